@@ -0,0 +1,396 @@
+/*
+ * Compiler of CAN hardware acceptance filters from receive buffers.
+ *
+ * @file        CO_CANfilter.c
+ * @ingroup     CO_CANfilter
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "301/CO_driver.h"
+
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_HW_FILTER
+
+#include "301/CO_CANfilter.h"
+
+/* Number of identifiers (11-bit + RTR) accepted by mask */
+static int32_t accepted(uint16_t mask) {
+    int32_t n = 1;
+    for (uint16_t bit = 0x0800U; bit != 0; bit >>= 1) {
+        if ((mask & bit) == 0) {
+            n <<= 1;
+        }
+    }
+    return n;
+}
+
+/* true, if all identifiers accepted by a are also accepted by b */
+static inline bool_t covers(const CO_CANfilter_t *b, const CO_CANfilter_t *a) {
+    return (a->mask & b->mask) == b->mask
+        && ((a->ident ^ b->ident) & b->mask) == 0;
+}
+
+/* Remove duplicates and entries covered by other entries, return new count */
+static uint16_t reduce(CO_CANfilter_t e[], uint16_t n) {
+    uint16_t k = 0;
+
+    for (uint16_t i = 0; i < n; i++) {
+        bool_t isCovered = false;
+        uint16_t j;
+
+        for (j = 0; j < k && !isCovered; j++) {
+            isCovered = covers(&e[j], &e[i]);
+        }
+        for (j = i + 1; j < n && !isCovered; j++) {
+            isCovered = covers(&e[j], &e[i])
+                     && (e[j].ident != e[i].ident || e[j].mask != e[i].mask);
+        }
+        if (!isCovered) {
+            e[k++] = e[i];
+        }
+    }
+    return k;
+}
+
+static inline uint8_t min8(uint8_t a, uint8_t b) { return a < b ? a : b; }
+
+/* Number of available banks, limited by result array */
+static uint8_t bankLimit(const CO_CANfilterHw_t *hw) {
+    return min8(hw->banks, CO_CONFIG_DRIVER_FILTER_BANKS);
+}
+
+/* Pack entries into independent mask and list banks */
+static uint8_t packIndependent(const CO_CANfilterHw_t *hw,
+                               const CO_CANfilter_t e[], uint16_t n,
+                               CO_CANfilterBank_t banks[])
+{
+    uint8_t M = min8(hw->maskSlots, CO_CANfilter_SLOTS_MAX);
+    uint8_t L = min8(hw->listSlots, CO_CANfilter_SLOTS_MAX);
+    uint16_t nMasked = 0, nExact, freeSlots, exactRest;
+    uint16_t bm = 0, bl = 0;
+
+    for (uint16_t i = 0; i < n; i++) {
+        if (e[i].mask != hw->maskBits) {
+            nMasked++;
+        }
+    }
+    nExact = n - nMasked;
+    if (nMasked > 0 && M == 0) {
+        return CO_CANfilter_FAIL;
+    }
+
+    /* exact entries fill free slots of mask banks first */
+    if (M > 0) {
+        bm = (nMasked + M - 1) / M;
+    }
+    freeSlots = bm * M - nMasked;
+    exactRest = nExact > freeSlots ? nExact - freeSlots : 0;
+    if (exactRest > 0) {
+        if (L > M) {
+            bl = (exactRest + L - 1) / L;
+        }
+        else if (M > 0) {
+            bm += (exactRest + M - 1) / M;
+        }
+        else {
+            return CO_CANfilter_FAIL;
+        }
+    }
+    if ((bm + bl) > bankLimit(hw)) {
+        return CO_CANfilter_FAIL;
+    }
+
+    if (banks != NULL) {
+        uint16_t b, i;
+        uint16_t iMasked = 0, iExact = 0;
+
+        for (b = 0; b < (bm + bl); b++) {
+            CO_CANfilterBank_t *bank = &banks[b];
+            bank->mode = b < bm ? CO_CANfilter_MODE_MASK : CO_CANfilter_MODE_LIST;
+            bank->count = 0;
+            while (bank->count < (b < bm ? M : L)) {
+                /* masked entries first, then exact */
+                if (b < bm) {
+                    while (iMasked < n && e[iMasked].mask == hw->maskBits) {
+                        iMasked++;
+                    }
+                    if (iMasked < n) {
+                        bank->slot[bank->count++] = e[iMasked++];
+                        continue;
+                    }
+                }
+                while (iExact < n && e[iExact].mask != hw->maskBits) {
+                    iExact++;
+                }
+                if (iExact >= n) {
+                    break;
+                }
+                bank->slot[bank->count++] = e[iExact++];
+            }
+            /* unused slots are copies of the first slot of the bank */
+            for (i = bank->count; i < CO_CANfilter_SLOTS_MAX; i++) {
+                bank->slot[i] = bank->slot[0];
+            }
+        }
+    }
+    return (uint8_t)(bm + bl);
+}
+
+/* Sort entries by mask, so entries with the same mask are contiguous */
+static void sortByMask(CO_CANfilter_t e[], uint16_t n) {
+    for (uint16_t i = 1; i < n; i++) {
+        CO_CANfilter_t x = e[i];
+        uint16_t j = i;
+        while (j > 0 && e[j - 1].mask < x.mask) {
+            e[j] = e[j - 1];
+            j--;
+        }
+        e[j] = x;
+    }
+}
+
+/* Pack groups of entries with the same mask into banks with shared mask */
+static uint8_t packShared(const CO_CANfilterHw_t *hw,
+                          CO_CANfilter_t e[], uint16_t n,
+                          CO_CANfilterBank_t banks[])
+{
+    uint8_t nBanks = bankLimit(hw);
+    uint8_t cap[CO_CONFIG_DRIVER_FILTER_BANKS];
+    bool_t used[CO_CONFIG_DRIVER_FILTER_BANKS];
+    bool_t groupDone[CO_CONFIG_DRIVER_FILTER_ENTRIES];
+    uint8_t bankCount = 0;
+    uint16_t done = 0;
+
+    for (uint8_t b = 0; b < nBanks; b++) {
+        cap[b] = (b == 0 && hw->listSlotsBank0 != 0)
+               ? hw->listSlotsBank0 : hw->listSlots;
+        cap[b] = min8(cap[b], CO_CANfilter_SLOTS_MAX);
+        used[b] = false;
+        banks[b].mode = CO_CANfilter_MODE_LIST;
+        banks[b].count = 0;
+    }
+    for (uint16_t i = 0; i < n; i++) {
+        groupDone[i] = false;
+    }
+
+    sortByMask(e, n);
+
+    /* assign groups, the largest first, to the largest free banks */
+    while (done < n) {
+        uint16_t gStart = 0, gSize = 0, next = 0;
+
+        for (uint16_t i = 0; i < n; i = next) {
+            next = i;
+            while (next < n && e[next].mask == e[i].mask) {
+                next++;
+            }
+            if (!groupDone[i] && (next - i) > gSize) {
+                gStart = i;
+                gSize = next - i;
+            }
+        }
+        groupDone[gStart] = true;
+        done += gSize;
+
+        for (uint16_t k = 0; k < gSize;) {
+            CO_CANfilterBank_t *bank;
+            uint8_t best = CO_CANfilter_FAIL;
+
+            for (uint8_t b = 0; b < nBanks; b++) {
+                if (!used[b] && cap[b] > 0
+                    && (best == CO_CANfilter_FAIL || cap[b] > cap[best])
+                ) {
+                    best = b;
+                }
+            }
+            if (best == CO_CANfilter_FAIL) {
+                return CO_CANfilter_FAIL;
+            }
+            used[best] = true;
+            if (best >= bankCount) {
+                bankCount = best + 1;
+            }
+            bank = &banks[best];
+            while (bank->count < cap[best] && k < gSize) {
+                bank->slot[bank->count++] = e[gStart + k++];
+            }
+        }
+    }
+
+    /* unused slots are copies of the first slot of the bank */
+    for (uint8_t b = 0; b < bankCount; b++) {
+        for (uint8_t s = banks[b].count; s < CO_CANfilter_SLOTS_MAX; s++) {
+            banks[b].slot[s] = banks[b].count > 0
+                             ? banks[b].slot[0] : (CO_CANfilter_t){0, 0};
+        }
+    }
+    return bankCount;
+}
+
+/* Merge the pair of entries (or masks on shared mask controller) with the
+ * lowest number of additionally accepted identifiers. Return false, if no
+ * merge is possible. */
+static bool_t mergeBest(const CO_CANfilterHw_t *hw,
+                        CO_CANfilter_t e[], uint16_t n)
+{
+    int32_t bestCost = INT32_MAX;
+    uint16_t bi = 0, bj = 0;
+    bool_t bestUnify = false;
+
+    for (uint16_t i = 0; i < n; i++) {
+        for (uint16_t j = i + 1; j < n; j++) {
+            uint16_t m = e[i].mask & e[j].mask & ~(e[i].ident ^ e[j].ident);
+            int32_t cost = accepted(m) - accepted(e[i].mask)
+                         - accepted(e[j].mask);
+            /* merged entry must be usable by controller */
+            if ((hw->sharedMask || hw->maskSlots > 0) && cost < bestCost) {
+                bestCost = cost;
+                bi = i;
+                bj = j;
+                bestUnify = false;
+            }
+        }
+    }
+
+    if (hw->sharedMask) {
+        /* unify masks of two groups, entries in both groups get common mask */
+        for (uint16_t i = 0; i < n; i++) {
+            for (uint16_t j = i + 1; j < n; j++) {
+                uint16_t m = e[i].mask & e[j].mask;
+                int32_t cost = 0;
+                bool_t first = true;
+
+                if (e[i].mask == e[j].mask) {
+                    continue;
+                }
+                /* only the first pair of entries for two masks */
+                for (uint16_t k = 0; k < i && first; k++) {
+                    if (e[k].mask == e[i].mask || e[k].mask == e[j].mask) {
+                        first = false;
+                    }
+                }
+                for (uint16_t k = i + 1; k < j && first; k++) {
+                    if (e[k].mask == e[j].mask) {
+                        first = false;
+                    }
+                }
+                if (!first) {
+                    continue;
+                }
+                for (uint16_t k = 0; k < n; k++) {
+                    if (e[k].mask == e[i].mask || e[k].mask == e[j].mask) {
+                        cost += accepted(m) - accepted(e[k].mask);
+                    }
+                }
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bi = i;
+                    bj = j;
+                    bestUnify = true;
+                }
+            }
+        }
+    }
+
+    if (bestCost == INT32_MAX) {
+        return false;
+    }
+
+    if (bestUnify) {
+        uint16_t mi = e[bi].mask, mj = e[bj].mask, m = mi & mj;
+        for (uint16_t k = 0; k < n; k++) {
+            if (e[k].mask == mi || e[k].mask == mj) {
+                e[k].mask = m;
+                e[k].ident &= m;
+            }
+        }
+    }
+    else {
+        uint16_t m = e[bi].mask & e[bj].mask & ~(e[bi].ident ^ e[bj].ident);
+        e[bi].mask = m;
+        e[bi].ident &= m;
+        /* entry bj is covered now and will be removed by reduce() */
+        e[bj] = e[bi];
+    }
+    return true;
+}
+
+
+/******************************************************************************/
+uint8_t CO_CANfilter_compile(const CO_CANfilterHw_t *hw,
+                             CO_CANfilter_t entries[],
+                             uint16_t count,
+                             CO_CANfilterBank_t banks[])
+{
+    if (hw == NULL || (entries == NULL && count > 0) || banks == NULL
+        || count > CO_CONFIG_DRIVER_FILTER_ENTRIES
+    ) {
+        return CO_CANfilter_FAIL;
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        entries[i].mask &= hw->maskBits;
+        entries[i].ident &= entries[i].mask;
+    }
+
+    for (;;) {
+        uint8_t bankCount;
+
+        count = reduce(entries, count);
+
+        if (hw->sharedMask) {
+            bankCount = packShared(hw, entries, count, banks);
+            if (bankCount != CO_CANfilter_FAIL) {
+                return bankCount;
+            }
+        }
+        else {
+            bankCount = packIndependent(hw, entries, count, NULL);
+            if (bankCount != CO_CANfilter_FAIL) {
+                return packIndependent(hw, entries, count, banks);
+            }
+        }
+
+        if (count <= 1 || !mergeBest(hw, entries, count)) {
+            return CO_CANfilter_FAIL;
+        }
+    }
+}
+
+
+/******************************************************************************/
+uint8_t CO_CANfilter_accepts(const CO_CANfilterBank_t banks[],
+                             uint8_t bankCount,
+                             uint16_t ident)
+{
+    if (banks == NULL || bankCount == CO_CANfilter_FAIL) {
+        return 1;
+    }
+    for (uint8_t b = 0; b < bankCount; b++) {
+        for (uint8_t s = 0; s < banks[b].count; s++) {
+            const CO_CANfilter_t *f = &banks[b].slot[s];
+            if (((ident ^ f->ident) & f->mask) == 0) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+#endif /* (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_HW_FILTER */
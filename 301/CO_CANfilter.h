@@ -0,0 +1,195 @@
+/**
+ * Compiler of CAN hardware acceptance filters from receive buffers.
+ *
+ * @file        CO_CANfilter.h
+ * @ingroup     CO_CANfilter
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_CAN_FILTER_H
+#define CO_CAN_FILTER_H
+
+/* This file is included from CO_driver_target.h, before CO_driver.h
+ * declarations, so it uses only standard types. */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_CANfilter CAN hardware filter compiler
+ * Minimal set of CAN hardware acceptance filter banks from receive buffers.
+ *
+ * @ingroup CO_driver
+ * @{
+ *
+ * Helper for driver implementations, enabled by
+ * @ref CO_CONFIG_DRIVER_HW_FILTER. CAN controllers usually have less
+ * acceptance filters than there are receive buffers in CANopenNode and
+ * filters are organized in banks, which work either in mask mode
+ * (independent identifier/mask pairs) or in list mode (exact identifiers).
+ * Driver collects (ident, mask) of all configured receive buffers, usually in
+ * CO_CANsetNormalMode(), and calls CO_CANfilter_compile() with description of
+ * the controller, @ref CO_CANfilterHw_t. Result is a list of filter banks,
+ * which driver copies into controller registers. Unwanted messages are then
+ * rejected by hardware and do not interrupt the CPU.
+ *
+ * Algorithm first removes duplicate entries and entries covered by other
+ * entries. Exact entries are packed into list banks, other into mask banks.
+ * If there are not enough banks, two entries are merged into one with common
+ * mask (or two masks are unified on controllers with shared mask), choosing
+ * merge, which lets through the least number of additional identifiers. This
+ * repeats until the result fits. Accepted set of identifiers is always a
+ * superset of the configured set, so driver must still match received message
+ * against rxArray in software (useCANrxFilters is false).
+ *
+ * Function runs in O(n^3) for n entries and is intended for initialization,
+ * not for interrupts.
+ */
+
+#ifndef CO_CONFIG_DRIVER_FILTER_BANKS
+/** Maximum number of filter banks in result of @ref CO_CANfilter_compile() */
+#define CO_CONFIG_DRIVER_FILTER_BANKS 28
+#endif
+
+#ifndef CO_CONFIG_DRIVER_FILTER_ENTRIES
+/** Maximum number of receive buffers, collected by driver for
+ * @ref CO_CANfilter_compile(). */
+#define CO_CONFIG_DRIVER_FILTER_ENTRIES 64
+#endif
+
+/** Maximum number of filters in one bank */
+#define CO_CANfilter_SLOTS_MAX 4
+
+/** RTR bit in ident and mask of @ref CO_CANfilter_t */
+#define CO_CANfilter_RTR 0x0800U
+
+/** Return value of @ref CO_CANfilter_compile(), if filters do not fit */
+#define CO_CANfilter_FAIL 0xFFU
+
+/**
+ * Acceptance filter: 11-bit CAN identifier and RTR bit, see
+ * @ref CO_CANfilter_RTR. Message is accepted, if
+ * ((msgIdent ^ ident) & mask) == 0.
+ */
+typedef struct {
+    uint16_t ident; /**< CAN identifier, bits not set in mask are zero */
+    uint16_t mask;  /**< Acceptance mask, set bits must match */
+} CO_CANfilter_t;
+
+/** Mode of filter bank */
+typedef enum {
+    /** Each slot is independent identifier/mask pair */
+    CO_CANfilter_MODE_MASK = 0,
+    /** Each slot is exact identifier. On controllers with shared mask all
+     * slots have the same mask. */
+    CO_CANfilter_MODE_LIST = 1
+} CO_CANfilter_mode_t;
+
+/**
+ * Filter bank, as produced by @ref CO_CANfilter_compile().
+ */
+typedef struct {
+    /** @ref CO_CANfilter_mode_t */
+    uint8_t mode;
+    /** Number of used slots, 0 if bank is not used. Unused slots of used bank
+     * are copies of slot[0], so they may be written into hardware as well. */
+    uint8_t count;
+    /** Filters */
+    CO_CANfilter_t slot[CO_CANfilter_SLOTS_MAX];
+} CO_CANfilterBank_t;
+
+/**
+ * Description of CAN controller acceptance filters.
+ */
+typedef struct {
+    /** Number of filter banks available for this CAN module */
+    uint8_t banks;
+    /** Number of identifier/mask pairs in mask mode bank, 0 if controller
+     * has no mask mode */
+    uint8_t maskSlots;
+    /** Number of identifiers in list mode bank, 0 if controller has no list
+     * mode */
+    uint8_t listSlots;
+    /** Number of identifiers in first bank, if different from listSlots,
+     * otherwise 0 */
+    uint8_t listSlotsBank0;
+    /** If non-zero, all identifiers in bank are compared with single mask of
+     * the bank. Banks are then always in list mode. */
+    uint8_t sharedMask;
+    /** Identifier and RTR bits, which can be compared by hardware */
+    uint16_t maskBits;
+} CO_CANfilterHw_t;
+
+/** bxCAN (STM32F0/F1/F4...) with filter banks in 16-bit scale. Each bank has
+ * two identifier/mask pairs or four identifiers. Number of banks is 14 or 28,
+ * shared between two CAN modules on some devices. */
+#define CO_CANfilterHw_BXCAN {14, 2, 4, 0, 0, 0x0FFFU}
+/** Bosch M_CAN / FDCAN (STM32G4/H7...) standard identifier filter elements.
+ * Each element is classic filter (identifier and mask) or dual identifier
+ * filter. Number of elements is device specific. RTR is not filtered. */
+#define CO_CANfilterHw_FDCAN {28, 1, 2, 0, 0, 0x07FFU}
+/** MCP2515: two masks, first is shared by two receive filters (RXB0), second
+ * by four receive filters (RXB1). RTR is not filtered. */
+#define CO_CANfilterHw_MCP2515 {2, 0, 4, 2, 1, 0x07FFU}
+/** SJA1000 in PeliCAN mode with dual filter: two identifier/mask pairs. */
+#define CO_CANfilterHw_SJA1000 {1, 2, 0, 0, 0, 0x0FFFU}
+
+
+/**
+ * Compile minimal set of filter banks.
+ *
+ * @param hw Description of CAN controller.
+ * @param entries Identifiers and masks of configured receive buffers. Array is
+ * used as working space and is modified.
+ * @param count Number of entries, up to @ref CO_CONFIG_DRIVER_FILTER_ENTRIES.
+ * @param [out] banks Result, array of at least
+ * @ref CO_CONFIG_DRIVER_FILTER_BANKS elements. Index in array is index of
+ * hardware bank.
+ *
+ * @return Number of used elements in banks or @ref CO_CANfilter_FAIL, if
+ * filters can not be configured (driver must then accept all messages).
+ */
+uint8_t CO_CANfilter_compile(const CO_CANfilterHw_t *hw,
+                             CO_CANfilter_t entries[],
+                             uint16_t count,
+                             CO_CANfilterBank_t banks[]);
+
+/**
+ * Verify, if message identifier is accepted by filter banks.
+ *
+ * @param banks Result of @ref CO_CANfilter_compile().
+ * @param bankCount Return value of @ref CO_CANfilter_compile().
+ * @param ident 11-bit CAN identifier with @ref CO_CANfilter_RTR bit.
+ *
+ * @return Non-zero, if message is accepted.
+ */
+uint8_t CO_CANfilter_accepts(const CO_CANfilterBank_t banks[],
+                             uint8_t bankCount,
+                             uint16_t ident);
+
+/** @} */ /* CO_CANfilter */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* CO_CAN_FILTER_H */
@@ -0,0 +1,137 @@
+/*
+ * Receive dispatch index for CAN drivers.
+ *
+ * @file        CO_CANrxDispatch.c
+ * @ingroup     CO_CANrxDispatch
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "301/CO_CANrxDispatch.h"
+
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_DISPATCH
+
+#define IS_EXACT(buffer) CO_CANrxDispatch_IS_EXACT(buffer)
+
+/* Rebuild the list of rxArray entries with other masks, without entry skip.
+ * Used after the list has overflowed, so receive dispatch index is used again,
+ * when the list fits. */
+static void maskedRebuild(CO_CANmodule_t *CANmodule, uint16_t skip) {
+    uint16_t i;
+
+    CANmodule->rxMaskedCount = 0U;
+    CANmodule->rxMaskedOverflow = false;
+    for (i = 0U; i < CANmodule->rxSize; i++) {
+        CO_CANrx_t *b = &CANmodule->rxArray[i];
+        if (i == skip || b->CANrx_callback == NULL || IS_EXACT(b)) {
+            continue;
+        }
+        if (CANmodule->rxMaskedCount >= CO_CONFIG_DRIVER_RX_MASKED_COUNT) {
+            CANmodule->rxMaskedOverflow = true;
+            break;
+        }
+        CANmodule->rxMasked[CANmodule->rxMaskedCount++] = i;
+    }
+}
+
+
+/******************************************************************************/
+void CO_CANrxDispatch_init(CO_CANmodule_t *CANmodule) {
+    memset(CANmodule->rxDispatch, 0xFF, sizeof(CANmodule->rxDispatch));
+    CANmodule->rxMaskedCount = 0U;
+    CANmodule->rxMaskedOverflow = false;
+}
+
+
+/******************************************************************************/
+void CO_CANrxDispatch_remove(CO_CANmodule_t *CANmodule, uint16_t index) {
+    CO_CANrx_t *buffer = &CANmodule->rxArray[index];
+    uint16_t i;
+
+    if (buffer->CANrx_callback == NULL) {
+        return;
+    }
+
+    if (IS_EXACT(buffer)) {
+        uint16_t id = buffer->ident & 0x07FFU;
+
+        if (CANmodule->rxDispatch[id] == index) {
+            /* next buffer with the same identifier takes precedence */
+            CANmodule->rxDispatch[id] = CO_CANrxDispatch_NONE;
+            for (i = index + 1U; i < CANmodule->rxSize; i++) {
+                CO_CANrx_t *b = &CANmodule->rxArray[i];
+                if (b->CANrx_callback != NULL && IS_EXACT(b)
+                    && (b->ident & 0x07FFU) == id
+                ) {
+                    CANmodule->rxDispatch[id] = i;
+                    break;
+                }
+            }
+        }
+    }
+    else if (CANmodule->rxMaskedOverflow) {
+        maskedRebuild(CANmodule, index);
+    }
+    else {
+        for (i = 0U; i < CANmodule->rxMaskedCount; i++) {
+            if (CANmodule->rxMasked[i] == index) {
+                CANmodule->rxMaskedCount--;
+                for (; i < CANmodule->rxMaskedCount; i++) {
+                    CANmodule->rxMasked[i] = CANmodule->rxMasked[i + 1U];
+                }
+                break;
+            }
+        }
+    }
+}
+
+
+/******************************************************************************/
+void CO_CANrxDispatch_add(CO_CANmodule_t *CANmodule, uint16_t index) {
+    CO_CANrx_t *buffer = &CANmodule->rxArray[index];
+
+    if (IS_EXACT(buffer)) {
+        uint16_t id = buffer->ident & 0x07FFU;
+
+        /* buffer with lower index has precedence */
+        if (CANmodule->rxDispatch[id] == CO_CANrxDispatch_NONE
+            || CANmodule->rxDispatch[id] > index
+        ) {
+            CANmodule->rxDispatch[id] = index;
+        }
+    }
+    else if (CANmodule->rxMaskedCount >= CO_CONFIG_DRIVER_RX_MASKED_COUNT) {
+        CANmodule->rxMaskedOverflow = true;
+    }
+    else {
+        /* keep the list sorted by index */
+        uint16_t i = CANmodule->rxMaskedCount;
+        while (i > 0U && CANmodule->rxMasked[i - 1U] > index) {
+            CANmodule->rxMasked[i] = CANmodule->rxMasked[i - 1U];
+            i--;
+        }
+        CANmodule->rxMasked[i] = index;
+        CANmodule->rxMaskedCount++;
+    }
+}
+
+
+#endif /* (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_DISPATCH */
@@ -0,0 +1,178 @@
+/**
+ * Receive dispatch index for CAN drivers.
+ *
+ * @file        CO_CANrxDispatch.h
+ * @ingroup     CO_CANrxDispatch
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_CAN_RX_DISPATCH_H
+#define CO_CAN_RX_DISPATCH_H
+
+#include "301/CO_driver.h"
+
+#if ((CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_DISPATCH) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_CANrxDispatch CAN receive dispatch index
+ * Constant time search of the rxArray entry for received CAN message.
+ *
+ * @ingroup CO_driver
+ * @{
+ *
+ * Helper for driver implementations, enabled by
+ * @ref CO_CONFIG_DRIVER_RX_DISPATCH. It is used, when CAN module hardware
+ * filters don't tell the rxArray index of the received message.
+ *
+ * Index is kept in CO_CANmodule_t, which must contain members rxArray, rxSize,
+ * rxDispatch[0x800], rxMasked[CO_CONFIG_DRIVER_RX_MASKED_COUNT], rxMaskedCount
+ * and rxMaskedOverflow, see example/CO_driver_target.h. CO_CANrx_t must contain
+ * members ident, mask and CANrx_callback. Ident and mask contain 11-bit CAN
+ * identifier and RTR bit (0x0800), as set by CO_CANrxBufferInit() in
+ * example/CO_driver_blank.c.
+ *
+ * Driver calls CO_CANrxDispatch_init() from CO_CANmodule_init(),
+ * CO_CANrxDispatch_remove() and CO_CANrxDispatch_add() from
+ * CO_CANrxBufferInit(), before and after the rxArray entry is changed, and
+ * CO_CANrxDispatch_find() for each received message. Functions, which change
+ * the index, must be protected with CO_LOCK_CAN_SEND() against the receive
+ * interrupt.
+ */
+
+/** Value of rxDispatch entry, if there is no rxArray entry for identifier */
+#define CO_CANrxDispatch_NONE 0xFFFFU
+
+/** True, if rxArray entry is received with exact 11-bit identifier mask */
+#define CO_CANrxDispatch_IS_EXACT(buffer) (((buffer)->mask & 0x07FFU) == 0x07FFU)
+
+
+/**
+ * Initialize empty receive dispatch index.
+ *
+ * @param CANmodule CAN module object.
+ */
+void CO_CANrxDispatch_init(CO_CANmodule_t *CANmodule);
+
+
+/**
+ * Remove rxArray entry from the receive dispatch index.
+ *
+ * Must be called before the entry is reconfigured. Entry, which was not yet
+ * configured (CANrx_callback is NULL), is ignored.
+ *
+ * @param CANmodule CAN module object.
+ * @param index Index of the entry in rxArray.
+ */
+void CO_CANrxDispatch_remove(CO_CANmodule_t *CANmodule, uint16_t index);
+
+
+/**
+ * Add configured rxArray entry to the receive dispatch index.
+ *
+ * @param CANmodule CAN module object.
+ * @param index Index of the entry in rxArray.
+ */
+void CO_CANrxDispatch_add(CO_CANmodule_t *CANmodule, uint16_t index);
+
+
+/**
+ * Find rxArray entry for the received message.
+ *
+ * If there are more matching entries, the one with the lowest index is
+ * returned, the same as with the linear search of the rxArray. If more than
+ * @ref CO_CONFIG_DRIVER_RX_MASKED_COUNT entries with non-exact mask are
+ * configured, rxArray is searched linearly. Function is inline, because it is
+ * called from the receive interrupt for each message.
+ *
+ * @param CANmodule CAN module object.
+ * @param ident 11-bit CAN identifier of the received message, with RTR bit
+ * (0x0800).
+ *
+ * @return Matching rxArray entry or NULL.
+ */
+static inline CO_CANrx_t *CO_CANrxDispatch_find(CO_CANmodule_t *CANmodule,
+                                                uint16_t ident)
+{
+    CO_CANrx_t *buffer = NULL;
+    uint16_t index;
+    uint16_t i;
+
+    if (CANmodule->rxMaskedOverflow) {
+        /* Search rxArray form CANmodule for the same CAN-ID. */
+        buffer = &CANmodule->rxArray[0];
+        for (index = CANmodule->rxSize; index > 0U; index--) {
+            if (((ident ^ buffer->ident) & buffer->mask) == 0U) {
+                return buffer;
+            }
+            buffer++;
+        }
+        return NULL;
+    }
+
+    /* Get rxArray index from the dispatch table, then check buffers with
+     * other masks, which have higher precedence. */
+    index = CANmodule->rxDispatch[ident & 0x07FFU];
+    if (index != CO_CANrxDispatch_NONE) {
+        buffer = &CANmodule->rxArray[index];
+        /* verify also RTR */
+        if (((ident ^ buffer->ident) & buffer->mask) != 0U) {
+            /* Dispatch index has only the first buffer for identifier. Other
+             * buffer with the same identifier and different RTR bit may
+             * follow, which is rare, so search for it. */
+            buffer = NULL;
+            for (i = index + 1U; i < CANmodule->rxSize; i++) {
+                CO_CANrx_t *b = &CANmodule->rxArray[i];
+                if (b->CANrx_callback != NULL && CO_CANrxDispatch_IS_EXACT(b)
+                    && ((ident ^ b->ident) & b->mask) == 0U
+                ) {
+                    buffer = b;
+                    break;
+                }
+            }
+            index = (buffer != NULL) ? i : CO_CANrxDispatch_NONE;
+        }
+    }
+    for (i = 0U; i < CANmodule->rxMaskedCount; i++) {
+        CO_CANrx_t *bufMasked;
+        if (CANmodule->rxMasked[i] >= index) {
+            break;
+        }
+        bufMasked = &CANmodule->rxArray[CANmodule->rxMasked[i]];
+        if (((ident ^ bufMasked->ident) & bufMasked->mask) == 0U) {
+            return bufMasked;
+        }
+    }
+
+    return buffer;
+}
+
+/** @} */ /* CO_CANrxDispatch */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_DISPATCH */
+
+#endif /* CO_CAN_RX_DISPATCH_H */
@@ -0,0 +1,214 @@
+/*
+ * CAN bus traffic statistics: bus load and per COB-ID frame counters.
+ *
+ * @file        CO_CANtraffic.c
+ * @ingroup     CO_CANtraffic
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "301/CO_driver.h"
+#include "301/CO_CANtraffic.h"
+
+/* Bits of the frame, as they are appended from start of frame */
+typedef struct {
+    uint16_t crc;
+    uint16_t count;
+    uint16_t stuff;
+    uint8_t prev;
+    uint8_t run;
+} frameBits_t;
+
+/* Append count bits of value, MSB first. Update CRC-15 (polynomial 0x4599),
+ * if calcCrc, and count stuff bits. Stuff bit is inserted after five equal
+ * bits and it also starts the next run. */
+static void frameAppend(frameBits_t *f, uint32_t value, uint8_t count,
+                        bool_t calcCrc)
+{
+    while (count > 0U) {
+        uint8_t bit;
+
+        count--;
+        bit = (uint8_t)((value >> count) & 1U);
+
+        if (calcCrc) {
+            bool_t crcNext = (bit ^ ((f->crc >> 14U) & 1U)) != 0U;
+            f->crc = (uint16_t)((f->crc << 1U) & 0x7FFFU);
+            if (crcNext) {
+                f->crc ^= 0x4599U;
+            }
+        }
+
+        if (f->count > 0U && bit == f->prev) {
+            f->run++;
+        }
+        else {
+            f->prev = bit;
+            f->run = 1U;
+        }
+        f->count++;
+        if (f->run == 5U) {
+            f->stuff++;
+            f->prev ^= 1U;
+            f->run = 1U;
+        }
+    }
+}
+
+
+/******************************************************************************/
+uint16_t CO_CANtraffic_frameBits(uint16_t ident, uint8_t DLC,
+                                 const uint8_t *data, uint16_t *stuffBits)
+{
+    frameBits_t f = {0U, 0U, 0U, 0U, 0U};
+    bool_t rtr = (ident & 0x0800U) != 0U;
+    uint8_t dataLen = (rtr || data == NULL) ? 0U : DLC;
+    uint8_t i;
+
+    /* SOF, ID, RTR, IDE, r0, DLC, data, CRC */
+    frameAppend(&f, 0U, 1U, true);
+    frameAppend(&f, ident & 0x07FFU, 11U, true);
+    frameAppend(&f, rtr ? 1U : 0U, 1U, true);
+    frameAppend(&f, 0U, 2U, true);
+    frameAppend(&f, DLC > 8U ? 0xFU : DLC, 4U, true);
+    for (i = 0U; i < dataLen; i++) {
+        frameAppend(&f, data[i], 8U, true);
+    }
+    frameAppend(&f, f.crc, 15U, false);
+
+    if (stuffBits != NULL) {
+        *stuffBits = f.stuff;
+    }
+    return f.count + f.stuff + CO_CANtraffic_TAIL_BITS;
+}
+
+
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+
+/* Find entry for identifier in the table of COB-IDs or add it. Lower bits of
+ * the CAN identifier are node-ID, so function code is mixed into the hash. */
+static CO_CANtrafficId_t *CO_CANtraffic_find(CO_CANtraffic_t *t,
+                                             uint16_t ident)
+{
+    uint16_t i = (ident ^ (ident >> 7U)) & (CO_CONFIG_DRIVER_TRAFFIC_IDS - 1U);
+    uint16_t probes;
+
+    for (probes = CO_CONFIG_DRIVER_TRAFFIC_IDS; probes > 0U; probes--) {
+        CO_CANtrafficId_t *id = &t->ids[i];
+
+        if (id->ident == ident) {
+            return id;
+        }
+        if (id->ident == CO_CANtraffic_ID_NONE) {
+            id->ident = ident;
+            return id;
+        }
+        i = (i + 1U) & (CO_CONFIG_DRIVER_TRAFFIC_IDS - 1U);
+    }
+    return NULL;
+}
+
+
+/******************************************************************************/
+void CO_CANtraffic_init(CO_CANtraffic_t *t, uint16_t bitRate) {
+    t->bitRate = bitRate;
+    CO_CANtraffic_reset(t);
+}
+
+
+/******************************************************************************/
+void CO_CANtraffic_reset(CO_CANtraffic_t *t) {
+    uint16_t i;
+
+    for (i = 0U; i < CO_CONFIG_DRIVER_TRAFFIC_IDS; i++) {
+        t->ids[i].ident = CO_CANtraffic_ID_NONE;
+        t->ids[i].rxFrames = 0U;
+        t->ids[i].txFrames = 0U;
+    }
+    t->otherFrames = 0U;
+    t->rxFrames = 0U;
+    t->txFrames = 0U;
+    t->bits = 0U;
+    t->bitsWindowStart = 0U;
+    t->window_us = 0U;
+    t->load = 0U;
+    t->loadPeak = 0U;
+    t->txCountMax = 0U;
+}
+
+
+/******************************************************************************/
+void CO_CANtraffic_rx(CO_CANtraffic_t *t, uint16_t ident, uint8_t DLC,
+                      const uint8_t *data)
+{
+    CO_CANtrafficId_t *id = CO_CANtraffic_find(t, ident & 0x0FFFU);
+
+    if (id != NULL) {
+        id->rxFrames++;
+    }
+    else {
+        t->otherFrames++;
+    }
+    t->rxFrames++;
+    t->bits += CO_CANtraffic_frameBits(ident, DLC, data, NULL);
+}
+
+
+/******************************************************************************/
+void CO_CANtraffic_tx(CO_CANtraffic_t *t, uint16_t ident, uint8_t DLC,
+                      const uint8_t *data)
+{
+    CO_CANtrafficId_t *id = CO_CANtraffic_find(t, ident & 0x0FFFU);
+
+    if (id != NULL) {
+        id->txFrames++;
+    }
+    else {
+        t->otherFrames++;
+    }
+    t->txFrames++;
+    t->bits += CO_CANtraffic_frameBits(ident, DLC, data, NULL);
+}
+
+
+/******************************************************************************/
+void CO_CANtraffic_process(CO_CANtraffic_t *t, uint32_t timeDifference_us) {
+    if (t->bitRate == 0U) {
+        return;
+    }
+
+    t->window_us += timeDifference_us;
+    if (t->window_us >= (uint32_t)CO_CONFIG_DRIVER_TRAFFIC_WINDOW_MS * 1000U) {
+        /* unsigned arithmetic handles overflow of the bits counter */
+        uint32_t bits = t->bits;
+        uint32_t bitsWindow = bits - t->bitsWindowStart;
+        /* bit rate in kbit/s is number of bits per 1000 microseconds */
+        uint64_t load = (uint64_t)bitsWindow * 1000000U
+                        / ((uint64_t)t->bitRate * t->window_us);
+
+        t->load = load > 1000U ? 1000U : (uint16_t)load;
+        if (t->load > t->loadPeak) {
+            t->loadPeak = t->load;
+        }
+        t->bitsWindowStart = bits;
+        t->window_us = 0U;
+    }
+}
+
+#endif /* (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC */
@@ -0,0 +1,243 @@
+/**
+ * CAN bus traffic statistics: bus load and per COB-ID frame counters.
+ *
+ * @file        CO_CANtraffic.h
+ * @ingroup     CO_CANtraffic
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_CAN_TRAFFIC_H
+#define CO_CAN_TRAFFIC_H
+
+/* This file is included from CO_driver_target.h, before CO_driver.h
+ * declarations, so it uses only standard types. */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_CANtraffic CAN traffic statistics
+ * Bus load and per COB-ID frame counters of the CAN module.
+ *
+ * @ingroup CO_driver
+ * @{
+ *
+ * Helper for driver implementations, enabled by
+ * @ref CO_CONFIG_DRIVER_TRAFFIC. Driver includes @ref CO_CANtraffic_t as
+ * member *traffic* of CO_CANmodule_t and calls:
+ * - CO_CANtraffic_init() from CO_CANmodule_init(), with CAN bit rate.
+ * - CO_CANtraffic_rx() for each received message, also for messages, which
+ *   does not match any rxArray entry, if hardware filters are not used.
+ * - CO_CANtraffic_tx() for each message copied to the CAN controller.
+ * - CO_CANtraffic_txQueued() after CANtxCount is incremented in CO_CANsend().
+ *
+ * CO_CANtraffic_process() is called from CO_process(). It calculates bus load
+ * from the number of bits of all counted frames, including stuff bits, see
+ * CO_CANtraffic_frameBits(). It is an estimate: error frames, overload frames
+ * and frames rejected by hardware filters are not seen by the driver. It is
+ * valid only for classical CAN, not for CAN FD.
+ *
+ * Drivers with *traffic* member: example/CO_driver_blank.c,
+ * simulation/CO_driver_sim.c and socketCAN/CO_driver_socketCAN.c.
+ *
+ * Frames are counted for each COB-ID in a table of
+ * @ref CO_CONFIG_DRIVER_TRAFFIC_IDS entries. COB-ID gets an entry with the
+ * first frame, entries are only cleared by CO_CANtraffic_reset(). If table is
+ * full, frames with other COB-IDs are counted in *otherFrames*.
+ *
+ * Statistics are readable from Object Dictionary, see CO_stats_initTraffic().
+ *
+ * CO_CANtraffic_rx(), CO_CANtraffic_tx() and CO_CANtraffic_txQueued() are
+ * called from CAN interrupt or inside CO_LOCK_CAN_SEND(). Counters of bits
+ * are only read by CO_CANtraffic_process(), so it needs no locking.
+ */
+
+#ifndef CO_CONFIG_DRIVER_TRAFFIC_IDS
+/** Number of entries in the table of COB-IDs, power of 2, up to 64 */
+#define CO_CONFIG_DRIVER_TRAFFIC_IDS 32
+#endif
+
+#if CO_CONFIG_DRIVER_TRAFFIC_IDS > 64 \
+    || (CO_CONFIG_DRIVER_TRAFFIC_IDS & (CO_CONFIG_DRIVER_TRAFFIC_IDS - 1)) != 0
+#error CO_CONFIG_DRIVER_TRAFFIC_IDS must be power of 2, not larger than 64
+#endif
+
+#ifndef CO_CONFIG_DRIVER_TRAFFIC_WINDOW_MS
+/** Time window for calculation of bus load in milliseconds */
+#define CO_CONFIG_DRIVER_TRAFFIC_WINDOW_MS 1000
+#endif
+
+/** Identifier of unused entry in the table of COB-IDs */
+#define CO_CANtraffic_ID_NONE 0xFFFFU
+
+/** Number of bits after CRC: CRC delimiter, ACK, EOF and interframe space */
+#define CO_CANtraffic_TAIL_BITS 13U
+
+/**
+ * Frame counters for one COB-ID
+ */
+typedef struct {
+    /** 11-bit CAN identifier, 0x0800 is RTR bit, CO_CANtraffic_ID_NONE if
+     * entry is unused */
+    uint16_t ident;
+    /** Number of received frames */
+    uint32_t rxFrames;
+    /** Number of transmitted frames */
+    uint32_t txFrames;
+} CO_CANtrafficId_t;
+
+
+/**
+ * CAN traffic statistics object
+ */
+typedef struct {
+    /** Table of COB-IDs, hashed by lower bits of CAN identifier */
+    CO_CANtrafficId_t ids[CO_CONFIG_DRIVER_TRAFFIC_IDS];
+    /** Number of frames, which did not fit into the table of COB-IDs */
+    uint32_t otherFrames;
+    /** Number of received frames */
+    uint32_t rxFrames;
+    /** Number of transmitted frames */
+    uint32_t txFrames;
+    /** Number of bits of all counted frames, including stuff bits, free
+     * running */
+    uint32_t bits;
+    /** Value of bits at the start of the current window */
+    uint32_t bitsWindowStart;
+    /** Time in the current window in microseconds */
+    uint32_t window_us;
+    /** CAN bit rate in kbit/s, from CO_CANtraffic_init() */
+    uint16_t bitRate;
+    /** Bus load in previous window in per mille */
+    uint16_t load;
+    /** Maximum bus load of any window in per mille */
+    uint16_t loadPeak;
+    /** High-water mark of CANtxCount, number of transmit buffers from
+     * txArray, which were waiting for CAN controller at the same time */
+    uint16_t txCountMax;
+} CO_CANtraffic_t;
+
+
+/**
+ * Get number of bits on the bus for classical CAN frame with standard
+ * identifier.
+ *
+ * Calculated are all bits from start of frame to the end of interframe space,
+ * including exact number of stuff bits, which depends on identifier, data
+ * and CRC. Function does not depend on @ref CO_CONFIG_DRIVER_TRAFFIC.
+ *
+ * @warning Only classical CAN framing is encoded. CAN FD frames are counted
+ * as classical frames with the same number of data bytes, without FD control
+ * bits, longer CRC, fixed stuff bits and faster data phase with bit rate
+ * switch. So bus load of CAN FD traffic is wrong, usually too high with bit
+ * rate switch.
+ *
+ * @param ident 11-bit CAN identifier, 0x0800 is RTR bit.
+ * @param DLC Data length code, number of data bytes.
+ * @param data Data bytes, not used for RTR frame.
+ * @param [out] stuffBits Number of stuff bits, may be NULL.
+ *
+ * @return Number of bits.
+ */
+uint16_t CO_CANtraffic_frameBits(uint16_t ident, uint8_t DLC,
+                                 const uint8_t *data, uint16_t *stuffBits);
+
+
+/**
+ * Initialize CAN traffic statistics, all statistics are cleared.
+ *
+ * @param t This object.
+ * @param bitRate CAN bit rate in kbit/s, 0 if unknown. Then bus load is not
+ * calculated.
+ */
+void CO_CANtraffic_init(CO_CANtraffic_t *t, uint16_t bitRate);
+
+
+/**
+ * Clear all statistics, bit rate is preserved.
+ *
+ * Function must be called inside CO_LOCK_CAN_SEND().
+ *
+ * @param t This object.
+ */
+void CO_CANtraffic_reset(CO_CANtraffic_t *t);
+
+
+/**
+ * Count received frame.
+ *
+ * @param t This object.
+ * @param ident 11-bit CAN identifier, 0x0800 is RTR bit.
+ * @param DLC Data length code, number of data bytes.
+ * @param data Data bytes.
+ */
+void CO_CANtraffic_rx(CO_CANtraffic_t *t, uint16_t ident, uint8_t DLC,
+                      const uint8_t *data);
+
+
+/**
+ * Count transmitted frame, same as @ref CO_CANtraffic_rx().
+ *
+ * @param t This object.
+ * @param ident 11-bit CAN identifier, 0x0800 is RTR bit.
+ * @param DLC Data length code, number of data bytes.
+ * @param data Data bytes.
+ */
+void CO_CANtraffic_tx(CO_CANtraffic_t *t, uint16_t ident, uint8_t DLC,
+                      const uint8_t *data);
+
+
+/**
+ * Update high-water mark of transmit buffers, waiting for CAN controller.
+ *
+ * @param t This object.
+ * @param CANtxCount Current value of CANtxCount from CO_CANmodule_t.
+ */
+static inline void CO_CANtraffic_txQueued(CO_CANtraffic_t *t,
+                                          uint16_t CANtxCount)
+{
+    if (CANtxCount > t->txCountMax) {
+        t->txCountMax = CANtxCount;
+    }
+}
+
+
+/**
+ * Calculate bus load.
+ *
+ * Function is called from CO_process_NMT() for each CAN module, after
+ * CO_CANmodule_process(). At the end of each
+ * @ref CO_CONFIG_DRIVER_TRAFFIC_WINDOW_MS it updates *load* and *loadPeak*.
+ *
+ * @param t This object.
+ * @param timeDifference_us Time difference from previous function call in
+ * [microseconds].
+ */
+void CO_CANtraffic_process(CO_CANtraffic_t *t, uint32_t timeDifference_us);
+
+/** @} */ /* CO_CANtraffic */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* CO_CAN_TRAFFIC_H */
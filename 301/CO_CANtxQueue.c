@@ -0,0 +1,141 @@
+/*
+ * Priority ordered queue of CAN transmit buffers.
+ *
+ * @file        CO_CANtxQueue.c
+ * @ingroup     CO_CANtxQueue
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "301/CO_driver.h"
+
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_QUEUE
+
+#include "301/CO_CANtxQueue.h"
+
+/* get or set pending bit for priority rank */
+static inline bool_t rankIsPending(CO_CANtxQueue_t *q, uint16_t r) {
+    return (q->pending[r >> 5] & (0x80000000UL >> (r & 0x1FU))) != 0;
+}
+
+static void rankSetPending(CO_CANtxQueue_t *q, uint16_t r, bool_t pending) {
+    uint16_t w = r >> 5;
+    uint32_t mask = 0x80000000UL >> (r & 0x1FU);
+
+    if (pending) {
+        q->pending[w] |= mask;
+    }
+    else {
+        q->pending[w] &= ~mask;
+    }
+
+    if (q->pending[w] != 0) {
+        q->summary |= 0x80000000UL >> w;
+    }
+    else {
+        q->summary &= ~(0x80000000UL >> w);
+    }
+}
+
+/* true, if buffer i has higher priority than buffer j */
+static inline bool_t higherPriority(CO_CANtxQueue_t *q, uint16_t i, uint16_t j) {
+    return q->ident[i] < q->ident[j] || (q->ident[i] == q->ident[j] && i < j);
+}
+
+
+/******************************************************************************/
+void CO_CANtxQueue_init(CO_CANtxQueue_t *q, uint16_t size) {
+    if (q == NULL) {
+        return;
+    }
+    if (size > CO_CONFIG_DRIVER_TX_QUEUE_SIZE) {
+        size = CO_CONFIG_DRIVER_TX_QUEUE_SIZE;
+    }
+
+    memset(q, 0, sizeof(CO_CANtxQueue_t));
+    q->size = size;
+    for (uint16_t i = 0; i < size; i++) {
+        q->rank[i] = i;
+        q->index[i] = i;
+    }
+}
+
+
+/******************************************************************************/
+void CO_CANtxQueue_setIdent(CO_CANtxQueue_t *q, uint16_t index, uint16_t ident) {
+    if (q == NULL || index >= q->size || q->ident[index] == ident) {
+        return;
+    }
+
+    uint16_t r = q->rank[index];
+    bool_t pending = rankIsPending(q, r);
+    q->ident[index] = ident;
+
+    /* Move buffer to the new position in priority order. Buffers in between
+     * are shifted by one place, together with their pending bits. */
+    while (r > 0 && higherPriority(q, index, q->index[r - 1])) {
+        uint16_t other = q->index[r - 1];
+        q->index[r] = other;
+        q->rank[other] = r;
+        rankSetPending(q, r, rankIsPending(q, r - 1));
+        r--;
+    }
+    while ((r + 1) < q->size && higherPriority(q, q->index[r + 1], index)) {
+        uint16_t other = q->index[r + 1];
+        q->index[r] = other;
+        q->rank[other] = r;
+        rankSetPending(q, r, rankIsPending(q, r + 1));
+        r++;
+    }
+    q->index[r] = index;
+    q->rank[index] = r;
+    rankSetPending(q, r, pending);
+}
+
+
+/******************************************************************************/
+void CO_CANtxQueue_push(CO_CANtxQueue_t *q, uint16_t index) {
+    if (index < q->size) {
+        rankSetPending(q, q->rank[index], true);
+    }
+}
+
+
+/******************************************************************************/
+void CO_CANtxQueue_remove(CO_CANtxQueue_t *q, uint16_t index) {
+    if (index < q->size) {
+        rankSetPending(q, q->rank[index], false);
+    }
+}
+
+
+/******************************************************************************/
+uint16_t CO_CANtxQueue_pop(CO_CANtxQueue_t *q) {
+    if (q->summary == 0) {
+        return CO_CANtxQueue_NONE;
+    }
+
+    uint16_t w = CO_CLZ32(q->summary);
+    uint16_t r = (w << 5) + CO_CLZ32(q->pending[w]);
+
+    rankSetPending(q, r, false);
+    return q->index[r];
+}
+
+#endif /* (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_QUEUE */
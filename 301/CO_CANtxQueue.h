@@ -0,0 +1,166 @@
+/**
+ * Priority ordered queue of CAN transmit buffers.
+ *
+ * @file        CO_CANtxQueue.h
+ * @ingroup     CO_CANtxQueue
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_CAN_TX_QUEUE_H
+#define CO_CAN_TX_QUEUE_H
+
+/* This file is included from CO_driver_target.h, before CO_driver.h
+ * declarations, so it uses only standard types. */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_CANtxQueue CAN transmit queue
+ * Priority ordered queue of CAN transmit buffers.
+ *
+ * @ingroup CO_driver
+ * @{
+ *
+ * Helper for driver implementations, enabled by
+ * @ref CO_CONFIG_DRIVER_TX_QUEUE. If CO_CANsend() can not copy message to the
+ * CAN module, it marks transmit buffer as pending in the queue. CAN transmit
+ * interrupt then takes pending buffer with the lowest CAN identifier (the
+ * highest priority on the CAN bus) with @ref CO_CANtxQueue_pop(), instead of
+ * scanning the txArray. Buffers with the same CAN identifier are ordered by
+ * index in txArray.
+ *
+ * Pending buffers are stored as bits in a two level bitmap, ordered by
+ * priority. Next buffer is found with two count-leading-zeros operations,
+ * @ref CO_CLZ32. Priority order is recalculated only, when CAN identifier of
+ * the buffer changes, see @ref CO_CANtxQueue_setIdent().
+ *
+ * Functions are not thread safe, they must be called inside
+ * CO_LOCK_CAN_SEND() or from CAN interrupt.
+ */
+
+#ifndef CO_CONFIG_DRIVER_TX_QUEUE_SIZE
+/** Maximum number of CAN transmit buffers in the queue, up to 1024 */
+#define CO_CONFIG_DRIVER_TX_QUEUE_SIZE 128
+#endif
+
+#if CO_CONFIG_DRIVER_TX_QUEUE_SIZE > 1024
+#error CO_CONFIG_DRIVER_TX_QUEUE_SIZE must not be larger than 1024
+#endif
+
+#ifndef CO_CLZ32
+#if defined __GNUC__ || defined CO_DOXYGEN
+/** Count leading zeros of non-zero 32-bit value. May be defined by target to
+ * use specific CPU instruction. */
+#define CO_CLZ32(x) ((uint16_t)__builtin_clz(x))
+#else
+static inline uint16_t CO_CLZ32(uint32_t x) {
+    uint16_t n = 0;
+    while ((x & 0x80000000UL) == 0) { x <<= 1; n++; }
+    return n;
+}
+#endif
+#endif
+
+/** Return value of @ref CO_CANtxQueue_pop(), if queue is empty */
+#define CO_CANtxQueue_NONE 0xFFFFU
+
+/**
+ * CAN transmit queue object
+ */
+typedef struct {
+    /** Bit (31 - w) is set, if pending[w] is not zero */
+    uint32_t summary;
+    /** Pending buffers. Priority rank r is bit (31 - r % 32) in word r / 32 */
+    uint32_t pending[(CO_CONFIG_DRIVER_TX_QUEUE_SIZE + 31) / 32];
+    /** 11-bit CAN identifier of each buffer, indexed by txArray index */
+    uint16_t ident[CO_CONFIG_DRIVER_TX_QUEUE_SIZE];
+    /** Priority rank of each buffer, indexed by txArray index */
+    uint16_t rank[CO_CONFIG_DRIVER_TX_QUEUE_SIZE];
+    /** txArray index of each buffer, indexed by priority rank */
+    uint16_t index[CO_CONFIG_DRIVER_TX_QUEUE_SIZE];
+    /** Number of buffers, from CO_CANtxQueue_init() */
+    uint16_t size;
+} CO_CANtxQueue_t;
+
+
+/**
+ * Initialize CAN transmit queue.
+ *
+ * All buffers have the same CAN identifier and are not pending. Function is
+ * called from CO_CANmodule_init().
+ *
+ * @param q This object.
+ * @param size Number of transmit buffers, must not be larger than
+ * @ref CO_CONFIG_DRIVER_TX_QUEUE_SIZE.
+ */
+void CO_CANtxQueue_init(CO_CANtxQueue_t *q, uint16_t size);
+
+
+/**
+ * Set CAN identifier of the transmit buffer and recalculate priority order.
+ *
+ * Function is called from CO_CANtxBufferInit(). Pending state of all buffers
+ * is preserved.
+ *
+ * @param q This object.
+ * @param index Index of the buffer in txArray.
+ * @param ident 11-bit CAN identifier.
+ */
+void CO_CANtxQueue_setIdent(CO_CANtxQueue_t *q, uint16_t index, uint16_t ident);
+
+
+/**
+ * Mark transmit buffer as pending.
+ *
+ * @param q This object.
+ * @param index Index of the buffer in txArray.
+ */
+void CO_CANtxQueue_push(CO_CANtxQueue_t *q, uint16_t index);
+
+
+/**
+ * Remove pending mark from transmit buffer.
+ *
+ * @param q This object.
+ * @param index Index of the buffer in txArray.
+ */
+void CO_CANtxQueue_remove(CO_CANtxQueue_t *q, uint16_t index);
+
+
+/**
+ * Take pending buffer with the highest priority.
+ *
+ * @param q This object.
+ *
+ * @return Index of the buffer in txArray or @ref CO_CANtxQueue_NONE, if no
+ * buffer is pending. Returned buffer is not pending any more.
+ */
+uint16_t CO_CANtxQueue_pop(CO_CANtxQueue_t *q);
+
+/** @} */ /* CO_CANtxQueue */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* CO_CAN_TX_QUEUE_H */
@@ -33,6 +33,15 @@
     || (CO_CONFIG_EM_ERR_STATUS_BITS_COUNT % 8) != 0
  #error CO_CONFIG_EM_ERR_STATUS_BITS_COUNT is not correct
 #endif
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_COALESCE
+ #if !((CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER)
+  #error CO_CONFIG_EM_PROD_COALESCE requires CO_CONFIG_EM_PRODUCER
+ #endif
+ #if CO_CONFIG_EM_RATE_BURST < 1 || CO_CONFIG_EM_RATE_BURST > 255 \
+     || CO_CONFIG_EM_RATE_INTERVAL_US < 1
+  #error CO_CONFIG_EM_RATE_BURST or CO_CONFIG_EM_RATE_INTERVAL_US not correct
+ #endif
+#endif
 
 /* fifo buffer example for fifoSize = 7 (actual capacity = 6)                 *
  *                                                                            *
@@ -301,6 +310,9 @@ static ODR_t OD_write_statusBits(OD_stream_t *stream, const void *buf,
     }
 
     memcpy (&em->errorStatusBits[0], buf, countWrite);
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_STATUS_DIRTY
+    em->errorStatusDirty = 0xFFFFFFFFUL;
+#endif
 
     *countWritten = countWrite;
     return ODR_OK;
@@ -404,6 +416,9 @@ CO_ReturnError_t CO_EM_init(CO_EM_t *em,
         return CO_ERROR_OD_PARAMETERS;
     }
     *em->errorRegister = 0;
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_STATUS_DIRTY
+    em->errorStatusDirty = 0xFFFFFFFFUL;
+#endif
 
 #if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
     em->fifo = fifo;
@@ -484,6 +499,10 @@ CO_ReturnError_t CO_EM_init(CO_EM_t *em,
         OD_extension_init(OD_1015_InhTime, &em->OD_1015_extension);
     }
  #endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_INHIBIT */
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_COALESCE
+    em->tokens = CO_CONFIG_EM_RATE_BURST;
+    em->tokenTimer_us = 0;
+ #endif
 #endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER */
 
 
@@ -550,6 +569,35 @@ void CO_EM_initCallbackPre(CO_EM_t *em,
 #endif
 
 
+/* Calculate Error register from errorStatusBits */
+static uint8_t calculateErrorRegister(CO_EM_t *em) {
+    uint8_t errorRegister = 0U;
+    if (CO_CONFIG_ERR_CONDITION_GENERIC)
+        errorRegister |= CO_ERR_REG_GENERIC_ERR;
+#ifdef CO_CONFIG_ERR_CONDITION_CURRENT
+    if (CO_CONFIG_ERR_CONDITION_CURRENT)
+        errorRegister |= CO_ERR_REG_CURRENT;
+#endif
+#ifdef CO_CONFIG_ERR_CONDITION_VOLTAGE
+    if (CO_CONFIG_ERR_CONDITION_VOLTAGE)
+        errorRegister |= CO_ERR_REG_VOLTAGE;
+#endif
+#ifdef CO_CONFIG_ERR_CONDITION_TEMPERATURE
+    if (CO_CONFIG_ERR_CONDITION_TEMPERATURE)
+        errorRegister |= CO_ERR_REG_TEMPERATURE;
+#endif
+    if (CO_CONFIG_ERR_CONDITION_COMMUNICATION)
+        errorRegister |= CO_ERR_REG_COMMUNICATION;
+#ifdef CO_CONFIG_ERR_CONDITION_DEV_PROFILE
+    if (CO_CONFIG_ERR_CONDITION_DEV_PROFILE)
+        errorRegister |= CO_ERR_REG_DEV_PROFILE;
+#endif
+    if (CO_CONFIG_ERR_CONDITION_MANUFACTURER)
+        errorRegister |= CO_ERR_REG_MANUFACTURER;
+    return errorRegister;
+}
+
+
 /******************************************************************************/
 void CO_EM_process(CO_EM_t *em,
                    bool_t NMTisPreOrOperational,
@@ -595,29 +643,21 @@ void CO_EM_process(CO_EM_t *em,
     }
 
     /* calculate Error register */
-    uint8_t errorRegister = 0U;
-    if (CO_CONFIG_ERR_CONDITION_GENERIC)
-        errorRegister |= CO_ERR_REG_GENERIC_ERR;
-#ifdef CO_CONFIG_ERR_CONDITION_CURRENT
-    if (CO_CONFIG_ERR_CONDITION_CURRENT)
-        errorRegister |= CO_ERR_REG_CURRENT;
-#endif
-#ifdef CO_CONFIG_ERR_CONDITION_VOLTAGE
-    if (CO_CONFIG_ERR_CONDITION_VOLTAGE)
-        errorRegister |= CO_ERR_REG_VOLTAGE;
-#endif
-#ifdef CO_CONFIG_ERR_CONDITION_TEMPERATURE
-    if (CO_CONFIG_ERR_CONDITION_TEMPERATURE)
-        errorRegister |= CO_ERR_REG_TEMPERATURE;
-#endif
-    if (CO_CONFIG_ERR_CONDITION_COMMUNICATION)
-        errorRegister |= CO_ERR_REG_COMMUNICATION;
-#ifdef CO_CONFIG_ERR_CONDITION_DEV_PROFILE
-    if (CO_CONFIG_ERR_CONDITION_DEV_PROFILE)
-        errorRegister |= CO_ERR_REG_DEV_PROFILE;
+    uint8_t errorRegister;
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_STATUS_DIRTY
+    /* recalculate only after change of errorStatusBits */
+    if (em->errorStatusDirty == 0) {
+        errorRegister = *em->errorRegister;
+    }
+    else {
+        CO_LOCK_EMCY(em->CANdevTx);
+        em->errorStatusDirty = 0;
+        CO_UNLOCK_EMCY(em->CANdevTx);
+        errorRegister = calculateErrorRegister(em);
+    }
+#else
+    errorRegister = calculateErrorRegister(em);
 #endif
-    if (CO_CONFIG_ERR_CONDITION_MANUFACTURER)
-        errorRegister |= CO_ERR_REG_MANUFACTURER;
     *em->errorRegister = errorRegister;
 
     if (!NMTisPreOrOperational) {
@@ -629,24 +669,56 @@ void CO_EM_process(CO_EM_t *em,
     if (em->fifoSize >= 2) {
         uint8_t fifoPpPtr = em->fifoPpPtr;
 
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_COALESCE
+        /* add tokens to the token bucket */
+        if (em->tokens < CO_CONFIG_EM_RATE_BURST) {
+            uint32_t tokensNew;
+            em->tokenTimer_us += timeDifference_us;
+            tokensNew = em->tokenTimer_us / CO_CONFIG_EM_RATE_INTERVAL_US;
+            if (tokensNew >= (uint32_t)(CO_CONFIG_EM_RATE_BURST - em->tokens)) {
+                em->tokens = CO_CONFIG_EM_RATE_BURST;
+                em->tokenTimer_us = 0;
+            }
+            else {
+                em->tokens += (uint8_t)tokensNew;
+                em->tokenTimer_us -= tokensNew * CO_CONFIG_EM_RATE_INTERVAL_US;
+            }
+        }
+        bool_t tokenAvailable = em->tokens > 0;
+ #else
+        bool_t tokenAvailable = true;
+ #endif
+
  #if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_INHIBIT
         if (em->inhibitEmTimer < em->inhibitEmTime_us) {
             em->inhibitEmTimer += timeDifference_us;
         }
 
         if (fifoPpPtr != em->fifoWrPtr && !em->CANtxBuff->bufferFull
-            && em->inhibitEmTimer >= em->inhibitEmTime_us
+            && em->inhibitEmTimer >= em->inhibitEmTime_us && tokenAvailable
         ) {
             em->inhibitEmTimer = 0;
  #else
-        if (fifoPpPtr != em->fifoWrPtr && !em->CANtxBuff->bufferFull) {
+        if (fifoPpPtr != em->fifoWrPtr && !em->CANtxBuff->bufferFull
+            && tokenAvailable
+        ) {
+ #endif
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_COALESCE
+            /* CO_error() may merge new event into message, which is not yet
+             * post-processed. Take message out of the fifo safely. */
+            em->tokens--;
+            CO_LOCK_EMCY(em->CANdevTx);
  #endif
             /* add error register to emergency message */
             em->fifo[fifoPpPtr].msg |= (uint32_t) errorRegister << 16;
 
-            /* send emergency message */
-            memcpy(em->CANtxBuff->data, &em->fifo[fifoPpPtr].msg,
-                sizeof(em->CANtxBuff->data));
+            /* send emergency message, fifo entry holds all 8 bytes of it, while
+             * CANtxBuff->data may be larger with CO_CONFIG_DRIVER_FD */
+            memcpy(em->CANtxBuff->data, &em->fifo[fifoPpPtr].msg, 8);
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_COALESCE
+            em->fifoPpPtr = ((fifoPpPtr + 1) < em->fifoSize) ? fifoPpPtr + 1 : 0;
+            CO_UNLOCK_EMCY(em->CANdevTx);
+ #endif
             CO_CANsend(em->CANdevTx, em->CANtxBuff);
 
  #if (CO_CONFIG_EM) & CO_CONFIG_EM_CONSUMER
@@ -662,7 +734,9 @@ void CO_EM_process(CO_EM_t *em,
  #endif
 
             /* increment pointer */
+ #if !((CO_CONFIG_EM) & CO_CONFIG_EM_PROD_COALESCE)
             em->fifoPpPtr = (++fifoPpPtr < em->fifoSize) ? fifoPpPtr : 0;
+ #endif
 
             /* verify message buffer overflow. Clear error condition if all
              * messages from fifo buffer are processed */
@@ -688,6 +762,18 @@ void CO_EM_process(CO_EM_t *em,
             }
         }
   #endif
+ #endif
+ #if ((CO_CONFIG_EM) & CO_CONFIG_EM_PROD_COALESCE) \
+     && ((CO_CONFIG_EM) & CO_CONFIG_FLAG_TIMERNEXT)
+        if (timerNext_us != NULL && em->tokens == 0
+            && em->fifoPpPtr != em->fifoWrPtr
+        ) {
+            /* check again after next token is available */
+            uint32_t diff = CO_CONFIG_EM_RATE_INTERVAL_US - em->tokenTimer_us;
+            if (*timerNext_us > diff) {
+                *timerNext_us = diff;
+            }
+        }
  #endif
     }
 #elif (CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY
@@ -709,12 +795,24 @@ void CO_EM_process(CO_EM_t *em,
 }
 
 
-/******************************************************************************/
-void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
-              uint16_t errorCode, uint32_t infoCode)
+/* True, if error condition for errorBit will change with setError */
+static inline bool_t errorChanges(CO_EM_t *em, bool_t setError,
+                                  uint8_t errorBit)
 {
-    if (em == NULL) return;
+    /* if unsupported errorBit, change to 'CO_EM_WRONG_ERROR_REPORT' */
+    if ((errorBit >> 3) >= (CO_CONFIG_EM_ERR_STATUS_BITS_COUNT / 8)) {
+        errorBit = CO_EM_WRONG_ERROR_REPORT;
+    }
+    bool_t isSet = (em->errorStatusBits[errorBit >> 3]
+                    & (1 << (errorBit & 0x7))) != 0;
+    return setError ? !isSet : isSet;
+}
 
+/* Set or reset error condition and prepare emergency message. Must be called
+ * inside CO_LOCK_EMCY(). Returns true, if error condition changed. */
+static bool_t errorUpdate(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
+                          uint16_t errorCode, uint32_t infoCode)
+{
     uint8_t index = errorBit >> 3;
     uint8_t bitmask = 1 << (errorBit & 0x7);
 
@@ -733,12 +831,12 @@ void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
      * otherwise toggle bit and continue with error indication. */
     if (setError) {
         if (errorStatusBitMasked != 0) {
-            return;
+            return false;
         }
     }
     else {
         if (errorStatusBitMasked == 0) {
-            return;
+            return false;
         }
         errorCode = CO_EMC_NO_ERROR;
     }
@@ -746,16 +844,21 @@ void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
 #if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
     /* prepare emergency message. Error register will be added in post-process*/
     uint32_t errMsg = (uint32_t)errorBit << 24 | CO_SWAP_16(errorCode);
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_COALESCE
+    /* byte 7 of emergency message is used for count of merged events */
+    infoCode &= 0x00FFFFFFUL;
+ #endif
  #if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
     uint32_t infoCodeSwapped = CO_SWAP_32(infoCode);
  #endif
 #endif
 
-    /* safely write data, and increment pointers */
-    CO_LOCK_EMCY(em->CANdevTx);
+    /* write data, and increment pointers */
     if (setError) *errorStatusBits |= bitmask;
     else          *errorStatusBits &= ~bitmask;
-
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_STATUS_DIRTY
+    em->errorStatusDirty |= 1UL << index;
+#endif
 #if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
     if (em->fifoSize >= 2) {
         uint8_t fifoWrPtr = em->fifoWrPtr;
@@ -763,8 +866,54 @@ void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
         if (fifoWrPtrNext >= em->fifoSize) {
             fifoWrPtrNext = 0;
         }
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_COALESCE
+        /* search for the last two not yet sent messages with the same
+         * errorBit. Error status bit toggles on each event, so the last one
+         * has opposite and the previous one the same state as the new event*/
+        uint8_t last = fifoWrPtr;
+        uint8_t prev = fifoWrPtr;
+        for (uint8_t i = em->fifoPpPtr; i != fifoWrPtr; ) {
+            if ((uint8_t)(em->fifo[i].msg >> 24) == errorBit) {
+                prev = last;
+                last = i;
+            }
+            if (++i >= em->fifoSize) {
+                i = 0;
+            }
+        }
 
+        if (setError && prev != fifoWrPtr) {
+            /* Error was set and reset, both messages are not yet sent. Keep
+             * the "set" message, so its error code is sent and recorded in
+             * the error history, and remove the "reset" message. Both events
+             * are counted in byte 7 of the kept message. */
+            uint32_t info = CO_SWAP_32(em->fifo[prev].info);
+            uint16_t count = (uint16_t)(info >> 24) + 2;
+            if (count > 0xFF) {
+                count = 0xFF;
+            }
+            em->fifo[prev].info = CO_SWAP_32((info & 0x00FFFFFFUL)
+                                             | ((uint32_t)count << 24));
+
+            uint8_t i = last;
+            uint8_t iNext = i + 1;
+            if (iNext >= em->fifoSize) {
+                iNext = 0;
+            }
+            while (iNext != fifoWrPtr) {
+                em->fifo[i] = em->fifo[iNext];
+                i = iNext;
+                if (++iNext >= em->fifoSize) {
+                    iNext = 0;
+                }
+            }
+            em->fifoWrPtr = i;
+            if (em->fifoCount > 0) em->fifoCount--;
+        }
+        else if (fifoWrPtrNext == em->fifoPpPtr) {
+ #else
         if (fifoWrPtrNext == em->fifoPpPtr) {
+ #endif
             em->fifoOverflow = 1;
         }
         else {
@@ -778,8 +927,12 @@ void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
     }
 #endif /* (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY) */
 
-    CO_UNLOCK_EMCY(em->CANdevTx);
+    return true;
+}
 
+/* Inform application about new emergency message */
+static inline void errorSignal(CO_EM_t *em) {
+    (void) em; /* may be unused */
 #if (CO_CONFIG_EM) & CO_CONFIG_FLAG_CALLBACK_PRE
  #if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
     /* Optional signal to RTOS, which can resume task, which handles
@@ -790,3 +943,42 @@ void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
  #endif
 #endif
 }
+
+
+/******************************************************************************/
+void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
+              uint16_t errorCode, uint32_t infoCode)
+{
+    if (em == NULL || !errorChanges(em, setError, errorBit)) return;
+
+    /* safely write data, and increment pointers */
+    CO_LOCK_EMCY(em->CANdevTx);
+    bool_t changed = errorUpdate(em, setError, errorBit, errorCode, infoCode);
+    CO_UNLOCK_EMCY(em->CANdevTx);
+
+    if (changed) {
+        errorSignal(em);
+    }
+}
+
+
+/******************************************************************************/
+void CO_errorMulti(CO_EM_t *em, const CO_EM_error_t *errors, uint8_t count) {
+    bool_t changed = false;
+
+    if (em == NULL || errors == NULL) return;
+
+    CO_LOCK_EMCY(em->CANdevTx);
+    for (uint8_t i = 0; i < count; i++) {
+        if (errorUpdate(em, errors[i].setError, errors[i].errorBit,
+                        errors[i].errorCode, errors[i].infoCode)
+        ) {
+            changed = true;
+        }
+    }
+    CO_UNLOCK_EMCY(em->CANdevTx);
+
+    if (changed) {
+        errorSignal(em);
+    }
+}
@@ -39,6 +39,12 @@
 #ifndef CO_CONFIG_EM_ERR_STATUS_BITS_COUNT
 #define CO_CONFIG_EM_ERR_STATUS_BITS_COUNT (10*8)
 #endif
+#ifndef CO_CONFIG_EM_RATE_BURST
+#define CO_CONFIG_EM_RATE_BURST 8
+#endif
+#ifndef CO_CONFIG_EM_RATE_INTERVAL_US
+#define CO_CONFIG_EM_RATE_INTERVAL_US 10000
+#endif
 #ifndef CO_CONFIG_ERR_CONDITION_GENERIC
 #define CO_CONFIG_ERR_CONDITION_GENERIC (em->errorStatusBits[5] != 0)
 #endif
@@ -380,6 +386,11 @@ typedef struct {
 typedef struct {
     /** Bitfield for the internal indication of the error condition. */
     uint8_t errorStatusBits[CO_CONFIG_EM_ERR_STATUS_BITS_COUNT / 8];
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_STATUS_DIRTY) || defined CO_DOXYGEN
+    /** Bitmap of changed errorStatusBits bytes, bit 0 for errorStatusBits[0].
+     * Set by CO_error(), cleared by CO_EM_process(). */
+    volatile uint32_t errorStatusDirty;
+#endif
     /** Pointer to error register in object dictionary at 0x1001,00. */
     uint8_t *errorRegister;
     /** Old CAN error status bitfield */
@@ -434,6 +445,12 @@ typedef struct {
     /** Extension for OD object */
     OD_extension_t OD_1015_extension;
  #endif
+ #if ((CO_CONFIG_EM) & CO_CONFIG_EM_PROD_COALESCE) || defined CO_DOXYGEN
+    /** Available tokens for transmission, see @ref CO_CONFIG_EM_RATE_BURST */
+    uint8_t tokens;
+    /** Internal timer for adding tokens */
+    uint32_t tokenTimer_us;
+ #endif
 #endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER */
 
 #if ((CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY) || defined CO_DOXYGEN
@@ -615,6 +632,34 @@ void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
               uint16_t errorCode, uint32_t infoCode);
 
 
+/**
+ * Error condition for @ref CO_errorMulti()
+ */
+typedef struct {
+    /** True if error occurred or false if error resolved */
+    bool_t setError;
+    /** From @ref CO_EM_errorStatusBits_t */
+    uint8_t errorBit;
+    /** From @ref CO_EM_errorCode_t, ignored if setError is false */
+    uint16_t errorCode;
+    /** Additional information for bytes 4...7 of the Emergency message */
+    uint32_t infoCode;
+} CO_EM_error_t;
+
+
+/**
+ * Set or reset multiple error conditions.
+ *
+ * Same as calling @ref CO_error() for each element of the array, but
+ * CO_LOCK_EMCY() is taken and callback is signalled only once.
+ *
+ * @param em Emergency object.
+ * @param errors Array of error conditions.
+ * @param count Number of elements in array.
+ */
+void CO_errorMulti(CO_EM_t *em, const CO_EM_error_t *errors, uint8_t count);
+
+
 /**
  * Report error condition, for description of parameters see @ref CO_error.
  */
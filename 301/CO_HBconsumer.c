@@ -46,9 +46,28 @@ static void CO_HBcons_receive(void *object, void *msg) {
     uint8_t *data = CO_CANrxMsg_readData(msg);
 
     if (DLC == 1) {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+        bool_t queued = CO_FLAG_READ(HBconsNode->CANrxNew);
+#endif
         /* copy data and set 'new message' flag. */
         HBconsNode->NMTstate = (CO_NMT_internalState_t)data[0];
         CO_FLAG_SET(HBconsNode->CANrxNew);
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+        /* add node to the queue of received messages, if not already there */
+        if (!queued) {
+            CO_HBconsumer_t *HBcons = HBconsNode->HBcons;
+            uint8_t wr = HBcons->rxQueueWr;
+            uint8_t wrNext = (wr + 1) & 0x7F;
+            if (wrNext != HBcons->rxQueueRd) {
+                HBcons->rxQueue[wr] = HBconsNode->idx;
+                CO_MemoryBarrier();
+                HBcons->rxQueueWr = wrNext;
+            }
+            else {
+                CO_FLAG_SET(HBcons->rxQueueOverflow);
+            }
+        }
+#endif
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_CALLBACK_PRE
         /* Optional signal to RTOS, which can resume task, which handles HBcons. */
         if (HBconsNode->pFunctSignalPre != NULL) {
@@ -59,6 +78,126 @@ static void CO_HBcons_receive(void *object, void *msg) {
 }
 
 
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+#define HB_IDX_NONE 0xFFU
+
+/* true, if deadline a is before deadline b, timer overflow is considered */
+#define DEADLINE_BEFORE(a, b) ((int32_t)((uint32_t)(a) - (uint32_t)(b)) < 0)
+
+/* Place node idx to position pos inside heap */
+static void heapSet(CO_HBconsumer_t *HBcons, uint8_t pos, uint8_t idx) {
+    HBcons->heap[pos] = idx;
+    HBcons->monitoredNodes[idx].heapPos = pos;
+}
+
+/* Move node at position pos up or down, according to its deadline */
+static void heapSift(CO_HBconsumer_t *HBcons, uint8_t pos) {
+    CO_HBconsNode_t *nodes = HBcons->monitoredNodes;
+    uint8_t idx = HBcons->heap[pos];
+    uint32_t deadline = nodes[idx].deadline_us;
+
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (!DEADLINE_BEFORE(deadline,
+                             nodes[HBcons->heap[parent]].deadline_us)) {
+            break;
+        }
+        heapSet(HBcons, pos, HBcons->heap[parent]);
+        pos = parent;
+    }
+    for (;;) {
+        uint16_t child = 2 * (uint16_t)pos + 1;
+        if (child >= HBcons->heapCount) {
+            break;
+        }
+        if ((child + 1) < HBcons->heapCount
+            && DEADLINE_BEFORE(nodes[HBcons->heap[child + 1]].deadline_us,
+                               nodes[HBcons->heap[child]].deadline_us)
+        ) {
+            child++;
+        }
+        if (!DEADLINE_BEFORE(nodes[HBcons->heap[child]].deadline_us,
+                             deadline)) {
+            break;
+        }
+        heapSet(HBcons, pos, HBcons->heap[child]);
+        pos = (uint8_t)child;
+    }
+    heapSet(HBcons, pos, idx);
+}
+
+/* Insert node into heap or update its position after deadline change */
+static void heapUpdate(CO_HBconsumer_t *HBcons, CO_HBconsNode_t *node) {
+    if (node->heapPos == HB_IDX_NONE) {
+        heapSet(HBcons, HBcons->heapCount++, node->idx);
+    }
+    heapSift(HBcons, node->heapPos);
+}
+
+/* Remove node from heap, if there */
+static void heapRemove(CO_HBconsumer_t *HBcons, CO_HBconsNode_t *node) {
+    uint8_t pos = node->heapPos;
+
+    if (pos == HB_IDX_NONE) {
+        return;
+    }
+    node->heapPos = HB_IDX_NONE;
+    HBcons->heapCount--;
+    if (pos < HBcons->heapCount) {
+        heapSet(HBcons, pos, HBcons->heap[HBcons->heapCount]);
+        heapSift(HBcons, pos);
+    }
+}
+
+/* Update number of NMT operational nodes after NMTstate change */
+static void countOperational(CO_HBconsumer_t *HBcons, CO_HBconsNode_t *node) {
+    bool_t operational = node->NMTstate == CO_NMT_OPERATIONAL
+                         && node->HBstate != CO_HBconsumer_UNCONFIGURED;
+
+    if (operational != node->operational) {
+        node->operational = operational;
+        if (operational) {
+            HBcons->countOperational++;
+        }
+        else {
+            HBcons->countOperational--;
+        }
+    }
+}
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED */
+
+
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_BITMAP
+/* Set or clear bit in word, return changed bits */
+static uint32_t bitmapWrite(uint32_t *word, uint32_t bit, bool_t value) {
+    uint32_t old = *word;
+    *word = value ? (old | bit) : (old & ~bit);
+    return old ^ *word;
+}
+
+/* Update bitmaps for one node according to its HB and NMT state */
+static void bitmapUpdate(CO_HBconsumer_t *HBcons, uint8_t nodeId,
+                         CO_HBconsumer_state_t HBstate,
+                         CO_NMT_internalState_t NMTstate)
+{
+    if (nodeId == 0 || nodeId > 127) {
+        return;
+    }
+    uint8_t w = nodeId >> 5;
+    uint32_t bit = 1UL << (nodeId & 0x1F);
+    bool_t active = HBstate == CO_HBconsumer_ACTIVE;
+    uint32_t changed;
+
+    changed = bitmapWrite(&HBcons->bmActive[w], bit, active);
+    changed |= bitmapWrite(&HBcons->bmTimeout[w], bit,
+                           HBstate == CO_HBconsumer_TIMEOUT);
+    changed |= bitmapWrite(&HBcons->bmOperational[w], bit,
+                           active && NMTstate == CO_NMT_OPERATIONAL);
+    HBcons->bmChanged[w] |= changed;
+}
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_BITMAP */
+
+
 /*
  * Initialize one Heartbeat consumer entry
  *
@@ -142,6 +281,19 @@ CO_ReturnError_t CO_HBconsumer_init(CO_HBconsumer_t *HBcons,
         OD_1016_HBcons->subEntriesCount-1 < monitoredNodesCount ?
         OD_1016_HBcons->subEntriesCount-1 : monitoredNodesCount;
 
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+    memset(HBcons->nodeIdx, HB_IDX_NONE, sizeof(HBcons->nodeIdx));
+    for (uint8_t i = 0; i < HBcons->numberOfMonitoredNodes; i++) {
+        CO_HBconsNode_t *monitoredNode = &monitoredNodes[i];
+        monitoredNode->HBcons = HBcons;
+        monitoredNode->idx = i;
+        monitoredNode->heapPos = HB_IDX_NONE;
+        monitoredNode->operational = false;
+        monitoredNode->HBstate = CO_HBconsumer_UNCONFIGURED;
+        CO_FLAG_CLEAR(monitoredNode->CANrxNew);
+    }
+#endif
+
     for (uint8_t i = 0; i < HBcons->numberOfMonitoredNodes; i++) {
         uint32_t val;
         odRet = OD_get_u32(OD_1016_HBcons, i + 1, &val, true);
@@ -191,6 +343,15 @@ static CO_ReturnError_t CO_HBconsumer_initEntry(CO_HBconsumer_t *HBcons,
     }
 
     /* verify for duplicate entries */
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+    if (consumerTime_ms != 0 && nodeId != 0) {
+        if (nodeId > 127 || (HBcons->nodeIdx[nodeId] != HB_IDX_NONE
+                             && HBcons->nodeIdx[nodeId] != idx)
+        ) {
+            ret = CO_ERROR_OD_PARAMETERS;
+        }
+    }
+#else
     if(consumerTime_ms != 0 && nodeId != 0) {
         for (uint8_t i = 0; i < HBcons->numberOfMonitoredNodes; i++) {
             CO_HBconsNode_t node = HBcons->monitoredNodes[i];
@@ -199,15 +360,33 @@ static CO_ReturnError_t CO_HBconsumer_initEntry(CO_HBconsumer_t *HBcons,
             }
         }
     }
+#endif
 
     /* Configure one monitored node */
     if (ret == CO_ERROR_NO) {
         uint16_t COB_ID;
 
         CO_HBconsNode_t * monitoredNode = &HBcons->monitoredNodes[idx];
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+        /* remove previous configuration */
+        heapRemove(HBcons, monitoredNode);
+        if (monitoredNode->HBstate != CO_HBconsumer_UNCONFIGURED) {
+            HBcons->countConfigured--;
+            HBcons->nodeIdx[monitoredNode->nodeId] = HB_IDX_NONE;
+            monitoredNode->HBstate = CO_HBconsumer_UNCONFIGURED;
+        }
+        countOperational(HBcons, monitoredNode);
+#endif
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_BITMAP
+        if (monitoredNode->time_us != 0) {
+            bitmapUpdate(HBcons, monitoredNode->nodeId,
+                         CO_HBconsumer_UNCONFIGURED, CO_NMT_UNKNOWN);
+        }
+#endif
         monitoredNode->nodeId = nodeId;
         monitoredNode->time_us = (int32_t)consumerTime_ms * 1000;
         monitoredNode->NMTstate = CO_NMT_UNKNOWN;
+        monitoredNode->resetCount++;
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE \
     || (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
         monitoredNode->NMTstatePrev = CO_NMT_UNKNOWN;
@@ -218,6 +397,10 @@ static CO_ReturnError_t CO_HBconsumer_initEntry(CO_HBconsumer_t *HBcons,
         if (monitoredNode->nodeId != 0 && monitoredNode->time_us != 0) {
             COB_ID = monitoredNode->nodeId + CO_CAN_ID_HEARTBEAT;
             monitoredNode->HBstate = CO_HBconsumer_UNKNOWN;
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+            HBcons->countConfigured++;
+            HBcons->nodeIdx[nodeId] = idx;
+#endif
         }
         else {
             COB_ID = 0;
@@ -355,6 +538,167 @@ void CO_HBconsumer_initCallbackRemoteReset(
 #endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI */
 
 
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_BITMAP
+/******************************************************************************/
+void CO_HBconsumer_initCallbackChangedSet(
+        CO_HBconsumer_t        *HBcons,
+        void                   *object,
+        void                  (*pFunctSignal)(const uint32_t *changed,
+                                              void *object))
+{
+    if (HBcons != NULL) {
+        HBcons->functSignalObjectChangedSet = object;
+        HBcons->pFunctSignalChangedSet = pFunctSignal;
+    }
+}
+#endif
+
+
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+/* Update counters and inform application after NMT state of node changed */
+static void nodeChanged(CO_HBconsumer_t *HBcons, CO_HBconsNode_t *monitoredNode) {
+    countOperational(HBcons, monitoredNode);
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_BITMAP
+    bitmapUpdate(HBcons, monitoredNode->nodeId, monitoredNode->HBstate,
+                 monitoredNode->NMTstate);
+#endif
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE \
+    || (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+    /* Verify, if NMT state of monitored node changed */
+    if(monitoredNode->NMTstate != monitoredNode->NMTstatePrev) {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE
+        if (HBcons->pFunctSignalNmtChanged != NULL) {
+            HBcons->pFunctSignalNmtChanged(
+                monitoredNode->nodeId, monitoredNode->idx,
+                monitoredNode->NMTstate,
+                HBcons->pFunctSignalObjectNmtChanged);
+#else
+        if (monitoredNode->pFunctSignalNmtChanged != NULL) {
+            monitoredNode->pFunctSignalNmtChanged(
+                monitoredNode->nodeId, monitoredNode->idx,
+                monitoredNode->NMTstate,
+                monitoredNode->pFunctSignalObjectNmtChanged);
+#endif
+        }
+        monitoredNode->NMTstatePrev = monitoredNode->NMTstate;
+    }
+#endif
+}
+
+
+/* Process received heartbeat or bootup message of one monitored node */
+static void processRx(CO_HBconsumer_t *HBcons, CO_HBconsNode_t *monitoredNode) {
+    if (monitoredNode->HBstate == CO_HBconsumer_UNCONFIGURED
+        || !CO_FLAG_READ(monitoredNode->CANrxNew)
+    ) {
+        return;
+    }
+    /* clear flag before reading NMTstate, so new message is queued again */
+    CO_FLAG_CLEAR(monitoredNode->CANrxNew);
+
+    if (monitoredNode->NMTstate == CO_NMT_INITIALIZING) {
+        /* bootup message*/
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+        if (monitoredNode->pFunctSignalRemoteReset != NULL) {
+            monitoredNode->pFunctSignalRemoteReset(
+                monitoredNode->nodeId, monitoredNode->idx,
+                monitoredNode->functSignalObjectRemoteReset);
+        }
+#endif
+        if (monitoredNode->HBstate == CO_HBconsumer_ACTIVE) {
+            CO_errorReport(HBcons->em, CO_EM_HB_CONSUMER_REMOTE_RESET,
+                           CO_EMC_HEARTBEAT, monitoredNode->idx);
+        }
+        monitoredNode->HBstate = CO_HBconsumer_UNKNOWN;
+        monitoredNode->resetCount++;
+        heapRemove(HBcons, monitoredNode);
+    }
+    else {
+        /* heartbeat message */
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+        if (monitoredNode->HBstate != CO_HBconsumer_ACTIVE &&
+            monitoredNode->pFunctSignalHbStarted != NULL) {
+            monitoredNode->pFunctSignalHbStarted(
+                monitoredNode->nodeId, monitoredNode->idx,
+                monitoredNode->functSignalObjectHbStarted);
+        }
+#endif
+        monitoredNode->HBstate = CO_HBconsumer_ACTIVE;
+        /* reset timer */
+        monitoredNode->deadline_us = HBcons->timer_us + monitoredNode->time_us;
+        heapUpdate(HBcons, monitoredNode);
+    }
+    nodeChanged(HBcons, monitoredNode);
+}
+
+
+/* Process received messages and expired timeouts only */
+static void processIndexed(CO_HBconsumer_t *HBcons,
+                           uint32_t timeDifference_us,
+                           uint32_t *timerNext_us)
+{
+    (void)timerNext_us; /* may be unused */
+
+    CO_HBconsNode_t *monitoredNodes = HBcons->monitoredNodes;
+    uint8_t wr;
+
+    HBcons->timer_us += timeDifference_us;
+
+    /* queue was full, verify all nodes */
+    if (CO_FLAG_READ(HBcons->rxQueueOverflow)) {
+        CO_FLAG_CLEAR(HBcons->rxQueueOverflow);
+        HBcons->rxQueueRd = HBcons->rxQueueWr;
+        for (uint8_t i = 0; i < HBcons->numberOfMonitoredNodes; i++) {
+            processRx(HBcons, &monitoredNodes[i]);
+        }
+    }
+
+    /* nodes with received message */
+    wr = HBcons->rxQueueWr;
+    CO_MemoryBarrier();
+    while (HBcons->rxQueueRd != wr) {
+        uint8_t idx = HBcons->rxQueue[HBcons->rxQueueRd];
+        HBcons->rxQueueRd = (HBcons->rxQueueRd + 1) & 0x7F;
+        processRx(HBcons, &monitoredNodes[idx]);
+    }
+
+    /* nodes with expired timeout are on the top of the heap */
+    while (HBcons->heapCount > 0) {
+        CO_HBconsNode_t * const monitoredNode = &monitoredNodes[HBcons->heap[0]];
+
+        if (DEADLINE_BEFORE(HBcons->timer_us, monitoredNode->deadline_us)) {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_TIMERNEXT
+            if (timerNext_us != NULL) {
+                /* Calculate timerNext_us for next timeout checking. */
+                uint32_t diff = monitoredNode->deadline_us - HBcons->timer_us;
+                if (*timerNext_us > diff) {
+                    *timerNext_us = diff;
+                }
+            }
+#endif
+            break;
+        }
+
+        /* timeout expired */
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+        if (monitoredNode->pFunctSignalTimeout!=NULL) {
+            monitoredNode->pFunctSignalTimeout(
+                monitoredNode->nodeId, monitoredNode->idx,
+                monitoredNode->functSignalObjectTimeout);
+        }
+#endif
+        CO_errorReport(HBcons->em, CO_EM_HEARTBEAT_CONSUMER,
+                       CO_EMC_HEARTBEAT, monitoredNode->idx);
+        monitoredNode->NMTstate = CO_NMT_UNKNOWN;
+        monitoredNode->HBstate = CO_HBconsumer_TIMEOUT;
+        monitoredNode->resetCount++;
+        heapRemove(HBcons, monitoredNode);
+        nodeChanged(HBcons, monitoredNode);
+    }
+}
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED */
+
+
 /******************************************************************************/
 void CO_HBconsumer_process(
         CO_HBconsumer_t        *HBcons,
@@ -368,6 +712,13 @@ void CO_HBconsumer_process(
     bool_t allMonitoredOperationalCurrent = true;
 
     if (NMTisPreOrOperational && HBcons->NMTisPreOrOperationalPrev) {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+        processIndexed(HBcons, timeDifference_us, timerNext_us);
+        allMonitoredActiveCurrent =
+            HBcons->heapCount == HBcons->countConfigured;
+        allMonitoredOperationalCurrent =
+            HBcons->countOperational == HBcons->countConfigured;
+#else
         for (uint8_t i=0; i<HBcons->numberOfMonitoredNodes; i++) {
             uint32_t timeDifference_us_copy = timeDifference_us;
             CO_HBconsNode_t * const monitoredNode = &HBcons->monitoredNodes[i];
@@ -393,7 +744,7 @@ void CO_HBconsumer_process(
                                        CO_EMC_HEARTBEAT, i);
                     }
                     monitoredNode->HBstate = CO_HBconsumer_UNKNOWN;
-
+                    monitoredNode->resetCount++;
                 }
                 else {
                     /* heartbeat message */
@@ -430,6 +781,7 @@ void CO_HBconsumer_process(
                                    CO_EMC_HEARTBEAT, i);
                     monitoredNode->NMTstate = CO_NMT_UNKNOWN;
                     monitoredNode->HBstate = CO_HBconsumer_TIMEOUT;
+                    monitoredNode->resetCount++;
                 }
 
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_TIMERNEXT
@@ -468,14 +820,29 @@ void CO_HBconsumer_process(
                 }
                 monitoredNode->NMTstatePrev = monitoredNode->NMTstate;
             }
+#endif
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_BITMAP
+            bitmapUpdate(HBcons, monitoredNode->nodeId, monitoredNode->HBstate,
+                         monitoredNode->NMTstate);
 #endif
         }
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED */
     }
     else if (NMTisPreOrOperational || HBcons->NMTisPreOrOperationalPrev) {
         /* (pre)operational state changed, clear variables */
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+        HBcons->rxQueueRd = HBcons->rxQueueWr;
+        CO_FLAG_CLEAR(HBcons->rxQueueOverflow);
+        HBcons->heapCount = 0;
+        HBcons->countOperational = 0;
+#endif
         for(uint8_t i=0; i<HBcons->numberOfMonitoredNodes; i++) {
             CO_HBconsNode_t * const monitoredNode = &HBcons->monitoredNodes[i];
             monitoredNode->NMTstate = CO_NMT_UNKNOWN;
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+            monitoredNode->heapPos = HB_IDX_NONE;
+            monitoredNode->operational = false;
+#endif
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE \
     || (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
             monitoredNode->NMTstatePrev = CO_NMT_UNKNOWN;
@@ -483,12 +850,32 @@ void CO_HBconsumer_process(
             CO_FLAG_CLEAR(monitoredNode->CANrxNew);
             if (monitoredNode->HBstate != CO_HBconsumer_UNCONFIGURED) {
                 monitoredNode->HBstate = CO_HBconsumer_UNKNOWN;
+                monitoredNode->resetCount++;
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_BITMAP
+                bitmapUpdate(HBcons, monitoredNode->nodeId,
+                             monitoredNode->HBstate, monitoredNode->NMTstate);
+#endif
             }
         }
         allMonitoredActiveCurrent = false;
         allMonitoredOperationalCurrent = false;
     }
 
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_BITMAP
+    /* Inform application once about all changed nodes */
+    uint32_t changedAny = 0;
+    for (uint8_t i = 0; i < CO_HBconsumer_BITMAP_WORDS; i++) {
+        changedAny |= HBcons->bmChanged[i];
+    }
+    if (changedAny != 0) {
+        if (HBcons->pFunctSignalChangedSet != NULL) {
+            HBcons->pFunctSignalChangedSet(HBcons->bmChanged,
+                                           HBcons->functSignalObjectChangedSet);
+        }
+        memset(HBcons->bmChanged, 0, sizeof(HBcons->bmChanged));
+    }
+#endif
+
     /* Clear emergencies when all monitored nodes becomes active.
      * We only have one emergency index for all monitored nodes! */
     if (!HBcons->allMonitoredActive && allMonitoredActiveCurrent) {
@@ -508,13 +895,19 @@ int8_t CO_HBconsumer_getIdxByNodeId(
         CO_HBconsumer_t        *HBcons,
         uint8_t                 nodeId)
 {
-    uint8_t i;
-    CO_HBconsNode_t *monitoredNode;
-
     if (HBcons == NULL) {
         return -1;
     }
 
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+    /* direct lookup in the table */
+    if (nodeId <= 127 && HBcons->nodeIdx[nodeId] != HB_IDX_NONE) {
+        return (int8_t)HBcons->nodeIdx[nodeId];
+    }
+#else
+    uint8_t i;
+    CO_HBconsNode_t *monitoredNode;
+
     /* linear search for the node */
     monitoredNode = &HBcons->monitoredNodes[0];
     for(i=0; i<HBcons->numberOfMonitoredNodes; i++){
@@ -523,6 +916,7 @@ int8_t CO_HBconsumer_getIdxByNodeId(
         }
         monitoredNode ++;
     }
+#endif
     /* not found */
     return -1;
 }
@@ -74,6 +74,14 @@ typedef enum {
   CO_HBconsumer_TIMEOUT      = 0x03U,     /**< No heatbeat received for set time */
 } CO_HBconsumer_state_t;
 
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_BITMAP) || defined CO_DOXYGEN
+/** Number of 32-bit words in node-ID bitmap. Bit (nodeId & 0x1F) in word
+ * (nodeId >> 5) corresponds to node-ID, bit for node-ID 0 is not used. */
+#define CO_HBconsumer_BITMAP_WORDS 4
+#endif
+
+
+struct CO_HBconsumer;
 
 /**
  * One monitored node inside CO_HBconsumer_t.
@@ -85,12 +93,29 @@ typedef struct {
     CO_NMT_internalState_t NMTstate;
     /** Current heartbeat monitoring state of the remote node */
     CO_HBconsumer_state_t HBstate;
-    /** Time since last heartbeat received */
+    /** Time since last heartbeat received, not used with
+     * CO_CONFIG_HB_CONS_INDEXED, see deadline_us */
     uint32_t timeoutTimer;
     /** Consumer heartbeat time from OD */
     uint32_t time_us;
     /** Indication if new Heartbeat message received from the CAN bus */
     volatile void *CANrxNew;
+    /** Incremented on boot-up message, heartbeat timeout, restart of
+     * monitoring and reconfiguration of this entry. Data of the remote node,
+     * kept by the application, are not valid any more, if value changes. */
+    uint16_t resetCount;
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED) || defined CO_DOXYGEN
+    /** Heartbeat consumer object, which contains this node */
+    struct CO_HBconsumer *HBcons;
+    /** Index of this node inside CO_HBconsumer_t */
+    uint8_t idx;
+    /** Position inside deadline heap or 0xFF, if node is not active */
+    uint8_t heapPos;
+    /** True, if node is counted as NMT operational */
+    bool_t operational;
+    /** Time of heartbeat timeout, relative to timer inside CO_HBconsumer_t */
+    uint32_t deadline_us;
+#endif
 #if ((CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_CALLBACK_PRE) || defined CO_DOXYGEN
     /** From CO_HBconsumer_initCallbackPre() or NULL */
     void (*pFunctSignalPre)(void *object);
@@ -136,7 +161,7 @@ typedef struct {
  * Object is initilaized by CO_HBconsumer_init(). It contains an array of
  * CO_HBconsNode_t objects.
  */
-typedef struct {
+typedef struct CO_HBconsumer {
     /** From CO_HBconsumer_init() */
     CO_EM_t *em;
     /** Array of monitored nodes, from CO_HBconsumer_init() */
@@ -156,6 +181,45 @@ typedef struct {
     CO_CANmodule_t *CANdevRx;
     /** From CO_HBconsumer_init() */
     uint16_t CANdevRxIdxStart;
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED) || defined CO_DOXYGEN
+    /** Index of monitored node for each node-ID or 0xFF, if not monitored */
+    uint8_t nodeIdx[128];
+    /** Indexes of active nodes, ordered as binary min-heap by deadline_us */
+    uint8_t heap[127];
+    /** Number of nodes in heap, equal to number of active nodes */
+    uint8_t heapCount;
+    /** Number of configured nodes */
+    uint8_t countConfigured;
+    /** Number of configured nodes in NMT operational state */
+    uint8_t countOperational;
+    /** Circular queue of indexes of nodes with received message. Written from
+     * CAN receive function, each node is inside queue only once. */
+    uint8_t rxQueue[128];
+    /** Write index in rxQueue, changed only by CAN receive function */
+    volatile uint8_t rxQueueWr;
+    /** Read index in rxQueue */
+    uint8_t rxQueueRd;
+    /** Set by CAN receive function, if rxQueue is full */
+    volatile void *rxQueueOverflow;
+    /** Timer, incremented by timeDifference_us in (pre)operational state */
+    uint32_t timer_us;
+#endif
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_BITMAP) || defined CO_DOXYGEN
+    /** Bitmap of monitored nodes with HB state #CO_HBconsumer_ACTIVE. Can be
+     * read by the application, see also CO_HBconsumer_bitmapContains(). */
+    uint32_t bmActive[CO_HBconsumer_BITMAP_WORDS];
+    /** Bitmap of monitored nodes with HB state #CO_HBconsumer_TIMEOUT */
+    uint32_t bmTimeout[CO_HBconsumer_BITMAP_WORDS];
+    /** Bitmap of active monitored nodes in NMT operational state */
+    uint32_t bmOperational[CO_HBconsumer_BITMAP_WORDS];
+    /** Bitmap of nodes, which changed any of the above bits since last
+     * callback from CO_HBconsumer_initCallbackChangedSet() */
+    uint32_t bmChanged[CO_HBconsumer_BITMAP_WORDS];
+    /** From CO_HBconsumer_initCallbackChangedSet() or NULL */
+    void (*pFunctSignalChangedSet)(const uint32_t *changed, void *object);
+    /** From CO_HBconsumer_initCallbackChangedSet() or NULL */
+    void *functSignalObjectChangedSet;
+#endif
 #if ((CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_OD_DYNAMIC) || defined CO_DOXYGEN
     /** Extension for OD object */
     OD_extension_t OD_1016_extension;
@@ -300,6 +364,63 @@ void CO_HBconsumer_initCallbackRemoteReset(
         void                  (*pFunctSignal)(uint8_t nodeId, uint8_t idx, void *object));
 #endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI */
 
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_BITMAP) || defined CO_DOXYGEN
+/**
+ * Initialize Heartbeat consumer changed set callback function.
+ *
+ * Function initializes optional callback function, which is called at most
+ * once per CO_HBconsumer_process() call, if any bit in bmActive, bmTimeout or
+ * bmOperational changed. Argument _changed_ is a bitmap of
+ * #CO_HBconsumer_BITMAP_WORDS words with set bits for all changed nodes. New
+ * states are available in bitmaps inside CO_HBconsumer_t.
+ *
+ * @param HBcons This object.
+ * @param object Pointer to object, which will be passed to pFunctSignal(). Can be NULL
+ * @param pFunctSignal Pointer to the callback function. Not called if NULL.
+ */
+void CO_HBconsumer_initCallbackChangedSet(
+        CO_HBconsumer_t        *HBcons,
+        void                   *object,
+        void                  (*pFunctSignal)(const uint32_t *changed,
+                                              void *object));
+
+/**
+ * Verify, if all nodes from set are also in bitmap.
+ *
+ * For example, application can check, if all drives are operational with
+ * `CO_HBconsumer_bitmapContains(HBcons->bmOperational, drives)`.
+ *
+ * @param bitmap Bitmap from CO_HBconsumer_t.
+ * @param set Bitmap of #CO_HBconsumer_BITMAP_WORDS words with required nodes.
+ *
+ * @return True, if all nodes from set are in bitmap.
+ */
+static inline bool_t CO_HBconsumer_bitmapContains(const uint32_t *bitmap,
+                                                  const uint32_t *set)
+{
+    uint32_t missing = 0;
+    for (uint8_t i = 0; i < CO_HBconsumer_BITMAP_WORDS; i++) {
+        missing |= set[i] & ~bitmap[i];
+    }
+    return missing == 0;
+}
+
+/**
+ * Verify, if node is set in bitmap.
+ *
+ * @param bitmap Bitmap from CO_HBconsumer_t.
+ * @param nodeId Node-ID, 1 to 127.
+ *
+ * @return True, if bit for nodeId is set.
+ */
+static inline bool_t CO_HBconsumer_bitmapTest(const uint32_t *bitmap,
+                                              uint8_t nodeId)
+{
+    return nodeId <= 127
+           && (bitmap[nodeId >> 5] & (1UL << (nodeId & 0x1F))) != 0;
+}
+#endif
+
 /**
  * Process Heartbeat consumer object.
  *
@@ -323,7 +444,8 @@ void CO_HBconsumer_process(
  *
  * @param HBcons This object.
  * @param nodeId producer node ID
- * @return index. -1 if not found
+ * @return index. -1 if not found. With CO_CONFIG_HB_CONS_INDEXED only indexes
+ * of configured nodes are found, lookup then takes constant time.
  */
 int8_t CO_HBconsumer_getIdxByNodeId(
         CO_HBconsumer_t        *HBcons,
@@ -26,6 +26,48 @@
 #define OD_DEFINITION
 #include "301/CO_ODinterface.h"
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_REQUEST_COUNT
+volatile uint32_t OD_TPDOrequestCount = 0;
+#endif
+
+#if OD_WRITE_OBSERVER
+/* List of Object Dictionaries with write observer */
+static OD_t *OD_writeObserverList = NULL;
+
+void OD_setWriteObserver(OD_t *od, void *object,
+                         void (*observer)(void *object, const void *dataOrig,
+                                          OD_size_t len))
+{
+    if (od == NULL) {
+        return;
+    }
+
+    od->writeObserverObject = object;
+    od->writeObserver = observer;
+
+    /* add to the list, if not already there */
+    for (OD_t *odObs = OD_writeObserverList; odObs != NULL;
+         odObs = odObs->writeObserverNext
+    ) {
+        if (odObs == od) {
+            return;
+        }
+    }
+    od->writeObserverNext = OD_writeObserverList;
+    OD_writeObserverList = od;
+}
+
+void OD_notifyWrite(const void *dataOrig, OD_size_t len) {
+    for (OD_t *od = OD_writeObserverList; od != NULL;
+         od = od->writeObserverNext
+    ) {
+        if (od->writeObserver != NULL) {
+            od->writeObserver(od->writeObserverObject, dataOrig, len);
+        }
+    }
+}
+#endif
+
 
 /******************************************************************************/
 ODR_t OD_readOriginal(OD_stream_t *stream, void *buf,
@@ -117,6 +159,9 @@ ODR_t OD_writeOriginal(OD_stream_t *stream, const void *buf,
     }
 
     memcpy(dataOrig, buf, dataLenToCopy);
+#if OD_WRITE_OBSERVER
+    OD_notifyWrite(dataOrig, dataLenToCopy);
+#endif
 
     *countWritten = dataLenToCopy;
     return returnCode;
@@ -145,6 +190,16 @@ OD_entry_t *OD_find(OD_t *od, uint16_t index) {
         return NULL;
     }
 
+#if OD_FIND_CACHE_SIZE > 0
+    /* Direct-mapped cache, mix high byte of the index into the slot number */
+    OD_entry_t **cached = &od->findCache[(index ^ (index >> 8))
+                                         & (OD_FIND_CACHE_SIZE - 1)];
+    OD_entry_t *entryCached = *cached;
+    if (entryCached != NULL && entryCached->index == index) {
+        return entryCached;
+    }
+#endif
+
     uint16_t min = 0;
     uint16_t max = od->size - 1;
 
@@ -157,6 +212,9 @@ OD_entry_t *OD_find(OD_t *od, uint16_t index) {
         OD_entry_t* entry = &od->list[cur];
 
         if (index == entry->index) {
+#if OD_FIND_CACHE_SIZE > 0
+            *cached = entry;
+#endif
             return entry;
         }
 
@@ -171,6 +229,9 @@ OD_entry_t *OD_find(OD_t *od, uint16_t index) {
     if (min == max) {
         OD_entry_t* entry = &od->list[min];
         if (index == entry->index) {
+#if OD_FIND_CACHE_SIZE > 0
+            *cached = entry;
+#endif
             return entry;
         }
     }
@@ -233,6 +294,34 @@ ODR_t OD_getSub(const OD_entry_t *entry, uint8_t subIndex,
         stream->dataLength = odo->dataLength;
         break;
     }
+#if OD_COMPACT
+    case ODT_CMP: {
+        CO_PROGMEM OD_obj_compact_t *odo = entry->odObject;
+        CO_PROGMEM OD_obj_compactSub_t *sub = NULL;
+
+        /* consecutive sub-indexes are found directly */
+        if (subIndex < entry->subEntriesCount
+            && odo->sub[subIndex].subIndex == subIndex
+        ) {
+            sub = &odo->sub[subIndex];
+        }
+        else {
+            for (uint8_t i = 0; i < entry->subEntriesCount; i++) {
+                if (odo->sub[i].subIndex == subIndex) {
+                    sub = &odo->sub[i];
+                    break;
+                }
+            }
+        }
+        if (sub == NULL) return ODR_SUB_NOT_EXIST;
+
+        stream->attribute = sub->attribute;
+        stream->dataOrig = sub->offset == OD_COMPACT_NO_DATA ? NULL
+                         : (uint8_t *)odo->dataBase + sub->offset;
+        stream->dataLength = sub->dataLength;
+        break;
+    }
+#endif
     default: {
         return ODR_DEV_INCOMPAT;
     }
@@ -329,6 +418,23 @@ ODR_t OD_set_value(const OD_entry_t *entry, uint8_t subIndex, void *val,
     return io.write(stream, val, len, &countWritten);
 }
 
+ODR_t OD_handleInit(OD_handle_t *handle, const OD_entry_t *entry,
+                    uint8_t subIndex, bool_t odOrig)
+{
+    if (handle == NULL) return ODR_DEV_INCOMPAT;
+
+    handle->data = NULL;
+    ODR_t ret = OD_getSub(entry, subIndex, &handle->io, odOrig);
+
+    /* direct access, if there is no extension */
+    if (ret == ODR_OK && handle->io.read == OD_readOriginal
+        && handle->io.write == OD_writeOriginal
+    ) {
+        handle->data = handle->io.stream.dataOrig;
+    }
+    return ret;
+}
+
 void *OD_getPtr(const OD_entry_t *entry, uint8_t subIndex, OD_size_t len,
                 ODR_t *err)
 {
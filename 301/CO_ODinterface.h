@@ -53,6 +53,36 @@ typedef uint8_t OD_attr_t;
 #define OD_FLAGS_PDO_SIZE 4
 #endif
 
+#ifndef OD_FIND_CACHE_SIZE
+/** Size of direct-mapped cache of OD entries inside @ref OD_t, used by
+ * @ref OD_find(). Cache is keyed by OD index and avoids binary search for
+ * frequently accessed entries. Must be 0 (cache disabled) or power of 2.
+ * If enabled, OD_find() may be called from different threads only, if writing
+ * a pointer is atomic operation on the target. */
+#define OD_FIND_CACHE_SIZE 0
+#endif
+
+#ifndef OD_EXTENSION_VIEW
+/** If set to 1, then @ref OD_extension_t contains optional view() function,
+ * which exposes OD variable as contiguous read-only memory. SDO server then
+ * uploads data directly from that memory, without intermediate buffer. */
+#define OD_EXTENSION_VIEW 0
+#endif
+
+#ifndef OD_WRITE_OBSERVER
+/** If set to 1, then @ref OD_t contains optional write observer, see
+ * @ref OD_setWriteObserver(). It is required by
+ * CO_CONFIG_STORAGE_AUTO_DIRTY. */
+#define OD_WRITE_OBSERVER 0
+#endif
+
+#ifndef OD_COMPACT
+/** If set to 1, then @ref OD_getSub() also handles OD objects of type
+ * @ref ODT_CMP, which store 16-bit offsets from a common data block instead of
+ * pointers, see @ref OD_obj_compact_t. */
+#define OD_COMPACT 0
+#endif
+
 #ifndef CO_PROGMEM
 /** Modifier for OD objects. This is large amount of data and is specified in
  * Object Dictionary (OD.c file usually) */
@@ -143,6 +173,10 @@ typedef enum {
 /* !!!! WARNING !!!!
  * If changing these values, change also OD_getSDOabCode() function!
  */
+    /** Read/write is in progress (for example slow backing store is accessed
+     * by DMA or by another thread), no data were transferred. Make the same
+     * call again later, see @ref OD_IO_t. */
+    ODR_PENDING = -2,
     /** Read/write is only partial, make more calls */
     ODR_PARTIAL = -1,
     /** SDO abort 0x00000000 - Read/write successfully finished */
@@ -257,6 +291,15 @@ typedef struct {
      * not large enough. ("*returnCode" must not return 'ODR_PARTIAL', if there
      * is still space in "buf".)
      *
+     * If data are not available yet, "read" function may start the operation
+     * (DMA transfer, request to other thread, etc.), return 'ODR_PENDING' and
+     * "*countRead" zero. Caller will then call "read" again with the same
+     * arguments, until it returns other value. 'ODR_PENDING' is supported only
+     * by SDO server with @ref CO_CONFIG_SDO_SRV_OD_PENDING enabled, other
+     * users (PDO, OD_get_value(), etc) handle it as error. If SDO transfer is
+     * aborted, "read" is not called again, next access starts with
+     * stream->dataOffset equal to zero.
+     *
      * @warning When accessing OD variables by calling the read() function, it
      * may be necessary to use @ref CO_LOCK_OD() and @ref CO_UNLOCK_OD() macros.
      * See @ref CO_critical_sections for more information.
@@ -288,6 +331,10 @@ typedef struct {
      * "write" function must always copy all available data from buf. If OD
      * variable expect more data, then "*returnCode" must return 'ODR_PARTIAL'.
      *
+     * "write" function may also return 'ODR_PENDING', if data can not be
+     * accepted yet. Caller will then call "write" again with the same
+     * arguments, similar as described for "read" function.
+     *
      * @warning When accessing OD variables by calling the read() function, it
      * may be necessary to use @ref CO_LOCK_OD() and @ref CO_UNLOCK_OD() macros.
      * See @ref CO_critical_sections for more information.
@@ -335,6 +382,24 @@ typedef struct {
      * See also @ref OD_requestTPDO and @ref OD_TPDOtransmitted. */
     uint8_t flagsPDO[OD_FLAGS_PDO_SIZE];
 #endif
+#if OD_EXTENSION_VIEW || defined CO_DOXYGEN
+    /** Application specified view function pointer, optional, may be NULL.
+     * If it returns "ODR_OK", then data of the OD variable are available as
+     * contiguous memory of the given length. Data must be in little-endian
+     * format and must stay valid and unchanged until the transfer is finished
+     * or aborted. SDO server uses it for segmented and block upload, instead
+     * of read() function. If return value is not "ODR_OK", then read() is
+     * used.
+     *
+     * @param stream Object Dictionary stream object, as for read().
+     * @param [out] data Pointer to data must be returned here.
+     * @param [out] length Length of data in bytes must be returned here,
+     * must be larger than zero.
+     *
+     * @return Value from @ref ODR_t, "ODR_OK" if view is available. */
+    ODR_t (*view)(OD_stream_t *stream, const uint8_t **data,
+                  OD_size_t *length);
+#endif
 } OD_extension_t;
 
 
@@ -364,11 +429,25 @@ typedef struct {
 /**
  * Object Dictionary
  */
-typedef struct {
+typedef struct OD_s {
     /** Number of elements in the list, without last element, which is blank */
     uint16_t size;
     /** List OD entries (table of contents), ordered by index */
     OD_entry_t *list;
+#if OD_FIND_CACHE_SIZE > 0
+    /** Cache of recently found entries, used by @ref OD_find(). Initially all
+     * NULL, so Object Dictionary definition does not need to set it. */
+    OD_entry_t *findCache[OD_FIND_CACHE_SIZE];
+#endif
+#if OD_WRITE_OBSERVER || defined CO_DOXYGEN
+    /** Observer of writes, see @ref OD_setWriteObserver(). Initially NULL, so
+     * Object Dictionary definition does not need to set it. */
+    void (*writeObserver)(void *object, const void *dataOrig, OD_size_t len);
+    /** Object passed to writeObserver */
+    void *writeObserverObject;
+    /** Next Object Dictionary with write observer, internal */
+    struct OD_s *writeObserverNext;
+#endif
 } OD_t;
 
 
@@ -398,6 +477,41 @@ ODR_t OD_writeOriginal(OD_stream_t *stream, const void *buf,
                        OD_size_t count, OD_size_t *countWritten);
 
 
+#if OD_WRITE_OBSERVER || defined CO_DOXYGEN
+/**
+ * Set observer of writes to original OD locations of the Object Dictionary
+ *
+ * Observer is called from @ref OD_writeOriginal() after data are copied into
+ * the OD variable. Modules, which copy data into OD variables directly (like
+ * PDO copy plan), call @ref OD_notifyWrite(). Observer is used by automatic
+ * data storage, see CO_CONFIG_STORAGE_AUTO_DIRTY. It is called from the
+ * context of the write, it must be short.
+ *
+ * OD_writeOriginal() does not know, to which Object Dictionary the written
+ * variable belongs, so observers of all Object Dictionaries are called for
+ * each write. Observer must ignore addresses, which it does not own. Function
+ * should be called in initialization phase, before OD is accessed.
+ *
+ * @param od Object Dictionary.
+ * @param object Pointer to object passed to observer.
+ * @param observer Function, called with address and length of written data,
+ * may be NULL.
+ */
+void OD_setWriteObserver(OD_t *od, void *object,
+                         void (*observer)(void *object, const void *dataOrig,
+                                          OD_size_t len));
+
+
+/**
+ * Notify write observers about data, written into OD variable directly
+ *
+ * @param dataOrig Address of written data inside original OD location.
+ * @param len Length of written data.
+ */
+void OD_notifyWrite(const void *dataOrig, OD_size_t len);
+#endif
+
+
 /**
  * Find OD entry in Object Dictionary
  *
@@ -457,6 +571,46 @@ static inline bool_t OD_mappable(OD_stream_t *stream) {
 }
 
 
+/**
+ * Groups of OD variables for locking, see @ref CO_critical_sections.
+ */
+typedef enum {
+    /** PDO or SRDO mappable variables and parameters of objects, processed
+     * in real-time thread: SYNC (0x1005, 0x1006, 0x1007, 0x1019), SRDO
+     * (0x1300 - 0x13FF) and PDO communication and mapping (0x1400 - 0x1BFF).
+     * Writing to parameters reconfigures these objects through OD
+     * extensions. */
+    OD_LOCK_GRP_RT = 0,
+    /** Other communication profile area (0x1000 - 0x1FFF), which may
+     * reconfigure communication objects through OD extensions */
+    OD_LOCK_GRP_COMM = 1,
+    /** Other variables, accessed from mainline only */
+    OD_LOCK_GRP_APP = 2
+} OD_lockGroup_t;
+
+
+/**
+ * Get lock group of OD variable, used with CO_LOCK_OD_GROUP() macro.
+ *
+ * @param index Index of the OD entry.
+ * @param stream Object Dictionary stream object.
+ *
+ * @return @ref OD_lockGroup_t.
+ */
+static inline OD_lockGroup_t OD_lockGroup(uint16_t index,
+                                          OD_stream_t *stream)
+{
+    if (OD_mappable(stream)
+        || index == 0x1005 || index == 0x1006 || index == 0x1007
+        || index == 0x1019 || (index >= 0x1300 && index < 0x1C00)
+    ) {
+        return OD_LOCK_GRP_RT;
+    }
+    return (index >= 0x1000 && index < 0x2000)
+           ? OD_LOCK_GRP_COMM : OD_LOCK_GRP_APP;
+}
+
+
 /**
  * Restart read or write operation on OD variable
  *
@@ -490,6 +644,16 @@ static inline uint8_t *OD_getFlagsPDO(OD_entry_t *entry) {
 }
 
 
+#if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_REQUEST_COUNT) || defined CO_DOXYGEN
+/**
+ * Number of @ref OD_requestTPDO() calls, allowed to overflow. Used with
+ * CO_CONFIG_TPDO_REQUEST_COUNT, so flagsPDO are checked only after new
+ * requests.
+ */
+extern volatile uint32_t OD_TPDOrequestCount;
+#endif
+
+
 /**
  * Request TPDO, to which OD variable is mapped
  *
@@ -498,7 +662,8 @@ static inline uint8_t *OD_getFlagsPDO(OD_entry_t *entry) {
  * must be enabled on OD variable. If OD variable is mapped to any TPDO with
  * event driven transmission, then TPDO will be transmitted after this function
  * call. If OD variable is mapped to more than one TPDO with event driven
- * transmission, only the first matched TPDO will be transmitted.
+ * transmission, only the first matched TPDO will be transmitted, except with
+ * CO_CONFIG_TPDO_REQUEST_COUNT, where all are transmitted.
  *
  * TPDO event driven transmission is enabled, if TPDO communication parameter,
  * transmission type is set to 0, 254 or 255. For other transmission types
@@ -513,6 +678,10 @@ static inline void OD_requestTPDO(uint8_t *flagsPDO, uint8_t subIndex) {
         /* clear subIndex-th bit */
         uint8_t mask = ~(1 << (subIndex & 0x07));
         flagsPDO[subIndex >> 3] &= mask;
+ #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_REQUEST_COUNT
+        CO_MemoryBarrier();
+        OD_TPDOrequestCount++;
+ #endif
     }
 #endif
 }
@@ -775,6 +944,192 @@ static inline ODR_t OD_set_f64(const OD_entry_t *entry, uint8_t subIndex,
     return OD_set_value(entry, subIndex, &val, sizeof(val), odOrig);
 }
 
+/**
+ * Handle of OD variable, resolved once by @ref OD_handleInit().
+ *
+ * Handle is intended for application, which accesses the same OD variables in
+ * each cycle. Functions OD_handleRead(), OD_handleWrite() and OD_handleGet_xx()
+ * / OD_handleSet_xx() then skip OD_find() and OD_getSub(). If OD variable has
+ * no @ref OD_extension_t, data are accessed directly, otherwise through single
+ * call of read() or write() function of the extension. Handle must be
+ * initialized again, if extension of the OD entry is changed.
+ */
+typedef struct {
+    /** Stream and read/write functions from @ref OD_getSub() */
+    OD_IO_t io;
+    /** Pointer to original OD data for direct access or NULL */
+    void *data;
+} OD_handle_t;
+
+
+/**
+ * Initialize handle of OD variable
+ *
+ * @param [out] handle Handle to be initialized.
+ * @param entry OD entry returned by @ref OD_find().
+ * @param subIndex Sub-index of the variable from the OD object.
+ * @param odOrig If true, then potential IO extension on entry will be
+ * ignored and data in the original OD location will be accessed.
+ *
+ * @return Value from @ref ODR_t, "ODR_OK" in case of success.
+ */
+ODR_t OD_handleInit(OD_handle_t *handle, const OD_entry_t *entry,
+                    uint8_t subIndex, bool_t odOrig);
+
+/**
+ * Read variable through handle
+ *
+ * @param handle Handle initialized by @ref OD_handleInit().
+ * @param [out] val Value will be written here.
+ * @param len Size of value, must be equal to length of OD variable.
+ *
+ * @return Value from @ref ODR_t, "ODR_OK" in case of success.
+ */
+static inline ODR_t OD_handleRead(OD_handle_t *handle, void *val,
+                                  OD_size_t len)
+{
+    OD_stream_t *stream = &handle->io.stream;
+    OD_size_t countRd;
+
+    if (len != stream->dataLength) return ODR_TYPE_MISMATCH;
+    if (handle->data != NULL) {
+        memcpy(val, handle->data, len);
+        return ODR_OK;
+    }
+    stream->dataOffset = 0;
+    return handle->io.read(stream, val, len, &countRd);
+}
+
+/**
+ * Write variable through handle
+ *
+ * If variable is copied directly, observer from @ref OD_setWriteObserver() is
+ * notified with OD_notifyWrite(), same as by OD_writeOriginal().
+ *
+ * @param handle Handle initialized by @ref OD_handleInit().
+ * @param val Value to be written.
+ * @param len Size of value, must be equal to length of OD variable.
+ *
+ * @return Value from @ref ODR_t, "ODR_OK" in case of success.
+ */
+static inline ODR_t OD_handleWrite(OD_handle_t *handle, const void *val,
+                                   OD_size_t len)
+{
+    OD_stream_t *stream = &handle->io.stream;
+    OD_size_t countWr;
+
+    if (len != stream->dataLength) return ODR_TYPE_MISMATCH;
+    if (handle->data != NULL) {
+        memcpy(handle->data, val, len);
+#if OD_WRITE_OBSERVER
+        OD_notifyWrite(handle->data, len);
+#endif
+        return ODR_OK;
+    }
+    stream->dataOffset = 0;
+    return handle->io.write(stream, val, len, &countWr);
+}
+
+/** Get int8_t variable through handle, see @ref OD_handleRead */
+static inline ODR_t OD_handleGet_i8(OD_handle_t *handle, int8_t *val) {
+    return OD_handleRead(handle, val, sizeof(*val));
+}
+
+/** Get int16_t variable through handle, see @ref OD_handleRead */
+static inline ODR_t OD_handleGet_i16(OD_handle_t *handle, int16_t *val) {
+    return OD_handleRead(handle, val, sizeof(*val));
+}
+
+/** Get int32_t variable through handle, see @ref OD_handleRead */
+static inline ODR_t OD_handleGet_i32(OD_handle_t *handle, int32_t *val) {
+    return OD_handleRead(handle, val, sizeof(*val));
+}
+
+/** Get int64_t variable through handle, see @ref OD_handleRead */
+static inline ODR_t OD_handleGet_i64(OD_handle_t *handle, int64_t *val) {
+    return OD_handleRead(handle, val, sizeof(*val));
+}
+
+/** Get uint8_t variable through handle, see @ref OD_handleRead */
+static inline ODR_t OD_handleGet_u8(OD_handle_t *handle, uint8_t *val) {
+    return OD_handleRead(handle, val, sizeof(*val));
+}
+
+/** Get uint16_t variable through handle, see @ref OD_handleRead */
+static inline ODR_t OD_handleGet_u16(OD_handle_t *handle, uint16_t *val) {
+    return OD_handleRead(handle, val, sizeof(*val));
+}
+
+/** Get uint32_t variable through handle, see @ref OD_handleRead */
+static inline ODR_t OD_handleGet_u32(OD_handle_t *handle, uint32_t *val) {
+    return OD_handleRead(handle, val, sizeof(*val));
+}
+
+/** Get uint64_t variable through handle, see @ref OD_handleRead */
+static inline ODR_t OD_handleGet_u64(OD_handle_t *handle, uint64_t *val) {
+    return OD_handleRead(handle, val, sizeof(*val));
+}
+
+/** Get float32_t variable through handle, see @ref OD_handleRead */
+static inline ODR_t OD_handleGet_f32(OD_handle_t *handle, float32_t *val) {
+    return OD_handleRead(handle, val, sizeof(*val));
+}
+
+/** Get float64_t variable through handle, see @ref OD_handleRead */
+static inline ODR_t OD_handleGet_f64(OD_handle_t *handle, float64_t *val) {
+    return OD_handleRead(handle, val, sizeof(*val));
+}
+
+/** Set int8_t variable through handle, see @ref OD_handleWrite */
+static inline ODR_t OD_handleSet_i8(OD_handle_t *handle, int8_t val) {
+    return OD_handleWrite(handle, &val, sizeof(val));
+}
+
+/** Set int16_t variable through handle, see @ref OD_handleWrite */
+static inline ODR_t OD_handleSet_i16(OD_handle_t *handle, int16_t val) {
+    return OD_handleWrite(handle, &val, sizeof(val));
+}
+
+/** Set int32_t variable through handle, see @ref OD_handleWrite */
+static inline ODR_t OD_handleSet_i32(OD_handle_t *handle, int32_t val) {
+    return OD_handleWrite(handle, &val, sizeof(val));
+}
+
+/** Set int64_t variable through handle, see @ref OD_handleWrite */
+static inline ODR_t OD_handleSet_i64(OD_handle_t *handle, int64_t val) {
+    return OD_handleWrite(handle, &val, sizeof(val));
+}
+
+/** Set uint8_t variable through handle, see @ref OD_handleWrite */
+static inline ODR_t OD_handleSet_u8(OD_handle_t *handle, uint8_t val) {
+    return OD_handleWrite(handle, &val, sizeof(val));
+}
+
+/** Set uint16_t variable through handle, see @ref OD_handleWrite */
+static inline ODR_t OD_handleSet_u16(OD_handle_t *handle, uint16_t val) {
+    return OD_handleWrite(handle, &val, sizeof(val));
+}
+
+/** Set uint32_t variable through handle, see @ref OD_handleWrite */
+static inline ODR_t OD_handleSet_u32(OD_handle_t *handle, uint32_t val) {
+    return OD_handleWrite(handle, &val, sizeof(val));
+}
+
+/** Set uint64_t variable through handle, see @ref OD_handleWrite */
+static inline ODR_t OD_handleSet_u64(OD_handle_t *handle, uint64_t val) {
+    return OD_handleWrite(handle, &val, sizeof(val));
+}
+
+/** Set float32_t variable through handle, see @ref OD_handleWrite */
+static inline ODR_t OD_handleSet_f32(OD_handle_t *handle, float32_t val) {
+    return OD_handleWrite(handle, &val, sizeof(val));
+}
+
+/** Set float64_t variable through handle, see @ref OD_handleWrite */
+static inline ODR_t OD_handleSet_f64(OD_handle_t *handle, float64_t val) {
+    return OD_handleWrite(handle, &val, sizeof(val));
+}
+
 /**
  * Get pointer to memory which holds data variable from Object Dictionary
  *
@@ -824,6 +1179,10 @@ typedef enum {
      * @ref OD_obj_var_t. Variable at sub-index 0 is of type uint8_t and usually
      * represents number of sub-elements in the structure. */
     ODT_REC = 0x03,
+    /** Compact OD object of any object code, enabled by @ref OD_COMPACT. OD
+     * object is type of @ref OD_obj_compact_t. It describes all sub-entries,
+     * each with 16-bit offset of its data inside common data block. */
+    ODT_CMP = 0x04,
     /** Mask for basic type */
     ODT_TYPE_MASK = 0x0F,
 } OD_objectTypes_t;
@@ -860,6 +1219,34 @@ typedef struct {
     OD_size_t dataLength; /**< Data length in bytes */
 } OD_obj_record_t;
 
+/** Value of @ref OD_obj_compactSub_t offset for sub-entry without data */
+#define OD_COMPACT_NO_DATA 0xFFFF
+
+/**
+ * Sub-entry of compact OD object, used in @ref OD_obj_compact_t
+ */
+typedef struct {
+    uint16_t offset; /**< Offset of data inside dataBase in bytes or
+                          @ref OD_COMPACT_NO_DATA */
+    uint8_t subIndex; /**< Sub index of element. */
+    OD_attr_t attribute; /**< Attribute bitfield, see @ref OD_attributes_t */
+    uint16_t dataLength; /**< Data length in bytes */
+} OD_obj_compactSub_t;
+
+/**
+ * Object for compact OD object, used in "CMP" type OD objects
+ *
+ * All sub-entries of the object share a single data block of at most 64kB,
+ * usually one of the OD data groups, for example OD_RAM. Sub-entries should
+ * be ordered by subIndex. If sub-entries are at consecutive sub-indexes from
+ * 0, they are found without search.
+ */
+typedef struct {
+    void *dataBase; /**< Pointer to data block */
+    CO_PROGMEM OD_obj_compactSub_t *sub; /**< Array of subEntriesCount
+                                              sub-entries */
+} OD_obj_compact_t;
+
 /** @} */ /* CO_ODdefinition */
 
 #endif /* defined OD_DEFINITION */
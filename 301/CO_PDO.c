@@ -23,6 +23,7 @@
  * limitations under the License.
  */
 
+#include <stddef.h>
 #include <string.h>
 
 #include "301/CO_PDO.h"
@@ -34,6 +35,38 @@
   #error Dynamic PDO mapping is not possible without CO_CONFIG_PDO_OD_IO_ACCESS
  #endif
 #endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_PLAN
+ #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS) == 0
+  #error CO_CONFIG_PDO_COPY_PLAN requires CO_CONFIG_PDO_OD_IO_ACCESS
+ #endif
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_COS
+ #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS) == 0 \
+     || ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_TIMERS_ENABLE) == 0
+  #error CO_CONFIG_TPDO_COS requires CO_CONFIG_PDO_OD_IO_ACCESS and CO_CONFIG_TPDO_TIMERS_ENABLE
+ #endif
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ISR_PROCESS
+ #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_PLAN) == 0 \
+     || ((CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE) == 0
+  #error CO_CONFIG_RPDO_ISR_PROCESS requires CO_CONFIG_PDO_COPY_PLAN and RPDO
+ #endif
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_ROUTING
+ #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS) == 0 \
+     || ((CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE) == 0 \
+     || ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE) == 0
+  #error CO_CONFIG_PDO_ROUTING requires CO_CONFIG_PDO_OD_IO_ACCESS, RPDO and TPDO
+ #endif
+#endif
+
+/* Length of CAN frame for PDO with dataLength bytes. CAN FD frame has
+ * discrete lengths, PDO is padded with zeros. */
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD
+ #define CO_PDO_FRAME_LENGTH(dataLength) CO_CANfd_roundLength(dataLength)
+#else
+ #define CO_PDO_FRAME_LENGTH(dataLength) (dataLength)
+#endif
 
 #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS
 /*
@@ -149,6 +182,70 @@ static ODR_t PDOconfigMap(CO_PDO_common_t *PDO,
     return ODR_OK;
 }
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_PLAN
+/*
+ * Build PDO copy plan from configured mapping
+ *
+ * Mapped OD variables without extension are copied directly. Their mapped
+ * length must match OD variable length (for TPDO it may be shorter) and on
+ * big-endian target they must not be multibyte. Runs of directly copied
+ * variables, which are adjacent in memory, are coalesced.
+ *
+ * @param PDO This object, mappedObjectsCount must be set.
+ * @param isRPDO True for RPDO and false for TPDO.
+ */
+static void PDO_buildCopyPlan(CO_PDO_common_t *PDO, bool_t isRPDO) {
+    CO_PDO_copyRun_t *run = NULL;
+    uint8_t count = 0;
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ISR_PROCESS
+    bool_t planDirect = isRPDO;
+#endif
+
+    for (uint8_t i = 0; i < PDO->mappedObjectsCount; i++) {
+        OD_IO_t *OD_IO = &PDO->OD_IO[i];
+        OD_stream_t *stream = &OD_IO->stream;
+        uint8_t mappedLength = (uint8_t) stream->dataOffset;
+        uint8_t *dataOD = NULL;
+
+        bool_t direct = isRPDO
+                      ? (OD_IO->write == OD_writeOriginal
+                         && stream->dataLength == mappedLength)
+                      : (OD_IO->read == OD_readOriginal
+                         && stream->dataLength >= mappedLength);
+#ifdef CO_BIG_ENDIAN
+        if ((stream->attribute & ODA_MB) != 0 && stream->dataLength > 1) {
+            direct = false;
+        }
+#endif
+        if (direct && mappedLength > 0) {
+            dataOD = stream->dataOrig;
+        }
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ISR_PROCESS
+        else if (OD_IO->write != OD_write_dummy) {
+            planDirect = false;
+        }
+#endif
+
+        if (dataOD != NULL && run != NULL && run->dataOD != NULL
+            && (run->dataOD + run->length) == dataOD
+        ) {
+            run->length += mappedLength;
+        }
+        else {
+            run = &PDO->copyPlan[count++];
+            run->dataOD = dataOD;
+            run->mapIndex = i;
+            run->length = mappedLength;
+        }
+    }
+
+    PDO->copyPlanCount = count;
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ISR_PROCESS
+    PDO->copyPlanDirect = planDirect;
+#endif
+}
+#endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_PLAN */
+
 /*
  * Initialize PDO mapping parameters
  *
@@ -217,11 +314,111 @@ static CO_ReturnError_t PDO_initMapping(CO_PDO_common_t *PDO,
     if (*erroneousMap == 0) {
         PDO->dataLength = (CO_PDO_size_t)pdoDataLength;
         PDO->mappedObjectsCount = mappedObjectsCount;
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_PLAN
+        PDO_buildCopyPlan(PDO, isRPDO);
+#endif
     }
 
     return CO_ERROR_NO;
 }
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_ROUTING
+/*
+ * Mark mapped variables of TPDO inside the routed range.
+ *
+ * @return false, if range does not cover whole mapped variables. TPDO is not
+ * changed in that case.
+ */
+static bool_t TPDO_markRouted(CO_TPDO_t *TPDO,
+                              uint8_t dstOffset,
+                              uint8_t length)
+{
+    CO_PDO_common_t *PDO = &TPDO->PDO_common;
+    uint8_t first = 0, last = 0;
+    uint16_t offset = 0;
+    bool_t startFound = false;
+    for (uint8_t i = 0; i < PDO->mappedObjectsCount; i++) {
+        if (offset == dstOffset) {
+            first = i;
+            startFound = true;
+        }
+        offset += (uint8_t) PDO->OD_IO[i].stream.dataOffset;
+        if (offset == ((uint16_t)dstOffset + length)) {
+            last = i;
+            break;
+        }
+    }
+    if (!startFound || offset != ((uint16_t)dstOffset + length)) {
+        return false;
+    }
+
+    for (uint8_t i = first; i <= last; i++) {
+        if (!TPDO->routed[i]) {
+            TPDO->routed[i] = true;
+            TPDO->routedCount++;
+        }
+    }
+    return true;
+}
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_FLAG_OD_DYNAMIC
+/*
+ * Remove all routes from RPDO or to TPDO, whose mapping is changed.
+ *
+ * Routed flags of each TPDO, which loses the route from RPDO, are rebuilt
+ * from its other routes. PDO must be disabled, RPDO is then not processed.
+ * Routes are unlinked with single pointer write, so RPDO, which may be just
+ * processing its routes to disabled TPDO, sees the list valid.
+ */
+static void PDO_removeRoutes(CO_PDO_common_t *PDO) {
+    CO_PDOroute_t *route;
+
+    if (PDO->isRPDO) {
+        /* RPDO is the first element inside CO_RPDO_t */
+        CO_RPDO_t *RPDO = (CO_RPDO_t *)PDO;
+
+        route = RPDO->routes;
+        RPDO->routes = NULL;
+        for (; route != NULL; route = route->next) {
+            CO_TPDO_t *TPDO = route->TPDO;
+            CO_PDOroute_t **pp = &TPDO->routesIn;
+
+            while (*pp != NULL && *pp != route) {
+                pp = &(*pp)->nextIn;
+            }
+            if (*pp != NULL) {
+                *pp = route->nextIn;
+            }
+
+            memset(TPDO->routed, 0, sizeof(TPDO->routed));
+            TPDO->routedCount = 0;
+            for (CO_PDOroute_t *r = TPDO->routesIn; r != NULL; r = r->nextIn) {
+                (void)TPDO_markRouted(TPDO, r->dstOffset, r->length);
+            }
+        }
+    }
+    else {
+        /* TPDO is the first element inside CO_TPDO_t */
+        CO_TPDO_t *TPDO = (CO_TPDO_t *)PDO;
+
+        for (route = TPDO->routesIn; route != NULL; route = route->nextIn) {
+            CO_PDOroute_t **pp = &route->RPDO->routes;
+
+            while (*pp != NULL && *pp != route) {
+                pp = &(*pp)->next;
+            }
+            if (*pp != NULL) {
+                *pp = route->next;
+            }
+        }
+        TPDO->routesIn = NULL;
+        memset(TPDO->routed, 0, sizeof(TPDO->routed));
+        TPDO->routedCount = 0;
+    }
+}
+#endif
+#endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_ROUTING */
+
 #if (CO_CONFIG_PDO) & CO_CONFIG_FLAG_OD_DYNAMIC
 /*
  * Custom function for writing OD object "PDO mapping parameter"
@@ -245,6 +442,9 @@ static ODR_t OD_write_PDO_mapping(OD_stream_t *stream, const void *buf,
     if (PDO->valid || (PDO->mappedObjectsCount != 0 && stream->subIndex > 0)) {
         return ODR_UNSUPP_ACCESS;
     }
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_FAST_REINIT
+    PDO->mapCacheValid = false;
+#endif
 
     if (stream->subIndex == 0) {
         uint8_t mappedObjectsCount = CO_getUint8(buf);
@@ -277,6 +477,12 @@ static ODR_t OD_write_PDO_mapping(OD_stream_t *stream, const void *buf,
         /* success, update PDO */
         PDO->dataLength = (CO_PDO_size_t)pdoDataLength;
         PDO->mappedObjectsCount = mappedObjectsCount;
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_PLAN
+        PDO_buildCopyPlan(PDO, PDO->isRPDO);
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_ROUTING
+        PDO_removeRoutes(PDO);
+#endif
     }
     else {
         uint32_t val = CO_getUint32(buf);
@@ -404,6 +610,69 @@ static CO_ReturnError_t PDO_initMapping(CO_PDO_common_t *PDO,
 #endif /* ((CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS) == 0 */
 
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_FAST_REINIT
+/*
+ * Read mapping parameters from OD into map and count. Return true, if they are
+ * equal to the cached mapping, which can then be reused.
+ */
+static bool_t PDO_mapUnchanged(CO_PDO_common_t *PDO,
+                               OD_t *OD,
+                               OD_entry_t *OD_PDOMapPar,
+                               uint32_t *map,
+                               uint8_t *count)
+{
+    bool_t unchanged = PDO->mapCacheValid && PDO->mapCacheOD == OD;
+
+    if (OD_get_u8(OD_PDOMapPar, 0, count, true) != ODR_OK) {
+        return false;
+    }
+    if (*count != PDO->mapCacheCount) {
+        unchanged = false;
+    }
+    for (uint8_t i = 0; i < CO_PDO_MAX_MAPPED_ENTRIES; i++) {
+        map[i] = 0;
+        ODR_t odRet = OD_get_u32(OD_PDOMapPar, i + 1, &map[i], true);
+        if (odRet != ODR_OK && odRet != ODR_SUB_NOT_EXIST) {
+            return false;
+        }
+        if (map[i] != PDO->mapCache[i]) {
+            unchanged = false;
+        }
+    }
+    return unchanged;
+}
+
+/*
+ * Clear PDO object of size objSize. If keepMapping is true, mapping from the
+ * previous initialization is preserved.
+ */
+static void PDO_clear(CO_PDO_common_t *PDO, size_t objSize,
+                      bool_t keepMapping)
+{
+    if (!keepMapping) {
+        memset(PDO, 0, objSize);
+        return;
+    }
+
+    size_t keepStart = offsetof(CO_PDO_common_t, dataLength);
+    size_t keepEnd = offsetof(CO_PDO_common_t, mapCacheOD)
+                   + sizeof(PDO->mapCacheOD);
+    memset(PDO, 0, keepStart);
+    memset((uint8_t *)PDO + keepEnd, 0, objSize - keepEnd);
+}
+
+/* Remember successfully initialized mapping */
+static void PDO_mapCacheSet(CO_PDO_common_t *PDO, OD_t *OD,
+                            const uint32_t *map, uint8_t count)
+{
+    memcpy(PDO->mapCache, map, sizeof(PDO->mapCache));
+    PDO->mapCacheCount = count;
+    PDO->mapCacheOD = OD;
+    PDO->mapCacheValid = true;
+}
+#endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_FAST_REINIT */
+
+
 #if (CO_CONFIG_PDO) & CO_CONFIG_FLAG_OD_DYNAMIC
 /*
  * Custom function for reading OD object "PDO communication parameter"
@@ -454,6 +723,55 @@ typedef enum {
     CO_RPDO_RX_LONG = 13 /* Too long RPDO received, not acknowledged */
 } CO_PDO_receiveErrors_t;
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ISR_PROCESS
+/*
+ * Copy received RPDO into OD variables inside CAN receive callback, if enabled
+ * by CO_RPDO_setIsrProcessing() and possible.
+ *
+ * @param RPDO RPDO object.
+ * @param data Data of the received CAN message.
+ *
+ * @return True, if data were written into OD.
+ */
+static bool_t CO_RPDOisrProcess(CO_RPDO_t *RPDO, const uint8_t *data) {
+    CO_PDO_common_t *PDO = &RPDO->PDO_common;
+
+    if (!RPDO->isrProcess || !RPDO->isrActive || !PDO->copyPlanDirect
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_ENABLE
+        || RPDO->synchronous
+ #endif
+    ) {
+        return false;
+    }
+
+    /* Store message for routing. Odd sequence counter tells
+     * CO_RPDO_process(), that buffer is being written, change of the counter
+     * tells, that it was rewritten during its read. */
+    RPDO->isrSeq++;
+    CO_MemoryBarrier();
+    memcpy(RPDO->isrData, data, sizeof(RPDO->isrData));
+    CO_MemoryBarrier();
+    RPDO->isrSeq++;
+
+    const uint8_t *dataRPDO = data;
+    for (uint8_t r = 0; r < PDO->copyPlanCount; r++) {
+        CO_PDO_copyRun_t *run = &PDO->copyPlan[r];
+
+        /* run without dataOD is dummy entry */
+        if (run->dataOD != NULL) {
+            memcpy(run->dataOD, dataRPDO, run->length);
+        }
+        dataRPDO += run->length;
+    }
+
+    /* publish the message */
+    CO_FLAG_SET(RPDO->isrNew);
+
+    return true;
+}
+#endif
+
+
 /*
  * Read received message from CAN module.
  *
@@ -473,7 +791,9 @@ static void CO_PDO_receive(void *object, void *msg) {
     if (PDO->valid) {
         if (DLC >= PDO->dataLength) {
             /* indicate errors in PDO length */
-            if (DLC == PDO->dataLength) {
+            if (DLC == PDO->dataLength
+                || DLC == CO_PDO_FRAME_LENGTH(PDO->dataLength)
+            ) {
                 if (err == CO_RPDO_RX_ACK_ERROR) err = CO_RPDO_RX_OK;
             }
             else {
@@ -491,8 +811,17 @@ static void CO_PDO_receive(void *object, void *msg) {
 #endif
 
             /* copy data into appropriate buffer and set 'new message' flag */
-            memcpy(RPDO->CANrxData[bufNo], data,sizeof(RPDO->CANrxData[bufNo]));
-            CO_FLAG_SET(RPDO->CANrxNew[bufNo]);
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ISR_PROCESS
+            if (CO_RPDOisrProcess(RPDO, data)) {
+                /* data are already written into OD */
+            }
+            else
+#endif
+            {
+                memcpy(RPDO->CANrxData[bufNo], data,
+                       sizeof(RPDO->CANrxData[bufNo]));
+                CO_FLAG_SET(RPDO->CANrxNew[bufNo]);
+            }
 
 #if (CO_CONFIG_PDO) & CO_CONFIG_FLAG_CALLBACK_PRE
             /* Optional signal to RTOS, which can resume task, which handles
@@ -650,7 +979,14 @@ CO_ReturnError_t CO_RPDO_init(CO_RPDO_t *RPDO,
     }
 
     /* clear object */
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_FAST_REINIT
+    uint32_t map[CO_PDO_MAX_MAPPED_ENTRIES];
+    uint8_t mapCount = 0;
+    bool_t mapReuse = PDO_mapUnchanged(PDO, OD, OD_16xx_RPDOMapPar, map, &mapCount);
+    PDO_clear(PDO, sizeof(CO_RPDO_t), mapReuse);
+#else
     memset(RPDO, 0, sizeof(CO_RPDO_t));
+#endif
 
     /* Configure object variables */
     PDO->em = em;
@@ -658,6 +994,10 @@ CO_ReturnError_t CO_RPDO_init(CO_RPDO_t *RPDO,
 
     /* Configure mapping parameters */
     uint32_t erroneousMap = 0;
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_FAST_REINIT
+    if (!mapReuse) {
+        PDO->mapCacheValid = false;
+#endif
     ret = PDO_initMapping(PDO,
                           OD,
                           OD_16xx_RPDOMapPar,
@@ -667,6 +1007,12 @@ CO_ReturnError_t CO_RPDO_init(CO_RPDO_t *RPDO,
     if (ret != CO_ERROR_NO) {
         return ret;
     }
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_FAST_REINIT
+        if (erroneousMap == 0) {
+            PDO_mapCacheSet(PDO, OD, map, mapCount);
+        }
+    }
+#endif
 
 
     /* Configure communication parameter - COB-ID */
@@ -773,6 +1119,85 @@ void CO_RPDO_initCallbackPre(CO_RPDO_t *RPDO,
 #endif
 
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ISR_PROCESS
+/******************************************************************************/
+void CO_RPDO_setIsrProcessing(CO_RPDO_t *RPDO, bool_t enable) {
+    if (RPDO != NULL) {
+        RPDO->isrProcess = enable;
+    }
+}
+#endif
+
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_ROUTING
+static CO_ReturnError_t CO_TPDOsend(CO_TPDO_t *TPDO);
+
+/*
+ * Copy routed data from received RPDO into TPDOs and send or request them.
+ *
+ * @param RPDO RPDO object.
+ * @param dataRPDO Data of the received RPDO.
+ */
+static void CO_RPDOroute(CO_RPDO_t *RPDO, const uint8_t *dataRPDO) {
+    for (CO_PDOroute_t *route = RPDO->routes; route != NULL;
+         route = route->next
+    ) {
+        CO_TPDO_t *TPDO = route->TPDO;
+
+        memcpy(&TPDO->CANtxBuff->data[route->dstOffset],
+               &dataRPDO[route->srcOffset], route->length);
+
+        if (!TPDO->PDO_common.valid) {
+            continue;
+        }
+        if (route->forwardOnRx) {
+            CO_TPDOsend(TPDO);
+        }
+        else {
+            TPDO->sendRequest = true;
+        }
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_RPDO_addRoute(CO_RPDO_t *RPDO,
+                                  CO_PDOroute_t *route,
+                                  CO_TPDO_t *TPDO,
+                                  uint8_t srcOffset,
+                                  uint8_t dstOffset,
+                                  uint8_t length,
+                                  bool_t forwardOnRx)
+{
+    if (RPDO == NULL || route == NULL || TPDO == NULL
+        || TPDO->CANtxBuff == NULL || length == 0
+        || ((uint16_t)srcOffset + length) > RPDO->PDO_common.dataLength
+        || ((uint16_t)dstOffset + length) > TPDO->PDO_common.dataLength
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* mark mapped variables of TPDO inside the routed range */
+    if (!TPDO_markRouted(TPDO, dstOffset, length)) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    route->RPDO = RPDO;
+    route->TPDO = TPDO;
+    route->srcOffset = srcOffset;
+    route->dstOffset = dstOffset;
+    route->length = length;
+    route->forwardOnRx = forwardOnRx;
+    route->next = RPDO->routes;
+    route->nextIn = TPDO->routesIn;
+    RPDO->routes = route;
+    TPDO->routesIn = route;
+
+    return CO_ERROR_NO;
+}
+#endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_ROUTING */
+
+
 /******************************************************************************/
 void CO_RPDO_process(CO_RPDO_t *RPDO,
 #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_TIMERS_ENABLE
@@ -785,6 +1210,11 @@ void CO_RPDO_process(CO_RPDO_t *RPDO,
     (void) syncWas;
     CO_PDO_common_t *PDO = &RPDO->PDO_common;
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ISR_PROCESS
+    /* enable or disable processing inside CAN receive callback */
+    RPDO->isrActive = PDO->valid && NMTisOperational;
+#endif
+
     if (PDO->valid && NMTisOperational
 #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_ENABLE
         && (syncWas || !RPDO->synchronous)
@@ -810,16 +1240,64 @@ void CO_RPDO_process(CO_RPDO_t *RPDO,
 
         /* copy RPDO into OD variables according to mappings */
         bool_t rpdoReceived = false;
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ISR_PROCESS
+        /* RPDO was already copied into OD by receive callback */
+        if (CO_FLAG_READ(RPDO->isrNew)) {
+            rpdoReceived = true;
+            CO_FLAG_CLEAR(RPDO->isrNew);
+ #if OD_WRITE_OBSERVER
+            /* observers are not called from receive callback */
+            for (uint8_t r = 0; r < PDO->copyPlanCount; r++) {
+                CO_PDO_copyRun_t *run = &PDO->copyPlan[r];
+                if (run->dataOD != NULL) {
+                    OD_notifyWrite(run->dataOD, run->length);
+                }
+            }
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_ROUTING
+            /* consistent copy of the last message, retry if receive callback
+             * wrote it meanwhile */
+            uint8_t dataRoute[CO_PDO_MAX_SIZE];
+            uint16_t seq;
+            do {
+                seq = RPDO->isrSeq;
+                CO_MemoryBarrier();
+                memcpy(dataRoute, RPDO->isrData, sizeof(dataRoute));
+                CO_MemoryBarrier();
+            } while ((seq & 1U) != 0U || seq != RPDO->isrSeq);
+            CO_RPDOroute(RPDO, dataRoute);
+ #endif
+        }
+#endif
         while (CO_FLAG_READ(RPDO->CANrxNew[bufNo])) {
             rpdoReceived = true;
             uint8_t *dataRPDO = RPDO->CANrxData[bufNo];
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_ROUTING
+            uint8_t *dataRoute = dataRPDO;
+#endif
 
             /* Clear the flag. If between the copy operation CANrxNew is set
              * by receive thread, then copy the latest data again. */
             CO_FLAG_CLEAR(RPDO->CANrxNew[bufNo]);
 
 #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_PLAN
+            for (uint8_t r = 0; r < PDO->copyPlanCount; r++) {
+                CO_PDO_copyRun_t *run = &PDO->copyPlan[r];
+
+                /* mapped variables without OD extension, copy directly */
+                if (run->dataOD != NULL) {
+                    memcpy(run->dataOD, dataRPDO, run->length);
+  #if OD_WRITE_OBSERVER
+                    OD_notifyWrite(run->dataOD, run->length);
+  #endif
+                    dataRPDO += run->length;
+                    continue;
+                }
+                uint8_t i = run->mapIndex;
+ #else
             for (uint8_t i = 0; i < PDO->mappedObjectsCount; i++) {
+ #endif
                 OD_IO_t *OD_IO = &PDO->OD_IO[i];
 
                 /* get mappedLength from temporary storage */
@@ -871,9 +1349,15 @@ void CO_RPDO_process(CO_RPDO_t *RPDO,
 #else
             for (uint8_t i = 0; i < PDO->dataLength; i++) {
                 *PDO->mapPointer[i] = dataRPDO[i];
+ #if OD_WRITE_OBSERVER
+                OD_notifyWrite(PDO->mapPointer[i], 1);
+ #endif
             }
 #endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS */
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_ROUTING
+            CO_RPDOroute(RPDO, dataRoute);
+#endif
         } /* while (CO_FLAG_READ(RPDO->CANrxNew[bufNo])) */
 
         /* verify RPDO timeout */
@@ -917,12 +1401,18 @@ void CO_RPDO_process(CO_RPDO_t *RPDO,
         if (!PDO->valid || !NMTisOperational) {
             CO_FLAG_CLEAR(RPDO->CANrxNew[0]);
             CO_FLAG_CLEAR(RPDO->CANrxNew[1]);
+ #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ISR_PROCESS
+            CO_FLAG_CLEAR(RPDO->isrNew);
+ #endif
  #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_TIMERS_ENABLE
             RPDO->timeoutTimer = 0;
  #endif
         }
 #else
         CO_FLAG_CLEAR(RPDO->CANrxNew[0]);
+ #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ISR_PROCESS
+        CO_FLAG_CLEAR(RPDO->isrNew);
+ #endif
  #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_TIMERS_ENABLE
         RPDO->timeoutTimer = 0;
  #endif
@@ -987,13 +1477,16 @@ static ODR_t OD_write_18xx(OD_stream_t *stream, const void *buf,
                 PDO->CANdevIdx,   /* index of specific buffer inside CAN mod. */
                 CAN_ID,           /* CAN identifier */
                 0,                /* rtr */
-                PDO->dataLength,  /* number of data bytes */
+                CO_PDO_FRAME_LENGTH(PDO->dataLength), /* number of data bytes */
                 TPDO->transmissionType <= CO_PDO_TRANSM_TYPE_SYNC_240);
                                   /* synchronous message flag */
 
             if (CANtxBuff == NULL) {
                 return ODR_DEV_INCOMPAT;
             }
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD
+            memset(CANtxBuff->data, 0, sizeof(CANtxBuff->data));
+#endif
 
             TPDO->CANtxBuff = CANtxBuff;
             PDO->valid = valid;
@@ -1089,7 +1582,14 @@ CO_ReturnError_t CO_TPDO_init(CO_TPDO_t *TPDO,
     }
 
     /* clear object */
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_FAST_REINIT
+    uint32_t map[CO_PDO_MAX_MAPPED_ENTRIES];
+    uint8_t mapCount = 0;
+    bool_t mapReuse = PDO_mapUnchanged(PDO, OD, OD_1Axx_TPDOMapPar, map, &mapCount);
+    PDO_clear(PDO, sizeof(CO_TPDO_t), mapReuse);
+#else
     memset(TPDO, 0, sizeof(CO_TPDO_t));
+#endif
 
     /* Configure object variables */
     PDO->em = em;
@@ -1097,15 +1597,26 @@ CO_ReturnError_t CO_TPDO_init(CO_TPDO_t *TPDO,
 
     /* Configure mapping parameters */
     uint32_t erroneousMap = 0;
-    CO_ReturnError_t ret = PDO_initMapping(PDO,
-                                           OD,
-                                           OD_1Axx_TPDOMapPar,
-                                           false,
-                                           errInfo,
-                                           &erroneousMap);
+    CO_ReturnError_t ret;
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_FAST_REINIT
+    if (!mapReuse) {
+        PDO->mapCacheValid = false;
+#endif
+    ret = PDO_initMapping(PDO,
+                          OD,
+                          OD_1Axx_TPDOMapPar,
+                          false,
+                          errInfo,
+                          &erroneousMap);
     if (ret != CO_ERROR_NO) {
         return ret;
     }
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_FAST_REINIT
+        if (erroneousMap == 0) {
+            PDO_mapCacheSet(PDO, OD, map, mapCount);
+        }
+    }
+#endif
 
 
     /* Configure communication parameter - transmission type */
@@ -1163,12 +1674,15 @@ CO_ReturnError_t CO_TPDO_init(CO_TPDO_t *TPDO,
             CANdevTxIdx,        /* index of specific buffer inside CAN module */
             CAN_ID,             /* CAN identifier */
             0,                  /* rtr */
-            PDO->dataLength,    /* number of data bytes */
+            CO_PDO_FRAME_LENGTH(PDO->dataLength), /* number of data bytes */
             TPDO->transmissionType <= CO_PDO_TRANSM_TYPE_SYNC_240);
                                 /* synchronous message flag bit */
     if (TPDO->CANtxBuff == NULL) {
         return CO_ERROR_ILLEGAL_ARGUMENT;
     }
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD
+    memset(TPDO->CANtxBuff->data, 0, sizeof(TPDO->CANtxBuff->data));
+#endif
 
     PDO->valid = valid;
 
@@ -1214,6 +1728,121 @@ CO_ReturnError_t CO_TPDO_init(CO_TPDO_t *TPDO,
 }
 
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS
+/*
+ * Read one mapped OD variable into TPDO data.
+ *
+ * @param OD_IO OD_IO of mapped variable.
+ * @param [out] dataTPDO Buffer for mappedLength bytes.
+ *
+ * @return mappedLength.
+ */
+static uint8_t CO_TPDOreadEntry(OD_IO_t *OD_IO, uint8_t *dataTPDO) {
+    OD_stream_t *stream = &OD_IO->stream;
+
+    /* get mappedLength from temporary storage */
+    uint8_t mappedLength = (uint8_t) stream->dataOffset;
+
+    /* length of OD variable may be larger than mappedLength */
+    OD_size_t ODdataLength = stream->dataLength;
+    if (ODdataLength > CO_PDO_MAX_SIZE)
+        ODdataLength = CO_PDO_MAX_SIZE;
+
+    /* If mappedLength is smaller than ODdataLength, use auxiliary buffer */
+    uint8_t buf[CO_PDO_MAX_SIZE];
+    uint8_t *dataTPDOCopy;
+    if (ODdataLength > mappedLength) {
+        memset(buf, 0, sizeof(buf));
+        dataTPDOCopy = buf;
+    }
+    else {
+        dataTPDOCopy = dataTPDO;
+    }
+
+    /* Set stream.dataOffset to zero, perform OD_IO.read()
+     * and store mappedLength back to stream.dataOffset */
+    stream->dataOffset= 0;
+    OD_size_t countRd;
+    OD_IO->read(stream, dataTPDOCopy, ODdataLength, &countRd);
+    stream->dataOffset = mappedLength;
+
+    /* swap multibyte data if big-endian */
+ #ifdef CO_BIG_ENDIAN
+    if ((stream->attribute & ODA_MB) != 0) {
+        uint8_t *lo = dataTPDOCopy;
+        uint8_t *hi = dataTPDOCopy + ODdataLength - 1;
+        while (lo < hi) {
+            uint8_t swap = *lo;
+            *lo++ = *hi;
+            *hi-- = swap;
+        }
+    }
+ #endif
+
+    /* If auxiliary buffer, copy it to the TPDO */
+    if (ODdataLength > mappedLength) {
+        memcpy(dataTPDO, buf, mappedLength);
+    }
+
+    return mappedLength;
+}
+#endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS */
+
+
+/*
+ * Read TPDO data from Object Dictionary variables.
+ *
+ * @param TPDO TPDO object.
+ * @param [out] dataTPDO Buffer for PDO_common.dataLength bytes.
+ */
+static void CO_TPDOreadData(CO_TPDO_t *TPDO, uint8_t *dataTPDO) {
+    CO_PDO_common_t *PDO = &TPDO->PDO_common;
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_ROUTING
+    if (TPDO->routedCount > 0) {
+        /* data of routed variables are already in CANtxBuff */
+        const uint8_t *dataRouted = &TPDO->CANtxBuff->data[0];
+        for (uint8_t i = 0; i < PDO->mappedObjectsCount; i++) {
+            uint8_t mappedLength = (uint8_t) PDO->OD_IO[i].stream.dataOffset;
+            if (!TPDO->routed[i]) {
+                CO_TPDOreadEntry(&PDO->OD_IO[i], dataTPDO);
+            }
+            else if (dataTPDO != dataRouted) {
+                memcpy(dataTPDO, dataRouted, mappedLength);
+            }
+            dataTPDO += mappedLength;
+            dataRouted += mappedLength;
+        }
+        return;
+    }
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_PLAN
+    for (uint8_t r = 0; r < PDO->copyPlanCount; r++) {
+        CO_PDO_copyRun_t *run = &PDO->copyPlan[r];
+
+        /* mapped variables without OD extension, copy directly */
+        if (run->dataOD != NULL) {
+            memcpy(dataTPDO, run->dataOD, run->length);
+        }
+        else {
+            CO_TPDOreadEntry(&PDO->OD_IO[run->mapIndex], dataTPDO);
+        }
+        dataTPDO += run->length;
+    }
+ #else
+    for (uint8_t i = 0; i < PDO->mappedObjectsCount; i++) {
+        dataTPDO += CO_TPDOreadEntry(&PDO->OD_IO[i], dataTPDO);
+    }
+ #endif
+#else
+    for (uint8_t i = 0; i < PDO->dataLength; i++) {
+        dataTPDO[i] = *PDO->mapPointer[i];
+    }
+#endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS */
+}
+
+
 /*
  * Send TPDO message.
  *
@@ -1226,93 +1855,203 @@ CO_ReturnError_t CO_TPDO_init(CO_TPDO_t *TPDO,
  */
 static CO_ReturnError_t CO_TPDOsend(CO_TPDO_t *TPDO) {
     CO_PDO_common_t *PDO = &TPDO->PDO_common;
-    uint8_t *dataTPDO = &TPDO->CANtxBuff->data[0];
+
+    CO_TPDOreadData(TPDO, &TPDO->CANtxBuff->data[0]);
+
+    /* In event driven TPDO indicate transmission of all OD variables. Without
+     * CO_CONFIG_PDO_OD_IO_ACCESS mappedObjectsCount equals dataLength. */
 #if OD_FLAGS_PDO_SIZE > 0
-    bool_t eventDriven =
-            (TPDO->transmissionType == CO_PDO_TRANSM_TYPE_SYNC_ACYCLIC
-            || TPDO->transmissionType >= CO_PDO_TRANSM_TYPE_SYNC_EVENT_LO);
+    if (TPDO->transmissionType == CO_PDO_TRANSM_TYPE_SYNC_ACYCLIC
+        || TPDO->transmissionType >= CO_PDO_TRANSM_TYPE_SYNC_EVENT_LO
+    ) {
+        for (uint8_t i = 0; i < PDO->mappedObjectsCount; i++) {
+            uint8_t *flagPDObyte = PDO->flagPDObyte[i];
+            if (flagPDObyte != NULL) {
+                *flagPDObyte |= PDO->flagPDObitmask[i];
+            }
+        }
+    }
 #endif
 
-#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS
-    for (uint8_t i = 0; i < PDO->mappedObjectsCount; i++) {
-        OD_IO_t *OD_IO = &PDO->OD_IO[i];
-        OD_stream_t *stream = &OD_IO->stream;
+    TPDO->sendRequest = false;
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_TIMERS_ENABLE
+    TPDO->eventTimer = TPDO->eventTime_us;
+    TPDO->inhibitTimer = TPDO->inhibitTime_us;
+#endif
 
-        /* get mappedLength from temporary storage */
-        uint8_t mappedLength = (uint8_t) stream->dataOffset;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_BATCH
+    /* synchronous TPDO will be sent together with others by application */
+    CO_CANtxBatch_t *txBatch = TPDO->txBatch;
+    if (txBatch != NULL && txBatch->CANmodule == PDO->CANdev
+        && TPDO->transmissionType <= CO_PDO_TRANSM_TYPE_SYNC_240
+        && txBatch->count < CO_CONFIG_DRIVER_TX_BATCH_SIZE
+    ) {
+        txBatch->buffers[txBatch->count++] = TPDO->CANtxBuff;
+        return CO_ERROR_NO;
+    }
+#endif
+    return CO_CANsend(PDO->CANdev, TPDO->CANtxBuff);
+}
 
-        /* length of OD variable may be larger than mappedLength */
-        OD_size_t ODdataLength = stream->dataLength;
-        if (ODdataLength > CO_PDO_MAX_SIZE)
-            ODdataLength = CO_PDO_MAX_SIZE;
 
-        /* If mappedLength is smaller than ODdataLength, use auxiliary buffer */
-        uint8_t buf[CO_PDO_MAX_SIZE];
-        uint8_t *dataTPDOCopy;
-        if (ODdataLength > mappedLength) {
-            memset(buf, 0, sizeof(buf));
-            dataTPDOCopy = buf;
-        }
-        else {
-            dataTPDOCopy = dataTPDO;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_BATCH
+/******************************************************************************/
+void CO_TPDO_initTxBatch(CO_TPDO_t *TPDO, CO_CANtxBatch_t *txBatch) {
+    if (TPDO != NULL) {
+        TPDO->txBatch = txBatch;
+    }
+}
+#endif
+
+
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_ENABLE) \
+    && ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_SYNC_OFFSET)
+/******************************************************************************/
+void CO_TPDO_setSyncOffset(CO_TPDO_t *TPDO, uint32_t syncOffset_us) {
+    if (TPDO != NULL) {
+        TPDO->syncOffset_us = syncOffset_us;
+        TPDO->syncOffsetPending = false;
+    }
+}
+
+/* Send synchronous TPDO now or after syncOffset_us */
+static void CO_TPDOsendSync(CO_TPDO_t *TPDO) {
+    if (TPDO->syncOffset_us > 0) {
+        TPDO->syncOffsetPending = true;
+    }
+    else {
+        CO_TPDOsend(TPDO);
+    }
+}
+#else
+#define CO_TPDOsendSync(TPDO) CO_TPDOsend(TPDO)
+#endif
+
+
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_COS
+/******************************************************************************/
+void CO_TPDO_setCOS(CO_TPDO_t *TPDO, bool_t enable) {
+    if (TPDO != NULL) {
+        TPDO->cosEnabled = enable;
+        for (uint8_t i = 0; i < CO_PDO_MAX_MAPPED_ENTRIES; i++) {
+            TPDO->cos[i].mask = 0xFFFFFFFF;
+            TPDO->cos[i].deadband = 0;
+            TPDO->cos[i].isSigned = false;
         }
+    }
+}
 
-        /* Set stream.dataOffset to zero, perform OD_IO.read()
-         * and store mappedLength back to stream.dataOffset */
-        stream->dataOffset= 0;
-        OD_size_t countRd;
-        OD_IO->read(stream, dataTPDOCopy, ODdataLength, &countRd);
-        stream->dataOffset = mappedLength;
 
-        /* swap multibyte data if big-endian */
- #ifdef CO_BIG_ENDIAN
-        if ((stream->attribute & ODA_MB) != 0) {
-            uint8_t *lo = dataTPDOCopy;
-            uint8_t *hi = dataTPDOCopy + ODdataLength - 1;
-            while (lo < hi) {
-                uint8_t swap = *lo;
-                *lo++ = *hi;
-                *hi-- = swap;
+/******************************************************************************/
+CO_ReturnError_t CO_TPDO_setCOSdeadband(CO_TPDO_t *TPDO,
+                                        uint8_t mapIndex,
+                                        uint32_t mask,
+                                        uint32_t deadband,
+                                        bool_t isSigned)
+{
+    if (TPDO == NULL || mapIndex >= CO_PDO_MAX_MAPPED_ENTRIES) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    TPDO->cos[mapIndex].mask = mask;
+    TPDO->cos[mapIndex].deadband = deadband;
+    TPDO->cos[mapIndex].isSigned = isSigned;
+    return CO_ERROR_NO;
+}
+
+
+/* Get little endian integer of length 1 to 4 bytes */
+static int64_t CO_TPDOcosValue(const uint8_t *data, uint8_t length,
+                               uint32_t mask, bool_t isSigned)
+{
+    uint32_t value = 0;
+
+    for (uint8_t j = length; j > 0; j--) {
+        value = (value << 8) | data[j - 1];
+    }
+    value &= mask;
+
+    if (isSigned && length < 4) {
+        uint32_t signBit = (uint32_t)1 << (length * 8 - 1);
+        return (int64_t)(value ^ signBit) - (int64_t)signBit;
+    }
+    return isSigned ? (int64_t)(int32_t)value : (int64_t)value;
+}
+
+
+/*
+ * Detect change of state of mapped data.
+ *
+ * @param TPDO TPDO object.
+ *
+ * @return true, if any mapped variable differs from the last transmitted data
+ * for more than deadband.
+ */
+static bool_t CO_TPDOcosChanged(CO_TPDO_t *TPDO) {
+    CO_PDO_common_t *PDO = &TPDO->PDO_common;
+    const uint8_t *dataLast = &TPDO->CANtxBuff->data[0];
+    uint8_t data[CO_PDO_MAX_SIZE];
+    uint8_t offset = 0;
+
+    CO_TPDOreadData(TPDO, data);
+
+    for (uint8_t i = 0; i < PDO->mappedObjectsCount; i++) {
+        uint8_t mappedLength = (uint8_t) PDO->OD_IO[i].stream.dataOffset;
+        const uint8_t *a = &data[offset];
+        const uint8_t *b = &dataLast[offset];
+        CO_TPDO_cos_t *cos = &TPDO->cos[i];
+
+        offset += mappedLength;
+        if (mappedLength > 4) {
+            if (memcmp(a, b, mappedLength) != 0) {
+                return true;
             }
         }
- #endif
-
-        /* If auxiliary buffer, copy it to the TPDO */
-        if (ODdataLength > mappedLength) {
-            memcpy(dataTPDO, buf, mappedLength);
+        else if (mappedLength > 0) {
+            int64_t diff = CO_TPDOcosValue(a, mappedLength, cos->mask,
+                                           cos->isSigned)
+                         - CO_TPDOcosValue(b, mappedLength, cos->mask,
+                                           cos->isSigned);
+            if (diff < 0) {
+                diff = -diff;
+            }
+            if (diff > (int64_t)cos->deadband) {
+                return true;
+            }
         }
+    }
+    return false;
+}
+#endif /* (CO_CONFIG_PDO) & CO_CONFIG_TPDO_COS */
+
 
-        /* In event driven TPDO indicate transmission of OD variable */
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_REQUEST_COUNT
+/******************************************************************************/
+void CO_TPDO_checkRequests(CO_TPDO_t *TPDO) {
  #if OD_FLAGS_PDO_SIZE > 0
-        uint8_t *flagPDObyte = PDO->flagPDObyte[i];
-        if (flagPDObyte != NULL && eventDriven) {
-           *flagPDObyte |= PDO->flagPDObitmask[i];
-        }
- #endif
+    CO_PDO_common_t *PDO = &TPDO->PDO_common;
 
-        dataTPDO += mappedLength;
+    if (!PDO->valid || TPDO->sendRequest
+        || (TPDO->transmissionType != CO_PDO_TRANSM_TYPE_SYNC_ACYCLIC
+            && TPDO->transmissionType < CO_PDO_TRANSM_TYPE_SYNC_EVENT_LO)
+    ) {
+        return;
     }
-#else
-    for (uint8_t i = 0; i < PDO->dataLength; i++) {
-        dataTPDO[i] = *PDO->mapPointer[i];
 
-        /* In event driven TPDO indicate transmission of OD variable */
- #if OD_FLAGS_PDO_SIZE > 0
+    for (uint8_t i = 0; i < PDO->mappedObjectsCount; i++) {
         uint8_t *flagPDObyte = PDO->flagPDObyte[i];
-        if (flagPDObyte != NULL && eventDriven) {
-           *flagPDObyte |= PDO->flagPDObitmask[i];
+        if (flagPDObyte != NULL
+            && (*flagPDObyte & PDO->flagPDObitmask[i]) == 0
+        ) {
+            TPDO->sendRequest = true;
+            break;
         }
- #endif
     }
-#endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS */
-
-    TPDO->sendRequest = false;
-#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_TIMERS_ENABLE
-    TPDO->eventTimer = TPDO->eventTime_us;
-    TPDO->inhibitTimer = TPDO->inhibitTime_us;
-#endif
-    return CO_CANsend(PDO->CANdev, TPDO->CANtxBuff);
+ #else
+    (void) TPDO;
+ #endif
 }
+#endif
 
 
 /******************************************************************************/
@@ -1354,7 +2093,8 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
             }
  #endif
             /* check for any OD_requestTPDO() */
- #if OD_FLAGS_PDO_SIZE > 0
+ #if OD_FLAGS_PDO_SIZE > 0 \
+     && ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_REQUEST_COUNT) == 0
             if (!TPDO->sendRequest) {
                 for (uint8_t i = 0; i < PDO->mappedObjectsCount; i++) {
                     uint8_t *flagPDObyte = PDO->flagPDObyte[i];
@@ -1377,6 +2117,15 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
             TPDO->inhibitTimer = (TPDO->inhibitTimer > timeDifference_us)
                                ? (TPDO->inhibitTimer - timeDifference_us) : 0;
 
+ #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_COS
+            /* change of state of mapped data */
+            if (TPDO->cosEnabled && !TPDO->sendRequest
+                && TPDO->inhibitTimer == 0 && CO_TPDOcosChanged(TPDO)
+            ) {
+                TPDO->sendRequest = true;
+            }
+ #endif
+
             /* send TPDO */
             if (TPDO->sendRequest && TPDO->inhibitTimer == 0) {
                 CO_TPDOsend(TPDO);
@@ -1402,7 +2151,7 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
         else if (TPDO->SYNC != NULL && syncWas) {
             /* send synchronous acyclic TPDO */
             if (TPDO->transmissionType == CO_PDO_TRANSM_TYPE_SYNC_ACYCLIC) {
-                if (TPDO->sendRequest) CO_TPDOsend(TPDO);
+                if (TPDO->sendRequest) CO_TPDOsendSync(TPDO);
             }
             /* send synchronous cyclic TPDO */
             else {
@@ -1424,16 +2173,38 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
                 if (TPDO->syncCounter == 254) {
                     if (TPDO->SYNC->counter == TPDO->syncStartValue) {
                         TPDO->syncCounter = TPDO->transmissionType;
-                        CO_TPDOsend(TPDO);
+                        CO_TPDOsendSync(TPDO);
                     }
                 }
                 /* Send TPDO after every N-th Sync */
                 else if (--TPDO->syncCounter == 0) {
                     TPDO->syncCounter = TPDO->transmissionType;
-                    CO_TPDOsend(TPDO);
+                    CO_TPDOsendSync(TPDO);
                 }
             }
         } /* else if (TPDO->SYNC && syncWas) */
+
+ #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_SYNC_OFFSET
+        /* send synchronous TPDO delayed by syncOffset_us */
+        if (TPDO->syncOffsetPending && TPDO->SYNC != NULL) {
+            if (TPDO->SYNC->syncIsOutsideWindow) {
+                TPDO->syncOffsetPending = false;
+            }
+            else if (TPDO->SYNC->timer >= TPDO->syncOffset_us) {
+                TPDO->syncOffsetPending = false;
+                CO_TPDOsend(TPDO);
+            }
+  #if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_TIMERS_ENABLE) \
+      && ((CO_CONFIG_PDO) & CO_CONFIG_FLAG_TIMERNEXT)
+            else if (timerNext_us != NULL) {
+                uint32_t diff = TPDO->syncOffset_us - TPDO->SYNC->timer;
+                if (*timerNext_us > diff) {
+                    *timerNext_us = diff;
+                }
+            }
+  #endif
+        }
+ #endif
 #endif
 
     }
@@ -1445,6 +2216,9 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
 #endif
 #if (CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_ENABLE
         TPDO->syncCounter = 255;
+ #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_SYNC_OFFSET
+        TPDO->syncOffsetPending = false;
+ #endif
 #endif
     }
 }
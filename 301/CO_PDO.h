@@ -133,15 +133,17 @@ extern "C" {
  *   COB-ID
  */
 
-/** Maximum size of PDO message, 8 for standard CAN */
+/** Maximum size of PDO message, 8 for standard CAN, 64 for CAN FD
+ * (@ref CO_CONFIG_DRIVER_FD) */
 #ifndef CO_PDO_MAX_SIZE
-#define CO_PDO_MAX_SIZE 8
+#define CO_PDO_MAX_SIZE CO_CAN_MAX_DATA_LEN
 #endif
 
 /** Maximum number of entries, which can be mapped to PDO, 8 for standard CAN,
- * may be less to preserve RAM usage */
+ * 64 for CAN FD, so 64 byte PDO can be mapped with byte-sized entries. May be
+ * less to preserve RAM usage, each entry takes one OD_IO_t in every PDO. */
 #ifndef CO_PDO_MAX_MAPPED_ENTRIES
-#define CO_PDO_MAX_MAPPED_ENTRIES 8
+#define CO_PDO_MAX_MAPPED_ENTRIES CO_PDO_MAX_SIZE
 #endif
 
 /** Number of CANopen RPDO objects, which uses default CAN indentifiers.
@@ -183,6 +185,21 @@ typedef enum {
     (device profile and application profile specific) */
 } CO_PDO_transmissionTypes_t;
 
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_PLAN) || defined CO_DOXYGEN
+/**
+ * One run of the PDO copy plan, see @ref CO_CONFIG_PDO_COPY_PLAN
+ */
+typedef struct {
+    /** Pointer to the original OD location for direct copy or NULL, if
+     * OD_IO[mapIndex] read()/write() function must be used. */
+    uint8_t *dataOD;
+    /** Index of the first mapped entry in the run */
+    uint8_t mapIndex;
+    /** Number of PDO data bytes in the run */
+    uint8_t length;
+} CO_PDO_copyRun_t;
+#endif
+
 /**
  * PDO object, common properties
  */
@@ -211,6 +228,17 @@ typedef struct {
     /** Bitmask for the flagPDObyte */
     uint8_t flagPDObitmask[CO_PDO_MAX_MAPPED_ENTRIES];
   #endif
+  #if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_COPY_PLAN) || defined CO_DOXYGEN
+    /** Copy plan, consecutive runs cover all PDO data bytes */
+    CO_PDO_copyRun_t copyPlan[CO_PDO_MAX_MAPPED_ENTRIES];
+    /** Number of runs in copyPlan */
+    uint8_t copyPlanCount;
+   #if ((CO_CONFIG_PDO) & CO_CONFIG_RPDO_ISR_PROCESS) || defined CO_DOXYGEN
+    /** True, if all runs of the RPDO copyPlan are copied directly or are
+     * dummy entries */
+    bool_t copyPlanDirect;
+   #endif
+  #endif
 #else
     /* Pointers to data objects inside OD, where PDO will be copied */
     uint8_t *mapPointer[CO_PDO_MAX_SIZE];
@@ -219,6 +247,17 @@ typedef struct {
     uint8_t flagPDObitmask[CO_PDO_MAX_SIZE];
   #endif
 #endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_FAST_REINIT) || defined CO_DOXYGEN
+    /** Mapping parameters (subindexes 1 and above) from the last successful
+     * mapping initialization, see @ref CO_CONFIG_PDO_FAST_REINIT */
+    uint32_t mapCache[CO_PDO_MAX_MAPPED_ENTRIES];
+    /** Number of mapped objects (subindex 0) from the mapping parameter */
+    uint8_t mapCacheCount;
+    /** True, if mapCache corresponds to the current mapping */
+    bool_t mapCacheValid;
+    /** Object dictionary used for the cached mapping */
+    OD_t *mapCacheOD;
+#endif
 #if ((CO_CONFIG_PDO) & CO_CONFIG_FLAG_OD_DYNAMIC) || defined CO_DOXYGEN
     /** True for RPDO, false for TPDO */
     bool_t isRPDO;
@@ -283,6 +322,23 @@ typedef struct {
     /** From CO_RPDO_initCallbackPre() or NULL */
     void *functSignalObjectPre;
 #endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_ROUTING) || defined CO_DOXYGEN
+    /** List of routes from this RPDO, see CO_RPDO_addRoute() */
+    struct CO_PDOroute *routes;
+#endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_RPDO_ISR_PROCESS) || defined CO_DOXYGEN
+    /** From CO_RPDO_setIsrProcessing() */
+    bool_t isrProcess;
+    /** Set by CO_RPDO_process(), true if PDO is valid and NMT is operational */
+    volatile bool_t isrActive;
+    /** Last message, written into OD by receive callback */
+    uint8_t isrData[CO_PDO_MAX_SIZE];
+    /** Sequence counter of isrData, odd while receive callback writes it */
+    volatile uint16_t isrSeq;
+    /** Variable indicates, if new PDO message was processed by receive
+     * callback. */
+    volatile void *isrNew;
+#endif
 } CO_RPDO_t;
 
 
@@ -341,6 +397,33 @@ void CO_RPDO_initCallbackPre(CO_RPDO_t *RPDO,
 #endif
 
 
+#if ((CO_CONFIG_PDO) & CO_CONFIG_RPDO_ISR_PROCESS) || defined CO_DOXYGEN
+/**
+ * Enable processing of RPDO in CAN receive callback.
+ *
+ * If enabled, event driven RPDO (transmission type 254 or 255) is copied into
+ * mapped OD variables directly by CAN receive callback, which eliminates the
+ * latency of the mainline. It is effective only, if all mapped OD variables
+ * are copied directly, without OD extension (see @ref CO_CONFIG_PDO_COPY_PLAN)
+ * and NMT state is operational. Otherwise RPDO is processed by
+ * CO_RPDO_process() as usual. Received message is stored into a buffer
+ * guarded by a sequence counter, copied into OD variables and then published
+ * to CO_RPDO_process(), which handles timeout and routing. CO_RPDO_process()
+ * copies the buffer and retries, if receive callback changed it meanwhile, so
+ * routed data are never mixed from two messages. Callback from
+ * CO_RPDO_initCallbackPre() is called after OD variables are written, so it
+ * can wake the control task immediately.
+ *
+ * @warning Mapped OD variables are written from the CAN receive thread
+ * (interrupt). Application must read them inside @ref CO_LOCK_OD().
+ *
+ * @param RPDO This object.
+ * @param enable True to enable, false to disable processing in callback.
+ */
+void CO_RPDO_setIsrProcessing(CO_RPDO_t *RPDO, bool_t enable);
+#endif
+
+
 /**
  * Process received PDO messages.
  *
@@ -370,6 +453,22 @@ void CO_RPDO_process(CO_RPDO_t *RPDO,
  *      T P D O
  ******************************************************************************/
 #if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE) || defined CO_DOXYGEN
+#if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_COS) || defined CO_DOXYGEN
+/**
+ * Change of state parameters of one mapped variable, see
+ * CO_TPDO_setCOSdeadband().
+ */
+typedef struct {
+    /** Bits of the variable, which are compared */
+    uint32_t mask;
+    /** Change of the masked value, which is ignored */
+    uint32_t deadband;
+    /** True, if variable is signed integer */
+    bool_t isSigned;
+} CO_TPDO_cos_t;
+#endif
+
+
 /**
  * TPDO object.
  */
@@ -391,6 +490,13 @@ typedef struct {
     /** SYNC counter used for PDO sending */
     uint8_t syncCounter;
 #endif
+#if (((CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_ENABLE) \
+     && ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_SYNC_OFFSET)) || defined CO_DOXYGEN
+    /** From CO_TPDO_setSyncOffset(), time after SYNC in microseconds */
+    uint32_t syncOffset_us;
+    /** True, if synchronous TPDO is waiting for syncOffset_us to expire */
+    bool_t syncOffsetPending;
+#endif
 #if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_TIMERS_ENABLE) || defined CO_DOXYGEN
     /** Inhibit time from object dictionary translated to microseconds */
     uint32_t inhibitTime_us;
@@ -401,6 +507,25 @@ typedef struct {
     /** Event timer variable in microseconds */
     uint32_t eventTimer;
 #endif
+#if ((CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_BATCH) || defined CO_DOXYGEN
+    /** From CO_TPDO_initTxBatch() or NULL */
+    CO_CANtxBatch_t *txBatch;
+#endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_COS) || defined CO_DOXYGEN
+    /** True, if change of state detection is enabled by CO_TPDO_setCOS() */
+    bool_t cosEnabled;
+    /** Change of state parameters for each mapped variable */
+    CO_TPDO_cos_t cos[CO_PDO_MAX_MAPPED_ENTRIES];
+#endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_ROUTING) || defined CO_DOXYGEN
+    /** True for mapped variable, which data are written by route from RPDO
+     * and not read from OD, see CO_RPDO_addRoute() */
+    bool_t routed[CO_PDO_MAX_MAPPED_ENTRIES];
+    /** Number of true elements in routed */
+    uint8_t routedCount;
+    /** List of routes to this TPDO, linked by CO_PDOroute_t.nextIn */
+    struct CO_PDOroute *routesIn;
+#endif
 } CO_TPDO_t;
 
 
@@ -441,6 +566,43 @@ CO_ReturnError_t CO_TPDO_init(CO_TPDO_t *TPDO,
                               uint32_t *errInfo);
 
 
+#if ((CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_BATCH) || defined CO_DOXYGEN
+/**
+ * Initialize TPDO batch transmission.
+ *
+ * If set, synchronous TPDO (transmission type 0 to 240) is not sent
+ * immediately from CO_TPDO_process(), but its CAN buffer is appended to the
+ * txBatch. Application must then send the batch with CO_CANsendBatch() and
+ * set txBatch->count to zero, after CO_TPDO_process() was called for all
+ * TPDOs. If txBatch is full or belongs to other CAN module, TPDO is sent as
+ * usual.
+ *
+ * @param TPDO This object.
+ * @param txBatch Batch object, may be shared between TPDOs, or NULL.
+ */
+void CO_TPDO_initTxBatch(CO_TPDO_t *TPDO, CO_CANtxBatch_t *txBatch);
+#endif
+
+
+#if (((CO_CONFIG_PDO) & CO_CONFIG_PDO_SYNC_ENABLE) \
+     && ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_SYNC_OFFSET)) || defined CO_DOXYGEN
+/**
+ * Set transmit offset of synchronous TPDO.
+ *
+ * Synchronous TPDO (transmission type 0 to 240) is then sent from
+ * CO_TPDO_process() syncOffset_us after the SYNC instead of immediately. Time
+ * is measured with the SYNC timer, see @ref CO_SYNC_t. If "Synchronous window
+ * length" (OD 1007) expires before, TPDO is not sent in this SYNC period.
+ * Offset should be shorter than SYNC period. Function must be called after
+ * each CO_TPDO_init().
+ *
+ * @param TPDO This object.
+ * @param syncOffset_us Offset in microseconds, 0 disables it.
+ */
+void CO_TPDO_setSyncOffset(CO_TPDO_t *TPDO, uint32_t syncOffset_us);
+#endif
+
+
 /**
  * Request transmission of TPDO message.
  *
@@ -455,6 +617,66 @@ static inline void CO_TPDOsendRequest(CO_TPDO_t *TPDO) {
 }
 
 
+#if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_COS) || defined CO_DOXYGEN
+/**
+ * Enable change of state detection on event driven TPDO.
+ *
+ * If enabled and TPDO transmission type is 254 or 255, CO_TPDO_process()
+ * reads mapped OD variables after inhibit time expires and sends TPDO, if any
+ * of them differs from the last transmitted data. Mapped variables are
+ * compared bytewise, until CO_TPDO_setCOSdeadband() is used. Read functions of
+ * mapped OD variables are then called on each CO_TPDO_process(), so they
+ * should not have side effects. Function must be called after each
+ * CO_TPDO_init(), deadbands are also cleared.
+ *
+ * @param TPDO This object.
+ * @param enable Enable or disable change of state detection.
+ */
+void CO_TPDO_setCOS(CO_TPDO_t *TPDO, bool_t enable);
+
+
+/**
+ * Set bit mask and deadband of mapped variable for change of state detection.
+ *
+ * Change of mapped variable is detected, if absolute difference between masked
+ * current value and masked last transmitted value is larger than deadband.
+ * For example, mask 0xFFF0 ignores four least significant bits of 16-bit
+ * analog value. Mask and deadband are used for mapped variables with length up
+ * to four bytes, longer are always compared bytewise. Function must be called
+ * after CO_TPDO_setCOS() and again after PDO mapping is changed.
+ *
+ * @param TPDO This object.
+ * @param mapIndex Index of mapped variable, 0 for first mapped variable.
+ * @param mask Bits of the variable which are compared, 0xFFFFFFFF for all.
+ * @param deadband Ignored change of the masked value, 0 detects any change.
+ * @param isSigned True, if variable is signed integer.
+ *
+ * @return CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_TPDO_setCOSdeadband(CO_TPDO_t *TPDO,
+                                        uint8_t mapIndex,
+                                        uint32_t mask,
+                                        uint32_t deadband,
+                                        bool_t isSigned);
+#endif
+
+
+#if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_REQUEST_COUNT) || defined CO_DOXYGEN
+/**
+ * Check for @ref OD_requestTPDO() on OD variables mapped to TPDO.
+ *
+ * If TPDO is valid and event driven and flagsPDO bit of any mapped variable is
+ * cleared, sendRequest is set. With CO_CONFIG_TPDO_REQUEST_COUNT this check is
+ * not part of CO_TPDO_process(). Function must be called for all TPDOs before
+ * CO_TPDO_process() is called for any of them, but only when
+ * @ref OD_TPDOrequestCount has changed. CO_process_TPDO() does that.
+ *
+ * @param TPDO This object.
+ */
+void CO_TPDO_checkRequests(CO_TPDO_t *TPDO);
+#endif
+
+
 /**
  * Process transmitting PDO messages.
  *
@@ -477,6 +699,79 @@ void CO_TPDO_process(CO_TPDO_t *TPDO,
                      bool_t syncWas);
 #endif /* (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE */
 
+
+/*******************************************************************************
+ *      P D O   R O U T I N G
+ ******************************************************************************/
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_ROUTING) || defined CO_DOXYGEN
+/**
+ * Route of data range from RPDO to TPDO, see CO_RPDO_addRoute().
+ *
+ * Object is allocated by application and must remain valid as long as RPDO
+ * uses it.
+ */
+typedef struct CO_PDOroute {
+    /** Source RPDO */
+    CO_RPDO_t *RPDO;
+    /** Destination TPDO */
+    CO_TPDO_t *TPDO;
+    /** Offset of the data in the received RPDO, in bytes */
+    uint8_t srcOffset;
+    /** Offset of the data in the transmitted TPDO, in bytes */
+    uint8_t dstOffset;
+    /** Length of the routed data in bytes */
+    uint8_t length;
+    /** If true, TPDO is sent immediately from CO_RPDO_process() */
+    bool_t forwardOnRx;
+    /** Next route from the same RPDO or NULL */
+    struct CO_PDOroute *next;
+    /** Next route to the same TPDO or NULL */
+    struct CO_PDOroute *nextIn;
+} CO_PDOroute_t;
+
+
+/**
+ * Add route of data from RPDO to TPDO.
+ *
+ * When CO_RPDO_process() processes received RPDO, it writes mapped OD
+ * variables as usual, then copies length bytes from srcOffset of RPDO data
+ * directly into TPDO CAN buffer at dstOffset. Mapped variables of TPDO inside
+ * the routed range are then not read from the Object Dictionary by TPDO, so
+ * routed data skip OD access and application. Routed range must cover whole
+ * mapped variables of TPDO. Byte order is preserved, so source and destination
+ * variables must have the same type.
+ *
+ * If forwardOnRx is false, transmission of TPDO is requested as with
+ * OD_requestTPDO(), so event driven TPDO is sent by CO_TPDO_process() after
+ * inhibit time, synchronous TPDO on its SYNC. If forwardOnRx is true, valid
+ * TPDO is sent immediately from CO_RPDO_process(), regardless of its
+ * transmission type and inhibit time, so latency is fixed.
+ *
+ * Function must be called after each CO_RPDO_init() and CO_TPDO_init(), for
+ * example after CO_CANopenInitPDO(). If mapping of RPDO or TPDO is changed,
+ * all routes from that RPDO or to that TPDO are removed and must be added
+ * again. Route objects are only unlinked, they remain owned by application.
+ *
+ * @param RPDO Source RPDO.
+ * @param route Route object, will be initialized.
+ * @param TPDO Destination TPDO.
+ * @param srcOffset Offset of the data in the received RPDO, in bytes.
+ * @param dstOffset Offset of the data in the transmitted TPDO, in bytes.
+ * @param length Length of the routed data in bytes.
+ * @param forwardOnRx Send TPDO immediately after RPDO is processed.
+ *
+ * @return CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT, if range is outside of
+ * PDOs or does not cover whole mapped variables of TPDO.
+ */
+CO_ReturnError_t CO_RPDO_addRoute(CO_RPDO_t *RPDO,
+                                  CO_PDOroute_t *route,
+                                  CO_TPDO_t *TPDO,
+                                  uint8_t srcOffset,
+                                  uint8_t dstOffset,
+                                  uint8_t length,
+                                  bool_t forwardOnRx);
+#endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_ROUTING */
+
 /** @} */ /* CO_PDO */
 
 #ifdef __cplusplus
@@ -539,6 +539,8 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
 
             odRet = OD_getSub(OD_find(SDO_C->OD, SDO_C->index), SDO_C->subIndex,
                               &SDO_C->OD_IO, false);
+            SDO_C->ODlockGroup = OD_lockGroup(SDO_C->index,
+                                              &SDO_C->OD_IO.stream);
 
             if (odRet != ODR_OK) {
                 abortCode = (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
@@ -623,10 +625,10 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
                 OD_size_t countWritten = 0;
 
                 /* write data to Object Dictionary */
-                CO_LOCK_OD(SDO_C->CANdevTx);
+                CO_LOCK_OD_GROUP(SDO_C->CANdevTx, SDO_C->ODlockGroup);
                 ODR_t odRet = SDO_C->OD_IO.write(&SDO_C->OD_IO.stream, buf,
                                                  (OD_size_t)count, &countWritten);
-                CO_UNLOCK_OD(SDO_C->CANdevTx);
+                CO_UNLOCK_OD_GROUP(SDO_C->CANdevTx, SDO_C->ODlockGroup);
 
                 /* verify for errors in write */
                 if (odRet != ODR_OK && odRet != ODR_PARTIAL) {
@@ -772,6 +774,9 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
                     if (SDO_C->block_blksize < 1 || SDO_C->block_blksize > 127)
                         SDO_C->block_blksize = 127;
                     SDO_C->block_seqno = 0;
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_PIPELINE
+                    SDO_C->block_crcNextValid = false;
+#endif
                     CO_fifo_altBegin(&SDO_C->bufFifo, 0);
                     SDO_C->state = CO_SDO_ST_DOWNLOAD_BLK_SUBBLOCK_REQ;
                 }
@@ -785,6 +790,12 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
             case CO_SDO_ST_DOWNLOAD_BLK_SUBBLOCK_REQ:
             case CO_SDO_ST_DOWNLOAD_BLK_SUBBLOCK_RSP: {
                 if (SDO_C->CANrxData[0] == 0xA2) {
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_PIPELINE
+                    /* precalculated crc is valid, if all segments are ok */
+                    bool_t crcNextValid = SDO_C->block_crcNextValid
+                                   && SDO_C->CANrxData[1] == SDO_C->block_seqno;
+                    SDO_C->block_crcNextValid = false;
+#endif
                     /* check number of segments */
                     if (SDO_C->CANrxData[1] < SDO_C->block_seqno) {
                         /* NOT all segments transferred successfully.
@@ -805,6 +816,13 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
                     }
 
                     /* confirm successfully transmitted data */
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_PIPELINE
+                    if (crcNextValid) {
+                        CO_fifo_altFinish(&SDO_C->bufFifo, NULL);
+                        SDO_C->block_crc = SDO_C->block_crcNext;
+                    }
+                    else
+#endif
                     CO_fifo_altFinish(&SDO_C->bufFifo, &SDO_C->block_crc);
 
                     if (SDO_C->finished) {
@@ -999,52 +1017,74 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
         }
 
         case CO_SDO_ST_DOWNLOAD_BLK_SUBBLOCK_REQ: {
-            if (CO_fifo_altGetOccupied(&SDO_C->bufFifo) < 7 && bufferPartial) {
-                /* wait until data are refilled */
-                break;
-            }
-            SDO_C->CANtxBuff->data[0] = ++SDO_C->block_seqno;
-
-            /* get up to 7 data bytes */
-            count = CO_fifo_altRead(&SDO_C->bufFifo,
-                                    &SDO_C->CANtxBuff->data[1], 7);
-            SDO_C->block_noData = (uint8_t)(7 - count);
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_PIPELINE
+            /* send segments in a burst, while CAN transmit buffer is free */
+            do {
+                memset((void *)&SDO_C->CANtxBuff->data[0], 0, 8);
+#endif
+                if (CO_fifo_altGetOccupied(&SDO_C->bufFifo) < 7
+                    && bufferPartial
+                ) {
+                    /* wait until data are refilled */
+                    break;
+                }
+                SDO_C->CANtxBuff->data[0] = ++SDO_C->block_seqno;
 
-            /* verify if sizeTran is too large */
-            SDO_C->sizeTran += count;
-            if (SDO_C->sizeInd > 0 && SDO_C->sizeTran > SDO_C->sizeInd) {
-                SDO_C->sizeTran -= count;
-                abortCode = CO_SDO_AB_DATA_LONG;
-                SDO_C->state = CO_SDO_ST_ABORT;
-                break;
-            }
+                /* get up to 7 data bytes */
+                count = CO_fifo_altRead(&SDO_C->bufFifo,
+                                        &SDO_C->CANtxBuff->data[1], 7);
+                SDO_C->block_noData = (uint8_t)(7 - count);
 
-            /* is end of transfer? Verify also sizeTran */
-            if (CO_fifo_altGetOccupied(&SDO_C->bufFifo) == 0 && !bufferPartial){
-                if (SDO_C->sizeInd > 0 && SDO_C->sizeTran < SDO_C->sizeInd) {
-                    abortCode = CO_SDO_AB_DATA_SHORT;
+                /* verify if sizeTran is too large */
+                SDO_C->sizeTran += count;
+                if (SDO_C->sizeInd > 0 && SDO_C->sizeTran > SDO_C->sizeInd) {
+                    SDO_C->sizeTran -= count;
+                    abortCode = CO_SDO_AB_DATA_LONG;
                     SDO_C->state = CO_SDO_ST_ABORT;
                     break;
                 }
-                SDO_C->CANtxBuff->data[0] |= 0x80;
-                SDO_C->finished = true;
-                SDO_C->state = CO_SDO_ST_DOWNLOAD_BLK_SUBBLOCK_RSP;
-            }
-            /* are all segments in current block transferred? */
-            else if (SDO_C->block_seqno >= SDO_C->block_blksize) {
-                SDO_C->state = CO_SDO_ST_DOWNLOAD_BLK_SUBBLOCK_RSP;
-            }
+
+                /* is end of transfer? Verify also sizeTran */
+                if (CO_fifo_altGetOccupied(&SDO_C->bufFifo) == 0
+                    && !bufferPartial
+                ) {
+                    if (SDO_C->sizeInd > 0
+                        && SDO_C->sizeTran < SDO_C->sizeInd
+                    ) {
+                        abortCode = CO_SDO_AB_DATA_SHORT;
+                        SDO_C->state = CO_SDO_ST_ABORT;
+                        break;
+                    }
+                    SDO_C->CANtxBuff->data[0] |= 0x80;
+                    SDO_C->finished = true;
+                    SDO_C->state = CO_SDO_ST_DOWNLOAD_BLK_SUBBLOCK_RSP;
+                }
+                /* are all segments in current block transferred? */
+                else if (SDO_C->block_seqno >= SDO_C->block_blksize) {
+                    SDO_C->state = CO_SDO_ST_DOWNLOAD_BLK_SUBBLOCK_RSP;
+                }
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_FLAG_TIMERNEXT
-            else {
-                /* Inform OS to call this function again without delay. */
-                if (timerNext_us != NULL) {
-                    *timerNext_us = 0;
+                else {
+                    /* Inform OS to call this function again without delay. */
+                    if (timerNext_us != NULL) {
+                        *timerNext_us = 0;
+                    }
                 }
+#endif
+                /* reset timeout timer and send message */
+                SDO_C->timeoutTimer = 0;
+                CO_CANsend(SDO_C->CANdevTx, SDO_C->CANtxBuff);
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_PIPELINE
+            } while (SDO_C->state == CO_SDO_ST_DOWNLOAD_BLK_SUBBLOCK_REQ
+                     && !SDO_C->CANtxBuff->bufferFull);
+
+            if (SDO_C->state == CO_SDO_ST_DOWNLOAD_BLK_SUBBLOCK_RSP) {
+                /* sub-block is sent, calculate its crc before acknowledge */
+                SDO_C->block_crcNext = CO_fifo_altCrc(&SDO_C->bufFifo,
+                                                      SDO_C->block_crc);
+                SDO_C->block_crcNextValid = true;
             }
 #endif
-            /* reset timeout timer and send message */
-            SDO_C->timeoutTimer = 0;
-            CO_CANsend(SDO_C->CANdevTx, SDO_C->CANtxBuff);
             break;
         }
 
@@ -1183,6 +1223,8 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
 
             odRet = OD_getSub(OD_find(SDO_C->OD, SDO_C->index), SDO_C->subIndex,
                               &SDO_C->OD_IO, false);
+            SDO_C->ODlockGroup = OD_lockGroup(SDO_C->index,
+                                              &SDO_C->OD_IO.stream);
 
             if (odRet != ODR_OK) {
                 abortCode = (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
@@ -1219,10 +1261,10 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
             uint8_t buf[CO_CONFIG_SDO_CLI_BUFFER_SIZE + 1];
 
             /* load data from OD variable into the buffer */
-            CO_LOCK_OD(SDO_C->CANdevTx);
+            CO_LOCK_OD_GROUP(SDO_C->CANdevTx, SDO_C->ODlockGroup);
             ODR_t odRet = SDO_C->OD_IO.read(&SDO_C->OD_IO.stream,
                                             buf, countBuf, &countRd);
-            CO_UNLOCK_OD(SDO_C->CANdevTx);
+            CO_UNLOCK_OD_GROUP(SDO_C->CANdevTx, SDO_C->ODlockGroup);
 
             if (odRet != ODR_OK && odRet != ODR_PARTIAL) {
                 abortCode = (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
@@ -181,6 +181,8 @@ typedef struct {
     uint8_t nodeId;
     /** Object dictionary interface for locally transferred object */
     OD_IO_t OD_IO;
+    /** Lock group of current object, see @ref CO_LOCK_OD_GROUP */
+    OD_lockGroup_t ODlockGroup;
 #endif
     /** From CO_SDOclient_init() */
     CO_CANmodule_t *CANdevRx;
@@ -261,6 +263,13 @@ typedef struct {
     uint8_t block_dataUploadLast[7];
     /** Calculated CRC checksum */
     uint16_t block_crc;
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_PIPELINE) || defined CO_DOXYGEN
+    /** CRC checksum including current sub-block, calculated while waiting for
+     * acknowledge at block download */
+    uint16_t block_crcNext;
+    /** True, if block_crcNext is valid for current sub-block */
+    bool_t block_crcNextValid;
+#endif
 #endif
 } CO_SDOclient_t;
 
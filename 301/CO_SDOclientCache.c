@@ -0,0 +1,233 @@
+/*
+ * Cache of objects, read from remote SDO servers.
+ *
+ * @file        CO_SDOclientCache.c
+ * @ingroup     CO_SDOclientCache
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "301/CO_SDOclientCache.h"
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE
+
+#if CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE > 255
+#error CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE must not be larger than 255.
+#endif
+
+/* Find cached entry, return NULL if not found */
+static CO_SDOclientCache_entry_t *entryFind(CO_SDOclientCache_t *cache,
+                                            uint8_t nodeId,
+                                            uint16_t index,
+                                            uint8_t subIndex)
+{
+    for (uint16_t i = 0; i < CO_CONFIG_SDO_CLI_CACHE_SIZE; i++) {
+        CO_SDOclientCache_entry_t *entry = &cache->entries[i];
+        if (entry->nodeId == nodeId && entry->index == index
+            && entry->subIndex == subIndex
+        ) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_SDOclientCache_init(
+        CO_SDOclientCache_t *cache,
+        const CO_SDOclientCache_policy_t *policies,
+        uint16_t policiesCount)
+{
+    /* verify arguments */
+    if (cache == NULL || (policies == NULL && policiesCount > 0)) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(cache, 0, sizeof(CO_SDOclientCache_t));
+    cache->policies = policies;
+    cache->policiesCount = policiesCount;
+
+    return CO_ERROR_NO;
+}
+
+
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+/******************************************************************************/
+void CO_SDOclientCache_initHBconsumer(CO_SDOclientCache_t *cache,
+                                      CO_HBconsumer_t *HBcons)
+{
+    if (cache != NULL) {
+        cache->HBcons = HBcons;
+        /* values stored before are not connected with HB consumer */
+        CO_SDOclientCache_invalidate(cache, 0);
+    }
+}
+#endif
+
+
+/******************************************************************************/
+bool_t CO_SDOclientCache_lookup(CO_SDOclientCache_t *cache,
+                                uint8_t nodeId,
+                                uint16_t index,
+                                uint8_t subIndex,
+                                uint8_t *buf,
+                                size_t bufSize,
+                                size_t *dataSize)
+{
+    if (cache == NULL || buf == NULL || nodeId == 0) {
+        return false;
+    }
+
+    CO_SDOclientCache_entry_t *entry = entryFind(cache, nodeId,
+                                                 index, subIndex);
+    if (entry != NULL && entry->ttl_ms != CO_SDO_CACHE_STATIC
+        && (uint32_t)(cache->time_ms - entry->stored_ms) >= entry->ttl_ms
+    ) {
+        /* expired */
+        entry->nodeId = 0;
+        entry = NULL;
+    }
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+    if (entry != NULL && entry->HBidx >= 0 && cache->HBcons != NULL) {
+        CO_HBconsNode_t *node = &cache->HBcons->monitoredNodes[entry->HBidx];
+        if (node->nodeId != nodeId || node->resetCount != entry->HBresetCount) {
+            /* node was reset or its heartbeat was lost */
+            entry->nodeId = 0;
+            entry = NULL;
+        }
+    }
+#endif
+    if (entry == NULL || entry->dataSize > bufSize) {
+        cache->misses++;
+        return false;
+    }
+
+    memcpy(buf, entry->data, entry->dataSize);
+    if (dataSize != NULL) {
+        *dataSize = entry->dataSize;
+    }
+    entry->used_ms = cache->time_ms;
+    cache->hits++;
+    return true;
+}
+
+
+/******************************************************************************/
+void CO_SDOclientCache_store(CO_SDOclientCache_t *cache,
+                             uint8_t nodeId,
+                             uint16_t index,
+                             uint8_t subIndex,
+                             const uint8_t *data,
+                             size_t dataSize)
+{
+    const CO_SDOclientCache_policy_t *policy = NULL;
+    CO_SDOclientCache_entry_t *entry;
+
+    if (cache == NULL || data == NULL || nodeId == 0
+        || dataSize > CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE
+    ) {
+        return;
+    }
+
+    for (uint16_t i = 0; i < cache->policiesCount; i++) {
+        const CO_SDOclientCache_policy_t *p = &cache->policies[i];
+        if (p->index == index && subIndex >= p->subIndexFirst
+            && subIndex <= p->subIndexLast
+        ) {
+            policy = p;
+            break;
+        }
+    }
+    if (policy == NULL) {
+        return;
+    }
+
+    entry = entryFind(cache, nodeId, index, subIndex);
+    if (entry == NULL) {
+        /* use free entry or replace the least recently used */
+        uint32_t ageMax = 0;
+        for (uint16_t i = 0; i < CO_CONFIG_SDO_CLI_CACHE_SIZE; i++) {
+            CO_SDOclientCache_entry_t *e = &cache->entries[i];
+            uint32_t age = (uint32_t)(cache->time_ms - e->used_ms);
+            if (e->nodeId == 0) {
+                entry = e;
+                break;
+            }
+            if (entry == NULL || age > ageMax) {
+                entry = e;
+                ageMax = age;
+            }
+        }
+    }
+
+    entry->nodeId = nodeId;
+    entry->index = index;
+    entry->subIndex = subIndex;
+    entry->ttl_ms = policy->ttl_ms;
+    entry->stored_ms = cache->time_ms;
+    entry->used_ms = cache->time_ms;
+    entry->dataSize = (uint8_t)dataSize;
+    memcpy(entry->data, data, dataSize);
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+    entry->HBidx = -1;
+    if (cache->HBcons != NULL) {
+        for (uint8_t i = 0; i < cache->HBcons->numberOfMonitoredNodes; i++) {
+            CO_HBconsNode_t *node = &cache->HBcons->monitoredNodes[i];
+            if (node->nodeId == nodeId && node->time_us != 0) {
+                entry->HBidx = (int8_t)i;
+                entry->HBresetCount = node->resetCount;
+                break;
+            }
+        }
+    }
+#endif
+}
+
+
+/******************************************************************************/
+void CO_SDOclientCache_invalidate(CO_SDOclientCache_t *cache, uint8_t nodeId) {
+    if (cache == NULL) {
+        return;
+    }
+    for (uint16_t i = 0; i < CO_CONFIG_SDO_CLI_CACHE_SIZE; i++) {
+        CO_SDOclientCache_entry_t *entry = &cache->entries[i];
+        if (nodeId == 0 || entry->nodeId == nodeId) {
+            entry->nodeId = 0;
+        }
+    }
+}
+
+
+/******************************************************************************/
+void CO_SDOclientCache_process(CO_SDOclientCache_t *cache,
+                               uint32_t timeDifference_us)
+{
+    if (cache == NULL) {
+        return;
+    }
+
+    cache->time_us += timeDifference_us;
+    cache->time_ms += cache->time_us / 1000;
+    cache->time_us %= 1000;
+}
+
+#endif /* (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE */
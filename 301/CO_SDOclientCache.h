@@ -0,0 +1,259 @@
+/**
+ * Cache of objects, read from remote SDO servers.
+ *
+ * @file        CO_SDOclientCache.h
+ * @ingroup     CO_SDOclientCache
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_SDO_CLIENT_CACHE_H
+#define CO_SDO_CLIENT_CACHE_H
+
+#include "301/CO_SDOclient.h"
+#include "301/CO_HBconsumer.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_SDO_CLI_CACHE_SIZE
+#define CO_CONFIG_SDO_CLI_CACHE_SIZE 16
+#endif
+#ifndef CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE
+#define CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE 32
+#endif
+
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_SDOclientCache SDO client cache
+ * Cache of values, uploaded from remote SDO servers.
+ *
+ * @ingroup CO_SDOclient
+ * @{
+ * Many remote objects never change at runtime, for example identity, device
+ * name or software version. Cache keeps the last uploaded value of such
+ * objects, keyed by node-ID, index and subindex. Repeated reads are then
+ * answered from the cache, without SDO communication on CAN.
+ *
+ * Only objects listed in the @ref CO_SDOclientCache_policy_t table are cached.
+ * Each policy specifies time to live of the cached value or
+ * #CO_SDO_CACHE_STATIC, which keeps the value until it is invalidated. Values
+ * of the node, monitored by heartbeat consumer, are invalid after its
+ * heartbeat timeout or boot-up message, see CO_SDOclientCache_initHBconsumer().
+ * Each value remembers CO_HBconsNode_t.resetCount, so no event between two
+ * calls is missed. Values of other nodes are invalidated only by TTL or by
+ * @ref CO_SDOclientCache_invalidate().
+ *
+ * Cache is used by @ref CO_CANopen_309_3 for 'r' commands, see
+ * CO_GTWA_initCache(). Application may use it in front of own
+ * CO_SDOclientUpload() calls: call @ref CO_SDOclientCache_lookup() before
+ * upload and @ref CO_SDOclientCache_store() after successful upload.
+ *
+ * If cache is full, least recently used value is replaced. Values larger than
+ * @ref CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE are not cached.
+ */
+
+/** Value of ttl_ms in @ref CO_SDOclientCache_policy_t: value never expires */
+#define CO_SDO_CACHE_STATIC 0
+
+
+/**
+ * Caching policy for a range of subindexes of one object.
+ */
+typedef struct {
+    /** Index of the object in Object Dictionary of the SDO server */
+    uint16_t index;
+    /** First cached subindex */
+    uint8_t subIndexFirst;
+    /** Last cached subindex */
+    uint8_t subIndexLast;
+    /** Time to live of the cached value in milliseconds or
+     * #CO_SDO_CACHE_STATIC */
+    uint32_t ttl_ms;
+} CO_SDOclientCache_policy_t;
+
+
+/**
+ * One cached value.
+ */
+typedef struct {
+    /** Node-ID of the SDO server, 0 if entry is free */
+    uint8_t nodeId;
+    /** Subindex of the object */
+    uint8_t subIndex;
+    /** Index of the object */
+    uint16_t index;
+    /** Time to live from the policy */
+    uint32_t ttl_ms;
+    /** Cache time, when value was stored */
+    uint32_t stored_ms;
+    /** Cache time of the last store or lookup, for replacement */
+    uint32_t used_ms;
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE) || defined CO_DOXYGEN
+    /** CO_HBconsNode_t.resetCount of the node, when value was stored */
+    uint16_t HBresetCount;
+    /** Index of the node in HB consumer or -1, if node is not monitored */
+    int8_t HBidx;
+#endif
+    /** Size of data */
+    uint8_t dataSize;
+    /** Data in little-endian format, as transferred by SDO */
+    uint8_t data[CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE];
+} CO_SDOclientCache_entry_t;
+
+
+/**
+ * SDO client cache object.
+ */
+typedef struct {
+    /** From CO_SDOclientCache_init() */
+    const CO_SDOclientCache_policy_t *policies;
+    /** From CO_SDOclientCache_init() */
+    uint16_t policiesCount;
+    /** Cached values */
+    CO_SDOclientCache_entry_t entries[CO_CONFIG_SDO_CLI_CACHE_SIZE];
+    /** Time of the cache in milliseconds, incremented in
+     * CO_SDOclientCache_process() */
+    uint32_t time_ms;
+    /** Remainder of time in microseconds */
+    uint32_t time_us;
+    /** Number of lookups answered from the cache, for statistics */
+    uint32_t hits;
+    /** Number of lookups, which require SDO transfer */
+    uint32_t misses;
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE) || defined CO_DOXYGEN
+    /** From CO_SDOclientCache_initHBconsumer() or NULL */
+    CO_HBconsumer_t *HBcons;
+#endif
+} CO_SDOclientCache_t;
+
+
+/**
+ * Initialize SDO client cache object.
+ *
+ * @param cache This object will be initialized.
+ * @param policies Table of caching policies, must stay valid. Objects not
+ * listed in the table are not cached.
+ * @param policiesCount Number of policies in the table.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_SDOclientCache_init(
+        CO_SDOclientCache_t *cache,
+        const CO_SDOclientCache_policy_t *policies,
+        uint16_t policiesCount);
+
+
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE) || defined CO_DOXYGEN
+/**
+ * Connect SDO client cache with heartbeat consumer.
+ *
+ * Cached value of the monitored node is then not used by
+ * CO_SDOclientCache_lookup(), if CO_HBconsNode_t.resetCount of the node has
+ * changed since the value was stored: heartbeat timeout, boot-up message or
+ * restart of monitoring.
+ *
+ * @param cache This object.
+ * @param HBcons Heartbeat consumer object, may be NULL.
+ */
+void CO_SDOclientCache_initHBconsumer(CO_SDOclientCache_t *cache,
+                                      CO_HBconsumer_t *HBcons);
+#endif
+
+
+/**
+ * Get value from the cache.
+ *
+ * @param cache This object.
+ * @param nodeId Node-ID of the SDO server.
+ * @param index Index of the object.
+ * @param subIndex Subindex of the object.
+ * @param [out] buf Buffer for data.
+ * @param bufSize Size of the buffer.
+ * @param [out] dataSize Size of data copied into buf.
+ *
+ * @return true, if valid value was found and copied into buf. False, if SDO
+ * upload is necessary.
+ */
+bool_t CO_SDOclientCache_lookup(CO_SDOclientCache_t *cache,
+                                uint8_t nodeId,
+                                uint16_t index,
+                                uint8_t subIndex,
+                                uint8_t *buf,
+                                size_t bufSize,
+                                size_t *dataSize);
+
+
+/**
+ * Store uploaded value into the cache.
+ *
+ * Value is stored only, if object matches any caching policy and data fit
+ * into the entry.
+ *
+ * @param cache This object.
+ * @param nodeId Node-ID of the SDO server.
+ * @param index Index of the object.
+ * @param subIndex Subindex of the object.
+ * @param data Uploaded data.
+ * @param dataSize Size of data.
+ */
+void CO_SDOclientCache_store(CO_SDOclientCache_t *cache,
+                             uint8_t nodeId,
+                             uint16_t index,
+                             uint8_t subIndex,
+                             const uint8_t *data,
+                             size_t dataSize);
+
+
+/**
+ * Remove all cached values of the node.
+ *
+ * Function must be called, if application writes to the cached object.
+ *
+ * @param cache This object.
+ * @param nodeId Node-ID of the SDO server or 0 for all nodes.
+ */
+void CO_SDOclientCache_invalidate(CO_SDOclientCache_t *cache, uint8_t nodeId);
+
+
+/**
+ * Process SDO client cache.
+ *
+ * Function must be called cyclically, from the same thread and after the
+ * CO_process(). It increments time of the cache.
+ *
+ * @param cache This object.
+ * @param timeDifference_us Time difference from previous function call in
+ * [microseconds].
+ */
+void CO_SDOclientCache_process(CO_SDOclientCache_t *cache,
+                               uint32_t timeDifference_us);
+
+/** @} */ /* CO_SDOclientCache */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE */
+
+#endif /* CO_SDO_CLIENT_CACHE_H */
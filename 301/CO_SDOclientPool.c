@@ -0,0 +1,264 @@
+/*
+ * Pool of CANopen SDO clients, which process queued SDO jobs.
+ *
+ * @file        CO_SDOclientPool.c
+ * @ingroup     CO_SDOclientPool
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "301/CO_SDOclientPool.h"
+
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE) \
+    && ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_POOL)
+
+/* Finish the active job on SDO client i and inform application */
+static void jobFinish(CO_SDOclientPool_t *pool, uint8_t i,
+                      CO_SDO_return_t result,
+                      CO_SDO_abortCode_t abortCode,
+                      size_t sizeTransferred)
+{
+    CO_SDOclientJob_t *job = pool->active[i];
+
+    CO_SDOclientClose(&pool->SDOclients[i]);
+    pool->active[i] = NULL;
+
+    job->result = result;
+    job->abortCode = abortCode;
+    job->sizeTransferred = sizeTransferred;
+    job->next = NULL;
+    if (job->functCompleted != NULL) {
+        job->functCompleted(job->object, job);
+    }
+}
+
+
+/* Start the job on free SDO client i */
+static void jobStart(CO_SDOclientPool_t *pool, uint8_t i,
+                     CO_SDOclientJob_t *job)
+{
+    CO_SDOclient_t *SDO_C = &pool->SDOclients[i];
+    CO_SDO_return_t ret;
+
+    pool->active[i] = job;
+    job->bufOffset = 0;
+
+    ret = CO_SDOclient_setup(SDO_C,
+                             CO_CAN_ID_SDO_CLI + job->nodeId,
+                             CO_CAN_ID_SDO_SRV + job->nodeId,
+                             job->nodeId);
+    if (ret == CO_SDO_RT_ok_communicationEnd) {
+        ret = job->upload
+            ? CO_SDOclientUploadInitiate(SDO_C, job->index, job->subIndex,
+                                         pool->SDOtimeoutTime_ms,
+                                         pool->blockEnable)
+            : CO_SDOclientDownloadInitiate(SDO_C, job->index, job->subIndex,
+                                           job->dataSize,
+                                           pool->SDOtimeoutTime_ms,
+                                           pool->blockEnable);
+    }
+    if (ret != CO_SDO_RT_ok_communicationEnd) {
+        jobFinish(pool, i, ret, CO_SDO_AB_GENERAL, 0);
+    }
+}
+
+
+/* Process the active job on SDO client i */
+static void jobProcess(CO_SDOclientPool_t *pool, uint8_t i,
+                       uint32_t timeDifference_us,
+                       uint32_t *timerNext_us)
+{
+    CO_SDOclient_t *SDO_C = &pool->SDOclients[i];
+    CO_SDOclientJob_t *job = pool->active[i];
+    CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+    size_t sizeTransferred = 0;
+    CO_SDO_return_t ret;
+
+    if (job->upload) {
+        /* abort, if data do not fit into application buffer */
+        bool_t abort = job->bufOffset >= job->dataSize
+                       && CO_fifo_getOccupied(&SDO_C->bufFifo) > 0;
+        if (abort) {
+            abortCode = CO_SDO_AB_OUT_OF_MEM;
+        }
+
+        ret = CO_SDOclientUpload(SDO_C, timeDifference_us, abort, &abortCode,
+                                 NULL, &sizeTransferred, timerNext_us);
+
+        if (ret != CO_SDO_RT_blockUploadInProgress) {
+            job->bufOffset += CO_SDOclientUploadBufRead(SDO_C,
+                                            job->data + job->bufOffset,
+                                            job->dataSize - job->bufOffset);
+        }
+        if (ret == CO_SDO_RT_ok_communicationEnd
+            && CO_fifo_getOccupied(&SDO_C->bufFifo) > 0
+        ) {
+            /* transfer finished, but data are larger than buffer */
+            ret = CO_SDO_RT_endedWithClientAbort;
+            abortCode = CO_SDO_AB_OUT_OF_MEM;
+        }
+    }
+    else {
+        if (job->bufOffset < job->dataSize) {
+            job->bufOffset += CO_SDOclientDownloadBufWrite(SDO_C,
+                                            job->data + job->bufOffset,
+                                            job->dataSize - job->bufOffset);
+        }
+
+        ret = CO_SDOclientDownload(SDO_C, timeDifference_us, false,
+                                   job->bufOffset < job->dataSize,
+                                   &abortCode, &sizeTransferred, timerNext_us);
+    }
+
+    if (ret <= CO_SDO_RT_ok_communicationEnd) {
+        jobFinish(pool, i, ret, abortCode, sizeTransferred);
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_SDOclientPool_init(CO_SDOclientPool_t *pool,
+                                       CO_SDOclient_t *SDOclients,
+                                       uint8_t count,
+                                       uint16_t SDOtimeoutTime_ms,
+                                       bool_t blockEnable)
+{
+    if (pool == NULL || SDOclients == NULL || count == 0) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(pool, 0, sizeof(CO_SDOclientPool_t));
+    pool->SDOclients = SDOclients;
+    pool->count = count < CO_CONFIG_SDO_CLI_POOL_SIZE
+                ? count : CO_CONFIG_SDO_CLI_POOL_SIZE;
+    pool->SDOtimeoutTime_ms = SDOtimeoutTime_ms;
+    pool->blockEnable = blockEnable;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_SDOclientPool_add(CO_SDOclientPool_t *pool,
+                                      CO_SDOclientJob_t *job)
+{
+    if (pool == NULL || job == NULL || job->nodeId < 1 || job->nodeId > 127
+        || (job->data == NULL && job->dataSize > 0)
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    job->result = CO_SDO_RT_waitingResponse;
+    job->abortCode = CO_SDO_AB_NONE;
+    job->sizeTransferred = 0;
+    job->bufOffset = 0;
+    job->next = NULL;
+
+    if (pool->queueHead == NULL) {
+        pool->queueHead = job;
+    }
+    else {
+        pool->queueTail->next = job;
+    }
+    pool->queueTail = job;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+bool_t CO_SDOclientPool_process(CO_SDOclientPool_t *pool,
+                                uint32_t timeDifference_us,
+                                uint32_t *timerNext_us)
+{
+    uint8_t i;
+    bool_t busy = false;
+
+    if (pool == NULL) {
+        return false;
+    }
+
+    /* process active transfers */
+    for (i = 0; i < pool->count; i++) {
+        if (pool->active[i] != NULL) {
+            jobProcess(pool, i, timeDifference_us, timerNext_us);
+        }
+    }
+
+    /* assign waiting jobs to free SDO clients. Take the first job in the
+     * queue, whose SDO server is not busy with other job. */
+    for (i = 0; i < pool->count && pool->queueHead != NULL; i++) {
+        CO_SDOclientJob_t *job, *prev = NULL;
+
+        if (pool->active[i] != NULL) {
+            continue;
+        }
+
+        for (job = pool->queueHead; job != NULL; prev = job, job = job->next) {
+            uint8_t j;
+            for (j = 0; j < pool->count; j++) {
+                if (pool->active[j] != NULL
+                    && pool->active[j]->nodeId == job->nodeId
+                ) {
+                    break;
+                }
+            }
+            if (j == pool->count) {
+                break;
+            }
+        }
+        if (job == NULL) {
+            /* all waiting jobs are for busy SDO servers */
+            break;
+        }
+
+        /* remove job from the queue */
+        if (prev == NULL) {
+            pool->queueHead = job->next;
+        }
+        else {
+            prev->next = job->next;
+        }
+        if (pool->queueTail == job) {
+            pool->queueTail = prev;
+        }
+        job->next = NULL;
+
+        jobStart(pool, i, job);
+        if (pool->active[i] != NULL) {
+            /* send initiate request without delay */
+            jobProcess(pool, i, 0, timerNext_us);
+        }
+    }
+
+    for (i = 0; i < pool->count; i++) {
+        if (pool->active[i] != NULL) {
+            busy = true;
+        }
+    }
+    if (pool->queueHead != NULL) {
+        busy = true;
+    }
+
+    return busy;
+}
+
+#endif /* (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_POOL */
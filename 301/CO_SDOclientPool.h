@@ -0,0 +1,205 @@
+/**
+ * Pool of CANopen SDO clients, which process queued SDO jobs.
+ *
+ * @file        CO_SDOclientPool.h
+ * @ingroup     CO_SDOclientPool
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_SDO_CLIENT_POOL_H
+#define CO_SDO_CLIENT_POOL_H
+
+#include "301/CO_SDOclient.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_SDO_CLI_POOL_SIZE
+#define CO_CONFIG_SDO_CLI_POOL_SIZE 8
+#endif
+
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_POOL) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_SDOclientPool SDO client pool
+ * Pool of SDO clients, which process queued SDO jobs in parallel.
+ *
+ * @ingroup CO_SDOclient
+ * @{
+ * Application prepares @ref CO_SDOclientJob_t objects, each with node-ID of
+ * the SDO server, index, subindex and data buffer, and adds them to the queue
+ * with @ref CO_SDOclientPool_add(). @ref CO_SDOclientPool_process() must be
+ * called cyclically. It assigns queued jobs to free SDO clients and processes
+ * all active transfers in parallel. Only one job per SDO server is active at a
+ * time, jobs for the same server are processed in the order of adding. At the
+ * end of each job functCompleted callback is called.
+ *
+ * SDO clients used by the pool must not be used elsewhere. They are configured
+ * for each job with @ref CO_SDOclient_setup() and default SDO CAN identifiers
+ * (0x600 + nodeId and 0x580 + nodeId).
+ *
+ * Example for writing the same parameter into many nodes:
+ * @code{.c}
+static CO_SDOclientPool_t pool;
+static CO_SDOclientJob_t jobs[100];
+static uint32_t value = 1000;
+
+CO_SDOclientPool_init(&pool, co->SDOclient, OD_CNT_SDO_CLI, 500, true);
+for (int i = 0; i < 100; i++) {
+    jobs[i].nodeId = i + 1;
+    jobs[i].index = 0x2000;
+    jobs[i].subIndex = 0;
+    jobs[i].upload = false;
+    jobs[i].data = (uint8_t *)&value;
+    jobs[i].dataSize = sizeof(value);
+    jobs[i].functCompleted = jobCompleted;
+    jobs[i].object = NULL;
+    CO_SDOclientPool_add(&pool, &jobs[i]);
+}
+ * @endcode
+ * Then call CO_SDOclientPool_process() from the same thread as CO_process().
+ */
+
+
+/**
+ * SDO job, processed by SDO client pool.
+ *
+ * Object is owned by the application and must stay valid until the
+ * functCompleted callback is called. Fields from nodeId to object must be set
+ * by the application before @ref CO_SDOclientPool_add().
+ */
+typedef struct CO_SDOclientJob {
+    /** Node-ID of the SDO server, 1..127 */
+    uint8_t nodeId;
+    /** Index of object in Object Dictionary of the SDO server */
+    uint16_t index;
+    /** Subindex of object in Object Dictionary of the SDO server */
+    uint8_t subIndex;
+    /** If true, data are read from the server (upload), otherwise written */
+    bool_t upload;
+    /** Data buffer: source of data for download, destination for upload. Data
+     * are in little-endian format, as transferred by SDO. */
+    uint8_t *data;
+    /** Size of data for download or size of data buffer for upload */
+    size_t dataSize;
+    /** Callback, called from CO_SDOclientPool_process() after job is finished,
+     * may be NULL. Object may be reused or added again inside callback. */
+    void (*functCompleted)(void *object, struct CO_SDOclientJob *job);
+    /** Pointer to object passed to functCompleted */
+    void *object;
+    /** Result of the job, valid inside functCompleted: CO_SDO_RT_ok_
+     * communicationEnd on success, negative value on error. */
+    CO_SDO_return_t result;
+    /** SDO abort code, valid inside functCompleted */
+    CO_SDO_abortCode_t abortCode;
+    /** Number of bytes transferred, valid inside functCompleted */
+    size_t sizeTransferred;
+    /** Internal, number of bytes copied to or from the SDO client buffer */
+    size_t bufOffset;
+    /** Internal, next job in the queue */
+    struct CO_SDOclientJob *next;
+} CO_SDOclientJob_t;
+
+
+/**
+ * SDO client pool object.
+ */
+typedef struct {
+    /** From CO_SDOclientPool_init() */
+    CO_SDOclient_t *SDOclients;
+    /** Number of SDO clients used, up to @ref CO_CONFIG_SDO_CLI_POOL_SIZE */
+    uint8_t count;
+    /** From CO_SDOclientPool_init() */
+    uint16_t SDOtimeoutTime_ms;
+    /** From CO_SDOclientPool_init() */
+    bool_t blockEnable;
+    /** Active job for each SDO client, NULL if client is free */
+    CO_SDOclientJob_t *active[CO_CONFIG_SDO_CLI_POOL_SIZE];
+    /** First job in the queue of waiting jobs */
+    CO_SDOclientJob_t *queueHead;
+    /** Last job in the queue of waiting jobs */
+    CO_SDOclientJob_t *queueTail;
+} CO_SDOclientPool_t;
+
+
+/**
+ * Initialize SDO client pool object.
+ *
+ * @param pool This object will be initialized.
+ * @param SDOclients Array of SDO client objects, initialized by
+ * @ref CO_SDOclient_init().
+ * @param count Number of SDO clients in array. If larger than
+ * @ref CO_CONFIG_SDO_CLI_POOL_SIZE, only that many are used.
+ * @param SDOtimeoutTime_ms Timeout time for SDO communication of each job.
+ * @param blockEnable Try to use block transfer.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_SDOclientPool_init(CO_SDOclientPool_t *pool,
+                                       CO_SDOclient_t *SDOclients,
+                                       uint8_t count,
+                                       uint16_t SDOtimeoutTime_ms,
+                                       bool_t blockEnable);
+
+
+/**
+ * Add SDO job to the end of the queue.
+ *
+ * Must be called from the same thread as CO_SDOclientPool_process() or from
+ * the functCompleted callback.
+ *
+ * @param pool This object.
+ * @param job SDO job, prepared by application.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_SDOclientPool_add(CO_SDOclientPool_t *pool,
+                                      CO_SDOclientJob_t *job);
+
+
+/**
+ * Process SDO client pool.
+ *
+ * Function must be called cyclically. It assigns waiting jobs to free SDO
+ * clients, processes active transfers and calls functCompleted for finished
+ * jobs. Function is non-blocking.
+ *
+ * @param pool This object.
+ * @param timeDifference_us Time difference from previous function call in
+ * [microseconds].
+ * @param [out] timerNext_us info to OS - see CO_process(). Ignored if NULL.
+ *
+ * @return true, if there are active or waiting jobs.
+ */
+bool_t CO_SDOclientPool_process(CO_SDOclientPool_t *pool,
+                                uint32_t timeDifference_us,
+                                uint32_t *timerNext_us);
+
+/** @} */ /* CO_SDOclientPool */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_POOL */
+
+#endif /* CO_SDO_CLIENT_POOL_H */
@@ -41,10 +41,35 @@
  #if !((CO_CONFIG_CRC16) & CO_CONFIG_CRC16_ENABLE)
   #error CO_CONFIG_CRC16_ENABLE must be enabled.
  #endif
- #if CO_CONFIG_SDO_SRV_BUFFER_SIZE < 900
+ #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+  #if CO_CONFIG_SDO_SRV_POOL_BUFFER_SIZE < 900
+   #error CO_CONFIG_SDO_SRV_POOL_BUFFER_SIZE must be greater or equal than 900.
+  #endif
+ #elif CO_CONFIG_SDO_SRV_BUFFER_SIZE < 900
   #error CO_CONFIG_SDO_SRV_BUFFER_SIZE must be greater or equal than 900.
  #endif
 #endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING
+ #if !((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED)
+  #error CO_CONFIG_SDO_SRV_SEGMENTED must be enabled.
+ #endif
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+ #if !((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED)
+  #error CO_CONFIG_SDO_SRV_SEGMENTED must be enabled.
+ #endif
+ #if CO_CONFIG_SDO_SRV_POOL_BUFFER_SIZE < 20
+  #error CO_CONFIG_SDO_SRV_POOL_BUFFER_SIZE must be greater or equal than 20.
+ #endif
+ #if CO_CONFIG_SDO_SRV_POOL_COUNT < 1 || CO_CONFIG_SDO_SRV_POOL_COUNT > 8
+  #error CO_CONFIG_SDO_SRV_POOL_COUNT must be from 1 to 8.
+ #endif
+ /* Size of the interim data buffer for current transfer */
+ #define CO_SDO_BUF_SIZE(SDO) ((SDO)->bufSize)
+ #define CO_SDO_BUF_POOL_NONE 0xFF
+#else
+ #define CO_SDO_BUF_SIZE(SDO) CO_CONFIG_SDO_SRV_BUFFER_SIZE
+#endif
 
 /*
  * Read received message from CAN module.
@@ -63,6 +88,10 @@ static void CO_SDO_receive(void *object, void *msg) {
         if (data[0] == 0x80) {
             /* abort from client, just make idle */
             SDO->state = CO_SDO_ST_IDLE;
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING
+            /* drop message, which may be kept by pending OD access */
+            CO_FLAG_CLEAR(SDO->CANrxNew);
+#endif
         }
         else if (CO_FLAG_READ(SDO->CANrxNew)) {
             /* ignore message if previous message was not processed yet */
@@ -74,7 +103,7 @@ static void CO_SDO_receive(void *object, void *msg) {
         }
         else if (SDO->state == CO_SDO_ST_DOWNLOAD_BLK_SUBBLOCK_REQ) {
             /* just in case, condition should always pass */
-            if (SDO->bufOffsetWr <= (CO_CONFIG_SDO_SRV_BUFFER_SIZE - (7+2))) {
+            if (SDO->bufOffsetWr <= (CO_SDO_BUF_SIZE(SDO) - (7+2))) {
                 /* block download, copy data directly */
                 CO_SDO_state_t state = CO_SDO_ST_DOWNLOAD_BLK_SUBBLOCK_REQ;
                 uint8_t seqno = data[0] & 0x7F;
@@ -334,10 +363,19 @@ CO_ReturnError_t CO_SDOserver_init(CO_SDOserver_t *SDO,
 #if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED)
     SDO->SDOtimeoutTime_us = (uint32_t)SDOtimeoutTime_ms * 1000;
 #endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING
+    SDO->odPending = false;
+#endif
 #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK
     SDO->block_SDOtimeoutTime_us = (uint32_t)SDOtimeoutTime_ms * 700;
 #endif
     SDO->state = CO_SDO_ST_IDLE;
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    SDO->buf = SDO->bufOwn;
+    SDO->bufSize = CO_CONFIG_SDO_SRV_BUFFER_SIZE;
+    SDO->bufPool = NULL;
+    SDO->bufPoolIdx = CO_SDO_BUF_POOL_NONE;
+#endif
 
 #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_FLAG_CALLBACK_PRE
     SDO->pFunctSignalPre = NULL;
@@ -448,6 +486,84 @@ void CO_SDOserver_initCallbackPre(CO_SDOserver_t *SDO,
 #endif
 
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+/******************************************************************************/
+void CO_SDOserver_bufferPoolInit(CO_SDOserver_bufferPool_t *bufPool) {
+    if (bufPool != NULL) {
+        bufPool->used = 0;
+    }
+}
+
+
+/******************************************************************************/
+void CO_SDOserver_initBufferPool(CO_SDOserver_t *SDO,
+                                 CO_SDOserver_bufferPool_t *bufPool)
+{
+    if (SDO != NULL) {
+        SDO->bufPool = bufPool;
+    }
+}
+
+
+/** Borrow buffer from the pool for new segmented or block transfer, if OD
+ * variable does not fit into own buffer. If pool is empty, own buffer is used,
+ * except for block upload, which requires large buffer.
+ *
+ * @param SDO SDO server
+ * @param [out] abortCode SDO abort code in case of error
+ *
+ * @return true if transfer may continue, false on error. */
+static bool_t bufBorrow(CO_SDOserver_t *SDO, CO_SDO_abortCode_t *abortCode) {
+    OD_size_t sizeInOd = SDO->OD_IO.stream.dataLength;
+    uint8_t i;
+
+    if (SDO->bufPoolIdx != CO_SDO_BUF_POOL_NONE
+        || (sizeInOd > 0 && sizeInOd <= CO_CONFIG_SDO_SRV_BUFFER_SIZE
+            && (SDO->OD_IO.stream.attribute & ODA_STR) == 0)
+    ) {
+        return true;
+    }
+
+    if (SDO->bufPool != NULL) {
+        for (i = 0; i < CO_CONFIG_SDO_SRV_POOL_COUNT; i++) {
+            uint8_t mask = (uint8_t)(1U << i);
+            if ((SDO->bufPool->used & mask) == 0) {
+                SDO->bufPool->used |= mask;
+                SDO->bufPoolIdx = i;
+                SDO->buf = &SDO->bufPool->buf[i][0];
+                SDO->bufSize = CO_CONFIG_SDO_SRV_POOL_BUFFER_SIZE;
+                return true;
+            }
+        }
+    }
+
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK) \
+    && CO_CONFIG_SDO_SRV_BUFFER_SIZE < 900
+    if (SDO->state == CO_SDO_ST_UPLOAD_BLK_INITIATE_REQ) {
+        *abortCode = CO_SDO_AB_OUT_OF_MEM;
+        SDO->state = CO_SDO_ST_ABORT;
+        return false;
+    }
+#endif
+    (void)abortCode;
+    return true;
+}
+
+
+/** Return buffer to the pool, if borrowed, and use own buffer.
+ *
+ * @param SDO SDO server */
+static inline void bufRelease(CO_SDOserver_t *SDO) {
+    if (SDO->bufPoolIdx != CO_SDO_BUF_POOL_NONE) {
+        SDO->bufPool->used &= (uint8_t)~(1U << SDO->bufPoolIdx);
+        SDO->bufPoolIdx = CO_SDO_BUF_POOL_NONE;
+        SDO->buf = SDO->bufOwn;
+        SDO->bufSize = CO_CONFIG_SDO_SRV_BUFFER_SIZE;
+    }
+}
+#endif
+
+
 #ifdef CO_BIG_ENDIAN
 static inline void reverseBytes(void *start, OD_size_t size) {
     uint8_t *lo = (uint8_t *)start;
@@ -472,7 +588,8 @@ static inline void reverseBytes(void *start, OD_size_t size) {
  * @parma crcClient crc checksum to campare with
  *
  * Returns true on success, otherwise write also abortCode and sets state to
- * CO_SDO_ST_ABORT */
+ * CO_SDO_ST_ABORT. If OD write returns ODR_PENDING, function returns false,
+ * sets SDO->odPending and keeps data and state for the next call. */
 static bool_t validateAndWriteToOD(CO_SDOserver_t *SDO,
                                    CO_SDO_abortCode_t *abortCode,
                                    uint8_t crcOperation,
@@ -480,6 +597,13 @@ static bool_t validateAndWriteToOD(CO_SDOserver_t *SDO,
 {
     OD_size_t bufOffsetWrOrig = SDO->bufOffsetWr;
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING
+    if (SDO->odPending) {
+        /* data were already verified and prepared, repeat writing */
+        crcOperation = 0;
+    }
+    else
+#endif
     if (SDO->finished) {
         /* Verify if size of data downloaded matches size indicated. */
         if (SDO->sizeInd > 0 && SDO->sizeTran != SDO->sizeInd) {
@@ -504,7 +628,7 @@ static bool_t validateAndWriteToOD(CO_SDOserver_t *SDO,
          * (temporary, send information about EOF into OD_IO.write) */
         if ((SDO->OD_IO.stream.attribute & ODA_STR) != 0
             && (sizeInOd == 0 || SDO->sizeTran < sizeInOd)
-            && (SDO->bufOffsetWr + 2) <= CO_CONFIG_SDO_SRV_BUFFER_SIZE
+            && (SDO->bufOffsetWr + 2) <= CO_SDO_BUF_SIZE(SDO)
         ) {
             SDO->buf[SDO->bufOffsetWr++] = 0;
             SDO->sizeTran++;
@@ -552,11 +676,17 @@ static bool_t validateAndWriteToOD(CO_SDOserver_t *SDO,
     /* write data */
     OD_size_t countWritten = 0;
 
-    CO_LOCK_OD(SDO->CANdevTx);
+    CO_LOCK_OD_GROUP(SDO->CANdevTx, SDO->ODlockGroup);
     ODR_t odRet = SDO->OD_IO.write(&SDO->OD_IO.stream, SDO->buf,
                                    SDO->bufOffsetWr, &countWritten);
-    CO_UNLOCK_OD(SDO->CANdevTx);
+    CO_UNLOCK_OD_GROUP(SDO->CANdevTx, SDO->ODlockGroup);
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING
+    SDO->odPending = odRet == ODR_PENDING;
+    if (SDO->odPending) {
+        return false;
+    }
+#endif
     SDO->bufOffsetWr = 0;
 
     /* verify write error value */
@@ -592,7 +722,8 @@ static bool_t validateAndWriteToOD(CO_SDOserver_t *SDO,
  * @param calculateCrc if true, crc is calculated
  *
  * Returns true on success, otherwise write also abortCode and sets state to
- * CO_SDO_ST_ABORT */
+ * CO_SDO_ST_ABORT. If OD read returns ODR_PENDING, function returns false,
+ * sets SDO->odPending and keeps state for the next call. */
 static bool_t readFromOd(CO_SDOserver_t *SDO,
                          CO_SDO_abortCode_t *abortCode,
                          OD_size_t countMinimum,
@@ -607,16 +738,23 @@ static bool_t readFromOd(CO_SDOserver_t *SDO,
         SDO->bufOffsetWr = countRemain;
 
         /* Get size of free data buffer */
-        OD_size_t countRdRequest = CO_CONFIG_SDO_SRV_BUFFER_SIZE - countRemain;
+        OD_size_t countRdRequest = CO_SDO_BUF_SIZE(SDO) - countRemain;
 
         /* load data from OD variable into the buffer */
         OD_size_t countRd = 0;
         uint8_t *bufShifted = SDO->buf + countRemain;
 
-        CO_LOCK_OD(SDO->CANdevTx);
+        CO_LOCK_OD_GROUP(SDO->CANdevTx, SDO->ODlockGroup);
         ODR_t odRet = SDO->OD_IO.read(&SDO->OD_IO.stream, bufShifted,
                                       countRdRequest, &countRd);
-        CO_UNLOCK_OD(SDO->CANdevTx);
+        CO_UNLOCK_OD_GROUP(SDO->CANdevTx, SDO->ODlockGroup);
+
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING
+        SDO->odPending = odRet == ODR_PENDING;
+        if (SDO->odPending) {
+            return false;
+        }
+#endif
 
         if (odRet != ODR_OK && odRet != ODR_PARTIAL) {
             *abortCode = (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
@@ -676,7 +814,95 @@ static bool_t readFromOd(CO_SDOserver_t *SDO,
     }
     return true;
 }
+
+
+/** Helper function for reading the first data from Object dictionary on upload
+ * initiate. It also determines data size, which is indicated to the client.
+ *
+ * @param SDO SDO server
+ * @param [out] abortCode SDO abort code in case of error
+ *
+ * Returns true on success, same as readFromOd() otherwise. */
+static bool_t readFromOdInitiate(CO_SDOserver_t *SDO,
+                                 CO_SDO_abortCode_t *abortCode)
+{
+    if (!readFromOd(SDO, abortCode, 7, false)) {
+        return false;
+    }
+
+    /* Size of variable in OD (may not be known yet) */
+    if (SDO->finished) {
+        /* OD variable was completely read, its size is known */
+
+        SDO->sizeInd = SDO->OD_IO.stream.dataLength;
+
+        if (SDO->sizeInd == 0) {
+            SDO->sizeInd = SDO->bufOffsetWr;
+        }
+        else if (SDO->sizeInd != SDO->bufOffsetWr) {
+            *abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+            SDO->state = CO_SDO_ST_ABORT;
+            return false;
+        }
+    }
+    else {
+        /* If data type is string, size is not known */
+        SDO->sizeInd = (SDO->OD_IO.stream.attribute & ODA_STR) == 0
+                     ? SDO->OD_IO.stream.dataLength
+                     : 0;
+    }
+    return true;
+}
+
+
+#if OD_EXTENSION_VIEW
+/** Helper function for getting contiguous read-only view of OD variable from
+ * its extension, see OD_extension_t. If view is available, SDO->view is set,
+ * data size is indicated and reading from OD is finished.
+ *
+ * @param SDO SDO server
+ * @param entry OD entry of the current object
+ *
+ * Returns true, if view is used */
+static bool_t viewFromOd(CO_SDOserver_t *SDO, const OD_entry_t *entry) {
+    const uint8_t *data = NULL;
+    OD_size_t length = 0;
+    ODR_t odRet = ODR_DEV_INCOMPAT;
+
+    SDO->view = NULL;
+    if (entry->extension == NULL || entry->extension->view == NULL) {
+        return false;
+    }
+
+    CO_LOCK_OD_GROUP(SDO->CANdevTx, SDO->ODlockGroup);
+    odRet = entry->extension->view(&SDO->OD_IO.stream, &data, &length);
+    CO_UNLOCK_OD_GROUP(SDO->CANdevTx, SDO->ODlockGroup);
+
+    if (odRet != ODR_OK || data == NULL || length == 0) {
+        return false;
+    }
+
+    if (length <= 4) {
+        /* expedited transfer is sent from the buffer */
+        memcpy(SDO->buf, data, length);
+    }
+    else {
+        SDO->view = data;
+    }
+    SDO->bufOffsetWr = length;
+    SDO->sizeInd = length;
+    SDO->finished = true;
+    return true;
+}
+#endif /* OD_EXTENSION_VIEW */
+
+/* Source of upload data, SDO->buf or view of OD variable */
+#if OD_EXTENSION_VIEW
+#define UPLOAD_DATA(SDO) ((SDO)->view != NULL ? (SDO)->view : (SDO)->buf)
+#else
+#define UPLOAD_DATA(SDO) ((SDO)->buf)
 #endif
+#endif /* (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED */
 
 
 /******************************************************************************/
@@ -712,6 +938,12 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
         if (SDO->state == CO_SDO_ST_IDLE) { /* new SDO communication? */
             bool_t upload = false;
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING
+            /* Previous transfer may be aborted by the client from receive
+             * callback, while OD access was pending. Its pending state must
+             * not leak into the new transfer. */
+            SDO->odPending = false;
+#endif
             if ((SDO->CANrxData[0] & 0xF0) == 0x20) {
                 SDO->state = CO_SDO_ST_DOWNLOAD_INITIATE_REQ;
             }
@@ -734,13 +966,15 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             }
 
             /* if no error search object dictionary for new SDO request */
+            OD_entry_t *entry = NULL;
             if (abortCode == CO_SDO_AB_NONE) {
                 ODR_t odRet;
                 SDO->index = ((uint16_t)SDO->CANrxData[2]) << 8
                              | SDO->CANrxData[1];
                 SDO->subIndex = SDO->CANrxData[3];
-                odRet = OD_getSub(OD_find(SDO->OD, SDO->index), SDO->subIndex,
-                                  &SDO->OD_IO, false);
+                entry = OD_find(SDO->OD, SDO->index);
+                odRet = OD_getSub(entry, SDO->subIndex, &SDO->OD_IO, false);
+                SDO->ODlockGroup = OD_lockGroup(SDO->index, &SDO->OD_IO.stream);
                 if (odRet != ODR_OK) {
                     abortCode = (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
                     SDO->state = CO_SDO_ST_ABORT;
@@ -766,6 +1000,16 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                 }
             }
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+            /* segmented or block download needs interim buffer */
+            if (!upload && abortCode == CO_SDO_AB_NONE
+                && (SDO->state != CO_SDO_ST_DOWNLOAD_INITIATE_REQ
+                    || (SDO->CANrxData[0] & 0x02) == 0)
+            ) {
+                bufBorrow(SDO, &abortCode);
+            }
+#endif
+
 #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED
             /* load data from object dictionary, if upload and no error */
             if (upload && abortCode == CO_SDO_AB_NONE) {
@@ -773,27 +1017,20 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                 SDO->sizeTran = 0;
                 SDO->finished = false;
 
-                if (readFromOd(SDO, &abortCode, 7, false)) {
-                    /* Size of variable in OD (may not be known yet) */
-                    if (SDO->finished) {
-                        /* OD variable was completely read, its size is known */
-
-                        SDO->sizeInd = SDO->OD_IO.stream.dataLength;
-
-                        if (SDO->sizeInd == 0) {
-                            SDO->sizeInd = SDO->bufOffsetWr;
-                        }
-                        else if (SDO->sizeInd != SDO->bufOffsetWr) {
-                            abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
-                            SDO->state = CO_SDO_ST_ABORT;
-                        }
-                    }
-                    else {
-                        /* If data type is string, size is not known */
-                        SDO->sizeInd = (SDO->OD_IO.stream.attribute&ODA_STR)==0
-                                     ? SDO->OD_IO.stream.dataLength
-                                     : 0;
-                    }
+#if OD_EXTENSION_VIEW
+                if (viewFromOd(SDO, entry)) {
+                    /* data size is known, no need to read from OD */
+                }
+                else
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+                if (!bufBorrow(SDO, &abortCode)) {
+                    /* abort, no buffer for block upload */
+                }
+                else
+#endif
+                {
+                    readFromOdInitiate(SDO, &abortCode);
                 }
             }
 #endif /* (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED */
@@ -804,56 +1041,76 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
         case CO_SDO_ST_DOWNLOAD_INITIATE_REQ: {
             if (SDO->CANrxData[0] & 0x02) {
                 /* Expedited transfer, max 4 bytes of data */
-
-                /* Size of OD variable (>0 if indicated) */
-                OD_size_t sizeInOd = SDO->OD_IO.stream.dataLength;
+                uint8_t buf[6] = {0};
 
                 /* Get SDO data size (indicated by SDO client or get from OD) */
                 OD_size_t dataSizeToWrite = 4;
-                if (SDO->CANrxData[0] & 0x01)
-                    dataSizeToWrite -= (SDO->CANrxData[0] >> 2) & 0x03;
-                else if (sizeInOd > 0 && sizeInOd < 4)
-                    dataSizeToWrite = sizeInOd;
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING
+                if (SDO->odPending) {
+                    /* data were prepared in previous call, repeat writing */
+                    memcpy(buf, SDO->buf, sizeof(buf));
+                    dataSizeToWrite = SDO->bufOffsetWr;
+                }
+                else
+#endif
+                {
+                    /* Size of OD variable (>0 if indicated) */
+                    OD_size_t sizeInOd = SDO->OD_IO.stream.dataLength;
 
-                /* copy data to the temp buffer, swap data if necessary */
-                uint8_t buf[6] = {0};
-                memcpy(buf, &SDO->CANrxData[4], dataSizeToWrite);
+                    if (SDO->CANrxData[0] & 0x01)
+                        dataSizeToWrite -= (SDO->CANrxData[0] >> 2) & 0x03;
+                    else if (sizeInOd > 0 && sizeInOd < 4)
+                        dataSizeToWrite = sizeInOd;
+
+                    /* copy data to the temp buffer, swap data if necessary */
+                    memcpy(buf, &SDO->CANrxData[4], dataSizeToWrite);
 #ifdef CO_BIG_ENDIAN
-                if ((SDO->OD_IO.stream.attribute & ODA_MB) != 0) {
-                    reverseBytes(buf, dataSizeToWrite);
-                }
+                    if ((SDO->OD_IO.stream.attribute & ODA_MB) != 0) {
+                        reverseBytes(buf, dataSizeToWrite);
+                    }
 #endif
 
-                /* If dataType is string, then size of data downloaded may be
-                 * shorter as size of OD data buffer. If so, add two zero bytes
-                 * to terminate (unicode) string. Shorten also OD data size,
-                 * (temporary, send information about EOF into OD_IO.write) */
-                if ((SDO->OD_IO.stream.attribute & ODA_STR) != 0
-                    && (sizeInOd == 0 || dataSizeToWrite < sizeInOd)
-                ) {
-                    OD_size_t delta = sizeInOd - dataSizeToWrite;
-                    dataSizeToWrite += delta == 1 ? 1 : 2;
-                    SDO->OD_IO.stream.dataLength = dataSizeToWrite;
-                }
-                else if (sizeInOd == 0) {
-                    SDO->OD_IO.stream.dataLength = dataSizeToWrite;
-                }
-                /* Verify if size of data downloaded matches data size in OD. */
-                else if (dataSizeToWrite != sizeInOd) {
-                    abortCode = (dataSizeToWrite > sizeInOd) ?
-                                CO_SDO_AB_DATA_LONG : CO_SDO_AB_DATA_SHORT;
-                    SDO->state = CO_SDO_ST_ABORT;
-                    break;
+                    /* If dataType is string, then size of data downloaded may
+                     * be shorter as size of OD data buffer. If so, add two zero
+                     * bytes to terminate (unicode) string. Shorten also OD data
+                     * size, (temporary, send information about EOF into
+                     * OD_IO.write) */
+                    if ((SDO->OD_IO.stream.attribute & ODA_STR) != 0
+                        && (sizeInOd == 0 || dataSizeToWrite < sizeInOd)
+                    ) {
+                        OD_size_t delta = sizeInOd - dataSizeToWrite;
+                        dataSizeToWrite += delta == 1 ? 1 : 2;
+                        SDO->OD_IO.stream.dataLength = dataSizeToWrite;
+                    }
+                    else if (sizeInOd == 0) {
+                        SDO->OD_IO.stream.dataLength = dataSizeToWrite;
+                    }
+                    /* Verify if size of data downloaded matches size in OD */
+                    else if (dataSizeToWrite != sizeInOd) {
+                        abortCode = (dataSizeToWrite > sizeInOd) ?
+                                    CO_SDO_AB_DATA_LONG : CO_SDO_AB_DATA_SHORT;
+                        SDO->state = CO_SDO_ST_ABORT;
+                        break;
+                    }
                 }
 
                 /* Copy data */
                 OD_size_t countWritten = 0;
 
-                CO_LOCK_OD(SDO->CANdevTx);
+                CO_LOCK_OD_GROUP(SDO->CANdevTx, SDO->ODlockGroup);
                 ODR_t odRet = SDO->OD_IO.write(&SDO->OD_IO.stream, buf,
                                                dataSizeToWrite, &countWritten);
-                CO_UNLOCK_OD(SDO->CANdevTx);
-
+                CO_UNLOCK_OD_GROUP(SDO->CANdevTx, SDO->ODlockGroup);
+
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING
+                SDO->odPending = odRet == ODR_PENDING;
+                if (SDO->odPending) {
+                    /* keep prepared data for the next call */
+                    memcpy(SDO->buf, buf, sizeof(buf));
+                    SDO->bufOffsetWr = dataSizeToWrite;
+                    break;
+                }
+#endif
                 if (odRet != ODR_OK) {
                     abortCode = (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
                     SDO->state = CO_SDO_ST_ABORT;
@@ -909,34 +1166,43 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
 #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED
         case CO_SDO_ST_DOWNLOAD_SEGMENT_REQ: {
             if ((SDO->CANrxData[0] & 0xE0) == 0x00) {
-                SDO->finished = (SDO->CANrxData[0] & 0x01) != 0;
-
-                /* verify and alternate toggle bit */
-                uint8_t toggle = SDO->CANrxData[0] & 0x10;
-                if (toggle != SDO->toggle) {
-                    abortCode = CO_SDO_AB_TOGGLE_BIT;
-                    SDO->state = CO_SDO_ST_ABORT;
-                    break;
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING
+                if (SDO->odPending) {
+                    /* segment is already in the buffer, repeat writing */
                 }
+                else
+#endif
+                {
+                    SDO->finished = (SDO->CANrxData[0] & 0x01) != 0;
 
-                /* get data size and write data to the buffer */
-                OD_size_t count = 7 - ((SDO->CANrxData[0] >> 1) & 0x07);
-                memcpy(SDO->buf + SDO->bufOffsetWr, &SDO->CANrxData[1], count);
-                SDO->bufOffsetWr += count;
-                SDO->sizeTran += count;
+                    /* verify and alternate toggle bit */
+                    uint8_t toggle = SDO->CANrxData[0] & 0x10;
+                    if (toggle != SDO->toggle) {
+                        abortCode = CO_SDO_AB_TOGGLE_BIT;
+                        SDO->state = CO_SDO_ST_ABORT;
+                        break;
+                    }
 
-                /* if data size exceeds variable size, abort */
-                if (SDO->OD_IO.stream.dataLength > 0
-                    && SDO->sizeTran > SDO->OD_IO.stream.dataLength
-                ) {
-                    abortCode = CO_SDO_AB_DATA_LONG;
-                    SDO->state = CO_SDO_ST_ABORT;
-                    break;
+                    /* get data size and write data to the buffer */
+                    OD_size_t count = 7 - ((SDO->CANrxData[0] >> 1) & 0x07);
+                    memcpy(SDO->buf + SDO->bufOffsetWr,
+                           &SDO->CANrxData[1], count);
+                    SDO->bufOffsetWr += count;
+                    SDO->sizeTran += count;
+
+                    /* if data size exceeds variable size, abort */
+                    if (SDO->OD_IO.stream.dataLength > 0
+                        && SDO->sizeTran > SDO->OD_IO.stream.dataLength
+                    ) {
+                        abortCode = CO_SDO_AB_DATA_LONG;
+                        SDO->state = CO_SDO_ST_ABORT;
+                        break;
+                    }
                 }
 
                 /* if necessary, empty the buffer */
                 if (SDO->finished
-                    || (CO_CONFIG_SDO_SRV_BUFFER_SIZE - SDO->bufOffsetWr)<(7+2)
+                    || (CO_SDO_BUF_SIZE(SDO) - SDO->bufOffsetWr)<(7+2)
                 ) {
                     if (!validateAndWriteToOD(SDO, &abortCode, 0, 0))
                         break;
@@ -953,6 +1219,12 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
 #endif /* (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED */
 
         case CO_SDO_ST_UPLOAD_INITIATE_REQ: {
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING
+            /* repeat reading from OD, if it is pending */
+            if (SDO->odPending && !readFromOdInitiate(SDO, &abortCode)) {
+                break;
+            }
+#endif
             SDO->state = CO_SDO_ST_UPLOAD_INITIATE_RSP;
             break;
         }
@@ -1024,14 +1296,22 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                 /* Get number of data bytes in last segment, that do not
                     * contain data. Then reduce buffer. */
                 uint8_t noData = ((SDO->CANrxData[0] >> 2) & 0x07);
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING
+                if (SDO->odPending) {
+                    /* buffer was already reduced, repeat writing */
+                }
+                else
+#endif
                 if (SDO->bufOffsetWr <= noData) {
                     /* just in case, should never happen */
                     abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
                     SDO->state = CO_SDO_ST_ABORT;
                     break;
                 }
-                SDO->sizeTran -= noData;
-                SDO->bufOffsetWr -= noData;
+                else {
+                    SDO->sizeTran -= noData;
+                    SDO->bufOffsetWr -= noData;
+                }
 
                 uint16_t crcClient = 0;
                 if (SDO->block_crcEnabled) {
@@ -1052,6 +1332,12 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
         }
 
         case CO_SDO_ST_UPLOAD_BLK_INITIATE_REQ: {
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING
+            /* repeat reading from OD, if it is pending */
+            if (SDO->odPending && !readFromOdInitiate(SDO, &abortCode)) {
+                break;
+            }
+#endif
             /* if pst (protocol switch threshold, byte5) is larger than data
              * size of OD variable, then switch to segmented transfer */
             if (SDO->sizeInd > 0 && SDO->CANrxData[5] > 0
@@ -1063,7 +1349,8 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                 /* data were already loaded from OD variable, verify crc */
                 if ((SDO->CANrxData[0] & 0x04) != 0) {
                     SDO->block_crcEnabled = true;
-                    SDO->block_crc = crc16_ccitt(SDO->buf, SDO->bufOffsetWr, 0);
+                    SDO->block_crc = crc16_ccitt(UPLOAD_DATA(SDO),
+                                                  SDO->bufOffsetWr, 0);
                 }
                 else {
                     SDO->block_crcEnabled = false;
@@ -1103,34 +1390,42 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
         case CO_SDO_ST_UPLOAD_BLK_SUBBLOCK_SREQ:
         case CO_SDO_ST_UPLOAD_BLK_SUBBLOCK_CRSP: {
             if (SDO->CANrxData[0] == 0xA2) {
-                SDO->block_blksize = SDO->CANrxData[2];
-                if (SDO->block_blksize < 1 || SDO->block_blksize > 127) {
-                    abortCode = CO_SDO_AB_BLOCK_SIZE;
-                    SDO->state = CO_SDO_ST_ABORT;
-                    break;
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING
+                if (SDO->odPending) {
+                    /* buffer offsets were already updated, repeat reading */
                 }
+                else
+#endif
+                {
+                    SDO->block_blksize = SDO->CANrxData[2];
+                    if (SDO->block_blksize < 1 || SDO->block_blksize > 127) {
+                        abortCode = CO_SDO_AB_BLOCK_SIZE;
+                        SDO->state = CO_SDO_ST_ABORT;
+                        break;
+                    }
 
-                /* check number of segments */
-                if (SDO->CANrxData[1] < SDO->block_seqno) {
-                    /* NOT all segments transferred successfully.
-                     * Re-transmit data after erroneous segment. */
-                    OD_size_t cntFailed = SDO->block_seqno - SDO->CANrxData[1];
-                    cntFailed = cntFailed * 7 - SDO->block_noData;
-                    SDO->bufOffsetRd -= cntFailed;
-                    SDO->sizeTran -= cntFailed;
-                }
-                else if (SDO->CANrxData[1] > SDO->block_seqno) {
-                    /* something strange from server, break transmission */
-                    abortCode = CO_SDO_AB_CMD;
-                    SDO->state = CO_SDO_ST_ABORT;
-                    break;
+                    /* check number of segments */
+                    if (SDO->CANrxData[1] < SDO->block_seqno) {
+                        /* NOT all segments transferred successfully.
+                         * Re-transmit data after erroneous segment. */
+                        OD_size_t cntFailed = SDO->block_seqno
+                                              - SDO->CANrxData[1];
+                        cntFailed = cntFailed * 7 - SDO->block_noData;
+                        SDO->bufOffsetRd -= cntFailed;
+                        SDO->sizeTran -= cntFailed;
+                    }
+                    else if (SDO->CANrxData[1] > SDO->block_seqno) {
+                        /* something strange from server, break transmission */
+                        abortCode = CO_SDO_AB_CMD;
+                        SDO->state = CO_SDO_ST_ABORT;
+                        break;
+                    }
                 }
 
                 /* refill data buffer if necessary */
                 if (!readFromOd(SDO, &abortCode, SDO->block_blksize * 7, true))
                     break;
 
-
                 if (SDO->bufOffsetWr == SDO->bufOffsetRd) {
                     SDO->state = CO_SDO_ST_UPLOAD_BLK_END_SREQ;
                 }
@@ -1153,11 +1448,20 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             SDO->state = CO_SDO_ST_ABORT;
         }
         } /* switch (SDO->state) */
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING
+        if (SDO->odPending) {
+            /* keep the message, it will be processed again on next call,
+             * timeout timer is running */
+        }
+        else
+#endif
+        {
 #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_SEGMENTED
-        SDO->timeoutTimer = 0;
+            SDO->timeoutTimer = 0;
 #endif
-        timeDifference_us = 0;
-        CO_FLAG_CLEAR(SDO->CANrxNew);
+            timeDifference_us = 0;
+            CO_FLAG_CLEAR(SDO->CANrxNew);
+        }
     } /* if (isNew) */
 
     /* Timeout timers and transmit bufferFull flag ****************************/
@@ -1205,6 +1509,17 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
         }
 #endif /* (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK */
 
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING) \
+    && ((CO_CONFIG_SDO_SRV) & CO_CONFIG_FLAG_TIMERNEXT)
+        /* repeat pending OD access soon, not only after SDO timeout */
+        if (SDO->odPending && SDO->state != CO_SDO_ST_ABORT
+            && timerNext_us != NULL
+            && *timerNext_us > CO_CONFIG_SDO_SRV_PENDING_INTERVAL_US
+        ) {
+            *timerNext_us = CO_CONFIG_SDO_SRV_PENDING_INTERVAL_US;
+        }
+#endif
+
         if (SDO->CANtxBuff->bufferFull) {
             ret = CO_SDO_RT_transmittBufferFull;
         }
@@ -1272,7 +1587,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             if (SDO->sizeInd > 0 && SDO->sizeInd <= 4) {
                 /* expedited transfer */
                 SDO->CANtxBuff->data[0] = (uint8_t)(0x43|((4-SDO->sizeInd)<<2));
-                memcpy(&SDO->CANtxBuff->data[4], &SDO->buf, SDO->sizeInd);
+                memcpy(&SDO->CANtxBuff->data[4], SDO->buf, SDO->sizeInd);
                 SDO->state = CO_SDO_ST_IDLE;
                 ret = CO_SDO_RT_ok_communicationEnd;
             }
@@ -1297,10 +1612,10 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             /* load data from OD variable */
             OD_size_t count = 0;
 
-            CO_LOCK_OD(SDO->CANdevTx);
+            CO_LOCK_OD_GROUP(SDO->CANdevTx, SDO->ODlockGroup);
             ODR_t odRet = SDO->OD_IO.read(&SDO->OD_IO.stream,
                                           &SDO->CANtxBuff->data[4], 4, &count);
-            CO_UNLOCK_OD(SDO->CANdevTx);
+            CO_UNLOCK_OD_GROUP(SDO->CANdevTx, SDO->ODlockGroup);
 
             /* strings are allowed to be shorter */
             if (odRet == ODR_PARTIAL
@@ -1360,8 +1675,8 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             }
 
             /* copy data segment to CAN message */
-            memcpy(&SDO->CANtxBuff->data[1], SDO->buf + SDO->bufOffsetRd,
-                   count);
+            memcpy(&SDO->CANtxBuff->data[1],
+                   UPLOAD_DATA(SDO) + SDO->bufOffsetRd, count);
             SDO->bufOffsetRd += count;
             SDO->sizeTran += count;
 
@@ -1396,7 +1711,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             SDO->CANtxBuff->data[3] = SDO->subIndex;
 
             /* calculate number of block segments from free buffer space */
-            OD_size_t count = (CO_CONFIG_SDO_SRV_BUFFER_SIZE-2) / 7;
+            OD_size_t count = (CO_SDO_BUF_SIZE(SDO)-2) / 7;
             if (count > 127) {
                 count = 127;
             }
@@ -1436,7 +1751,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             else {
                 /* calculate number of block segments from free buffer space */
                 OD_size_t count;
-                count = (CO_CONFIG_SDO_SRV_BUFFER_SIZE-2-SDO->bufOffsetWr)/7;
+                count = (CO_SDO_BUF_SIZE(SDO)-2-SDO->bufOffsetWr)/7;
                 if (count >= 127) {
                     count = 127;
                 }
@@ -1445,7 +1760,7 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
                     if (!validateAndWriteToOD(SDO, &abortCode, 1, 0))
                         break;
 
-                    count =(CO_CONFIG_SDO_SRV_BUFFER_SIZE-2-SDO->bufOffsetWr)/7;
+                    count =(CO_SDO_BUF_SIZE(SDO)-2-SDO->bufOffsetWr)/7;
                     if (count >= 127) {
                         count = 127;
                     }
@@ -1518,8 +1833,8 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
             }
 
             /* copy data segment to CAN message */
-            memcpy(&SDO->CANtxBuff->data[1], SDO->buf + SDO->bufOffsetRd,
-                   count);
+            memcpy(&SDO->CANtxBuff->data[1],
+                   UPLOAD_DATA(SDO) + SDO->bufOffsetRd, count);
             SDO->bufOffsetRd += count;
             SDO->block_noData = (uint8_t)(7 - count);
             SDO->sizeTran += count;
@@ -1603,5 +1918,18 @@ CO_SDO_return_t CO_SDOserver_process(CO_SDOserver_t *SDO,
 #endif
     }
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING
+    if (SDO->state == CO_SDO_ST_IDLE && SDO->odPending) {
+        /* transfer was aborted while OD access was pending */
+        SDO->odPending = false;
+        CO_FLAG_CLEAR(SDO->CANrxNew);
+    }
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    if (SDO->state == CO_SDO_ST_IDLE) {
+        bufRelease(SDO);
+    }
+#endif
+
     return ret;
 }
@@ -39,6 +39,15 @@
 #ifndef CO_CONFIG_SDO_SRV_BUFFER_SIZE
 #define CO_CONFIG_SDO_SRV_BUFFER_SIZE 32
 #endif
+#ifndef CO_CONFIG_SDO_SRV_POOL_BUFFER_SIZE
+#define CO_CONFIG_SDO_SRV_POOL_BUFFER_SIZE 1024
+#endif
+#ifndef CO_CONFIG_SDO_SRV_POOL_COUNT
+#define CO_CONFIG_SDO_SRV_POOL_COUNT 2
+#endif
+#ifndef CO_CONFIG_SDO_SRV_PENDING_INTERVAL_US
+#define CO_CONFIG_SDO_SRV_PENDING_INTERVAL_US 1000
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -436,6 +445,26 @@ typedef enum {
 } CO_SDO_return_t;
 
 
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL) || defined CO_DOXYGEN
+/**
+ * Pool of large interim data buffers, shared by SDO servers.
+ *
+ * SDO server borrows buffer when segmented or block transfer starts and
+ * returns it when transfer ends. Expedited transfers and transfers of small
+ * OD variables do not need buffer from the pool. Pool is accessed only from
+ * CO_SDOserver_process(), so all SDO servers sharing the pool must be
+ * processed from the same thread.
+ */
+typedef struct {
+    /** Buffers + byte for '\0' */
+    uint8_t buf[CO_CONFIG_SDO_SRV_POOL_COUNT]
+               [CO_CONFIG_SDO_SRV_POOL_BUFFER_SIZE + 1];
+    /** Bit mask of borrowed buffers */
+    uint8_t used;
+} CO_SDOserver_bufferPool_t;
+#endif
+
+
 /**
  * SDO server object.
  */
@@ -454,6 +483,8 @@ typedef struct {
     volatile CO_SDO_state_t state;
     /** Object dictionary interface for current object. */
     OD_IO_t OD_IO;
+    /** Lock group of current object, see @ref CO_LOCK_OD_GROUP */
+    OD_lockGroup_t ODlockGroup;
     /** Index of the current object in Object Dictionary */
     uint16_t index;
     /** Subindex of the current object in Object Dictionary */
@@ -495,12 +526,38 @@ typedef struct {
     uint32_t SDOtimeoutTime_us;
     /** Timeout timer for SDO communication */
     uint32_t timeoutTimer;
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL) || defined CO_DOXYGEN
+    /** Own interim data buffer, used if buffer from the pool is not required
+     * or not available + byte for '\0' */
+    uint8_t bufOwn[CO_CONFIG_SDO_SRV_BUFFER_SIZE + 1];
+    /** Interim data buffer for current transfer, bufOwn or buffer from the
+     * pool, one byte larger than bufSize */
+    uint8_t *buf;
+    /** Size of the buf */
+    OD_size_t bufSize;
+    /** From CO_SDOserver_initBufferPool() or NULL */
+    CO_SDOserver_bufferPool_t *bufPool;
+    /** Index of buffer borrowed from the bufPool or 0xFF if none */
+    uint8_t bufPoolIdx;
+#else
     /** Interim data buffer for segmented or block transfer + byte for '\0' */
     uint8_t buf[CO_CONFIG_SDO_SRV_BUFFER_SIZE + 1];
+#endif
     /** Offset of next free data byte available for write in the buffer. */
     OD_size_t bufOffsetWr;
     /** Offset of first data available for read in the buffer */
     OD_size_t bufOffsetRd;
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_OD_PENDING) || defined CO_DOXYGEN
+    /** True, if OD read/write function returned ODR_PENDING. Current step of
+     * SDO communication is then repeated on next CO_SDOserver_process() */
+    bool_t odPending;
+#endif
+#if OD_EXTENSION_VIEW || defined CO_DOXYGEN
+    /** If not NULL, then upload data are read directly from this memory,
+     * provided by OD_extension_t view() function, instead of buf. Offsets and
+     * sizes above then apply to this memory. */
+    const uint8_t *view;
+#endif
 #endif
 #if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK) || defined CO_DOXYGEN
     /** Timeout time for SDO sub-block download, half of #SDOtimeoutTime_us */
@@ -581,6 +638,33 @@ void CO_SDOserver_initCallbackPre(CO_SDOserver_t *SDO,
 #endif
 
 
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL) || defined CO_DOXYGEN
+/**
+ * Initialize shared buffer pool for SDO servers.
+ *
+ * Function must be called in the communication reset section, before
+ * CO_SDOserver_initBufferPool().
+ *
+ * @param bufPool This object will be initialized.
+ */
+void CO_SDOserver_bufferPoolInit(CO_SDOserver_bufferPool_t *bufPool);
+
+
+/**
+ * Attach shared buffer pool to SDO server.
+ *
+ * Function must be called after CO_SDOserver_init(). If it is not called,
+ * SDO server uses only own buffer of CO_CONFIG_SDO_SRV_BUFFER_SIZE.
+ *
+ * @param SDO This object.
+ * @param bufPool Buffer pool, initialized by CO_SDOserver_bufferPoolInit().
+ * Can be NULL.
+ */
+void CO_SDOserver_initBufferPool(CO_SDOserver_t *SDO,
+                                 CO_SDOserver_bufferPool_t *bufPool);
+#endif
+
+
 /**
  * Process SDO communication.
  *
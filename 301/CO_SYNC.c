@@ -62,6 +62,9 @@ static void CO_SYNC_receive(void *object, void *msg) {
         /* toggle PDO receive buffer */
         SYNC->CANrxToggle = SYNC->CANrxToggle ? false : true;
 
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_RX_TIMESTAMP
+        SYNC->rxTimestamp = CO_CANrxMsg_readTimestamp(msg);
+#endif
         CO_FLAG_SET(SYNC->CANrxNew);
 
 #if (CO_CONFIG_SYNC) & CO_CONFIG_FLAG_CALLBACK_PRE
@@ -74,6 +77,41 @@ static void CO_SYNC_receive(void *object, void *msg) {
 }
 
 
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_RX_TIMESTAMP
+/* Update statistics with timestamp of just received SYNC message */
+static void CO_SYNC_statsUpdate(CO_SYNC_t *SYNC, uint32_t period_us) {
+    uint32_t timestamp = SYNC->rxTimestamp;
+
+    if (SYNC->rxTimestampPrevValid) {
+        CO_SYNC_stats_t *stats = &SYNC->stats;
+        /* unsigned arithmetic handles overflow of the timestamp counter */
+        uint32_t interval = timestamp - SYNC->rxTimestampPrev;
+
+        stats->intervalLast_us = interval;
+        if (stats->count == 0 || interval < stats->intervalMin_us) {
+            stats->intervalMin_us = interval;
+        }
+        if (interval > stats->intervalMax_us) {
+            stats->intervalMax_us = interval;
+        }
+        if (period_us > 0) {
+            uint32_t jitter = interval > period_us
+                            ? interval - period_us : period_us - interval;
+            stats->jitterLast_us = jitter;
+            if (jitter > stats->jitterMax_us) {
+                stats->jitterMax_us = jitter;
+            }
+        }
+        if (stats->count < 0xFFFFFFFF) {
+            stats->count++;
+        }
+    }
+    SYNC->rxTimestampPrev = timestamp;
+    SYNC->rxTimestampPrevValid = true;
+}
+#endif
+
+
 #if (CO_CONFIG_SYNC) & CO_CONFIG_FLAG_OD_DYNAMIC
 /*
  * Custom function for writing OD object "COB-ID sync message"
@@ -367,16 +405,19 @@ CO_SYNC_status_t CO_SYNC_process(CO_SYNC_t *SYNC,
         uint32_t timerNew = SYNC->timer + timeDifference_us;
         if (timerNew > SYNC->timer) SYNC->timer = timerNew;
 
+        uint32_t OD_1006_period = SYNC->OD_1006_period != NULL
+                                ? *SYNC->OD_1006_period : 0;
+
         /* was SYNC just received */
         if (CO_FLAG_READ(SYNC->CANrxNew)) {
             SYNC->timer = 0;
             syncStatus = CO_SYNC_RX_TX;
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_RX_TIMESTAMP
+            CO_SYNC_statsUpdate(SYNC, OD_1006_period);
+#endif
             CO_FLAG_CLEAR(SYNC->CANrxNew);
         }
 
-        uint32_t OD_1006_period = SYNC->OD_1006_period != NULL
-                                ? *SYNC->OD_1006_period : 0;
-
         if (OD_1006_period > 0) {
 #if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_PRODUCER
             if (SYNC->isProducer) {
@@ -444,6 +485,9 @@ CO_SYNC_status_t CO_SYNC_process(CO_SYNC_t *SYNC,
         SYNC->receiveError = 0;
         SYNC->counter = 0;
         SYNC->timer = 0;
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_RX_TIMESTAMP
+        CO_SYNC_resetStats(SYNC);
+#endif
     }
 
     if (syncStatus == CO_SYNC_RX_TX) {
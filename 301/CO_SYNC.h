@@ -75,6 +75,33 @@ extern "C" {
  */
 
 
+#if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_RX_TIMESTAMP) || defined CO_DOXYGEN
+/**
+ * SYNC reception statistics, calculated from SYNC receive timestamps.
+ *
+ * Interval is time between two consecutive received SYNC messages. Jitter is
+ * absolute difference between interval and "Communication cycle period"
+ * (OD 1006), it is calculated only if period is nonzero. Statistics are
+ * cleared by CO_SYNC_resetStats() and on NMT state other than pre-operational
+ * or operational.
+ */
+typedef struct {
+    /** Number of intervals measured */
+    uint32_t count;
+    /** Last interval in [microseconds] */
+    uint32_t intervalLast_us;
+    /** Minimum interval in [microseconds] */
+    uint32_t intervalMin_us;
+    /** Maximum interval in [microseconds] */
+    uint32_t intervalMax_us;
+    /** Last jitter in [microseconds] */
+    uint32_t jitterLast_us;
+    /** Maximum jitter in [microseconds] */
+    uint32_t jitterMax_us;
+} CO_SYNC_stats_t;
+#endif
+
+
 /**
  * SYNC producer and consumer object.
  */
@@ -140,6 +167,18 @@ typedef struct {
     /** From CO_SYNC_initCallbackPre() or NULL */
     void *functSignalObjectPre;
 #endif
+
+#if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_RX_TIMESTAMP) || defined CO_DOXYGEN
+    /** Reception time of the last SYNC message, written by receive function */
+    uint32_t rxTimestamp;
+    /** Reception time of the previous SYNC message, processed by
+     * CO_SYNC_process() */
+    uint32_t rxTimestampPrev;
+    /** True, if rxTimestampPrev is valid */
+    bool_t rxTimestampPrevValid;
+    /** SYNC period and jitter statistics */
+    CO_SYNC_stats_t stats;
+#endif
 } CO_SYNC_t;
 
 
@@ -251,6 +290,24 @@ CO_SYNC_status_t CO_SYNC_process(CO_SYNC_t *SYNC,
                                  uint32_t timeDifference_us,
                                  uint32_t *timerNext_us);
 
+
+#if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_RX_TIMESTAMP) || defined CO_DOXYGEN
+/**
+ * Clear SYNC statistics.
+ *
+ * Must be called from the same thread as CO_SYNC_process(). Next received
+ * SYNC starts new measurement.
+ *
+ * @param SYNC SYNC object.
+ */
+static inline void CO_SYNC_resetStats(CO_SYNC_t *SYNC) {
+    if (SYNC != NULL) {
+        memset(&SYNC->stats, 0, sizeof(SYNC->stats));
+        SYNC->rxTimestampPrevValid = false;
+    }
+}
+#endif
+
 /** @} */ /* CO_SYNC */
 
 #ifdef __cplusplus
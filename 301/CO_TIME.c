@@ -29,6 +29,15 @@
 
 #if (CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE
 
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_SERVO
+/* Gains of the PI controller, as right shift of the rate, which would remove
+ * the time difference in one time stamp interval. */
+#define CO_TIME_SERVO_KP_SHIFT 4
+#define CO_TIME_SERVO_KI_SHIFT 8
+
+#define CO_TIME_US_PER_DAY ((int64_t)1000*1000*60*60*24)
+#endif
+
 /*
  * Read received message from CAN module.
  *
@@ -89,6 +98,64 @@ static ODR_t OD_write_1012(OD_stream_t *stream, const void *buf,
 #endif
 
 
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_SERVO
+static int32_t servoClamp(int64_t rate) {
+    if (rate > CO_CONFIG_TIME_SERVO_MAX_PPB) return CO_CONFIG_TIME_SERVO_MAX_PPB;
+    if (rate < -CO_CONFIG_TIME_SERVO_MAX_PPB) return -CO_CONFIG_TIME_SERVO_MAX_PPB;
+    return (int32_t)rate;
+}
+
+/* Return timeDifference_us, corrected by the rate of the servo */
+static uint32_t servoAdvance(CO_TIME_t *TIME, uint32_t timeDifference_us) {
+    int64_t residual = TIME->servoResidual
+                     + (int64_t)timeDifference_us * TIME->servoRate_ppb;
+    int32_t adjust_us = (int32_t)(residual / 1000000000);
+
+    TIME->servoResidual = residual - (int64_t)adjust_us * 1000000000;
+    TIME->servoLocal_us += timeDifference_us;
+
+    /* rate correction is much smaller than 1, result is not negative */
+    return (uint32_t)((int64_t)timeDifference_us + adjust_us);
+}
+
+/* Compare received time stamp with own time and update the servo */
+static void servoUpdate(CO_TIME_t *TIME, uint32_t ms, uint16_t days) {
+    int64_t error_us = (((int64_t)days - TIME->days) * CO_TIME_US_PER_DAY)
+                     + ((int64_t)ms - TIME->ms) * 1000
+                     + CO_CONFIG_TIME_SERVO_LATENCY_US - TIME->residual_us;
+
+    if (!TIME->servoLocked || error_us > CO_CONFIG_TIME_SERVO_STEP_US
+        || error_us < -CO_CONFIG_TIME_SERVO_STEP_US
+    ) {
+        /* set own time, keep the rate, if already locked */
+        TIME->ms = ms + CO_CONFIG_TIME_SERVO_LATENCY_US / 1000;
+        TIME->days = days;
+        if (TIME->ms >= ((uint32_t)1000*60*60*24)) {
+            TIME->ms -= ((uint32_t)1000*60*60*24);
+            TIME->days += 1;
+        }
+        TIME->residual_us = CO_CONFIG_TIME_SERVO_LATENCY_US % 1000;
+        TIME->servoResidual = 0;
+        TIME->servoError_us = 0;
+        TIME->servoLocked = true;
+    }
+    else {
+        uint32_t interval_us = TIME->servoLocal_us - TIME->servoLocalPrev_us;
+        if (interval_us > 0) {
+            /* rate, which would remove the error in one interval */
+            int64_t rate = error_us * 1000000000 / interval_us;
+            TIME->servoRateI_ppb = servoClamp(TIME->servoRateI_ppb
+                                   + rate / (1 << CO_TIME_SERVO_KI_SHIFT));
+            TIME->servoRate_ppb = servoClamp(TIME->servoRateI_ppb
+                                   + rate / (1 << CO_TIME_SERVO_KP_SHIFT));
+        }
+        TIME->servoError_us = (int32_t)error_us;
+    }
+    TIME->servoLocalPrev_us = TIME->servoLocal_us;
+}
+#endif
+
+
 CO_ReturnError_t CO_TIME_init(CO_TIME_t *TIME,
                               OD_entry_t *OD_1012_cobIdTimeStamp,
                               CO_CANmodule_t *CANdevRx,
@@ -183,14 +250,27 @@ bool_t CO_TIME_process(CO_TIME_t *TIME,
 {
     bool_t timestampReceived = false;
 
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_SERVO
+    uint32_t stampMs = 0;
+    uint16_t stampDays = 0;
+
+    /* own clock keeps running with corrected rate, also at time stamp */
+    timeDifference_us = servoAdvance(TIME, timeDifference_us);
+#endif
+
     /* Was TIME stamp message just received */
     if (NMTisPreOrOperational && TIME->isConsumer) {
         if(CO_FLAG_READ(TIME->CANrxNew)) {
             uint32_t ms_swapped = CO_getUint32(&TIME->timeStamp[0]);
             uint16_t days_swapped = CO_getUint16(&TIME->timeStamp[4]);
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_SERVO
+            stampMs = CO_SWAP_32(ms_swapped) & 0x0FFFFFFF;
+            stampDays = CO_SWAP_16(days_swapped);
+#else
             TIME->ms = CO_SWAP_32(ms_swapped) & 0x0FFFFFFF;
             TIME->days = CO_SWAP_16(days_swapped);
             TIME->residual_us = 0;
+#endif
             timestampReceived = true;
 
             CO_FLAG_CLEAR(TIME->CANrxNew);
@@ -202,7 +282,11 @@ bool_t CO_TIME_process(CO_TIME_t *TIME,
 
     /* Update time */
     uint32_t ms = 0;
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_SERVO
+    if (timeDifference_us > 0) {
+#else
     if (!timestampReceived && timeDifference_us > 0) {
+#endif
         uint32_t us = timeDifference_us + TIME->residual_us;
         ms = us / 1000;
         TIME->residual_us = us % 1000;
@@ -212,6 +296,11 @@ bool_t CO_TIME_process(CO_TIME_t *TIME,
             TIME->days += 1;
         }
     }
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_SERVO
+    if (timestampReceived) {
+        servoUpdate(TIME, stampMs, stampDays);
+    }
+#endif
 
 #if (CO_CONFIG_TIME) & CO_CONFIG_TIME_PRODUCER
     if (NMTisPreOrOperational && TIME->isProducer
@@ -37,6 +37,15 @@
                         CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE | \
                         CO_CONFIG_GLOBAL_FLAG_OD_DYNAMIC)
 #endif
+#ifndef CO_CONFIG_TIME_SERVO_STEP_US
+#define CO_CONFIG_TIME_SERVO_STEP_US 100000
+#endif
+#ifndef CO_CONFIG_TIME_SERVO_LATENCY_US
+#define CO_CONFIG_TIME_SERVO_LATENCY_US 500
+#endif
+#ifndef CO_CONFIG_TIME_SERVO_MAX_PPB
+#define CO_CONFIG_TIME_SERVO_MAX_PPB 500000
+#endif
 
 #if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE) || defined CO_DOXYGEN
 
@@ -68,6 +77,12 @@ extern "C" {
  * Current time can be set with @ref CO_TIME_set() function, which is necessary
  * at least once, if time producer. If configured, time stamp message is
  * send from @ref CO_TIME_process() in intervals specified by @ref CO_TIME_set()
+ *
+ * If CO_CONFIG_TIME_SERVO is enabled, consumer sets its time only from the
+ * first received time stamp (or if difference is larger than
+ * @ref CO_CONFIG_TIME_SERVO_STEP_US). Later time stamps only correct the rate
+ * of own clock, so time is monotonic and keeps running with corrected rate
+ * also, if time stamps are missing.
  */
 
 
@@ -115,6 +130,23 @@ typedef struct {
     /** Extension for OD object */
     OD_extension_t OD_1012_extension;
 #endif
+#if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_SERVO) || defined CO_DOXYGEN
+    /** True, after time was set from the first received time stamp */
+    bool_t servoLocked;
+    /** Rate correction of own clock in ppb (parts per billion) */
+    int32_t servoRate_ppb;
+    /** Integral part of servoRate_ppb */
+    int32_t servoRateI_ppb;
+    /** Difference between last received time stamp and own time in
+     * microseconds, positive if own clock is behind */
+    int32_t servoError_us;
+    /** Uncorrected own time in microseconds, sum of timeDifference_us */
+    uint32_t servoLocal_us;
+    /** servoLocal_us at the last received time stamp */
+    uint32_t servoLocalPrev_us;
+    /** Residual of rate correction in 1e-9 microseconds */
+    int64_t servoResidual;
+#endif
 } CO_TIME_t;
 
 
@@ -209,6 +241,22 @@ bool_t CO_TIME_process(CO_TIME_t *TIME,
                        uint32_t timeDifference_us);
 
 
+#if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_SERVO) || defined CO_DOXYGEN
+/**
+ * Get current time in microseconds
+ *
+ * @param TIME This object.
+ *
+ * @return Microseconds since January 1, 1984, as updated by last
+ * CO_TIME_process() call.
+ */
+static inline uint64_t CO_TIME_get_us(CO_TIME_t *TIME) {
+    return ((uint64_t)TIME->days * ((uint32_t)1000*60*60*24) + TIME->ms) * 1000
+           + TIME->residual_us;
+}
+#endif
+
+
 /** @} */ /* CO_TIME */
 
 #ifdef __cplusplus
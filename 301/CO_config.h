@@ -124,6 +124,136 @@ extern "C" {
 /** @} */ /* CO_STACK_CONFIG_COMMON */
 
 
+/**
+ * @defgroup CO_STACK_CONFIG_DRIVER CAN driver
+ * Optional parts of the CAN driver interface
+ * @{
+ */
+/**
+ * Configuration of @ref CO_driver
+ *
+ * Flags are interpreted by the target specific CO_driver_target.h and
+ * CO_driver.c files. The example driver implements all of them.
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_DRIVER_RX_DISPATCH - Enable receive dispatch index, used when CAN
+ *   module hardware filters are not used. CO_CANrxBufferInit() builds a direct
+ *   lookup table for all 2048 standard identifiers, which are received with
+ *   exact mask (0x7FF), and a short list of rxArray entries with other masks.
+ *   Receive interrupt then finds the matching rxArray entry in constant time,
+ *   regardless of the number of configured CANopen objects. Entries with the
+ *   same identifier and different RTR bit share the lookup entry, others than
+ *   the first are found by search. Requires additional 4kB of RAM per CAN
+ *   module. Drivers share the implementation in @ref CO_CANrxDispatch.
+ * - CO_CONFIG_DRIVER_RX_RING - Enable single-producer/single-consumer ring of
+ *   received CAN messages inside CO_CANmodule_t. Receive interrupt only copies
+ *   matched message into the ring. CO_CANmodule_process(), called from
+ *   CO_process(), drains the ring and calls CANrx_callback() functions. Ring
+ *   only moves callbacks from interrupt to mainline, it does not buffer data
+ *   for CANopen objects. At most one message for each rxArray entry is
+ *   dispatched in one call, later messages for that entry stay in the ring
+ *   and are dispatched in next calls, in order. Messages for other entries
+ *   are not delayed. This does not protect against overwrite: if CANopen
+ *   object has not processed the message before its next message is
+ *   dispatched, the callback overwrites it, as without the ring. For example
+ *   second RPDO with the same CAN-ID overwrites the first one, if
+ *   CO_process_RPDO() was not called between two CO_process() calls. Note
+ *   that callbacks of real-time objects (SYNC, RPDO) are then also called
+ *   from mainline. If ring is full, message is dropped and
+ *   CO_CAN_ERRRX_OVERFLOW is set in CANerrorStatus.
+ * - CO_CONFIG_DRIVER_TX_BATCH - Enable CO_CANsendBatch() function, which sends
+ *   multiple CAN messages under single CO_LOCK_CAN_SEND. Driver may map it to
+ *   multi-mailbox or sendmmsg() submission. Synchronous TPDOs, processed by
+ *   CO_process_TPDO(), are then collected and submitted in single batch.
+ * - CO_CONFIG_DRIVER_TX_QUEUE - Enable priority ordered queue of pending CAN
+ *   transmit buffers, see @ref CO_CANtxQueue. CAN transmit interrupt sends
+ *   pending message with the lowest CAN identifier first, instead of scanning
+ *   txArray in index order. Size is limited by CO_CONFIG_DRIVER_TX_QUEUE_SIZE.
+ * - CO_CONFIG_DRIVER_FD - Enable CAN FD frames with up to 64 data bytes, see
+ *   CO_CAN_MAX_DATA_LEN. Driver must provide 64 byte data buffers in received
+ *   and transmit messages and CO_CANrxMsg_readDLC() must return data length in
+ *   bytes. Default CO_PDO_MAX_SIZE and CO_PDO_MAX_MAPPED_ENTRIES are then 64,
+ *   so PDO can map up to 64 bytes, also with byte-sized entries.
+ *   PDO with data length, which is not a valid CAN FD frame length, is sent
+ *   in the next larger frame, padded with zeros, see CO_CANfd_roundLength().
+ *   Other CANopen objects still use classic frames.
+ * - CO_CONFIG_DRIVER_HW_FILTER - Enable compiler of CAN hardware acceptance
+ *   filters, see @ref CO_CANfilter. Driver collects identifiers and masks of
+ *   all configured receive buffers and gets minimal set of mask/list filter
+ *   banks for its CAN controller. If there are not enough banks, entries are
+ *   merged, so hardware accepts some unwanted messages, which are then
+ *   rejected in software.
+ * - CO_CONFIG_DRIVER_TRAFFIC - Enable CAN traffic statistics inside
+ *   CO_CANmodule_t, see @ref CO_CANtraffic. Driver counts received and
+ *   transmitted frames for each COB-ID and number of bits on the bus,
+ *   including stuff bits. CO_process() calculates estimated bus load and
+ *   records high-water mark of transmit buffers waiting in txArray. Statistics
+ *   are readable from Object Dictionary, if @ref CO_CONFIG_STATS is enabled,
+ *   see @ref CO_CONFIG_STATS_TRAFFIC_OD_INDEX. Driver must provide *traffic*
+ *   member in CO_CANmodule_t: blank example, simulation and socketCAN drivers
+ *   do, other drivers fail to compile CO_process_NMT(). Bits are counted with
+ *   classical CAN framing, so with @ref CO_CONFIG_DRIVER_FD the bus load is
+ *   not correct, see CO_CANtraffic_frameBits().
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_DRIVER (0)
+#endif
+#define CO_CONFIG_DRIVER_RX_DISPATCH 0x01
+#define CO_CONFIG_DRIVER_RX_RING 0x02
+#define CO_CONFIG_DRIVER_TX_BATCH 0x04
+#define CO_CONFIG_DRIVER_TX_QUEUE 0x08
+#define CO_CONFIG_DRIVER_FD 0x10
+#define CO_CONFIG_DRIVER_HW_FILTER 0x20
+#define CO_CONFIG_DRIVER_TRAFFIC 0x40
+
+/**
+ * Maximum number of rxArray entries with non-exact mask, which can be handled
+ * by @ref CO_CONFIG_DRIVER_RX_DISPATCH. If more such entries are configured,
+ * receive interrupt falls back to the linear search of the rxArray, until
+ * some of them are reconfigured with exact mask or removed.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_DRIVER_RX_MASKED_COUNT 4
+#endif
+
+/**
+ * Number of CAN messages in the ring, enabled by
+ * @ref CO_CONFIG_DRIVER_RX_RING. Must be power of 2.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_DRIVER_RX_RING_SIZE 32
+#endif
+
+/**
+ * Maximum number of CAN messages in @ref CO_CANtxBatch_t, enabled by
+ * @ref CO_CONFIG_DRIVER_TX_BATCH. If batch is full, further messages are sent
+ * with CO_CANsend().
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_DRIVER_TX_BATCH_SIZE 32
+#endif
+
+/**
+ * Maximum number of filter banks and maximum number of receive buffers for
+ * @ref CO_CONFIG_DRIVER_HW_FILTER.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_DRIVER_FILTER_BANKS 28
+#define CO_CONFIG_DRIVER_FILTER_ENTRIES 64
+#endif
+
+/**
+ * Number of entries in the table of COB-IDs and time window for bus load in
+ * milliseconds for @ref CO_CONFIG_DRIVER_TRAFFIC. Number of entries must be
+ * power of 2, not larger than 64.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_DRIVER_TRAFFIC_IDS 32
+#define CO_CONFIG_DRIVER_TRAFFIC_WINDOW_MS 1000
+#endif
+/** @} */ /* CO_STACK_CONFIG_DRIVER */
+
+
 /**
  * @defgroup CO_STACK_CONFIG_NMT_HB NMT master/slave and HB producer/consumer
  * Specified in standard CiA 301
@@ -165,6 +295,16 @@ extern "C" {
  *   CO_HBconsumer_initCallbackRemoteReset() functions.
  * - CO_CONFIG_HB_CONS_QUERY_FUNCT - Enable functions for query HB state or
  *   NMT state of the specific monitored node.
+ * - CO_CONFIG_HB_CONS_INDEXED - Enable node-ID to index table, queue of
+ *   received heartbeats and deadline ordered heap of active nodes. Processing
+ *   time of CO_HBconsumer_process() then depends on the number of received
+ *   messages and expired timeouts only, not on the number of monitored nodes.
+ *   Useful for large number of monitored nodes. Node-ID in 0x1016 must be
+ *   1..127 then.
+ * - CO_CONFIG_HB_CONS_BITMAP - Enable node-ID bitmaps of active, timed out and
+ *   NMT operational nodes inside CO_HBconsumer_t and aggregated callback with
+ *   the set of changed nodes, configured by
+ *   CO_HBconsumer_initCallbackChangedSet().
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received heartbeat CAN message.
  *   Callback is configured by CO_HBconsumer_initCallbackPre().
@@ -183,6 +323,8 @@ extern "C" {
 #define CO_CONFIG_HB_CONS_CALLBACK_CHANGE 0x02
 #define CO_CONFIG_HB_CONS_CALLBACK_MULTI 0x04
 #define CO_CONFIG_HB_CONS_QUERY_FUNCT 0x08
+#define CO_CONFIG_HB_CONS_INDEXED 0x10
+#define CO_CONFIG_HB_CONS_BITMAP 0x20
 /** @} */ /* CO_STACK_CONFIG_NMT_HB */
 
 
@@ -205,6 +347,12 @@ extern "C" {
  *   "Pre-defined error field"
  * - CO_CONFIG_EM_CONSUMER - Enable simple emergency consumer with callback.
  * - CO_CONFIG_EM_STATUS_BITS - Access @ref CO_EM_errorStatusBits_t from OD.
+ * - CO_CONFIG_EM_PROD_COALESCE - Coalesce repeated emergency events and limit
+ *   transmission rate of emergency producer, see @ref CO_CONFIG_EM_RATE_BURST.
+ *   Requires CO_CONFIG_EM_PRODUCER.
+ * - CO_CONFIG_EM_STATUS_DIRTY - Track changes of errorStatusBits in a bitmap
+ *   and recalculate Error register inside CO_EM_process() only after change.
+ *   CO_CONFIG_ERR_CONDITION_xxx must then depend on errorStatusBits only.
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   emergency condition by CO_errorReport() or CO_errorReset() call.
  *   Callback is configured by CO_EM_initCallbackPre().
@@ -220,6 +368,8 @@ extern "C" {
 #define CO_CONFIG_EM_HISTORY 0x08
 #define CO_CONFIG_EM_STATUS_BITS 0x10
 #define CO_CONFIG_EM_CONSUMER 0x20
+#define CO_CONFIG_EM_PROD_COALESCE 0x40
+#define CO_CONFIG_EM_STATUS_DIRTY 0x80
 
 /**
  * Maximum number of @ref CO_EM_errorStatusBits_t
@@ -232,6 +382,35 @@ extern "C" {
 #define CO_CONFIG_EM_ERR_STATUS_BITS_COUNT (10*8)
 #endif
 
+/**
+ * Token bucket for emergency producer with CO_CONFIG_EM_PROD_COALESCE.
+ *
+ * If error is set, reset and set again by CO_error() for the same errorBit,
+ * while its "set" and "reset" emergency messages are still waiting in the
+ * fifo, then the "reset" message is removed and the new event is merged into
+ * the "set" message. That message keeps its error code and info code, so each
+ * error code is still sent and recorded in the error history (0x1003). Number
+ * of merged events (saturated at 255) is transmitted in byte 7 of the
+ * emergency message, so only lower 24 bits of infoCode are transmitted.
+ * Messages with different set/reset state are never merged, so one errorBit
+ * takes at most three messages in the fifo.
+ *
+ * Transmission is limited by token bucket: each emergency message consumes
+ * one token, one token is added each @ref CO_CONFIG_EM_RATE_INTERVAL_US, up to
+ * CO_CONFIG_EM_RATE_BURST tokens. Inhibit time (0x1015) applies additionally.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_EM_RATE_BURST 8
+#endif
+
+/**
+ * Interval in microseconds for adding one token, see
+ * @ref CO_CONFIG_EM_RATE_BURST.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_EM_RATE_INTERVAL_US 10000
+#endif
+
 /**
  * Condition for calculating CANopen Error register, "generic" error bit.
  *
@@ -322,6 +501,16 @@ extern "C" {
  * - CO_CONFIG_SDO_SRV_SEGMENTED - Enable SDO server segmented transfer.
  * - CO_CONFIG_SDO_SRV_BLOCK - Enable SDO server block transfer. If set, then
  *   CO_CONFIG_SDO_SRV_SEGMENTED must also be set.
+ * - CO_CONFIG_SDO_SRV_OD_PENDING - Enable support for ODR_PENDING return
+ *   value from OD read/write functions. Transfer is then parked, until OD
+ *   function completes or SDO timeout expires. OD function is called again
+ *   after CO_CONFIG_SDO_SRV_PENDING_INTERVAL_US. If set, then
+ *   CO_CONFIG_SDO_SRV_SEGMENTED must also be set.
+ * - CO_CONFIG_SDO_SRV_BUFFER_POOL - Enable pool of large transfer buffers,
+ *   shared by all SDO servers. Server borrows buffer from the pool, when
+ *   segmented or block transfer starts and returns it, when transfer ends.
+ *   Pool is configured by CO_SDOserver_initBufferPool(). If set, then
+ *   CO_CONFIG_SDO_SRV_SEGMENTED must also be set.
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received SDO CAN message.
  *   Callback is configured by CO_SDOserver_initCallbackPre().
@@ -335,18 +524,57 @@ extern "C" {
 #endif
 #define CO_CONFIG_SDO_SRV_SEGMENTED 0x02
 #define CO_CONFIG_SDO_SRV_BLOCK 0x04
+#define CO_CONFIG_SDO_SRV_BUFFER_POOL 0x08
+#define CO_CONFIG_SDO_SRV_OD_PENDING 0x10
 
 /**
  * Size of the internal data buffer for the SDO server.
  *
  * If size is less than size of some variables in Object Dictionary, then data
  * will be transferred to internal buffer in several segments. Minimum size is
- * 8 or 899 (127*7) for block transfer.
+ * 8 or 899 (127*7) for block transfer. If CO_CONFIG_SDO_SRV_BUFFER_POOL is
+ * enabled, then this buffer is used only, if buffer from the pool is not
+ * required or not available, and minimum size for block transfer does not
+ * apply.
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_SDO_SRV_BUFFER_SIZE 32
 #endif
 
+/**
+ * Size of each buffer in the SDO server buffer pool.
+ *
+ * Used, if CO_CONFIG_SDO_SRV_BUFFER_POOL is enabled. Minimum size is 20 or 899
+ * (127*7) for block transfer.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_SDO_SRV_POOL_BUFFER_SIZE 1024
+#endif
+
+/**
+ * Number of buffers in the SDO server buffer pool, 1 to 8.
+ *
+ * This is the number of segmented or block transfers, which may use large
+ * buffer simultaneously. Used, if CO_CONFIG_SDO_SRV_BUFFER_POOL is enabled.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_SDO_SRV_POOL_COUNT 2
+#endif
+
+/**
+ * Interval in microseconds, in which SDO server repeats OD read/write, which
+ * returned ODR_PENDING.
+ *
+ * Used, if CO_CONFIG_SDO_SRV_OD_PENDING and #CO_CONFIG_FLAG_TIMERNEXT are
+ * enabled: while OD access is pending, SDO server limits timerNext_us to this
+ * value, so mainline is not suspended until SDO timeout. Without
+ * #CO_CONFIG_FLAG_TIMERNEXT application must call CO_process() frequently
+ * enough by itself.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_SDO_SRV_PENDING_INTERVAL_US 1000
+#endif
+
 /**
  * Configuration of @ref CO_SDOclient
  *
@@ -359,6 +587,18 @@ extern "C" {
  * - CO_CONFIG_SDO_CLI_LOCAL - Enable local transfer, if Node-ID of the SDO
  *   server is the same as node-ID of the SDO client. (SDO client is the same
  *   device as SDO server.) Transfer data directly without communication on CAN.
+ * - CO_CONFIG_SDO_CLI_BLOCK_PIPELINE - Pipelined block download. Segments of
+ *   the sub-block are sent in a burst within one CO_SDOclientDownload() call,
+ *   as long as CAN transmit buffer is free. Retransmission from the server
+ *   reported ackseq starts within the same call, which processes the
+ *   acknowledge. CRC of the sub-block is calculated while waiting for the
+ *   acknowledge. Useful, if CAN driver has transmit queue.
+ * - CO_CONFIG_SDO_CLI_POOL - Enable @ref CO_SDOclientPool, which processes
+ *   queue of SDO jobs in parallel on multiple SDO clients, each job with
+ *   different SDO server.
+ * - CO_CONFIG_SDO_CLI_CACHE - Enable @ref CO_SDOclientCache, which keeps
+ *   values uploaded from remote nodes, so repeated reads of static objects
+ *   need no SDO communication. Used by the gateway 'r' command.
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received SDO CAN message.
  *   Callback is configured by CO_SDOclient_initCallbackPre().
@@ -375,6 +615,33 @@ extern "C" {
 #define CO_CONFIG_SDO_CLI_SEGMENTED 0x02
 #define CO_CONFIG_SDO_CLI_BLOCK 0x04
 #define CO_CONFIG_SDO_CLI_LOCAL 0x08
+#define CO_CONFIG_SDO_CLI_BLOCK_PIPELINE 0x10
+#define CO_CONFIG_SDO_CLI_POOL 0x20
+#define CO_CONFIG_SDO_CLI_CACHE 0x40
+
+/**
+ * Maximum number of SDO clients used by @ref CO_SDOclientPool, if
+ * CO_CONFIG_SDO_CLI_POOL is enabled.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_SDO_CLI_POOL_SIZE 8
+#endif
+
+/**
+ * Number of values in @ref CO_SDOclientCache, if CO_CONFIG_SDO_CLI_CACHE is
+ * enabled.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_SDO_CLI_CACHE_SIZE 16
+#endif
+
+/**
+ * Maximum size of one value in @ref CO_SDOclientCache in bytes, up to 255.
+ * Larger values are not cached.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE 32
+#endif
 
 /**
  * Size of the internal data buffer for the SDO client.
@@ -409,12 +676,47 @@ extern "C" {
  *   Callback is configured by CO_TIME_initCallbackPre().
  * - #CO_CONFIG_FLAG_OD_DYNAMIC - Enable dynamic configuration - writing to
  *   object 0x1012 enables / disables time producer or consumer.
+ * - CO_CONFIG_TIME_SERVO - Time consumer does not overwrite its time with each
+ *   received time stamp. Instead it measures the difference between received
+ *   and own time and corrects the rate of own clock with PI controller. This
+ *   compensates drift of local oscillator and averages out millisecond
+ *   resolution of the time stamp, so own microsecond clock stays aligned with
+ *   the producer between time stamps. See @ref CO_TIME_get_us().
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_TIME (CO_CONFIG_TIME_ENABLE | CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE | CO_CONFIG_GLOBAL_FLAG_OD_DYNAMIC)
 #endif
 #define CO_CONFIG_TIME_ENABLE 0x01
 #define CO_CONFIG_TIME_PRODUCER 0x02
+#define CO_CONFIG_TIME_SERVO 0x04
+
+/**
+ * Maximum time difference in microseconds, corrected by CO_CONFIG_TIME_SERVO.
+ *
+ * If difference between received time stamp and own time is larger, own time
+ * is set to the received time stamp, as without the servo.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_TIME_SERVO_STEP_US 100000
+#endif
+
+/**
+ * Time in microseconds, added to received time stamp by CO_CONFIG_TIME_SERVO.
+ *
+ * Producer sends milliseconds after midnight truncated, so received time stamp
+ * is in average half of millisecond behind. Value may be increased by the
+ * transmission and processing delay.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_TIME_SERVO_LATENCY_US 500
+#endif
+
+/**
+ * Maximum rate correction in ppb (parts per billion) by CO_CONFIG_TIME_SERVO.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_TIME_SERVO_MAX_PPB 500000
+#endif
 /** @} */ /* CO_STACK_CONFIG_TIME */
 
 
@@ -435,12 +737,16 @@ extern "C" {
  * - #CO_CONFIG_FLAG_TIMERNEXT - Enable calculation of timerNext_us variable
  *   inside CO_SYNC_process().
  * - #CO_CONFIG_FLAG_OD_DYNAMIC - Enable dynamic configuration of SYNC.
+ * - CO_CONFIG_SYNC_RX_TIMESTAMP - Read reception time of SYNC message with
+ *   CO_CANrxMsg_readTimestamp(), which must be provided by the driver, and
+ *   calculate SYNC period and jitter statistics, see @ref CO_SYNC_stats_t.
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_SYNC (CO_CONFIG_SYNC_ENABLE | CO_CONFIG_SYNC_PRODUCER | CO_CONFIG_GLOBAL_RT_FLAG_CALLBACK_PRE | CO_CONFIG_GLOBAL_FLAG_TIMERNEXT | CO_CONFIG_GLOBAL_FLAG_OD_DYNAMIC)
 #endif
 #define CO_CONFIG_SYNC_ENABLE 0x01
 #define CO_CONFIG_SYNC_PRODUCER 0x02
+#define CO_CONFIG_SYNC_RX_TIMESTAMP 0x04
 
 /**
  * Configuration of @ref CO_PDO
@@ -458,6 +764,56 @@ extern "C" {
  *   flexibility for application program, but consumes some additional memory
  *   and processor resources. If this option is not enabled, then data from OD
  *   variables are fetched directly from memory allocated by Object dictionary.
+ * - CO_CONFIG_PDO_COPY_PLAN - Used with CO_CONFIG_PDO_OD_IO_ACCESS. Mapped OD
+ *   variables without OD extension are copied directly to/from memory
+ *   allocated by Object dictionary, without read/write function call. Mapping
+ *   is compiled into a plan of copy runs, where mapped variables, adjacent in
+ *   memory, are coalesced into single memcpy. Plan is built when PDO mapping
+ *   is configured. Variables with OD extension are still accessed via
+ *   @ref OD_IO_t. As with read/write functions, OD extension must be
+ *   initialized before PDO.
+ * - CO_CONFIG_PDO_FAST_REINIT - Remember PDO mapping parameters from the last
+ *   initialization. On CO_RPDO_init() or CO_TPDO_init() after communication
+ *   reset, mapping is rebuilt only if mapping parameters in OD have changed,
+ *   otherwise mapping from the previous initialization is reused. This skips
+ *   searching the Object Dictionary for each mapped variable. OD extensions of
+ *   mapped variables must not change between initializations. PDO objects
+ *   must be zeroed before first initialization, as CO_new() does.
+ * - CO_CONFIG_TPDO_SYNC_OFFSET - Used with CO_CONFIG_PDO_SYNC_ENABLE.
+ *   Synchronous TPDO may be configured with CO_TPDO_setSyncOffset() to be
+ *   sent specified time after the SYNC, instead of immediately. Different
+ *   offsets for different TPDOs spread them over the SYNC period. Accuracy
+ *   depends on how often CO_TPDO_process() is called, so
+ *   #CO_CONFIG_FLAG_TIMERNEXT is recommended.
+ * - CO_CONFIG_TPDO_REQUEST_COUNT - Each OD_requestTPDO() call also increments
+ *   global OD_TPDOrequestCount. CO_process_TPDO() then checks flagsPDO bits
+ *   of mapped OD variables with CO_TPDO_checkRequests() only, if counter
+ *   changed, and CO_TPDO_process() does not check them at all. All TPDOs are
+ *   checked before any of them is sent, so OD variable, mapped to multiple
+ *   event driven TPDOs, triggers all of them. Counter is single and global,
+ *   it does not tell which TPDO was requested: any request causes the scan of
+ *   all mapped variables of all TPDOs, also in other CO_t objects. Idle cost
+ *   is so reduced only by the flag scan, CO_TPDO_process() is still called
+ *   for each TPDO. Benefit is small, if requests are frequent.
+ * - CO_CONFIG_TPDO_COS - Used with CO_CONFIG_PDO_OD_IO_ACCESS and
+ *   CO_CONFIG_TPDO_TIMERS_ENABLE. Event driven TPDO (transmission type 254 or
+ *   255) may be configured with CO_TPDO_setCOS() to be sent automatically on
+ *   change of state of mapped data, without OD_requestTPDO(). After inhibit
+ *   time, CO_TPDO_process() reads mapped variables and compares them with the
+ *   last transmitted data. Each mapped variable may have own bit mask and
+ *   deadband, see CO_TPDO_setCOSdeadband().
+ * - CO_CONFIG_PDO_ROUTING - Used with CO_CONFIG_PDO_OD_IO_ACCESS, RPDO and
+ *   TPDO. Data range of RPDO may be routed with CO_RPDO_addRoute() directly
+ *   into CAN buffer of TPDO, possibly bound to other CAN interface. Routed
+ *   mapped variables of TPDO are not read from OD and TPDO may be sent
+ *   immediately after RPDO is processed. OD variables of RPDO are still
+ *   written.
+ * - CO_CONFIG_RPDO_ISR_PROCESS - Used with CO_CONFIG_PDO_COPY_PLAN. Event
+ *   driven RPDO (transmission type 254 or 255) may be configured with
+ *   CO_RPDO_setIsrProcessing() to write received data into OD variables
+ *   directly from CAN receive callback, if all mapped variables are copied
+ *   directly (have no OD extension). CO_RPDO_process() then only monitors
+ *   timeout and routes data.
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received RPDO CAN message.
  *   Callback is configured by CO_RPDO_initCallbackPre().
@@ -474,6 +830,13 @@ extern "C" {
 #define CO_CONFIG_TPDO_TIMERS_ENABLE 0x08
 #define CO_CONFIG_PDO_SYNC_ENABLE 0x10
 #define CO_CONFIG_PDO_OD_IO_ACCESS 0x20
+#define CO_CONFIG_PDO_COPY_PLAN 0x40
+#define CO_CONFIG_PDO_FAST_REINIT 0x80
+#define CO_CONFIG_TPDO_SYNC_OFFSET 0x100
+#define CO_CONFIG_TPDO_REQUEST_COUNT 0x200
+#define CO_CONFIG_TPDO_COS 0x400
+#define CO_CONFIG_PDO_ROUTING 0x800
+#define CO_CONFIG_RPDO_ISR_PROCESS 0x1000
 /** @} */ /* CO_STACK_CONFIG_SYNC_PDO */
 
 
@@ -487,14 +850,92 @@ extern "C" {
  *
  * Possible flags, can be ORed:
  * - CO_CONFIG_STORAGE_ENABLE - Enable data storage
+ * - CO_CONFIG_STORAGE_EEPROM_DELTA - Used with @ref CO_storage_eeprom. On
+ *   store command (0x1010) data block is compared with eeprom in chunks of
+ *   @ref CO_CONFIG_STORAGE_EEPROM_CHUNK bytes and only changed chunks are
+ *   written and verified. CRC checksum is calculated from the chunks during
+ *   the same pass, so data block is not read back again from the eeprom.
+ * - CO_CONFIG_STORAGE_AUTO_DIRTY - Used with @ref CO_storage_eeprom. Writes to
+ *   OD variables with OD_writeOriginal() (including OD_set_xxx() functions)
+ *   mark dirty range inside auto storage entry. Automatic storage compares and
+ *   writes only dirty ranges, so eeprom is not accessed, if nothing changed.
+ *   Data changed directly by application must be marked with
+ *   CO_storageEeprom_markDirty(). RPDOs, which copy data into OD variables
+ *   directly, mark them with OD_notifyWrite(). OD_WRITE_OBSERVER must be set
+ *   to 1 and Object Dictionary must be passed to CO_storageEeprom_init().
+ * - CO_CONFIG_STORAGE_DEFERRED - Store command (0x1010) is not executed inside
+ *   SDO server. OD write only queues the command and returns ODR_PENDING.
+ *   Data are stored by CO_storage_process(), which must be called cyclically
+ *   from mainline or from separate thread. SDO response is sent, when store is
+ *   finished. Requires @ref CO_CONFIG_SDO_SRV_OD_PENDING. With
+ *   @ref CO_storage_eeprom one chunk of @ref CO_CONFIG_STORAGE_EEPROM_CHUNK
+ *   bytes is written and verified per CO_storage_process() call.
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_STORAGE (CO_CONFIG_STORAGE_ENABLE)
 #endif
 #define CO_CONFIG_STORAGE_ENABLE 0x01
+#define CO_CONFIG_STORAGE_EEPROM_DELTA 0x02
+#define CO_CONFIG_STORAGE_AUTO_DIRTY 0x04
+#define CO_CONFIG_STORAGE_DEFERRED 0x08
+
+/**
+ * Size of chunk in bytes, used with CO_CONFIG_STORAGE_EEPROM_DELTA and
+ * CO_CONFIG_STORAGE_DEFERRED.
+ *
+ * Chunks are aligned to multiples of this value inside eeprom, so it must be
+ * equal to eeprom page size or its divisor. Chunk buffer is on stack.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_STORAGE_EEPROM_CHUNK 32
+#endif
 /** @} */ /* CO_STACK_CONFIG_STORAGE */
 
 
+/**
+ * @defgroup CO_STACK_CONFIG_BOOT_MGR Boot-up manager
+ * Specified in standard CiA 302-2
+ * @{
+ */
+/**
+ * Configuration of @ref CO_bootManager
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_BOOT_MGR_ENABLE - Enable boot-up manager, which checks,
+ *   configures and starts NMT slaves in parallel. CO_CONFIG_SDO_CLI_POOL and
+ *   CO_CONFIG_NMT_MASTER must also be enabled. If CO_CONFIG_HB_CONS_CALLBACK_
+ *   MULTI and CO_CONFIG_HB_CONS_QUERY_FUNCT are enabled, slaves are booted
+ *   again after boot-up message.
+ * - #CO_CONFIG_FLAG_TIMERNEXT - Enable calculation of timerNext_us variable
+ *   inside CO_bootManager_process().
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_BOOT_MGR (0)
+#endif
+#define CO_CONFIG_BOOT_MGR_ENABLE 0x01
+/** @} */ /* CO_STACK_CONFIG_BOOT_MGR */
+
+
+/**
+ * @defgroup CO_STACK_CONFIG_CONCISE_DCF Concise DCF
+ * Specified in standard CiA 302-3
+ * @{
+ */
+/**
+ * Configuration of @ref CO_conciseDcf
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_CONCISE_DCF_ENABLE - Enable concise DCF consumer on OD object
+ *   0x1F22. Whole configuration can then be downloaded with single SDO (block)
+ *   transfer. Concise DCF image can also be used by @ref CO_bootManager.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_CONCISE_DCF (0)
+#endif
+#define CO_CONFIG_CONCISE_DCF_ENABLE 0x01
+/** @} */ /* CO_STACK_CONFIG_CONCISE_DCF */
+
+
 /**
  * @defgroup CO_STACK_CONFIG_LEDS CANopen LED diodes
  * Specified in standard CiA 303-3
@@ -527,6 +968,9 @@ extern "C" {
  * - CO_CONFIG_GFC_ENABLE - Enable the GFC object
  * - CO_CONFIG_GFC_CONSUMER - Enable the GFC consumer
  * - CO_CONFIG_GFC_PRODUCER - Enable the GFC producer
+ * - CO_CONFIG_GFC_LATENCY - Measure latency from GFC reception to safe state,
+ *   see CO_GFC_safeStateReached(). Reception time is read with
+ *   CO_CANrxMsg_readTimestamp(), which must be provided by the driver.
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_GFC (0)
@@ -534,6 +978,7 @@ extern "C" {
 #define CO_CONFIG_GFC_ENABLE 0x01
 #define CO_CONFIG_GFC_CONSUMER 0x02
 #define CO_CONFIG_GFC_PRODUCER 0x04
+#define CO_CONFIG_GFC_LATENCY 0x08
 
 /**
  * Configuration of @ref CO_SRDO
@@ -584,6 +1029,11 @@ extern "C" {
  * - CO_CONFIG_LSS_SLAVE_FASTSCAN_DIRECT_RESPOND - Send LSS fastscan respond
  *   directly from CO_LSSslave_receive() function.
  * - CO_CONFIG_LSS_MASTER - Enable LSS master
+ * - CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI - Enable identification of many
+ *   unconfigured nodes in one session with LSS master fastscan. Timeout for
+ *   fastscan queries is adapted to the measured response time of the slaves,
+ *   LSS address parts of the previously found node are verified first, before
+ *   scanning all bits. Enables also CO_LSSmaster_AssignNodeIds().
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received CAN message.
  *   Callback is configured by CO_LSSmaster_initCallbackPre().
@@ -594,6 +1044,28 @@ extern "C" {
 #define CO_CONFIG_LSS_SLAVE 0x01
 #define CO_CONFIG_LSS_SLAVE_FASTSCAN_DIRECT_RESPOND 0x02
 #define CO_CONFIG_LSS_MASTER 0x10
+#define CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI 0x20
+
+/**
+ * Fastscan response timeout multiplier, used with
+ * CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI.
+ *
+ * Timeout for fastscan query is the largest measured response time of the
+ * slaves, multiplied by this value and incremented by
+ * CO_CONFIG_LSS_FASTSCAN_TIMEOUT_MARGIN_US. It is never larger than timeout
+ * set by CO_LSSmaster_changeTimeout().
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_LSS_FASTSCAN_TIMEOUT_FACTOR 4
+#endif
+
+/**
+ * Fastscan response timeout margin in microseconds, see
+ * CO_CONFIG_LSS_FASTSCAN_TIMEOUT_FACTOR.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_LSS_FASTSCAN_TIMEOUT_MARGIN_US 2000
+#endif
 /** @} */ /* CO_STACK_CONFIG_LSS */
 
 
@@ -625,6 +1097,13 @@ extern "C" {
  *   help usage.
  * - CO_CONFIG_GTW_ASCII_PRINT_LEDS - Display "red" and "green" CANopen status
  *   LED diodes on terminal.
+ * - CO_CONFIG_GTW_BINARY - Enable compact binary framed commands, which may be
+ *   mixed with ASCII commands on the same stream. They use the same SDO, NMT
+ *   and LSS back-ends, but with raw binary data, no ASCII conversion. See
+ *   @ref CO_CANopen_309_3_Binary.
+ * - CO_CONFIG_GTW_ASCII_SDO_MULTI - Enable multiple outstanding SDO commands.
+ *   Each runs on own SDO client from CO_GTWA_initSDOchannels() and responses
+ *   are emitted as commands complete, identified by the sequence number.
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_GTW (0)
@@ -638,6 +1117,8 @@ extern "C" {
 #define CO_CONFIG_GTW_ASCII_ERROR_DESC 0x40
 #define CO_CONFIG_GTW_ASCII_PRINT_HELP 0x80
 #define CO_CONFIG_GTW_ASCII_PRINT_LEDS 0x100
+#define CO_CONFIG_GTW_BINARY 0x200
+#define CO_CONFIG_GTW_ASCII_SDO_MULTI 0x400
 
 /**
  * Number of loops of #CO_SDOclientDownload() in case of block download
@@ -666,6 +1147,14 @@ extern "C" {
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_GTWA_LOG_BUF_SIZE 2000
 #endif
+
+/**
+ * Maximum number of background SDO channels in ASCII gateway object, see
+ * CO_CONFIG_GTW_ASCII_SDO_MULTI.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_GTWA_SDO_CHANNELS 4
+#endif
 /** @} */ /* CO_STACK_CONFIG_GATEWAY */
 
 
@@ -680,12 +1169,32 @@ extern "C" {
  * Possible flags, can be ORed:
  * - CO_CONFIG_CRC16_ENABLE - Enable CRC16 calculation
  * - CO_CONFIG_CRC16_EXTERNAL - CRC functions are defined externally
+ * - CO_CONFIG_CRC16_SLICE4 - crc16_ccitt() processes four bytes per step
+ *   (slicing-by-4). Uses additional 1536 bytes of constant tables.
+ * - CO_CONFIG_CRC16_SLICE8 - crc16_ccitt() processes eight bytes per step
+ *   (slicing-by-8). Uses additional 3584 bytes of constant tables. Overrides
+ *   CO_CONFIG_CRC16_SLICE4.
+ * - CO_CONFIG_CRC16_HW - crc16_ccitt() passes blocks, which are not shorter
+ *   than @ref CO_CONFIG_CRC16_HW_MIN_LENGTH, to crc16_ccitt_hw() function,
+ *   which must be defined by the application or driver. It may use CRC
+ *   peripheral of the microcontroller.
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_CRC16 (0)
 #endif
 #define CO_CONFIG_CRC16_ENABLE 0x01
 #define CO_CONFIG_CRC16_EXTERNAL 0x02
+#define CO_CONFIG_CRC16_SLICE4 0x04
+#define CO_CONFIG_CRC16_SLICE8 0x08
+#define CO_CONFIG_CRC16_HW 0x10
+
+/**
+ * Minimum length of data block in bytes, for which crc16_ccitt_hw() is used,
+ * if CO_CONFIG_CRC16_HW is enabled. Shorter blocks are calculated in software.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_CRC16_HW_MIN_LENGTH 16
+#endif
 /** @} */ /* CO_STACK_CONFIG_CRC16 */
 
 
@@ -713,7 +1222,11 @@ extern "C" {
  * - CO_CONFIG_FIFO_ASCII_DATATYPES - This must be enabled, when CANopen gateway
  *   has CO_CONFIG_GTW_ASCII and CO_CONFIG_GTW_ASCII_SDO enabled. It adds
  *   datatype transform functions between binary and ascii, which are necessary
- *   for SDO client.
+ *   for SDO client. Numbers are formatted and parsed with own functions, which
+ *   use no locale and no heap, and do not need printf from the C library.
+ * - CO_CONFIG_FIFO_ASCII_LIBC - If set, sprintf(), strtoul(), strtod() and
+ *   similar functions from the C library are used for the datatype transform
+ *   functions instead of own formatters and parsers.
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_FIFO (0)
@@ -723,6 +1236,7 @@ extern "C" {
 #define CO_CONFIG_FIFO_CRC16_CCITT 0x04
 #define CO_CONFIG_FIFO_ASCII_COMMANDS 0x08
 #define CO_CONFIG_FIFO_ASCII_DATATYPES 0x10
+#define CO_CONFIG_FIFO_ASCII_LIBC 0x20
 /** @} */ /* CO_STACK_CONFIG_FIFO */
 
 
@@ -738,15 +1252,141 @@ extern "C" {
  * - CO_CONFIG_TRACE_ENABLE - Enable Trace recorder
  * - CO_CONFIG_TRACE_OWN_INTTYPES - If set, then macros PRIu32("u" or "lu")
  *   and PRId32("d" or "ld") must be set. (File inttypes.h can not be included).
+ * - CO_CONFIG_TRACE_BINARY_DELTA - Enable output format 3 (binary delta) for
+ *   trace.plot. Each point is written as two variable length integers:
+ *   difference of time stamp and difference of value from previous point.
+ *   No text formatting is used on the device and data are much shorter.
+ * - CO_CONFIG_TRACE_TRIGGER_WINDOW - Enable triggered capture: if bit 2 is set
+ *   in trigger, recording stops after the configured number of points after
+ *   the trigger. Circular buffer then contains pre-trigger and post-trigger
+ *   window, see CO_trace_setPostTrigger().
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_TRACE (0)
 #endif
 #define CO_CONFIG_TRACE_ENABLE 0x01
 #define CO_CONFIG_TRACE_OWN_INTTYPES 0x02
+#define CO_CONFIG_TRACE_BINARY_DELTA 0x04
+#define CO_CONFIG_TRACE_TRIGGER_WINDOW 0x08
 /** @} */ /* CO_STACK_CONFIG_TRACE */
 
 
+/**
+ * @defgroup CO_STACK_CONFIG_STATS Statistics
+ * Non standard object
+ * @{
+ */
+/**
+ * Configuration of @ref CO_stats, statistics of processing time and
+ * communication events inside CO_process() and other functions from CANopen.c.
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_STATS_ENABLE - Enable statistics. Execution time is measured with
+ *   CO_STATS_CYCLES() macro, which should be defined by the driver.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_STATS (0)
+#endif
+#define CO_CONFIG_STATS_ENABLE 0x01
+
+/**
+ * Index of manufacturer specific OD entry with statistics.
+ *
+ * If entry does not exist in Object Dictionary, statistics are only available
+ * to application inside CO_t. For structure of entry see CO_stats_init().
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_STATS_OD_INDEX 0x2F00
+#endif
+
+/**
+ * Index of manufacturer specific OD entry with CAN traffic statistics of the
+ * first CAN module, enabled by @ref CO_CONFIG_DRIVER_TRAFFIC. For structure
+ * of entry see CO_stats_initTraffic().
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_STATS_TRAFFIC_OD_INDEX 0x2F01
+#endif
+/** @} */ /* CO_STACK_CONFIG_STATS */
+
+
+/**
+ * @defgroup CO_STACK_CONFIG_EVLOG Event log
+ * Non standard object
+ * @{
+ */
+/**
+ * Configuration of @ref CO_eventLog, lock-free log of binary event records.
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_EVLOG_ENABLE - Enable event log. If CO_CONFIG_GTW_ASCII_LOG is
+ *   also enabled, records are printed by "log" command of the gateway and
+ *   gateway records SDO aborts and LSS events.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_EVLOG (0)
+#endif
+#define CO_CONFIG_EVLOG_ENABLE 0x01
+
+/**
+ * Number of records in event log, must be power of two.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_EVLOG_SIZE 64
+#endif
+/** @} */ /* CO_STACK_CONFIG_EVLOG */
+
+
+/**
+ * @defgroup CO_STACK_CONFIG_PROCESS Processing of CANopen objects
+ * Processing inside CO_process() from CANopen.c
+ * @{
+ */
+/**
+ * Configuration of CO_process().
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_PROCESS_SCHEDULER - Enable scheduler inside CO_process(). Each
+ *   object with own deadline or receive event is processed only, if its
+ *   timer from previous timerNext_us expired or if it has new CAN message or
+ *   other pending work. Time elapsed between is accumulated and passed to the
+ *   processing function. This is used for SDO servers and Heartbeat consumer,
+ *   which then take no processing time when idle. Heartbeat consumer requires
+ *   #CO_CONFIG_FLAG_TIMERNEXT for skipping. Other objects are processed on
+ *   each call, as they poll for changes without events.
+ *   If 0x1016 is changed by application directly (not by SDO), change is
+ *   applied on next Heartbeat consumer event.
+ * - CO_CONFIG_PROCESS_BUDGET - Enable CO_processBudget(), alternative to
+ *   CO_process(), which limits the amount of work done in one call. Tasks are
+ *   processed in round-robin order within the work budget and next call
+ *   continues, where previous stopped. Budget is a number of active objects,
+ *   not time, and tasks are not split, see CO_processBudget() for limits.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_PROCESS (0)
+#endif
+#define CO_CONFIG_PROCESS_SCHEDULER 0x01
+#define CO_CONFIG_PROCESS_BUDGET 0x02
+
+/**
+ * Number of CAN interfaces (CAN modules) inside one @ref CO_t object.
+ *
+ * If larger than 1, additional CAN modules are allocated by CO_new(), each with
+ * own CANrx and CANtx arrays, sized only for the objects, which can be bound to
+ * them (RPDO, TPDO, SDO and Heartbeat consumer). They are initialised by
+ * CO_CANinitIf() and processed together with the first one. All interfaces
+ * share single Object Dictionary, so data received on one bus can be mapped to
+ * PDO on other bus without copying. RPDO, TPDO, SDO server, SDO client and
+ * Heartbeat consumer objects can be bound to any interface with
+ * CO_setInterface(), default is interface 0. Other objects (NMT, Heartbeat
+ * producer, Emergency, SYNC, TIME, LSS, etc.) always use interface 0.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_CAN_IF_COUNT 1
+#endif
+/** @} */ /* CO_STACK_CONFIG_PROCESS */
+
+
 /**
  * @defgroup CO_STACK_CONFIG_DEBUG Debug messages
  * Messages from different parts of the stack.
@@ -49,6 +49,25 @@ extern "C" {
 #ifndef CO_CONFIG_GLOBAL_FLAG_OD_DYNAMIC
  #define CO_CONFIG_GLOBAL_FLAG_OD_DYNAMIC CO_CONFIG_FLAG_OD_DYNAMIC
 #endif
+#ifndef CO_CONFIG_DRIVER
+ #define CO_CONFIG_DRIVER (0)
+#endif
+#ifndef CO_CONFIG_DRIVER_TX_BATCH_SIZE
+ #define CO_CONFIG_DRIVER_TX_BATCH_SIZE 32
+#endif
+
+/** Maximum number of data bytes in CAN message, see CO_CONFIG_DRIVER_FD */
+#if ((CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD) || defined CO_DOXYGEN
+ #define CO_CAN_MAX_DATA_LEN 64
+#else
+ #define CO_CAN_MAX_DATA_LEN 8
+#endif
+
+/* Default locking macros, see CO_critical_sections. */
+#ifndef CO_LOCK_OD_GROUP
+ #define CO_LOCK_OD_GROUP(CAN_MODULE, group) CO_LOCK_OD(CAN_MODULE)
+ #define CO_UNLOCK_OD_GROUP(CAN_MODULE, group) CO_UNLOCK_OD(CAN_MODULE)
+#endif
 #ifdef CO_DEBUG_COMMON
  #if (CO_CONFIG_DEBUG) & CO_CONFIG_DEBUG_SDO_CLIENT
   #define CO_DEBUG_SDO_CLIENT(msg) CO_DEBUG_COMMON(msg)
@@ -231,7 +250,8 @@ static inline uint16_t CO_CANrxMsg_readIdent(void *rxMsg) {
  * See also CO_CANrxMsg_readIdent():
  *
  * @param rxMsg Pointer to received message
- * @return data length in bytes (0 to 8)
+ * @return data length in bytes (0 to 8). With @ref CO_CONFIG_DRIVER_FD data
+ * length in bytes (0 to 64), converted from CAN FD DLC code.
  */
 static inline uint8_t CO_CANrxMsg_readDLC(void *rxMsg) {
     return 0;
@@ -249,6 +269,23 @@ static inline uint8_t *CO_CANrxMsg_readData(void *rxMsg) {
     return NULL;
 }
 
+/**
+ * CANrx_callback() can read reception time from received CAN message
+ *
+ * Must be defined in the **CO_driver_target.h** file, if
+ * CO_CONFIG_SYNC_RX_TIMESTAMP is enabled. Timestamp should be captured by CAN
+ * hardware or as early as possible in the receive interrupt.
+ *
+ * See also CO_CANrxMsg_readIdent():
+ *
+ * @param rxMsg Pointer to received message
+ * @return Time of reception in [microseconds] from free running counter, which
+ * is allowed to overflow.
+ */
+static inline uint32_t CO_CANrxMsg_readTimestamp(void *rxMsg) {
+    return 0;
+}
+
 /**
  * Configuration object for CAN received message for specific \ref CO_obj
  * "CANopenNode Object".
@@ -269,6 +306,8 @@ typedef struct {
     void (*pCANrx_callback)(
         void *object, void *message); /**< Pointer to CANrx_callback()
                                          initialized in CO_CANrxBufferInit() */
+    uint16_t rxRingBatch; /**< Only with @ref CO_CONFIG_DRIVER_RX_RING: ring
+                             drain cycle, in which message was dispatched */
 } CO_CANrx_t;
 /** @} */
 
@@ -305,7 +344,8 @@ typedef struct {
 typedef struct {
     uint32_t ident;             /**< CAN identifier as aligned in CAN module */
     uint8_t DLC;                /**< Length of CAN message */
-    uint8_t data[8];            /**< 8 data bytes */
+    uint8_t data[8];            /**< 8 data bytes, CO_CAN_MAX_DATA_LEN with
+                                     CO_CONFIG_DRIVER_FD */
     volatile bool_t bufferFull; /**< True if previous message is still in the
                                      buffer */
     volatile bool_t syncFlag;   /**< Synchronous PDO messages has this flag set.
@@ -344,6 +384,33 @@ typedef struct {
     volatile uint16_t CANtxCount;      /**< Number of messages in transmit
             buffer, which are waiting to be copied to the CAN module */
     uint32_t errOld;                   /**< Previous state of CAN errors */
+    /** Only with @ref CO_CONFIG_DRIVER_RX_DISPATCH: index into rxArray for
+     * each standard 11-bit identifier, received with exact mask, 0xFFFF if
+     * unused. */
+    uint16_t rxDispatch[0x800];
+    /** Ascending list of rxArray indexes with non-exact mask */
+    uint16_t rxMasked[CO_CONFIG_DRIVER_RX_MASKED_COUNT];
+    uint16_t rxMaskedCount;            /**< Number of entries in rxMasked */
+    bool_t rxMaskedOverflow;           /**< True, if rxMasked is too small, so
+            receive interrupt must fall back to linear search of rxArray */
+    /** Only with @ref CO_CONFIG_DRIVER_RX_RING: received messages, each with
+     * index of matched rxArray entry */
+    CO_CANrxRingEntry_t rxRing[CO_CONFIG_DRIVER_RX_RING_SIZE];
+    volatile uint16_t rxRingHead;      /**< Written by receive interrupt */
+    volatile uint16_t rxRingTail;      /**< Written by CO_CANmodule_process() */
+    uint16_t rxRingBatch;              /**< Counter of ring drain cycles */
+    /** Only with @ref CO_CONFIG_DRIVER_TX_QUEUE: priority ordered queue of
+     * pending transmit buffers */
+    CO_CANtxQueue_t txQueue;
+    /** Only with @ref CO_CONFIG_DRIVER_TRAFFIC: bus load and per COB-ID
+     * frame counters, updated by the driver */
+    CO_CANtraffic_t traffic;
+    /** Only with @ref CO_CONFIG_STATS: number of lost received messages, see
+     * CO_CAN_COUNT_RX_OVERFLOW() */
+    uint32_t rxOverflowCount;
+    /** Only with @ref CO_CONFIG_STATS: number of transmit overflow events,
+     * see CO_CAN_COUNT_TX_OVERFLOW() */
+    uint32_t txOverflowCount;
 } CO_CANmodule_t;
 
 
@@ -384,6 +451,15 @@ typedef struct {
     /** Offset of next byte being updated by automatic storage, required with
      * @ref CO_storage_eeprom. */
     size_t offset;
+    /** Start of changed range for automatic storage, required with
+     * @ref CO_storage_eeprom and CO_CONFIG_STORAGE_AUTO_DIRTY. */
+    size_t dirtyStart;
+    /** End of changed range (exclusive) for automatic storage, required with
+     * @ref CO_storage_eeprom and CO_CONFIG_STORAGE_AUTO_DIRTY. */
+    size_t dirtyEnd;
+    /** Offset of next chunk being stored by deferred store command, required
+     * with @ref CO_storage_eeprom and CO_CONFIG_STORAGE_DEFERRED. */
+    size_t storeOffset;
     /** Additional target specific parameters, optional. */
     void *additionalParameters;
 } CO_storage_entry_t;
@@ -428,6 +504,24 @@ typedef struct {
  *   special care. Also when there are multiple threads accessing the OD (e.g.
  *   when using a RTOS), you should always lock the OD.
  *
+ * SDO server and SDO client access OD variables with
+ * CO_LOCK_OD_GROUP(CAN_MODULE, group) and CO_UNLOCK_OD_GROUP(CAN_MODULE, group)
+ * macros, where group is @ref OD_lockGroup_t from @ref OD_lockGroup(). By
+ * default they are the same as CO_LOCK_OD() and CO_UNLOCK_OD(). Target may
+ * define them for finer grained locking, for example with separate mutex for
+ * each group. Then only SDO access to PDO mappable variables and to
+ * parameters of SYNC, SRDO and PDO objects blocks the real-time thread, while
+ * long SDO transfers of other variables don't. Writing to these parameters
+ * reconfigures objects, processed by CO_process_SYNC(), CO_process_RPDO(),
+ * CO_process_TPDO() and CO_process_SRDO(), so it must be excluded with the
+ * real-time thread. If tasks from CO_process() run in different threads, see
+ * @ref CO_process_NMT(), mutex for group OD_LOCK_GRP_COMM should also protect
+ * the tasks, because writing to communication parameters reconfigures
+ * communication objects.
+ *
+ * Each CANopen object uses own CAN transmit buffer, so tasks never share
+ * transmit buffers. CO_LOCK_CAN_SEND() protects the common CAN module only.
+ *
  * #### Synchronization functions for CAN receive
  * After CAN message is received, it is pre-processed in CANrx_callback(), which
  * copies some data into appropriate object and at the end sets **new_message**
@@ -456,6 +550,10 @@ typedef struct {
 #define CO_LOCK_OD(CAN_MODULE)
 /** Unock critical section when accessing Object Dictionary */
 #define CO_UNLOCK_OD(CAN_MODULE)
+/** Lock critical section when SDO accesses OD variable from lock group */
+#define CO_LOCK_OD_GROUP(CAN_MODULE, group) CO_LOCK_OD(CAN_MODULE)
+/** Unlock critical section when SDO accesses OD variable from lock group */
+#define CO_UNLOCK_OD_GROUP(CAN_MODULE, group) CO_UNLOCK_OD(CAN_MODULE)
 
 /** Check if new message has arrived */
 #define CO_FLAG_READ(rxNew) ((rxNew) != NULL)
@@ -539,6 +637,30 @@ typedef enum {
 } CO_CAN_ERR_status_t;
 
 
+/**
+ * Count CAN overflow events for @ref CO_stats.
+ *
+ * Driver uses CO_CAN_COUNT_RX_OVERFLOW() at each place, where it sets
+ * CO_CAN_ERRRX_OVERFLOW, with number of lost messages, if known, or 1.
+ * Similar CO_CAN_COUNT_TX_OVERFLOW() is used with CO_CAN_ERRTX_OVERFLOW. So
+ * each event is counted, also while the bit in CANerrorStatus is still set.
+ *
+ * Counters are rxOverflowCount and txOverflowCount members of CO_CANmodule_t,
+ * if @ref CO_CONFIG_STATS is enabled, otherwise macros are empty. They are
+ * zero after CO_new() and are not cleared by CO_CANmodule_init(), so they are
+ * kept over communication reset.
+ */
+#if ((CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE) || defined CO_DOXYGEN
+#define CO_CAN_COUNT_RX_OVERFLOW(CANmodule, n) \
+    ((CANmodule)->rxOverflowCount += (uint32_t)(n))
+#define CO_CAN_COUNT_TX_OVERFLOW(CANmodule, n) \
+    ((CANmodule)->txOverflowCount += (uint32_t)(n))
+#else
+#define CO_CAN_COUNT_RX_OVERFLOW(CANmodule, n)
+#define CO_CAN_COUNT_TX_OVERFLOW(CANmodule, n)
+#endif
+
+
 /**
  * Return values of some CANopen functions. If function was executed
  * successfully it returns 0 otherwise it returns <0.
@@ -575,6 +697,48 @@ typedef enum {
 } CO_ReturnError_t;
 
 
+#if ((CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD) || defined CO_DOXYGEN
+/**
+ * Convert CAN FD data length code to data length in bytes.
+ *
+ * @param DLC Data length code from CAN FD frame (0 to 15).
+ *
+ * @return Data length in bytes (0 to 64).
+ */
+static inline uint8_t CO_CANfd_DLCtoLength(uint8_t DLC) {
+    static const uint8_t len[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8,
+                                    12, 16, 20, 24, 32, 48, 64};
+    return len[DLC & 0x0FU];
+}
+
+/**
+ * Convert data length in bytes to CAN FD data length code.
+ *
+ * @param length Data length in bytes (0 to 64).
+ *
+ * @return Data length code of the smallest frame, which fits length bytes.
+ */
+static inline uint8_t CO_CANfd_lengthToDLC(uint8_t length) {
+    if (length <= 8U) return length;
+    if (length <= 24U) return (uint8_t)(8U + (length - 5U) / 4U);
+    if (length <= 32U) return 13U;
+    if (length <= 48U) return 14U;
+    return 15U;
+}
+
+/**
+ * Round data length up to the valid CAN FD frame length.
+ *
+ * @param length Data length in bytes (0 to 64).
+ *
+ * @return Frame length in bytes: 0 to 8, 12, 16, 20, 24, 32, 48 or 64.
+ */
+static inline uint8_t CO_CANfd_roundLength(uint8_t length) {
+    return CO_CANfd_DLCtoLength(CO_CANfd_lengthToDLC(length));
+}
+#endif /* (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD */
+
+
 /**
  * Request CAN configuration (stopped) mode and *wait* until it is set.
  *
@@ -672,11 +836,12 @@ CO_ReturnError_t CO_CANrxBufferInit(CO_CANmodule_t *CANmodule,
  * @param index Index of the specific buffer in _txArray_.
  * @param ident 11-bit standard CAN Identifier.
  * @param rtr If true, 'Remote Transmit Request' messages will be transmitted.
- * @param noOfBytes Length of CAN message in bytes (0 to 8 bytes).
+ * @param noOfBytes Length of CAN message in bytes (0 to 8 bytes). With
+ * @ref CO_CONFIG_DRIVER_FD valid CAN FD frame length up to 64 bytes.
  * @param syncFlag This flag bit is used for synchronous TPDO messages. If it is
  * set, message will not be sent, if current time is outside synchronous window.
  *
- * @return Pointer to CAN transmit message buffer. 8 bytes data array inside
+ * @return Pointer to CAN transmit message buffer. Data array inside
  * buffer should be written, before CO_CANsend() function is called.
  * Zero is returned in case of wrong arguments.
  */
@@ -701,6 +866,44 @@ CO_CANtx_t *CO_CANtxBufferInit(CO_CANmodule_t *CANmodule,
 CO_ReturnError_t CO_CANsend(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer);
 
 
+#if ((CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_BATCH) || defined CO_DOXYGEN
+/**
+ * Batch of CAN messages, collected for single CO_CANsendBatch() call.
+ */
+typedef struct {
+    /** CAN module, to which all collected buffers belong */
+    CO_CANmodule_t *CANmodule;
+    /** Number of collected buffers */
+    uint16_t count;
+    /** Collected transmit buffers, in order of transmission */
+    CO_CANtx_t *buffers[CO_CONFIG_DRIVER_TX_BATCH_SIZE];
+} CO_CANtxBatch_t;
+
+
+/**
+ * Send multiple CAN messages.
+ *
+ * Function has the same effect as calling CO_CANsend() for each buffer, but
+ * CO_LOCK_CAN_SEND is taken only once. If CAN module has multiple transmit
+ * mailboxes, or operating system supports sending multiple messages with one
+ * call, driver may submit all messages at once. Order of messages must be
+ * preserved.
+ *
+ * @param CANmodule This object.
+ * @param buffers Array of pointers to transmit buffers, returned by
+ * CO_CANtxBufferInit(). Data bytes must be written in buffers.
+ * @param count Number of buffers.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_TX_OVERFLOW, if any of
+ * the messages overflowed. Overflow is also indicated by CO_CAN_ERRTX_OVERFLOW
+ * in CANerrorStatus, same as with CO_CANsend().
+ */
+CO_ReturnError_t CO_CANsendBatch(CO_CANmodule_t *CANmodule,
+                                 CO_CANtx_t *buffers[],
+                                 uint16_t count);
+#endif /* (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_BATCH */
+
+
 /**
  * Clear all synchronous TPDOs from CAN module transmit buffers.
  *
@@ -722,7 +925,9 @@ void CO_CANclearPendingSyncPDOs(CO_CANmodule_t *CANmodule);
  * Process can module - verify CAN errors
  *
  * Function must be called cyclically. It should calculate CANerrorStatus
- * bitfield for CAN errors defined in @ref CO_CAN_ERR_status_t.
+ * bitfield for CAN errors defined in @ref CO_CAN_ERR_status_t. If
+ * @ref CO_CONFIG_DRIVER_RX_RING is enabled, it also dispatches received
+ * messages from the ring to the CANrx_callback() functions.
  *
  * @param CANmodule This object.
  */
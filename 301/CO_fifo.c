@@ -29,12 +29,20 @@
 
 #include <string.h>
 #include <ctype.h>
-#include <stdlib.h>
 #include "crc16-ccitt.h"
 
-#if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_COMMANDS
+#if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_DATATYPES
+#if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_LIBC
 #include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
 #include <inttypes.h>
+#else
+#include <math.h>
+#endif
+#endif
+
+#if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_COMMANDS
 
 /* Non-graphical character for command delimiter */
 #define DELIM_COMMAND ((uint8_t)'\n')
@@ -85,90 +93,169 @@ size_t CO_fifo_write(CO_fifo_t *fifo,
                      size_t count,
                      uint16_t *crc)
 {
-    size_t i;
-    uint8_t *bufDest;
+    CO_fifo_span_t span[2];
+    size_t written = 0;
+    int i;
 
     if (fifo == NULL || fifo->buf == NULL || buf == NULL) {
         return 0;
     }
 
-    bufDest = &fifo->buf[fifo->writePtr];
-    for (i = count; i > 0; i--) {
-        size_t writePtrNext = fifo->writePtr + 1;
+    CO_fifo_getWriteSpans(fifo, span);
+    for (i = 0; i < 2 && written < count; i++) {
+        size_t n = count - written;
+        if (n > span[i].len) {
+            n = span[i].len;
+        }
+        memcpy(span[i].ptr, &buf[written], n);
+        written += n;
+    }
+    CO_fifo_commitWrite(fifo, written, crc);
 
-        /* is circular buffer full */
-        if (writePtrNext == fifo->readPtr ||
-            (writePtrNext == fifo->bufSize && fifo->readPtr == 0)) {
-            break;
+    return written;
+}
+
+
+/******************************************************************************/
+size_t CO_fifo_read(CO_fifo_t *fifo, uint8_t *buf, size_t count, bool_t *eof) {
+    CO_fifo_span_t span[2];
+    size_t read = 0;
+    bool_t delim = false;
+    int i;
+
+    if (eof != NULL) {
+        *eof = false;
+    }
+    if (fifo == NULL || buf == NULL || fifo->readPtr == fifo->writePtr) {
+        return 0;
+    }
+
+    CO_fifo_getReadSpans(fifo, span);
+    for (i = 0; i < 2 && read < count && !delim; i++) {
+        size_t n = count - read;
+        if (n > span[i].len) {
+            n = span[i].len;
         }
+#if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_COMMANDS
+        /* is delimiter? */
+        if (eof != NULL) {
+            const uint8_t *d = memchr(span[i].ptr, DELIM_COMMAND, n);
+            if (d != NULL) {
+                n = (size_t)(d - span[i].ptr) + 1;
+                *eof = true;
+                delim = true;
+            }
+        }
+#endif
+        memcpy(&buf[read], span[i].ptr, n);
+        read += n;
+    }
+    CO_fifo_advanceRead(fifo, read, NULL);
+
+    return read;
+}
 
-        *bufDest = *buf;
 
+/* Calculate crc of count bytes in two spans */
 #if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_CRC16_CCITT
-        if (crc != NULL) {
-            crc16_ccitt_single(crc, *buf);
-        }
+static void spansCrc(CO_fifo_span_t span[2], size_t count, uint16_t *crc) {
+    size_t n = count < span[0].len ? count : span[0].len;
+
+    *crc = crc16_ccitt(span[0].ptr, n, *crc);
+    if (count > n) {
+        *crc = crc16_ccitt(span[1].ptr, count - n, *crc);
+    }
+}
 #endif
 
-        /* increment variables */
-        if (writePtrNext == fifo->bufSize) {
-            fifo->writePtr = 0;
-            bufDest = &fifo->buf[0];
-        }
-        else {
-            fifo->writePtr++;
-            bufDest++;
-        }
-        buf++;
+
+/******************************************************************************/
+size_t CO_fifo_getWriteSpans(CO_fifo_t *fifo, CO_fifo_span_t span[2]) {
+    size_t space;
+
+    if (fifo == NULL || fifo->buf == NULL) {
+        span[0].len = span[1].len = 0;
+        return 0;
+    }
+
+    space = CO_fifo_getSpace(fifo);
+    span[0].ptr = &fifo->buf[fifo->writePtr];
+    span[0].len = fifo->bufSize - fifo->writePtr;
+    if (span[0].len > space) {
+        span[0].len = space;
     }
+    span[1].ptr = &fifo->buf[0];
+    span[1].len = space - span[0].len;
 
-    return count - i;
+    return space;
 }
 
 
 /******************************************************************************/
-size_t CO_fifo_read(CO_fifo_t *fifo, uint8_t *buf, size_t count, bool_t *eof) {
-    size_t i;
-    const uint8_t *bufSrc;
+void CO_fifo_commitWrite(CO_fifo_t *fifo, size_t count, uint16_t *crc) {
+    if (fifo == NULL || count == 0) {
+        return;
+    }
 
-    if (eof != NULL) {
-        *eof = false;
+#if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_CRC16_CCITT
+    if (crc != NULL) {
+        CO_fifo_span_t span[2];
+        CO_fifo_getWriteSpans(fifo, span);
+        spansCrc(span, count, crc);
     }
-    if (fifo == NULL || buf == NULL || fifo->readPtr == fifo->writePtr) {
+#else
+    (void)crc;
+#endif
+
+    fifo->writePtr += count;
+    if (fifo->writePtr >= fifo->bufSize) {
+        fifo->writePtr -= fifo->bufSize;
+    }
+}
+
+
+/******************************************************************************/
+size_t CO_fifo_getReadSpans(CO_fifo_t *fifo, CO_fifo_span_t span[2]) {
+    size_t occupied;
+
+    if (fifo == NULL || fifo->buf == NULL) {
+        span[0].len = span[1].len = 0;
         return 0;
     }
 
-    bufSrc = &fifo->buf[fifo->readPtr];
-    for (i = count; i > 0; ) {
-        const uint8_t c = *bufSrc;
+    occupied = CO_fifo_getOccupied(fifo);
+    span[0].ptr = &fifo->buf[fifo->readPtr];
+    span[0].len = fifo->bufSize - fifo->readPtr;
+    if (span[0].len > occupied) {
+        span[0].len = occupied;
+    }
+    span[1].ptr = &fifo->buf[0];
+    span[1].len = occupied - span[0].len;
 
-        /* is circular buffer empty */
-        if (fifo->readPtr == fifo->writePtr) {
-            break;
-        }
+    return occupied;
+}
 
-        *(buf++) = c;
 
-        /* increment variables */
-        if (++fifo->readPtr == fifo->bufSize) {
-            fifo->readPtr = 0;
-            bufSrc = &fifo->buf[0];
-        }
-        else {
-            bufSrc++;
-        }
-        i--;
+/******************************************************************************/
+void CO_fifo_advanceRead(CO_fifo_t *fifo, size_t count, uint16_t *crc) {
+    if (fifo == NULL || count == 0) {
+        return;
+    }
 
-#if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_COMMANDS
-        /* is delimiter? */
-        if (eof != NULL && c == DELIM_COMMAND) {
-            *eof = true;
-            break;
-        }
-#endif
+#if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_CRC16_CCITT
+    if (crc != NULL) {
+        CO_fifo_span_t span[2];
+        CO_fifo_getReadSpans(fifo, span);
+        spansCrc(span, count, crc);
     }
+#else
+    (void)crc;
+#endif
 
-    return count - i;
+    fifo->readPtr += count;
+    if (fifo->readPtr >= fifo->bufSize) {
+        fifo->readPtr -= fifo->bufSize;
+    }
 }
 
 
@@ -203,53 +290,59 @@ void CO_fifo_altFinish(CO_fifo_t *fifo, uint16_t *crc) {
         return;
     }
 
-    if (crc == NULL) {
-        fifo->readPtr = fifo->altReadPtr;
-    }
-    else {
-        const uint8_t *bufSrc = &fifo->buf[fifo->readPtr];
-        while (fifo->readPtr != fifo->altReadPtr) {
 #if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_CRC16_CCITT
-            crc16_ccitt_single(crc, *bufSrc);
+    if (crc != NULL) {
+        *crc = CO_fifo_altCrc(fifo, *crc);
+    }
+#else
+    (void)crc;
 #endif
-            /* increment variable */
-            if (++fifo->readPtr == fifo->bufSize) {
-                fifo->readPtr = 0;
-                bufSrc = &fifo->buf[0];
-            }
-            else {
-                bufSrc++;
-            }
-        }
+    fifo->readPtr = fifo->altReadPtr;
+}
+
+#if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_CRC16_CCITT
+uint16_t CO_fifo_altCrc(CO_fifo_t *fifo, uint16_t crc) {
+    if (fifo == NULL) {
+        return crc;
+    }
+
+    /* data may be split into two contiguous parts */
+    if (fifo->altReadPtr < fifo->readPtr) {
+        crc = crc16_ccitt(&fifo->buf[fifo->readPtr],
+                          fifo->bufSize - fifo->readPtr, crc);
+        crc = crc16_ccitt(&fifo->buf[0], fifo->altReadPtr, crc);
     }
+    else {
+        crc = crc16_ccitt(&fifo->buf[fifo->readPtr],
+                          fifo->altReadPtr - fifo->readPtr, crc);
+    }
+
+    return crc;
 }
+#endif
 
 size_t CO_fifo_altRead(CO_fifo_t *fifo, uint8_t *buf, size_t count) {
-    size_t i;
-    const uint8_t *bufSrc;
-
-    bufSrc = &fifo->buf[fifo->altReadPtr];
-    for (i = count; i > 0; i--) {
-        const uint8_t c = *bufSrc;
+    size_t occupied = CO_fifo_altGetOccupied(fifo);
+    size_t n;
 
-        /* is there no more data */
-        if (fifo->altReadPtr == fifo->writePtr) {
-            break;
-        }
+    if (count > occupied) {
+        count = occupied;
+    }
 
-        *(buf++) = c;
+    /* data may be split into two contiguous parts */
+    n = fifo->bufSize - fifo->altReadPtr;
+    if (n > count) {
+        n = count;
+    }
+    memcpy(buf, &fifo->buf[fifo->altReadPtr], n);
+    memcpy(&buf[n], &fifo->buf[0], count - n);
 
-        /* increment variables */
-        if (++fifo->altReadPtr == fifo->bufSize) {
-            fifo->altReadPtr = 0;
-            bufSrc = &fifo->buf[0];
-        }
-        else {
-            bufSrc++;
-        }
+    fifo->altReadPtr += count;
+    if (fifo->altReadPtr >= fifo->bufSize) {
+        fifo->altReadPtr -= fifo->bufSize;
     }
 
-    return count - i;
+    return count;
 }
 #endif /* (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ALT_READ */
 
@@ -482,12 +575,550 @@ static const uint8_t base64DecTable[] = {
    255, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
     41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51,255,255,255,255,255};
 
+
+/******************************************************************************/
+/* Formatters and parsers of numbers for datatype transform functions. Output
+ * of formatters is the same as from sprintf() with formats "%u", "%d",
+ * "0x%0*X" and "%g". Parsers accept the same syntax as strtoul() and strtod():
+ * decimal, hexadecimal with "0x" prefix or octal with leading "0". Whole
+ * string must be a valid number. */
+static const char hexDigits[] = "0123456789ABCDEF";
+
+/* Value of digit in given base or 0xFF, if character is not valid */
+static uint8_t digitValue(char c, uint8_t base) {
+    uint8_t v;
+    if (c >= '0' && c <= '9') v = (uint8_t)(c - '0');
+    else if (c >= 'a' && c <= 'f') v = (uint8_t)(c - 'a' + 10);
+    else if (c >= 'A' && c <= 'F') v = (uint8_t)(c - 'A' + 10);
+    else return 0xFF;
+    return v < base ? v : 0xFF;
+}
+
+#if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_LIBC
+static size_t fmtU64(char *buf, uint64_t n) {
+    return (size_t)sprintf(buf, "%"PRIu64, n);
+}
+
+static size_t fmtI64(char *buf, int64_t n) {
+    return (size_t)sprintf(buf, "%"PRId64, n);
+}
+
+static size_t fmtHex(char *buf, uint64_t n, uint8_t digits) {
+    return (size_t)sprintf(buf, "0x%0*"PRIX64, (int)digits, n);
+}
+
+static size_t fmtR64(char *buf, float64_t v) {
+    return (size_t)sprintf(buf, "%g", v);
+}
+
+static bool_t parseU64(const char *s, uint64_t max, uint64_t *n) {
+    char *sRet;
+    errno = 0;
+    *n = strtoull(s, &sRet, 0);
+    return *sRet == '\0' && errno == 0 && *s != '-' && *n <= max;
+}
+
+static bool_t parseI64(const char *s, int64_t min, int64_t max, int64_t *n) {
+    char *sRet;
+    errno = 0;
+    *n = strtoll(s, &sRet, 0);
+    return *sRet == '\0' && errno == 0 && *n >= min && *n <= max;
+}
+
+static bool_t parseR64(const char *s, float64_t *v) {
+    char *sRet;
+    *v = strtod(s, &sRet);
+    return *sRet == '\0';
+}
+
+static bool_t parseR32(const char *s, float32_t *v) {
+    char *sRet;
+    *v = strtof(s, &sRet);
+    return *sRet == '\0';
+}
+
+#else /* (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_LIBC */
+static const char digitPairs[] =
+    "00010203040506070809" "10111213141516171819"
+    "20212223242526272829" "30313233343536373839"
+    "40414243444546474849" "50515253545556575859"
+    "60616263646566676869" "70717273747576777879"
+    "80818283848586878889" "90919293949596979899";
+
+/* Exact powers of ten, 10^0 ... 10^22 */
+static const float64_t pow10Exact[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/* 2^64, scaling with it is exact */
+#define POW2_64 18446744073709551616.0
+
+/* Binary powers of ten, 10^(2^i) */
+static const float64_t pow10Bin[] = {
+    1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256};
+
+/* Write exactly 'digits' decimal digits of n (digits is even or 1), without
+ * zero termination */
+static void fmtDigits(char *buf, uint32_t n, uint8_t digits) {
+    while (digits >= 2) {
+        uint32_t q = n / 100;
+        const char *d = &digitPairs[(n - q * 100) * 2];
+        digits -= 2;
+        buf[digits] = d[0];
+        buf[digits + 1] = d[1];
+        n = q;
+    }
+    if (digits == 1) {
+        buf[0] = (char)('0' + n);
+    }
+}
+
+static size_t fmtU32(char *buf, uint32_t n) {
+    uint8_t len = 1;
+    for (uint32_t p = 10; len < 10 && n >= p; p *= 10) {
+        len++;
+    }
+    if ((len & 1) != 0) {
+        /* odd number of digits: first digit separately, then pairs */
+        uint32_t p = 1;
+        for (uint8_t i = 1; i < len; i++) {
+            p *= 10;
+        }
+        buf[0] = (char)('0' + n / p);
+        fmtDigits(&buf[1], n % p, len - 1);
+    }
+    else {
+        fmtDigits(buf, n, len);
+    }
+    buf[len] = 0;
+    return len;
+}
+
+static size_t fmtU64(char *buf, uint64_t n) {
+    if (n <= UINT32_MAX) {
+        return fmtU32(buf, (uint32_t)n);
+    }
+    /* 64-bit division only for upper digits, lower 8 digits are 32-bit */
+    size_t len = fmtU64(buf, n / 100000000U);
+    fmtDigits(&buf[len], (uint32_t)(n % 100000000U), 8);
+    len += 8;
+    buf[len] = 0;
+    return len;
+}
+
+static size_t fmtI64(char *buf, int64_t n) {
+    if (n < 0) {
+        buf[0] = '-';
+        return fmtU64(&buf[1], (uint64_t)0 - (uint64_t)n) + 1;
+    }
+    return fmtU64(buf, (uint64_t)n);
+}
+
+static size_t fmtHex(char *buf, uint64_t n, uint8_t digits) {
+    buf[0] = '0';
+    buf[1] = 'x';
+    for (uint8_t i = digits; i > 0; i--) {
+        buf[1 + i] = hexDigits[n & 0x0F];
+        n >>= 4;
+    }
+    buf[2 + digits] = 0;
+    return 2 + (size_t)digits;
+}
+
+/* Exact product: a * b = return value + *err. Numbers are split into halves,
+ * so products of halves are exact (Dekker). */
+static float64_t twoProd(float64_t a, float64_t b, float64_t *err) {
+    float64_t p = a * b;
+    float64_t c = 134217729.0 * a;
+    float64_t ah = c - (c - a);
+    float64_t al = a - ah;
+    c = 134217729.0 * b;
+    float64_t bh = c - (c - b);
+    float64_t bl = b - bh;
+    *err = ((ah * bh - p) + ah * bl + al * bh) + al * bl;
+    return p;
+}
+
+/* Round v * 10^k to integer, ties to even. Result must fit into uint32_t.
+ * Decision about rounding is exact for k from -22 to 22. */
+static uint32_t scaleRound(float64_t v, int16_t k) {
+    float64_t p;
+    float64_t err = 0;
+    uint32_t m;
+
+    if (k >= 0 && k <= 22) {
+        p = twoProd(v, pow10Exact[k], &err);
+    }
+    else if (k < 0 && k >= -22) {
+        /* sign of the remainder v - p * 10^-k */
+        float64_t e, h;
+        p = v / pow10Exact[-k];
+        h = twoProd(p, pow10Exact[-k], &e);
+        err = (v - h) - e;
+    }
+    else {
+        uint16_t kAbs = (uint16_t)(k < 0 ? -k : k);
+        p = v;
+        for (uint8_t i = 0; kAbs != 0; i++, kAbs >>= 1) {
+            if ((kAbs & 1) != 0) {
+                if (k < 0) p /= pow10Bin[i];
+                else p *= pow10Bin[i];
+            }
+        }
+    }
+
+    m = (uint32_t)p;
+    p -= m;
+    if (p > 0.5 || (p == 0.5 && (err > 0 || (err == 0 && (m & 1) != 0)))) {
+        m++;
+    }
+    return m;
+}
+
+/* The same as "%g": six significant digits, trailing zeros removed, fixed form
+ * for decimal exponents from -4 to 5, exponential form otherwise. */
+static size_t fmtR64(char *buf, float64_t v) {
+    uint64_t bits;
+    size_t len = 0;
+    char d[7];
+    int16_t exp10 = 0;
+    uint8_t nd;
+    uint32_t m;
+    float64_t t;
+
+    memcpy(&bits, &v, sizeof(bits));
+    if ((bits >> 63) != 0) {
+        buf[len++] = '-';
+        v = -v;
+    }
+    if (((bits >> 52) & 0x7FF) == 0x7FF) {
+        memcpy(&buf[len], ((bits & 0xFFFFFFFFFFFFFULL) != 0) ? "nan" : "inf", 4);
+        return len + 3;
+    }
+    if (v == 0) {
+        buf[len++] = '0';
+        buf[len] = 0;
+        return len;
+    }
+
+    /* estimate decimal exponent, it may be off by one */
+    t = v;
+    if (t >= 10) {
+        for (int8_t i = 8; i >= 0; i--) {
+            if (t >= pow10Bin[i]) {
+                t /= pow10Bin[i];
+                exp10 += (int16_t)1 << i;
+            }
+        }
+    }
+    else if (t < 1) {
+        for (int8_t i = 8; i >= 0; i--) {
+            if (t * pow10Bin[i] < 1) {
+                t *= pow10Bin[i];
+                exp10 -= (int16_t)1 << i;
+            }
+        }
+        exp10--;
+    }
+
+    /* round to six significant digits */
+    m = scaleRound(v, 5 - exp10);
+    if (m < 100000) {
+        exp10--;
+        m = scaleRound(v, 5 - exp10);
+    }
+    if (m >= 1000000) {
+        exp10++;
+        m = scaleRound(v, 5 - exp10);
+    }
+    fmtDigits(d, m, 6);
+    for (nd = 6; nd > 1 && d[nd - 1] == '0'; nd--) { }
+
+    if (exp10 < -4 || exp10 >= 6) {
+        buf[len++] = d[0];
+        if (nd > 1) {
+            buf[len++] = '.';
+            memcpy(&buf[len], &d[1], nd - 1U);
+            len += nd - 1U;
+        }
+        buf[len++] = 'e';
+        buf[len++] = exp10 < 0 ? '-' : '+';
+        if (exp10 < 0) {
+            exp10 = -exp10;
+        }
+        if (exp10 >= 100) {
+            buf[len++] = (char)('0' + exp10 / 100);
+            exp10 %= 100;
+        }
+        fmtDigits(&buf[len], (uint32_t)exp10, 2);
+        len += 2;
+    }
+    else if (exp10 >= 0) {
+        uint8_t nInt = (uint8_t)exp10 + 1U;
+        memcpy(&buf[len], d, nInt);
+        len += nInt;
+        if (nd > nInt) {
+            buf[len++] = '.';
+            memcpy(&buf[len], &d[nInt], nd - nInt);
+            len += nd - nInt;
+        }
+    }
+    else {
+        buf[len++] = '0';
+        buf[len++] = '.';
+        for (int16_t i = exp10 + 1; i < 0; i++) {
+            buf[len++] = '0';
+        }
+        memcpy(&buf[len], d, nd);
+        len += nd;
+    }
+    buf[len] = 0;
+    return len;
+}
+
+/* Parse magnitude of the integer, base is determined from prefix */
+static bool_t parseMagnitude(const char *s, uint64_t *n) {
+    uint8_t base = 10;
+    uint64_t val = 0;
+
+    if (s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+        base = 16;
+        s += 2;
+    }
+    else if (s[0] == '0') {
+        base = 8;
+    }
+    if (*s == '\0') {
+        return false;
+    }
+    for (; *s != '\0'; s++) {
+        uint8_t v = digitValue(*s, base);
+        if (v == 0xFF || val > (UINT64_MAX - v) / base) {
+            return false;
+        }
+        val = val * base + v;
+    }
+    *n = val;
+    return true;
+}
+
+static bool_t parseU64(const char *s, uint64_t max, uint64_t *n) {
+    if (*s == '+') {
+        s++;
+    }
+    return parseMagnitude(s, n) && *n <= max;
+}
+
+static bool_t parseI64(const char *s, int64_t min, int64_t max, int64_t *n) {
+    bool_t neg = false;
+    uint64_t u;
+
+    if (*s == '+' || *s == '-') {
+        neg = *s == '-';
+        s++;
+    }
+    if (!parseMagnitude(s, &u)) {
+        return false;
+    }
+    if (neg) {
+        if (u > (uint64_t)0 - (uint64_t)min) return false;
+        *n = (int64_t)((uint64_t)0 - u);
+    }
+    else {
+        if (u > (uint64_t)max) return false;
+        *n = (int64_t)u;
+    }
+    return true;
+}
+
+/* Compare string with lower case word, ignore case */
+static bool_t strEqualNoCase(const char *s, const char *word) {
+    for (; *word != '\0'; s++, word++) {
+        if (tolower((int)(unsigned char)*s) != *word) {
+            return false;
+        }
+    }
+    return *s == '\0';
+}
+
+/* Multiply or divide (*h + *l) by exact power of ten 10^k, k <= 22 */
+static void scaleExtended(float64_t *h, float64_t *l, uint8_t k, bool_t div) {
+    float64_t e, p, r, sum;
+    const float64_t pow10 = pow10Exact[k];
+
+    if (div) {
+        float64_t q = *h / pow10;
+        p = twoProd(q, pow10, &e);
+        r = (((*h - p) - e) + *l) / pow10;
+        p = q;
+    }
+    else if (*h > 1e250) {
+        /* avoid overflow inside twoProd(), calculate with value scaled by
+         * 2^-64, scaling is exact. Result is infinite, if it overflows. */
+        p = twoProd(*h / POW2_64, pow10, &e);
+        r = e + *l / POW2_64 * pow10;
+        sum = p + r;
+        *l = (r - (sum - p)) * POW2_64;
+        *h = sum * POW2_64;
+        if (isinf(p) || isinf(*h)) {
+            *h = INFINITY;
+            *l = 0;
+        }
+        return;
+    }
+    else {
+        p = twoProd(*h, pow10, &e);
+        r = e + *l * pow10;
+    }
+    sum = p + r;
+    *l = r - (sum - p);
+    *h = sum;
+}
+
+/* Decimal floating point number. Up to 19 significant digits are used. Result
+ * is correctly rounded, except for rare cases very close to the half way and
+ * for subnormal numbers. Too large numbers are infinite, as with strtod().
+ * *remSign is 1, if absolute value of the number is larger than |*v|, -1 if it
+ * is smaller and 0 if equal or unknown. */
+static bool_t parseReal(const char *s, float64_t *v, int8_t *remSign) {
+    bool_t neg = false;
+    bool_t digits = false;
+    bool_t dropped = false;
+    uint64_t mant = 0;
+    int32_t exp10 = 0;
+    float64_t val;
+
+    if (*s == '+' || *s == '-') {
+        neg = *s == '-';
+        s++;
+    }
+    *remSign = 0;
+    if (strEqualNoCase(s, "inf") || strEqualNoCase(s, "infinity")) {
+        *v = neg ? -INFINITY : INFINITY;
+        return true;
+    }
+    if (strEqualNoCase(s, "nan")) {
+        *v = neg ? -NAN : NAN;
+        return true;
+    }
+
+    for (; *s >= '0' && *s <= '9'; s++) {
+        digits = true;
+        if (mant < 1000000000000000000ULL) mant = mant * 10 + (uint8_t)(*s - '0');
+        else {
+            exp10++;
+            if (*s != '0') dropped = true;
+        }
+    }
+    if (*s == '.') {
+        for (s++; *s >= '0' && *s <= '9'; s++) {
+            digits = true;
+            if (mant < 1000000000000000000ULL) {
+                mant = mant * 10 + (uint8_t)(*s - '0');
+                exp10--;
+            }
+            else if (*s != '0') {
+                dropped = true;
+            }
+        }
+    }
+    if (!digits) {
+        return false;
+    }
+    if (*s == 'e' || *s == 'E') {
+        bool_t expNeg = false;
+        int32_t e = 0;
+        s++;
+        if (*s == '+' || *s == '-') {
+            expNeg = *s == '-';
+            s++;
+        }
+        if (*s < '0' || *s > '9') {
+            return false;
+        }
+        for (; *s >= '0' && *s <= '9'; s++) {
+            if (e < 10000) e = e * 10 + (*s - '0');
+        }
+        exp10 += expNeg ? -e : e;
+    }
+    if (*s != '\0') {
+        return false;
+    }
+
+    /* mantissa as sum of two doubles, then scaled in steps by exact powers
+     * of ten with extended precision and rounded once at the end */
+    val = (float64_t)mant;
+    if (mant != 0) {
+        float64_t low = (float64_t)(int64_t)(mant - (uint64_t)val);
+        bool_t div = exp10 < 0;
+        uint8_t scaledUp = 0;
+        if (div) exp10 = -exp10;
+        if (exp10 > 400) exp10 = 400;
+        while (exp10 > 0 && !isinf(val)) {
+            uint8_t k = exp10 > 22 ? 22 : (uint8_t)exp10;
+            if (div && val < 1e-250) {
+                /* keep low part away from underflow */
+                val *= POW2_64;
+                low *= POW2_64;
+                scaledUp++;
+            }
+            scaleExtended(&val, &low, k, div);
+            exp10 -= k;
+        }
+        float64_t sum = val + low;
+        float64_t rem = low - (sum - val);
+        if (isinf(sum) || scaledUp > 0) {
+            rem = 0;
+        }
+        else if (dropped && rem <= 0) {
+            /* dropped digits make the number larger by unknown amount */
+            rem = rem < 0 ? 0 : 1;
+        }
+        *remSign = rem > 0 ? 1 : rem < 0 ? -1 : 0;
+        val = sum;
+        for (; scaledUp > 0; scaledUp--) {
+            val /= POW2_64;
+        }
+    }
+    *v = neg ? -val : val;
+    return true;
+}
+
+static bool_t parseR64(const char *s, float64_t *v) {
+    int8_t remSign;
+    return parseReal(s, v, &remSign);
+}
+
+/* Rounding float64_t to float32_t may round twice. If double value is exactly
+ * half way between two floats, then the part lost by the first rounding
+ * decides the direction. */
+static bool_t parseR32(const char *s, float32_t *v) {
+    float64_t f64;
+    int8_t remSign;
+    uint64_t bits;
+
+    if (!parseReal(s, &f64, &remSign)) {
+        return false;
+    }
+    memcpy(&bits, &f64, sizeof(bits));
+    if (remSign != 0 && (bits & 0x1FFFFFFFULL) == 0x10000000ULL) {
+        /* move absolute value of double for one ulp towards the exact value,
+         * sign is in the highest bit */
+        if (remSign > 0) bits++;
+        else bits--;
+        memcpy(&f64, &bits, sizeof(bits));
+    }
+    *v = (float32_t)f64;
+    return true;
+}
+#endif /* (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_LIBC */
+
 size_t CO_fifo_readU82a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
     uint8_t n=0;
 
     if (fifo != NULL && count >= 6 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, &n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRIu8, n);
+        return fmtU64(buf, n);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -499,7 +1130,7 @@ size_t CO_fifo_readU162a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 8 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRIu16, CO_SWAP_16(n));
+        return fmtU64(buf, CO_SWAP_16(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -511,7 +1142,7 @@ size_t CO_fifo_readU322a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 12 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRIu32, CO_SWAP_32(n));
+        return fmtU64(buf, CO_SWAP_32(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -523,7 +1154,7 @@ size_t CO_fifo_readU642a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 20 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRIu64, CO_SWAP_64(n));
+        return fmtU64(buf, CO_SWAP_64(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -535,7 +1166,7 @@ size_t CO_fifo_readX82a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 6 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "0x%02"PRIX8, n);
+        return fmtHex(buf, n, 2);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -547,7 +1178,7 @@ size_t CO_fifo_readX162a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 8 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "0x%04"PRIX16, CO_SWAP_16(n));
+        return fmtHex(buf, CO_SWAP_16(n), 4);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -559,7 +1190,7 @@ size_t CO_fifo_readX322a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 12 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "0x%08"PRIX32, CO_SWAP_32(n));
+        return fmtHex(buf, CO_SWAP_32(n), 8);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -571,7 +1202,7 @@ size_t CO_fifo_readX642a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 20 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "0x%016"PRIX64, CO_SWAP_64(n));
+        return fmtHex(buf, CO_SWAP_64(n), 16);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -583,7 +1214,7 @@ size_t CO_fifo_readI82a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 6 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRId8, n);
+        return fmtI64(buf, n);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -595,7 +1226,7 @@ size_t CO_fifo_readI162a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 8 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRId16, CO_SWAP_16(n));
+        return fmtI64(buf, CO_SWAP_16(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -607,7 +1238,7 @@ size_t CO_fifo_readI322a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 13 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRId32, CO_SWAP_32(n));
+        return fmtI64(buf, CO_SWAP_32(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -619,7 +1250,7 @@ size_t CO_fifo_readI642a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 23 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRId64, CO_SWAP_64(n));
+        return fmtI64(buf, CO_SWAP_64(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -631,7 +1262,7 @@ size_t CO_fifo_readR322a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 20 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%g", (double)CO_SWAP_32(n));
+        return fmtR64(buf, (float64_t)CO_SWAP_32(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -643,7 +1274,7 @@ size_t CO_fifo_readR642a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 30 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%g", (double)CO_SWAP_64(n));
+        return fmtR64(buf, CO_SWAP_64(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -660,7 +1291,10 @@ size_t CO_fifo_readHex2a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
         if (!fifo->started) {
             uint8_t c;
             if(CO_fifo_getc(fifo, &c)) {
-                len = sprintf(&buf[0], "%02"PRIX8, c);
+                buf[0] = hexDigits[c >> 4];
+                buf[1] = hexDigits[c & 0x0F];
+                buf[2] = 0;
+                len = 2;
                 fifo->started = true;
             }
         }
@@ -670,7 +1304,10 @@ size_t CO_fifo_readHex2a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
             if(!CO_fifo_getc(fifo, &c)) {
                 break;
             }
-            len += sprintf(&buf[len], " %02"PRIX8, c);
+            buf[len++] = ' ';
+            buf[len++] = hexDigits[c >> 4];
+            buf[len++] = hexDigits[c & 0x0F];
+            buf[len] = 0;
         }
     }
 
@@ -786,11 +1423,10 @@ size_t CO_fifo_cpyTok2U8(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        uint32_t u32 = strtoul(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0') || u32 > UINT8_MAX) st |= CO_fifo_st_errVal;
+        uint64_t u64;
+        if (!parseU64(buf, UINT8_MAX, &u64)) st |= CO_fifo_st_errVal;
         else {
-            uint8_t num = (uint8_t) u32;
+            uint8_t num = (uint8_t) u64;
             nWr = CO_fifo_write(dest, &num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -808,11 +1444,10 @@ size_t CO_fifo_cpyTok2U16(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        uint32_t u32 = strtoul(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0') || u32 > UINT16_MAX) st |= CO_fifo_st_errVal;
+        uint64_t u64;
+        if (!parseU64(buf, UINT16_MAX, &u64)) st |= CO_fifo_st_errVal;
         else {
-            uint16_t num = CO_SWAP_16((uint16_t) u32);
+            uint16_t num = CO_SWAP_16((uint16_t) u64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -830,11 +1465,10 @@ size_t CO_fifo_cpyTok2U32(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        uint32_t u32 = strtoul(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0')) st |= CO_fifo_st_errVal;
+        uint64_t u64;
+        if (!parseU64(buf, UINT32_MAX, &u64)) st |= CO_fifo_st_errVal;
         else {
-            uint32_t num = CO_SWAP_32(u32);
+            uint32_t num = CO_SWAP_32((uint32_t) u64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -852,9 +1486,8 @@ size_t CO_fifo_cpyTok2U64(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        uint64_t u64 = strtoull(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0')) st |= CO_fifo_st_errVal;
+        uint64_t u64;
+        if (!parseU64(buf, UINT64_MAX, &u64)) st |= CO_fifo_st_errVal;
         else {
             uint64_t num = CO_SWAP_64(u64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
@@ -874,12 +1507,10 @@ size_t CO_fifo_cpyTok2I8(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        int32_t i32 = strtol(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0') || i32 < INT8_MIN || i32 > INT8_MAX) {
-            st |= CO_fifo_st_errVal;
-        } else {
-            int8_t num = (int8_t) i32;
+        int64_t i64;
+        if (!parseI64(buf, INT8_MIN, INT8_MAX, &i64)) st |= CO_fifo_st_errVal;
+        else {
+            int8_t num = (int8_t) i64;
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -897,12 +1528,10 @@ size_t CO_fifo_cpyTok2I16(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        int32_t i32 = strtol(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0') || i32 < INT16_MIN || i32 > INT16_MAX) {
-            st |= CO_fifo_st_errVal;
-        } else {
-            int16_t num = CO_SWAP_16((int16_t) i32);
+        int64_t i64;
+        if (!parseI64(buf, INT16_MIN, INT16_MAX, &i64)) st |= CO_fifo_st_errVal;
+        else {
+            int16_t num = CO_SWAP_16((int16_t) i64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -920,11 +1549,10 @@ size_t CO_fifo_cpyTok2I32(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        int32_t i32 = strtol(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0')) st |= CO_fifo_st_errVal;
+        int64_t i64;
+        if (!parseI64(buf, INT32_MIN, INT32_MAX, &i64)) st |= CO_fifo_st_errVal;
         else {
-            int32_t num = CO_SWAP_32(i32);
+            int32_t num = CO_SWAP_32((int32_t) i64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -942,9 +1570,8 @@ size_t CO_fifo_cpyTok2I64(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        int64_t i64 = strtoll(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0')) st |= CO_fifo_st_errVal;
+        int64_t i64;
+        if (!parseI64(buf, INT64_MIN, INT64_MAX, &i64)) st |= CO_fifo_st_errVal;
         else {
             int64_t num = CO_SWAP_64(i64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
@@ -964,9 +1591,8 @@ size_t CO_fifo_cpyTok2R32(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        float32_t f32 = strtof(buf, &sRet);
-        if (sRet != strchr(buf, '\0')) st |= CO_fifo_st_errVal;
+        float32_t f32;
+        if (!parseR32(buf, &f32)) st |= CO_fifo_st_errVal;
         else {
             float32_t num = CO_SWAP_32(f32);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
@@ -986,9 +1612,8 @@ size_t CO_fifo_cpyTok2R64(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        float64_t f64 = strtof(buf, &sRet);
-        if (sRet != strchr(buf, '\0')) st |= CO_fifo_st_errVal;
+        float64_t f64;
+        if (!parseR64(buf, &f64)) st |= CO_fifo_st_errVal;
         else {
             float64_t num = CO_SWAP_64(f64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
@@ -1056,11 +1681,9 @@ size_t CO_fifo_cpyTok2Hex(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
             }
             else {
                 /* write the byte */
-                uint8_t s[3];
-                int32_t num;
-                s[0] = firstChar; s[1] = c; s[2] = 0;
-                num = strtol((char *)&s[0], NULL, 16);
-                CO_fifo_putc(dest, (uint8_t) num);
+                uint8_t num = (uint8_t)(digitValue((char)firstChar, 16) << 4)
+                              | digitValue((char)c, 16);
+                CO_fifo_putc(dest, num);
                 destSpace--;
                 step = 0;
             }
@@ -1076,11 +1699,7 @@ size_t CO_fifo_cpyTok2Hex(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
             /* this is space or delimiter */
             if (step == 1) {
                 /* write the byte */
-                uint8_t s[2];
-                int32_t num;
-                s[0] = firstChar; s[1] = 0;
-                num = strtol((char *)&s[0], NULL, 16);
-                CO_fifo_putc(dest, (uint8_t) num);
+                CO_fifo_putc(dest, digitValue((char)firstChar, 16));
                 destSpace--;
                 step = 0;
             }
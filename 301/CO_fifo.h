@@ -52,6 +52,11 @@ extern "C" {
  * It can be used as general purpose FIFO circular buffer for any data. Data can
  * be written by CO_fifo_write() and read by CO_fifo_read() functions.
  *
+ * For direct access without intermediate copy, contiguous regions of free
+ * space or data are available with CO_fifo_getWriteSpans() and
+ * CO_fifo_getReadSpans(). After direct access, CO_fifo_commitWrite() or
+ * CO_fifo_advanceRead() must be called.
+ *
  * Buffer has additional functions for usage with CiA309-3 standard. It acts as
  * circular buffer for storing ascii commands and fetching tokens from them.
  */
@@ -82,6 +87,17 @@ typedef struct {
 } CO_fifo_t;
 
 
+/**
+ * Contiguous region inside fifo buffer, see CO_fifo_getWriteSpans()
+ */
+typedef struct {
+    /** Pointer to the first byte of the region */
+    uint8_t *ptr;
+    /** Length of the region in bytes, may be zero */
+    size_t len;
+} CO_fifo_span_t;
+
+
 
 /**
  * Initialize fifo object
@@ -267,6 +283,58 @@ size_t CO_fifo_write(CO_fifo_t *fifo,
 size_t CO_fifo_read(CO_fifo_t *fifo, uint8_t *buf, size_t count, bool_t *eof);
 
 
+/**
+ * Get free space in CO_fifo_t object as up to two contiguous regions.
+ *
+ * Application may write data directly into span[0] and then into span[1] and
+ * then call CO_fifo_commitWrite(). Fifo must not be written otherwise meantime.
+ *
+ * @param fifo This object
+ * @param [out] span Array of two regions, second is used, if free space wraps
+ * around the end of the buffer.
+ *
+ * @return total free space, sum of both span lengths.
+ */
+size_t CO_fifo_getWriteSpans(CO_fifo_t *fifo, CO_fifo_span_t span[2]);
+
+
+/**
+ * Commit data written directly into regions from CO_fifo_getWriteSpans().
+ *
+ * @param fifo This object
+ * @param count Number of bytes written, not more than free space.
+ * @param [in,out] crc Externally defined variable for CRC checksum, ignored if
+ * NULL
+ */
+void CO_fifo_commitWrite(CO_fifo_t *fifo, size_t count, uint16_t *crc);
+
+
+/**
+ * Get data in CO_fifo_t object as up to two contiguous regions.
+ *
+ * Application may read data directly from span[0] and then from span[1] and
+ * then call CO_fifo_advanceRead(). Data must not be modified.
+ *
+ * @param fifo This object
+ * @param [out] span Array of two regions, second is used, if data wrap around
+ * the end of the buffer.
+ *
+ * @return total size of data, sum of both span lengths.
+ */
+size_t CO_fifo_getReadSpans(CO_fifo_t *fifo, CO_fifo_span_t span[2]);
+
+
+/**
+ * Remove data read directly from regions from CO_fifo_getReadSpans().
+ *
+ * @param fifo This object
+ * @param count Number of bytes to remove, not more than occupied.
+ * @param [in,out] crc Externally defined variable for CRC checksum of removed
+ * data, ignored if NULL
+ */
+void CO_fifo_advanceRead(CO_fifo_t *fifo, size_t count, uint16_t *crc);
+
+
 #if ((CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ALT_READ) || defined CO_DOXYGEN
 /**
  * Initializes alternate read with #CO_fifo_altRead
@@ -289,6 +357,22 @@ size_t CO_fifo_altBegin(CO_fifo_t *fifo, size_t offset);
 void CO_fifo_altFinish(CO_fifo_t *fifo, uint16_t *crc);
 
 
+#if ((CO_CONFIG_FIFO) & CO_CONFIG_FIFO_CRC16_CCITT) || defined CO_DOXYGEN
+/**
+ * Calculate crc checksum of data, read by #CO_fifo_altRead
+ *
+ * Data between original and alternate read pointer remain in the buffer. Result
+ * is the same as crc calculated by CO_fifo_altFinish().
+ *
+ * @param fifo This object
+ * @param crc Initial value of crc
+ *
+ * @return Calculated CRC.
+ */
+uint16_t CO_fifo_altCrc(CO_fifo_t *fifo, uint16_t crc);
+#endif
+
+
 /**
  * Get alternate size of remaining data, see #CO_fifo_altRead
  *
@@ -513,9 +597,10 @@ size_t CO_fifo_cpyTok2I16(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status);
 size_t CO_fifo_cpyTok2I32(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status);
 /** Copy ascii string to int64_t variable, see CO_fifo_cpyTok2U8 */
 size_t CO_fifo_cpyTok2I64(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status);
-/** Copy ascii string to float32_t variable, see CO_fifo_cpyTok2U8 */
+/** Copy ascii string to float32_t variable, see CO_fifo_cpyTok2U8. Too large
+ * value is copied as infinity with the same sign, as with strtof(). */
 size_t CO_fifo_cpyTok2R32(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status);
-/** Copy ascii string to float64_t variable, see CO_fifo_cpyTok2U8 */
+/** Copy ascii string to float64_t variable, see CO_fifo_cpyTok2R32 */
 size_t CO_fifo_cpyTok2R64(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status);
 /** Copy bytes written as two hex digits into to data. Bytes may be space
  * separated. See CO_fifo_cpyTok2U8 for parameters. */
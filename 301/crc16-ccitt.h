@@ -33,6 +33,9 @@
 #ifndef CO_CONFIG_CRC16
 #define CO_CONFIG_CRC16 (0)
 #endif
+#ifndef CO_CONFIG_CRC16_HW_MIN_LENGTH
+#define CO_CONFIG_CRC16_HW_MIN_LENGTH 16
+#endif
 
 #if ((CO_CONFIG_CRC16) & CO_CONFIG_CRC16_ENABLE) || defined CO_DOXYGEN
 
@@ -50,6 +53,10 @@ extern "C" {
  * Equation:
  *
  * `x^16 + x^12 + x^5 + 1`
+ *
+ * Default implementation of crc16_ccitt() uses lookup table and processes one
+ * byte per step. Faster variants, which process four or eight bytes per step
+ * (slicing), or hardware CRC unit can be selected with @ref CO_CONFIG_CRC16.
  */
 
 
@@ -81,6 +88,28 @@ uint16_t crc16_ccitt(const uint8_t block[],
                      uint16_t crc);
 
 
+#if ((CO_CONFIG_CRC16) & CO_CONFIG_CRC16_HW) || defined CO_DOXYGEN
+/**
+ * Calculate CRC sum on block of data with hardware CRC unit.
+ *
+ * Function is called from crc16_ccitt() for blocks, which are not shorter
+ * than @ref CO_CONFIG_CRC16_HW_MIN_LENGTH, if CO_CONFIG_CRC16_HW is enabled.
+ * It must be defined by the application or CAN driver. It must give the same
+ * result as crc16_ccitt(): polynomial 0x1021, no reflection, no final xor.
+ * If CRC unit is shared, function must take care of the locking.
+ *
+ * @param block Pointer to block of data.
+ * @param blockLength Length of data in bytes;
+ * @param crc Initial value.
+ *
+ * @return Calculated CRC.
+ */
+uint16_t crc16_ccitt_hw(const uint8_t block[],
+                        size_t blockLength,
+                        uint16_t crc);
+#endif
+
+
 /** @} */ /* CO_crc16_ccitt */
 
 #ifdef __cplusplus
@@ -0,0 +1,502 @@
+/*
+ * CANopen boot-up manager, which checks, configures and starts slaves.
+ *
+ * @file        CO_bootManager.c
+ * @ingroup     CO_bootManager
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "302/CO_bootManager.h"
+
+#if (CO_CONFIG_BOOT_MGR) & CO_CONFIG_BOOT_MGR_ENABLE
+
+/* verify configuration */
+#if !((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_POOL)
+ #error CO_CONFIG_SDO_CLI_POOL must be enabled.
+#endif
+#if !((CO_CONFIG_NMT) & CO_CONFIG_NMT_MASTER)
+ #error CO_CONFIG_NMT_MASTER must be enabled.
+#endif
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI) \
+    && ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_QUERY_FUNCT)
+ #define CO_BOOT_MGR_HB_EVENTS
+#endif
+
+/* Steps of the boot slave process, each is one SDO job */
+#define STEP_DEVICE_TYPE     0U  /* 0x1000 */
+#define STEP_IDENTITY        1U  /* 0x1018, sub 1 to 4, steps 1 to 4 */
+#define STEP_CFG_DATE_READ   5U  /* 0x1020:1 */
+#define STEP_CFG_TIME_READ   6U  /* 0x1020:2 */
+#define STEP_CONFIG          7U  /* configuration entries */
+#define STEP_CFG_DATE_WRITE  8U  /* 0x1020:1 */
+#define STEP_CFG_TIME_WRITE  9U  /* 0x1020:2 */
+#define STEP_STORE           10U /* 0x1010:1 */
+#define STEP_START           11U /* NMT start */
+
+/* "save" signature for 0x1010 */
+#define CO_BOOT_STORE_SIGNATURE 0x65766173UL
+
+
+/* Change state of the slave and inform application */
+static void slaveSetState(CO_bootSlave_t *slave, CO_bootSlave_state_t state) {
+    CO_bootManager_t *bootMgr = slave->bootMgr;
+
+    if (slave->state == state) {
+        return;
+    }
+    if (slave->state == CO_bootSlave_BOOTED) {
+        bootMgr->countBooted--;
+    }
+    else if (state == CO_bootSlave_BOOTED) {
+        bootMgr->countBooted++;
+    }
+    slave->state = state;
+
+    if (state != CO_bootSlave_CHECK && state != CO_bootSlave_CONFIG
+        && bootMgr->pFunctSignalSlave != NULL
+    ) {
+        bootMgr->pFunctSignalSlave(bootMgr->functSignalObjectSlave, slave);
+    }
+}
+
+
+/* End the boot slave process */
+static void slaveFinish(CO_bootSlave_t *slave, CO_bootSlave_error_t error,
+                        CO_SDO_abortCode_t abortCode)
+{
+    slave->error = error;
+    slave->abortCode = abortCode;
+    slave->retryTimer_us = 0;
+    slaveSetState(slave, error == CO_bootSlave_ERR_NONE
+                         ? CO_bootSlave_BOOTED : CO_bootSlave_ERROR);
+}
+
+
+static void slaveJobCompleted(void *object, CO_SDOclientJob_t *job);
+
+/* Add SDO job for the current step into the SDO client pool */
+static void slaveAddJob(CO_bootSlave_t *slave, uint16_t index,
+                        uint8_t subIndex, bool_t upload,
+                        const uint8_t *data, size_t dataSize)
+{
+    CO_SDOclientJob_t *job = &slave->job;
+
+    job->nodeId = slave->nodeId;
+    job->index = index;
+    job->subIndex = subIndex;
+    job->upload = upload;
+    /* pool only reads the buffer for download */
+    job->data = (uint8_t *)data;
+    job->dataSize = dataSize;
+    job->functCompleted = slaveJobCompleted;
+    job->object = slave;
+
+    if (CO_SDOclientPool_add(slave->bootMgr->pool, job) == CO_ERROR_NO) {
+        slave->busy = true;
+    }
+    else {
+        slaveFinish(slave, CO_bootSlave_ERR_SDO, CO_SDO_AB_GENERAL);
+    }
+}
+
+/* Upload uint32 value into jobData */
+static void slaveUpload(CO_bootSlave_t *slave, uint16_t index,
+                        uint8_t subIndex)
+{
+    memset(slave->jobData, 0, sizeof(slave->jobData));
+    slaveAddJob(slave, index, subIndex, true,
+                slave->jobData, sizeof(slave->jobData));
+}
+
+/* Download uint32 value from jobData */
+static void slaveDownload(CO_bootSlave_t *slave, uint16_t index,
+                          uint8_t subIndex, uint32_t value)
+{
+    CO_setUint32(slave->jobData, value);
+    slaveAddJob(slave, index, subIndex, false,
+                slave->jobData, sizeof(slave->jobData));
+}
+
+
+/* Execute the current step or skip it, if not necessary */
+static void slaveNext(CO_bootSlave_t *slave) {
+    CO_bootManager_t *bootMgr = slave->bootMgr;
+
+    for (;;) {
+        switch (slave->step) {
+        case STEP_DEVICE_TYPE:
+            /* always read, it verifies presence of the slave */
+            slaveUpload(slave, 0x1000, 0);
+            return;
+
+        case STEP_CFG_DATE_READ:
+            if (slave->configDate == 0 && slave->configTime == 0) {
+                slave->step = STEP_CONFIG;
+                break;
+            }
+            slaveUpload(slave, 0x1020, 1);
+            return;
+
+        case STEP_CFG_TIME_READ:
+            slaveUpload(slave, 0x1020, 2);
+            return;
+
+        case STEP_CONFIG:
+            if (slave->configMatch) {
+                slave->step = STEP_START;
+                break;
+            }
+            if (slave->conciseDcf != NULL) {
+                /* whole configuration with single SDO transfer */
+                if (slave->configPos > 0) {
+                    slave->step = STEP_CFG_DATE_WRITE;
+                    break;
+                }
+                slaveSetState(slave, CO_bootSlave_CONFIG);
+                slaveAddJob(slave, 0x1F22, 1, false,
+                            slave->conciseDcf, slave->conciseDcfSize);
+                return;
+            }
+            if (slave->configPos >= slave->configCount) {
+                slave->step = STEP_CFG_DATE_WRITE;
+                break;
+            }
+            slaveSetState(slave, CO_bootSlave_CONFIG);
+            slaveAddJob(slave, slave->config[slave->configPos].index,
+                        slave->config[slave->configPos].subIndex, false,
+                        slave->config[slave->configPos].data,
+                        slave->config[slave->configPos].dataSize);
+            return;
+
+        case STEP_CFG_DATE_WRITE:
+            if (slave->configDate == 0 && slave->configTime == 0) {
+                slave->step = STEP_STORE;
+                break;
+            }
+            slaveDownload(slave, 0x1020, 1, slave->configDate);
+            return;
+
+        case STEP_CFG_TIME_WRITE:
+            slaveDownload(slave, 0x1020, 2, slave->configTime);
+            return;
+
+        case STEP_STORE:
+            if (!bootMgr->storeConfig) {
+                slave->step = STEP_START;
+                break;
+            }
+            slaveDownload(slave, 0x1010, 1, CO_BOOT_STORE_SIGNATURE);
+            return;
+
+        case STEP_START:
+            if (bootMgr->startSlaves) {
+                CO_NMT_sendCommand(bootMgr->NMT, CO_NMT_ENTER_OPERATIONAL,
+                                   slave->nodeId);
+            }
+            slaveFinish(slave, CO_bootSlave_ERR_NONE, CO_SDO_AB_NONE);
+            return;
+
+        default: /* STEP_IDENTITY */
+            if (slave->identity[slave->step - STEP_IDENTITY] == 0) {
+                slave->step++;
+                break;
+            }
+            slaveUpload(slave, 0x1018, slave->step - STEP_IDENTITY + 1);
+            return;
+        }
+    }
+}
+
+
+/* Start the boot slave process from the beginning */
+static void slaveBegin(CO_bootSlave_t *slave) {
+    if (slave->busy) {
+        /* can not cancel job inside the pool, restart after it */
+        slave->restart = true;
+        return;
+    }
+    slave->restart = false;
+    slave->step = STEP_DEVICE_TYPE;
+    slave->configPos = 0;
+    slave->configMatch = false;
+    slave->error = CO_bootSlave_ERR_NONE;
+    slave->abortCode = CO_SDO_AB_NONE;
+    slaveSetState(slave, CO_bootSlave_CHECK);
+    slaveNext(slave);
+}
+
+
+/* Called from CO_SDOclientPool_process() after the job is finished */
+static void slaveJobCompleted(void *object, CO_SDOclientJob_t *job) {
+    CO_bootSlave_t *slave = object;
+    bool_t ok = job->result == CO_SDO_RT_ok_communicationEnd;
+    uint32_t value = CO_getUint32(slave->jobData);
+
+    slave->busy = false;
+    if (slave->restart) {
+        slaveBegin(slave);
+        return;
+    }
+
+    switch (slave->step) {
+    case STEP_DEVICE_TYPE:
+        if (!ok) {
+            slaveFinish(slave, CO_bootSlave_ERR_NO_RESPONSE, job->abortCode);
+            return;
+        }
+        if (slave->deviceType != 0 && value != slave->deviceType) {
+            slaveFinish(slave, CO_bootSlave_ERR_DEVICE_TYPE, CO_SDO_AB_NONE);
+            return;
+        }
+        slave->step++;
+        break;
+
+    case STEP_CFG_DATE_READ:
+    case STEP_CFG_TIME_READ:
+        /* 0x1020 may not be supported by the slave, then configure it */
+        if (!ok) {
+            slave->configMatch = false;
+            slave->step = STEP_CONFIG;
+            break;
+        }
+        if (slave->step == STEP_CFG_DATE_READ) {
+            slave->configMatch = value == slave->configDate;
+        }
+        else {
+            slave->configMatch = slave->configMatch
+                                 && value == slave->configTime;
+        }
+        slave->step++;
+        break;
+
+    case STEP_CONFIG:
+    case STEP_CFG_DATE_WRITE:
+    case STEP_CFG_TIME_WRITE:
+    case STEP_STORE:
+        if (!ok) {
+            slaveFinish(slave, CO_bootSlave_ERR_CONFIG, job->abortCode);
+            return;
+        }
+        if (slave->step == STEP_CONFIG) {
+            slave->configPos++;
+        }
+        else {
+            slave->step++;
+        }
+        break;
+
+    default: /* STEP_IDENTITY */
+        if (!ok) {
+            slaveFinish(slave, CO_bootSlave_ERR_SDO, job->abortCode);
+            return;
+        }
+        if (value != slave->identity[slave->step - STEP_IDENTITY]) {
+            slaveFinish(slave, (CO_bootSlave_error_t)
+                        (CO_bootSlave_ERR_VENDOR_ID + slave->step
+                         - STEP_IDENTITY), CO_SDO_AB_NONE);
+            return;
+        }
+        slave->step++;
+        break;
+    }
+
+    slaveNext(slave);
+}
+
+
+#ifdef CO_BOOT_MGR_HB_EVENTS
+/* Boot-up message received from the slave */
+static void slaveRemoteReset(uint8_t nodeId, uint8_t idx, void *object) {
+    (void)nodeId; (void)idx;
+    CO_bootSlave_t *slave = object;
+
+    if (slave->bootMgr->active) {
+        slaveBegin(slave);
+    }
+}
+
+/* First heartbeat received from the slave after (re)configuration or timeout.
+ * Slave may be already running, without boot-up message. */
+static void slaveHbStarted(uint8_t nodeId, uint8_t idx, void *object) {
+    (void)nodeId; (void)idx;
+    CO_bootSlave_t *slave = object;
+
+    if (slave->bootMgr->active && !slave->busy
+        && (slave->state == CO_bootSlave_IDLE
+            || slave->state == CO_bootSlave_ERROR)
+    ) {
+        slaveBegin(slave);
+    }
+}
+
+/* Heartbeat of the slave timed out */
+static void slaveHbTimeout(uint8_t nodeId, uint8_t idx, void *object) {
+    (void)nodeId; (void)idx;
+    CO_bootSlave_t *slave = object;
+
+    if (slave->state == CO_bootSlave_BOOTED) {
+        slaveSetState(slave, CO_bootSlave_IDLE);
+    }
+}
+#endif
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_bootManager_init(CO_bootManager_t *bootMgr,
+                                     CO_bootSlave_t *slaves,
+                                     uint8_t slavesCount,
+                                     CO_SDOclientPool_t *pool,
+                                     CO_NMT_t *NMT,
+                                     CO_HBconsumer_t *HBcons,
+                                     uint16_t retryTime_ms,
+                                     bool_t startSlaves,
+                                     bool_t storeConfig)
+{
+    /* verify arguments */
+    if (bootMgr == NULL || (slaves == NULL && slavesCount > 0)
+        || pool == NULL || NMT == NULL
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    for (uint8_t i = 0; i < slavesCount; i++) {
+        if (slaves[i].nodeId < 1 || slaves[i].nodeId > 127
+            || (slaves[i].config == NULL && slaves[i].configCount > 0)
+            || (slaves[i].conciseDcf == NULL && slaves[i].conciseDcfSize > 0)
+        ) {
+            return CO_ERROR_ILLEGAL_ARGUMENT;
+        }
+    }
+
+    memset(bootMgr, 0, sizeof(CO_bootManager_t));
+    bootMgr->slaves = slaves;
+    bootMgr->slavesCount = slavesCount;
+    bootMgr->pool = pool;
+    bootMgr->NMT = NMT;
+    bootMgr->retryTime_us = (uint32_t)retryTime_ms * 1000;
+    bootMgr->startSlaves = startSlaves;
+    bootMgr->storeConfig = storeConfig;
+
+    for (uint8_t i = 0; i < slavesCount; i++) {
+        CO_bootSlave_t *slave = &slaves[i];
+
+        slave->bootMgr = bootMgr;
+        slave->state = CO_bootSlave_IDLE;
+        slave->error = CO_bootSlave_ERR_NONE;
+        slave->abortCode = CO_SDO_AB_NONE;
+        slave->busy = false;
+        slave->restart = false;
+        slave->retryTimer_us = 0;
+
+#ifdef CO_BOOT_MGR_HB_EVENTS
+        int8_t idx = HBcons != NULL
+                   ? CO_HBconsumer_getIdxByNodeId(HBcons, slave->nodeId) : -1;
+        if (idx >= 0) {
+            CO_HBconsumer_initCallbackRemoteReset(HBcons, (uint8_t)idx,
+                                                  slave, slaveRemoteReset);
+            CO_HBconsumer_initCallbackHeartbeatStarted(HBcons, (uint8_t)idx,
+                                                       slave, slaveHbStarted);
+            CO_HBconsumer_initCallbackTimeout(HBcons, (uint8_t)idx,
+                                              slave, slaveHbTimeout);
+        }
+#endif
+    }
+#ifndef CO_BOOT_MGR_HB_EVENTS
+    (void)HBcons; /* unused */
+#endif
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_bootManager_initCallbackSlave(
+        CO_bootManager_t       *bootMgr,
+        void                   *object,
+        void                  (*pFunctSignal)(void *object,
+                                              CO_bootSlave_t *slave))
+{
+    if (bootMgr != NULL) {
+        bootMgr->functSignalObjectSlave = object;
+        bootMgr->pFunctSignalSlave = pFunctSignal;
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_bootManager_start(CO_bootManager_t *bootMgr) {
+    if (bootMgr == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    bootMgr->active = true;
+    for (uint8_t i = 0; i < bootMgr->slavesCount; i++) {
+        slaveBegin(&bootMgr->slaves[i]);
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+bool_t CO_bootManager_process(CO_bootManager_t *bootMgr,
+                              uint32_t timeDifference_us,
+                              uint32_t *timerNext_us)
+{
+    if (bootMgr == NULL) {
+        return false;
+    }
+
+    /* all SDO jobs of all slaves run in parallel here */
+    CO_SDOclientPool_process(bootMgr->pool, timeDifference_us, timerNext_us);
+
+    /* retry slaves with communication error */
+    if (bootMgr->active && bootMgr->retryTime_us > 0) {
+        for (uint8_t i = 0; i < bootMgr->slavesCount; i++) {
+            CO_bootSlave_t *slave = &bootMgr->slaves[i];
+
+            if (slave->state != CO_bootSlave_ERROR || slave->busy
+                || (slave->error != CO_bootSlave_ERR_NO_RESPONSE
+                    && slave->error != CO_bootSlave_ERR_SDO
+                    && slave->error != CO_bootSlave_ERR_CONFIG)
+            ) {
+                continue;
+            }
+
+            slave->retryTimer_us += timeDifference_us;
+            if (slave->retryTimer_us >= bootMgr->retryTime_us) {
+                slaveBegin(slave);
+            }
+#if (CO_CONFIG_BOOT_MGR) & CO_CONFIG_FLAG_TIMERNEXT
+            else if (timerNext_us != NULL) {
+                uint32_t diff = bootMgr->retryTime_us - slave->retryTimer_us;
+                if (*timerNext_us > diff) {
+                    *timerNext_us = diff;
+                }
+            }
+#endif
+        }
+    }
+
+    return bootMgr->countBooted == bootMgr->slavesCount;
+}
+
+#endif /* (CO_CONFIG_BOOT_MGR) & CO_CONFIG_BOOT_MGR_ENABLE */
@@ -0,0 +1,315 @@
+/**
+ * CANopen boot-up manager, which checks, configures and starts slaves.
+ *
+ * @file        CO_bootManager.h
+ * @ingroup     CO_bootManager
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_BOOT_MANAGER_H
+#define CO_BOOT_MANAGER_H
+
+#include "301/CO_driver.h"
+#include "301/CO_NMT_Heartbeat.h"
+#include "301/CO_HBconsumer.h"
+#include "301/CO_SDOclientPool.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_BOOT_MGR
+#define CO_CONFIG_BOOT_MGR (0)
+#endif
+
+#if ((CO_CONFIG_BOOT_MGR) & CO_CONFIG_BOOT_MGR_ENABLE) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_bootManager Boot-up manager
+ * Network boot-up of NMT slaves, similar to CiA 302-2.
+ *
+ * @ingroup CO_CANopen_302
+ * @{
+ * Boot-up manager runs on NMT master. For each slave from the
+ * @ref CO_bootSlave_t array it executes the boot slave process:
+ * - Read device type (0x1000). If there is no response, slave is missing.
+ * - Read identity (0x1018, sub 1 to 4) and compare it with expected values.
+ * - Read configuration date and time (0x1020, sub 1 and 2). If they match
+ *   expected values, configuration is skipped.
+ * - Otherwise download configuration entries or concise DCF image, write
+ *   expected configuration date and time into 0x1020 and optionally store
+ *   parameters (0x1010).
+ * - Send NMT start command to the slave.
+ *
+ * Each step is one @ref CO_SDOclientJob_t and all slaves run their processes
+ * in parallel on the SDO clients of @ref CO_SDOclientPool. Slave is started as
+ * soon as its own process is finished, it does not wait for other slaves.
+ *
+ * If HB consumer is configured with CO_CONFIG_HB_CONS_CALLBACK_MULTI and
+ * CO_CONFIG_HB_CONS_QUERY_FUNCT, boot-up manager registers heartbeat started,
+ * timeout and remote reset callbacks for monitored slaves. Slave is then booted
+ * again after boot-up message or after its heartbeat appears again. These
+ * callbacks must not be used by the application for the same slaves.
+ *
+ * Failed slave with communication error is retried after retryTime_ms.
+ */
+
+
+/**
+ * State of the boot slave process.
+ */
+typedef enum {
+    /** Process not started or slave lost (heartbeat timeout) */
+    CO_bootSlave_IDLE = 0,
+    /** Checking device type, identity and configuration date */
+    CO_bootSlave_CHECK = 1,
+    /** Downloading configuration */
+    CO_bootSlave_CONFIG = 2,
+    /** Slave is configured and started (NMT start was sent, if enabled) */
+    CO_bootSlave_BOOTED = 3,
+    /** Boot slave process failed, see @ref CO_bootSlave_error_t */
+    CO_bootSlave_ERROR = 4
+} CO_bootSlave_state_t;
+
+
+/**
+ * Error of the boot slave process.
+ */
+typedef enum {
+    /** No error */
+    CO_bootSlave_ERR_NONE = 0,
+    /** No response to device type (0x1000) read */
+    CO_bootSlave_ERR_NO_RESPONSE = 1,
+    /** Device type (0x1000) mismatch */
+    CO_bootSlave_ERR_DEVICE_TYPE = 2,
+    /** Vendor-ID (0x1018:1) mismatch */
+    CO_bootSlave_ERR_VENDOR_ID = 3,
+    /** Product code (0x1018:2) mismatch */
+    CO_bootSlave_ERR_PRODUCT_CODE = 4,
+    /** Revision number (0x1018:3) mismatch */
+    CO_bootSlave_ERR_REVISION = 5,
+    /** Serial number (0x1018:4) mismatch */
+    CO_bootSlave_ERR_SERIAL = 6,
+    /** SDO communication error during check */
+    CO_bootSlave_ERR_SDO = 7,
+    /** SDO download of configuration failed */
+    CO_bootSlave_ERR_CONFIG = 8
+} CO_bootSlave_error_t;
+
+
+/**
+ * One configuration entry, downloaded to the slave.
+ */
+typedef struct {
+    /** Index of object in Object Dictionary of the slave */
+    uint16_t index;
+    /** Subindex of object in Object Dictionary of the slave */
+    uint8_t subIndex;
+    /** Size of data in bytes */
+    size_t dataSize;
+    /** Data in little-endian format, as transferred by SDO */
+    const uint8_t *data;
+} CO_bootConfigEntry_t;
+
+
+struct CO_bootManager;
+
+/**
+ * Boot slave object.
+ *
+ * Fields from nodeId to conciseDcfSize must be set by the application before
+ * @ref CO_bootManager_init(). Zero value of the expected device type, identity
+ * or configuration date and time means, that value is not checked.
+ */
+typedef struct {
+    /** Node-ID of the slave, 1..127 */
+    uint8_t nodeId;
+    /** Expected device type (0x1000) */
+    uint32_t deviceType;
+    /** Expected vendor-ID, product code, revision and serial number (0x1018,
+     * sub 1 to 4) */
+    uint32_t identity[4];
+    /** Expected configuration date (0x1020:1). If configDate and configTime
+     * are both zero, configuration is always downloaded and 0x1020 is not
+     * written. */
+    uint32_t configDate;
+    /** Expected configuration time (0x1020:2) */
+    uint32_t configTime;
+    /** Array of configuration entries, may be NULL */
+    const CO_bootConfigEntry_t *config;
+    /** Number of configuration entries */
+    uint16_t configCount;
+    /** Concise DCF image, may be NULL. If set, it is downloaded to 0x1F22:1
+     * of the slave with single SDO transfer instead of config entries. See
+     * @ref CO_conciseDcf. */
+    const uint8_t *conciseDcf;
+    /** Size of the concise DCF image */
+    size_t conciseDcfSize;
+    /** Current state, read only */
+    CO_bootSlave_state_t state;
+    /** Error, valid in state #CO_bootSlave_ERROR, read only */
+    CO_bootSlave_error_t error;
+    /** SDO abort code of the failed step, read only */
+    CO_SDO_abortCode_t abortCode;
+    /** Internal, boot-up manager, which contains this slave */
+    struct CO_bootManager *bootMgr;
+    /** Internal, current step of the boot slave process */
+    uint8_t step;
+    /** Internal, current configuration entry */
+    uint16_t configPos;
+    /** Internal, true, if configuration date and time match */
+    bool_t configMatch;
+    /** Internal, true, if job is inside SDO client pool */
+    bool_t busy;
+    /** Internal, true, if process must restart after the current job */
+    bool_t restart;
+    /** Internal, time in state #CO_bootSlave_ERROR */
+    uint32_t retryTimer_us;
+    /** Internal, SDO job */
+    CO_SDOclientJob_t job;
+    /** Internal, data buffer for SDO job */
+    uint8_t jobData[4];
+} CO_bootSlave_t;
+
+
+/**
+ * Boot-up manager object.
+ */
+typedef struct CO_bootManager {
+    /** From CO_bootManager_init() */
+    CO_bootSlave_t *slaves;
+    /** From CO_bootManager_init() */
+    uint8_t slavesCount;
+    /** From CO_bootManager_init() */
+    CO_SDOclientPool_t *pool;
+    /** From CO_bootManager_init() */
+    CO_NMT_t *NMT;
+    /** From CO_bootManager_init() */
+    uint32_t retryTime_us;
+    /** From CO_bootManager_init() */
+    bool_t startSlaves;
+    /** From CO_bootManager_init() */
+    bool_t storeConfig;
+    /** True after CO_bootManager_start() */
+    bool_t active;
+    /** Number of slaves in state #CO_bootSlave_BOOTED. Can be read by the
+     * application. */
+    uint8_t countBooted;
+    /** From CO_bootManager_initCallbackSlave() or NULL */
+    void (*pFunctSignalSlave)(void *object, CO_bootSlave_t *slave);
+    /** From CO_bootManager_initCallbackSlave() or NULL */
+    void *functSignalObjectSlave;
+} CO_bootManager_t;
+
+
+/**
+ * Initialize boot-up manager object.
+ *
+ * Function must be called in the communication reset section, after
+ * initialization of the HB consumer and SDO client pool.
+ *
+ * @param bootMgr This object will be initialized.
+ * @param slaves Array of boot slave objects, prepared by the application.
+ * @param slavesCount Number of slaves in array.
+ * @param pool SDO client pool. It is processed inside
+ * CO_bootManager_process(), but it may be used by the application too.
+ * @param NMT NMT object, used for sending NMT start command.
+ * @param HBcons Heartbeat consumer object for boot-up and heartbeat events, may
+ * be NULL.
+ * @param retryTime_ms Time after the boot slave process is repeated for the
+ * slave with communication error. If 0, process is repeated only after
+ * boot-up message or CO_bootManager_start().
+ * @param startSlaves If true, NMT start is sent to each slave at the end of its
+ * boot slave process.
+ * @param storeConfig If true, command "save" is written to 0x1010:1 of the
+ * slave after configuration download.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_bootManager_init(CO_bootManager_t *bootMgr,
+                                     CO_bootSlave_t *slaves,
+                                     uint8_t slavesCount,
+                                     CO_SDOclientPool_t *pool,
+                                     CO_NMT_t *NMT,
+                                     CO_HBconsumer_t *HBcons,
+                                     uint16_t retryTime_ms,
+                                     bool_t startSlaves,
+                                     bool_t storeConfig);
+
+
+/**
+ * Initialize boot slave callback function.
+ *
+ * Function initializes optional callback function, which is called from
+ * CO_bootManager_process() or CO_bootManager_start(), when state of any slave
+ * changes to #CO_bootSlave_BOOTED, #CO_bootSlave_ERROR or #CO_bootSlave_IDLE.
+ *
+ * @param bootMgr This object.
+ * @param object Pointer to object, which will be passed to pFunctSignal(). Can
+ * be NULL
+ * @param pFunctSignal Pointer to the callback function. Not called if NULL.
+ */
+void CO_bootManager_initCallbackSlave(
+        CO_bootManager_t       *bootMgr,
+        void                   *object,
+        void                  (*pFunctSignal)(void *object,
+                                              CO_bootSlave_t *slave));
+
+
+/**
+ * Start boot slave process for all slaves.
+ *
+ * Function is usually called once, after NMT master enters NMT operational or
+ * pre-operational state. It may be called again, to boot all slaves again.
+ *
+ * @param bootMgr This object.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_bootManager_start(CO_bootManager_t *bootMgr);
+
+
+/**
+ * Process boot-up manager.
+ *
+ * Function must be called cyclically, from the same thread as CO_process().
+ * It processes SDO client pool and retry timers. Function is non-blocking.
+ *
+ * @param bootMgr This object.
+ * @param timeDifference_us Time difference from previous function call in
+ * [microseconds].
+ * @param [out] timerNext_us info to OS - see CO_process(). Ignored if NULL.
+ *
+ * @return true, if all slaves are in state #CO_bootSlave_BOOTED.
+ */
+bool_t CO_bootManager_process(CO_bootManager_t *bootMgr,
+                              uint32_t timeDifference_us,
+                              uint32_t *timerNext_us);
+
+/** @} */ /* CO_bootManager */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_BOOT_MGR) & CO_CONFIG_BOOT_MGR_ENABLE */
+
+#endif /* CO_BOOT_MANAGER_H */
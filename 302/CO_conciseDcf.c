@@ -0,0 +1,374 @@
+/*
+ * CANopen concise DCF, bulk configuration with single SDO transfer.
+ *
+ * @file        CO_conciseDcf.c
+ * @ingroup     CO_conciseDcf
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "302/CO_conciseDcf.h"
+
+#if (CO_CONFIG_CONCISE_DCF) & CO_CONFIG_CONCISE_DCF_ENABLE
+
+/* Parser states */
+#define DCF_ST_COUNT  0U /* reading number of entries */
+#define DCF_ST_HEADER 1U /* reading index, sub-index and size of entry */
+#define DCF_ST_DATA   2U /* writing data of entry */
+
+/* Size of entry header: index, sub-index, size */
+#define DCF_HDR_SIZE  7U
+
+
+/* Start writing new entry, header is in dcf->hdr */
+static ODR_t entryBegin(CO_conciseDcf_t *dcf) {
+    uint16_t index = CO_getUint16(&dcf->hdr[0]);
+    uint8_t subIndex = dcf->hdr[2];
+    uint32_t size = CO_getUint32(&dcf->hdr[3]);
+
+    dcf->errIndex = index;
+    dcf->errSubIndex = subIndex;
+
+    OD_entry_t *entry = OD_find(dcf->OD, index);
+    if (entry == NULL) {
+        return ODR_IDX_NOT_EXIST;
+    }
+    ODR_t odRet = OD_getSub(entry, subIndex, &dcf->io, false);
+    if (odRet != ODR_OK) {
+        return odRet;
+    }
+    if ((dcf->io.stream.attribute & ODA_SDO_W) == 0) {
+        return ODR_READONLY;
+    }
+    dcf->lockGroup = OD_lockGroup(index, &dcf->io.stream);
+
+    /* verify size the same way as SDO server does */
+    OD_size_t sizeInOd = dcf->io.stream.dataLength;
+    dcf->strTerminate = false;
+    if ((dcf->io.stream.attribute & ODA_STR) != 0
+        && (sizeInOd == 0 || size < sizeInOd)
+    ) {
+        /* shorter string is terminated with zero */
+        dcf->strTerminate = true;
+        dcf->io.stream.dataLength = (OD_size_t)size + 1;
+    }
+    else if (sizeInOd == 0) {
+        dcf->io.stream.dataLength = (OD_size_t)size;
+    }
+    else if (size != sizeInOd) {
+        return (size > sizeInOd) ? ODR_DATA_LONG : ODR_DATA_SHORT;
+    }
+
+    dcf->dataSize = size;
+    dcf->dataPos = 0;
+    return ODR_OK;
+}
+
+
+/* Write to the current entry. SDO server calls OD_write_1F22() with the lock of
+ * the 0x1F22 group taken. Target entry may be in other group, for example PDO
+ * parameter in OD_LOCK_GRP_RT, so the lock is switched during the write. */
+static ODR_t entryIoWrite(CO_conciseDcf_t *dcf, const void *buf,
+                          OD_size_t count, OD_size_t *countWritten)
+{
+    ODR_t odRet;
+
+    if (dcf->lockGroup == dcf->lockGroupDcf) {
+        return dcf->io.write(&dcf->io.stream, buf, count, countWritten);
+    }
+    CO_UNLOCK_OD_GROUP(dcf->CANdev, dcf->lockGroupDcf);
+    CO_LOCK_OD_GROUP(dcf->CANdev, dcf->lockGroup);
+    odRet = dcf->io.write(&dcf->io.stream, buf, count, countWritten);
+    CO_UNLOCK_OD_GROUP(dcf->CANdev, dcf->lockGroup);
+    CO_LOCK_OD_GROUP(dcf->CANdev, dcf->lockGroupDcf);
+    return odRet;
+}
+
+
+/* Write data of the current entry from buffer. Return ODR_OK, if entry is
+ * finished, ODR_PARTIAL, if more data are necessary, ODR_PENDING, if function
+ * must be called again with the same arguments or error. */
+static ODR_t entryWrite(CO_conciseDcf_t *dcf, const uint8_t *data,
+                        OD_size_t avail, OD_size_t *consumed)
+{
+    uint32_t remaining = dcf->dataSize - dcf->dataPos;
+    OD_size_t take = (remaining < avail) ? (OD_size_t)remaining : avail;
+    OD_size_t countWritten;
+    ODR_t odRet;
+
+    *consumed = 0;
+
+    if ((dcf->dataSize + (dcf->strTerminate ? 1 : 0)) <= sizeof(dcf->value)) {
+        /* small value, collect and write it at once */
+        uint8_t value[sizeof(dcf->value)];
+        OD_size_t len = (OD_size_t)dcf->dataSize;
+
+        memcpy(&dcf->value[dcf->dataPos], data, take);
+        if ((dcf->dataPos + take) < dcf->dataSize) {
+            dcf->dataPos += take;
+            *consumed = take;
+            return ODR_PARTIAL;
+        }
+        memcpy(value, dcf->value, len);
+#ifdef CO_BIG_ENDIAN
+        if ((dcf->io.stream.attribute & ODA_MB) != 0) {
+            for (OD_size_t i = 0; i < len / 2; i++) {
+                uint8_t swap = value[i];
+                value[i] = value[len - 1 - i];
+                value[len - 1 - i] = swap;
+            }
+        }
+#endif
+        if (dcf->strTerminate) {
+            value[len++] = 0;
+        }
+
+        odRet = entryIoWrite(dcf, value, len, &countWritten);
+        if (odRet == ODR_PENDING) {
+            return odRet;
+        }
+        dcf->dataPos = dcf->dataSize;
+        *consumed = take;
+        return (odRet == ODR_PARTIAL) ? ODR_DATA_SHORT : odRet;
+    }
+
+    if (remaining > 0) {
+        /* large value, pass data to OD variable in segments */
+        if (take == 0) {
+            return ODR_PARTIAL;
+        }
+        odRet = entryIoWrite(dcf, data, take, &countWritten);
+        if (odRet == ODR_PENDING) {
+            return odRet;
+        }
+        dcf->dataPos += take;
+        *consumed = take;
+        if (odRet != ODR_OK && odRet != ODR_PARTIAL) {
+            return odRet;
+        }
+        if (dcf->dataPos < dcf->dataSize || dcf->strTerminate) {
+            return (odRet == ODR_OK) ? ODR_DATA_LONG : ODR_PARTIAL;
+        }
+        return (odRet == ODR_OK) ? ODR_OK : ODR_DATA_SHORT;
+    }
+
+    /* terminate large string */
+    const uint8_t zero = 0;
+    odRet = entryIoWrite(dcf, &zero, 1, &countWritten);
+    if (odRet == ODR_PENDING) {
+        return odRet;
+    }
+    dcf->strTerminate = false;
+    return (odRet == ODR_PARTIAL) ? ODR_DATA_SHORT : odRet;
+}
+
+
+/*
+ * Custom function for writing OD object "Concise DCF"
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_write_1F22(OD_stream_t *stream, const void *buf,
+                           OD_size_t count, OD_size_t *countWritten)
+{
+    if (stream == NULL || buf == NULL || countWritten == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+    if (stream->subIndex == 0) {
+        return OD_writeOriginal(stream, buf, count, countWritten);
+    }
+
+    CO_conciseDcf_t *dcf = stream->object;
+    const uint8_t *data = buf;
+    OD_size_t pos = 0;
+    ODR_t odRet;
+
+    dcf->lockGroupDcf = OD_lockGroup(0x1F22, stream);
+
+    if (stream->dataOffset == 0) {
+        /* new concise DCF. Previous transfer may be aborted, while write of
+         * its entry was pending, so pending state is discarded. */
+        dcf->pending = false;
+        dcf->state = DCF_ST_COUNT;
+        dcf->hdrLen = 0;
+        dcf->entriesRemaining = 0;
+        dcf->entriesWritten = 0;
+    }
+    else if (dcf->pending) {
+        /* repeated call with the same arguments */
+        dcf->pending = false;
+        pos = dcf->resumePos;
+        stream->dataOffset -= pos;
+    }
+
+    for (;;) {
+        if (dcf->state == DCF_ST_DATA) {
+            OD_size_t consumed;
+
+            if (pos >= count && dcf->dataPos < dcf->dataSize) {
+                break;
+            }
+            odRet = entryWrite(dcf, &data[pos], count - pos, &consumed);
+            if (odRet == ODR_PENDING) {
+                /* Number of entries and entry header precede the data,
+                 * so dataOffset is not zero in the repeated call. */
+                dcf->pending = true;
+                dcf->resumePos = pos;
+                stream->dataOffset += pos;
+                *countWritten = 0;
+                return odRet;
+            }
+            pos += consumed;
+            if (odRet == ODR_PARTIAL) {
+                continue;
+            }
+            if (odRet != ODR_OK) {
+                return odRet;
+            }
+            dcf->entriesRemaining--;
+            dcf->entriesWritten++;
+            dcf->state = DCF_ST_HEADER;
+            continue;
+        }
+
+        if (pos >= count) {
+            break;
+        }
+        if (dcf->state == DCF_ST_HEADER && dcf->entriesRemaining == 0) {
+            /* more data than entries */
+            return ODR_DATA_LONG;
+        }
+
+        /* collect number of entries or entry header */
+        uint8_t need = (dcf->state == DCF_ST_COUNT) ? 4 : DCF_HDR_SIZE;
+        OD_size_t take = need - dcf->hdrLen;
+        if (take > (count - pos)) {
+            take = count - pos;
+        }
+        memcpy(&dcf->hdr[dcf->hdrLen], &data[pos], take);
+        dcf->hdrLen += (uint8_t)take;
+        pos += take;
+        if (dcf->hdrLen < need) {
+            break;
+        }
+        dcf->hdrLen = 0;
+
+        if (dcf->state == DCF_ST_COUNT) {
+            dcf->entriesRemaining = CO_getUint32(dcf->hdr);
+            dcf->state = DCF_ST_HEADER;
+        }
+        else {
+            odRet = entryBegin(dcf);
+            if (odRet != ODR_OK) {
+                return odRet;
+            }
+            dcf->state = DCF_ST_DATA;
+        }
+    }
+
+    *countWritten = count;
+    stream->dataOffset += count;
+
+    /* SDO server indicates the total size with the last segment */
+    if (stream->dataLength == 0 || stream->dataOffset < stream->dataLength) {
+        return ODR_PARTIAL;
+    }
+    stream->dataOffset = 0;
+    if (dcf->state != DCF_ST_HEADER || dcf->hdrLen != 0
+        || dcf->entriesRemaining != 0
+    ) {
+        return ODR_DATA_SHORT;
+    }
+    return ODR_OK;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_conciseDcf_init(CO_conciseDcf_t *dcf,
+                                    OD_t *od,
+                                    OD_entry_t *OD_1F22_conciseDcf,
+                                    CO_CANmodule_t *CANdev,
+                                    uint32_t *errInfo)
+{
+    if (dcf == NULL || od == NULL || CANdev == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(dcf, 0, sizeof(CO_conciseDcf_t));
+    dcf->OD = od;
+    dcf->CANdev = CANdev;
+
+    if (OD_1F22_conciseDcf != NULL) {
+        dcf->OD_1F22_extension.object = dcf;
+        dcf->OD_1F22_extension.read = OD_readOriginal;
+        dcf->OD_1F22_extension.write = OD_write_1F22;
+        ODR_t odRet = OD_extension_init(OD_1F22_conciseDcf,
+                                        &dcf->OD_1F22_extension);
+        if (odRet != ODR_OK) {
+            if (errInfo != NULL) *errInfo = OD_getIndex(OD_1F22_conciseDcf);
+            return CO_ERROR_OD_PARAMETERS;
+        }
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+bool_t CO_conciseDcf_addEntry(uint8_t *dcf,
+                              size_t dcfBufSize,
+                              size_t *dcfSize,
+                              uint16_t index,
+                              uint8_t subIndex,
+                              const void *data,
+                              uint32_t dataSize)
+{
+    if (dcf == NULL || dcfSize == NULL || (data == NULL && dataSize > 0)) {
+        return false;
+    }
+
+    if (*dcfSize == 0) {
+        if (dcfBufSize < 4) {
+            return false;
+        }
+        CO_setUint32(dcf, 0);
+        *dcfSize = 4;
+    }
+    if (*dcfSize < 4 || *dcfSize > dcfBufSize
+        || (dcfBufSize - *dcfSize) < (DCF_HDR_SIZE + (size_t)dataSize)
+    ) {
+        return false;
+    }
+
+    uint8_t *p = &dcf[*dcfSize];
+    CO_setUint16(&p[0], index);
+    p[2] = subIndex;
+    CO_setUint32(&p[3], dataSize);
+    if (dataSize > 0) {
+        memcpy(&p[DCF_HDR_SIZE], data, dataSize);
+    }
+    *dcfSize += DCF_HDR_SIZE + dataSize;
+    CO_setUint32(dcf, CO_getUint32(dcf) + 1);
+
+    return true;
+}
+
+#endif /* (CO_CONFIG_CONCISE_DCF) & CO_CONFIG_CONCISE_DCF_ENABLE */
@@ -0,0 +1,176 @@
+/**
+ * CANopen concise DCF, bulk configuration with single SDO transfer.
+ *
+ * @file        CO_conciseDcf.h
+ * @ingroup     CO_conciseDcf
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_CONCISE_DCF_H
+#define CO_CONCISE_DCF_H
+
+#include "301/CO_driver.h"
+#include "301/CO_ODinterface.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_CONCISE_DCF
+#define CO_CONFIG_CONCISE_DCF (0)
+#endif
+
+#if ((CO_CONFIG_CONCISE_DCF) & CO_CONFIG_CONCISE_DCF_ENABLE) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_conciseDcf Concise DCF
+ * Bulk configuration of Object Dictionary with concise DCF, CiA 302-3.
+ *
+ * @ingroup CO_CANopen_302
+ * @{
+ * Concise DCF is a packed image of Object Dictionary values, all numbers are
+ * little-endian:
+ *
+ *   Size | Description
+ *   -----|-----------------------------------------------------------
+ *     4  | Number of entries
+ *     2  | Index of the first entry
+ *     1  | Sub-index of the first entry
+ *     4  | Size of data of the first entry in bytes (n)
+ *     n  | Data of the first entry
+ *    ... | Next entries
+ *
+ * SDO client downloads the image with single SDO (block) transfer into the
+ * DOMAIN object 0x1F22 of the device, any sub-index. Concise DCF consumer
+ * unpacks the stream, as it arrives from the SDO server, and writes each entry
+ * into own Object Dictionary. Write goes through IO extensions of the target
+ * objects, the same as SDO download of each entry. Each entry is written with
+ * the lock of its own group, see @ref OD_lockGroup(). The image is not stored.
+ *
+ * If writing of any entry fails, SDO transfer is aborted with the abort code of
+ * that entry, see errIndex and errSubIndex in @ref CO_conciseDcf_t. Entries
+ * before it remain written.
+ *
+ * Concise DCF image can be prepared with @ref CO_conciseDcf_addEntry().
+ */
+
+
+/**
+ * Concise DCF consumer object.
+ */
+typedef struct {
+    /** From CO_conciseDcf_init() */
+    OD_t *OD;
+    /** From CO_conciseDcf_init(), used with CO_LOCK_OD_GROUP() */
+    CO_CANmodule_t *CANdev;
+    /** Lock group of 0x1F22, taken by SDO server during write */
+    OD_lockGroup_t lockGroupDcf;
+    /** Lock group of the current entry */
+    OD_lockGroup_t lockGroup;
+    /** Extension for OD object */
+    OD_extension_t OD_1F22_extension;
+    /** Parser state: 0 = number of entries, 1 = entry header, 2 = data */
+    uint8_t state;
+    /** Header bytes, collected from the stream */
+    uint8_t hdr[7];
+    /** Number of bytes in hdr */
+    uint8_t hdrLen;
+    /** Number of entries, which are not yet written */
+    uint32_t entriesRemaining;
+    /** Size of data of the current entry */
+    uint32_t dataSize;
+    /** Number of data bytes of the current entry already processed */
+    uint32_t dataPos;
+    /** IO access to the current entry */
+    OD_IO_t io;
+    /** Buffer for data up to 8 bytes, written at once */
+    uint8_t value[8];
+    /** True, if current entry is shorter string, terminated with zero */
+    bool_t strTerminate;
+    /** True, if write of the current entry returned ODR_PENDING */
+    bool_t pending;
+    /** Position in the buffer of the pending write call. It is also added to
+     * stream dataOffset, until the call is repeated. */
+    OD_size_t resumePos;
+    /** Number of entries written with the last concise DCF */
+    uint32_t entriesWritten;
+    /** Index of the entry, which failed */
+    uint16_t errIndex;
+    /** Sub-index of the entry, which failed */
+    uint8_t errSubIndex;
+} CO_conciseDcf_t;
+
+
+/**
+ * Initialize concise DCF consumer.
+ *
+ * Function must be called in the communication reset section.
+ *
+ * @param dcf This object will be initialized.
+ * @param od Object Dictionary, where entries are written.
+ * @param OD_1F22_conciseDcf OD entry for 0x1F22 - "Concise DCF", DOMAIN array.
+ * If NULL, consumer is not used.
+ * @param CANdev CAN device, used with CO_LOCK_OD_GROUP() macros.
+ * @param [out] errInfo Additional information in case of error, may be NULL.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT or
+ * CO_ERROR_OD_PARAMETERS.
+ */
+CO_ReturnError_t CO_conciseDcf_init(CO_conciseDcf_t *dcf,
+                                    OD_t *od,
+                                    OD_entry_t *OD_1F22_conciseDcf,
+                                    CO_CANmodule_t *CANdev,
+                                    uint32_t *errInfo);
+
+
+/**
+ * Add entry to the concise DCF image.
+ *
+ * If *dcfSize is zero, image is started with zero number of entries. Then
+ * entry is appended and number of entries is incremented.
+ *
+ * @param dcf Buffer for concise DCF image.
+ * @param dcfBufSize Size of the dcf buffer.
+ * @param [in,out] dcfSize Current size of the image.
+ * @param index Index of the object.
+ * @param subIndex Sub-index of the object.
+ * @param data Data in little-endian format.
+ * @param dataSize Size of data.
+ *
+ * @return true on success, false if buffer is too small.
+ */
+bool_t CO_conciseDcf_addEntry(uint8_t *dcf,
+                              size_t dcfBufSize,
+                              size_t *dcfSize,
+                              uint16_t index,
+                              uint8_t subIndex,
+                              const void *data,
+                              uint32_t dataSize);
+
+/** @} */ /* CO_conciseDcf */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_CONCISE_DCF) & CO_CONFIG_CONCISE_DCF_ENABLE */
+
+#endif /* CO_CONCISE_DCF_H */
@@ -27,6 +27,12 @@
 
 #if (CO_CONFIG_GFC) & CO_CONFIG_GFC_ENABLE
 
+/* verify configuration */
+#if ((CO_CONFIG_GFC) & CO_CONFIG_GFC_LATENCY) \
+    && !((CO_CONFIG_GFC) & CO_CONFIG_GFC_CONSUMER)
+ #error CO_CONFIG_GFC_CONSUMER must be enabled.
+#endif
+
 #if (CO_CONFIG_GFC) & CO_CONFIG_GFC_CONSUMER
 
 static void CO_GFC_receive(void *object, void *msg)
@@ -38,6 +44,10 @@ static void CO_GFC_receive(void *object, void *msg)
         object; /* this is the correct pointer type of the first argument */
 
     if ((*GFC->valid == 0x01) && (DLC == 0)) {
+#if (CO_CONFIG_GFC) & CO_CONFIG_GFC_LATENCY
+        GFC->rxTimestamp = CO_CANrxMsg_readTimestamp(msg);
+        GFC->latencyPending = true;
+#endif
 
 #if (CO_CONFIG_GFC) & CO_CONFIG_GFC_CONSUMER
         /* Optional signal to RTOS, which can resume task, which handles SRDO.
@@ -60,6 +70,24 @@ void CO_GFC_initCallbackEnterSafeState(CO_GFC_t *GFC,
 }
 #endif
 
+#if (CO_CONFIG_GFC) & CO_CONFIG_GFC_LATENCY
+void CO_GFC_safeStateReached(CO_GFC_t *GFC, uint32_t timestamp_us)
+{
+    if (GFC == NULL || !GFC->latencyPending) {
+        return;
+    }
+    GFC->latencyPending = false;
+
+    /* free running counters, difference is valid also after overflow */
+    uint32_t latency = timestamp_us - GFC->rxTimestamp;
+    GFC->latencyLast_us = latency;
+    if (latency > GFC->latencyMax_us) {
+        GFC->latencyMax_us = latency;
+    }
+    GFC->latencyCount++;
+}
+#endif
+
 CO_ReturnError_t CO_GFC_init(CO_GFC_t *GFC,
                              uint8_t *valid,
                              CO_CANmodule_t *GFC_CANdevRx,
@@ -81,6 +109,11 @@ CO_ReturnError_t CO_GFC_init(CO_GFC_t *GFC,
     GFC->functSignalObjectSafe = NULL;
     GFC->pFunctSignalSafe = NULL;
 #endif
+#if (CO_CONFIG_GFC) & CO_CONFIG_GFC_LATENCY
+    GFC->rxTimestamp = 0;
+    GFC->latencyPending = false;
+    CO_GFC_latencyReset(GFC);
+#endif
 
 #if (CO_CONFIG_GFC) & CO_CONFIG_GFC_PRODUCER
     GFC->CANtxBuff = CO_CANtxBufferInit(
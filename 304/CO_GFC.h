@@ -50,6 +50,9 @@ extern "C" {
  * On a safety-relevant the producer can send a GFC message (ID 0, DLC 0).
  * The consumer can use this message to start the transition to a safe state.
  * The GFC is optional for the security protocol and is not monitored (timed).
+ *
+ * With CO_CONFIG_GFC_LATENCY latency from GFC reception to safe state can be
+ * measured on target, see CO_GFC_safeStateReached().
  */
 
 
@@ -68,6 +71,19 @@ typedef struct {
     /** From CO_GFC_initCallbackEnterSafeState() or NULL */
     void *functSignalObjectSafe;
 #endif
+#if ((CO_CONFIG_GFC)&CO_CONFIG_GFC_LATENCY) || defined CO_DOXYGEN
+    /** Reception time of the last GFC message in microseconds */
+    volatile uint32_t rxTimestamp;
+    /** True, if GFC was received and CO_GFC_safeStateReached() was not yet
+     * called */
+    volatile bool_t latencyPending;
+    /** Latency of the last GFC in microseconds */
+    uint32_t latencyLast_us;
+    /** Maximum measured latency in microseconds */
+    uint32_t latencyMax_us;
+    /** Number of measured GFC messages */
+    uint32_t latencyCount;
+#endif
 } CO_GFC_t;
 
 /**
@@ -112,6 +128,35 @@ void CO_GFC_initCallbackEnterSafeState(CO_GFC_t *GFC,
                                        void (*pFunctSignalSafe)(void *object));
 #endif
 
+#if ((CO_CONFIG_GFC)&CO_CONFIG_GFC_LATENCY) || defined CO_DOXYGEN
+/**
+ * Indicate, that safe state has been reached after GFC reception.
+ *
+ * Application calls this function, when outputs are disabled, for example at
+ * the end of safe state callback. Function calculates latency from GFC
+ * reception time to timestamp_us and updates statistics. Call without pending
+ * GFC is ignored.
+ *
+ * @param GFC This object.
+ * @param timestamp_us Current time in microseconds, from the same free
+ * running counter as used by CO_CANrxMsg_readTimestamp().
+ */
+void CO_GFC_safeStateReached(CO_GFC_t *GFC, uint32_t timestamp_us);
+
+/**
+ * Reset GFC latency statistics.
+ *
+ * @param GFC This object.
+ */
+static inline void CO_GFC_latencyReset(CO_GFC_t *GFC) {
+    if (GFC != NULL) {
+        GFC->latencyLast_us = 0;
+        GFC->latencyMax_us = 0;
+        GFC->latencyCount = 0;
+    }
+}
+#endif
+
 #if ((CO_CONFIG_GFC)&CO_CONFIG_GFC_PRODUCER) || defined CO_DOXYGEN
 /**
  * Send GFC message.
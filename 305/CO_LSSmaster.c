@@ -64,7 +64,8 @@ typedef enum {
 typedef enum {
   CO_LSSmaster_FS_STATE_CHECK,
   CO_LSSmaster_FS_STATE_SCAN,
-  CO_LSSmaster_FS_STATE_VERIFY
+  CO_LSSmaster_FS_STATE_VERIFY,
+  CO_LSSmaster_FS_STATE_VERIFY_PREV
 } CO_LSSmaster_fs_t;
 
 /*
@@ -122,6 +123,63 @@ static inline CO_LSSmaster_return_t CO_LSSmaster_check_timeout(
     return ret;
 }
 
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI
+/*
+ * Reset fastscan session
+ */
+static void CO_LSSmaster_FsSessionReset(
+        CO_LSSmaster_t         *LSSmaster)
+{
+    LSSmaster->fsLatencyMax_us = 0;
+    LSSmaster->fsLatencyValid = false;
+    LSSmaster->fsRxSeen = false;
+    LSSmaster->fsPrevValid = false;
+    memset(&LSSmaster->fsPrev, 0, sizeof(LSSmaster->fsPrev));
+}
+#endif
+
+/*
+ * Check LSS timeout for fastscan query.
+ *
+ * With CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI response time is measured and
+ * timeout is adapted to the slowest response seen in the current session.
+ */
+static inline CO_LSSmaster_return_t CO_LSSmaster_FsCheckTimeout(
+        CO_LSSmaster_t         *LSSmaster,
+        uint32_t                timeDifference_us)
+{
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI
+    uint32_t timeout_us = LSSmaster->timeout_us;
+
+    LSSmaster->timeoutTimer += timeDifference_us;
+    if (!LSSmaster->fsRxSeen && CO_FLAG_READ(LSSmaster->CANrxNew)) {
+        LSSmaster->fsRxSeen = true;
+        if (!LSSmaster->fsLatencyValid
+            || LSSmaster->timeoutTimer > LSSmaster->fsLatencyMax_us
+        ) {
+            LSSmaster->fsLatencyMax_us = LSSmaster->timeoutTimer;
+            LSSmaster->fsLatencyValid = true;
+        }
+    }
+    if (LSSmaster->fsLatencyValid) {
+        uint32_t adaptive_us = LSSmaster->fsLatencyMax_us
+                               * CO_CONFIG_LSS_FASTSCAN_TIMEOUT_FACTOR
+                               + CO_CONFIG_LSS_FASTSCAN_TIMEOUT_MARGIN_US;
+        if (adaptive_us < timeout_us) {
+            timeout_us = adaptive_us;
+        }
+    }
+
+    if (LSSmaster->timeoutTimer >= timeout_us) {
+        LSSmaster->timeoutTimer = 0;
+        return CO_LSSmaster_TIMEOUT;
+    }
+    return CO_LSSmaster_WAIT_SLAVE;
+#else
+    return CO_LSSmaster_check_timeout(LSSmaster, timeDifference_us);
+#endif
+}
+
 
 /******************************************************************************/
 CO_ReturnError_t CO_LSSmaster_init(
@@ -151,6 +209,9 @@ CO_ReturnError_t CO_LSSmaster_init(
     LSSmaster->pFunctSignal = NULL;
     LSSmaster->functSignalObject = NULL;
 #endif
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI
+    CO_LSSmaster_FsSessionReset(LSSmaster);
+#endif
 
     /* configure LSS CAN Slave response message reception */
     ret = CO_CANrxBufferInit(
@@ -187,6 +248,9 @@ void CO_LSSmaster_changeTimeout(
 {
     if (LSSmaster != NULL) {
         LSSmaster->timeout_us = (uint32_t)timeout_ms * 1000;
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI
+        CO_LSSmaster_FsSessionReset(LSSmaster);
+#endif
     }
 }
 
@@ -754,6 +818,9 @@ static void CO_LSSmaster_FsSendMsg(
         uint8_t                 lssNext)
 {
     LSSmaster->timeoutTimer = 0;
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI
+    LSSmaster->fsRxSeen = false;
+#endif
 
     CO_FLAG_CLEAR(LSSmaster->CANrxNew);
     LSSmaster->TXbuff->data[0] = CO_LSS_IDENT_FASTSCAN;
@@ -774,7 +841,7 @@ static CO_LSSmaster_return_t CO_LSSmaster_FsCheckWait(
 {
     CO_LSSmaster_return_t ret;
 
-    ret = CO_LSSmaster_check_timeout(LSSmaster, timeDifference_us);
+    ret = CO_LSSmaster_FsCheckTimeout(LSSmaster, timeDifference_us);
     if (ret == CO_LSSmaster_TIMEOUT) {
         ret = CO_LSSmaster_SCAN_NOACK;
 
@@ -847,7 +914,7 @@ static CO_LSSmaster_return_t CO_LSSmaster_FsScanWait(
             return CO_LSSmaster_SCAN_FAILED;
     }
 
-    ret = CO_LSSmaster_check_timeout(LSSmaster, timeDifference_us);
+    ret = CO_LSSmaster_FsCheckTimeout(LSSmaster, timeDifference_us);
     if (ret == CO_LSSmaster_TIMEOUT) {
 
         ret = CO_LSSmaster_WAIT_SLAVE;
@@ -932,7 +999,7 @@ static CO_LSSmaster_return_t CO_LSSmaster_FsVerifyWait(
         return CO_LSSmaster_SCAN_FAILED;
     }
 
-    ret = CO_LSSmaster_check_timeout(LSSmaster, timeDifference_us);
+    ret = CO_LSSmaster_FsCheckTimeout(LSSmaster, timeDifference_us);
     if (ret == CO_LSSmaster_TIMEOUT) {
 
         *idNumberRet = 0;
@@ -976,6 +1043,74 @@ static CO_LSS_fastscan_lss_sub_next CO_LSSmaster_FsSearchNext(
     return CO_LSS_FASTSCAN_VENDOR_ID;
 }
 
+/*
+ * Helper function - initiate identification of 32 bit part of LSS address
+ *
+ * If possible, value from the previously found node is verified first,
+ * otherwise scan is initiated.
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_FsPartInitiate(
+        CO_LSSmaster_t                  *LSSmaster,
+        uint32_t                         timeDifference_us,
+        const CO_LSSmaster_fastscan_t   *fastscan,
+        CO_LSS_fastscan_lss_sub_next     lssSub)
+{
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI
+    if (fastscan->scan[lssSub] == CO_LSSmaster_FS_SCAN
+        && LSSmaster->fsPrevValid && lssSub != CO_LSS_FASTSCAN_SERIAL
+    ) {
+        LSSmaster->fsLssSub = lssSub;
+        LSSmaster->fsIdNumber = LSSmaster->fsPrev.addr[lssSub];
+        LSSmaster->fsBitChecked = CO_LSS_FASTSCAN_BIT0;
+        CO_LSSmaster_FsSendMsg(LSSmaster, LSSmaster->fsIdNumber,
+            LSSmaster->fsBitChecked, LSSmaster->fsLssSub,
+            CO_LSSmaster_FsSearchNext(LSSmaster, fastscan));
+
+        LSSmaster->fsState = CO_LSSmaster_FS_STATE_VERIFY_PREV;
+        return CO_LSSmaster_WAIT_SLAVE;
+    }
+#endif
+
+    LSSmaster->fsState = CO_LSSmaster_FS_STATE_SCAN;
+    return CO_LSSmaster_FsScanInitiate(LSSmaster, timeDifference_us,
+                                       fastscan->scan[lssSub], lssSub);
+}
+
+/*
+ * Helper function - 32 bit part of LSS address is verified, node(s) have
+ * switched their state machine. Continue with next part or finish.
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_FsVerified(
+        CO_LSSmaster_t                  *LSSmaster,
+        uint32_t                         timeDifference_us,
+        CO_LSSmaster_fastscan_t         *fastscan)
+{
+    CO_LSSmaster_return_t ret = CO_LSSmaster_SCAN_FINISHED;
+    CO_LSS_fastscan_lss_sub_next next;
+
+    next = CO_LSSmaster_FsSearchNext(LSSmaster, fastscan);
+    if (next == CO_LSS_FASTSCAN_VENDOR_ID) {
+        /* fastscan finished, one node is now in LSS configuration
+         * mode */
+        LSSmaster->state = CO_LSSmaster_STATE_CFG_SLECTIVE;
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI
+        LSSmaster->fsPrev = fastscan->found;
+        LSSmaster->fsPrevValid = true;
+#endif
+    }
+    else {
+        /* initiate identification of next part of LSS address */
+        ret = CO_LSSmaster_FsPartInitiate(LSSmaster, timeDifference_us,
+                                          fastscan, next);
+        if (ret == CO_LSSmaster_SCAN_FINISHED) {
+            /* Scanning is not requested. Initiate verification
+             * step in next function call */
+            ret = CO_LSSmaster_WAIT_SLAVE;
+        }
+    }
+    return ret;
+}
+
 /******************************************************************************/
 CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscan(
         CO_LSSmaster_t          *LSSmaster,
@@ -985,7 +1120,6 @@ CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscan(
     uint8_t i;
     uint8_t count;
     CO_LSSmaster_return_t ret = CO_LSSmaster_INVALID_STATE;
-    CO_LSS_fastscan_lss_sub_next next;
 
     /* parameter validation */
     if (LSSmaster==NULL || fastscan==NULL){
@@ -1050,12 +1184,9 @@ CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscan(
                 memset(&fastscan->found, 0, sizeof(fastscan->found));
 
                 /* start scanning procedure by triggering vendor ID scan */
-                CO_LSSmaster_FsScanInitiate(LSSmaster, timeDifference_us,
-                      fastscan->scan[CO_LSS_FASTSCAN_VENDOR_ID],
-                      CO_LSS_FASTSCAN_VENDOR_ID);
+                CO_LSSmaster_FsPartInitiate(LSSmaster, timeDifference_us,
+                      fastscan, CO_LSS_FASTSCAN_VENDOR_ID);
                 ret = CO_LSSmaster_WAIT_SLAVE;
-
-                LSSmaster->fsState = CO_LSSmaster_FS_STATE_SCAN;
             }
             break;
         case CO_LSSmaster_FS_STATE_SCAN:
@@ -1065,6 +1196,7 @@ CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscan(
                 /* scanning finished, initiate verifcation. The verification
                  * message also contains the node state machine "switch to
                  * next state" request */
+                CO_LSS_fastscan_lss_sub_next next;
                 next = CO_LSSmaster_FsSearchNext(LSSmaster, fastscan);
                 ret = CO_LSSmaster_FsVerifyInitiate(LSSmaster, timeDifference_us,
                           fastscan->scan[LSSmaster->fsLssSub],
@@ -1082,26 +1214,29 @@ CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscan(
                  * - assumed node id is correct
                  * - node state machine has switched to the requested state,
                  *   mirror that in the local copy */
-                next = CO_LSSmaster_FsSearchNext(LSSmaster, fastscan);
-                if (next == CO_LSS_FASTSCAN_VENDOR_ID) {
-                    /* fastscan finished, one node is now in LSS configuration
-                     * mode */
-                    LSSmaster->state = CO_LSSmaster_STATE_CFG_SLECTIVE;
-                }
-                else {
-                    /* initiate scan for next part of LSS address */
-                    ret = CO_LSSmaster_FsScanInitiate(LSSmaster,
-                              timeDifference_us, fastscan->scan[next], next);
-                    if (ret == CO_LSSmaster_SCAN_FINISHED) {
-                        /* Scanning is not requested. Initiate verification
-                         * step in next function call */
-                        ret = CO_LSSmaster_WAIT_SLAVE;
-                    }
-
-                    LSSmaster->fsState = CO_LSSmaster_FS_STATE_SCAN;
-                }
+                ret = CO_LSSmaster_FsVerified(LSSmaster, timeDifference_us,
+                                              fastscan);
+            }
+            break;
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI
+        case CO_LSSmaster_FS_STATE_VERIFY_PREV:
+            ret = CO_LSSmaster_FsVerifyWait(LSSmaster, timeDifference_us,
+                      CO_LSSmaster_FS_SCAN,
+                      &fastscan->found.addr[LSSmaster->fsLssSub]);
+            if (ret == CO_LSSmaster_SCAN_NOACK) {
+                /* no node with the same value as previous node, scan bits.
+                 * Node state machines were not switched. */
+                LSSmaster->fsState = CO_LSSmaster_FS_STATE_SCAN;
+                ret = CO_LSSmaster_FsScanInitiate(LSSmaster, timeDifference_us,
+                          fastscan->scan[LSSmaster->fsLssSub],
+                          (CO_LSS_fastscan_lss_sub_next)LSSmaster->fsLssSub);
+            }
+            else if (ret == CO_LSSmaster_SCAN_FINISHED) {
+                ret = CO_LSSmaster_FsVerified(LSSmaster, timeDifference_us,
+                                              fastscan);
             }
             break;
+#endif
         default:
             break;
     }
@@ -1113,4 +1248,103 @@ CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscan(
     return ret;
 }
 
+
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI
+/******************************************************************************/
+CO_LSSmaster_return_t CO_LSSmaster_AssignNodeIds(
+        CO_LSSmaster_t          *LSSmaster,
+        uint32_t                 timeDifference_us,
+        CO_LSSmaster_assign_t   *assign)
+{
+    CO_LSSmaster_return_t ret = CO_LSSmaster_WAIT_SLAVE;
+
+    if (LSSmaster==NULL || assign==NULL){
+        return CO_LSSmaster_ILLEGAL_ARGUMENT;
+    }
+
+    if (!assign->active) {
+        if (assign->nodeIdFirst < 1 || assign->nodeIdLast > 127
+            || assign->nodeIdFirst > assign->nodeIdLast
+        ) {
+            return CO_LSSmaster_ILLEGAL_ARGUMENT;
+        }
+        if (LSSmaster->state != CO_LSSmaster_STATE_WAITING
+            || LSSmaster->command != CO_LSSmaster_COMMAND_WAITING
+        ) {
+            return CO_LSSmaster_INVALID_STATE;
+        }
+
+        /* start new fastscan session */
+        CO_LSSmaster_FsSessionReset(LSSmaster);
+        assign->nodeId = assign->nodeIdFirst;
+        assign->nodeCount = 0;
+        assign->subState = 0;
+        assign->active = true;
+        timeDifference_us = 0;
+    }
+
+    if (assign->subState == 0) { /* select next unconfigured node */
+        ret = CO_LSSmaster_IdentifyFastscan(LSSmaster, timeDifference_us,
+                                            &assign->fastscan);
+        if (ret == CO_LSSmaster_OK || ret == CO_LSSmaster_SCAN_NOACK) {
+            /* no (more) unconfigured nodes */
+            assign->active = false;
+            return CO_LSSmaster_OK;
+        }
+        else if (ret == CO_LSSmaster_SCAN_FINISHED) {
+            assign->subState = 1;
+            timeDifference_us = 0;
+        }
+        else if (ret != CO_LSSmaster_WAIT_SLAVE) {
+            assign->active = false;
+            return ret;
+        }
+    }
+    if (assign->subState == 1) { /* configure node-ID */
+        ret = CO_LSSmaster_configureNodeId(LSSmaster, timeDifference_us,
+                                           assign->nodeId);
+        if (ret == CO_LSSmaster_OK) {
+            assign->subState = assign->store ? 2 : 3;
+            timeDifference_us = 0;
+        }
+        else if (ret != CO_LSSmaster_WAIT_SLAVE) {
+            CO_LSSmaster_switchStateDeselect(LSSmaster);
+            assign->active = false;
+            return ret;
+        }
+    }
+    if (assign->subState == 2) { /* store configuration */
+        ret = CO_LSSmaster_configureStore(LSSmaster, timeDifference_us);
+        if (ret == CO_LSSmaster_OK) {
+            assign->subState = 3;
+        }
+        else if (ret != CO_LSSmaster_WAIT_SLAVE) {
+            CO_LSSmaster_switchStateDeselect(LSSmaster);
+            assign->active = false;
+            return ret;
+        }
+    }
+    if (assign->subState == 3) { /* deselect node, continue with next */
+        uint8_t nodeIdAssigned = assign->nodeId;
+
+        CO_LSSmaster_switchStateDeselect(LSSmaster);
+        assign->nodeCount++;
+        if (assign->functAssigned != NULL) {
+            assign->functAssigned(assign->object, nodeIdAssigned,
+                                  &assign->fastscan.found);
+        }
+
+        if (nodeIdAssigned >= assign->nodeIdLast) {
+            assign->active = false;
+            return CO_LSSmaster_SCAN_FINISHED;
+        }
+        assign->nodeId++;
+        assign->subState = 0;
+        ret = CO_LSSmaster_WAIT_SLAVE;
+    }
+
+    return ret;
+}
+#endif /* (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI */
+
 #endif /* (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER */
@@ -114,6 +114,13 @@ typedef struct{
     uint8_t          fsLssSub;         /**< Current state of node state machine */
     uint8_t          fsBitChecked;     /**< Current scan bit position */
     uint32_t         fsIdNumber;       /**< Current scan result */
+#if ((CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI) || defined CO_DOXYGEN
+    uint32_t         fsLatencyMax_us;  /**< Largest measured fastscan response time in current session */
+    bool_t           fsLatencyValid;   /**< True, if fsLatencyMax_us was measured */
+    bool_t           fsRxSeen;         /**< True, if response to the current fastscan query was seen */
+    bool_t           fsPrevValid;      /**< True, if fsPrev contains address of previously found node */
+    CO_LSS_address_t fsPrev;           /**< LSS address of previously found node in current session */
+#endif
 
     volatile void   *CANrxNew;         /**< Indication if new LSS message is received from CAN bus. It needs to be cleared when received message is completely processed. */
     uint8_t          CANrxData[8];     /**< 8 data bytes of the received message */
@@ -134,6 +141,14 @@ typedef struct{
 #define CO_LSSmaster_DEFAULT_TIMEOUT 1000U /* ms */
 #endif
 
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_LSS_FASTSCAN_TIMEOUT_FACTOR
+#define CO_CONFIG_LSS_FASTSCAN_TIMEOUT_FACTOR 4
+#endif
+#ifndef CO_CONFIG_LSS_FASTSCAN_TIMEOUT_MARGIN_US
+#define CO_CONFIG_LSS_FASTSCAN_TIMEOUT_MARGIN_US 2000
+#endif
+
 
 /**
  * Initialize LSS object.
@@ -177,6 +192,10 @@ CO_ReturnError_t CO_LSSmaster_init(
  * @remark This timeout is per-transfer. If a command internally needs multiple
  * transfers to complete, this timeout is applied on each transfer.
  *
+ * With CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI fastscan queries use shorter,
+ * measured timeout, limited by this value. This function also resets the
+ * fastscan session: measured response times and previously found address.
+ *
  * @param LSSmaster This object.
  * @param timeout_ms timeout value in ms
  */
@@ -467,6 +486,63 @@ CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscan(
         uint32_t                         timeDifference_us,
         CO_LSSmaster_fastscan_t         *fastscan);
 
+
+#if ((CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI) || defined CO_DOXYGEN
+/**
+ * Parameters and state for #CO_LSSmaster_AssignNodeIds
+ *
+ * Fields from fastscan to object must be set by the application before the
+ * first call. Other fields are set by CO_LSSmaster_AssignNodeIds().
+ */
+typedef struct {
+    CO_LSSmaster_fastscan_t fastscan; /**< Fastscan parameters, see #CO_LSSmaster_IdentifyFastscan. found contains address of the last configured node */
+    uint8_t         nodeIdFirst;      /**< Node-ID assigned to the first found node, 1..127 */
+    uint8_t         nodeIdLast;       /**< Last node-ID, which may be assigned, nodeIdFirst..127 */
+    bool_t          store;            /**< If true, configuration is stored in each node */
+    /** Callback called after node-ID is assigned to the node, may be NULL */
+    void          (*functAssigned)(void *object, uint8_t nodeId,
+                                   const CO_LSS_address_t *lssAddress);
+    void           *object;           /**< Pointer to object passed to functAssigned */
+    uint8_t         nodeId;           /**< Node-ID, which will be assigned to the next found node */
+    uint8_t         nodeCount;        /**< Number of configured nodes */
+    uint8_t         subState;         /**< Internal state */
+    bool_t          active;           /**< True, if assignment is in progress */
+} CO_LSSmaster_assign_t;
+
+/**
+ * Assign consecutive node-IDs to all unconfigured nodes
+ *
+ * Function repeats following steps in one fastscan session: select a node with
+ * #CO_LSSmaster_IdentifyFastscan, configure node-ID with
+ * #CO_LSSmaster_configureNodeId, optionally store configuration with
+ * #CO_LSSmaster_configureStore and deselect the node. Node-IDs from
+ * nodeIdFirst up to nodeIdLast are assigned in order of identification.
+ *
+ * Nodes with identical vendor-ID, product-code and revision-number are
+ * identified faster, because those values are only verified for the next
+ * node, only serial number is scanned bit by bit.
+ *
+ * This function needs that no node is selected when starting.
+ *
+ * Function must be called cyclically until it returns != #CO_LSSmaster_WAIT_SLAVE.
+ * Function is non-blocking.
+ *
+ * @param LSSmaster This object.
+ * @param timeDifference_us Time difference from previous function call in
+ * [microseconds]. Zero when request is started.
+ * @param assign Parameters and state of assignment.
+ * @return #CO_LSSmaster_ILLEGAL_ARGUMENT, #CO_LSSmaster_INVALID_STATE,
+ * #CO_LSSmaster_WAIT_SLAVE, #CO_LSSmaster_OK (all unconfigured nodes were
+ * configured), #CO_LSSmaster_SCAN_FINISHED (nodeIdLast was assigned, there
+ * may be more unconfigured nodes) or other error code from the steps above.
+ * Number of configured nodes is in assign->nodeCount.
+ */
+CO_LSSmaster_return_t CO_LSSmaster_AssignNodeIds(
+        CO_LSSmaster_t                  *LSSmaster,
+        uint32_t                         timeDifference_us,
+        CO_LSSmaster_assign_t           *assign);
+#endif /* (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI */
+
 /** @} */ /*@defgroup CO_LSSmaster*/
 
 #ifdef __cplusplus
@@ -106,6 +106,9 @@ CO_ReturnError_t CO_GTWA_init(CO_GTWA_t* gtwa,
     gtwa->node_default = -1;
     gtwa->state = CO_GTWA_ST_IDLE;
     gtwa->respHold = false;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI
+    gtwa->SDOchannelRespOwner = CO_GTWA_SDO_CHANNEL_NONE;
+#endif
 
     CO_fifo_init(&gtwa->commFifo,
                  &gtwa->commBuf[0],
@@ -136,6 +139,45 @@ void CO_GTWA_initRead(CO_GTWA_t* gtwa,
 }
 
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI
+/******************************************************************************/
+CO_ReturnError_t CO_GTWA_initSDOchannels(CO_GTWA_t* gtwa,
+                                         CO_SDOclient_t* SDO_C,
+                                         uint8_t count)
+{
+    uint8_t i;
+
+    if (gtwa == NULL || (SDO_C == NULL && count > 0)) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    if (count > CO_CONFIG_GTWA_SDO_CHANNELS) {
+        count = CO_CONFIG_GTWA_SDO_CHANNELS;
+    }
+
+    memset(gtwa->SDOchannels, 0, sizeof(gtwa->SDOchannels));
+    for (i = 0; i < count; i++) {
+        gtwa->SDOchannels[i].SDO_C = &SDO_C[i];
+        gtwa->SDOchannels[i].state = CO_GTWA_ST_IDLE;
+    }
+    gtwa->SDOchannelsCount = count;
+    gtwa->SDOchannelRespOwner = CO_GTWA_SDO_CHANNEL_NONE;
+
+    return CO_ERROR_NO;
+}
+#endif
+
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO) \
+    && ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE)
+/******************************************************************************/
+void CO_GTWA_initCache(CO_GTWA_t* gtwa, CO_SDOclientCache_t *cache) {
+    if (gtwa != NULL) {
+        gtwa->SDOcache = cache;
+    }
+}
+#endif
+
+
 /******************************************************************************/
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG
 void CO_GTWA_log_print(CO_GTWA_t* gtwa, const char *message) {
@@ -150,6 +192,38 @@ void CO_GTWA_log_print(CO_GTWA_t* gtwa, const char *message) {
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG */
 
 
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG) \
+    && ((CO_CONFIG_EVLOG) & CO_CONFIG_EVLOG_ENABLE)
+/******************************************************************************/
+void CO_GTWA_initEventLog(CO_GTWA_t* gtwa, CO_eventLog_t *evlog) {
+    if (gtwa != NULL) {
+        gtwa->evlog = evlog;
+    }
+}
+
+/* Record event into event log, if used */
+static void evlogPut(CO_GTWA_t *gtwa, uint8_t type, uint8_t nodeId,
+                     uint16_t arg16, uint8_t arg8, uint32_t arg32)
+{
+    if (gtwa->evlog != NULL) {
+        CO_eventLog_record_t rec;
+
+        memset(&rec, 0, sizeof(rec));
+        rec.type = type;
+        rec.nodeId = nodeId;
+        rec.arg16 = arg16;
+        rec.arg8[0] = arg8;
+        rec.arg32 = arg32;
+        CO_eventLog_put(gtwa->evlog, &rec);
+    }
+}
+#define EVLOG_PUT(gtwa, type, nodeId, arg16, arg8, arg32) \
+    evlogPut(gtwa, type, nodeId, arg16, arg8, arg32)
+#else
+#define EVLOG_PUT(gtwa, type, nodeId, arg16, arg8, arg32)
+#endif
+
+
 /*******************************************************************************
  * HELPER FUNCTIONS
  ******************************************************************************/
@@ -401,6 +475,102 @@ static bool_t respBufTransfer(CO_GTWA_t *gtwa) {
 }
 
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+/* Offset of response data in binary response frame */
+#define BIN_DATA_OFFSET (CO_GTWA_BIN_HEADER_SIZE + 4U)
+
+/* Write header and result of binary response frame into respBuf. dataSize
+ * bytes of data must be already in respBuf at BIN_DATA_OFFSET. */
+static void binResponse(CO_GTWA_t *gtwa, uint32_t result,
+                        size_t dataSize, bool_t more)
+{
+    uint8_t *r = (uint8_t *)gtwa->respBuf;
+    uint16_t len = (uint16_t)(dataSize + 4U);
+
+    r[0] = CO_GTWA_BIN_SOF;
+    r[1] = gtwa->binCmd | CO_GTWA_BIN_RESPONSE | (more ? CO_GTWA_BIN_MORE : 0);
+    CO_setUint16(&r[2], len);
+    CO_setUint32(&r[4], gtwa->sequence);
+    CO_setUint16(&r[8], gtwa->net);
+    r[10] = gtwa->node;
+    r[11] = 0;
+    CO_setUint32(&r[12], result);
+    gtwa->respBufCount = CO_GTWA_BIN_HEADER_SIZE + len;
+}
+
+/* Send binary response with result only, if current command is binary.
+ * Return true, if response was sent. */
+static bool_t binResponseResult(CO_GTWA_t *gtwa, uint32_t result) {
+    if (!gtwa->binary) {
+        return false;
+    }
+    binResponse(gtwa, result, 0, false);
+    respBufTransfer(gtwa);
+    return true;
+}
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+/* Copy data from fifo to fifo without modification, or purge them, if dest is
+ * NULL. Return number of bytes copied. */
+static size_t binCopy(CO_fifo_t *dest, CO_fifo_t *src, size_t count) {
+    CO_fifo_span_t span[2];
+    size_t copied = 0;
+    int i;
+
+    CO_fifo_getReadSpans(src, span);
+    for (i = 0; i < 2 && copied < count; i++) {
+        size_t n = count - copied;
+
+        if (n > span[i].len) {
+            n = span[i].len;
+        }
+        if (dest != NULL) {
+            n = CO_fifo_write(dest, span[i].ptr, n, NULL);
+        }
+        copied += n;
+        if (n < span[i].len) {
+            break;
+        }
+    }
+    CO_fifo_advanceRead(src, copied, NULL);
+    return copied;
+}
+#endif
+
+/* Copy data from the beginning of fifo without reading them */
+static size_t binPeek(CO_fifo_t *fifo, uint8_t *buf, size_t count) {
+    CO_fifo_span_t span[2];
+    size_t n0;
+
+    if (count > CO_fifo_getReadSpans(fifo, span)) {
+        count = span[0].len + span[1].len;
+    }
+    n0 = count < span[0].len ? count : span[0].len;
+    memcpy(buf, span[0].ptr, n0);
+    memcpy(&buf[n0], span[1].ptr, count - n0);
+    return count;
+}
+
+/* True, if binary frame on the beginning of command fifo is ready to parse */
+static bool_t binFrameReady(CO_GTWA_t *gtwa) {
+    uint8_t h[CO_GTWA_BIN_HEADER_SIZE];
+    size_t len;
+
+    if (binPeek(&gtwa->commFifo, h, sizeof(h)) < sizeof(h)
+        || h[0] != CO_GTWA_BIN_SOF
+    ) {
+        return false;
+    }
+    len = CO_getUint16(&h[2]);
+    if (h[1] == CO_GTWA_BIN_WRITE && len > 3) {
+        len = 3;
+    }
+    return len > CO_GTWA_BIN_PAYLOAD_MAX
+        || CO_fifo_getOccupied(&gtwa->commFifo) >= (sizeof(h) + len);
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY */
+
+
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ERROR_DESC
 #ifndef CO_CONFIG_GTW_ASCII_ERROR_DESC_STRINGS
 #define CO_CONFIG_GTW_ASCII_ERROR_DESC_STRINGS
@@ -483,6 +653,11 @@ static void responseWithError(CO_GTWA_t *gtwa,
     int len = sizeof(errorDescs) / sizeof(errorDescs_t);
     const char *desc = "-";
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    if (binResponseResult(gtwa, (uint32_t)respErrorCode)) {
+        return;
+    }
+#endif
     for (i = 0; i < len; i++) {
         const errorDescs_t *ed = &errorDescs[i];
         if((CO_GTWA_respErrorCode_t)ed->code == respErrorCode) {
@@ -505,6 +680,13 @@ static void responseWithErrorSDO(CO_GTWA_t *gtwa,
     int len = sizeof(errorDescsSDO) / sizeof(errorDescs_t);
     const char *desc = "-";
 
+    EVLOG_PUT(gtwa, CO_EVLOG_SDO_ABORT, gtwa->node, gtwa->SDOidx,
+              gtwa->SDOsubidx, (uint32_t)abortCode);
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    if (binResponseResult(gtwa, (uint32_t)abortCode)) {
+        return;
+    }
+#endif
     for (i = 0; i < len; i++) {
         const errorDescs_t *ed = &errorDescsSDO[i];
         if((CO_SDO_abortCode_t)ed->code == abortCode) {
@@ -531,6 +713,11 @@ static void responseWithErrorSDO(CO_GTWA_t *gtwa,
 static inline void responseWithError(CO_GTWA_t *gtwa,
                                      CO_GTWA_respErrorCode_t respErrorCode)
 {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    if (binResponseResult(gtwa, (uint32_t)respErrorCode)) {
+        return;
+    }
+#endif
     gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
                                   "[%"PRId32"] ERROR:%d\r\n",
                                   gtwa->sequence, respErrorCode);
@@ -542,6 +729,13 @@ static inline void responseWithErrorSDO(CO_GTWA_t *gtwa,
                                         CO_SDO_abortCode_t abortCode,
                                         bool_t postponed)
 {
+    EVLOG_PUT(gtwa, CO_EVLOG_SDO_ABORT, gtwa->node, gtwa->SDOidx,
+              gtwa->SDOsubidx, (uint32_t)abortCode);
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    if (binResponseResult(gtwa, (uint32_t)abortCode)) {
+        return;
+    }
+#endif
     if (!postponed) {
         gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
                                       "[%"PRId32"] ERROR:0x%08X\r\n",
@@ -552,64 +746,819 @@ static inline void responseWithErrorSDO(CO_GTWA_t *gtwa,
                                       "\n...ERROR:0x%08X\r\n",
                                       abortCode);
     }
-
-    respBufTransfer(gtwa);
+
+    respBufTransfer(gtwa);
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ERROR_DESC */
+
+
+static inline void responseWithOK(CO_GTWA_t *gtwa) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    if (binResponseResult(gtwa, 0)) {
+        return;
+    }
+#endif
+    gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
+                                  "[%"PRId32"] OK\r\n",
+                                  gtwa->sequence);
+    respBufTransfer(gtwa);
+}
+
+
+static inline void responseWithEmpty(CO_GTWA_t *gtwa) {
+    gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
+                                  "\r\n");
+    respBufTransfer(gtwa);
+}
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS
+static void responseLSS(CO_GTWA_t *gtwa, CO_LSSmaster_return_t lss_ret) {
+    if (lss_ret == CO_LSSmaster_OK) {
+        responseWithOK(gtwa);
+    }
+    else {
+        CO_GTWA_respErrorCode_t respErrorCode;
+
+        if (lss_ret==CO_LSSmaster_TIMEOUT || lss_ret==CO_LSSmaster_SCAN_NOACK) {
+            respErrorCode = CO_GTWA_respErrorTimeOut;
+        }
+        else if (lss_ret == CO_LSSmaster_OK_MANUFACTURER) {
+            respErrorCode = CO_GTWA_respErrorLSSmanufacturer;
+        }
+        else {
+            respErrorCode = CO_GTWA_respErrorInternalState;
+        }
+        responseWithError(gtwa, respErrorCode);
+    }
+}
+#endif
+
+
+static inline void convertToLower(char *token, size_t maxCount) {
+    size_t i;
+    char *c = &token[0];
+
+    for (i = 0; i < maxCount; i++) {
+        if (*c == 0) {
+            break;
+        } else {
+            *c = (char)tolower((int)*c);
+        }
+        c++;
+    }
+}
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+/* Setup SDO client and initiate SDO transfer with parameters from gtwa->SDOidx,
+ * SDOsubidx and SDOupload. For download also copy (the first part of) data
+ * from commFifo into SDO buffer. Return true on error. */
+static bool_t SDOstart(CO_GTWA_t *gtwa,
+                       CO_GTWA_respErrorCode_t *respErrorCode,
+                       int8_t *closed)
+{
+    CO_SDO_return_t SDO_ret;
+    size_t size;
+
+    /* setup client */
+    SDO_ret = CO_SDOclient_setup(gtwa->SDO_C,
+                                 CO_CAN_ID_SDO_CLI + gtwa->node,
+                                 CO_CAN_ID_SDO_SRV + gtwa->node,
+                                 gtwa->node);
+    if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
+        *respErrorCode = CO_GTWA_respErrorInternalState;
+        return true;
+    }
+
+    /* initiate upload */
+    if (gtwa->SDOupload) {
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE
+        uint8_t buf[CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE];
+
+        if (CO_SDOclientCache_lookup(gtwa->SDOcache, gtwa->node,
+                                     gtwa->SDOidx, gtwa->SDOsubidx,
+                                     buf, sizeof(buf), &size)
+        ) {
+            /* response from the cache, no SDO communication */
+            CO_fifo_reset(&gtwa->SDO_C->bufFifo);
+            if (CO_fifo_write(&gtwa->SDO_C->bufFifo, buf, size, NULL) == size) {
+                gtwa->SDOdataCopyStatus = false;
+                gtwa->state = CO_GTWA_ST_READ_CACHED;
+                return false;
+            }
+        }
+#endif
+        SDO_ret = CO_SDOclientUploadInitiate(gtwa->SDO_C,
+                                             gtwa->SDOidx, gtwa->SDOsubidx,
+                                             gtwa->SDOtimeoutTime,
+                                             gtwa->SDOblockTransferEnable);
+        if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
+            *respErrorCode = CO_GTWA_respErrorInternalState;
+            return true;
+        }
+
+        /* indicate that gateway response didn't start yet */
+        gtwa->SDOdataCopyStatus = false;
+        gtwa->state = CO_GTWA_ST_READ;
+        return false;
+    }
+
+    /* initiate download */
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE
+    CO_SDOclientCache_invalidate(gtwa->SDOcache, gtwa->node);
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    size = gtwa->binary ? gtwa->binRemain : gtwa->SDOdataType->length;
+#else
+    size = gtwa->SDOdataType->length;
+#endif
+    SDO_ret = CO_SDOclientDownloadInitiate(gtwa->SDO_C,
+                                           gtwa->SDOidx, gtwa->SDOsubidx,
+                                           size,
+                                           gtwa->SDOtimeoutTime,
+                                           gtwa->SDOblockTransferEnable);
+    if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
+        *respErrorCode = CO_GTWA_respErrorInternalState;
+        return true;
+    }
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    if (gtwa->binary) {
+        /* copy available raw data, rest is copied in state machine */
+        gtwa->binRemain -= binCopy(&gtwa->SDO_C->bufFifo,
+                                   &gtwa->commFifo, gtwa->binRemain);
+        gtwa->SDOdataCopyStatus = gtwa->binRemain > 0;
+    }
+    else
+#endif
+    {
+        CO_fifo_st status;
+
+        /* copy data from comm to the SDO buffer, according to data type */
+        size = gtwa->SDOdataType->dataTypeScan(&gtwa->SDO_C->bufFifo,
+                                               &gtwa->commFifo,
+                                               &status);
+        /* set to true, if command delimiter was found */
+        *closed = ((status & CO_fifo_st_closed) == 0) ? 0 : 1;
+        /* set to true, if data are copied only partially */
+        gtwa->SDOdataCopyStatus = (status & CO_fifo_st_partial) != 0;
+
+        /* is syntax error in command or size is zero or not the last token
+         * in command */
+        if ((status & CO_fifo_st_errMask) != 0 || size == 0
+            || (gtwa->SDOdataCopyStatus == false && *closed != 1)
+        ) {
+            return true;
+        }
+
+        /* if data size was not known before and is known now, update SDO */
+        if (gtwa->SDOdataType->length == 0 && !gtwa->SDOdataCopyStatus) {
+            CO_SDOclientDownloadInitiateSize(gtwa->SDO_C, size);
+        }
+    }
+
+    gtwa->stateTimeoutTmr = 0;
+    gtwa->state = CO_GTWA_ST_WRITE;
+    return false;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI
+/* Exchange context of the current command with the SDO channel */
+#define SWAP(type, a, b) { type tmp = a; a = b; b = tmp; }
+static void SDOchannelSwap(CO_GTWA_t *gtwa, CO_GTWA_SDOchannel_t *ch) {
+    SWAP(uint32_t, gtwa->sequence, ch->sequence);
+    SWAP(uint16_t, gtwa->net, ch->net);
+    SWAP(uint8_t, gtwa->node, ch->node);
+    SWAP(CO_GTWA_state_t, gtwa->state, ch->state);
+    SWAP(uint32_t, gtwa->stateTimeoutTmr, ch->stateTimeoutTmr);
+    SWAP(CO_SDOclient_t *, gtwa->SDO_C, ch->SDO_C);
+    SWAP(bool_t, gtwa->SDOdataCopyStatus, ch->SDOdataCopyStatus);
+    SWAP(const CO_GTWA_dataType_t *, gtwa->SDOdataType, ch->SDOdataType);
+    SWAP(uint16_t, gtwa->SDOidx, ch->SDOidx);
+    SWAP(uint8_t, gtwa->SDOsubidx, ch->SDOsubidx);
+    SWAP(bool_t, gtwa->SDOupload, ch->SDOupload);
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+    SWAP(bool_t, gtwa->binary, ch->binary);
+    SWAP(uint8_t, gtwa->binCmd, ch->binCmd);
+    SWAP(size_t, gtwa->binRemain, ch->binRemain);
+#endif
+}
+
+/* True, if SDO server on gtwa->node is busy with transfer in other channel */
+static bool_t SDOnodeBusy(CO_GTWA_t *gtwa) {
+    uint8_t i;
+
+    for (i = 0; i < gtwa->SDOchannelsCount; i++) {
+        CO_GTWA_SDOchannel_t *ch = &gtwa->SDOchannels[i];
+        if (ch->state != CO_GTWA_ST_IDLE && ch->node == gtwa->node) {
+            return true;
+        }
+    }
+    return false;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+/* Parse binary framed commands from the beginning of commFifo, see
+ * @ref CO_CANopen_309_3_Binary. Return false, if there is no binary frame on
+ * the beginning of commFifo, so ASCII command may be parsed. Return true, if
+ * parser must stop: frame is incomplete, error or command continues in state
+ * machine. */
+static bool_t binaryCommand(CO_GTWA_t *gtwa,
+                            bool_t *err,
+                            int8_t *closed,
+                            CO_GTWA_respErrorCode_t *respErrorCode,
+                            uint32_t *timeDifference_us)
+{
+    uint8_t fr[CO_GTWA_BIN_HEADER_SIZE + CO_GTWA_BIN_PAYLOAD_MAX];
+    const uint8_t *pl = &fr[CO_GTWA_BIN_HEADER_SIZE];
+
+    (void)pl; (void)timeDifference_us; /* may be unused */
+
+    while (gtwa->state == CO_GTWA_ST_IDLE && !gtwa->respHold) {
+        size_t count = binPeek(&gtwa->commFifo, fr, sizeof(fr));
+        size_t len, need;
+        uint16_t netRaw;
+        int32_t net;
+        int16_t node;
+
+        if (count == 0 || fr[0] != CO_GTWA_BIN_SOF) {
+            return false;
+        }
+        /* binary frame does not need command delimiter */
+        *closed = 1;
+        if (count < CO_GTWA_BIN_HEADER_SIZE) {
+            return true;
+        }
+
+        gtwa->binary = true;
+        gtwa->binCmd = fr[1];
+        gtwa->sequence = CO_getUint32(&fr[4]);
+        len = CO_getUint16(&fr[2]);
+
+        /* WRITE data are copied later, other payload must be complete */
+        if (gtwa->binCmd == CO_GTWA_BIN_WRITE) {
+            need = len < 3 ? len : 3;
+        }
+        else if (len > CO_GTWA_BIN_PAYLOAD_MAX) {
+            /* framing error, clear all to resynchronize */
+            CO_fifo_reset(&gtwa->commFifo);
+            *respErrorCode = CO_GTWA_respErrorRunningOutOfMemory;
+            *err = true;
+            return true;
+        }
+        else {
+            need = len;
+        }
+        if (count < (CO_GTWA_BIN_HEADER_SIZE + need)) {
+            return true;
+        }
+        CO_fifo_read(&gtwa->commFifo, fr, CO_GTWA_BIN_HEADER_SIZE + need, NULL);
+        gtwa->binRemain = len - need;
+
+        netRaw = CO_getUint16(&fr[8]);
+        net = netRaw == 0xFFFF ? gtwa->net_default : (int32_t)netRaw;
+        node = fr[10] == 0xFF ? gtwa->node_default : (int16_t)fr[10];
+        (void)net; (void)node; /* may be unused */
+
+        switch (gtwa->binCmd) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+        case CO_GTWA_BIN_READ:
+        case CO_GTWA_BIN_WRITE: {
+            gtwa->SDOupload = gtwa->binCmd == CO_GTWA_BIN_READ;
+
+            if ((gtwa->SDOupload ? len != 3 : len <= 3)
+                || checkNetNode(gtwa, net, node, 1, respErrorCode)
+            ) {
+                *err = true;
+                break;
+            }
+            gtwa->SDOidx = CO_getUint16(&pl[0]);
+            gtwa->SDOsubidx = pl[2];
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI
+            if (SDOnodeBusy(gtwa)) {
+                /* wait for other SDO channel to finish with the same node */
+                gtwa->state = CO_GTWA_ST_SDO_WAIT;
+                break;
+            }
+#endif
+            *err = SDOstart(gtwa, respErrorCode, closed);
+            *timeDifference_us = 0;
+            break;
+        }
+
+        case CO_GTWA_BIN_SET_SDO_TIMEOUT: {
+            uint16_t value = CO_getUint16(&pl[0]);
+            if (len != 2 || value == 0
+                || checkNet(gtwa, net, respErrorCode)
+            ) {
+                *err = true;
+                break;
+            }
+            gtwa->SDOtimeoutTime = value;
+            responseWithOK(gtwa);
+            break;
+        }
+
+        case CO_GTWA_BIN_SET_SDO_BLOCK: {
+            if (len != 1 || pl[0] > 1 || checkNet(gtwa, net, respErrorCode)) {
+                *err = true;
+                break;
+            }
+            gtwa->SDOblockTransferEnable = pl[0] == 1 ? true : false;
+            responseWithOK(gtwa);
+            break;
+        }
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_NMT
+        case CO_GTWA_BIN_NMT: {
+            CO_NMT_command_t command2 = (CO_NMT_command_t)pl[0];
+
+            if (len != 1 || checkNetNode(gtwa, net, node, 0, respErrorCode)) {
+                *err = true;
+                break;
+            }
+            if (command2 != CO_NMT_ENTER_OPERATIONAL
+                && command2 != CO_NMT_ENTER_STOPPED
+                && command2 != CO_NMT_ENTER_PRE_OPERATIONAL
+                && command2 != CO_NMT_RESET_NODE
+                && command2 != CO_NMT_RESET_COMMUNICATION
+            ) {
+                *err = true;
+                break;
+            }
+            if (CO_NMT_sendCommand(gtwa->NMT, command2, gtwa->node)
+                == CO_ERROR_NO
+            ) {
+                responseWithOK(gtwa);
+            }
+            else {
+                *respErrorCode = CO_GTWA_respErrorInternalState;
+                *err = true;
+            }
+            break;
+        }
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_NMT */
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS
+        case CO_GTWA_BIN_LSS_SWITCH_GLOB: {
+            if (len != 1 || pl[0] > 1 || checkNet(gtwa, net, respErrorCode)) {
+                *err = true;
+                break;
+            }
+            if (pl[0] == 0) {
+                /* send non-confirmed message */
+                if (CO_LSSmaster_switchStateDeselect(gtwa->LSSmaster)
+                    == CO_LSSmaster_OK
+                ) {
+                    responseWithOK(gtwa);
+                }
+                else {
+                    *respErrorCode = CO_GTWA_respErrorInternalState;
+                    *err = true;
+                }
+            }
+            else {
+                gtwa->state = CO_GTWA_ST_LSS_SWITCH_GLOB;
+            }
+            break;
+        }
+
+        case CO_GTWA_BIN_LSS_SWITCH_SEL: {
+            CO_LSS_address_t *addr = &gtwa->lssAddress;
+
+            if (len != 16 || checkNet(gtwa, net, respErrorCode)) {
+                *err = true;
+                break;
+            }
+            addr->identity.vendorID = CO_getUint32(&pl[0]);
+            addr->identity.productCode = CO_getUint32(&pl[4]);
+            addr->identity.revisionNumber = CO_getUint32(&pl[8]);
+            addr->identity.serialNumber = CO_getUint32(&pl[12]);
+            gtwa->state = CO_GTWA_ST_LSS_SWITCH_SEL;
+            break;
+        }
+
+        case CO_GTWA_BIN_LSS_SET_NODE: {
+            if (len != 1 || (pl[0] > 0x7F && pl[0] < 0xFF)
+                || checkNet(gtwa, net, respErrorCode)
+            ) {
+                *err = true;
+                break;
+            }
+            gtwa->lssNID = pl[0];
+            gtwa->state = CO_GTWA_ST_LSS_SET_NODE;
+            break;
+        }
+
+        case CO_GTWA_BIN_LSS_CONF_BITRATE: {
+            size_t maxIndex = (sizeof(CO_LSS_bitTimingTableLookup) /
+                               sizeof(CO_LSS_bitTimingTableLookup[0])) - 1;
+
+            if (len != 1 || pl[0] > maxIndex || pl[0] == 5
+                || checkNet(gtwa, net, respErrorCode)
+            ) {
+                *err = true;
+                break;
+            }
+            gtwa->lssBitrate = CO_LSS_bitTimingTableLookup[pl[0]];
+            gtwa->state = CO_GTWA_ST_LSS_CONF_BITRATE;
+            break;
+        }
+
+        case CO_GTWA_BIN_LSS_ACTIVATE_BITRATE: {
+            if (len != 2 || checkNet(gtwa, net, respErrorCode)) {
+                *err = true;
+                break;
+            }
+            /* send non-confirmed message */
+            if (CO_LSSmaster_ActivateBit(gtwa->LSSmaster, CO_getUint16(&pl[0]))
+                == CO_LSSmaster_OK
+            ) {
+                responseWithOK(gtwa);
+            }
+            else {
+                *respErrorCode = CO_GTWA_respErrorInternalState;
+                *err = true;
+            }
+            break;
+        }
+
+        case CO_GTWA_BIN_LSS_STORE: {
+            if (len != 0 || checkNet(gtwa, net, respErrorCode)) {
+                *err = true;
+                break;
+            }
+            gtwa->state = CO_GTWA_ST_LSS_STORE;
+            break;
+        }
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS */
+
+        default: {
+            *respErrorCode = CO_GTWA_respErrorReqNotSupported;
+            *err = true;
+            break;
+        }
+        } /* switch (gtwa->binCmd) */
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+        if (*err && gtwa->binRemain > 0) {
+            /* respond now and purge the rest of WRITE data in state machine */
+            if (*respErrorCode == CO_GTWA_respErrorNone) {
+                *respErrorCode = CO_GTWA_respErrorSyntax;
+            }
+            responseWithError(gtwa, *respErrorCode);
+            *respErrorCode = CO_GTWA_respErrorNone;
+            *err = false;
+            gtwa->SDOdataCopyStatus = true;
+            gtwa->state = CO_GTWA_ST_WRITE_ABORTED;
+        }
+#endif
+        if (*err) {
+            break;
+        }
+    }
+    return true;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE
+/* Store uploaded value from SDO buffer into the cache, data remain there */
+static void SDOcacheStore(CO_GTWA_t *gtwa) {
+    uint8_t buf[CO_CONFIG_SDO_CLI_CACHE_DATA_SIZE];
+    CO_fifo_span_t span[2];
+    size_t size = CO_fifo_getReadSpans(&gtwa->SDO_C->bufFifo, span);
+
+    if (size <= sizeof(buf)) {
+        memcpy(buf, span[0].ptr, span[0].len);
+        if (span[1].len > 0) {
+            memcpy(&buf[span[0].len], span[1].ptr, span[1].len);
+        }
+        CO_SDOclientCache_store(gtwa->SDOcache, gtwa->node, gtwa->SDOidx,
+                                gtwa->SDOsubidx, buf, size);
+    }
+}
+#endif
+
+
+/* Process SDO 'read' and 'write' states of the current command */
+static void SDOprocess(CO_GTWA_t *gtwa,
+                       uint32_t timeDifference_us,
+                       uint32_t *timerNext_us)
+{
+    int8_t closed;
+
+    switch (gtwa->state) {
+    /* SDO upload state */
+    case CO_GTWA_ST_READ:
+    case CO_GTWA_ST_READ_CACHED: {
+        CO_SDO_abortCode_t abortCode;
+        size_t sizeTransferred;
+        CO_SDO_return_t ret;
+
+        if (gtwa->state == CO_GTWA_ST_READ_CACHED) {
+            /* all data are already in the SDO buffer */
+            ret = CO_SDO_RT_ok_communicationEnd;
+        }
+        else {
+            ret = CO_SDOclientUpload(gtwa->SDO_C,
+                                     timeDifference_us,
+                                     false,
+                                     &abortCode,
+                                     NULL,
+                                     &sizeTransferred,
+                                     timerNext_us);
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE
+            /* store value, if it is whole inside the SDO buffer */
+            if (ret == CO_SDO_RT_ok_communicationEnd
+                && !gtwa->SDOdataCopyStatus && gtwa->SDOcache != NULL
+            ) {
+                SDOcacheStore(gtwa);
+            }
+#endif
+        }
+
+        if (ret < 0) {
+            responseWithErrorSDO(gtwa, abortCode, gtwa->SDOdataCopyStatus);
+            gtwa->state = CO_GTWA_ST_IDLE;
+        }
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+        /* Binary response, copy raw data from SDO fifo into response frames */
+        else if (gtwa->binary
+                 && (ret == CO_SDO_RT_uploadDataBufferFull
+                     || ret == CO_SDO_RT_ok_communicationEnd)
+        ) {
+            size_t fifoRemain;
+
+            gtwa->SDOdataCopyStatus = true;
+            do {
+                bool_t last;
+                size_t count = CO_fifo_read(&gtwa->SDO_C->bufFifo,
+                                (uint8_t *)&gtwa->respBuf[BIN_DATA_OFFSET],
+                                CO_GTWA_RESP_BUF_SIZE - BIN_DATA_OFFSET,
+                                NULL);
+                fifoRemain = CO_fifo_getOccupied(&gtwa->SDO_C->bufFifo);
+                last = ret == CO_SDO_RT_ok_communicationEnd && fifoRemain == 0;
+
+                binResponse(gtwa, 0, count, !last);
+                if (last) {
+                    gtwa->state = CO_GTWA_ST_IDLE;
+                }
+
+                if (respBufTransfer(gtwa) == false) {
+                    /* broken communication, send SDO abort and force finish. */
+                    if (gtwa->state == CO_GTWA_ST_READ) {
+                        abortCode = CO_SDO_AB_DATA_TRANSF;
+                        CO_SDOclientUpload(gtwa->SDO_C, 0, true, &abortCode,
+                                           NULL, NULL, NULL);
+                    }
+                    gtwa->state = CO_GTWA_ST_IDLE;
+                    break;
+                }
+            } while (gtwa->respHold == false && fifoRemain > 0);
+        }
+#endif
+        /* Response data must be read, partially or whole */
+        else if (ret == CO_SDO_RT_uploadDataBufferFull
+                 || ret == CO_SDO_RT_ok_communicationEnd
+        ) {
+            size_t fifoRemain;
+
+            /* write response head first */
+            if (!gtwa->SDOdataCopyStatus) {
+                gtwa->respBufCount = snprintf(gtwa->respBuf,
+                                              CO_GTWA_RESP_BUF_SIZE - 2,
+                                              "[%"PRId32"] ",
+                                              gtwa->sequence);
+                gtwa->SDOdataCopyStatus = true;
+            }
+
+            /* Empty SDO fifo buffer in multiple cycles. Repeat until
+             * application runs out of space (respHold) or fifo empty. */
+            do {
+                /* read SDO fifo (partially) and print specific data type as
+                 * ascii into intermediate respBuf */
+                gtwa->respBufCount += gtwa->SDOdataType->dataTypePrint(
+                    &gtwa->SDO_C->bufFifo,
+                    &gtwa->respBuf[gtwa->respBufCount],
+                    CO_GTWA_RESP_BUF_SIZE - 2 - gtwa->respBufCount,
+                    ret == CO_SDO_RT_ok_communicationEnd);
+                fifoRemain = CO_fifo_getOccupied(&gtwa->SDO_C->bufFifo);
+
+                /* end of communication, print newline and enter idle state */
+                if (ret == CO_SDO_RT_ok_communicationEnd && fifoRemain == 0) {
+                    gtwa->respBufCount +=
+                        sprintf(&gtwa->respBuf[gtwa->respBufCount], "\r\n");
+                    gtwa->state = CO_GTWA_ST_IDLE;
+                }
+
+                /* transfer response to the application */
+                if (respBufTransfer(gtwa) == false) {
+                    /* broken communication, send SDO abort and force finish. */
+                    if (gtwa->state == CO_GTWA_ST_READ) {
+                        abortCode = CO_SDO_AB_DATA_TRANSF;
+                        CO_SDOclientUpload(gtwa->SDO_C,
+                                           0,
+                                           true,
+                                           &abortCode,
+                                           NULL,
+                                           NULL,
+                                           NULL);
+                    }
+                    gtwa->state = CO_GTWA_ST_IDLE;
+                    break;
+                }
+            } while (gtwa->respHold == false && fifoRemain > 0);
+        }
+        break;
+    }
+
+    /* SDO download state */
+    case CO_GTWA_ST_WRITE:
+    case CO_GTWA_ST_WRITE_ABORTED: {
+        CO_SDO_abortCode_t abortCode;
+        size_t sizeTransferred;
+        bool_t abort = false;
+        bool_t hold = false;
+        CO_SDO_return_t ret;
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+        /* copy remaining raw data of the binary frame to the SDO buffer */
+        if (gtwa->binary) {
+            if (gtwa->state == CO_GTWA_ST_WRITE_ABORTED) {
+                /* purge the rest of the frame */
+                gtwa->binRemain -= binCopy(NULL, &gtwa->commFifo,
+                                           gtwa->binRemain);
+                if (gtwa->binRemain == 0) {
+                    gtwa->state = CO_GTWA_ST_IDLE;
+                }
+                break;
+            }
+            if (gtwa->binRemain > 0) {
+                gtwa->binRemain -= binCopy(&gtwa->SDO_C->bufFifo,
+                                           &gtwa->commFifo, gtwa->binRemain);
+                gtwa->SDOdataCopyStatus = gtwa->binRemain > 0;
+            }
+        }
+        else
+#endif
+        /* copy data to the SDO buffer if previous dataTypeScan was partial */
+        if (gtwa->SDOdataCopyStatus) {
+            CO_fifo_st status;
+            gtwa->SDOdataType->dataTypeScan(&gtwa->SDO_C->bufFifo,
+                                            &gtwa->commFifo,
+                                            &status);
+            /* set to true, if command delimiter was found */
+            closed = ((status & CO_fifo_st_closed) == 0) ? 0 : 1;
+            /* set to true, if data are copied only partially */
+            gtwa->SDOdataCopyStatus = (status & CO_fifo_st_partial) != 0;
+
+            /* is syntax error in command or not the last token in command */
+            if ((status & CO_fifo_st_errMask) != 0
+                || (gtwa->SDOdataCopyStatus == false && closed != 1)
+            ) {
+                abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+                abort = true; /* abort SDO communication */
+                /* clear the rest of the command, if necessary */
+                if (closed != 1)
+                    CO_fifo_CommSearch(&gtwa->commFifo, true);
+            }
+            if (gtwa->state == CO_GTWA_ST_WRITE_ABORTED) {
+                /* Stay in this state, until all data transferred via commFifo
+                 * will be purged. */
+                if (!CO_fifo_purge(&gtwa->SDO_C->bufFifo) || closed == 1) {
+                    gtwa->state = CO_GTWA_ST_IDLE;
+                }
+                break;
+            }
+        }
+        /* If not all data were transferred, make sure, there is enough data in
+         * SDO buffer, to continue communication. Otherwise wait and check for
+         * timeout */
+        if (gtwa->SDOdataCopyStatus
+            && CO_fifo_getOccupied(&gtwa->SDO_C->bufFifo) <
+               (CO_CONFIG_GTW_BLOCK_DL_LOOP * 7)
+        ) {
+            if (gtwa->stateTimeoutTmr > CO_GTWA_STATE_TIMEOUT_TIME_US) {
+                abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+                abort = true;
+            }
+            else {
+                gtwa->stateTimeoutTmr += timeDifference_us;
+                hold = true;
+            }
+        }
+        if (!hold || abort) {
+            /* if OS has CANtx queue, speedup block transfer */
+            int loop = 0;
+            do {
+                ret = CO_SDOclientDownload(gtwa->SDO_C,
+                                           timeDifference_us,
+                                           abort,
+                                           gtwa->SDOdataCopyStatus,
+                                           &abortCode,
+                                           &sizeTransferred,
+                                           timerNext_us);
+                if (++loop >= CO_CONFIG_GTW_BLOCK_DL_LOOP) {
+                    break;
+                }
+            } while (ret == CO_SDO_RT_blockDownldInProgress);
+
+            /* send response in case of error or finish */
+            if (ret < 0) {
+                responseWithErrorSDO(gtwa, abortCode, false);
+                /* purge remaining data if necessary */
+                gtwa->state = gtwa->SDOdataCopyStatus
+                              ? CO_GTWA_ST_WRITE_ABORTED
+                              : CO_GTWA_ST_IDLE;
+            }
+            else if (ret == CO_SDO_RT_ok_communicationEnd) {
+                responseWithOK(gtwa);
+                gtwa->state = CO_GTWA_ST_IDLE;
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
 }
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
-#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ERROR_DESC */
-
-
-static inline void responseWithOK(CO_GTWA_t *gtwa) {
-    gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
-                                  "[%"PRId32"] OK\r\n",
-                                  gtwa->sequence);
-    respBufTransfer(gtwa);
-}
 
 
-static inline void responseWithEmpty(CO_GTWA_t *gtwa) {
-    gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
-                                  "\r\n");
-    respBufTransfer(gtwa);
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI
+/* True, if the current command has started ASCII response, which is not yet
+ * finished. Other responses must not be inserted in between. */
+static bool_t respOpen(CO_GTWA_t *gtwa) {
+    if ((gtwa->state == CO_GTWA_ST_READ
+         || gtwa->state == CO_GTWA_ST_READ_CACHED)
+        && gtwa->SDOdataCopyStatus
+    ) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+        /* binary response frames may interleave */
+        return !gtwa->binary;
+#else
+        return true;
+#endif
+    }
+    return gtwa->state >= CO_GTWA_ST_LOG;
 }
 
+/* Process SDO transfers in background SDO channels. */
+static void SDOchannelsProcess(CO_GTWA_t *gtwa,
+                               uint32_t timeDifference_us,
+                               uint32_t *timerNext_us)
+{
+    uint8_t i;
 
-#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS
-static void responseLSS(CO_GTWA_t *gtwa, CO_LSSmaster_return_t lss_ret) {
-    if (lss_ret == CO_LSSmaster_OK) {
-        responseWithOK(gtwa);
-    }
-    else {
-        CO_GTWA_respErrorCode_t respErrorCode;
+    for (i = 0; i < gtwa->SDOchannelsCount; i++) {
+        CO_GTWA_SDOchannel_t *ch = &gtwa->SDOchannels[i];
+        bool_t open;
 
-        if (lss_ret==CO_LSSmaster_TIMEOUT || lss_ret==CO_LSSmaster_SCAN_NOACK) {
-            respErrorCode = CO_GTWA_respErrorTimeOut;
-        }
-        else if (lss_ret == CO_LSSmaster_OK_MANUFACTURER) {
-            respErrorCode = CO_GTWA_respErrorLSSmanufacturer;
+        if (ch->state == CO_GTWA_ST_IDLE
+            || (gtwa->SDOchannelRespOwner != CO_GTWA_SDO_CHANNEL_NONE
+                && gtwa->SDOchannelRespOwner != i)
+        ) {
+            continue;
         }
-        else {
-            respErrorCode = CO_GTWA_respErrorInternalState;
+        SDOchannelSwap(gtwa, ch);
+        SDOprocess(gtwa, timeDifference_us, timerNext_us);
+        open = respOpen(gtwa);
+        SDOchannelSwap(gtwa, ch);
+
+        gtwa->SDOchannelRespOwner = open ? i : CO_GTWA_SDO_CHANNEL_NONE;
+        if (open || gtwa->respHold) {
+            break;
         }
-        responseWithError(gtwa, respErrorCode);
     }
 }
-#endif
-
 
-static inline void convertToLower(char *token, size_t maxCount) {
-    size_t i;
-    char *c = &token[0];
+/* Move the current SDO command into free SDO channel, if response didn't
+ * start yet and all data for download are in SDO buffer. */
+static void SDOchannelPark(CO_GTWA_t *gtwa) {
+    uint8_t i;
 
-    for (i = 0; i < maxCount; i++) {
-        if (*c == 0) {
+    if ((gtwa->state != CO_GTWA_ST_READ && gtwa->state != CO_GTWA_ST_WRITE)
+        || gtwa->SDOdataCopyStatus
+    ) {
+        return;
+    }
+    for (i = 0; i < gtwa->SDOchannelsCount; i++) {
+        if (gtwa->SDOchannels[i].state == CO_GTWA_ST_IDLE) {
+            SDOchannelSwap(gtwa, &gtwa->SDOchannels[i]);
             break;
-        } else {
-            *c = (char)tolower((int)*c);
         }
-        c++;
     }
 }
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI */
 
 
 /*******************************************************************************
@@ -633,6 +1582,12 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
     if (!enable) {
         gtwa->state = CO_GTWA_ST_IDLE;
         CO_fifo_reset(&gtwa->commFifo);
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI
+        for (uint8_t i = 0; i < gtwa->SDOchannelsCount; i++) {
+            gtwa->SDOchannels[i].state = CO_GTWA_ST_IDLE;
+        }
+        gtwa->SDOchannelRespOwner = CO_GTWA_SDO_CHANNEL_NONE;
+#endif
         return;
     }
 
@@ -651,11 +1606,28 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
         }
     }
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI
+    /* Process SDO commands in background channels. Hold other commands, while
+     * some response is partially written. */
+    if (!respOpen(gtwa)) {
+        SDOchannelsProcess(gtwa, timeDifference_us, timerNext_us);
+        if (gtwa->SDOchannelRespOwner != CO_GTWA_SDO_CHANNEL_NONE
+            || gtwa->respHold
+        ) {
+            return;
+        }
+    }
+
+#endif
     /***************************************************************************
     * COMMAND PARSER
     ***************************************************************************/
     /* if idle, search for new command, skip comments or empty lines */
     while (gtwa->state == CO_GTWA_ST_IDLE
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+           && !binaryCommand(gtwa, &err, &closed, &respErrorCode,
+                             &timeDifference_us)
+#endif
            && CO_fifo_CommSearch(&gtwa->commFifo, false)
     ) {
         char tok[20];
@@ -665,6 +1637,9 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
         int32_t net = gtwa->net_default;
         int16_t node = gtwa->node_default;
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+        gtwa->binary = false;
+#endif
 
         /* parse mandatory token '"["<sequence>"]"' */
         closed = -1;
@@ -855,7 +1830,6 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
         else if (strcmp(tok, "r") == 0 || strcmp(tok, "read") == 0) {
             uint16_t idx;
             uint8_t subidx;
-            CO_SDO_return_t SDO_ret;
             bool_t NodeErr = checkNetNode(gtwa, net, node, 1, &respErrorCode);
 
             if (closed != 0 || NodeErr) {
@@ -892,41 +1866,27 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
                 gtwa->SDOdataType = &dataTypes[0]; /* use generic data type */
             }
 
-            /* setup client */
-            SDO_ret = CO_SDOclient_setup(gtwa->SDO_C,
-                                         CO_CAN_ID_SDO_CLI + gtwa->node,
-                                         CO_CAN_ID_SDO_SRV + gtwa->node,
-                                         gtwa->node);
-            if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
-                respErrorCode = CO_GTWA_respErrorInternalState;
-                err = true;
-                break;
-            }
-
-            /* initiate upload */
-            SDO_ret = CO_SDOclientUploadInitiate(gtwa->SDO_C, idx, subidx,
-                                                 gtwa->SDOtimeoutTime,
-                                                 gtwa->SDOblockTransferEnable);
-            if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
-                respErrorCode = CO_GTWA_respErrorInternalState;
-                err = true;
-                break;
+            gtwa->SDOidx = idx;
+            gtwa->SDOsubidx = subidx;
+            gtwa->SDOupload = true;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI
+            if (SDOnodeBusy(gtwa)) {
+                /* wait for other SDO channel to finish with the same node */
+                gtwa->state = CO_GTWA_ST_SDO_WAIT;
+                continue;
             }
+#endif
+            err = SDOstart(gtwa, &respErrorCode, &closed);
+            if (err) break;
 
-            /* indicate that gateway response didn't start yet */
-            gtwa->SDOdataCopyStatus = false;
             /* continue with state machine */
             timeDifference_us = 0;
-            gtwa->state = CO_GTWA_ST_READ;
         }
 
         /* Download SDO comm. - w[rite] <index> <subindex> <datatype> <value> */
         else if (strcmp(tok, "w") == 0 || strcmp(tok, "write") == 0) {
             uint16_t idx;
             uint8_t subidx;
-            CO_fifo_st status;
-            CO_SDO_return_t SDO_ret;
-            size_t size;
             bool_t NodeErr = checkNetNode(gtwa, net, node, 1, &respErrorCode);
 
             if (closed != 0 || NodeErr) {
@@ -955,56 +1915,22 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
             gtwa->SDOdataType = CO_GTWA_getDataType(tok, &err);
             if (err) break;
 
-            /* setup client */
-            SDO_ret = CO_SDOclient_setup(gtwa->SDO_C,
-                                         CO_CAN_ID_SDO_CLI + gtwa->node,
-                                         CO_CAN_ID_SDO_SRV + gtwa->node,
-                                         gtwa->node);
-            if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
-                respErrorCode = CO_GTWA_respErrorInternalState;
-                err = true;
-                break;
-            }
-
-            /* initiate download */
-            SDO_ret =
-            CO_SDOclientDownloadInitiate(gtwa->SDO_C, idx, subidx,
-                                         gtwa->SDOdataType->length,
-                                         gtwa->SDOtimeoutTime,
-                                         gtwa->SDOblockTransferEnable);
-            if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
-                respErrorCode = CO_GTWA_respErrorInternalState;
-                err = true;
-                break;
-            }
-
-            /* copy data from comm to the SDO buffer, according to data type */
-            size = gtwa->SDOdataType->dataTypeScan(&gtwa->SDO_C->bufFifo,
-                                                   &gtwa->commFifo,
-                                                   &status);
-            /* set to true, if command delimiter was found */
-            closed = ((status & CO_fifo_st_closed) == 0) ? 0 : 1;
-            /* set to true, if data are copied only partially */
-            gtwa->SDOdataCopyStatus = (status & CO_fifo_st_partial) != 0;
-
-            /* is syntax error in command or size is zero or not the last token
-             * in command */
-            if ((status & CO_fifo_st_errMask) != 0 || size == 0
-                || (gtwa->SDOdataCopyStatus == false && closed != 1)
-            ) {
-                err = true;
-                break;
-            }
-
-            /* if data size was not known before and is known now, update SDO */
-            if (gtwa->SDOdataType->length == 0 && !gtwa->SDOdataCopyStatus) {
-                CO_SDOclientDownloadInitiateSize(gtwa->SDO_C, size);
+            gtwa->SDOidx = idx;
+            gtwa->SDOsubidx = subidx;
+            gtwa->SDOupload = false;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI
+            if (SDOnodeBusy(gtwa)) {
+                /* wait for other SDO channel to finish with the same node,
+                 * data stay in commFifo */
+                gtwa->state = CO_GTWA_ST_SDO_WAIT;
+                continue;
             }
+#endif
+            err = SDOstart(gtwa, &respErrorCode, &closed);
+            if (err) break;
 
             /* continue with state machine */
-            gtwa->stateTimeoutTmr = 0;
             timeDifference_us = 0;
-            gtwa->state = CO_GTWA_ST_WRITE;
         }
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
 
@@ -1546,163 +2472,47 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
     }
 
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
-    /* SDO upload state */
-    case CO_GTWA_ST_READ: {
-        CO_SDO_abortCode_t abortCode;
-        size_t sizeTransferred;
-        CO_SDO_return_t ret;
-
-        ret = CO_SDOclientUpload(gtwa->SDO_C,
-                                 timeDifference_us,
-                                 false,
-                                 &abortCode,
-                                 NULL,
-                                 &sizeTransferred,
-                                 timerNext_us);
-
-        if (ret < 0) {
-            responseWithErrorSDO(gtwa, abortCode, gtwa->SDOdataCopyStatus);
-            gtwa->state = CO_GTWA_ST_IDLE;
-        }
-        /* Response data must be read, partially or whole */
-        else if (ret == CO_SDO_RT_uploadDataBufferFull
-                 || ret == CO_SDO_RT_ok_communicationEnd
-        ) {
-            size_t fifoRemain;
-
-            /* write response head first */
-            if (!gtwa->SDOdataCopyStatus) {
-                gtwa->respBufCount = snprintf(gtwa->respBuf,
-                                              CO_GTWA_RESP_BUF_SIZE - 2,
-                                              "[%"PRId32"] ",
-                                              gtwa->sequence);
-                gtwa->SDOdataCopyStatus = true;
-            }
-
-            /* Empty SDO fifo buffer in multiple cycles. Repeat until
-             * application runs out of space (respHold) or fifo empty. */
-            do {
-                /* read SDO fifo (partially) and print specific data type as
-                 * ascii into intermediate respBuf */
-                gtwa->respBufCount += gtwa->SDOdataType->dataTypePrint(
-                    &gtwa->SDO_C->bufFifo,
-                    &gtwa->respBuf[gtwa->respBufCount],
-                    CO_GTWA_RESP_BUF_SIZE - 2 - gtwa->respBufCount,
-                    ret == CO_SDO_RT_ok_communicationEnd);
-                fifoRemain = CO_fifo_getOccupied(&gtwa->SDO_C->bufFifo);
-
-                /* end of communication, print newline and enter idle state */
-                if (ret == CO_SDO_RT_ok_communicationEnd && fifoRemain == 0) {
-                    gtwa->respBufCount +=
-                        sprintf(&gtwa->respBuf[gtwa->respBufCount], "\r\n");
-                    gtwa->state = CO_GTWA_ST_IDLE;
-                }
-
-                /* transfer response to the application */
-                if (respBufTransfer(gtwa) == false) {
-                    /* broken communication, send SDO abort and force finish. */
-                    abortCode = CO_SDO_AB_DATA_TRANSF;
-                    CO_SDOclientUpload(gtwa->SDO_C,
-                                       0,
-                                       true,
-                                       &abortCode,
-                                       NULL,
-                                       NULL,
-                                       NULL);
-                    gtwa->state = CO_GTWA_ST_IDLE;
-                    break;
-                }
-            } while (gtwa->respHold == false && fifoRemain > 0);
-        }
-        break;
-    }
-
-    /* SDO download state */
+    /* SDO upload and download states */
+    case CO_GTWA_ST_READ:
+    case CO_GTWA_ST_READ_CACHED:
     case CO_GTWA_ST_WRITE:
     case CO_GTWA_ST_WRITE_ABORTED: {
-        CO_SDO_abortCode_t abortCode;
-        size_t sizeTransferred;
-        bool_t abort = false;
-        bool_t hold = false;
-        CO_SDO_return_t ret;
-
-        /* copy data to the SDO buffer if previous dataTypeScan was partial */
-        if (gtwa->SDOdataCopyStatus) {
-            CO_fifo_st status;
-            gtwa->SDOdataType->dataTypeScan(&gtwa->SDO_C->bufFifo,
-                                            &gtwa->commFifo,
-                                            &status);
-            /* set to true, if command delimiter was found */
-            closed = ((status & CO_fifo_st_closed) == 0) ? 0 : 1;
-            /* set to true, if data are copied only partially */
-            gtwa->SDOdataCopyStatus = (status & CO_fifo_st_partial) != 0;
+        SDOprocess(gtwa, timeDifference_us, timerNext_us);
+        break;
+    }
 
-            /* is syntax error in command or not the last token in command */
-            if ((status & CO_fifo_st_errMask) != 0
-                || (gtwa->SDOdataCopyStatus == false && closed != 1)
-            ) {
-                abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
-                abort = true; /* abort SDO communication */
-                /* clear the rest of the command, if necessary */
-                if (closed != 1)
-                    CO_fifo_CommSearch(&gtwa->commFifo, true);
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI
+    /* SDO command waits for other SDO channel with the same node */
+    case CO_GTWA_ST_SDO_WAIT: {
+        if (!SDOnodeBusy(gtwa)) {
+            closed = gtwa->SDOupload ? 1 : 0;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+            if (gtwa->binary) {
+                closed = 1;
             }
-            if (gtwa->state == CO_GTWA_ST_WRITE_ABORTED) {
-                /* Stay in this state, until all data transferred via commFifo
-                 * will be purged. */
-                if (!CO_fifo_purge(&gtwa->SDO_C->bufFifo) || closed == 1) {
-                    gtwa->state = CO_GTWA_ST_IDLE;
+#endif
+            if (SDOstart(gtwa, &respErrorCode, &closed)) {
+                if (respErrorCode == CO_GTWA_respErrorNone) {
+                    respErrorCode = CO_GTWA_respErrorSyntax;
                 }
-                break;
-            }
-        }
-        /* If not all data were transferred, make sure, there is enough data in
-         * SDO buffer, to continue communication. Otherwise wait and check for
-         * timeout */
-        if (gtwa->SDOdataCopyStatus
-            && CO_fifo_getOccupied(&gtwa->SDO_C->bufFifo) <
-               (CO_CONFIG_GTW_BLOCK_DL_LOOP * 7)
-        ) {
-            if (gtwa->stateTimeoutTmr > CO_GTWA_STATE_TIMEOUT_TIME_US) {
-                abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
-                abort = true;
-            }
-            else {
-                gtwa->stateTimeoutTmr += timeDifference_us;
-                hold = true;
-            }
-        }
-        if (!hold || abort) {
-            /* if OS has CANtx queue, speedup block transfer */
-            int loop = 0;
-            do {
-                ret = CO_SDOclientDownload(gtwa->SDO_C,
-                                           timeDifference_us,
-                                           abort,
-                                           gtwa->SDOdataCopyStatus,
-                                           &abortCode,
-                                           &sizeTransferred,
-                                           timerNext_us);
-                if (++loop >= CO_CONFIG_GTW_BLOCK_DL_LOOP) {
-                    break;
+                responseWithError(gtwa, respErrorCode);
+                /* delete command, if it was only partially read */
+                if (closed == 0) {
+                    CO_fifo_CommSearch(&gtwa->commFifo, true);
                 }
-            } while (ret == CO_SDO_RT_blockDownldInProgress);
-
-            /* send response in case of error or finish */
-            if (ret < 0) {
-                responseWithErrorSDO(gtwa, abortCode, false);
-                /* purge remaining data if necessary */
-                gtwa->state = gtwa->SDOdataCopyStatus
-                              ? CO_GTWA_ST_WRITE_ABORTED
-                              : CO_GTWA_ST_IDLE;
-            }
-            else if (ret == CO_SDO_RT_ok_communicationEnd) {
-                responseWithOK(gtwa);
                 gtwa->state = CO_GTWA_ST_IDLE;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+                if (gtwa->binary && gtwa->binRemain > 0) {
+                    /* purge the rest of WRITE data */
+                    gtwa->SDOdataCopyStatus = true;
+                    gtwa->state = CO_GTWA_ST_WRITE_ABORTED;
+                }
+#endif
             }
         }
         break;
     }
+#endif
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
 
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS
@@ -1734,6 +2544,9 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
                                            timeDifference_us,
                                            gtwa->lssNID);
         if (ret != CO_LSSmaster_WAIT_SLAVE) {
+            if (ret == CO_LSSmaster_OK) {
+                EVLOG_PUT(gtwa, CO_EVLOG_LSS_NODE_ID, gtwa->lssNID, 0, 0, 0);
+            }
             if (ret == CO_LSSmaster_OK_ILLEGAL_ARGUMENT) {
                 respErrorCode = CO_GTWA_respErrorLSSnodeIdNotSupported;
                 responseWithError(gtwa, respErrorCode);
@@ -1767,6 +2580,9 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
 
         ret = CO_LSSmaster_configureStore(gtwa->LSSmaster, timeDifference_us);
         if (ret != CO_LSSmaster_WAIT_SLAVE) {
+            if (ret == CO_LSSmaster_OK) {
+                EVLOG_PUT(gtwa, CO_EVLOG_LSS_STORED, 0, 0, 0, 0);
+            }
             if (ret == CO_LSSmaster_OK_ILLEGAL_ARGUMENT) {
                 respErrorCode = CO_GTWA_respErrorLSSparameterStoringFailed;
                 responseWithError(gtwa, respErrorCode);
@@ -1838,6 +2654,8 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
                                             &gtwa->lssFastscan);
         if (ret != CO_LSSmaster_WAIT_SLAVE) {
             if (ret == CO_LSSmaster_OK || ret == CO_LSSmaster_SCAN_FINISHED) {
+                EVLOG_PUT(gtwa, CO_EVLOG_LSS_FOUND, 0, 0, 0,
+                          gtwa->lssFastscan.found.identity.serialNumber);
                 gtwa->respBufCount =
                     snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
                              "[%"PRId32"] 0x%08"PRIX32" 0x%08"PRIX32 \
@@ -1880,6 +2698,8 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
                     gtwa->state = CO_GTWA_ST_IDLE;
                 }
                 else if (ret == CO_LSSmaster_SCAN_FINISHED) {
+                    EVLOG_PUT(gtwa, CO_EVLOG_LSS_FOUND, 0, 0, 0,
+                              gtwa->lssFastscan.found.identity.serialNumber);
                     /* next sub-step */
                     gtwa->lssSubState++;
                 }
@@ -1896,6 +2716,8 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
                                                gtwa->lssNID);
             if (ret != CO_LSSmaster_WAIT_SLAVE) {
                 if (ret == CO_LSSmaster_OK) {
+                    EVLOG_PUT(gtwa, CO_EVLOG_LSS_NODE_ID, gtwa->lssNID, 0, 0,
+                              gtwa->lssFastscan.found.identity.serialNumber);
                     /* next sub-step */
                     gtwa->lssSubState += gtwa->lssStore ? 1 : 2;
                 }
@@ -1917,6 +2739,7 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
                                               timeDifference_us);
             if (ret != CO_LSSmaster_WAIT_SLAVE) {
                 if (ret == CO_LSSmaster_OK) {
+                    EVLOG_PUT(gtwa, CO_EVLOG_LSS_STORED, gtwa->lssNID, 0, 0, 0);
                     /* next sub-step */
                     gtwa->lssSubState++;
                 }
@@ -1985,13 +2808,38 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG
     /* print message log */
     case CO_GTWA_ST_LOG: {
+#if (CO_CONFIG_EVLOG) & CO_CONFIG_EVLOG_ENABLE
+        /* limit number of records per call, producers may keep writing */
+        uint16_t evlogCount = 0;
+#endif
         do {
             gtwa->respBufCount = CO_fifo_read(&gtwa->logFifo,
                                               (uint8_t *)gtwa->respBuf,
                                               CO_GTWA_RESP_BUF_SIZE, NULL);
+#if (CO_CONFIG_EVLOG) & CO_CONFIG_EVLOG_ENABLE
+            if (gtwa->respBufCount == 0 && gtwa->evlog != NULL) {
+                /* message log is printed, continue with event records */
+                if (++evlogCount > CO_CONFIG_EVLOG_SIZE) {
+                    break;
+                }
+                gtwa->respBufCount = CO_eventLog_readText(gtwa->evlog,
+                                                          gtwa->respBuf,
+                                                          CO_GTWA_RESP_BUF_SIZE);
+                if (gtwa->respBufCount == 0) {
+                    gtwa->state = CO_GTWA_ST_IDLE;
+                    break;
+                }
+                respBufTransfer(gtwa);
+                continue;
+            }
+#endif
             respBufTransfer(gtwa);
 
-            if (CO_fifo_getOccupied(&gtwa->logFifo) == 0) {
+            if (CO_fifo_getOccupied(&gtwa->logFifo) == 0
+#if (CO_CONFIG_EVLOG) & CO_CONFIG_EVLOG_ENABLE
+                && gtwa->evlog == NULL
+#endif
+            ) {
                 gtwa->state = CO_GTWA_ST_IDLE;
                 break;
             }
@@ -2062,10 +2910,19 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
     }
     } /* switch (gtwa->state) */
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI
+    /* continue SDO transfer in background, so next command can be parsed */
+    SDOchannelPark(gtwa);
+
+#endif
     /* execute next CANopen processing immediately, if idle and more commands
      * available */
     if (timerNext_us != NULL && gtwa->state == CO_GTWA_ST_IDLE
-        && CO_fifo_CommSearch(&gtwa->commFifo, false)
+        && (CO_fifo_CommSearch(&gtwa->commFifo, false)
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY
+            || binFrameReady(gtwa)
+#endif
+        )
     ) {
         *timerNext_us = 0;
     }
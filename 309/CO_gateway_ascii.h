@@ -30,9 +30,11 @@
 #include "301/CO_driver.h"
 #include "301/CO_fifo.h"
 #include "301/CO_SDOclient.h"
+#include "301/CO_SDOclientCache.h"
 #include "301/CO_NMT_Heartbeat.h"
 #include "305/CO_LSSmaster.h"
 #include "303/CO_LEDs.h"
+#include "extra/CO_eventLog.h"
 
 /* default configuration, see CO_config.h */
 #ifndef CO_CONFIG_GTW
@@ -146,6 +148,103 @@ lss_allnodes [<timeout_ms> [<nodeStart=1..127> <store=0|1>\\
  */
 
 
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY) || defined CO_DOXYGEN
+/**
+ * @defgroup CO_CANopen_309_3_Binary Binary framed commands
+ * Compact binary alternative to ASCII command syntax.
+ *
+ * @{
+ *
+ * Binary frames may be mixed with ASCII commands on the same stream. Frame
+ * starts with @ref CO_GTWA_BIN_SOF byte, which can not start ASCII command.
+ * Then follows fixed size header and payload. All values are little-endian.
+ *
+ * @code{.unparsed}
+Offset  Size  Description
+0       1     Start of frame, 0xA5
+1       1     Command, see CO_GTWA_binCmd_t. In response CO_GTWA_BIN_RESPONSE
+              is added and also CO_GTWA_BIN_MORE, if more response frames
+              follow for the same request.
+2       2     Length of payload
+4       4     Request ID, copied into response (as <sequence> in ASCII)
+8       2     Net, 0xFFFF for default net
+10      1     Node-ID, 0xFF for default node
+11      1     Reserved, 0
+12      ...   Payload
+
+Command payloads:
+READ                  <index u16> <subindex u8>
+WRITE                 <index u16> <subindex u8> <data>
+NMT                   <NMT command u8, see CO_NMT_command_t>
+SET_SDO_TIMEOUT       <timeout_ms u16>
+SET_SDO_BLOCK         <0|1 u8>
+LSS_SWITCH_GLOB       <0|1 u8>
+LSS_SWITCH_SEL        <vendorID u32> <productCode u32> <revisionNo u32>
+                      <serialNo u32>
+LSS_SET_NODE          <node u8>
+LSS_CONF_BITRATE      <table_index u8>
+LSS_ACTIVATE_BITRATE  <switch_delay_ms u16>
+LSS_STORE             -
+
+Response payload:
+<result u32> [<data>]
+ * @endcode
+ *
+ * Result is 0 on success, CO_GTWA_respErrorCode_t on gateway error or
+ * CO_SDO_abortCode_t on SDO error. Data of SDO READ are raw data, as
+ * transferred by SDO. Larger data are split into multiple response frames,
+ * each with result 0. If SDO is aborted after the first data frame, last frame
+ * contains the SDO abort code.
+ *
+ * Payload of WRITE command may be larger than command buffer, data are copied
+ * to the SDO client as they arrive. Payload of other commands must not be
+ * larger than @ref CO_GTWA_BIN_PAYLOAD_MAX, otherwise command buffer is
+ * cleared to resynchronize.
+ */
+
+/** Start of frame byte of the binary command and response */
+#define CO_GTWA_BIN_SOF 0xA5U
+/** Size of the binary frame header in bytes */
+#define CO_GTWA_BIN_HEADER_SIZE 12U
+/** Maximum size of binary command payload, except for WRITE */
+#define CO_GTWA_BIN_PAYLOAD_MAX 16U
+/** Added to command byte in response frame */
+#define CO_GTWA_BIN_RESPONSE 0x80U
+/** Added to command byte in response frame, if more frames will follow */
+#define CO_GTWA_BIN_MORE 0x40U
+
+/**
+ * Binary commands
+ */
+typedef enum {
+    /** SDO upload */
+    CO_GTWA_BIN_READ = 0x01U,
+    /** SDO download */
+    CO_GTWA_BIN_WRITE = 0x02U,
+    /** NMT command */
+    CO_GTWA_BIN_NMT = 0x10U,
+    /** Configure SDO time-out */
+    CO_GTWA_BIN_SET_SDO_TIMEOUT = 0x18U,
+    /** Enable/disable SDO block transfer */
+    CO_GTWA_BIN_SET_SDO_BLOCK = 0x19U,
+    /** LSS switch state global */
+    CO_GTWA_BIN_LSS_SWITCH_GLOB = 0x20U,
+    /** LSS switch state selective */
+    CO_GTWA_BIN_LSS_SWITCH_SEL = 0x21U,
+    /** LSS configure node-ID */
+    CO_GTWA_BIN_LSS_SET_NODE = 0x22U,
+    /** LSS configure bit-rate */
+    CO_GTWA_BIN_LSS_CONF_BITRATE = 0x23U,
+    /** LSS activate new bit-rate */
+    CO_GTWA_BIN_LSS_ACTIVATE_BITRATE = 0x24U,
+    /** LSS store configuration */
+    CO_GTWA_BIN_LSS_STORE = 0x25U
+} CO_GTWA_binCmd_t;
+
+/** @} */ /* CO_CANopen_309_3_Binary */
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY */
+
+
 /** Size of response string buffer. This is intermediate buffer. If there is
  * larger amount of data to transfer, then multiple transfers will occur. */
 #ifndef CO_GTWA_RESP_BUF_SIZE
@@ -153,6 +252,16 @@ lss_allnodes [<timeout_ms> [<nodeStart=1..127> <store=0|1>\\
 #endif
 
 
+/** Maximum number of background SDO channels, see
+ * CO_GTWA_initSDOchannels(). */
+#ifndef CO_CONFIG_GTWA_SDO_CHANNELS
+#define CO_CONFIG_GTWA_SDO_CHANNELS 4
+#endif
+
+/** Indicates no SDO channel, used by CO_GTWA_t.SDOchannelRespOwner */
+#define CO_GTWA_SDO_CHANNEL_NONE 0xFFU
+
+
 /** Timeout time in microseconds for some internal states. */
 #ifndef CO_GTWA_STATE_TIMEOUT_TIME_US
 #define CO_GTWA_STATE_TIMEOUT_TIME_US 1200000
@@ -236,6 +345,12 @@ typedef enum {
     CO_GTWA_ST_WRITE = 0x11U,
     /** SDO 'write' (download) - aborted, purging remaining data */
     CO_GTWA_ST_WRITE_ABORTED = 0x12U,
+    /** SDO 'read' or 'write' waits for other SDO channel to finish transfer
+     * with the same node */
+    CO_GTWA_ST_SDO_WAIT = 0x13U,
+    /** SDO 'read' answered from @ref CO_SDOclientCache, data are in SDO
+     * client buffer */
+    CO_GTWA_ST_READ_CACHED = 0x14U,
     /** LSS 'lss_switch_glob' */
     CO_GTWA_ST_LSS_SWITCH_GLOB = 0x20U,
     /** LSS 'lss_switch_sel' */
@@ -291,6 +406,34 @@ typedef struct {
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
 
 
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI) || defined CO_DOXYGEN
+/**
+ * Background SDO channel of the Gateway-ascii object.
+ *
+ * Contains context of the SDO command, which continues in background, while
+ * next commands are parsed. Fields have the same meaning as in CO_GTWA_t.
+ */
+typedef struct {
+    uint32_t sequence;
+    uint16_t net;
+    uint8_t node;
+    CO_GTWA_state_t state;
+    uint32_t stateTimeoutTmr;
+    CO_SDOclient_t *SDO_C;
+    bool_t SDOdataCopyStatus;
+    const CO_GTWA_dataType_t *SDOdataType;
+    uint16_t SDOidx;
+    uint8_t SDOsubidx;
+    bool_t SDOupload;
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY) || defined CO_DOXYGEN
+    bool_t binary;
+    uint8_t binCmd;
+    size_t binRemain;
+#endif
+} CO_GTWA_SDOchannel_t;
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI */
+
+
 /**
  * CANopen Gateway-ascii object
  */
@@ -343,6 +486,14 @@ typedef struct {
     CO_GTWA_state_t state;
     /** Timeout timer for the current state */
     uint32_t stateTimeoutTmr;
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_BINARY) || defined CO_DOXYGEN
+    /** True, if current command is binary framed */
+    bool_t binary;
+    /** Command byte of the current binary command */
+    uint8_t binCmd;
+    /** Remaining payload of the current binary command inside commFifo */
+    size_t binRemain;
+#endif
 #if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO) || defined CO_DOXYGEN
     /** SDO client object from CO_GTWA_init() */
     CO_SDOclient_t *SDO_C;
@@ -356,6 +507,26 @@ typedef struct {
     bool_t SDOdataCopyStatus;
     /** Data type of variable in current SDO communication */
     const CO_GTWA_dataType_t *SDOdataType;
+    /** Index of the current SDO command */
+    uint16_t SDOidx;
+    /** Subindex of the current SDO command */
+    uint8_t SDOsubidx;
+    /** True for SDO 'read', false for 'write' */
+    bool_t SDOupload;
+#endif
+#if (((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO) \
+     && ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE)) || defined CO_DOXYGEN
+    /** SDO client cache from CO_GTWA_initCache() or NULL */
+    CO_SDOclientCache_t *SDOcache;
+#endif
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI) || defined CO_DOXYGEN
+    /** Background SDO channels from CO_GTWA_initSDOchannels() */
+    CO_GTWA_SDOchannel_t SDOchannels[CO_CONFIG_GTWA_SDO_CHANNELS];
+    /** Number of used background SDO channels */
+    uint8_t SDOchannelsCount;
+    /** Channel, which has started response and holds other responses, or
+     * CO_GTWA_SDO_CHANNEL_NONE */
+    uint8_t SDOchannelRespOwner;
 #endif
 #if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_NMT) || defined CO_DOXYGEN
     /** NMT object from CO_GTWA_init() */
@@ -389,6 +560,11 @@ typedef struct {
     /** CO_fifo_t object for message log (not pointer) */
     CO_fifo_t logFifo;
 #endif
+#if (((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG) \
+     && ((CO_CONFIG_EVLOG) & CO_CONFIG_EVLOG_ENABLE)) || defined CO_DOXYGEN
+    /** Event log from CO_GTWA_initEventLog() or NULL */
+    CO_eventLog_t *evlog;
+#endif
 #if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_PRINT_HELP) || defined CO_DOXYGEN
     /** Offset, when printing help text */
     const char *helpString;
@@ -456,6 +632,50 @@ void CO_GTWA_initRead(CO_GTWA_t* gtwa,
                       void *readCallbackObject);
 
 
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI) || defined CO_DOXYGEN
+/**
+ * Initialize background SDO channels of Gateway-ascii object
+ *
+ * SDO 'read' or 'write' command continues on free background channel after it
+ * is started, so next commands can be processed meanwhile. Responses are then
+ * emitted in order of completion, with own sequence numbers. Commands for the
+ * node, which is busy in other channel, wait for that transfer to finish.
+ *
+ * Function must be called after CO_GTWA_init().
+ *
+ * @param gtwa This object
+ * @param SDO_C Array of additional SDO client objects, not used elsewhere.
+ * @param count Number of SDO clients in array, up to
+ * @ref CO_CONFIG_GTWA_SDO_CHANNELS are used.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_GTWA_initSDOchannels(CO_GTWA_t* gtwa,
+                                         CO_SDOclient_t* SDO_C,
+                                         uint8_t count);
+#endif
+
+
+#if (((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO) \
+     && ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_CACHE)) || defined CO_DOXYGEN
+/**
+ * Initialize SDO client cache in Gateway-ascii object
+ *
+ * SDO 'read' commands are then answered from the cache, if value is there.
+ * Otherwise value is uploaded and stored into the cache, if it matches caching
+ * policy. SDO 'write' command invalidates cached values of the node. Cache must
+ * be processed by the application, see CO_SDOclientCache_process().
+ *
+ * Function must be called after CO_GTWA_init().
+ *
+ * @param gtwa This object
+ * @param cache SDO client cache object, initialized by
+ * @ref CO_SDOclientCache_init(). If NULL, cache is not used.
+ */
+void CO_GTWA_initCache(CO_GTWA_t* gtwa, CO_SDOclientCache_t *cache);
+#endif
+
+
 /**
  * Get free write buffer space
  *
@@ -508,6 +728,26 @@ void CO_GTWA_log_print(CO_GTWA_t* gtwa, const char *message);
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG */
 
 
+#if (((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG) \
+     && ((CO_CONFIG_EVLOG) & CO_CONFIG_EVLOG_ENABLE)) || defined CO_DOXYGEN
+/**
+ * Initialize event log in Gateway-ascii object
+ *
+ * Command "log" then prints message log and after it records from the event
+ * log, which are formatted only at that time. Gateway records SDO client aborts
+ * and LSS master events (node-ID configured, slave found by fastscan,
+ * configuration stored) into the event log.
+ *
+ * Function must be called after CO_GTWA_init().
+ *
+ * @param gtwa This object
+ * @param evlog Event log object, initialized by @ref CO_eventLog_init(). If
+ * NULL, event log is not used.
+ */
+void CO_GTWA_initEventLog(CO_GTWA_t* gtwa, CO_eventLog_t *evlog);
+#endif
+
+
 /**
  * Process Gateway-ascii object
  *
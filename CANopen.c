@@ -25,6 +25,31 @@
 
 #include "CANopen.h"
 
+/* CAN module of the object bound to interface ifNo, see CO_setInterface(),
+ * and index of its CANrx or CANtx buffer in that module. Additional interfaces
+ * contain only objects from CO_IF_RX_IDX_FIRST and CO_IF_TX_IDX_FIRST on. */
+#if CO_CONFIG_CAN_IF_COUNT > 1
+#define CO_IF_MODULE(ifNo) co->CANmoduleIf[ifNo]
+#define CO_IF_RX_IDX(ifNo, idx) \
+    ((ifNo) == 0 ? (idx) : (uint16_t)((idx) - CO_GET_CO(IF_RX_IDX_FIRST)))
+#define CO_IF_TX_IDX(ifNo, idx) \
+    ((ifNo) == 0 ? (idx) : (uint16_t)((idx) - CO_GET_CO(IF_TX_IDX_FIRST)))
+#else
+#define CO_IF_MODULE(ifNo) co->CANmodule
+#define CO_IF_RX_IDX(ifNo, idx) (idx)
+#define CO_IF_TX_IDX(ifNo, idx) (idx)
+#endif
+
+/* Static configuration uses global objects */
+#ifdef CO_STATIC_CONFIG
+ #ifdef CO_MULTIPLE_OD
+  #error CO_MULTIPLE_OD can not be used with CO_STATIC_CONFIG
+ #endif
+ #ifndef CO_USE_GLOBALS
+  #define CO_USE_GLOBALS
+ #endif
+#endif
+
 /* Get values from CO_config_t or from single default OD.h ********************/
 #ifdef CO_MULTIPLE_OD
 #define CO_GET_CO(obj) co->obj
@@ -284,11 +309,51 @@
 #define CO_TX_IDX_LSS_SLV   (CO_TX_IDX_HB_PROD  + CO_TX_CNT_HB_PROD)
 #define CO_TX_IDX_LSS_MST   (CO_TX_IDX_LSS_SLV  + CO_TX_CNT_LSS_SLV)
 #define CO_CNT_ALL_TX_MSGS  (CO_TX_IDX_LSS_MST  + CO_TX_CNT_LSS_MST)
+
+/* Range of indexes of objects, which can be bound to additional CAN interface,
+ * see CO_setInterface(). */
+#define CO_IF_RX_IDX_FIRST  CO_RX_IDX_RPDO
+#define CO_CNT_IF_RX_MSGS   (CO_RX_IDX_LSS_SLV - CO_RX_IDX_RPDO)
+#define CO_IF_TX_IDX_FIRST  CO_TX_IDX_TPDO
+#define CO_CNT_IF_TX_MSGS   (CO_TX_IDX_HB_PROD - CO_TX_IDX_TPDO)
 #endif /* #ifdef #else CO_MULTIPLE_OD */
 
 
-/* Objects from heap **********************************************************/
+/* Objects from heap or from arena ********************************************/
 #ifndef CO_USE_GLOBALS
+#ifdef CO_USE_ARENA
+#include <string.h>
+
+ #ifdef CO_alloc
+  #undef CO_alloc
+ #endif
+ #ifdef CO_free
+  #undef CO_free
+ #endif
+
+typedef struct {
+    uint8_t *buf;
+    size_t size;
+    size_t used;
+} CO_arena_t;
+
+/* Take zeroed memory for num elements from arena or return NULL */
+static void *CO_arenaAlloc(CO_arena_t *arena, size_t num, size_t size) {
+    size_t offset = CO_ARENA_ITEM(uint8_t, arena->used);
+    size_t len = num * size;
+
+    if (len > arena->size || offset > (arena->size - len)) {
+        return NULL;
+    }
+    arena->used = offset + len;
+    memset(&arena->buf[offset], 0, len);
+    return &arena->buf[offset];
+}
+
+#define CO_alloc(num, size)             CO_arenaAlloc(arena, (num), (size))
+#define CO_free(ptr)                    (void)(ptr)
+
+#else /* CO_USE_ARENA */
 #include <stdlib.h>
 
 /* Default allocation strategy ************************************************/
@@ -310,6 +375,7 @@
 #define CO_free(ptr)                    free((ptr))
 
 #endif
+#endif /* CO_USE_ARENA */
 
 /* Define macros for allocation */
 #define CO_alloc_break_on_fail(var, num, size)   if (((var) = CO_alloc((num), (size))) != NULL) { mem += (size) * (num); } else { break; }
@@ -320,7 +386,13 @@
 #define ON_MULTI_OD(sentence)
 #endif
 
+#ifdef CO_USE_ARENA
+static CO_t *CO_newInArena(CO_arena_t *arena, CO_config_t *config,
+                           uint32_t *heapMemoryUsed)
+{
+#else
 CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
+#endif
     CO_t *co = NULL;
     /* return values */
     CO_t *coFinal = NULL;
@@ -407,6 +479,12 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
         ON_MULTI_OD(uint8_t TX_CNT_SDO_SRV = 0);
         if (CO_GET_CNT(SDO_SRV) > 0) {
             CO_alloc_break_on_fail(co->SDOserver, CO_GET_CNT(SDO_SRV), sizeof(*co->SDOserver));
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+            CO_alloc_break_on_fail(co->SDObufPool, 1, sizeof(*co->SDObufPool));
+#endif
+#if CO_CONFIG_CAN_IF_COUNT > 1
+            CO_alloc_break_on_fail(co->ifSDO_SRV, CO_GET_CNT(SDO_SRV), sizeof(*co->ifSDO_SRV));
+#endif
             ON_MULTI_OD(RX_CNT_SDO_SRV = config->CNT_SDO_SRV);
             ON_MULTI_OD(TX_CNT_SDO_SRV = config->CNT_SDO_SRV);
         }
@@ -416,6 +494,9 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
         ON_MULTI_OD(uint8_t TX_CNT_SDO_CLI = 0);
         if (CO_GET_CNT(SDO_CLI) > 0) {
             CO_alloc_break_on_fail(co->SDOclient, CO_GET_CNT(SDO_CLI), sizeof(*co->SDOclient));
+ #if CO_CONFIG_CAN_IF_COUNT > 1
+            CO_alloc_break_on_fail(co->ifSDO_CLI, CO_GET_CNT(SDO_CLI), sizeof(*co->ifSDO_CLI));
+ #endif
             ON_MULTI_OD(RX_CNT_SDO_CLI = config->CNT_SDO_CLI);
             ON_MULTI_OD(TX_CNT_SDO_CLI = config->CNT_SDO_CLI);
         }
@@ -449,6 +530,9 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
         ON_MULTI_OD(uint16_t RX_CNT_RPDO = 0);
         if (CO_GET_CNT(RPDO) > 0) {
             CO_alloc_break_on_fail(co->RPDO, CO_GET_CNT(RPDO), sizeof(*co->RPDO));
+ #if CO_CONFIG_CAN_IF_COUNT > 1
+            CO_alloc_break_on_fail(co->ifRPDO, CO_GET_CNT(RPDO), sizeof(*co->ifRPDO));
+ #endif
             ON_MULTI_OD(RX_CNT_RPDO = config->CNT_RPDO);
         }
 #endif
@@ -457,6 +541,9 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
         ON_MULTI_OD(uint16_t TX_CNT_TPDO = 0);
         if (CO_GET_CNT(TPDO) > 0) {
             CO_alloc_break_on_fail(co->TPDO, CO_GET_CNT(TPDO), sizeof(*co->TPDO));
+ #if CO_CONFIG_CAN_IF_COUNT > 1
+            CO_alloc_break_on_fail(co->ifTPDO, CO_GET_CNT(TPDO), sizeof(*co->ifTPDO));
+ #endif
             ON_MULTI_OD(TX_CNT_TPDO = config->CNT_TPDO);
         }
 #endif
@@ -539,6 +626,9 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
 #if (CO_CONFIG_SRDO) & CO_CONFIG_SRDO_ENABLE
         co->RX_IDX_SRDO = idxRx; idxRx += RX_CNT_SRDO * 2;
 #endif
+#if CO_CONFIG_CAN_IF_COUNT > 1
+        co->IF_RX_IDX_FIRST = idxRx;
+#endif
 #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
         co->RX_IDX_RPDO = idxRx; idxRx += RX_CNT_RPDO;
 #endif
@@ -549,6 +639,9 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
         co->RX_IDX_HB_CONS = idxRx; idxRx += RX_CNT_HB_CONS;
 #endif
+#if CO_CONFIG_CAN_IF_COUNT > 1
+        co->CNT_IF_RX_MSGS = idxRx - co->IF_RX_IDX_FIRST;
+#endif
 #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_SLAVE
         co->RX_IDX_LSS_SLV = idxRx; idxRx += RX_CNT_LSS_SLV;
 #endif
@@ -572,12 +665,18 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
 #if (CO_CONFIG_SRDO) & CO_CONFIG_SRDO_ENABLE
         co->TX_IDX_SRDO = idxTx; idxTx += TX_CNT_SRDO * 2;
 #endif
+#if CO_CONFIG_CAN_IF_COUNT > 1
+        co->IF_TX_IDX_FIRST = idxTx;
+#endif
 #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
         co->TX_IDX_TPDO = idxTx; idxTx += TX_CNT_TPDO;
 #endif
         co->TX_IDX_SDO_SRV = idxTx; idxTx += TX_CNT_SDO_SRV;
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
         co->TX_IDX_SDO_CLI = idxTx; idxTx += TX_CNT_SDO_CLI;
+#endif
+#if CO_CONFIG_CAN_IF_COUNT > 1
+        co->CNT_IF_TX_MSGS = idxTx - co->IF_TX_IDX_FIRST;
 #endif
         co->TX_IDX_HB_PROD = idxTx; idxTx += TX_CNT_HB_PROD;
 #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_SLAVE
@@ -598,6 +697,23 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
         /* CAN TX blocks */
         CO_alloc_break_on_fail(co->CANtx, CO_GET_CO(CNT_ALL_TX_MSGS), sizeof(*co->CANtx));
 
+#if CO_CONFIG_CAN_IF_COUNT > 1
+        /* Additional CAN modules with CANrx and CANtx only for objects, which
+         * can be bound to them */
+        co->CANmoduleIf[0] = co->CANmodule;
+        co->CANrxIf[0] = co->CANrx;
+        co->CANtxIf[0] = co->CANtx;
+        uint8_t ifNo;
+        for (ifNo = 1; ifNo < CO_CONFIG_CAN_IF_COUNT; ifNo++) {
+            CO_alloc_break_on_fail(co->CANmoduleIf[ifNo], 1, sizeof(*co->CANmodule));
+            CO_alloc_break_on_fail(co->CANrxIf[ifNo], CO_GET_CO(CNT_IF_RX_MSGS), sizeof(*co->CANrx));
+            CO_alloc_break_on_fail(co->CANtxIf[ifNo], CO_GET_CO(CNT_IF_TX_MSGS), sizeof(*co->CANtx));
+        }
+        if (ifNo < CO_CONFIG_CAN_IF_COUNT) {
+            break;
+        }
+#endif
+
         /* finish successfully, set other parameters */
         co->nodeIdUnconfigured = true;
         coFinal = co;
@@ -607,11 +723,32 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
         CO_delete(co);
     }
     if (heapMemoryUsed != NULL) {
+#ifdef CO_USE_ARENA
+        /* include alignment padding */
+        mem = (uint32_t)arena->used;
+#endif
         *heapMemoryUsed = mem;
     }
     return coFinal;
 }
 
+#ifdef CO_USE_ARENA
+CO_t *CO_newArena(CO_config_t *config, void *arena, size_t arenaSize,
+                  uint32_t *heapMemoryUsed)
+{
+    CO_arena_t arenaObj;
+
+    if (arena == NULL || ((uintptr_t)arena % CO_ARENA_ALIGN) != 0) {
+        return NULL;
+    }
+    arenaObj.buf = (uint8_t *)arena;
+    arenaObj.size = arenaSize;
+    arenaObj.used = 0;
+
+    return CO_newInArena(&arenaObj, config, heapMemoryUsed);
+}
+#endif
+
 void CO_delete(CO_t *co) {
     if (co == NULL) {
         return;
@@ -619,6 +756,15 @@ void CO_delete(CO_t *co) {
 
     CO_CANmodule_disable(co->CANmodule);
 
+#if CO_CONFIG_CAN_IF_COUNT > 1
+    for (uint8_t ifNo = 1; ifNo < CO_CONFIG_CAN_IF_COUNT; ifNo++) {
+        CO_CANmodule_disable(co->CANmoduleIf[ifNo]);
+        CO_free(co->CANtxIf[ifNo]);
+        CO_free(co->CANrxIf[ifNo]);
+        CO_free(co->CANmoduleIf[ifNo]);
+    }
+#endif
+
     /* CANmodule */
     CO_free(co->CANtx);
     CO_free(co->CANrx);
@@ -654,10 +800,16 @@ void CO_delete(CO_t *co) {
 #endif
 
 #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+ #if CO_CONFIG_CAN_IF_COUNT > 1
+    CO_free(co->ifTPDO);
+ #endif
     CO_free(co->TPDO);
 #endif
 
 #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+ #if CO_CONFIG_CAN_IF_COUNT > 1
+    CO_free(co->ifRPDO);
+ #endif
     CO_free(co->RPDO);
 #endif
 
@@ -670,10 +822,19 @@ void CO_delete(CO_t *co) {
 #endif
 
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
-    free(co->SDOclient);
+ #if CO_CONFIG_CAN_IF_COUNT > 1
+    CO_free(co->ifSDO_CLI);
+ #endif
+    CO_free(co->SDOclient);
 #endif
 
     /* SDOserver */
+#if CO_CONFIG_CAN_IF_COUNT > 1
+    CO_free(co->ifSDO_SRV);
+#endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    CO_free(co->SDObufPool);
+#endif
     CO_free(co->SDOserver);
 
     /* Emergency */
@@ -705,6 +866,21 @@ void CO_delete(CO_t *co) {
     static CO_CANmodule_t COO_CANmodule;
     static CO_CANrx_t COO_CANmodule_rxArray[CO_CNT_ALL_RX_MSGS];
     static CO_CANtx_t COO_CANmodule_txArray[CO_CNT_ALL_TX_MSGS];
+#if CO_CONFIG_CAN_IF_COUNT > 1
+    static CO_CANmodule_t COO_CANmoduleIf[CO_CONFIG_CAN_IF_COUNT - 1];
+    static CO_CANrx_t COO_CANmoduleIf_rxArray[CO_CONFIG_CAN_IF_COUNT - 1][CO_CNT_IF_RX_MSGS];
+    static CO_CANtx_t COO_CANmoduleIf_txArray[CO_CONFIG_CAN_IF_COUNT - 1][CO_CNT_IF_TX_MSGS];
+    static uint8_t COO_ifSDO_SRV[OD_CNT_SDO_SRV];
+ #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
+    static uint8_t COO_ifSDO_CLI[OD_CNT_SDO_CLI];
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+    static uint8_t COO_ifRPDO[OD_CNT_RPDO];
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+    static uint8_t COO_ifTPDO[OD_CNT_TPDO];
+ #endif
+#endif
     static CO_NMT_t COO_NMT;
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
     static CO_HBconsumer_t COO_HBcons;
@@ -715,6 +891,9 @@ void CO_delete(CO_t *co) {
     static CO_EM_fifo_t COO_EM_FIFO[CO_GET_CNT(ARR_1003) + 1];
 #endif
     static CO_SDOserver_t COO_SDOserver[OD_CNT_SDO_SRV];
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    static CO_SDOserver_bufferPool_t COO_SDObufPool;
+#endif
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
     static CO_SDOclient_t COO_SDOclient[OD_CNT_SDO_CLI];
 #endif
@@ -766,6 +945,26 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
     co->CANmodule = &COO_CANmodule;
     co->CANrx = &COO_CANmodule_rxArray[0];
     co->CANtx = &COO_CANmodule_txArray[0];
+#if CO_CONFIG_CAN_IF_COUNT > 1
+    co->CANmoduleIf[0] = co->CANmodule;
+    co->CANrxIf[0] = co->CANrx;
+    co->CANtxIf[0] = co->CANtx;
+    for (uint8_t ifNo = 1; ifNo < CO_CONFIG_CAN_IF_COUNT; ifNo++) {
+        co->CANmoduleIf[ifNo] = &COO_CANmoduleIf[ifNo - 1];
+        co->CANrxIf[ifNo] = &COO_CANmoduleIf_rxArray[ifNo - 1][0];
+        co->CANtxIf[ifNo] = &COO_CANmoduleIf_txArray[ifNo - 1][0];
+    }
+    co->ifSDO_SRV = &COO_ifSDO_SRV[0];
+ #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
+    co->ifSDO_CLI = &COO_ifSDO_CLI[0];
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+    co->ifRPDO = &COO_ifRPDO[0];
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+    co->ifTPDO = &COO_ifTPDO[0];
+ #endif
+#endif
 
     co->NMT = &COO_NMT;
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
@@ -777,6 +976,9 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
     co->em_fifo = &COO_EM_FIFO[0];
 #endif
     co->SDOserver = &COO_SDOserver[0];
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+    co->SDObufPool = &COO_SDObufPool;
+#endif
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
     co->SDOclient = &COO_SDOclient[0];
 #endif
@@ -827,9 +1029,50 @@ void CO_delete(CO_t *co) {
     }
 
     CO_CANmodule_disable(co->CANmodule);
+#if CO_CONFIG_CAN_IF_COUNT > 1
+    for (uint8_t ifNo = 1; ifNo < CO_CONFIG_CAN_IF_COUNT; ifNo++) {
+        CO_CANmodule_disable(co->CANmoduleIf[ifNo]);
+    }
+#endif
 }
 #endif /* #ifdef CO_USE_GLOBALS */
 
+/* Objects used by processing functions. With CO_STATIC_CONFIG they are
+ * accessed directly as globals, not through pointers from CO_t. */
+#ifdef CO_STATIC_CONFIG
+ #define CO_P_CANmodule (&COO_CANmodule)
+ #define CO_P_NMT (&COO_NMT)
+ #define CO_P_em (&COO_EM)
+ #define CO_P_HBcons (&COO_HBcons)
+ #define CO_P_SDOserver (COO_SDOserver)
+ #define CO_P_TIME (&COO_TIME)
+ #define CO_P_SYNC (&COO_SYNC)
+ #define CO_P_RPDO (COO_RPDO)
+ #define CO_P_TPDO (COO_TPDO)
+ #define CO_P_LEDs (&COO_LEDs)
+ #define CO_P_SRDOGuard (&COO_SRDOGuard)
+ #define CO_P_SRDO (COO_SRDO)
+ #define CO_P_LSSslave (&COO_LSSslave)
+ #define CO_P_gtwa (&COO_gtwa)
+ #define CO_PROC(obj) ((void)co, CO_P_##obj)
+ /* Node-ID can be unconfigured only by LSS slave */
+ #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_SLAVE
+  #define CO_NODE_ID_UNCONFIGURED(co) (co)->nodeIdUnconfigured
+ #else
+  #define CO_NODE_ID_UNCONFIGURED(co) ((void)(co), false)
+ #endif
+ /* Loops over objects have constant count from OD.h */
+ #if defined __GNUC__ && !defined __clang__ && __GNUC__ >= 8
+  #define CO_UNROLL _Pragma("GCC unroll 16")
+ #endif
+#else
+ #define CO_PROC(obj) co->obj
+ #define CO_NODE_ID_UNCONFIGURED(co) (co)->nodeIdUnconfigured
+#endif
+#ifndef CO_UNROLL
+ #define CO_UNROLL
+#endif
+
 /* Helper functions ***********************************************************/
 bool_t CO_isLSSslaveEnabled(CO_t *co) {
     (void) co; /* may be unused */
@@ -842,6 +1085,9 @@ bool_t CO_isLSSslaveEnabled(CO_t *co) {
 
 /******************************************************************************/
 CO_ReturnError_t CO_CANinit(CO_t *co, void *CANptr, uint16_t bitRate) {
+#if CO_CONFIG_CAN_IF_COUNT > 1
+    return CO_CANinitIf(co, 0, CANptr, bitRate);
+#else
     CO_ReturnError_t err;
 
     if (co == NULL) return CO_ERROR_ILLEGAL_ARGUMENT;
@@ -859,9 +1105,92 @@ CO_ReturnError_t CO_CANinit(CO_t *co, void *CANptr, uint16_t bitRate) {
                             bitRate);
 
     return err;
+#endif
 }
 
 
+#if CO_CONFIG_CAN_IF_COUNT > 1
+/******************************************************************************/
+CO_ReturnError_t CO_CANinitIf(CO_t *co, uint8_t ifNo,
+                              void *CANptr, uint16_t bitRate)
+{
+    CO_ReturnError_t err;
+
+    if (co == NULL || ifNo >= CO_CONFIG_CAN_IF_COUNT) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    co->CANmoduleIf[ifNo]->CANnormal = false;
+    CO_CANsetConfigurationMode(CANptr);
+
+    err = CO_CANmodule_init(co->CANmoduleIf[ifNo],
+                            CANptr,
+                            co->CANrxIf[ifNo],
+                            ifNo == 0 ? CO_GET_CO(CNT_ALL_RX_MSGS)
+                                      : CO_GET_CO(CNT_IF_RX_MSGS),
+                            co->CANtxIf[ifNo],
+                            ifNo == 0 ? CO_GET_CO(CNT_ALL_TX_MSGS)
+                                      : CO_GET_CO(CNT_IF_TX_MSGS),
+                            bitRate);
+
+    return err;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_setInterface(CO_t *co, CO_ifObject_t object,
+                                 uint16_t index, uint8_t ifNo)
+{
+    uint8_t *ifArray = NULL;
+    uint16_t count = 0;
+
+    if (co == NULL || ifNo >= CO_CONFIG_CAN_IF_COUNT) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    switch (object) {
+ #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+        case CO_IF_OBJ_RPDO:
+            ifArray = co->ifRPDO;
+            count = CO_GET_CNT(RPDO);
+            break;
+ #endif
+ #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+        case CO_IF_OBJ_TPDO:
+            ifArray = co->ifTPDO;
+            count = CO_GET_CNT(TPDO);
+            break;
+ #endif
+        case CO_IF_OBJ_SDO_SRV:
+            ifArray = co->ifSDO_SRV;
+            count = CO_GET_CNT(SDO_SRV);
+            break;
+ #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
+        case CO_IF_OBJ_SDO_CLI:
+            ifArray = co->ifSDO_CLI;
+            count = CO_GET_CNT(SDO_CLI);
+            break;
+ #endif
+ #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+        case CO_IF_OBJ_HB_CONS:
+            ifArray = &co->ifHB_CONS;
+            count = CO_GET_CNT(HB_CONS);
+            break;
+ #endif
+        default:
+            break;
+    }
+
+    if (ifArray == NULL || index >= count) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    ifArray[index] = ifNo;
+
+    return CO_ERROR_NO;
+}
+#endif /* CO_CONFIG_CAN_IF_COUNT > 1 */
+
+
 /******************************************************************************/
 #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_SLAVE
 CO_ReturnError_t CO_LSSinit(CO_t *co,
@@ -943,6 +1272,17 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
     }
 #endif
 
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    err = CO_stats_init(&co->stats, co->CANmodule,
+                        OD_find(od, CO_CONFIG_STATS_OD_INDEX));
+    if (err) return err;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+    err = CO_stats_initTraffic(&co->stats,
+                               OD_find(od, CO_CONFIG_STATS_TRAFFIC_OD_INDEX));
+    if (err) return err;
+#endif
+#endif
+
     /* CANopen Node ID is unconfigured, stop initialization here */
     if (co->nodeIdUnconfigured) {
         return CO_ERROR_NODE_ID_UNCONFIGURED_LSS;
@@ -1009,31 +1349,58 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
                                  co->HBconsMonitoredNodes,
                                  CO_GET_CNT(ARR_1016),
                                  OD_GET(H1016, OD_H1016_CONSUMER_HB_TIME),
-                                 co->CANmodule,
-                                 CO_GET_CO(RX_IDX_HB_CONS),
+                                 CO_IF_MODULE(co->ifHB_CONS),
+                                 CO_IF_RX_IDX(co->ifHB_CONS,
+                                              CO_GET_CO(RX_IDX_HB_CONS)),
                                  errInfo);
         if (err) return err;
+ #if (CO_CONFIG_PROCESS) & CO_CONFIG_PROCESS_SCHEDULER
+        co->schedHBcons.elapsed_us = 0;
+        co->schedHBcons.timerNext_us = 0;
+        co->schedSDOactive = false;
+ #endif
+    }
+#endif
+
+#if (CO_CONFIG_PROCESS) & CO_CONFIG_PROCESS_BUDGET
+    co->budgetTaskNext = 0;
+    for (uint8_t i = 0; i < CO_PROC_TASK_COUNT; i++) {
+        co->budgetElapsed_us[i] = 0;
     }
 #endif
 
     /* SDOserver */
     if (CO_GET_CNT(SDO_SRV) > 0) {
         OD_entry_t *SDOsrvPar = OD_GET(H1200, OD_H1200_SDO_SERVER_1_PARAM);
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+        CO_SDOserver_bufferPoolInit(co->SDObufPool);
+#endif
         for (int16_t i = 0; i < CO_GET_CNT(SDO_SRV); i++) {
             err = CO_SDOserver_init(&co->SDOserver[i],
                                     od,
                                     SDOsrvPar++,
                                     nodeId,
                                     SDOserverTimeoutTime_ms,
-                                    co->CANmodule,
-                                    CO_GET_CO(RX_IDX_SDO_SRV) + i,
-                                    co->CANmodule,
-                                    CO_GET_CO(TX_IDX_SDO_SRV) + i,
+                                    CO_IF_MODULE(co->ifSDO_SRV[i]),
+                                    CO_IF_RX_IDX(co->ifSDO_SRV[i],
+                                                 CO_GET_CO(RX_IDX_SDO_SRV) + i),
+                                    CO_IF_MODULE(co->ifSDO_SRV[i]),
+                                    CO_IF_TX_IDX(co->ifSDO_SRV[i],
+                                                 CO_GET_CO(TX_IDX_SDO_SRV) + i),
                                     errInfo);
             if (err) return err;
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+            CO_SDOserver_initBufferPool(&co->SDOserver[i], co->SDObufPool);
+#endif
         }
     }
 
+#if (CO_CONFIG_CONCISE_DCF) & CO_CONFIG_CONCISE_DCF_ENABLE
+    err = CO_conciseDcf_init(&co->conciseDcf, od, OD_find(od, 0x1F22),
+                             co->CANmodule, errInfo);
+    if (err) return err;
+#endif
+
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
     if (CO_GET_CNT(SDO_CLI) > 0) {
         OD_entry_t *SDOcliPar = OD_GET(H1280, OD_H1280_SDO_CLIENT_1_PARAM);
@@ -1042,10 +1409,12 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
                                     od,
                                     SDOcliPar++,
                                     nodeId,
-                                    co->CANmodule,
-                                    CO_GET_CO(RX_IDX_SDO_CLI) + i,
-                                    co->CANmodule,
-                                    CO_GET_CO(TX_IDX_SDO_CLI) + i,
+                                    CO_IF_MODULE(co->ifSDO_CLI[i]),
+                                    CO_IF_RX_IDX(co->ifSDO_CLI[i],
+                                                 CO_GET_CO(RX_IDX_SDO_CLI) + i),
+                                    CO_IF_MODULE(co->ifSDO_CLI[i]),
+                                    CO_IF_TX_IDX(co->ifSDO_CLI[i],
+                                                 CO_GET_CO(TX_IDX_SDO_CLI) + i),
                                     errInfo);
             if (err) return err;
         }
@@ -1171,6 +1540,13 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
  #endif
                            0);
         if (err) return err;
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_MULTI
+        if (CO_GET_CNT(SDO_CLI) > 1) {
+            err = CO_GTWA_initSDOchannels(co->gtwa, &co->SDOclient[1],
+                                          CO_GET_CNT(SDO_CLI) - 1);
+            if (err) return err;
+        }
+ #endif
     }
 #endif
 
@@ -1243,8 +1619,9 @@ CO_ReturnError_t CO_CANopenInitPDO(CO_t *co,
                                preDefinedCanId,
                                RPDOcomm++,
                                RPDOmap++,
-                               co->CANmodule,
-                               CO_GET_CO(RX_IDX_RPDO) + i,
+                               CO_IF_MODULE(co->ifRPDO[i]),
+                               CO_IF_RX_IDX(co->ifRPDO[i],
+                                            CO_GET_CO(RX_IDX_RPDO) + i),
                                errInfo);
             if (err) return err;
         }
@@ -1277,11 +1654,23 @@ CO_ReturnError_t CO_CANopenInitPDO(CO_t *co,
                                preDefinedCanId,
                                TPDOcomm++,
                                TPDOmap++,
-                               co->CANmodule,
-                               CO_GET_CO(TX_IDX_TPDO) + i,
+                               CO_IF_MODULE(co->ifTPDO[i]),
+                               CO_IF_TX_IDX(co->ifTPDO[i],
+                                            CO_GET_CO(TX_IDX_TPDO) + i),
                                errInfo);
             if (err) return err;
+ #if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_BATCH
+  #if CO_CONFIG_CAN_IF_COUNT > 1
+            /* batch is submitted to interface 0, others send directly */
+            if (co->ifTPDO[i] == 0)
+  #endif
+            CO_TPDO_initTxBatch(&co->TPDO[i], &co->TPDOtxBatch);
+ #endif
         }
+ #if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_BATCH
+        co->TPDOtxBatch.CANmodule = co->CANmodule;
+        co->TPDOtxBatch.count = 0;
+ #endif
     }
 #endif
 
@@ -1289,36 +1678,104 @@ CO_ReturnError_t CO_CANopenInitPDO(CO_t *co,
 }
 
 
-/******************************************************************************/
-CO_NMT_reset_cmd_t CO_process(CO_t *co,
-                              bool_t enableGateway,
+#if (CO_CONFIG_PROCESS) & CO_CONFIG_PROCESS_SCHEDULER
+/* Add time difference to the task and return true, if task is due */
+static inline bool_t schedDue(CO_schedTask_t *task,
                               uint32_t timeDifference_us,
-                              uint32_t *timerNext_us)
+                              bool_t event)
+{
+    task->elapsed_us = (task->elapsed_us < (UINT32_MAX - timeDifference_us))
+                     ? (task->elapsed_us + timeDifference_us) : UINT32_MAX;
+    return event || task->elapsed_us >= task->timerNext_us;
+}
+
+/* Remember timerNext_us after task was processed */
+static inline void schedDone(CO_schedTask_t *task, uint32_t taskTimerNext_us) {
+    task->elapsed_us = 0;
+    task->timerNext_us = taskTimerNext_us;
+}
+
+/* Reduce timerNext_us according to the task deadline */
+static inline void schedTimerNext(CO_schedTask_t *task, uint32_t *timerNext_us) {
+    if (timerNext_us != NULL) {
+        uint32_t diff = task->timerNext_us - task->elapsed_us;
+        if (*timerNext_us > diff) {
+            *timerNext_us = diff;
+        }
+    }
+}
+
+ #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+/* True, if Heartbeat consumer has received message, which is not processed */
+static bool_t HBconsRxPending(CO_HBconsumer_t *HBcons) {
+  #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_INDEXED
+    return HBcons->rxQueueRd != HBcons->rxQueueWr
+           || CO_FLAG_READ(HBcons->rxQueueOverflow);
+  #else
+    for (uint8_t i = 0; i < HBcons->numberOfMonitoredNodes; i++) {
+        if (CO_FLAG_READ(HBcons->monitoredNodes[i].CANrxNew)) {
+            return true;
+        }
+    }
+    return false;
+  #endif
+}
+ #endif
+#endif /* (CO_CONFIG_PROCESS) & CO_CONFIG_PROCESS_SCHEDULER */
+
+
+/* True, if NMT internal state is pre-operational or operational */
+static inline bool_t NMTisPreOrOperational(CO_t *co) {
+    CO_NMT_internalState_t NMTstate = CO_NMT_getInternalState(CO_PROC(NMT));
+    return NMTstate == CO_NMT_PRE_OPERATIONAL
+           || NMTstate == CO_NMT_OPERATIONAL;
+}
+
+
+/******************************************************************************/
+CO_NMT_reset_cmd_t CO_process_NMT(CO_t *co,
+                                  uint32_t timeDifference_us,
+                                  uint32_t *timerNext_us)
 {
-    (void) enableGateway; /* may be unused */
     CO_NMT_reset_cmd_t reset = CO_RESET_NOT;
-    CO_NMT_internalState_t NMTstate = CO_NMT_getInternalState(co->NMT);
-    bool_t NMTisPreOrOperational = (NMTstate == CO_NMT_PRE_OPERATIONAL
-                                    || NMTstate == CO_NMT_OPERATIONAL);
+    CO_NMT_internalState_t NMTstate = CO_NMT_getInternalState(CO_PROC(NMT));
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    uint32_t statsStart = CO_stats_start();
+#endif
 
     /* CAN module */
-    CO_CANmodule_process(co->CANmodule);
+    CO_CANmodule_process(CO_PROC(CANmodule));
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+    CO_CANtraffic_process(&CO_PROC(CANmodule)->traffic, timeDifference_us);
+#endif
+#if CO_CONFIG_CAN_IF_COUNT > 1
+    for (uint8_t ifNo = 1; ifNo < CO_CONFIG_CAN_IF_COUNT; ifNo++) {
+        CO_CANmodule_process(co->CANmoduleIf[ifNo]);
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+        CO_CANtraffic_process(&co->CANmoduleIf[ifNo]->traffic,
+                              timeDifference_us);
+#endif
+    }
+#endif
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    CO_stats_process(&co->stats, timeDifference_us);
+#endif
 
 #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_SLAVE
     if (CO_GET_CNT(LSS_SLV) == 1) {
-        if (CO_LSSslave_process(co->LSSslave)) {
+        if (CO_LSSslave_process(CO_PROC(LSSslave))) {
             reset = CO_RESET_COMM;
         }
     }
 #endif
 
 #if (CO_CONFIG_LEDS) & CO_CONFIG_LEDS_ENABLE
-    bool_t unc = co->nodeIdUnconfigured;
-    uint16_t CANerrorStatus = co->CANmodule->CANerrorStatus;
+    bool_t unc = CO_NODE_ID_UNCONFIGURED(co);
+    uint16_t CANerrorStatus = CO_PROC(CANmodule)->CANerrorStatus;
     bool_t LSSslave_configuration = false;
  #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_SLAVE
     if (CO_GET_CNT(LSS_SLV) == 1
-        && CO_LSSslave_getState(co->LSSslave) == CO_LSS_STATE_CONFIGURATION
+        && CO_LSSslave_getState(CO_PROC(LSSslave)) == CO_LSS_STATE_CONFIGURATION
     ) {
         LSSslave_configuration = true;
     }
@@ -1329,79 +1786,331 @@ CO_NMT_reset_cmd_t CO_process(CO_t *co,
  #endif
 
     if (CO_GET_CNT(LEDS) == 1) {
-        CO_LEDs_process(co->LEDs,
+        CO_LEDs_process(CO_PROC(LEDs),
             timeDifference_us,
             unc ? CO_NMT_INITIALIZING : NMTstate,
             LSSslave_configuration,
             (CANerrorStatus & CO_CAN_ERRTX_BUS_OFF) != 0,
             (CANerrorStatus & CO_CAN_ERR_WARN_PASSIVE) != 0,
             0, /* RPDO event timer timeout */
-            unc ? false : CO_isError(co->em, CO_EM_SYNC_TIME_OUT),
-            unc ? false : (CO_isError(co->em, CO_EM_HEARTBEAT_CONSUMER)
-                        || CO_isError(co->em, CO_EM_HB_CONSUMER_REMOTE_RESET)),
-            CO_getErrorRegister(co->em) != 0,
+            unc ? false : CO_isError(CO_PROC(em), CO_EM_SYNC_TIME_OUT),
+            unc ? false : (CO_isError(CO_PROC(em), CO_EM_HEARTBEAT_CONSUMER)
+                        || CO_isError(CO_PROC(em), CO_EM_HB_CONSUMER_REMOTE_RESET)),
+            CO_getErrorRegister(CO_PROC(em)) != 0,
             CO_STATUS_FIRMWARE_DOWNLOAD_IN_PROGRESS,
             timerNext_us);
     }
 #endif
 
     /* CANopen Node ID is unconfigured (LSS slave), stop processing here */
-    if (co->nodeIdUnconfigured) {
+    if (CO_NODE_ID_UNCONFIGURED(co)) {
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+        CO_stats_stop(&co->stats, CO_STATS_NMT, statsStart);
+#endif
         return reset;
     }
 
     /* Emergency */
     if (CO_GET_CNT(EM) == 1) {
-        CO_EM_process(co->em,
-                      NMTisPreOrOperational,
+        CO_EM_process(CO_PROC(em),
+                      NMTisPreOrOperational(co),
                       timeDifference_us,
                       timerNext_us);
     }
 
     /* NMT_Heartbeat */
     if (CO_GET_CNT(NMT) == 1) {
-        reset = CO_NMT_process(co->NMT,
+        reset = CO_NMT_process(CO_PROC(NMT),
                                &NMTstate,
                                timeDifference_us,
                                timerNext_us);
     }
-    NMTisPreOrOperational = (NMTstate == CO_NMT_PRE_OPERATIONAL
-                             || NMTstate == CO_NMT_OPERATIONAL);
 
-    /* SDOserver */
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    CO_stats_stop(&co->stats, CO_STATS_NMT, statsStart);
+#endif
+    return reset;
+}
+
+
+/******************************************************************************/
+void CO_process_SDOserver(CO_t *co,
+                          uint32_t timeDifference_us,
+                          uint32_t *timerNext_us)
+{
+    if (CO_NODE_ID_UNCONFIGURED(co)) {
+        return;
+    }
+
+    bool_t NMTisPreOrOp = NMTisPreOrOperational(co);
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    uint32_t statsStart = CO_stats_start();
+#endif
+
+    CO_UNROLL
     for (uint8_t i = 0; i < CO_GET_CNT(SDO_SRV); i++) {
-        CO_SDOserver_process(&co->SDOserver[i],
-                             NMTisPreOrOperational,
+#if (CO_CONFIG_PROCESS) & CO_CONFIG_PROCESS_SCHEDULER
+        CO_SDOserver_t *SDO = &CO_PROC(SDOserver)[i];
+        /* skip, if idle and nothing new, as in CO_SDOserver_process() */
+        if (SDO->valid && SDO->state == CO_SDO_ST_IDLE
+            && !CO_FLAG_READ(SDO->CANrxNew)
+        ) {
+            continue;
+        }
+        /* OD may be changed by SDO server */
+        co->schedSDOactive = true;
+#endif
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+        OD_size_t sizeTranPrev = CO_PROC(SDOserver)[i].sizeTran;
+#endif
+        CO_SDOserver_process(&CO_PROC(SDOserver)[i],
+                             NMTisPreOrOp,
                              timeDifference_us,
                              timerNext_us);
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+        /* sizeTran is cleared at start of new transfer */
+        OD_size_t sizeTran = CO_PROC(SDOserver)[i].sizeTran;
+        CO_stats_addSDObytes(&co->stats, (uint32_t)(sizeTran >= sizeTranPrev
+                             ? sizeTran - sizeTranPrev : sizeTran));
+#endif
     }
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    CO_stats_stop(&co->stats, CO_STATS_SDO_SRV, statsStart);
+#endif
+}
 
+
+/******************************************************************************/
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
-    if (CO_GET_CNT(HB_CONS) == 1) {
-        CO_HBconsumer_process(co->HBcons,
-                              NMTisPreOrOperational,
-                              timeDifference_us,
-                              timerNext_us);
+void CO_process_HBconsumer(CO_t *co,
+                           uint32_t timeDifference_us,
+                           uint32_t *timerNext_us)
+{
+    if (CO_NODE_ID_UNCONFIGURED(co) || CO_GET_CNT(HB_CONS) != 1) {
+        return;
     }
+
+    bool_t NMTisPreOrOp = NMTisPreOrOperational(co);
+
+ #if (CO_CONFIG_PROCESS) & CO_CONFIG_PROCESS_SCHEDULER
+    /* Process on received message, expired timeout, change of 0x1016 or
+     * outside of steady (pre)operational state. */
+    CO_schedTask_t *task = &co->schedHBcons;
+    bool_t event = co->schedSDOactive || !NMTisPreOrOp
+                   || !CO_PROC(HBcons)->NMTisPreOrOperationalPrev
+                   || HBconsRxPending(CO_PROC(HBcons));
+    co->schedSDOactive = false;
+
+    if (schedDue(task, timeDifference_us, event)) {
+        uint32_t taskTimerNext_us = UINT32_MAX;
+        CO_HBconsumer_process(CO_PROC(HBcons),
+                              NMTisPreOrOp,
+                              task->elapsed_us,
+                              &taskTimerNext_us);
+  #if !((CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_TIMERNEXT)
+        /* timeouts are unknown, process on each call */
+        taskTimerNext_us = 0;
+  #endif
+        schedDone(task, taskTimerNext_us);
+    }
+  #if (CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_TIMERNEXT
+    schedTimerNext(task, timerNext_us);
+  #endif
+ #else
+    CO_HBconsumer_process(CO_PROC(HBcons),
+                          NMTisPreOrOp,
+                          timeDifference_us,
+                          timerNext_us);
+ #endif
+}
 #endif
 
+
+/******************************************************************************/
 #if (CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE
-    if (CO_GET_CNT(TIME) == 1) {
-        CO_TIME_process(co->TIME, NMTisPreOrOperational, timeDifference_us);
+void CO_process_TIME(CO_t *co,
+                     uint32_t timeDifference_us,
+                     uint32_t *timerNext_us)
+{
+    (void) timerNext_us;
+    if (!CO_NODE_ID_UNCONFIGURED(co) && CO_GET_CNT(TIME) == 1) {
+        CO_TIME_process(CO_PROC(TIME), NMTisPreOrOperational(co), timeDifference_us);
     }
+}
 #endif
 
+
+/******************************************************************************/
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
-    if (CO_GET_CNT(GTWA) == 1) {
-        CO_GTWA_process(co->gtwa,
+void CO_process_gateway(CO_t *co,
+                        bool_t enableGateway,
+                        uint32_t timeDifference_us,
+                        uint32_t *timerNext_us)
+{
+    if (!CO_NODE_ID_UNCONFIGURED(co) && CO_GET_CNT(GTWA) == 1) {
+        CO_GTWA_process(CO_PROC(gtwa),
                         enableGateway,
                         timeDifference_us,
                         timerNext_us);
     }
+}
+#endif
+
+
+/******************************************************************************/
+CO_NMT_reset_cmd_t CO_process(CO_t *co,
+                              bool_t enableGateway,
+                              uint32_t timeDifference_us,
+                              uint32_t *timerNext_us)
+{
+    (void) enableGateway; /* may be unused */
+    CO_NMT_reset_cmd_t reset;
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    uint32_t statsStart = CO_stats_start();
+#endif
+
+    reset = CO_process_NMT(co, timeDifference_us, timerNext_us);
+    CO_process_SDOserver(co, timeDifference_us, timerNext_us);
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+    CO_process_HBconsumer(co, timeDifference_us, timerNext_us);
+#endif
+#if (CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE
+    CO_process_TIME(co, timeDifference_us, timerNext_us);
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
+    CO_process_gateway(co, enableGateway, timeDifference_us, timerNext_us);
+#endif
+
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    CO_stats_stop(&co->stats, CO_STATS_PROCESS, statsStart);
+#endif
+    return reset;
+}
+
+
+#if (CO_CONFIG_PROCESS) & CO_CONFIG_PROCESS_BUDGET
+/* Get work of the task for CO_processBudget() */
+static uint16_t budgetTaskWork(CO_t *co, uint8_t task) {
+    uint16_t work = 0;
+
+    if (CO_NODE_ID_UNCONFIGURED(co)) {
+        return 0;
+    }
+
+    switch (task) {
+    case CO_PROC_TASK_SDO_SRV:
+        for (uint8_t i = 0; i < CO_GET_CNT(SDO_SRV); i++) {
+            CO_SDOserver_t *SDO = &CO_PROC(SDOserver)[i];
+            if (SDO->state != CO_SDO_ST_IDLE || CO_FLAG_READ(SDO->CANrxNew)) {
+                work++;
+            }
+        }
+        break;
+ #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+    case CO_PROC_TASK_HB_CONS:
+        work = CO_GET_CNT(HB_CONS);
+        break;
+ #endif
+ #if (CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE
+    case CO_PROC_TASK_TIME:
+        work = CO_GET_CNT(TIME);
+        break;
+ #endif
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
+    case CO_PROC_TASK_GTW:
+        work = CO_GET_CNT(GTWA);
+        break;
+ #endif
+    default:
+        break;
+    }
+    return work;
+}
+
+/* Process the task for CO_processBudget() */
+static void budgetTaskProcess(CO_t *co, uint8_t task, bool_t enableGateway,
+                              uint32_t timeDifference_us,
+                              uint32_t *timerNext_us)
+{
+    (void) enableGateway; /* may be unused */
+
+    switch (task) {
+    case CO_PROC_TASK_SDO_SRV:
+        CO_process_SDOserver(co, timeDifference_us, timerNext_us);
+        break;
+ #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+    case CO_PROC_TASK_HB_CONS:
+        CO_process_HBconsumer(co, timeDifference_us, timerNext_us);
+        break;
+ #endif
+ #if (CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE
+    case CO_PROC_TASK_TIME:
+        CO_process_TIME(co, timeDifference_us, timerNext_us);
+        break;
+ #endif
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
+    case CO_PROC_TASK_GTW:
+        CO_process_gateway(co, enableGateway, timeDifference_us, timerNext_us);
+        break;
+ #endif
+    default:
+        break;
+    }
+}
+
+
+/******************************************************************************/
+CO_NMT_reset_cmd_t CO_processBudget(CO_t *co,
+                                    bool_t enableGateway,
+                                    uint32_t timeDifference_us,
+                                    uint32_t *timerNext_us,
+                                    uint16_t budget)
+{
+    CO_NMT_reset_cmd_t reset;
+    uint8_t task = co->budgetTaskNext;
+    uint8_t count;
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    uint32_t statsStart = CO_stats_start();
 #endif
 
+    reset = CO_process_NMT(co, timeDifference_us, timerNext_us);
+
+    for (uint8_t i = 0; i < CO_PROC_TASK_COUNT; i++) {
+        uint32_t *elapsed_us = &co->budgetElapsed_us[i];
+        *elapsed_us = (*elapsed_us < (UINT32_MAX - timeDifference_us))
+                    ? (*elapsed_us + timeDifference_us) : UINT32_MAX;
+    }
+
+    for (count = 0; count < CO_PROC_TASK_COUNT; count++) {
+        uint16_t work = budgetTaskWork(co, task);
+
+        if (work > 0 && budget == 0) {
+            /* continue with this task on next call */
+            break;
+        }
+        budget = (work < budget) ? (budget - work) : 0;
+
+        budgetTaskProcess(co, task, enableGateway,
+                          co->budgetElapsed_us[task], timerNext_us);
+        co->budgetElapsed_us[task] = 0;
+
+        if (++task >= CO_PROC_TASK_COUNT) {
+            task = 0;
+        }
+    }
+    co->budgetTaskNext = task;
+
+    if (count < CO_PROC_TASK_COUNT && timerNext_us != NULL) {
+        /* work is pending */
+        *timerNext_us = 0;
+    }
+
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    CO_stats_stop(&co->stats, CO_STATS_PROCESS, statsStart);
+#endif
     return reset;
 }
+#endif /* (CO_CONFIG_PROCESS) & CO_CONFIG_PROCESS_BUDGET */
 
 
 /******************************************************************************/
@@ -1412,12 +2121,15 @@ bool_t CO_process_SYNC(CO_t *co,
 {
     bool_t syncWas = false;
 
-    if (!co->nodeIdUnconfigured && CO_GET_CNT(SYNC) == 1) {
-        CO_NMT_internalState_t NMTstate = CO_NMT_getInternalState(co->NMT);
+    if (!CO_NODE_ID_UNCONFIGURED(co) && CO_GET_CNT(SYNC) == 1) {
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+        uint32_t statsStart = CO_stats_start();
+#endif
+        CO_NMT_internalState_t NMTstate = CO_NMT_getInternalState(CO_PROC(NMT));
         bool_t NMTisPreOrOperational = (NMTstate == CO_NMT_PRE_OPERATIONAL
                                         || NMTstate == CO_NMT_OPERATIONAL);
 
-        CO_SYNC_status_t sync_process = CO_SYNC_process(co->SYNC,
+        CO_SYNC_status_t sync_process = CO_SYNC_process(CO_PROC(SYNC),
                                                         NMTisPreOrOperational,
                                                         timeDifference_us,
                                                         timerNext_us);
@@ -1429,9 +2141,17 @@ bool_t CO_process_SYNC(CO_t *co,
                 syncWas = true;
                 break;
             case CO_SYNC_PASSED_WINDOW:
-                CO_CANclearPendingSyncPDOs(co->CANmodule);
+                CO_CANclearPendingSyncPDOs(CO_PROC(CANmodule));
+#if CO_CONFIG_CAN_IF_COUNT > 1
+                for (uint8_t ifNo = 1; ifNo < CO_CONFIG_CAN_IF_COUNT; ifNo++) {
+                    CO_CANclearPendingSyncPDOs(co->CANmoduleIf[ifNo]);
+                }
+#endif
                 break;
         }
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+        CO_stats_stop(&co->stats, CO_STATS_SYNC, statsStart);
+#endif
     }
 
     return syncWas;
@@ -1447,15 +2167,19 @@ void CO_process_RPDO(CO_t *co,
                      uint32_t *timerNext_us)
 {
     (void) timeDifference_us; (void) timerNext_us;
-    if (co->nodeIdUnconfigured) {
+    if (CO_NODE_ID_UNCONFIGURED(co)) {
         return;
     }
 
     bool_t NMTisOperational =
-        CO_NMT_getInternalState(co->NMT) == CO_NMT_OPERATIONAL;
+        CO_NMT_getInternalState(CO_PROC(NMT)) == CO_NMT_OPERATIONAL;
 
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    uint32_t statsStart = CO_stats_start();
+#endif
+    CO_UNROLL
     for (int16_t i = 0; i < CO_GET_CNT(RPDO); i++) {
-        CO_RPDO_process(&co->RPDO[i],
+        CO_RPDO_process(&CO_PROC(RPDO)[i],
 #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_TIMERS_ENABLE
                         timeDifference_us,
                         timerNext_us,
@@ -1463,6 +2187,9 @@ void CO_process_RPDO(CO_t *co,
                         NMTisOperational,
                         syncWas);
     }
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    CO_stats_stop(&co->stats, CO_STATS_RPDO, statsStart);
+#endif
 }
 #endif
 
@@ -1475,15 +2202,31 @@ void CO_process_TPDO(CO_t *co,
                      uint32_t *timerNext_us)
 {
     (void) timeDifference_us; (void) timerNext_us;
-    if (co->nodeIdUnconfigured) {
+    if (CO_NODE_ID_UNCONFIGURED(co)) {
         return;
     }
 
     bool_t NMTisOperational =
-        CO_NMT_getInternalState(co->NMT) == CO_NMT_OPERATIONAL;
-
+        CO_NMT_getInternalState(CO_PROC(NMT)) == CO_NMT_OPERATIONAL;
+
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    uint32_t statsStart = CO_stats_start();
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_REQUEST_COUNT
+    /* check OD_requestTPDO() flags only after new requests, in all TPDOs
+     * before any of them is sent and flags are set back */
+    uint32_t requestCount = OD_TPDOrequestCount;
+    if (requestCount != co->TPDOrequestCount) {
+        co->TPDOrequestCount = requestCount;
+        CO_UNROLL
+        for (int16_t i = 0; i < CO_GET_CNT(TPDO); i++) {
+            CO_TPDO_checkRequests(&CO_PROC(TPDO)[i]);
+        }
+    }
+#endif
+    CO_UNROLL
     for (int16_t i = 0; i < CO_GET_CNT(TPDO); i++) {
-        CO_TPDO_process(&co->TPDO[i],
+        CO_TPDO_process(&CO_PROC(TPDO)[i],
 #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_TIMERS_ENABLE
                         timeDifference_us,
                         timerNext_us,
@@ -1491,6 +2234,21 @@ void CO_process_TPDO(CO_t *co,
                         NMTisOperational,
                         syncWas);
     }
+
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_BATCH
+    /* send all collected synchronous TPDOs at once */
+    if (co->TPDOtxBatch.count > 0) {
+        /* overflow is reported by driver in CANerrorStatus, as by
+         * CO_CANsend() */
+        (void)CO_CANsendBatch(co->TPDOtxBatch.CANmodule,
+                              co->TPDOtxBatch.buffers,
+                              co->TPDOtxBatch.count);
+        co->TPDOtxBatch.count = 0;
+    }
+#endif
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    CO_stats_stop(&co->stats, CO_STATS_TPDO, statsStart);
+#endif
 }
 #endif
 
@@ -1501,14 +2259,15 @@ void CO_process_SRDO(CO_t *co,
                      uint32_t timeDifference_us,
                      uint32_t *timerNext_us)
 {
-    if (co->nodeIdUnconfigured) {
+    if (CO_NODE_ID_UNCONFIGURED(co)) {
         return;
     }
 
-    uint8_t firstOperational = CO_SRDOGuard_process(co->SRDOGuard);
+    uint8_t firstOperational = CO_SRDOGuard_process(CO_PROC(SRDOGuard));
 
+    CO_UNROLL
     for (int16_t i = 0; i < CO_GET_CNT(SRDO); i++) {
-        CO_SRDO_process(&co->SRDO[i],
+        CO_SRDO_process(&CO_PROC(SRDO)[i],
                         firstOperational,
                         timeDifference_us,
                         timerNext_us);
@@ -38,6 +38,7 @@
 #include "301/CO_SYNC.h"
 #include "301/CO_PDO.h"
 #include "301/CO_TIME.h"
+#include "302/CO_conciseDcf.h"
 #include "303/CO_LEDs.h"
 #include "304/CO_GFC.h"
 #include "304/CO_SRDO.h"
@@ -45,7 +46,15 @@
 #include "305/CO_LSSmaster.h"
 #include "309/CO_gateway_ascii.h"
 #include "extra/CO_trace.h"
+#include "extra/CO_stats.h"
 
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_PROCESS
+#define CO_CONFIG_PROCESS (0)
+#endif
+#ifndef CO_CONFIG_CAN_IF_COUNT
+#define CO_CONFIG_CAN_IF_COUNT 1
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -95,6 +104,17 @@ extern "C" {
  * @}
  */
 
+/**
+ * @defgroup CO_CANopen_302 CANopen_302
+ * @{
+ *
+ * CANopen additional application layer functions (CiA 302)
+ *
+ * Network management functions of the NMT master, like boot-up of the NMT
+ * slaves, and configuration with concise DCF.
+ * @}
+ */
+
 /**
  * @defgroup CO_CANopen_303 CANopen_303
  * @{
@@ -186,6 +206,31 @@ extern "C" {
 #define CO_USE_GLOBALS
 #endif
 
+/**
+ * If macro is defined externally, then configuration is fully static, for
+ * production images with fixed "OD.h". CANopen objects are globals, as with
+ * @ref CO_USE_GLOBALS, which is then defined automatically. CO_process() and
+ * other processing functions use global objects directly instead of pointers
+ * from CO_t, object counts are OD_CNT_xxx constants from "OD.h", so loops
+ * have constant bounds and are unrolled (GCC) and branches for unused objects
+ * are removed by compiler. Check for unconfigured Node-ID is removed, if LSS
+ * slave is not enabled. CO_new() and CO_CANopenInit() must still be called.
+ * This is possible only if CO_MULTIPLE_OD is not defined.
+ */
+#ifdef CO_DOXYGEN
+#define CO_STATIC_CONFIG
+#endif
+
+/**
+ * If macro is defined externally, then CANopen objects are allocated from
+ * memory arena, provided by application to @ref CO_newArena(). Heap is not
+ * used and CO_new() is not available. Arena size can be determined with
+ * @ref CO_ARENA_SIZE.
+ */
+#ifdef CO_DOXYGEN
+#define CO_USE_ARENA
+#endif
+
 
 #if defined CO_MULTIPLE_OD || defined CO_DOXYGEN
 /**
@@ -272,6 +317,35 @@ typedef void CO_config_t;
 #endif /* CO_MULTIPLE_OD */
 
 
+#if ((CO_CONFIG_PROCESS) & CO_CONFIG_PROCESS_SCHEDULER) || defined CO_DOXYGEN
+/**
+ * Deadline of one CANopen object, processed by scheduler inside CO_process(),
+ * see @ref CO_CONFIG_PROCESS.
+ */
+typedef struct {
+    /** Time elapsed since object was processed last time, in microseconds */
+    uint32_t elapsed_us;
+    /** Time between last processing and next required processing, in
+     * microseconds, timerNext_us from the processing function. */
+    uint32_t timerNext_us;
+} CO_schedTask_t;
+#endif
+
+
+#if ((CO_CONFIG_PROCESS) & CO_CONFIG_PROCESS_BUDGET) || defined CO_DOXYGEN
+/**
+ * Tasks of CO_processBudget(), in round-robin order.
+ */
+typedef enum {
+    CO_PROC_TASK_SDO_SRV, /**< CO_process_SDOserver() */
+    CO_PROC_TASK_HB_CONS, /**< CO_process_HBconsumer() */
+    CO_PROC_TASK_TIME, /**< CO_process_TIME() */
+    CO_PROC_TASK_GTW, /**< CO_process_gateway() */
+    CO_PROC_TASK_COUNT /**< Number of tasks */
+} CO_procTask_t;
+#endif
+
+
 /**
  * CANopen object - collection of all CANopenNode objects
  */
@@ -287,6 +361,28 @@ typedef struct {
  #if defined CO_MULTIPLE_OD || defined CO_DOXYGEN
     uint16_t CNT_ALL_RX_MSGS; /**< Number of all CAN receive message objects. */
     uint16_t CNT_ALL_TX_MSGS; /**< Number of all CAN transmit message objects.*/
+ #endif
+ #if (CO_CONFIG_CAN_IF_COUNT > 1) || defined CO_DOXYGEN
+    /** All CAN modules, see @ref CO_CONFIG_CAN_IF_COUNT. CANmoduleIf[0] is the
+     * same as CANmodule, others are initialised by CO_CANinitIf(). */
+    CO_CANmodule_t *CANmoduleIf[CO_CONFIG_CAN_IF_COUNT];
+    /** CAN receive message objects for each CAN module */
+    CO_CANrx_t *CANrxIf[CO_CONFIG_CAN_IF_COUNT];
+    /** CAN transmit message objects for each CAN module */
+    CO_CANtx_t *CANtxIf[CO_CONFIG_CAN_IF_COUNT];
+    uint8_t *ifRPDO; /**< Interface of each RPDO, see CO_setInterface() */
+    uint8_t *ifTPDO; /**< Interface of each TPDO, see CO_setInterface() */
+    uint8_t *ifSDO_SRV; /**< Interface of each SDO server */
+    uint8_t *ifSDO_CLI; /**< Interface of each SDO client */
+    uint8_t ifHB_CONS; /**< Interface of Heartbeat consumer */
+  #if defined CO_MULTIPLE_OD || defined CO_DOXYGEN
+    /** Index in CANrx of the first object, which can be bound to additional
+     * interface. CANrxIf[1..] contain only objects from here on. */
+    uint16_t IF_RX_IDX_FIRST;
+    uint16_t CNT_IF_RX_MSGS; /**< Size of CANrxIf[1..] */
+    uint16_t IF_TX_IDX_FIRST; /**< Same as IF_RX_IDX_FIRST, for CANtx */
+    uint16_t CNT_IF_TX_MSGS; /**< Size of CANtxIf[1..] */
+  #endif
  #endif
     /** NMT and heartbeat object, initialised by @ref CO_NMT_init() */
     CO_NMT_t *NMT;
@@ -317,6 +413,11 @@ typedef struct {
 #endif
     /** SDO server objects, initialised by @ref CO_SDOserver_init() */
     CO_SDOserver_t *SDOserver;
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL) || defined CO_DOXYGEN
+    /** Buffer pool shared by all SDO servers, initialised by
+     * @ref CO_SDOserver_bufferPoolInit() */
+    CO_SDOserver_bufferPool_t *SDObufPool;
+#endif
  #if defined CO_MULTIPLE_OD || defined CO_DOXYGEN
     uint16_t RX_IDX_SDO_SRV; /**< Start index in CANrx. */
     uint16_t TX_IDX_SDO_SRV; /**< Start index in CANtx. */
@@ -358,6 +459,14 @@ typedef struct {
  #if defined CO_MULTIPLE_OD || defined CO_DOXYGEN
     uint16_t TX_IDX_TPDO; /**< Start index in CANtx. */
  #endif
+ #if ((CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_BATCH) || defined CO_DOXYGEN
+    /** Synchronous TPDOs, collected and sent by @ref CO_process_TPDO() */
+    CO_CANtxBatch_t TPDOtxBatch;
+ #endif
+ #if ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_REQUEST_COUNT) || defined CO_DOXYGEN
+    /** Last seen value of @ref OD_TPDOrequestCount */
+    uint32_t TPDOrequestCount;
+ #endif
 #endif
 #if ((CO_CONFIG_LEDS) & CO_CONFIG_LEDS_ENABLE) || defined CO_DOXYGEN
     /** LEDs object, initialised by @ref CO_LEDs_init() */
@@ -408,9 +517,270 @@ typedef struct {
     /** Trace object, initialised by @ref CO_trace_init(). */
     CO_trace_t *trace;
 #endif
+#if ((CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE) || defined CO_DOXYGEN
+    /** Statistics object, initialised by @ref CO_stats_init() inside
+     * CO_CANopenInit(). */
+    CO_stats_t stats;
+#endif
+#if ((CO_CONFIG_CONCISE_DCF) & CO_CONFIG_CONCISE_DCF_ENABLE) || defined CO_DOXYGEN
+    /** Concise DCF consumer on OD object 0x1F22, initialised by
+     * @ref CO_conciseDcf_init() inside CO_CANopenInit(). */
+    CO_conciseDcf_t conciseDcf;
+#endif
+#if ((CO_CONFIG_PROCESS) & CO_CONFIG_PROCESS_SCHEDULER) || defined CO_DOXYGEN
+ #if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE) || defined CO_DOXYGEN
+    /** Deadline of Heartbeat consumer for scheduler inside CO_process() */
+    CO_schedTask_t schedHBcons;
+ #endif
+    /** Set by CO_process_SDOserver() if any SDO server was active, cleared by
+     * CO_process_HBconsumer(). */
+    volatile bool_t schedSDOactive;
+#endif
+#if ((CO_CONFIG_PROCESS) & CO_CONFIG_PROCESS_BUDGET) || defined CO_DOXYGEN
+    /** Task, @ref CO_procTask_t, from which next CO_processBudget() starts */
+    uint8_t budgetTaskNext;
+    /** Time elapsed since each task was processed by CO_processBudget() */
+    uint32_t budgetElapsed_us[CO_PROC_TASK_COUNT];
+#endif
 } CO_t;
 
 
+#if defined CO_USE_ARENA || defined CO_DOXYGEN
+/** Alignment of each object inside the arena, in bytes. Arena itself must be
+ * aligned to the same value. */
+#ifndef CO_ARENA_ALIGN
+#define CO_ARENA_ALIGN 8
+#endif
+
+/** Size of count objects of type inside arena, including alignment padding */
+#define CO_ARENA_ITEM(type, count) \
+    ((sizeof(type) * (count) + CO_ARENA_ALIGN - 1) / CO_ARENA_ALIGN \
+     * CO_ARENA_ALIGN)
+
+ #if !defined CO_MULTIPLE_OD || defined CO_DOXYGEN
+#include "OD.h"
+
+/* Counts of objects from "OD.h", defaults are the same as in CANopen.c */
+  #ifdef OD_CNT_SDO_SRV
+   #define CO_ARENA_CNT_SDO_SRV OD_CNT_SDO_SRV
+  #else
+   #define CO_ARENA_CNT_SDO_SRV 1
+  #endif
+  #ifdef OD_CNT_ARR_1003
+   #define CO_ARENA_CNT_ARR_1003 OD_CNT_ARR_1003
+  #else
+   #define CO_ARENA_CNT_ARR_1003 8
+  #endif
+  #if defined OD_CNT_HB_CONS && defined OD_CNT_ARR_1016 \
+      && ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE)
+   #define CO_ARENA_CNT_HB_CONS (OD_CNT_HB_CONS * OD_CNT_ARR_1016)
+  #else
+   #define CO_ARENA_CNT_HB_CONS 0
+  #endif
+  #if defined OD_CNT_SDO_CLI && ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE)
+   #define CO_ARENA_CNT_SDO_CLI OD_CNT_SDO_CLI
+  #else
+   #define CO_ARENA_CNT_SDO_CLI 0
+  #endif
+  #if defined OD_CNT_TIME && ((CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE)
+   #define CO_ARENA_CNT_TIME OD_CNT_TIME
+  #else
+   #define CO_ARENA_CNT_TIME 0
+  #endif
+  #if defined OD_CNT_SYNC && ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_ENABLE)
+   #define CO_ARENA_CNT_SYNC OD_CNT_SYNC
+  #else
+   #define CO_ARENA_CNT_SYNC 0
+  #endif
+  #if defined OD_CNT_RPDO && ((CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE)
+   #define CO_ARENA_CNT_RPDO OD_CNT_RPDO
+  #else
+   #define CO_ARENA_CNT_RPDO 0
+  #endif
+  #if defined OD_CNT_TPDO && ((CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE)
+   #define CO_ARENA_CNT_TPDO OD_CNT_TPDO
+  #else
+   #define CO_ARENA_CNT_TPDO 0
+  #endif
+  #if defined OD_CNT_LEDS && ((CO_CONFIG_LEDS) & CO_CONFIG_LEDS_ENABLE)
+   #define CO_ARENA_CNT_LEDS OD_CNT_LEDS
+  #else
+   #define CO_ARENA_CNT_LEDS 0
+  #endif
+  #if defined OD_CNT_GFC && ((CO_CONFIG_GFC) & CO_CONFIG_GFC_ENABLE)
+   #define CO_ARENA_CNT_GFC OD_CNT_GFC
+  #else
+   #define CO_ARENA_CNT_GFC 0
+  #endif
+  #if defined OD_CNT_SRDO && ((CO_CONFIG_SRDO) & CO_CONFIG_SRDO_ENABLE)
+   #define CO_ARENA_CNT_SRDO OD_CNT_SRDO
+  #else
+   #define CO_ARENA_CNT_SRDO 0
+  #endif
+  #if defined OD_CNT_TRACE && ((CO_CONFIG_TRACE) & CO_CONFIG_TRACE_ENABLE)
+   #define CO_ARENA_CNT_TRACE OD_CNT_TRACE
+  #else
+   #define CO_ARENA_CNT_TRACE 0
+  #endif
+
+/* Objects, which may be disabled by configuration */
+  #if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
+   #define CO_ARENA_SIZE_EM_FIFO \
+       CO_ARENA_ITEM(CO_EM_fifo_t, CO_ARENA_CNT_ARR_1003 + 1)
+  #else
+   #define CO_ARENA_SIZE_EM_FIFO 0
+  #endif
+  #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+   #define CO_ARENA_SIZE_HB_CONS (CO_ARENA_CNT_HB_CONS > 0 \
+       ? (CO_ARENA_ITEM(CO_HBconsumer_t, 1) \
+          + CO_ARENA_ITEM(CO_HBconsNode_t, CO_ARENA_CNT_HB_CONS)) : 0)
+  #else
+   #define CO_ARENA_SIZE_HB_CONS 0
+  #endif
+  #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BUFFER_POOL
+   #define CO_ARENA_SIZE_SDO_SRV_POOL \
+       CO_ARENA_ITEM(CO_SDOserver_bufferPool_t, 1)
+  #else
+   #define CO_ARENA_SIZE_SDO_SRV_POOL 0
+  #endif
+  #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
+   #define CO_ARENA_SIZE_SDO_CLI \
+       CO_ARENA_ITEM(CO_SDOclient_t, CO_ARENA_CNT_SDO_CLI)
+  #else
+   #define CO_ARENA_SIZE_SDO_CLI 0
+  #endif
+  #if (CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE
+   #define CO_ARENA_SIZE_TIME CO_ARENA_ITEM(CO_TIME_t, CO_ARENA_CNT_TIME)
+  #else
+   #define CO_ARENA_SIZE_TIME 0
+  #endif
+  #if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_ENABLE
+   #define CO_ARENA_SIZE_SYNC CO_ARENA_ITEM(CO_SYNC_t, CO_ARENA_CNT_SYNC)
+  #else
+   #define CO_ARENA_SIZE_SYNC 0
+  #endif
+  #if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+   #define CO_ARENA_SIZE_RPDO CO_ARENA_ITEM(CO_RPDO_t, CO_ARENA_CNT_RPDO)
+  #else
+   #define CO_ARENA_SIZE_RPDO 0
+  #endif
+  #if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+   #define CO_ARENA_SIZE_TPDO CO_ARENA_ITEM(CO_TPDO_t, CO_ARENA_CNT_TPDO)
+  #else
+   #define CO_ARENA_SIZE_TPDO 0
+  #endif
+  #if (CO_CONFIG_LEDS) & CO_CONFIG_LEDS_ENABLE
+   #define CO_ARENA_SIZE_LEDS CO_ARENA_ITEM(CO_LEDs_t, CO_ARENA_CNT_LEDS)
+  #else
+   #define CO_ARENA_SIZE_LEDS 0
+  #endif
+  #if (CO_CONFIG_GFC) & CO_CONFIG_GFC_ENABLE
+   #define CO_ARENA_SIZE_GFC CO_ARENA_ITEM(CO_GFC_t, CO_ARENA_CNT_GFC)
+  #else
+   #define CO_ARENA_SIZE_GFC 0
+  #endif
+  #if (CO_CONFIG_SRDO) & CO_CONFIG_SRDO_ENABLE
+   #define CO_ARENA_SIZE_SRDO (CO_ARENA_CNT_SRDO > 0 \
+       ? (CO_ARENA_ITEM(CO_SRDOGuard_t, 1) \
+          + CO_ARENA_ITEM(CO_SRDO_t, CO_ARENA_CNT_SRDO)) : 0)
+  #else
+   #define CO_ARENA_SIZE_SRDO 0
+  #endif
+  #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_SLAVE
+   #define CO_ARENA_SIZE_LSS_SLV CO_ARENA_ITEM(CO_LSSslave_t, 1)
+  #else
+   #define CO_ARENA_SIZE_LSS_SLV 0
+  #endif
+  #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER
+   #define CO_ARENA_SIZE_LSS_MST CO_ARENA_ITEM(CO_LSSmaster_t, 1)
+  #else
+   #define CO_ARENA_SIZE_LSS_MST 0
+  #endif
+  #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
+   #define CO_ARENA_SIZE_GTWA CO_ARENA_ITEM(CO_GTWA_t, 1)
+  #else
+   #define CO_ARENA_SIZE_GTWA 0
+  #endif
+  #if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_ENABLE
+   #define CO_ARENA_SIZE_TRACE CO_ARENA_ITEM(CO_trace_t, CO_ARENA_CNT_TRACE)
+  #else
+   #define CO_ARENA_SIZE_TRACE 0
+  #endif
+
+/* Upper limit for number of CAN receive and transmit buffers */
+#define CO_ARENA_CNT_RX_MSGS (7 + CO_ARENA_CNT_SRDO * 2 + CO_ARENA_CNT_RPDO \
+    + CO_ARENA_CNT_SDO_SRV + CO_ARENA_CNT_SDO_CLI + CO_ARENA_CNT_HB_CONS)
+#define CO_ARENA_CNT_TX_MSGS (8 + CO_ARENA_CNT_SRDO * 2 + CO_ARENA_CNT_TPDO \
+    + CO_ARENA_CNT_SDO_SRV + CO_ARENA_CNT_SDO_CLI)
+
+/* Additional CAN modules with own rx and tx arrays and interface number of
+ * each PDO and SDO, see @ref CO_CONFIG_CAN_IF_COUNT */
+  #if CO_CONFIG_CAN_IF_COUNT > 1
+   #define CO_ARENA_SIZE_CAN_IF ((CO_CONFIG_CAN_IF_COUNT - 1) \
+    * (CO_ARENA_ITEM(CO_CANmodule_t, 1) \
+       + CO_ARENA_ITEM(CO_CANrx_t, CO_ARENA_CNT_RPDO + CO_ARENA_CNT_SDO_SRV \
+                       + CO_ARENA_CNT_SDO_CLI + CO_ARENA_CNT_HB_CONS) \
+       + CO_ARENA_ITEM(CO_CANtx_t, CO_ARENA_CNT_TPDO + CO_ARENA_CNT_SDO_SRV \
+                       + CO_ARENA_CNT_SDO_CLI)) \
+    + CO_ARENA_ITEM(uint8_t, CO_ARENA_CNT_RPDO) \
+    + CO_ARENA_ITEM(uint8_t, CO_ARENA_CNT_TPDO) \
+    + CO_ARENA_ITEM(uint8_t, CO_ARENA_CNT_SDO_SRV) \
+    + CO_ARENA_ITEM(uint8_t, CO_ARENA_CNT_SDO_CLI))
+  #else
+   #define CO_ARENA_SIZE_CAN_IF 0
+  #endif
+
+/**
+ * Size of memory arena for @ref CO_newArena(), in bytes.
+ *
+ * Size is calculated from OD_CNT_xxx macros from "OD.h" and from CO_CONFIG_xxx
+ * macros. It is not available, if @ref CO_MULTIPLE_OD is defined. Value may be
+ * slightly larger than required, exact required size is returned in
+ * heapMemoryUsed of CO_newArena(). Example:
+ * @code{.c}
+static uint64_t CO_arena[CO_ARENA_SIZE / sizeof(uint64_t)];
+co = CO_newArena(NULL, CO_arena, sizeof(CO_arena), &heapMemoryUsed);
+ * @endcode
+ */
+#define CO_ARENA_SIZE (CO_ARENA_ITEM(CO_t, 1) \
+    + CO_ARENA_ITEM(CO_CANmodule_t, 1) \
+    + CO_ARENA_ITEM(CO_CANrx_t, CO_ARENA_CNT_RX_MSGS) \
+    + CO_ARENA_ITEM(CO_CANtx_t, CO_ARENA_CNT_TX_MSGS) \
+    + CO_ARENA_SIZE_CAN_IF \
+    + CO_ARENA_ITEM(CO_NMT_t, 1) \
+    + CO_ARENA_ITEM(CO_EM_t, 1) + CO_ARENA_SIZE_EM_FIFO \
+    + CO_ARENA_ITEM(CO_SDOserver_t, CO_ARENA_CNT_SDO_SRV) \
+    + CO_ARENA_SIZE_SDO_SRV_POOL \
+    + CO_ARENA_SIZE_HB_CONS + CO_ARENA_SIZE_SDO_CLI + CO_ARENA_SIZE_TIME \
+    + CO_ARENA_SIZE_SYNC + CO_ARENA_SIZE_RPDO + CO_ARENA_SIZE_TPDO \
+    + CO_ARENA_SIZE_LEDS + CO_ARENA_SIZE_GFC + CO_ARENA_SIZE_SRDO \
+    + CO_ARENA_SIZE_LSS_SLV + CO_ARENA_SIZE_LSS_MST + CO_ARENA_SIZE_GTWA \
+    + CO_ARENA_SIZE_TRACE)
+ #endif /* !defined CO_MULTIPLE_OD */
+
+
+/**
+ * Create new CANopen object inside memory arena, if @ref CO_USE_ARENA is
+ * defined.
+ *
+ * All CANopenNode objects are placed consecutively into the arena and zeroed,
+ * allocator is not used. Arena must stay in memory until CO_delete(). After
+ * CO_delete() the same arena may be reused by next CO_newArena() call.
+ *
+ * @param config The same as in @ref CO_new().
+ * @param arena Memory provided by application, aligned to @ref CO_ARENA_ALIGN.
+ * @param arenaSize Size of arena in bytes, see @ref CO_ARENA_SIZE.
+ * @param [out] heapMemoryUsed Exact number of bytes used from the arena,
+ * including alignment padding. Ignored if NULL.
+ *
+ * @return Successfully configured CO_t object or NULL, if arena is too small
+ * or arguments are wrong.
+ */
+CO_t *CO_newArena(CO_config_t *config, void *arena, size_t arenaSize,
+                  uint32_t *heapMemoryUsed);
+#endif /* defined CO_USE_ARENA */
+
+
 /**
  * Create new CANopen object
  *
@@ -465,6 +835,59 @@ bool_t CO_isLSSslaveEnabled(CO_t *co);
 CO_ReturnError_t CO_CANinit(CO_t *co, void *CANptr, uint16_t bitRate);
 
 
+#if (CO_CONFIG_CAN_IF_COUNT > 1) || defined CO_DOXYGEN
+/**
+ * CANopen objects, which can be bound to other CAN interface, see
+ * CO_setInterface().
+ */
+typedef enum {
+    CO_IF_OBJ_RPDO = 0,     /**< RPDO, index is RPDO number - 1 */
+    CO_IF_OBJ_TPDO = 1,     /**< TPDO, index is TPDO number - 1 */
+    CO_IF_OBJ_SDO_SRV = 2,  /**< SDO server, index from 0 */
+    CO_IF_OBJ_SDO_CLI = 3,  /**< SDO client, index from 0 */
+    CO_IF_OBJ_HB_CONS = 4   /**< Heartbeat consumer, index must be 0 */
+} CO_ifObject_t;
+
+
+/**
+ * Initialize additional CAN interface, see @ref CO_CONFIG_CAN_IF_COUNT.
+ *
+ * Function must be called in the communication reset section, same as
+ * CO_CANinit(). CO_CANinitIf(co, 0, ...) is the same as CO_CANinit(). After
+ * CO_CANopenInit() and CO_CANopenInitPDO() application must call
+ * CO_CANsetNormalMode() for each interface, co->CANmoduleIf[0] to
+ * co->CANmoduleIf[CO_CONFIG_CAN_IF_COUNT - 1], not only for co->CANmodule.
+ *
+ * @param co CANopen object.
+ * @param ifNo Interface number, from 0 to CO_CONFIG_CAN_IF_COUNT - 1.
+ * @param CANptr Pointer to the user-defined CAN base structure, passed to
+ *               CO_CANmodule_init().
+ * @param bitRate CAN bit rate.
+ * @return CO_ERROR_NO in case of success.
+ */
+CO_ReturnError_t CO_CANinitIf(CO_t *co, uint8_t ifNo,
+                              void *CANptr, uint16_t bitRate);
+
+
+/**
+ * Bind CANopen object to CAN interface.
+ *
+ * Binding is used by the next CO_CANopenInit() (SDO, Heartbeat consumer) or
+ * CO_CANopenInitPDO() (RPDO, TPDO), so it must be set before them. It stays
+ * valid until CO_delete(). CAN-IDs are configured in Object Dictionary as
+ * usual, independently for each object.
+ *
+ * @param co CANopen object.
+ * @param object Type of CANopen object.
+ * @param index Index of the object of that type.
+ * @param ifNo Interface number, from 0 to CO_CONFIG_CAN_IF_COUNT - 1.
+ * @return CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT, if object does not exist.
+ */
+CO_ReturnError_t CO_setInterface(CO_t *co, CO_ifObject_t object,
+                                 uint16_t index, uint8_t ifNo);
+#endif /* CO_CONFIG_CAN_IF_COUNT > 1 */
+
+
 #if ((CO_CONFIG_LSS) & CO_CONFIG_LSS_SLAVE) || defined CO_DOXYGEN
 /**
  * Initialize CANopen LSS slave
@@ -560,7 +983,9 @@ CO_ReturnError_t CO_CANopenInitPDO(CO_t *co,
  * Process CANopen objects.
  *
  * Function must be called cyclically. It processes all "asynchronous" CANopen
- * objects.
+ * objects. It calls CO_process_NMT(), CO_process_SDOserver(),
+ * CO_process_HBconsumer(), CO_process_TIME() and CO_process_gateway() in that
+ * order.
  *
  * @param co CANopen object.
  * @param enableGateway If true, gateway to external world will be enabled.
@@ -576,6 +1001,9 @@ CO_ReturnError_t CO_CANopenInitPDO(CO_t *co,
  *        trigger calling of CO_process() function. Parameter is ignored if
  *        NULL. See also @ref CO_CONFIG_FLAG_CALLBACK_PRE configuration macro.
  *
+ * If scheduler is enabled by @ref CO_CONFIG_PROCESS, then idle objects are
+ * skipped and processed later with accumulated time difference.
+ *
  * @return Node or communication reset request, from @ref CO_NMT_process().
  */
 CO_NMT_reset_cmd_t CO_process(CO_t *co,
@@ -584,6 +1012,128 @@ CO_NMT_reset_cmd_t CO_process(CO_t *co,
                               uint32_t *timerNext_us);
 
 
+#if ((CO_CONFIG_PROCESS) & CO_CONFIG_PROCESS_BUDGET) || defined CO_DOXYGEN
+/**
+ * Process CANopen objects with limited amount of work.
+ *
+ * Function may be used instead of CO_process() in cooperative schedulers,
+ * which require bounded execution time of each call. CO_process_NMT() is
+ * called first on each call, because CAN module, Emergency and Heartbeat
+ * producer are time critical. Other tasks from @ref CO_procTask_t are then
+ * processed in round-robin order, while work budget lasts. Work of the task is
+ * number of its active objects: each SDO server with pending request or
+ * transfer in progress, or object of other task. Task with no work is always
+ * processed. Next call starts with the first task, which was not processed.
+ * Skipped tasks accumulate time difference.
+ *
+ * Scope is narrower than a time budget with per-subsystem quotas:
+ * - Budget is counted in objects, not in time. One object may still do a
+ *   variable amount of work, for example an SDO server processes one block or
+ *   segment, gateway parses its input buffer.
+ * - Task is never split: it is processed completely, if any budget remains,
+ *   even if its work is larger. So the budget may be exceeded by the work of
+ *   the last processed task.
+ * - There are no per-task quotas, tasks share one budget in round-robin order.
+ * - Pending work is reported only as timerNext_us = 0, not by amount.
+ * - PDO, SYNC, SRDO and other mainline functions are not included.
+ *
+ * @param co CANopen object.
+ * @param enableGateway If true, gateway to external world will be enabled.
+ * @param timeDifference_us Time difference from previous function call in
+ *                          microseconds.
+ * @param [out] timerNext_us info to OS - see CO_process(). If some tasks were
+ * not processed because of the budget, it is set to zero: function should be
+ * called again immediately.
+ * @param budget Maximum work for this call, in number of processed objects.
+ * If zero, only tasks with no work are processed.
+ *
+ * @return Node or communication reset request, from @ref CO_NMT_process().
+ */
+CO_NMT_reset_cmd_t CO_processBudget(CO_t *co,
+                                    bool_t enableGateway,
+                                    uint32_t timeDifference_us,
+                                    uint32_t *timerNext_us,
+                                    uint16_t budget);
+#endif
+
+
+/**
+ * Process CAN module, LSS slave, LEDs, Emergency and NMT objects.
+ *
+ * This and following CO_process_xxx() functions are tasks of CO_process().
+ * Application may call them separately instead of CO_process(), for example
+ * with different intervals or from different threads. Each CANopen object is
+ * processed by one task only. If tasks run in different threads, application
+ * must protect each task call with @ref CO_LOCK_OD_GROUP and OD_LOCK_GRP_COMM
+ * group, because tasks share communication parameters from Object Dictionary.
+ * Parameters are the same as in CO_process().
+ *
+ * @return Node or communication reset request, from @ref CO_NMT_process().
+ */
+CO_NMT_reset_cmd_t CO_process_NMT(CO_t *co,
+                                  uint32_t timeDifference_us,
+                                  uint32_t *timerNext_us);
+
+
+/**
+ * Process SDO server objects, see @ref CO_process_NMT().
+ *
+ * @param co CANopen object.
+ * @param timeDifference_us Time difference from previous function call.
+ * @param [out] timerNext_us info to OS - see CO_process().
+ */
+void CO_process_SDOserver(CO_t *co,
+                          uint32_t timeDifference_us,
+                          uint32_t *timerNext_us);
+
+
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE) || defined CO_DOXYGEN
+/**
+ * Process Heartbeat consumer object, see @ref CO_process_NMT().
+ *
+ * If scheduler is enabled by @ref CO_CONFIG_PROCESS, it should be called after
+ * CO_process_SDOserver(), which informs it about possible change of 0x1016.
+ *
+ * @param co CANopen object.
+ * @param timeDifference_us Time difference from previous function call.
+ * @param [out] timerNext_us info to OS - see CO_process().
+ */
+void CO_process_HBconsumer(CO_t *co,
+                           uint32_t timeDifference_us,
+                           uint32_t *timerNext_us);
+#endif
+
+
+#if ((CO_CONFIG_TIME) & CO_CONFIG_TIME_ENABLE) || defined CO_DOXYGEN
+/**
+ * Process TIME object, see @ref CO_process_NMT().
+ *
+ * @param co CANopen object.
+ * @param timeDifference_us Time difference from previous function call.
+ * @param [out] timerNext_us info to OS - see CO_process().
+ */
+void CO_process_TIME(CO_t *co,
+                     uint32_t timeDifference_us,
+                     uint32_t *timerNext_us);
+#endif
+
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII) || defined CO_DOXYGEN
+/**
+ * Process gateway-ascii object, see @ref CO_process_NMT().
+ *
+ * @param co CANopen object.
+ * @param enableGateway If true, gateway to external world will be enabled.
+ * @param timeDifference_us Time difference from previous function call.
+ * @param [out] timerNext_us info to OS - see CO_process().
+ */
+void CO_process_gateway(CO_t *co,
+                        bool_t enableGateway,
+                        uint32_t timeDifference_us,
+                        uint32_t *timerNext_us);
+#endif
+
+
 #if ((CO_CONFIG_SYNC) & CO_CONFIG_SYNC_ENABLE) || defined CO_DOXYGEN
 /**
  * Process CANopen SYNC objects.
@@ -633,7 +1183,8 @@ void CO_process_RPDO(CO_t *co,
  *
  * Function must be called cyclically. For time critical applications it may be
  * called from real time thread with constant interval (1ms typically). It
- * processes transmit PDO CANopen objects.
+ * processes transmit PDO CANopen objects. If @ref CO_CONFIG_DRIVER_TX_BATCH is
+ * enabled, synchronous TPDOs are sent together with CO_CANsendBatch().
  *
  * @param co CANopen object.
  * @param syncWas True, if CANopen SYNC message was just received or
@@ -0,0 +1,103 @@
+/*
+ * Stack configuration for the CANopenNode host benchmark.
+ *
+ * @file        CO_driver_custom.h
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CO_DRIVER_CUSTOM_H
+#define CO_DRIVER_CUSTOM_H
+
+/* This file is included from example/CO_driver_target.h, if CO_DRIVER_CUSTOM
+ * is defined. It enables modules, measured by bench_main.c. Any value may be
+ * overridden from the command line, for example:
+ * make OPT_EXTRA="-DCO_CONFIG_DRIVER=0" */
+
+#ifndef CO_CONFIG_DRIVER
+#define CO_CONFIG_DRIVER (CO_CONFIG_DRIVER_RX_DISPATCH)
+#endif
+
+/* All 127 heartbeats of one benchmark step must fit into the virtual bus and
+ * into the receive ring, if CO_CONFIG_DRIVER_RX_RING is enabled */
+#ifndef CO_DRIVER_LOOPBACK_SIZE
+#define CO_DRIVER_LOOPBACK_SIZE 256
+#endif
+#ifndef CO_CONFIG_DRIVER_RX_RING_SIZE
+#define CO_CONFIG_DRIVER_RX_RING_SIZE 256
+#endif
+
+#ifndef CO_CONFIG_NMT
+#define CO_CONFIG_NMT (CO_CONFIG_NMT_MASTER | \
+                       CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE | \
+                       CO_CONFIG_GLOBAL_FLAG_TIMERNEXT)
+#endif
+
+#ifndef CO_CONFIG_SDO_SRV
+#define CO_CONFIG_SDO_SRV (CO_CONFIG_SDO_SRV_SEGMENTED | \
+                           CO_CONFIG_SDO_SRV_BLOCK | \
+                           CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE | \
+                           CO_CONFIG_GLOBAL_FLAG_TIMERNEXT | \
+                           CO_CONFIG_GLOBAL_FLAG_OD_DYNAMIC)
+#endif
+#ifndef CO_CONFIG_SDO_SRV_BUFFER_SIZE
+#define CO_CONFIG_SDO_SRV_BUFFER_SIZE 1024
+#endif
+
+#ifndef CO_CONFIG_SDO_CLI
+#define CO_CONFIG_SDO_CLI (CO_CONFIG_SDO_CLI_ENABLE | \
+                           CO_CONFIG_SDO_CLI_SEGMENTED | \
+                           CO_CONFIG_SDO_CLI_BLOCK | \
+                           CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE | \
+                           CO_CONFIG_GLOBAL_FLAG_TIMERNEXT | \
+                           CO_CONFIG_GLOBAL_FLAG_OD_DYNAMIC)
+#endif
+#ifndef CO_CONFIG_SDO_CLI_BUFFER_SIZE
+#define CO_CONFIG_SDO_CLI_BUFFER_SIZE 1000
+#endif
+
+#ifndef CO_CONFIG_GTW
+#define CO_CONFIG_GTW (CO_CONFIG_GTW_ASCII | \
+                       CO_CONFIG_GTW_ASCII_SDO | \
+                       CO_CONFIG_GTW_ASCII_NMT)
+#endif
+#ifndef CO_CONFIG_GTW_BLOCK_DL_LOOP
+#define CO_CONFIG_GTW_BLOCK_DL_LOOP 1
+#endif
+#ifndef CO_CONFIG_GTWA_COMM_BUF_SIZE
+#define CO_CONFIG_GTWA_COMM_BUF_SIZE 200
+#endif
+#ifndef CO_CONFIG_GTWA_LOG_BUF_SIZE
+#define CO_CONFIG_GTWA_LOG_BUF_SIZE 2000
+#endif
+
+#ifndef CO_CONFIG_FIFO
+#define CO_CONFIG_FIFO (CO_CONFIG_FIFO_ENABLE | \
+                        CO_CONFIG_FIFO_ALT_READ | \
+                        CO_CONFIG_FIFO_CRC16_CCITT | \
+                        CO_CONFIG_FIFO_ASCII_COMMANDS | \
+                        CO_CONFIG_FIFO_ASCII_DATATYPES)
+#endif
+
+#ifndef CO_CONFIG_CRC16
+#define CO_CONFIG_CRC16 (CO_CONFIG_CRC16_ENABLE)
+#endif
+
+#endif /* CO_DRIVER_CUSTOM_H */
@@ -0,0 +1,645 @@
+/*
+ * CANopenNode host benchmark: throughput of the main communication paths.
+ *
+ * @file        bench_main.c
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <time.h>
+
+#define OD_DEFINITION
+#include "301/CO_ODinterface.h"
+#include "CANopen.h"
+#include "OD.h"
+
+#ifndef CO_MULTIPLE_OD
+#error Benchmark requires CO_MULTIPLE_OD, Object Dictionary is extended.
+#endif
+#ifndef CO_DRIVER_LOOPBACK
+#error Benchmark requires CO_DRIVER_LOOPBACK, virtual CAN bus of blank driver.
+#endif
+#if !((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK) \
+    || !((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_BLOCK) \
+    || !((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO) \
+    || !((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_NMT)
+#error Benchmark requires configuration from CO_driver_custom.h.
+#endif
+
+
+#define log_printf(macropar_message, ...) \
+        printf(macropar_message, ##__VA_ARGS__)
+
+
+/* default values for CO_CANopenInit() */
+#define NMT_CONTROL \
+            CO_NMT_STARTUP_TO_OPERATIONAL \
+          | CO_NMT_ERR_ON_ERR_REG \
+          | CO_ERR_REG_GENERIC_ERR \
+          | CO_ERR_REG_COMMUNICATION
+#define FIRST_HB_TIME 0
+#define SDO_SRV_TIMEOUT_TIME 1000
+#define SDO_CLI_TIMEOUT_TIME 1000
+#define SDO_CLI_BLOCK false
+
+/* Node-ID of the benchmarked device. Its SDO client talks to own SDO server
+ * and its TPDO and RPDO use own COB-IDs, all over the virtual CAN bus. */
+#define NODE_ID 1
+/* Heartbeat consumer monitors all nodes on the network */
+#define HB_CONS_NODES 127
+#define HB_CONSUMER_TIME_MS 1000
+/* Size of the OD variable for segmented and block SDO transfer */
+#define SDO_DATA_SIZE 1024
+/* Limit of the processing loops for one SDO transfer or gateway command */
+#define LOOPS_MAX 100000
+
+/* Default benchmark parameters, may be changed by program arguments */
+#define DEFAULT_REPEAT 3
+#define DEFAULT_TOLERANCE_PERCENT 25
+
+
+/* Device with Object Dictionary from OD.c, extended with manufacturer
+ * specific objects, which are used for PDO and SDO transfers */
+typedef struct {
+    CO_t *co;
+    CO_config_t config;
+    OD_t od;
+    OD_entry_t *odList;
+    /* Larger array for OD object 0x1016 */
+    OD_obj_array_t hbConsObj;
+    uint8_t hbConsCount;
+    uint32_t hbCons[HB_CONS_NODES];
+    /* OD object 0x2000, array of mappable variables */
+    OD_obj_array_t pdoObj;
+    uint8_t pdoCount;
+    uint32_t pdoData[8];
+    /* OD object 0x2001, octet string for SDO transfers */
+    OD_obj_var_t sdoObj;
+    uint8_t sdoData[SDO_DATA_SIZE];
+    /* Responses from the gateway */
+    uint32_t gtwaResponses;
+    uint32_t gtwaErrors;
+} benchDev_t;
+
+
+/* Result of one benchmark. Operation is one PDO, SDO transfer, OD_find() call,
+ * set of heartbeats or gateway command, frames are all CAN messages received
+ * from the virtual bus during the benchmark. */
+typedef struct {
+    const char *name;
+    uint32_t ops;
+    uint32_t frames;
+    uint64_t time_ns;
+} benchResult_t;
+
+
+static uint64_t timeNow_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+
+/* Put message on the virtual bus, as it would be sent by other device */
+static bool_t busInject(CO_CANmodule_t *CANmodule, uint16_t ident,
+                        uint8_t DLC, const uint8_t *data)
+{
+    uint16_t head = CANmodule->loopbackHead;
+    uint16_t headNext = (head + 1U) & (CO_DRIVER_LOOPBACK_SIZE - 1U);
+    CO_CANrxMsg_t *msg = &CANmodule->loopback[head];
+
+    if (headNext == CANmodule->loopbackTail) {
+        return false;
+    }
+    msg->ident = ident;
+    msg->DLC = DLC;
+    memset(msg->data, 0, sizeof(msg->data));
+    memcpy(msg->data, data, DLC);
+    CANmodule->loopbackHead = headNext;
+    return true;
+}
+
+
+/* Copy OD entries from OD.c and append manufacturer specific objects. OD
+ * objects and variables from OD.c are shared, except 0x1016, which is
+ * replaced with larger array, so heartbeats of all nodes can be consumed. */
+static bool_t odExtend(benchDev_t *dev) {
+    uint16_t size = OD->size;
+    OD_entry_t *entry;
+
+    dev->odList = calloc(size + 3U, sizeof(OD_entry_t));
+    if (dev->odList == NULL) {
+        return false;
+    }
+    memcpy(dev->odList, OD->list, size * sizeof(OD_entry_t));
+
+    dev->pdoCount = 8;
+    dev->pdoObj.dataOrig0 = &dev->pdoCount;
+    dev->pdoObj.dataOrig = dev->pdoData;
+    dev->pdoObj.attribute0 = ODA_SDO_R;
+    dev->pdoObj.attribute = ODA_SDO_RW | ODA_TRPDO | ODA_MB;
+    dev->pdoObj.dataElementLength = sizeof(dev->pdoData[0]);
+    dev->pdoObj.dataElementSizeof = sizeof(dev->pdoData[0]);
+    entry = &dev->odList[size++];
+    entry->index = 0x2000;
+    entry->subEntriesCount = dev->pdoCount + 1U;
+    entry->odObjectType = ODT_ARR;
+    entry->odObject = &dev->pdoObj;
+
+    dev->sdoObj.dataOrig = dev->sdoData;
+    dev->sdoObj.attribute = ODA_SDO_RW;
+    dev->sdoObj.dataLength = sizeof(dev->sdoData);
+    entry = &dev->odList[size++];
+    entry->index = 0x2001;
+    entry->subEntriesCount = 1;
+    entry->odObjectType = ODT_VAR;
+    entry->odObject = &dev->sdoObj;
+
+    memset(&dev->od, 0, sizeof(dev->od));
+    dev->od.size = size;
+    dev->od.list = dev->odList;
+
+    entry = OD_find(&dev->od, 0x1016);
+    if (entry == NULL) {
+        return false;
+    }
+    dev->hbConsObj = *(const OD_obj_array_t *)entry->odObject;
+    dev->hbConsCount = HB_CONS_NODES;
+    for (uint8_t i = 0; i < HB_CONS_NODES; i++) {
+        dev->hbCons[i] = ((uint32_t)(i + 1U) << 16) | HB_CONSUMER_TIME_MS;
+    }
+    dev->hbConsObj.dataOrig0 = &dev->hbConsCount;
+    dev->hbConsObj.dataOrig = dev->hbCons;
+    entry->odObject = &dev->hbConsObj;
+    entry->subEntriesCount = HB_CONS_NODES + 1U;
+    return true;
+}
+
+
+/* Receive response from the gateway, count complete responses and errors */
+static size_t gtwaRead(void *object, const char *buf, size_t count,
+                       uint8_t *connectionOK)
+{
+    benchDev_t *dev = (benchDev_t *)object;
+
+    for (size_t i = 0; i < count; i++) {
+        if (buf[i] == '\n') {
+            dev->gtwaResponses++;
+        }
+        else if (buf[i] == 'E' && count - i >= 5
+                 && memcmp(&buf[i], "ERROR", 5) == 0) {
+            dev->gtwaErrors++;
+        }
+    }
+    if (connectionOK != NULL) {
+        *connectionOK = 1;
+    }
+    return count;
+}
+
+
+/* Set CO_config_t, create and initialize CANopen objects of the device */
+static bool_t devInit(benchDev_t *dev) {
+    CO_config_t *c = &dev->config;
+    OD_t *od = &dev->od;
+    CO_ReturnError_t err;
+    uint32_t heapMemoryUsed = 0;
+    uint32_t errInfo = 0;
+
+    if (!odExtend(dev)) {
+        return false;
+    }
+
+    /* RPDO1 receives two variables, TPDO1 transmits other two. */
+    OD_PERSIST_COMM.x1400_RPDOCommunicationParameter.COB_IDUsedByRPDO = 0x200 + NODE_ID;
+    OD_PERSIST_COMM.x1400_RPDOCommunicationParameter.transmissionType = 0xFE;
+    OD_PERSIST_COMM.x1600_RPDOMappingParameter.numberOfMappedApplicationObjectsInPDO = 2;
+    OD_PERSIST_COMM.x1600_RPDOMappingParameter.applicationObject1 = 0x20000120;
+    OD_PERSIST_COMM.x1600_RPDOMappingParameter.applicationObject2 = 0x20000220;
+    OD_PERSIST_COMM.x1800_TPDOCommunicationParameter.COB_IDUsedByTPDO = 0x180 + NODE_ID;
+    OD_PERSIST_COMM.x1800_TPDOCommunicationParameter.transmissionType = 0xFE;
+    OD_PERSIST_COMM.x1800_TPDOCommunicationParameter.inhibitTime = 0;
+    OD_PERSIST_COMM.x1800_TPDOCommunicationParameter.eventTimer = 0;
+    OD_PERSIST_COMM.x1A00_TPDOMappingParameter.numberOfMappedApplicationObjectsInPDO = 2;
+    OD_PERSIST_COMM.x1A00_TPDOMappingParameter.applicationObject1 = 0x20000320;
+    OD_PERSIST_COMM.x1A00_TPDOMappingParameter.applicationObject2 = 0x20000420;
+    OD_PERSIST_COMM.x1017_producerHeartbeatTime = 0;
+
+    /* counts from OD.h, entries from extended OD */
+    OD_INIT_CONFIG(*c);
+    c->ENTRY_H1017 = OD_find(od, 0x1017);
+    c->ENTRY_H1016 = OD_find(od, 0x1016);
+    c->ENTRY_H1001 = OD_find(od, 0x1001);
+    c->ENTRY_H1014 = OD_find(od, 0x1014);
+    c->ENTRY_H1015 = OD_find(od, 0x1015);
+    c->ENTRY_H1003 = OD_find(od, 0x1003);
+    c->ENTRY_H1200 = OD_find(od, 0x1200);
+    c->ENTRY_H1280 = OD_find(od, 0x1280);
+    c->ENTRY_H1012 = OD_find(od, 0x1012);
+    c->ENTRY_H1005 = OD_find(od, 0x1005);
+    c->ENTRY_H1006 = OD_find(od, 0x1006);
+    c->ENTRY_H1007 = OD_find(od, 0x1007);
+    c->ENTRY_H1019 = OD_find(od, 0x1019);
+    c->ENTRY_H1400 = OD_find(od, 0x1400);
+    c->ENTRY_H1600 = OD_find(od, 0x1600);
+    c->ENTRY_H1800 = OD_find(od, 0x1800);
+    c->ENTRY_H1A00 = OD_find(od, 0x1A00);
+    c->CNT_HB_CONS = 1;
+    c->CNT_ARR_1016 = HB_CONS_NODES;
+    c->CNT_SDO_CLI = 1;
+    c->CNT_GTWA = 1;
+
+    dev->co = CO_new(c, &heapMemoryUsed);
+    if (dev->co == NULL) {
+        return false;
+    }
+
+    err = CO_CANinit(dev->co, NULL, 1000);
+    if (err == CO_ERROR_NO) {
+        err = CO_CANopenInit(dev->co, NULL, NULL, od, NULL, NMT_CONTROL,
+                             FIRST_HB_TIME, SDO_SRV_TIMEOUT_TIME,
+                             SDO_CLI_TIMEOUT_TIME, SDO_CLI_BLOCK,
+                             NODE_ID, &errInfo);
+    }
+    if (err == CO_ERROR_NO) {
+        err = CO_CANopenInitPDO(dev->co, dev->co->em, od, NODE_ID, &errInfo);
+    }
+    if (err != CO_ERROR_NO) {
+        if (err == CO_ERROR_OD_PARAMETERS) {
+            log_printf("Error: Object Dictionary entry 0x%"PRIX32"\n", errInfo);
+        }
+        return false;
+    }
+    CO_GTWA_initRead(dev->co->gtwa, gtwaRead, dev);
+    CO_CANsetNormalMode(dev->co->CANmodule);
+
+    /* bootup and NMT transition to operational */
+    for (int i = 0; i < 10; i++) {
+        CO_process(dev->co, false, 1000, NULL);
+    }
+    return dev->co->NMT->operatingState == CO_NMT_OPERATIONAL;
+}
+
+
+/* Receive all messages from the virtual bus and process CANopen objects,
+ * which are processed from CO_process() */
+static void devProcess(benchDev_t *dev) {
+    CO_process(dev->co, true, 0, NULL);
+}
+
+
+/* Benchmarks *****************************************************************/
+static void benchRPDO(benchDev_t *dev, uint32_t count) {
+    CO_t *co = dev->co;
+    uint8_t data[8] = {0};
+
+    for (uint32_t i = 0; i < count; i++) {
+        memcpy(&data[0], &i, sizeof(i));
+        busInject(co->CANmodule, 0x200 + NODE_ID, 8, data);
+        CO_CANmodule_process(co->CANmodule);
+        CO_process_RPDO(co, false, 0, NULL);
+    }
+}
+
+static void benchTPDO(benchDev_t *dev, uint32_t count) {
+    CO_t *co = dev->co;
+
+    for (uint32_t i = 0; i < count; i++) {
+        dev->pdoData[2] = i;
+        CO_TPDOsendRequest(&co->TPDO[0]);
+        CO_process_TPDO(co, false, 0, NULL);
+        CO_CANmodule_process(co->CANmodule);
+    }
+}
+
+/* One SDO download from own SDO client to own SDO server */
+static bool_t sdoDownload(benchDev_t *dev, uint16_t index, uint8_t subIndex,
+                          const uint8_t *data, size_t len, bool_t block)
+{
+    CO_SDOclient_t *SDO_C = &dev->co->SDOclient[0];
+    CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+    CO_SDO_return_t ret;
+    size_t written;
+
+    ret = CO_SDOclientDownloadInitiate(SDO_C, index, subIndex, len,
+                                       SDO_CLI_TIMEOUT_TIME, block);
+    if (ret != CO_SDO_RT_ok_communicationEnd) {
+        return false;
+    }
+    written = CO_SDOclientDownloadBufWrite(SDO_C, data, len);
+    for (uint32_t loops = 0; loops < LOOPS_MAX; loops++) {
+        ret = CO_SDOclientDownload(SDO_C, 0, false, written < len,
+                                   &abortCode, NULL, NULL);
+        if (ret <= CO_SDO_RT_ok_communicationEnd) {
+            break;
+        }
+        if (written < len) {
+            written += CO_SDOclientDownloadBufWrite(SDO_C, &data[written],
+                                                    len - written);
+        }
+        devProcess(dev);
+    }
+    return ret == CO_SDO_RT_ok_communicationEnd;
+}
+
+static bool_t benchSDO(benchDev_t *dev, uint32_t count, uint16_t index,
+                       uint8_t subIndex, size_t len, bool_t block)
+{
+    uint8_t data[SDO_DATA_SIZE];
+
+    CO_SDOclient_setup(&dev->co->SDOclient[0], CO_CAN_ID_SDO_CLI + NODE_ID,
+                       CO_CAN_ID_SDO_SRV + NODE_ID, NODE_ID);
+    for (size_t i = 0; i < len; i++) {
+        data[i] = (uint8_t)i;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        data[0] = (uint8_t)i;
+        if (!sdoDownload(dev, index, subIndex, data, len, block)) {
+            return false;
+        }
+    }
+    return memcmp(index == 0x2001 ? (void *)dev->sdoData
+                                  : (void *)&dev->pdoData[subIndex - 1U],
+                  data, len) == 0;
+}
+
+static bool_t benchSDOexpedited(benchDev_t *dev, uint32_t count) {
+    return benchSDO(dev, count, 0x2000, 5, sizeof(uint32_t), false);
+}
+
+static bool_t benchSDOsegmented(benchDev_t *dev, uint32_t count) {
+    return benchSDO(dev, count, 0x2001, 0, SDO_DATA_SIZE, false);
+}
+
+static bool_t benchSDOblock(benchDev_t *dev, uint32_t count) {
+    return benchSDO(dev, count, 0x2001, 0, SDO_DATA_SIZE, true);
+}
+
+static bool_t benchODfind(benchDev_t *dev, uint32_t count) {
+    OD_t *od = &dev->od;
+    uint32_t found = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint16_t index = od->list[i % od->size].index;
+        if (OD_find(od, index) != NULL) {
+            found++;
+        }
+    }
+    return found == count;
+}
+
+/* Heartbeats of all monitored nodes, one operation is HB_CONS_NODES frames */
+static bool_t benchHBconsumer(benchDev_t *dev, uint32_t count) {
+    CO_t *co = dev->co;
+    uint8_t state = (uint8_t)CO_NMT_OPERATIONAL;
+
+    for (uint32_t i = 0; i < count; i++) {
+        for (uint16_t nodeId = 1; nodeId <= HB_CONS_NODES; nodeId++) {
+            busInject(co->CANmodule, CO_CAN_ID_HEARTBEAT + nodeId, 1, &state);
+        }
+        CO_CANmodule_process(co->CANmodule);
+        CO_HBconsumer_process(co->HBcons, true, 1000, NULL);
+    }
+    return co->HBcons->allMonitoredOperational;
+}
+
+/* Parse and execute gateway commands: SDO upload and download to own SDO
+ * server, NMT command to other node and local setting. */
+static bool_t benchGateway(benchDev_t *dev, uint32_t count) {
+    static const char *commands[] = {
+        "[1] 1 r 0x1017 0 u16\n",
+        "[2] 1 w 0x2000 6 u32 0x12345678\n",
+        "[3] 5 start\n",
+        "[4] set sdo_timeout 1000\n"
+    };
+    CO_GTWA_t *gtwa = dev->co->gtwa;
+
+    dev->gtwaResponses = 0;
+    dev->gtwaErrors = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const char *cmd = commands[i % (sizeof(commands)/sizeof(commands[0]))];
+        uint32_t loops = 0;
+
+        CO_GTWA_write(gtwa, cmd, strlen(cmd));
+        while (dev->gtwaResponses <= i) {
+            if (++loops > LOOPS_MAX) {
+                return false;
+            }
+            devProcess(dev);
+        }
+    }
+    return dev->gtwaErrors == 0;
+}
+
+
+typedef struct {
+    const char *name;
+    bool_t (*run)(benchDev_t *dev, uint32_t count);
+    uint32_t count;
+} benchTest_t;
+
+static bool_t benchRPDOrun(benchDev_t *dev, uint32_t count) {
+    benchRPDO(dev, count);
+    return dev->pdoData[0] == count - 1U;
+}
+
+static bool_t benchTPDOrun(benchDev_t *dev, uint32_t count) {
+    uint32_t txOld = dev->co->CANmodule->loopbackTxCount;
+    benchTPDO(dev, count);
+    return dev->co->CANmodule->loopbackTxCount - txOld == count;
+}
+
+static const benchTest_t benchTests[] = {
+    {"rpdo",            benchRPDOrun,       1000000},
+    {"tpdo",            benchTPDOrun,       1000000},
+    {"sdo_expedited",   benchSDOexpedited,  100000},
+    {"sdo_segmented",   benchSDOsegmented,  5000},
+    {"sdo_block",       benchSDOblock,      5000},
+    {"od_find",         benchODfind,        5000000},
+    {"hb_consumer_127", benchHBconsumer,     20000},
+    {"gateway",         benchGateway,       40000}
+};
+#define BENCH_TESTS_COUNT (sizeof(benchTests) / sizeof(benchTests[0]))
+
+
+/* Baseline file has lines with test name and ns/op, '#' starts comment */
+static bool_t baselineFind(FILE *f, const char *name, double *nsPerOp) {
+    char line[128];
+    char lineName[64];
+
+    rewind(f);
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (line[0] == '#') {
+            continue;
+        }
+        if (sscanf(line, "%63s %lf", lineName, nsPerOp) == 2
+            && strcmp(lineName, name) == 0
+        ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+static void usage(const char *name) {
+    log_printf(
+"Usage: %s [options]\n"
+"Measure CANopenNode processing time on the host. One device communicates\n"
+"with itself over the virtual CAN bus of the blank driver (CO_DRIVER_LOOPBACK).\n"
+"  -r <repeat>     Run each test several times, report the fastest run\n"
+"                  (default %d).\n"
+"  -s <percent>    Scale number of operations of each test (default 100).\n"
+"  -c <file>       Compare ns/op with baseline file, exit with failure, if any\n"
+"                  test is slower than baseline by more than tolerance.\n"
+"  -t <percent>    Tolerance for comparison with baseline (default %d).\n"
+"  -w <file>       Write results into baseline file.\n",
+        name, DEFAULT_REPEAT, DEFAULT_TOLERANCE_PERCENT);
+}
+
+
+/* main ***********************************************************************/
+int main (int argc, char *argv[]){
+    benchDev_t *dev;
+    benchResult_t results[BENCH_TESTS_COUNT];
+    unsigned long repeat = DEFAULT_REPEAT;
+    unsigned long scale = 100;
+    unsigned long tolerance = DEFAULT_TOLERANCE_PERCENT;
+    const char *baselineCompare = NULL;
+    const char *baselineWrite = NULL;
+    int ret = EXIT_SUCCESS;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "r:s:c:t:w:h")) != -1) {
+        switch (opt) {
+            case 'r': repeat = strtoul(optarg, NULL, 0); break;
+            case 's': scale = strtoul(optarg, NULL, 0); break;
+            case 'c': baselineCompare = optarg; break;
+            case 't': tolerance = strtoul(optarg, NULL, 0); break;
+            case 'w': baselineWrite = optarg; break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+    if (repeat == 0 || scale == 0 || scale > 10000) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    dev = calloc(1, sizeof(benchDev_t));
+    if (dev == NULL || !devInit(dev)) {
+        log_printf("Error: Initialization of CANopen device failed\n");
+        return EXIT_FAILURE;
+    }
+
+    log_printf("%-16s %9s %10s %10s %10s %12s\n",
+               "test", "ops", "frames", "ns/op", "ns/frame", "frames/s");
+    for (size_t t = 0; t < BENCH_TESTS_COUNT; t++) {
+        const benchTest_t *test = &benchTests[t];
+        benchResult_t *r = &results[t];
+        uint32_t count = (uint32_t)((uint64_t)test->count * scale / 100U);
+
+        if (count == 0) {
+            count = 1;
+        }
+        r->name = test->name;
+        r->ops = count;
+        r->time_ns = UINT64_MAX;
+        for (unsigned long i = 0; i < repeat; i++) {
+            uint32_t rxOld = dev->co->CANmodule->loopbackRxCount;
+            uint64_t start = timeNow_ns();
+            bool_t ok = test->run(dev, count);
+            uint64_t time_ns = timeNow_ns() - start;
+
+            if (!ok) {
+                log_printf("Error: test %s failed\n", test->name);
+                return EXIT_FAILURE;
+            }
+            r->frames = dev->co->CANmodule->loopbackRxCount - rxOld;
+            if (time_ns < r->time_ns) {
+                r->time_ns = time_ns > 0 ? time_ns : 1;
+            }
+        }
+
+        log_printf("%-16s %9"PRIu32" %10"PRIu32" %10.1f ", r->name, r->ops,
+                   r->frames, (double)r->time_ns / r->ops);
+        if (r->frames > 0) {
+            log_printf("%10.1f %12.0f\n", (double)r->time_ns / r->frames,
+                       (double)r->frames * 1e9 / r->time_ns);
+        }
+        else {
+            log_printf("%10s %12s\n", "-", "-");
+        }
+    }
+
+    if (baselineWrite != NULL) {
+        FILE *f = fopen(baselineWrite, "w");
+        if (f == NULL) {
+            log_printf("Error: Can't write %s\n", baselineWrite);
+            return EXIT_FAILURE;
+        }
+        fprintf(f, "# CANopenNode benchmark baseline, ns/op, written by "
+                   "'make baseline'\n");
+        for (size_t t = 0; t < BENCH_TESTS_COUNT; t++) {
+            fprintf(f, "%s %.1f\n", results[t].name,
+                    (double)results[t].time_ns / results[t].ops);
+        }
+        fclose(f);
+    }
+
+    if (baselineCompare != NULL) {
+        FILE *f = fopen(baselineCompare, "r");
+        if (f == NULL) {
+            log_printf("Error: Can't read %s\n", baselineCompare);
+            return EXIT_FAILURE;
+        }
+        log_printf("\nCompared with %s, tolerance %lu %%:\n",
+                   baselineCompare, tolerance);
+        for (size_t t = 0; t < BENCH_TESTS_COUNT; t++) {
+            double nsPerOp = (double)results[t].time_ns / results[t].ops;
+            double nsBaseline;
+
+            if (!baselineFind(f, results[t].name, &nsBaseline)
+                || nsBaseline <= 0
+            ) {
+                log_printf("%-16s no baseline\n", results[t].name);
+                continue;
+            }
+            bool_t slower = nsPerOp > nsBaseline * (100U + tolerance) / 100;
+            log_printf("%-16s %+7.1f %%%s\n", results[t].name,
+                       (nsPerOp / nsBaseline - 1.0) * 100.0,
+                       slower ? "  REGRESSION" : "");
+            if (slower) {
+                ret = EXIT_FAILURE;
+            }
+        }
+        fclose(f);
+    }
+
+    CO_delete(dev->co);
+    free(dev->odList);
+    free(dev);
+    return ret;
+}
@@ -26,7 +26,27 @@
  */
 
 
+#include <string.h>
+
 #include "301/CO_driver.h"
+#include "301/CO_CANrxDispatch.h"
+
+
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_RING
+#if (CO_CONFIG_DRIVER_RX_RING_SIZE) < 2 \
+    || ((CO_CONFIG_DRIVER_RX_RING_SIZE) & ((CO_CONFIG_DRIVER_RX_RING_SIZE) - 1)) != 0
+#error CO_CONFIG_DRIVER_RX_RING_SIZE must be power of 2.
+#endif
+#define CO_RX_RING_MASK ((uint16_t)((CO_CONFIG_DRIVER_RX_RING_SIZE) - 1U))
+/* Index of the ring entry, which was already dispatched */
+#define CO_RX_RING_DISPATCHED 0xFFFFU
+#endif
+#ifdef CO_DRIVER_LOOPBACK
+#if (CO_DRIVER_LOOPBACK_SIZE) < 2 \
+    || ((CO_DRIVER_LOOPBACK_SIZE) & ((CO_DRIVER_LOOPBACK_SIZE) - 1)) != 0
+#error CO_DRIVER_LOOPBACK_SIZE must be power of 2.
+#endif
+#endif
 
 
 /******************************************************************************/
@@ -36,7 +56,48 @@ void CO_CANsetConfigurationMode(void *CANptr){
 
 
 /******************************************************************************/
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_HW_FILTER
+/* Acceptance filters of the CAN controller, microcontroller specific. */
+static const CO_CANfilterHw_t CO_CANfilterHw = CO_CANfilterHw_BXCAN;
+
+/* Compile hardware filter banks from configured rxArray */
+static void CO_CANfilterUpdate(CO_CANmodule_t *CANmodule) {
+    CO_CANfilter_t entries[CO_CONFIG_DRIVER_FILTER_ENTRIES];
+    uint16_t count = 0U;
+    uint16_t i;
+
+    for(i = 0U; i < CANmodule->rxSize; i++){
+        CO_CANrx_t *buffer = &CANmodule->rxArray[i];
+        if(buffer->CANrx_callback == NULL){
+            continue;
+        }
+        if(count >= CO_CONFIG_DRIVER_FILTER_ENTRIES){
+            count = 0xFFFFU;
+            break;
+        }
+        /* rxArray has the same format: 11-bit identifier and RTR bit */
+        entries[count].ident = buffer->ident;
+        entries[count].mask = buffer->mask;
+        count++;
+    }
+
+    CANmodule->filterBankCount = (count != 0xFFFFU)
+        ? CO_CANfilter_compile(&CO_CANfilterHw, entries, count,
+                               CANmodule->filterBanks)
+        : CO_CANfilter_FAIL;
+
+    /* Copy CANmodule->filterBanks into CAN module filter registers and
+     * disable the rest. If filterBankCount is CO_CANfilter_FAIL, configure
+     * one bank so, that all messages with standard identifier are accepted */
+}
+#endif
+
+
 void CO_CANsetNormalMode(CO_CANmodule_t *CANmodule){
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_HW_FILTER
+    CO_CANfilterUpdate(CANmodule);
+#endif
+
     /* Put CAN module in normal mode */
 
     CANmodule->CANnormal = true;
@@ -59,6 +120,11 @@ CO_ReturnError_t CO_CANmodule_init(
     if(CANmodule==NULL || rxArray==NULL || txArray==NULL){
         return CO_ERROR_ILLEGAL_ARGUMENT;
     }
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_QUEUE
+    if(txSize > CO_CONFIG_DRIVER_TX_QUEUE_SIZE){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+#endif
 
     /* Configure object variables */
     CANmodule->CANptr = CANptr;
@@ -79,10 +145,40 @@ CO_ReturnError_t CO_CANmodule_init(
         rxArray[i].mask = 0xFFFFU;
         rxArray[i].object = NULL;
         rxArray[i].CANrx_callback = NULL;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_RING
+        rxArray[i].rxRingBatch = 0U;
+#endif
     }
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_DISPATCH
+    CO_CANrxDispatch_init(CANmodule);
+#endif
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_RING
+    CANmodule->rxRingHead = 0U;
+    CANmodule->rxRingTail = 0U;
+    CANmodule->rxRingBatch = 0U;
+#endif
     for(i=0U; i<txSize; i++){
         txArray[i].bufferFull = false;
     }
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_QUEUE
+    CO_CANtxQueue_init(&CANmodule->txQueue, txSize);
+#endif
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+    CO_CANtraffic_init(&CANmodule->traffic, CANbitRate);
+#endif
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_HW_FILTER
+    /* filter banks from CO_CANfilterUpdate() don't tell rxArray index */
+    CANmodule->useCANrxFilters = false;
+    CANmodule->filterBankCount = CO_CANfilter_FAIL;
+#endif
+#ifdef CO_DRIVER_LOOPBACK
+    /* virtual bus has no hardware filters */
+    CANmodule->useCANrxFilters = false;
+    CANmodule->loopbackHead = 0U;
+    CANmodule->loopbackTail = 0U;
+    CANmodule->loopbackTxCount = 0U;
+    CANmodule->loopbackRxCount = 0U;
+#endif
 
 
     /* Configure CAN module registers */
@@ -136,6 +232,11 @@ CO_ReturnError_t CO_CANrxBufferInit(
         /* buffer, which will be configured */
         CO_CANrx_t *buffer = &CANmodule->rxArray[index];
 
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_DISPATCH
+        CO_LOCK_CAN_SEND(CANmodule);
+        CO_CANrxDispatch_remove(CANmodule, index);
+#endif
+
         /* Configure object variables */
         buffer->object = object;
         buffer->CANrx_callback = CANrx_callback;
@@ -147,10 +248,21 @@ CO_ReturnError_t CO_CANrxBufferInit(
         }
         buffer->mask = (mask & 0x07FFU) | 0x0800U;
 
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_DISPATCH
+        CO_CANrxDispatch_add(CANmodule, index);
+        CO_UNLOCK_CAN_SEND(CANmodule);
+#endif
+
         /* Set CAN hardware module filter and mask. */
         if(CANmodule->useCANrxFilters){
 
         }
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_HW_FILTER
+        else if(CANmodule->CANnormal){
+            /* receive buffer changed at runtime, e.g. PDO COB-ID */
+            CO_CANfilterUpdate(CANmodule);
+        }
+#endif
     }
     else{
         ret = CO_ERROR_ILLEGAL_ARGUMENT;
@@ -161,6 +273,25 @@ CO_ReturnError_t CO_CANrxBufferInit(
 
 
 /******************************************************************************/
+/* RTR bit in ident of the transmit buffer, above DLC */
+#define CO_CANtx_RTR 0x00010000UL
+
+/* 11-bit CAN identifier and RTR bit (0x0800) of the transmit buffer, as in
+ * received message */
+static inline uint16_t CO_CANtxIdent(const CO_CANtx_t *buffer) {
+    return (uint16_t)((buffer->ident & 0x07FFU)
+                      | (((buffer->ident & CO_CANtx_RTR) != 0U) ? 0x0800U : 0U));
+}
+
+/* Data length code of the transmit buffer */
+static inline uint8_t CO_CANtxDLC(const CO_CANtx_t *buffer) {
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD
+    return buffer->DLC;
+#else
+    return (uint8_t)((buffer->ident >> 12U) & 0xFU);
+#endif
+}
+
 CO_CANtx_t *CO_CANtxBufferInit(
         CO_CANmodule_t         *CANmodule,
         uint16_t                index,
@@ -177,12 +308,30 @@ CO_CANtx_t *CO_CANtxBufferInit(
 
         /* CAN identifier, DLC and rtr, bit aligned with CAN module transmit buffer.
          * Microcontroller specific. */
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD
+        /* data length in bytes is kept in DLC, CAN FD frame is used, if
+         * it is longer than 8 bytes */
+        if(noOfBytes > sizeof(buffer->data)){
+            return NULL;
+        }
+        buffer->ident = ((uint32_t)ident & 0x07FFU)
+                      | (rtr ? CO_CANtx_RTR : 0U);
+        buffer->DLC = noOfBytes;
+#else
         buffer->ident = ((uint32_t)ident & 0x07FFU)
                       | ((uint32_t)(((uint32_t)noOfBytes & 0xFU) << 12U))
-                      | ((uint32_t)(rtr ? 0x8000U : 0U));
+                      | (rtr ? CO_CANtx_RTR : 0U);
+#endif
 
         buffer->bufferFull = false;
         buffer->syncFlag = syncFlag;
+
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_QUEUE
+        CO_LOCK_CAN_SEND(CANmodule);
+        CO_CANtxQueue_remove(&CANmodule->txQueue, index);
+        CO_CANtxQueue_setIdent(&CANmodule->txQueue, index, ident & 0x07FFU);
+        CO_UNLOCK_CAN_SEND(CANmodule);
+#endif
     }
 
     return buffer;
@@ -190,14 +339,57 @@ CO_CANtx_t *CO_CANtxBufferInit(
 
 
 /******************************************************************************/
+#ifdef CO_DRIVER_LOOPBACK
+/* Copy message to the virtual bus, return false if it is full. */
+static bool_t CO_CANloopbackSend(CO_CANmodule_t *CANmodule,
+                                 CO_CANtx_t *buffer)
+{
+    uint16_t head = CANmodule->loopbackHead;
+    uint16_t headNext = (head + 1U) & (CO_DRIVER_LOOPBACK_SIZE - 1U);
+    CO_CANrxMsg_t *msg = &CANmodule->loopback[head];
+
+    if(headNext == CANmodule->loopbackTail){
+        return false;
+    }
+
+    /* transmit buffer ident contains also DLC and rtr, see CO_CANtxBufferInit */
+    msg->ident = CO_CANtxIdent(buffer);
+    msg->DLC = CO_CANtxDLC(buffer);
+    memcpy(msg->data, buffer->data, sizeof(msg->data));
+    CANmodule->loopbackHead = headNext;
+    CANmodule->loopbackTxCount++;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+    /* message is also received by this module, so bits are counted twice */
+    CO_CANtraffic_tx(&CANmodule->traffic, (uint16_t)msg->ident, msg->DLC,
+                     msg->data);
+#endif
+    CANmodule->firstCANtxMessage = false;
+
+    return true;
+}
+#endif
+
+
 CO_ReturnError_t CO_CANsend(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer){
     CO_ReturnError_t err = CO_ERROR_NO;
 
+#ifdef CO_DRIVER_LOOPBACK
+    CO_LOCK_CAN_SEND(CANmodule);
+    if(!CO_CANloopbackSend(CANmodule, buffer)){
+        CANmodule->CANerrorStatus |= CO_CAN_ERRTX_OVERFLOW;
+        CO_CAN_COUNT_TX_OVERFLOW(CANmodule, 1);
+        err = CO_ERROR_TX_OVERFLOW;
+    }
+    CO_UNLOCK_CAN_SEND(CANmodule);
+    return err;
+#endif
+
     /* Verify overflow */
     if(buffer->bufferFull){
         if(!CANmodule->firstCANtxMessage){
             /* don't set error, if bootup message is still on buffers */
             CANmodule->CANerrorStatus |= CO_CAN_ERRTX_OVERFLOW;
+            CO_CAN_COUNT_TX_OVERFLOW(CANmodule, 1);
         }
         err = CO_ERROR_TX_OVERFLOW;
     }
@@ -207,16 +399,94 @@ CO_ReturnError_t CO_CANsend(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer){
     if(1 && CANmodule->CANtxCount == 0){
         CANmodule->bufferInhibitFlag = buffer->syncFlag;
         /* copy message and txRequest */
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+        CO_CANtraffic_tx(&CANmodule->traffic, CO_CANtxIdent(buffer),
+                         CO_CANtxDLC(buffer), buffer->data);
+#endif
     }
     /* if no buffer is free, message will be sent by interrupt */
     else{
         buffer->bufferFull = true;
         CANmodule->CANtxCount++;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_QUEUE
+        CO_CANtxQueue_push(&CANmodule->txQueue,
+                           (uint16_t)(buffer - &CANmodule->txArray[0]));
+#endif
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+        CO_CANtraffic_txQueued(&CANmodule->traffic, CANmodule->CANtxCount);
+#endif
+    }
+    CO_UNLOCK_CAN_SEND(CANmodule);
+
+    return err;
+}
+
+
+/******************************************************************************/
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_BATCH
+CO_ReturnError_t CO_CANsendBatch(CO_CANmodule_t *CANmodule,
+                                 CO_CANtx_t *buffers[],
+                                 uint16_t count)
+{
+    CO_ReturnError_t err = CO_ERROR_NO;
+    bool_t txBufferFree;
+    uint16_t i;
+
+    CO_LOCK_CAN_SEND(CANmodule);
+    txBufferFree = (1 && CANmodule->CANtxCount == 0) ? true : false;
+    for(i = 0U; i < count; i++){
+        CO_CANtx_t *buffer = buffers[i];
+
+#ifdef CO_DRIVER_LOOPBACK
+        if(!CO_CANloopbackSend(CANmodule, buffer)){
+            CANmodule->CANerrorStatus |= CO_CAN_ERRTX_OVERFLOW;
+            CO_CAN_COUNT_TX_OVERFLOW(CANmodule, 1);
+            err = CO_ERROR_TX_OVERFLOW;
+        }
+        continue;
+#endif
+
+        /* Verify overflow */
+        if(buffer->bufferFull){
+            if(!CANmodule->firstCANtxMessage){
+                /* don't set error, if bootup message is still on buffers */
+                CANmodule->CANerrorStatus |= CO_CAN_ERRTX_OVERFLOW;
+                CO_CAN_COUNT_TX_OVERFLOW(CANmodule, 1);
+            }
+            err = CO_ERROR_TX_OVERFLOW;
+        }
+
+        /* if CAN TX buffer is free, copy message to it. Multi-mailbox CAN
+         * modules may fill several buffers here and request transmission
+         * of all of them at once. Other messages are queued, as in
+         * CO_CANsend(). */
+        if(txBufferFree){
+            txBufferFree = false;
+            CANmodule->bufferInhibitFlag = buffer->syncFlag;
+            /* copy message and txRequest */
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+            CO_CANtraffic_tx(&CANmodule->traffic, CO_CANtxIdent(buffer),
+                             CO_CANtxDLC(buffer), buffer->data);
+#endif
+        }
+        /* if no buffer is free, message will be sent by interrupt */
+        else{
+            buffer->bufferFull = true;
+            CANmodule->CANtxCount++;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_QUEUE
+            CO_CANtxQueue_push(&CANmodule->txQueue,
+                               (uint16_t)(buffer - &CANmodule->txArray[0]));
+#endif
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+            CO_CANtraffic_txQueued(&CANmodule->traffic, CANmodule->CANtxCount);
+#endif
+        }
     }
     CO_UNLOCK_CAN_SEND(CANmodule);
 
     return err;
 }
+#endif /* (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_BATCH */
 
 
 /******************************************************************************/
@@ -240,6 +510,10 @@ void CO_CANclearPendingSyncPDOs(CO_CANmodule_t *CANmodule){
                 if(buffer->syncFlag){
                     buffer->bufferFull = false;
                     CANmodule->CANtxCount--;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_QUEUE
+                    CO_CANtxQueue_remove(&CANmodule->txQueue,
+                                         CANmodule->txSize - i);
+#endif
                     tpdoDeleted = 2U;
                 }
             }
@@ -255,6 +529,79 @@ void CO_CANclearPendingSyncPDOs(CO_CANmodule_t *CANmodule){
 }
 
 
+/******************************************************************************/
+/* Find receive buffer for the received message and process it. */
+static void CO_CANrxMessage(CO_CANmodule_t *CANmodule, CO_CANrxMsg_t *rcvMsg){
+    uint16_t index;             /* index of received message */
+    uint32_t rcvMsgIdent;       /* identifier of the received message */
+    CO_CANrx_t *buffer = NULL;  /* receive message buffer from CO_CANmodule_t object. */
+    bool_t msgMatched = false;
+
+    rcvMsgIdent = rcvMsg->ident;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+    CO_CANtraffic_rx(&CANmodule->traffic, (uint16_t)(rcvMsgIdent & 0x0FFFU),
+                     rcvMsg->DLC, rcvMsg->data);
+#endif
+    if(CANmodule->useCANrxFilters){
+        /* CAN module filters are used. Message with known 11-bit identifier has */
+        /* been received */
+        index = 0;  /* get index of the received message here. Or something similar */
+        if(index < CANmodule->rxSize){
+            buffer = &CANmodule->rxArray[index];
+            /* verify also RTR */
+            if(((rcvMsgIdent ^ buffer->ident) & buffer->mask) == 0U){
+                msgMatched = true;
+            }
+        }
+    }
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_DISPATCH
+    else{
+        /* CAN module filters are not used, message with any standard 11-bit identifier */
+        /* has been received. Get rxArray entry from the dispatch index. */
+        buffer = CO_CANrxDispatch_find(CANmodule, (uint16_t)(rcvMsgIdent & 0x0FFFU));
+        msgMatched = buffer != NULL;
+    }
+#else
+    else{
+        /* CAN module filters are not used, message with any standard 11-bit identifier */
+        /* has been received. Search rxArray form CANmodule for the same CAN-ID. */
+        buffer = &CANmodule->rxArray[0];
+        for(index = CANmodule->rxSize; index > 0U; index--){
+            if(((rcvMsgIdent ^ buffer->ident) & buffer->mask) == 0U){
+                msgMatched = true;
+                break;
+            }
+            buffer++;
+        }
+    }
+#endif
+
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_RING
+    /* Copy message into the ring, it will be processed by mainline */
+    if(msgMatched && (buffer != NULL) && (buffer->CANrx_callback != NULL)){
+        uint16_t head = CANmodule->rxRingHead;
+        uint16_t headNext = (head + 1U) & CO_RX_RING_MASK;
+        if(headNext == CANmodule->rxRingTail){
+            /* ring is full, message is lost */
+            CANmodule->CANerrorStatus |= CO_CAN_ERRRX_OVERFLOW;
+            CO_CAN_COUNT_RX_OVERFLOW(CANmodule, 1);
+        }
+        else{
+            CANmodule->rxRing[head].index = (uint16_t)(buffer - &CANmodule->rxArray[0]);
+            CANmodule->rxRing[head].msg = *rcvMsg;
+            CO_MemoryBarrier();
+            CANmodule->rxRingHead = headNext;
+        }
+    }
+#else
+    /* Call specific function, which will process the message */
+    if(msgMatched && (buffer != NULL) && (buffer->CANrx_callback != NULL)){
+        buffer->CANrx_callback(buffer->object, (void*) rcvMsg);
+    }
+#endif
+}
+
+
 /******************************************************************************/
 /* Get error counters from the module. If necessary, function may use
     * different way to determine errors. */
@@ -301,63 +648,102 @@ void CO_CANmodule_process(CO_CANmodule_t *CANmodule) {
         }
 
         if (overflow != 0) {
-            /* CAN RX bus overflow */
+            /* CAN RX bus overflow. Count it better in receive interrupt,
+             * with number of lost messages, if CAN module reports it. */
             status |= CO_CAN_ERRRX_OVERFLOW;
+            CO_CAN_COUNT_RX_OVERFLOW(CANmodule, 1);
         }
 
         CANmodule->CANerrorStatus = status;
     }
+
+#ifdef CO_DRIVER_LOOPBACK
+    {
+        /* Receive messages from the virtual bus. Messages, sent from
+         * receive callbacks, are received in the next call. */
+        uint16_t head = CANmodule->loopbackHead;
+        while(CANmodule->loopbackTail != head){
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_HW_FILTER
+            /* simulate rejection by hardware filter banks */
+            if(CO_CANfilter_accepts(CANmodule->filterBanks,
+                    CANmodule->filterBankCount,
+                    (uint16_t)CANmodule->loopback[CANmodule->loopbackTail].ident))
+#endif
+            CO_CANrxMessage(CANmodule,
+                            &CANmodule->loopback[CANmodule->loopbackTail]);
+            CANmodule->loopbackTail = (CANmodule->loopbackTail + 1U)
+                                      & (CO_DRIVER_LOOPBACK_SIZE - 1U);
+            CANmodule->loopbackRxCount++;
+        }
+    }
+#endif
+
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_RING
+    {
+        /* Dispatch received messages from the ring. Only the first message
+         * for each rxArray entry is dispatched. Later messages for the same
+         * entry are kept in the ring in order and dispatched in the next
+         * call, other messages behind them are dispatched now. If CANopen
+         * object does not process the message before the next call, it is
+         * overwritten by the callback, as without the ring. */
+        uint16_t head = CANmodule->rxRingHead;
+        uint16_t tail = CANmodule->rxRingTail;
+        uint16_t kept = 0U;
+        uint16_t i;
+
+        CO_MemoryBarrier();
+        CANmodule->rxRingBatch++;
+        for(i = tail; i != head; i = (i + 1U) & CO_RX_RING_MASK){
+            CO_CANrxRingEntry_t *entry = &CANmodule->rxRing[i];
+            CO_CANrx_t *buffer = &CANmodule->rxArray[entry->index];
+
+            if(buffer->rxRingBatch == CANmodule->rxRingBatch){
+                kept++;
+                continue;
+            }
+            buffer->rxRingBatch = CANmodule->rxRingBatch;
+            if(buffer->CANrx_callback != NULL){
+                buffer->CANrx_callback(buffer->object, (void *)&entry->msg);
+            }
+            entry->index = CO_RX_RING_DISPATCHED;
+        }
+
+        /* Move kept messages towards the head, so they stay contiguous with
+         * messages, received meanwhile. Only slots before head are touched,
+         * receive interrupt writes only at head. */
+        if(kept > 0U){
+            uint16_t w = head;
+            i = head;
+            while(i != tail){
+                i = (i - 1U) & CO_RX_RING_MASK;
+                if(CANmodule->rxRing[i].index != CO_RX_RING_DISPATCHED){
+                    w = (w - 1U) & CO_RX_RING_MASK;
+                    if(w != i){
+                        CANmodule->rxRing[w] = CANmodule->rxRing[i];
+                    }
+                }
+            }
+            tail = w;
+        }
+        else{
+            tail = head;
+        }
+        CO_MemoryBarrier();
+        CANmodule->rxRingTail = tail;
+    }
+#endif
 }
 
 
 /******************************************************************************/
-typedef struct {
-    uint32_t ident;
-    uint8_t DLC;
-    uint8_t data[8];
-} CO_CANrxMsg_t;
-
 void CO_CANinterrupt(CO_CANmodule_t *CANmodule){
 
     /* receive interrupt */
     if(1){
         CO_CANrxMsg_t *rcvMsg;      /* pointer to received message in CAN module */
-        uint16_t index;             /* index of received message */
-        uint32_t rcvMsgIdent;       /* identifier of the received message */
-        CO_CANrx_t *buffer = NULL;  /* receive message buffer from CO_CANmodule_t object. */
-        bool_t msgMatched = false;
 
         rcvMsg = 0; /* get message from module here */
-        rcvMsgIdent = rcvMsg->ident;
-        if(CANmodule->useCANrxFilters){
-            /* CAN module filters are used. Message with known 11-bit identifier has */
-            /* been received */
-            index = 0;  /* get index of the received message here. Or something similar */
-            if(index < CANmodule->rxSize){
-                buffer = &CANmodule->rxArray[index];
-                /* verify also RTR */
-                if(((rcvMsgIdent ^ buffer->ident) & buffer->mask) == 0U){
-                    msgMatched = true;
-                }
-            }
-        }
-        else{
-            /* CAN module filters are not used, message with any standard 11-bit identifier */
-            /* has been received. Search rxArray form CANmodule for the same CAN-ID. */
-            buffer = &CANmodule->rxArray[0];
-            for(index = CANmodule->rxSize; index > 0U; index--){
-                if(((rcvMsgIdent ^ buffer->ident) & buffer->mask) == 0U){
-                    msgMatched = true;
-                    break;
-                }
-                buffer++;
-            }
-        }
-
-        /* Call specific function, which will process the message */
-        if(msgMatched && (buffer != NULL) && (buffer->CANrx_callback != NULL)){
-            buffer->CANrx_callback(buffer->object, (void*) rcvMsg);
-        }
+        CO_CANrxMessage(CANmodule, rcvMsg);
 
         /* Clear interrupt flag */
     }
@@ -372,6 +758,30 @@ void CO_CANinterrupt(CO_CANmodule_t *CANmodule){
         /* clear flag from previous message */
         CANmodule->bufferInhibitFlag = false;
         /* Are there any new messages waiting to be send */
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_QUEUE
+        if(CANmodule->CANtxCount > 0U){
+            /* pending message with the highest priority */
+            uint16_t index = CO_CANtxQueue_pop(&CANmodule->txQueue);
+
+            if(index != CO_CANtxQueue_NONE){
+                CO_CANtx_t *buffer = &CANmodule->txArray[index];
+                buffer->bufferFull = false;
+                CANmodule->CANtxCount--;
+
+                /* Copy message to CAN buffer */
+                CANmodule->bufferInhibitFlag = buffer->syncFlag;
+                /* canSend... */
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+                CO_CANtraffic_tx(&CANmodule->traffic, CO_CANtxIdent(buffer),
+                                 CO_CANtxDLC(buffer), buffer->data);
+#endif
+            }
+            else{
+                /* Clear counter if no more messages */
+                CANmodule->CANtxCount = 0U;
+            }
+        }
+#else
         if(CANmodule->CANtxCount > 0U){
             uint16_t i;             /* index of transmitting message */
 
@@ -387,6 +797,10 @@ void CO_CANinterrupt(CO_CANmodule_t *CANmodule){
                     /* Copy message to CAN buffer */
                     CANmodule->bufferInhibitFlag = buffer->syncFlag;
                     /* canSend... */
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+                    CO_CANtraffic_tx(&CANmodule->traffic, CO_CANtxIdent(buffer),
+                                     CO_CANtxDLC(buffer), buffer->data);
+#endif
                     break;                      /* exit for loop */
                 }
                 buffer++;
@@ -397,6 +811,7 @@ void CO_CANinterrupt(CO_CANmodule_t *CANmodule){
                 CANmodule->CANtxCount = 0U;
             }
         }
+#endif
     }
     else{
         /* some other interrupt reason */
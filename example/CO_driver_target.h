@@ -44,6 +44,24 @@ extern "C" {
 
 /* Stack configuration override default values.
  * For more information see file CO_config.h. */
+#ifndef CO_CONFIG_DRIVER
+#define CO_CONFIG_DRIVER (0)
+#endif
+#ifndef CO_CONFIG_DRIVER_RX_MASKED_COUNT
+#define CO_CONFIG_DRIVER_RX_MASKED_COUNT 4
+#endif
+#ifndef CO_CONFIG_DRIVER_RX_RING_SIZE
+#define CO_CONFIG_DRIVER_RX_RING_SIZE 32
+#endif
+
+/* If CO_DRIVER_LOOPBACK is defined, blank driver works as in-memory virtual
+ * CAN bus: each message sent with CO_CANsend() is queued and received back
+ * by the same CAN module in the next CO_CANmodule_process() call. It can be
+ * used for measuring performance of the stack on the host, without the CAN
+ * hardware. CO_DRIVER_LOOPBACK_SIZE is the size of the queue, power of 2. */
+#ifndef CO_DRIVER_LOOPBACK_SIZE
+#define CO_DRIVER_LOOPBACK_SIZE 64
+#endif
 
 
 /* Basic definitions. If big endian, CO_SWAP_xx macros must swap bytes. */
@@ -59,10 +77,34 @@ typedef float                   float32_t;
 typedef double                  float64_t;
 
 
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_QUEUE
+#include "301/CO_CANtxQueue.h"
+#endif
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_HW_FILTER
+#include "301/CO_CANfilter.h"
+#endif
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+#include "301/CO_CANtraffic.h"
+#endif
+
+
 /* Access to received CAN message */
-#define CO_CANrxMsg_readIdent(msg) ((uint16_t)0)
-#define CO_CANrxMsg_readDLC(msg)   ((uint8_t)0)
-#define CO_CANrxMsg_readData(msg)  ((uint8_t *)NULL)
+#define CO_CANrxMsg_readIdent(msg) \
+    ((uint16_t)(((CO_CANrxMsg_t *)(msg))->ident & 0x07FFU))
+#define CO_CANrxMsg_readDLC(msg)   (((CO_CANrxMsg_t *)(msg))->DLC)
+#define CO_CANrxMsg_readData(msg)  (((CO_CANrxMsg_t *)(msg))->data)
+#define CO_CANrxMsg_readTimestamp(msg) ((uint32_t)0)
+
+/* Received CAN message, as aligned in CAN module */
+typedef struct {
+    uint32_t ident;
+    uint8_t DLC;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD
+    uint8_t data[64];
+#else
+    uint8_t data[8];
+#endif
+} CO_CANrxMsg_t;
 
 /* Received message object */
 typedef struct {
@@ -70,13 +112,28 @@ typedef struct {
     uint16_t mask;
     void *object;
     void (*CANrx_callback)(void *object, void *message);
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_RING
+    uint16_t rxRingBatch;
+#endif
 } CO_CANrx_t;
 
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_RING
+/* Received message in the ring, with index of the matched rxArray entry */
+typedef struct {
+    uint16_t index;
+    CO_CANrxMsg_t msg;
+} CO_CANrxRingEntry_t;
+#endif
+
 /* Transmit message object */
 typedef struct {
     uint32_t ident;
     uint8_t DLC;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD
+    uint8_t data[64];
+#else
     uint8_t data[8];
+#endif
     volatile bool_t bufferFull;
     volatile bool_t syncFlag;
 } CO_CANtx_t;
@@ -95,6 +152,39 @@ typedef struct {
     volatile bool_t firstCANtxMessage;
     volatile uint16_t CANtxCount;
     uint32_t errOld;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_DISPATCH
+    uint16_t rxDispatch[0x800];
+    uint16_t rxMasked[CO_CONFIG_DRIVER_RX_MASKED_COUNT];
+    uint16_t rxMaskedCount;
+    bool_t rxMaskedOverflow;
+#endif
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_RING
+    CO_CANrxRingEntry_t rxRing[CO_CONFIG_DRIVER_RX_RING_SIZE];
+    volatile uint16_t rxRingHead;
+    volatile uint16_t rxRingTail;
+    uint16_t rxRingBatch;
+#endif
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_QUEUE
+    CO_CANtxQueue_t txQueue;
+#endif
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_HW_FILTER
+    CO_CANfilterBank_t filterBanks[CO_CONFIG_DRIVER_FILTER_BANKS];
+    uint8_t filterBankCount;
+#endif
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+    CO_CANtraffic_t traffic;
+#endif
+#ifdef CO_DRIVER_LOOPBACK
+    CO_CANrxMsg_t loopback[CO_DRIVER_LOOPBACK_SIZE];
+    uint16_t loopbackHead;
+    uint16_t loopbackTail;
+    uint32_t loopbackTxCount;
+    uint32_t loopbackRxCount;
+#endif
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    uint32_t rxOverflowCount;
+    uint32_t txOverflowCount;
+#endif
 } CO_CANmodule_t;
 
 
@@ -206,7 +206,13 @@ int main (void){
 
 
         /* start CAN */
+#if CO_CONFIG_CAN_IF_COUNT > 1
+        for(uint8_t ifNo = 0; ifNo < CO_CONFIG_CAN_IF_COUNT; ifNo++) {
+            CO_CANsetNormalMode(CO->CANmoduleIf[ifNo]);
+        }
+#else
         CO_CANsetNormalMode(CO->CANmodule);
+#endif
 
         reset = CO_RESET_NOT;
 
@@ -227,6 +233,11 @@ int main (void){
 
             /* Process automatic storage */
 
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_DEFERRED
+            /* Process store command, queued by SDO write to 0x1010 */
+            CO_storage_process(&storage);
+#endif
+
             /* optional sleep for short time */
         }
     }
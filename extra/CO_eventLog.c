@@ -0,0 +1,328 @@
+/*
+ * Lock-free log of binary event records.
+ *
+ * @file        CO_eventLog.c
+ * @ingroup     CO_eventLog
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "extra/CO_eventLog.h"
+
+#if (CO_CONFIG_EVLOG) & CO_CONFIG_EVLOG_ENABLE
+
+#define EVLOG_MASK ((uint32_t)CO_CONFIG_EVLOG_SIZE - 1U)
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_eventLog_init(CO_eventLog_t *evlog) {
+    if (evlog == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(evlog, 0, sizeof(CO_eventLog_t));
+    /* slot is free for writing, when its seq equals write position */
+    for (uint32_t i = 0; i < CO_CONFIG_EVLOG_SIZE; i++) {
+        evlog->slots[i].seq = i;
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_CONSUMER
+/* Callback has no object argument */
+static CO_eventLog_t *evlogEM = NULL;
+
+static void evlogEmRx(const uint16_t ident,
+                      const uint16_t errorCode,
+                      const uint8_t errorRegister,
+                      const uint8_t errorBit,
+                      const uint32_t infoCode)
+{
+    CO_eventLog_record_t rec;
+
+    rec.type = CO_EVLOG_EMCY_RX;
+    rec.nodeId = (uint8_t)(ident & 0x7F);
+    rec.arg16 = errorCode;
+    rec.arg8[0] = errorRegister;
+    rec.arg8[1] = errorBit;
+    rec.arg32 = infoCode;
+    CO_eventLog_put(evlogEM, &rec);
+}
+
+/******************************************************************************/
+void CO_eventLog_initEM(CO_eventLog_t *evlog, CO_EM_t *em) {
+    if (evlog != NULL && em != NULL) {
+        evlogEM = evlog;
+        CO_EM_initCallbackRx(em, evlogEmRx);
+    }
+}
+#endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_CONSUMER */
+
+
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE) \
+    || ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI)
+static void evlogHb(CO_eventLog_t *evlog, uint8_t type, uint8_t nodeId,
+                    uint8_t arg)
+{
+    CO_eventLog_record_t rec;
+
+    memset(&rec, 0, sizeof(rec));
+    rec.type = type;
+    rec.nodeId = nodeId;
+    rec.arg8[0] = arg;
+    CO_eventLog_put(evlog, &rec);
+}
+
+static void evlogHbNmtChanged(uint8_t nodeId, uint8_t idx,
+                              CO_NMT_internalState_t NMTstate, void *object)
+{
+    (void)idx;
+    evlogHb((CO_eventLog_t *)object, CO_EVLOG_HB_NMT_CHANGED, nodeId,
+            (uint8_t)NMTstate);
+}
+
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+static void evlogHbTimeout(uint8_t nodeId, uint8_t idx, void *object) {
+    (void)idx;
+    evlogHb((CO_eventLog_t *)object, CO_EVLOG_HB_TIMEOUT, nodeId, 0);
+}
+
+static void evlogHbRemoteReset(uint8_t nodeId, uint8_t idx, void *object) {
+    (void)idx;
+    evlogHb((CO_eventLog_t *)object, CO_EVLOG_HB_REMOTE_RESET, nodeId, 0);
+}
+#endif
+
+/******************************************************************************/
+void CO_eventLog_initHBconsumer(CO_eventLog_t *evlog, CO_HBconsumer_t *HBcons) {
+    if (evlog == NULL || HBcons == NULL) {
+        return;
+    }
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+    for (uint8_t i = 0; i < HBcons->numberOfMonitoredNodes; i++) {
+        CO_HBconsumer_initCallbackNmtChanged(HBcons, i, evlog,
+                                             evlogHbNmtChanged);
+        CO_HBconsumer_initCallbackTimeout(HBcons, i, evlog, evlogHbTimeout);
+        CO_HBconsumer_initCallbackRemoteReset(HBcons, i, evlog,
+                                              evlogHbRemoteReset);
+    }
+#else
+    CO_HBconsumer_initCallbackNmtChanged(HBcons, 0, evlog, evlogHbNmtChanged);
+#endif
+}
+#endif
+
+
+/******************************************************************************/
+bool_t CO_eventLog_put(CO_eventLog_t *evlog, const CO_eventLog_record_t *rec) {
+    CO_eventLog_slot_t *slot;
+    uint32_t pos;
+
+    if (evlog == NULL || rec == NULL) {
+        return false;
+    }
+
+    /* reserve the slot at write position */
+    pos = evlog->head;
+    for (;;) {
+        slot = &evlog->slots[pos & EVLOG_MASK];
+        uint32_t seq = slot->seq;
+        int32_t diff = (int32_t)(seq - pos);
+
+        if (diff == 0) {
+            if (CO_EVLOG_CAS_U32(&evlog->head, pos, pos + 1U)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            /* slot was not yet read, log is full */
+            CO_EVLOG_ADD_U32(&evlog->dropped, 1U);
+            return false;
+        }
+        /* other producer was faster, try again */
+        pos = evlog->head;
+    }
+
+    slot->record = *rec;
+    slot->record.time_ms = evlog->time_ms;
+    CO_MemoryBarrier();
+    /* publish the record to the consumer */
+    slot->seq = pos + 1U;
+
+    return true;
+}
+
+
+/******************************************************************************/
+bool_t CO_eventLog_read(CO_eventLog_t *evlog, CO_eventLog_record_t *rec) {
+    CO_eventLog_slot_t *slot;
+
+    if (evlog == NULL || rec == NULL) {
+        return false;
+    }
+
+    slot = &evlog->slots[evlog->tail & EVLOG_MASK];
+    if (slot->seq != evlog->tail + 1U) {
+        /* empty or producer did not finish writing yet */
+        return false;
+    }
+    CO_MemoryBarrier();
+    *rec = slot->record;
+    CO_MemoryBarrier();
+    /* free the slot for the next round */
+    slot->seq = evlog->tail + CO_CONFIG_EVLOG_SIZE;
+    evlog->tail++;
+
+    return true;
+}
+
+
+/******************************************************************************/
+uint32_t CO_eventLog_getDropped(CO_eventLog_t *evlog, bool_t reset) {
+    uint32_t dropped;
+
+    if (evlog == NULL) {
+        return 0;
+    }
+    dropped = evlog->dropped;
+    if (reset && dropped > 0) {
+        /* producers may increment it meanwhile */
+        CO_EVLOG_ADD_U32(&evlog->dropped, 0U - dropped);
+    }
+    return dropped;
+}
+
+
+/* Name of NMT state */
+static const char *nmtStateName(uint8_t state) {
+    switch ((int8_t)state) {
+        case CO_NMT_INITIALIZING: return "initializing";
+        case CO_NMT_PRE_OPERATIONAL: return "pre-operational";
+        case CO_NMT_OPERATIONAL: return "operational";
+        case CO_NMT_STOPPED: return "stopped";
+        default: return "unknown";
+    }
+}
+
+/******************************************************************************/
+size_t CO_eventLog_format(const CO_eventLog_record_t *rec,
+                          char *buf,
+                          size_t bufSize)
+{
+    int len;
+
+    if (rec == NULL || buf == NULL || bufSize == 0) {
+        return 0;
+    }
+
+    switch (rec->type) {
+    case CO_EVLOG_EMCY_RX:
+        len = snprintf(buf, bufSize, "%"PRIu32" ms: EMCY %d 0x%04X 0x%02X " \
+                       "0x%02X 0x%08"PRIX32"\n", rec->time_ms, rec->nodeId,
+                       rec->arg16, rec->arg8[0], rec->arg8[1], rec->arg32);
+        break;
+    case CO_EVLOG_HB_NMT_CHANGED:
+        len = snprintf(buf, bufSize, "%"PRIu32" ms: HB %d %s\n", rec->time_ms,
+                       rec->nodeId, nmtStateName(rec->arg8[0]));
+        break;
+    case CO_EVLOG_HB_TIMEOUT:
+        len = snprintf(buf, bufSize, "%"PRIu32" ms: HB %d timeout\n",
+                       rec->time_ms, rec->nodeId);
+        break;
+    case CO_EVLOG_HB_REMOTE_RESET:
+        len = snprintf(buf, bufSize, "%"PRIu32" ms: HB %d boot-up\n",
+                       rec->time_ms, rec->nodeId);
+        break;
+    case CO_EVLOG_SDO_ABORT:
+        len = snprintf(buf, bufSize, "%"PRIu32" ms: SDO %d 0x%04X 0x%02X " \
+                       "abort 0x%08"PRIX32"\n", rec->time_ms, rec->nodeId,
+                       rec->arg16, rec->arg8[0], rec->arg32);
+        break;
+    case CO_EVLOG_LSS_NODE_ID:
+        len = snprintf(buf, bufSize, "%"PRIu32" ms: LSS node-ID %d set, " \
+                       "serial 0x%08"PRIX32"\n", rec->time_ms, rec->nodeId,
+                       rec->arg32);
+        break;
+    case CO_EVLOG_LSS_FOUND:
+        len = snprintf(buf, bufSize, "%"PRIu32" ms: LSS found serial " \
+                       "0x%08"PRIX32"\n", rec->time_ms, rec->arg32);
+        break;
+    case CO_EVLOG_LSS_STORED:
+        len = snprintf(buf, bufSize, "%"PRIu32" ms: LSS stored\n",
+                       rec->time_ms);
+        break;
+    default:
+        len = snprintf(buf, bufSize, "%"PRIu32" ms: event 0x%02X %d 0x%04X " \
+                       "0x%02X 0x%02X 0x%08"PRIX32"\n", rec->time_ms,
+                       rec->type, rec->nodeId, rec->arg16, rec->arg8[0],
+                       rec->arg8[1], rec->arg32);
+        break;
+    }
+
+    if (len < 0) {
+        return 0;
+    }
+    return ((size_t)len < bufSize) ? (size_t)len : bufSize - 1;
+}
+
+
+/******************************************************************************/
+size_t CO_eventLog_readText(CO_eventLog_t *evlog, char *buf, size_t bufSize) {
+    CO_eventLog_record_t rec;
+    uint32_t dropped;
+
+    if (evlog == NULL || buf == NULL || bufSize == 0) {
+        return 0;
+    }
+
+    dropped = CO_eventLog_getDropped(evlog, true);
+    if (dropped > 0) {
+        int len = snprintf(buf, bufSize, "%"PRIu32" ms: %"PRIu32" events " \
+                           "dropped\n", evlog->time_ms, dropped);
+        if (len < 0) {
+            return 0;
+        }
+        return ((size_t)len < bufSize) ? (size_t)len : bufSize - 1;
+    }
+
+    if (!CO_eventLog_read(evlog, &rec)) {
+        return 0;
+    }
+    return CO_eventLog_format(&rec, buf, bufSize);
+}
+
+
+/******************************************************************************/
+void CO_eventLog_process(CO_eventLog_t *evlog, uint32_t timeDifference_us) {
+    if (evlog == NULL) {
+        return;
+    }
+
+    evlog->time_us += timeDifference_us;
+    evlog->time_ms += evlog->time_us / 1000;
+    evlog->time_us %= 1000;
+}
+
+#endif /* (CO_CONFIG_EVLOG) & CO_CONFIG_EVLOG_ENABLE */
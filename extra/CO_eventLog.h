@@ -0,0 +1,306 @@
+/**
+ * Lock-free log of binary event records.
+ *
+ * @file        CO_eventLog.h
+ * @ingroup     CO_eventLog
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_EVENT_LOG_H
+#define CO_EVENT_LOG_H
+
+#include "301/CO_driver.h"
+#include "301/CO_Emergency.h"
+#include "301/CO_HBconsumer.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_EVLOG
+#define CO_CONFIG_EVLOG (0)
+#endif
+#ifndef CO_CONFIG_EVLOG_SIZE
+#define CO_CONFIG_EVLOG_SIZE 64
+#endif
+
+#if ((CO_CONFIG_EVLOG) & CO_CONFIG_EVLOG_ENABLE) || defined CO_DOXYGEN
+
+#if (CO_CONFIG_EVLOG_SIZE & (CO_CONFIG_EVLOG_SIZE - 1)) != 0 \
+    || CO_CONFIG_EVLOG_SIZE < 2
+#error CO_CONFIG_EVLOG_SIZE must be power of two.
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_eventLog Event log
+ * Lock-free log of binary event records.
+ *
+ * @ingroup CO_CANopen_extra
+ * @{
+ * Event log records communication events into a ring of fixed-size binary
+ * records: received emergency messages, heartbeat consumer state changes, SDO
+ * client aborts in the gateway and LSS master events in the gateway. Recording
+ * is cheap: no formatting and no locks, only one compare-and-swap on the write
+ * position. Events may be recorded from any thread or interrupt (multiple
+ * producers), while log is read from a single thread (single consumer). If
+ * ring is full, event is dropped and counted.
+ *
+ * Records are formatted into text only when read with
+ * CO_eventLog_readText(), for example by "log" command of the
+ * @ref CO_CANopen_309_3. See CO_GTWA_initEventLog().
+ *
+ * Sources are connected with CO_eventLog_initEM() and
+ * CO_eventLog_initHBconsumer(). Application may record own events with
+ * CO_eventLog_put().
+ *
+ * Atomic operations are defined by #CO_EVLOG_CAS_U32 and
+ * #CO_EVLOG_ADD_U32 macros, which may be defined in **CO_driver_target.h**.
+ * Defaults use GCC builtins. On targets without atomic instructions macros may
+ * be implemented with interrupts disabled.
+ */
+
+#ifndef CO_EVLOG_CAS_U32
+/** Atomic compare and swap of uint32_t: if *ptr equals oldVal, set it to
+ * newVal and return true. Must include memory barrier. */
+#define CO_EVLOG_CAS_U32(ptr, oldVal, newVal) \
+    __sync_bool_compare_and_swap(ptr, oldVal, newVal)
+#endif
+#ifndef CO_EVLOG_ADD_U32
+/** Atomic add to uint32_t. Must include memory barrier. */
+#define CO_EVLOG_ADD_U32(ptr, val) ((void)__sync_fetch_and_add(ptr, val))
+#endif
+
+
+/**
+ * Type of the event record.
+ */
+typedef enum {
+    /** Emergency message received. nodeId is node-ID of the producer (0 for
+     * own emergency), arg16 is error code, arg8[0] is error register,
+     * arg8[1] is error bit, arg32 is additional info code. */
+    CO_EVLOG_EMCY_RX = 1,
+    /** NMT state of monitored node changed. arg8[0] is new
+     * @ref CO_NMT_internalState_t state. */
+    CO_EVLOG_HB_NMT_CHANGED = 2,
+    /** Heartbeat of monitored node timed out. */
+    CO_EVLOG_HB_TIMEOUT = 3,
+    /** Boot-up message received from monitored node. */
+    CO_EVLOG_HB_REMOTE_RESET = 4,
+    /** SDO client transfer aborted. arg16 is index, arg8[0] is subindex,
+     * arg32 is SDO abort code. */
+    CO_EVLOG_SDO_ABORT = 5,
+    /** LSS master configured node-ID (nodeId) of the selected LSS slave.
+     * arg32 is serial number of the slave, if known, otherwise zero. */
+    CO_EVLOG_LSS_NODE_ID = 6,
+    /** LSS master identified LSS slave with fastscan. arg32 is its serial
+     * number. */
+    CO_EVLOG_LSS_FOUND = 7,
+    /** LSS master stored configuration in the selected LSS slave. */
+    CO_EVLOG_LSS_STORED = 8,
+    /** Application specific events start here */
+    CO_EVLOG_USER = 0x80
+} CO_eventLog_type_t;
+
+
+/**
+ * Event record.
+ */
+typedef struct {
+    /** Time of the event in milliseconds, see CO_eventLog_process() */
+    uint32_t time_ms;
+    /** Argument, see @ref CO_eventLog_type_t */
+    uint32_t arg32;
+    /** Argument, see @ref CO_eventLog_type_t */
+    uint16_t arg16;
+    /** Type of the event, @ref CO_eventLog_type_t */
+    uint8_t type;
+    /** Node-ID of the node, which caused the event */
+    uint8_t nodeId;
+    /** Arguments, see @ref CO_eventLog_type_t */
+    uint8_t arg8[2];
+} CO_eventLog_record_t;
+
+
+/**
+ * Slot in the ring of records.
+ */
+typedef struct {
+    /** Sequence number, which indicates, if slot is free or written */
+    volatile uint32_t seq;
+    /** Event record */
+    CO_eventLog_record_t record;
+} CO_eventLog_slot_t;
+
+
+/**
+ * Event log object.
+ */
+typedef struct {
+    /** Ring of records */
+    CO_eventLog_slot_t slots[CO_CONFIG_EVLOG_SIZE];
+    /** Write position, shared by producers */
+    volatile uint32_t head;
+    /** Read position, used by consumer only */
+    uint32_t tail;
+    /** Number of dropped events since last CO_eventLog_getDropped() */
+    volatile uint32_t dropped;
+    /** Time of the log in milliseconds, incremented in
+     * CO_eventLog_process() */
+    volatile uint32_t time_ms;
+    /** Remainder of time in microseconds */
+    uint32_t time_us;
+} CO_eventLog_t;
+
+
+/**
+ * Initialize event log object.
+ *
+ * @param evlog This object will be initialized.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_eventLog_init(CO_eventLog_t *evlog);
+
+
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_CONSUMER) || defined CO_DOXYGEN
+/**
+ * Record received emergency messages.
+ *
+ * Function registers own callback with CO_EM_initCallbackRx(), which replaces
+ * previously registered callback. Only one event log can be connected to
+ * emergency objects, because callback has no object argument.
+ *
+ * @param evlog This object.
+ * @param em Emergency object.
+ */
+void CO_eventLog_initEM(CO_eventLog_t *evlog, CO_EM_t *em);
+#endif
+
+
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE) \
+    || ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI) \
+    || defined CO_DOXYGEN
+/**
+ * Record heartbeat consumer state changes.
+ *
+ * Function registers NMT changed callback and, if
+ * CO_CONFIG_HB_CONS_CALLBACK_MULTI is enabled, also timeout and remote reset
+ * callbacks for all monitored nodes. Previously registered callbacks are
+ * replaced. Function must be called after CO_HBconsumer_init().
+ *
+ * @param evlog This object.
+ * @param HBcons Heartbeat consumer object.
+ */
+void CO_eventLog_initHBconsumer(CO_eventLog_t *evlog, CO_HBconsumer_t *HBcons);
+#endif
+
+
+/**
+ * Record event.
+ *
+ * Function may be called from any thread or interrupt. Time of the record is
+ * set here.
+ *
+ * @param evlog This object.
+ * @param rec Event record, time_ms is ignored.
+ *
+ * @return true on success, false if log is full and event was dropped.
+ */
+bool_t CO_eventLog_put(CO_eventLog_t *evlog, const CO_eventLog_record_t *rec);
+
+
+/**
+ * Read and remove the oldest record.
+ *
+ * Function must be called from single thread.
+ *
+ * @param evlog This object.
+ * @param [out] rec Event record.
+ *
+ * @return true, if record was read, false if log is empty.
+ */
+bool_t CO_eventLog_read(CO_eventLog_t *evlog, CO_eventLog_record_t *rec);
+
+
+/**
+ * Get number of dropped events.
+ *
+ * @param evlog This object.
+ * @param reset If true, counter is decremented by returned value.
+ *
+ * @return Number of events, dropped because log was full.
+ */
+uint32_t CO_eventLog_getDropped(CO_eventLog_t *evlog, bool_t reset);
+
+
+/**
+ * Format event record into text.
+ *
+ * Text is single line, terminated with '\\n', for example:
+ * "1200 ms: HB 5 operational\\n".
+ *
+ * @param rec Event record.
+ * @param [out] buf Buffer for text, zero terminated.
+ * @param bufSize Size of the buffer.
+ *
+ * @return Length of the text, without terminating zero.
+ */
+size_t CO_eventLog_format(const CO_eventLog_record_t *rec,
+                          char *buf,
+                          size_t bufSize);
+
+
+/**
+ * Read the oldest record and format it into text.
+ *
+ * If some events were dropped, line with their number is returned first and
+ * counter is reset. Function must be called from single thread.
+ *
+ * @param evlog This object.
+ * @param [out] buf Buffer for text, zero terminated.
+ * @param bufSize Size of the buffer.
+ *
+ * @return Length of the text, without terminating zero, or 0 if log is empty.
+ */
+size_t CO_eventLog_readText(CO_eventLog_t *evlog, char *buf, size_t bufSize);
+
+
+/**
+ * Process event log.
+ *
+ * Function must be called cyclically, for example after CO_process(). It
+ * increments time of the log, used for records.
+ *
+ * @param evlog This object.
+ * @param timeDifference_us Time difference from previous function call in
+ * [microseconds].
+ */
+void CO_eventLog_process(CO_eventLog_t *evlog, uint32_t timeDifference_us);
+
+/** @} */ /* CO_eventLog */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_EVLOG) & CO_CONFIG_EVLOG_ENABLE */
+
+#endif /* CO_EVENT_LOG_H */
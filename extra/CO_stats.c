@@ -0,0 +1,297 @@
+/*
+ * CANopen statistics of processing time and communication events.
+ *
+ * @file        CO_stats.c
+ * @ingroup     CO_stats
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "extra/CO_stats.h"
+
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+
+/* Number of subindexes in OD entry, without subindex 0 */
+#define CO_STATS_OD_SUBS (CO_STATS_COUNT * 4 + 3)
+
+/*
+ * Custom function for reading OD object with statistics
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_read_stats(OD_stream_t *stream, void *buf,
+                           OD_size_t count, OD_size_t *countRead)
+{
+    if (stream == NULL || buf == NULL || countRead == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    if (stream->subIndex == 0) {
+        return OD_readOriginal(stream, buf, count, countRead);
+    }
+    if (stream->subIndex > CO_STATS_OD_SUBS) {
+        return ODR_SUB_NOT_EXIST;
+    }
+    if (count < sizeof(uint32_t)) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_stats_t *stats = stream->object;
+    uint8_t sub = stream->subIndex - 1;
+    uint32_t value;
+
+    if (sub < CO_STATS_COUNT * 4) {
+        CO_stats_timing_t *t = &stats->timing[sub / 4];
+        switch (sub % 4) {
+            case 0: value = t->count; break;
+            case 1: value = t->min; break;
+            case 2: value = t->sumCount > 0 ? t->sum / t->sumCount : 0; break;
+            default: value = t->max; break;
+        }
+    }
+    else if (sub == CO_STATS_COUNT * 4) {
+        value = CO_stats_rxOverflowCount(stats);
+    }
+    else if (sub == CO_STATS_COUNT * 4 + 1) {
+        value = CO_stats_txOverflowCount(stats);
+    }
+    else {
+        value = stats->sdoBytesPerSecond;
+    }
+
+    CO_setUint32(buf, value);
+    *countRead = sizeof(uint32_t);
+    return ODR_OK;
+}
+
+/*
+ * Custom function for writing OD object with statistics
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_write_stats(OD_stream_t *stream, const void *buf,
+                            OD_size_t count, OD_size_t *countWritten)
+{
+    if (stream == NULL || buf == NULL || countWritten == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+    if (stream->subIndex == 0) {
+        return ODR_READONLY;
+    }
+    if (stream->subIndex > CO_STATS_OD_SUBS) {
+        return ODR_SUB_NOT_EXIST;
+    }
+
+    CO_stats_reset(stream->object);
+
+    *countWritten = count;
+    return ODR_OK;
+}
+
+
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+/* Number of subindexes in OD entry for CAN traffic, without subindex 0 */
+#define CO_STATS_TRAFFIC_OD_SUBS (6 + CO_CONFIG_DRIVER_TRAFFIC_IDS * 3)
+
+/*
+ * Custom function for reading OD object with CAN traffic statistics
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_read_traffic(OD_stream_t *stream, void *buf,
+                             OD_size_t count, OD_size_t *countRead)
+{
+    if (stream == NULL || buf == NULL || countRead == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    if (stream->subIndex == 0) {
+        return OD_readOriginal(stream, buf, count, countRead);
+    }
+    if (stream->subIndex > CO_STATS_TRAFFIC_OD_SUBS) {
+        return ODR_SUB_NOT_EXIST;
+    }
+    if (count < sizeof(uint32_t)) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_stats_t *stats = stream->object;
+    CO_CANtraffic_t *t = &stats->CANmodule->traffic;
+    uint8_t sub = stream->subIndex - 1;
+    uint32_t value;
+
+    switch (sub) {
+        case 0: value = t->rxFrames; break;
+        case 1: value = t->txFrames; break;
+        case 2: value = t->load; break;
+        case 3: value = t->loadPeak; break;
+        case 4: value = t->txCountMax; break;
+        case 5: value = t->otherFrames; break;
+        default: {
+            CO_CANtrafficId_t *id = &t->ids[(sub - 6) / 3];
+            switch ((sub - 6) % 3) {
+                case 0:
+                    value = id->ident == CO_CANtraffic_ID_NONE
+                          ? 0x80000000UL : id->ident;
+                    break;
+                case 1: value = id->rxFrames; break;
+                default: value = id->txFrames; break;
+            }
+            break;
+        }
+    }
+
+    CO_setUint32(buf, value);
+    *countRead = sizeof(uint32_t);
+    return ODR_OK;
+}
+
+/*
+ * Custom function for writing OD object with CAN traffic statistics
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_write_traffic(OD_stream_t *stream, const void *buf,
+                              OD_size_t count, OD_size_t *countWritten)
+{
+    if (stream == NULL || buf == NULL || countWritten == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+    if (stream->subIndex == 0) {
+        return ODR_READONLY;
+    }
+    if (stream->subIndex > CO_STATS_TRAFFIC_OD_SUBS) {
+        return ODR_SUB_NOT_EXIST;
+    }
+
+    CO_stats_reset(stream->object);
+
+    *countWritten = count;
+    return ODR_OK;
+}
+#endif /* (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC */
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_stats_init(CO_stats_t *stats,
+                               CO_CANmodule_t *CANmodule,
+                               OD_entry_t *OD_stats)
+{
+    if (stats == NULL || CANmodule == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* statistics are kept over communication reset */
+    stats->CANmodule = CANmodule;
+
+    if (OD_stats != NULL) {
+        stats->OD_stats_extension.object = stats;
+        stats->OD_stats_extension.read = OD_read_stats;
+        stats->OD_stats_extension.write = OD_write_stats;
+        OD_extension_init(OD_stats, &stats->OD_stats_extension);
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+CO_ReturnError_t CO_stats_initTraffic(CO_stats_t *stats,
+                                      OD_entry_t *OD_traffic)
+{
+    if (stats == NULL || stats->CANmodule == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    if (OD_traffic != NULL) {
+        stats->OD_traffic_extension.object = stats;
+        stats->OD_traffic_extension.read = OD_read_traffic;
+        stats->OD_traffic_extension.write = OD_write_traffic;
+        OD_extension_init(OD_traffic, &stats->OD_traffic_extension);
+    }
+
+    return CO_ERROR_NO;
+}
+#endif
+
+
+/******************************************************************************/
+void CO_stats_reset(CO_stats_t *stats) {
+    if (stats != NULL) {
+        memset(stats->timing, 0, sizeof(stats->timing));
+        stats->sdoBytesPerSecond = 0;
+        stats->sdoBytes = 0;
+        stats->sdoTimer_us = 0;
+        if (stats->CANmodule != NULL) {
+            stats->rxOverflowBase = stats->CANmodule->rxOverflowCount;
+            stats->txOverflowBase = stats->CANmodule->txOverflowCount;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+            CO_LOCK_CAN_SEND(stats->CANmodule);
+            CO_CANtraffic_reset(&stats->CANmodule->traffic);
+            CO_UNLOCK_CAN_SEND(stats->CANmodule);
+#endif
+        }
+    }
+}
+
+
+/******************************************************************************/
+void CO_stats_stop(CO_stats_t *stats, CO_stats_id_t id, uint32_t start) {
+    /* unsigned arithmetic handles overflow of the cycle counter */
+    uint32_t time = CO_STATS_CYCLES() - start;
+    CO_stats_timing_t *t = &stats->timing[id];
+
+    if (t->count == 0 || time < t->min) {
+        t->min = time;
+    }
+    if (time > t->max) {
+        t->max = time;
+    }
+    if (t->count < 0xFFFFFFFF) {
+        t->count++;
+    }
+
+    /* keep average, if sum would overflow */
+    if ((t->sum + time) < t->sum || t->sumCount == 0xFFFFFFFF) {
+        t->sum /= 2;
+        t->sumCount /= 2;
+    }
+    t->sum += time;
+    t->sumCount++;
+}
+
+
+/******************************************************************************/
+void CO_stats_process(CO_stats_t *stats, uint32_t timeDifference_us) {
+    stats->sdoTimer_us += timeDifference_us;
+    if (stats->sdoTimer_us >= 1000000) {
+        /* scale to one second, if timer is late */
+        stats->sdoBytesPerSecond = (stats->sdoTimer_us < 2000000)
+            ? stats->sdoBytes
+            : (uint32_t)((uint64_t)stats->sdoBytes * 1000000
+                         / stats->sdoTimer_us);
+        stats->sdoBytes = 0;
+        stats->sdoTimer_us = 0;
+    }
+}
+
+#endif /* (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE */
@@ -0,0 +1,283 @@
+/**
+ * CANopen statistics of processing time and communication events.
+ *
+ * @file        CO_stats.h
+ * @ingroup     CO_stats
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_STATS_H
+#define CO_STATS_H
+
+#include "301/CO_driver.h"
+#include "301/CO_ODinterface.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_STATS
+#define CO_CONFIG_STATS (0)
+#endif
+#ifndef CO_CONFIG_STATS_OD_INDEX
+#define CO_CONFIG_STATS_OD_INDEX 0x2F00
+#endif
+#ifndef CO_CONFIG_STATS_TRAFFIC_OD_INDEX
+#define CO_CONFIG_STATS_TRAFFIC_OD_INDEX 0x2F01
+#endif
+
+#if ((CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_stats Statistics
+ * Statistics of processing time and communication events.
+ *
+ * @ingroup CO_CANopen_extra
+ * @{
+ * Object is included inside @ref CO_t and is updated from CO_process(),
+ * CO_process_SYNC(), CO_process_RPDO() and CO_process_TPDO(). For each of
+ * them (and for NMT and SDO server part of CO_process()) it records number of
+ * calls and minimum, average and maximum execution time. Time is measured
+ * with CO_STATS_CYCLES() macro, which should be defined in
+ * **CO_driver_target.h** file and return value of free running cycle counter,
+ * for example DWT->CYCCNT on Cortex-M. Units of time are units of that
+ * counter. If macro is not defined, only number of calls is valid.
+ *
+ * Additionally it reports CAN receive overflow and transmit overflow events
+ * and calculates number of bytes per second transferred by SDO servers.
+ * Overflow events are counted by the driver at the point of overflow, see
+ * CO_CAN_COUNT_RX_OVERFLOW(), so each lost message is counted, not only the
+ * change of CANerrorStatus. Drivers with these counters are:
+ * example/CO_driver_blank.c, simulation/CO_driver_sim.c and
+ * socketCAN/CO_driver_socketCAN.c.
+ *
+ * Statistics are kept over communication reset, they are cleared only by
+ * CO_stats_reset() or by write to the OD entry.
+ *
+ * If Object Dictionary contains entry at @ref CO_CONFIG_STATS_OD_INDEX, values
+ * are accessible there, see @ref CO_stats_init(). If
+ * @ref CO_CONFIG_DRIVER_TRAFFIC is enabled, CAN traffic statistics of the CAN
+ * module are accessible in entry at @ref CO_CONFIG_STATS_TRAFFIC_OD_INDEX, see
+ * @ref CO_stats_initTraffic().
+ */
+
+#ifndef CO_STATS_CYCLES
+/** Read free running cycle counter, see @ref CO_stats */
+#define CO_STATS_CYCLES() ((uint32_t)0)
+#endif
+
+
+/**
+ * Processing functions, for which statistics is recorded.
+ */
+typedef enum {
+    CO_STATS_PROCESS = 0, /**< CO_process() */
+    CO_STATS_NMT = 1,     /**< CO_process_NMT() */
+    CO_STATS_SDO_SRV = 2, /**< CO_process_SDOserver() */
+    CO_STATS_SYNC = 3,    /**< CO_process_SYNC() */
+    CO_STATS_RPDO = 4,    /**< CO_process_RPDO() */
+    CO_STATS_TPDO = 5,    /**< CO_process_TPDO() */
+    CO_STATS_COUNT = 6    /**< Number of processing functions */
+} CO_stats_id_t;
+
+
+/**
+ * Statistics of execution time of one processing function.
+ */
+typedef struct {
+    /** Number of calls */
+    uint32_t count;
+    /** Minimum execution time */
+    uint32_t min;
+    /** Maximum execution time */
+    uint32_t max;
+    /** Sum of execution times for average, divided by two with sumCount on
+     * overflow */
+    uint32_t sum;
+    /** Number of calls included in sum */
+    uint32_t sumCount;
+} CO_stats_timing_t;
+
+
+/**
+ * Statistics object.
+ */
+typedef struct {
+    /** Execution time statistics for each @ref CO_stats_id_t */
+    CO_stats_timing_t timing[CO_STATS_COUNT];
+    /** Value of rxOverflowCount from CANmodule at last CO_stats_reset() */
+    uint32_t rxOverflowBase;
+    /** Value of txOverflowCount from CANmodule at last CO_stats_reset() */
+    uint32_t txOverflowBase;
+    /** Number of bytes transferred by SDO servers in last second */
+    uint32_t sdoBytesPerSecond;
+    /** Number of bytes transferred by SDO servers in current second */
+    uint32_t sdoBytes;
+    /** Timer for sdoBytesPerSecond in microseconds */
+    uint32_t sdoTimer_us;
+    /** From CO_stats_init() */
+    CO_CANmodule_t *CANmodule;
+    /** Extension for OD object */
+    OD_extension_t OD_stats_extension;
+#if ((CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC) || defined CO_DOXYGEN
+    /** Extension for OD object with CAN traffic statistics */
+    OD_extension_t OD_traffic_extension;
+#endif
+} CO_stats_t;
+
+
+/**
+ * Initialize statistics object.
+ *
+ * Function is called from CO_CANopenInit(). Statistics are not cleared, so
+ * they are kept over communication reset. They are zero after CO_new(), which
+ * allocates zeroed memory.
+ *
+ * OD entry, if used, is array of UNSIGNED32 with 27 subindexes. For each
+ * @ref CO_stats_id_t (i = 0..5) subindexes 4*i+1 to 4*i+4 contain number of
+ * calls, minimum, average and maximum execution time. Subindex 25 contains
+ * number of CAN receive overflow events, 26 number of CAN transmit overflow
+ * events and 27 sdoBytesPerSecond. Writing any
+ * value to any subindex from 1 clears all statistics.
+ *
+ * @param stats This object will be initialized.
+ * @param CANmodule CAN module, which error status is monitored.
+ * @param OD_stats OD entry for statistics, may be NULL.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_stats_init(CO_stats_t *stats,
+                               CO_CANmodule_t *CANmodule,
+                               OD_entry_t *OD_stats);
+
+
+#if ((CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC) || defined CO_DOXYGEN
+/**
+ * Initialize readout of CAN traffic statistics from Object Dictionary.
+ *
+ * Function is called from CO_CANopenInit(), after CO_stats_init(). Statistics
+ * are collected by the driver in *traffic* member of CANmodule, see
+ * @ref CO_CANtraffic.
+ *
+ * OD entry is array of UNSIGNED32 with 6 + 3 * @ref CO_CONFIG_DRIVER_TRAFFIC_IDS
+ * subindexes. Subindex 1 contains number of received frames, 2 number of
+ * transmitted frames, 3 bus load in per mille, 4 peak bus load, 5 high-water
+ * mark of transmit buffers waiting in txArray and 6 number of frames, which
+ * did not fit into the table of COB-IDs. Then follow entries of the table (in
+ * hash order), each with three subindexes: CAN identifier (0x0800 is RTR bit,
+ * 0x80000000 if entry is unused), number of received and number of
+ * transmitted frames. Writing any value to any subindex from 1 clears all
+ * statistics, also those from CO_stats_init().
+ *
+ * @param stats This object, initialized by CO_stats_init().
+ * @param OD_traffic OD entry for CAN traffic statistics, may be NULL.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_stats_initTraffic(CO_stats_t *stats,
+                                      OD_entry_t *OD_traffic);
+#endif
+
+
+/**
+ * Clear all statistics.
+ *
+ * @param stats This object.
+ */
+void CO_stats_reset(CO_stats_t *stats);
+
+
+/**
+ * Get start time for CO_stats_stop().
+ *
+ * @return Value of cycle counter.
+ */
+static inline uint32_t CO_stats_start(void) {
+    return CO_STATS_CYCLES();
+}
+
+
+/**
+ * Record execution time of processing function.
+ *
+ * @param stats This object.
+ * @param id Processing function.
+ * @param start Value from CO_stats_start() at the beginning of the function.
+ */
+void CO_stats_stop(CO_stats_t *stats, CO_stats_id_t id, uint32_t start);
+
+
+/**
+ * Add number of bytes transferred by SDO server.
+ *
+ * @param stats This object.
+ * @param bytes Number of bytes.
+ */
+static inline void CO_stats_addSDObytes(CO_stats_t *stats, uint32_t bytes) {
+    stats->sdoBytes += bytes;
+}
+
+
+/**
+ * Get number of CAN receive overflow events since last CO_stats_reset().
+ *
+ * @param stats This object.
+ *
+ * @return Number of lost received messages, counted by the driver.
+ */
+static inline uint32_t CO_stats_rxOverflowCount(CO_stats_t *stats) {
+    return stats->CANmodule->rxOverflowCount - stats->rxOverflowBase;
+}
+
+
+/**
+ * Get number of CAN transmit overflow events since last CO_stats_reset().
+ *
+ * @param stats This object.
+ *
+ * @return Number of transmit overflow events, counted by the driver.
+ */
+static inline uint32_t CO_stats_txOverflowCount(CO_stats_t *stats) {
+    return stats->CANmodule->txOverflowCount - stats->txOverflowBase;
+}
+
+
+/**
+ * Process statistics.
+ *
+ * Function is called from CO_process_NMT(), after CO_CANmodule_process(). It
+ * updates sdoBytesPerSecond.
+ *
+ * @param stats This object.
+ * @param timeDifference_us Time difference from previous function call in
+ * [microseconds].
+ */
+void CO_stats_process(CO_stats_t *stats, uint32_t timeDifference_us);
+
+/** @} */ /* CO_stats */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE */
+
+#endif /* CO_STATS_H */
@@ -91,10 +91,64 @@ static const CO_trace_dataType_t dataTypes[] = {
     {getValueI32, printPointSvgStart,         printPointSvg,         printPointSvg},
     {getValueU8,  printPointSvgStartUnsigned, printPointSvgUnsigned, printPointSvgUnsigned},
     {getValueU16, printPointSvgStartUnsigned, printPointSvgUnsigned, printPointSvgUnsigned},
-    {getValueU32, printPointSvgStartUnsigned, printPointSvgUnsigned, printPointSvgUnsigned}
+    {getValueU32, printPointSvgStartUnsigned, printPointSvgUnsigned, printPointSvgUnsigned},
+#if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_BINARY_DELTA
+    /* binary delta, points are printed by printPointDelta() */
+    {getValueI8,  NULL,                       NULL,                  NULL},
+    {getValueI16, NULL,                       NULL,                  NULL},
+    {getValueI32, NULL,                       NULL,                  NULL},
+    {getValueU8,  NULL,                       NULL,                  NULL},
+    {getValueU16, NULL,                       NULL,                  NULL},
+    {getValueU32, NULL,                       NULL,                  NULL},
+#endif
 };
 
 
+#if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_BINARY_DELTA
+/* Print variable length integer, seven bits per byte, LSB first. */
+static uint32_t printVarint(char *s, uint32_t value) {
+    uint32_t len = 0;
+    while(value >= 0x80) {
+        s[len++] = (char)((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    s[len++] = (char)value;
+    return len;
+}
+
+/* Print point in binary delta format, see CO_trace.h. */
+static uint32_t printPointDelta(CO_trace_t *trace, char *s, uint32_t size, uint32_t timeStamp, int32_t value) {
+    if(size < 10) return 0;
+    uint32_t timeDiff = timeStamp - trace->deltaTime;
+    uint32_t valueDiff = (uint32_t)value - (uint32_t)trace->deltaValue;
+    /* zig-zag encoding of signed difference */
+    valueDiff = ((valueDiff & 0x80000000UL) != 0) ? ~(valueDiff << 1) : (valueDiff << 1);
+
+    uint32_t len = printVarint(s, timeDiff);
+    len += printVarint(s + len, valueDiff);
+    trace->deltaTime = timeStamp;
+    trace->deltaValue = value;
+    return len;
+}
+#endif
+
+
+/* Print point with data type specific function or in binary delta format. */
+static uint32_t printPoint(CO_trace_t *trace,
+                           uint32_t (*print)(char *s, uint32_t size, uint32_t timeStamp, int32_t value),
+                           char *s, uint32_t size, uint32_t timeStamp, int32_t value)
+{
+#if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_BINARY_DELTA
+    if(trace->delta) {
+        return printPointDelta(trace, s, size, timeStamp, value);
+    }
+#else
+    (void)trace;
+#endif
+    return print(s, size, timeStamp, value);
+}
+
+
 /* Find variable in Object Dictionary *****************************************/
 static void findVariable(CO_trace_t *trace) {
     bool_t err = false;
@@ -152,7 +206,7 @@ static void findVariable(CO_trace_t *trace) {
         /* third sequence: Output type */
         dtIndex += ((*trace->format) >> 1) * 6;
 
-        if(dtIndex > (sizeof(dataTypes) / sizeof(CO_trace_dataType_t))) {
+        if(dtIndex >= (sizeof(dataTypes) / sizeof(CO_trace_dataType_t))) {
             err = true;
         }
     }
@@ -166,6 +220,9 @@ static void findVariable(CO_trace_t *trace) {
             trace->OD_variable = trace->value;
         }
         trace->dt = &dataTypes[dtIndex];
+#if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_BINARY_DELTA
+        trace->delta = ((*trace->format) >> 1) == 3;
+#endif
     }
     else  {
         trace->OD_variable = NULL;
@@ -218,6 +275,10 @@ static CO_SDO_abortCode_t CO_ODF_traceConfig(CO_ODF_arg_t *ODF_arg) {
                         trace->valuePrev = 0;
                         trace->readPtr = 0;
                         trace->writePtr = 0;
+#if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_TRIGGER_WINDOW
+                        trace->triggered = false;
+                        trace->stopped = false;
+#endif
                         trace->enabled = true;
                     }
                     else {
@@ -272,6 +333,11 @@ static CO_SDO_abortCode_t CO_ODF_trace(CO_ODF_arg_t *ODF_arg) {
                     trace->writePtr = 0;
                     *trace->triggerTime = 0;
                 }
+#if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_TRIGGER_WINDOW
+                /* restart triggered capture */
+                trace->triggered = false;
+                trace->stopped = false;
+#endif
             }
             else {
                 ret = CO_SDO_AB_INVALID_VALUE;
@@ -311,6 +377,10 @@ static CO_SDO_abortCode_t CO_ODF_trace(CO_ODF_arg_t *ODF_arg) {
 
                     /* start plot, increment variables, verify overflow */
                     if(ODF_arg->firstSegment) {
+#if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_BINARY_DELTA
+                        trace->deltaTime = 0;
+                        trace->deltaValue = 0;
+#endif
                         t = trace->timeBuffer[rp];
                         v = trace->valueBuffer[rp];
                         rp ++;
@@ -326,7 +396,7 @@ static CO_SDO_abortCode_t CO_ODF_trace(CO_ODF_arg_t *ODF_arg) {
                             readPtrOverflowed = true;
                             continue;
                         }
-                        len = trace->dt->printPointStart(s, freeLen, t, v);
+                        len = printPoint(trace, trace->dt->printPointStart, s, freeLen, t, v);
                         s += len;
                         freeLen -= len;
                     }
@@ -354,14 +424,14 @@ static CO_SDO_abortCode_t CO_ODF_trace(CO_ODF_arg_t *ODF_arg) {
                         if(rp == trace->writePtr) {
                             /* If there is last time stamp, point will be printed at the end */
                             if(t != trace->lastTimeStamp) {
-                                len = trace->dt->printPoint(s, freeLen, t, v);
+                                len = printPoint(trace, trace->dt->printPoint, s, freeLen, t, v);
                                 s += len;
                                 freeLen -= len;
                             }
                             ODF_arg->lastSegment = true;
                             break;
                         }
-                        len = trace->dt->printPoint(s, freeLen, t, v);
+                        len = printPoint(trace, trace->dt->printPoint, s, freeLen, t, v);
                         s += len;
                         freeLen -= len;
 
@@ -377,7 +447,7 @@ static CO_SDO_abortCode_t CO_ODF_trace(CO_ODF_arg_t *ODF_arg) {
                     if(!readPtrOverflowed && ODF_arg->lastSegment) {
                         v = trace->valuePrev;
                         t = trace->lastTimeStamp;
-                        len = trace->dt->printPointEnd(s, freeLen, t, v);
+                        len = printPoint(trace, trace->dt->printPointEnd, s, freeLen, t, v);
                         s += len;
                         freeLen -= len;
                     }
@@ -440,6 +510,12 @@ void CO_trace_init(
     if(timeBuffer == NULL || valueBuffer == NULL) {
         trace->bufferSize = 0;
     }
+#if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_TRIGGER_WINDOW
+    trace->triggered = false;
+    trace->stopped = false;
+    trace->postTriggerCnt = 0;
+    CO_trace_setPostTrigger(trace, trace->bufferSize / 2);
+#endif
 
     if( trace->bufferSize == 0 || trace->OD_variable == NULL) {
         trace->enabled = false;
@@ -452,17 +528,27 @@ void CO_trace_init(
 
 /******************************************************************************/
 void CO_trace_process(CO_trace_t *trace, uint32_t timestamp) {
+#if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_TRIGGER_WINDOW
+    if(trace->stopped) {
+        /* capture window after trigger is complete */
+        return;
+    }
+#endif
     if(trace->enabled) {
 
         int32_t val = trace->dt->pGetValue(trace->OD_variable);
 
         if(val != trace->valuePrev) {
+            bool_t triggered = false;
+
             /* Verify, if value passed threshold */
             if((*trace->trigger & 1) != 0 && trace->valuePrev < *trace->threshold && val >= *trace->threshold) {
                 *trace->triggerTime = timestamp;
+                triggered = true;
             }
             if((*trace->trigger & 2) != 0 && trace->valuePrev < *trace->threshold && val >= *trace->threshold) {
                 *trace->triggerTime = timestamp;
+                triggered = true;
             }
 
             /* Write value and verify min/max */
@@ -488,6 +574,27 @@ void CO_trace_process(CO_trace_t *trace, uint32_t timestamp) {
                     trace->readPtr = 0;
                 }
             }
+
+#if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_TRIGGER_WINDOW
+            /* count points after trigger, stop when window is complete */
+            if(trace->triggered) {
+                if(trace->postTriggerCnt > 0) {
+                    trace->postTriggerCnt--;
+                }
+                if(trace->postTriggerCnt == 0) {
+                    trace->stopped = true;
+                }
+            }
+            else if(triggered && (*trace->trigger & 4) != 0) {
+                trace->triggered = true;
+                trace->postTriggerCnt = trace->postTrigger;
+                if(trace->postTriggerCnt == 0) {
+                    trace->stopped = true;
+                }
+            }
+#else
+            (void)triggered;
+#endif
         }
         else {
             /* if buffer is empty, make first record */
@@ -504,4 +611,15 @@ void CO_trace_process(CO_trace_t *trace, uint32_t timestamp) {
     }
 }
 
+
+#if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_TRIGGER_WINDOW
+/******************************************************************************/
+void CO_trace_setPostTrigger(CO_trace_t *trace, uint32_t postTrigger) {
+    /* circular buffer holds bufferSize - 1 points, including trigger point */
+    uint32_t max = trace->bufferSize > 2 ? trace->bufferSize - 2 : 0;
+
+    trace->postTrigger = postTrigger < max ? postTrigger : max;
+}
+#endif
+
 #endif /* (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_ENABLE */
@@ -59,6 +59,22 @@ extern "C" {
  * buffer, prints a SVG curve into string and sends it as a SDO response. If a
  * SDO request was received from the same device, then no traffic occupies CAN
  * network.
+ *
+ * Output format of the plot is set by bits 1 and above of the format:
+ * 0 - CSV text, 1 - binary (32-bit time stamp and value for each point),
+ * 2 - SVG path, 3 - binary delta (with CO_CONFIG_TRACE_BINARY_DELTA).
+ *
+ * Binary delta format: each point is two variable length integers: time
+ * stamp difference and value difference from the previous point. Value
+ * difference is zig-zag encoded (0, -1, 1, -2, ... to 0, 1, 2, 3, ...). Both
+ * are written in groups of seven bits, least significant first, bit 7 set in
+ * all bytes except the last. Previous point is zero at the start of each SDO
+ * upload.
+ *
+ * With CO_CONFIG_TRACE_TRIGGER_WINDOW and bit 2 set in trigger, recording
+ * stops after a number of points after the trigger. Buffer then contains
+ * points before and after the trigger. Recording restarts, when buffer is
+ * cleared by writing zero to trace.size.
  */
 
 
@@ -109,6 +125,17 @@ typedef struct {
     uint32_t           *triggerTime;    /**< From CO_trace_init(). */
     uint8_t            *trigger;        /**< From CO_trace_init(). */
     int32_t            *threshold;      /**< From CO_trace_init(). */
+#if ((CO_CONFIG_TRACE) & CO_CONFIG_TRACE_BINARY_DELTA) || defined CO_DOXYGEN
+    bool_t              delta;          /**< True, if output format is binary delta. */
+    uint32_t            deltaTime;      /**< Time stamp of previous point printed in binary delta format. */
+    int32_t             deltaValue;     /**< Value of previous point printed in binary delta format. */
+#endif
+#if ((CO_CONFIG_TRACE) & CO_CONFIG_TRACE_TRIGGER_WINDOW) || defined CO_DOXYGEN
+    uint32_t            postTrigger;    /**< Number of points recorded after trigger, see CO_trace_setPostTrigger(). */
+    uint32_t            postTriggerCnt; /**< Remaining points to record after trigger. */
+    bool_t              triggered;      /**< True, if trigger occurred. */
+    bool_t              stopped;        /**< True, if recording is stopped after trigger. */
+#endif
 } CO_trace_t;
 
 
@@ -167,6 +194,19 @@ void CO_trace_init(
  */
 void CO_trace_process(CO_trace_t *trace, uint32_t timestamp);
 
+
+#if ((CO_CONFIG_TRACE) & CO_CONFIG_TRACE_TRIGGER_WINDOW) || defined CO_DOXYGEN
+/**
+ * Set number of points recorded after trigger.
+ *
+ * Used if bit 2 is set in trigger. Default is half of the buffer size.
+ *
+ * @param trace This object.
+ * @param postTrigger Number of points, limited to buffer size - 1.
+ */
+void CO_trace_setPostTrigger(CO_trace_t *trace, uint32_t postTrigger);
+#endif
+
 /** @} */ /* CO_trace */
 
 #ifdef __cplusplus
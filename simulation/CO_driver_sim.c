@@ -0,0 +1,466 @@
+/*
+ * CAN module object for the simulated CAN bus.
+ *
+ * @file        CO_driver_sim.c
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <string.h>
+
+#include "301/CO_driver.h"
+#include "301/CO_CANtraffic.h"
+#include "CO_simBus.h"
+
+
+/******************************************************************************/
+void CO_CANsetConfigurationMode(void *CANptr){
+    /* simulated bus has no configuration */
+    (void)CANptr;
+}
+
+
+/******************************************************************************/
+void CO_CANsetNormalMode(CO_CANmodule_t *CANmodule){
+    /* messages are delivered only to modules in normal mode */
+    CANmodule->CANnormal = true;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANmodule_init(
+        CO_CANmodule_t         *CANmodule,
+        void                   *CANptr,
+        CO_CANrx_t              rxArray[],
+        uint16_t                rxSize,
+        CO_CANtx_t              txArray[],
+        uint16_t                txSize,
+        uint16_t                CANbitRate)
+{
+    CO_simBus_t *bus = (CO_simBus_t *)CANptr;
+    uint16_t i;
+
+    (void)CANbitRate; /* bit rate is property of the bus */
+
+    /* verify arguments */
+    if(CANmodule==NULL || bus==NULL || rxArray==NULL || txArray==NULL){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* attach module to the bus, if not already after previous reset */
+    for(i=0U; i<bus->modulesCount; i++){
+        if(bus->modules[i] == CANmodule){
+            break;
+        }
+    }
+    if(i == bus->modulesCount){
+        if(bus->modulesCount >= CO_SIM_BUS_MODULES){
+            return CO_ERROR_OUT_OF_MEMORY;
+        }
+        bus->modules[bus->modulesCount++] = CANmodule;
+        CANmodule->txFrames = 0U;
+        CANmodule->rxFrames = 0U;
+        memset(CANmodule->latencyHist, 0, sizeof(CANmodule->latencyHist));
+        CANmodule->latencySum_ns = 0U;
+        CANmodule->latencyMax_ns = 0U;
+    }
+
+    /* Configure object variables */
+    CANmodule->CANptr = CANptr;
+    CANmodule->rxArray = rxArray;
+    CANmodule->rxSize = rxSize;
+    CANmodule->txArray = txArray;
+    CANmodule->txSize = txSize;
+    CANmodule->CANerrorStatus = 0;
+    CANmodule->CANnormal = false;
+    /* all messages are received and searched in rxArray */
+    CANmodule->useCANrxFilters = false;
+    CANmodule->bufferInhibitFlag = false;
+    CANmodule->firstCANtxMessage = true;
+    CANmodule->CANtxCount = 0U;
+    CANmodule->errOld = 0U;
+
+    for(i=0U; i<rxSize; i++){
+        rxArray[i].ident = 0U;
+        rxArray[i].mask = 0xFFFFU;
+        rxArray[i].object = NULL;
+        rxArray[i].CANrx_callback = NULL;
+    }
+    for(i=0U; i<txSize; i++){
+        txArray[i].bufferFull = false;
+    }
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+    CO_CANtraffic_init(&CANmodule->traffic,
+                       (uint16_t)(1000000U / bus->bitTime_ns));
+#endif
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_CANmodule_disable(CO_CANmodule_t *CANmodule) {
+    if (CANmodule != NULL) {
+        /* module stays attached, but does not receive */
+        CANmodule->CANnormal = false;
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANrxBufferInit(
+        CO_CANmodule_t         *CANmodule,
+        uint16_t                index,
+        uint16_t                ident,
+        uint16_t                mask,
+        bool_t                  rtr,
+        void                   *object,
+        void                  (*CANrx_callback)(void *object, void *message))
+{
+    CO_ReturnError_t ret = CO_ERROR_NO;
+
+    if((CANmodule!=NULL) && (object!=NULL) && (CANrx_callback!=NULL) && (index < CANmodule->rxSize)){
+        /* buffer, which will be configured */
+        CO_CANrx_t *buffer = &CANmodule->rxArray[index];
+
+        /* Configure object variables */
+        buffer->object = object;
+        buffer->CANrx_callback = CANrx_callback;
+
+        /* CAN identifier and CAN mask, the same format as CO_CANrxMsg_t */
+        buffer->ident = ident & 0x07FFU;
+        if(rtr){
+            buffer->ident |= 0x0800U;
+        }
+        buffer->mask = (mask & 0x07FFU) | 0x0800U;
+    }
+    else{
+        ret = CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    return ret;
+}
+
+
+/******************************************************************************/
+CO_CANtx_t *CO_CANtxBufferInit(
+        CO_CANmodule_t         *CANmodule,
+        uint16_t                index,
+        uint16_t                ident,
+        bool_t                  rtr,
+        uint8_t                 noOfBytes,
+        bool_t                  syncFlag)
+{
+    CO_CANtx_t *buffer = NULL;
+
+    if((CANmodule != NULL) && (index < CANmodule->txSize)){
+        /* get specific buffer */
+        buffer = &CANmodule->txArray[index];
+
+        /* CAN identifier and rtr, the same format as CO_CANrxMsg_t */
+        buffer->ident = ((uint32_t)ident & 0x07FFU)
+                      | ((uint32_t)(rtr ? 0x0800U : 0U));
+        buffer->DLC = noOfBytes;
+
+        buffer->bufferFull = false;
+        buffer->syncFlag = syncFlag;
+    }
+
+    return buffer;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANsend(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer){
+    CO_simBus_t *bus = (CO_simBus_t *)CANmodule->CANptr;
+    CO_ReturnError_t err = CO_ERROR_NO;
+
+    /* Verify overflow, previous message is overwritten */
+    if(buffer->bufferFull){
+        if(!CANmodule->firstCANtxMessage){
+            /* don't set error, if bootup message is still on buffers */
+            CANmodule->CANerrorStatus |= CO_CAN_ERRTX_OVERFLOW;
+            CO_CAN_COUNT_TX_OVERFLOW(CANmodule, 1);
+        }
+        err = CO_ERROR_TX_OVERFLOW;
+    }
+    else{
+        /* message waits for arbitration inside CO_simBus_process() */
+        buffer->queued_ns = bus->time_ns;
+        buffer->bufferFull = true;
+        CANmodule->CANtxCount++;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+        CO_CANtraffic_txQueued(&CANmodule->traffic, CANmodule->CANtxCount);
+#endif
+    }
+
+    return err;
+}
+
+
+/******************************************************************************/
+void CO_CANclearPendingSyncPDOs(CO_CANmodule_t *CANmodule){
+    uint32_t tpdoDeleted = 0U;
+
+    /* delete pending synchronous TPDOs in TX buffers. Message, which is
+     * already on the bus, is not aborted. */
+    if(CANmodule->CANtxCount != 0U){
+        uint16_t i;
+        CO_CANtx_t *buffer = &CANmodule->txArray[0];
+        for(i = CANmodule->txSize; i > 0U; i--){
+            if(buffer->bufferFull && buffer->syncFlag){
+                buffer->bufferFull = false;
+                CANmodule->CANtxCount--;
+                tpdoDeleted = 2U;
+            }
+            buffer++;
+        }
+    }
+
+    if(tpdoDeleted != 0U){
+        CANmodule->CANerrorStatus |= CO_CAN_ERRTX_PDO_LATE;
+    }
+}
+
+
+/******************************************************************************/
+void CO_CANmodule_process(CO_CANmodule_t *CANmodule) {
+    /* Simulated bus has no error counters. Clear overflow, when all
+     * messages were transmitted. */
+    if(CANmodule->CANtxCount == 0U){
+        CANmodule->CANerrorStatus &= (uint16_t)~CO_CAN_ERRTX_OVERFLOW;
+    }
+}
+
+
+/* Simulated bus **************************************************************/
+/* Deliver the frame from the bus to all modules, except senders */
+static void frameDeliver(CO_simBus_t *bus) {
+    CO_CANtx_t *frame = &bus->frame;
+    CO_CANrxMsg_t rcvMsg;
+    uint16_t i;
+
+    rcvMsg.ident = frame->ident & 0x0FFFU;
+    rcvMsg.DLC = frame->DLC;
+    memcpy(rcvMsg.data, frame->data, sizeof(rcvMsg.data));
+
+    for(i = 0U; i < bus->modulesCount; i++){
+        CO_CANmodule_t *CANmodule = bus->modules[i];
+        CO_CANrx_t *buffer = &CANmodule->rxArray[0];
+        bool_t sender = false;
+        uint16_t index;
+
+        for(index = 0U; index < bus->frameSendersCount; index++){
+            if(bus->frameSenders[index] == CANmodule){
+                sender = true;
+            }
+        }
+        if(sender || !CANmodule->CANnormal){
+            continue;
+        }
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+        CO_CANtraffic_rx(&CANmodule->traffic, (uint16_t)rcvMsg.ident,
+                         rcvMsg.DLC, rcvMsg.data);
+#endif
+        /* Search rxArray for the same CAN-ID, as blank driver does */
+        for(index = CANmodule->rxSize; index > 0U; index--){
+            if(((rcvMsg.ident ^ buffer->ident) & buffer->mask) == 0U){
+                if(buffer->CANrx_callback != NULL){
+                    CANmodule->rxFrames++;
+                    buffer->CANrx_callback(buffer->object, (void*) &rcvMsg);
+                }
+                break;
+            }
+            buffer++;
+        }
+    }
+}
+
+
+/* Finish the frame on the bus: statistics and delivery */
+static void frameFinish(CO_simBus_t *bus) {
+    uint16_t i;
+
+    for(i = 0U; i < bus->frameSendersCount; i++){
+        CO_CANmodule_t *sender = bus->frameSenders[i];
+        uint64_t latency_ns = bus->frameEnd_ns - bus->frameQueued_ns[i];
+
+        sender->txFrames++;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+        CO_CANtraffic_tx(&sender->traffic,
+                         (uint16_t)(bus->frame.ident & 0x0FFFU),
+                         bus->frame.DLC, bus->frame.data);
+#endif
+        sender->latencyHist[CO_simBus_latencyBucket(latency_ns)]++;
+        sender->latencySum_ns += latency_ns;
+        if(latency_ns > sender->latencyMax_ns){
+            sender->latencyMax_ns = latency_ns;
+        }
+        sender->firstCANtxMessage = false;
+    }
+
+    bus->time_ns = bus->frameEnd_ns;
+    bus->busy = false;
+    frameDeliver(bus);
+}
+
+
+/* Start transmission of the pending message with the highest priority */
+static void frameArbitrate(CO_simBus_t *bus) {
+    CO_CANtx_t *candidates[CO_SIM_BUS_MODULES];
+    CO_CANtx_t *winner = NULL;
+    uint32_t winnerPrio = 0xFFFFFFFFU;
+    uint32_t contenders = 0U;
+    uint16_t i;
+
+    for(i = 0U; i < bus->modulesCount; i++){
+        CO_CANmodule_t *CANmodule = bus->modules[i];
+        CO_CANtx_t *candidate = NULL;
+        uint32_t candidatePrio = 0xFFFFFFFFU;
+        uint16_t j;
+
+        /* candidate of the module is its own highest priority message */
+        for(j = 0U; j < CANmodule->txSize && CANmodule->CANtxCount > 0U; j++){
+            CO_CANtx_t *buffer = &CANmodule->txArray[j];
+            uint32_t prio = ((buffer->ident & 0x07FFU) << 1U)
+                          | ((buffer->ident >> 11U) & 1U);
+            if(buffer->bufferFull && prio < candidatePrio){
+                candidate = buffer;
+                candidatePrio = prio;
+            }
+        }
+        candidates[i] = candidate;
+        if(candidate == NULL){
+            continue;
+        }
+        contenders++;
+        if(candidatePrio < winnerPrio){
+            winner = candidate;
+            winnerPrio = candidatePrio;
+        }
+    }
+
+    if(winner == NULL){
+        return;
+    }
+    bus->frame = *winner;
+
+    /* Identical frames from several modules are transmitted simultaneously
+     * as one frame, for example LSS fastscan responses. */
+    bus->frameSendersCount = 0U;
+    for(i = 0U; i < bus->modulesCount; i++){
+        CO_CANtx_t *candidate = candidates[i];
+        if(candidate != NULL && candidate->ident == winner->ident
+            && candidate->DLC == winner->DLC
+            && memcmp(candidate->data, winner->data, sizeof(winner->data)) == 0
+        ){
+            bus->frameSenders[bus->frameSendersCount] = bus->modules[i];
+            bus->frameQueued_ns[bus->frameSendersCount] = candidate->queued_ns;
+            bus->frameSendersCount++;
+            candidate->bufferFull = false;
+            bus->modules[i]->CANtxCount--;
+        }
+    }
+
+    uint16_t stuffBits;
+    uint16_t ident = (uint16_t)(bus->frame.ident & 0x0FFFU);
+    uint32_t bits = CO_CANtraffic_frameBits(ident, bus->frame.DLC,
+                                            bus->frame.data, &stuffBits);
+    uint64_t duration_ns = (uint64_t)bits * bus->bitTime_ns;
+
+    bus->frameEnd_ns = bus->time_ns + duration_ns;
+    bus->busy = true;
+
+    bus->frames++;
+    bus->bits += bits;
+    bus->stuffBits += stuffBits;
+    bus->busy_ns += duration_ns;
+    bus->windowBusy_ns += duration_ns;
+    bus->arbitrationLost += contenders - bus->frameSendersCount;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_simBus_init(CO_simBus_t *bus, uint16_t bitRate_kbps) {
+    if(bus == NULL || bitRate_kbps == 0U || bitRate_kbps > 1000U){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(bus, 0, sizeof(CO_simBus_t));
+    bus->bitTime_ns = 1000000U / bitRate_kbps;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_simBus_process(CO_simBus_t *bus, uint32_t timeDifference_us) {
+    uint64_t end_ns = bus->time_ns + (uint64_t)timeDifference_us * 1000U;
+
+    for(;;){
+        if(!bus->busy){
+            frameArbitrate(bus);
+            if(!bus->busy){
+                break;
+            }
+        }
+        if(bus->frameEnd_ns > end_ns){
+            break;
+        }
+        /* receivers may queue new messages, they get time of frame end */
+        frameFinish(bus);
+    }
+    bus->time_ns = end_ns;
+
+    while(bus->time_ns - bus->windowStart_ns >= CO_SIM_BUS_WINDOW_NS){
+        /* frame time is counted in the window, where it started */
+        uint64_t load = bus->windowBusy_ns * 1000U / CO_SIM_BUS_WINDOW_NS;
+        if(load > 1000U){
+            load = 1000U;
+        }
+        if(load > bus->loadPeak){
+            bus->loadPeak = (uint16_t)load;
+        }
+        bus->windowStart_ns += CO_SIM_BUS_WINDOW_NS;
+        bus->windowBusy_ns = 0U;
+    }
+}
+
+
+/******************************************************************************/
+uint16_t CO_simBus_getLoad(CO_simBus_t *bus) {
+    if(bus == NULL || bus->time_ns == 0U){
+        return 0U;
+    }
+    return (uint16_t)(bus->busy_ns * 1000U / bus->time_ns);
+}
+
+
+/******************************************************************************/
+uint8_t CO_simBus_latencyBucket(uint64_t latency_ns) {
+    uint64_t latency_us = latency_ns / 1000U;
+    uint8_t bucket = 0U;
+
+    while(latency_us >= 2U && bucket < (CO_SIM_LATENCY_HIST_SIZE - 1U)){
+        latency_us >>= 1U;
+        bucket++;
+    }
+    return bucket;
+}
@@ -0,0 +1,175 @@
+/*
+ * Simulation specific definitions for CANopenNode.
+ *
+ * @file        CO_driver_target.h
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CO_DRIVER_TARGET_H
+#define CO_DRIVER_TARGET_H
+
+/* This file contains definitions for many CANopen devices, which run inside
+ * one process on the simulated CAN bus, see CO_simBus.h.
+ * It is included from CO_driver.h, which contains documentation
+ * for common definitions below. */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Stack configuration override default values.
+ * For more information see file CO_config.h. */
+#ifndef CO_CONFIG_DRIVER
+#define CO_CONFIG_DRIVER (0)
+#endif
+/* Each node is LSS slave, first node may also be LSS master */
+#ifndef CO_CONFIG_LSS
+#define CO_CONFIG_LSS (CO_CONFIG_LSS_SLAVE | \
+                       CO_CONFIG_LSS_MASTER | \
+                       CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI)
+#endif
+
+/* Number of buckets in the transmit latency histogram of each CAN module.
+ * Bucket 0 counts latencies below 2 microseconds, bucket n latencies from
+ * 2^n to 2^(n+1)-1 microseconds. The last bucket counts all longer. */
+#ifndef CO_SIM_LATENCY_HIST_SIZE
+#define CO_SIM_LATENCY_HIST_SIZE 16
+#endif
+
+
+/* Basic definitions. If big endian, CO_SWAP_xx macros must swap bytes. */
+#define CO_LITTLE_ENDIAN
+#define CO_SWAP_16(x) x
+#define CO_SWAP_32(x) x
+#define CO_SWAP_64(x) x
+/* NULL is defined in stddef.h */
+/* true and false are defined in stdbool.h */
+/* int8_t to uint64_t are defined in stdint.h */
+typedef uint_fast8_t            bool_t;
+typedef float                   float32_t;
+typedef double                  float64_t;
+
+
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+#include "301/CO_CANtraffic.h"
+#endif
+
+
+/* Access to received CAN message */
+#define CO_CANrxMsg_readIdent(msg) \
+    ((uint16_t)(((CO_CANrxMsg_t *)(msg))->ident & 0x07FFU))
+#define CO_CANrxMsg_readDLC(msg)   (((CO_CANrxMsg_t *)(msg))->DLC)
+#define CO_CANrxMsg_readData(msg)  (((CO_CANrxMsg_t *)(msg))->data)
+#define CO_CANrxMsg_readTimestamp(msg) ((uint32_t)0)
+
+/* Received CAN message, ident contains 11-bit CAN-ID and RTR bit (0x0800) */
+typedef struct {
+    uint32_t ident;
+    uint8_t DLC;
+    uint8_t data[8];
+} CO_CANrxMsg_t;
+
+/* Received message object */
+typedef struct {
+    uint16_t ident;
+    uint16_t mask;
+    void *object;
+    void (*CANrx_callback)(void *object, void *message);
+} CO_CANrx_t;
+
+/* Transmit message object, ident has the same format as in CO_CANrxMsg_t */
+typedef struct {
+    uint32_t ident;
+    uint8_t DLC;
+    uint8_t data[8];
+    volatile bool_t bufferFull;
+    volatile bool_t syncFlag;
+    /* Simulated bus time, when message was queued by CO_CANsend() */
+    uint64_t queued_ns;
+} CO_CANtx_t;
+
+/* CAN module object */
+typedef struct {
+    void *CANptr;
+    CO_CANrx_t *rxArray;
+    uint16_t rxSize;
+    CO_CANtx_t *txArray;
+    uint16_t txSize;
+    uint16_t CANerrorStatus;
+    volatile bool_t CANnormal;
+    volatile bool_t useCANrxFilters;
+    volatile bool_t bufferInhibitFlag;
+    volatile bool_t firstCANtxMessage;
+    volatile uint16_t CANtxCount;
+    uint32_t errOld;
+    /* Statistics, collected by the simulated bus */
+    uint32_t txFrames;
+    uint32_t rxFrames;
+    uint32_t latencyHist[CO_SIM_LATENCY_HIST_SIZE];
+    uint64_t latencySum_ns;
+    uint64_t latencyMax_ns;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+    CO_CANtraffic_t traffic;
+#endif
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    uint32_t rxOverflowCount;
+    uint32_t txOverflowCount;
+#endif
+} CO_CANmodule_t;
+
+
+/* Data storage object for one entry */
+typedef struct {
+    void *addr;
+    size_t len;
+    uint8_t subIndexOD;
+    uint8_t attr;
+    /* Additional variables (target specific) */
+    void *addrNV;
+} CO_storage_entry_t;
+
+
+/* All nodes run in the same thread, locks are not necessary */
+#define CO_LOCK_CAN_SEND(CAN_MODULE)
+#define CO_UNLOCK_CAN_SEND(CAN_MODULE)
+
+#define CO_LOCK_EMCY(CAN_MODULE)
+#define CO_UNLOCK_EMCY(CAN_MODULE)
+
+#define CO_LOCK_OD(CAN_MODULE)
+#define CO_UNLOCK_OD(CAN_MODULE)
+
+/* Synchronization between CAN receive and message processing threads. */
+#define CO_MemoryBarrier()
+#define CO_FLAG_READ(rxNew) ((rxNew) != NULL)
+#define CO_FLAG_SET(rxNew) {CO_MemoryBarrier(); rxNew = (void*)1L;}
+#define CO_FLAG_CLEAR(rxNew) {CO_MemoryBarrier(); rxNew = NULL;}
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* CO_DRIVER_TARGET_H */
@@ -0,0 +1,167 @@
+/**
+ * Simulated CAN bus for many CANopenNode devices in one process.
+ *
+ * @file        CO_simBus.h
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_SIM_BUS_H
+#define CO_SIM_BUS_H
+
+#include "301/CO_driver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_simulation Simulation
+ * Many CANopen devices in one process on the simulated CAN bus.
+ *
+ * @ingroup CO_driver
+ * @{
+ *
+ * Simulated CAN bus connects CAN modules of all CANopen devices in the
+ * process. Pointer to CO_simBus_t is used as CANptr argument of CO_CANinit().
+ *
+ * CO_CANsend() only queues the message in the transmit buffer of the CAN
+ * module. CO_simBus_process() advances the bus time: it arbitrates between
+ * pending messages of all modules (lowest CAN-ID with RTR bit wins, one
+ * candidate per module, the same as CAN controller with priority based
+ * transmission), transmits the winner for the exact number of bits of the
+ * classical base frame, including CRC and stuff bits, and delivers it to all
+ * other modules in normal mode. Identical frames, pending in many modules,
+ * are transmitted simultaneously, as on the real bus. Received messages are processed by callbacks,
+ * as from CAN interrupt. Transmit latency of each message, from
+ * CO_CANsend() to the end of the frame, is collected in the CAN module.
+ *
+ * Bus has no errors and no error frames, every frame is acknowledged.
+ *
+ * Usage:
+ * - CO_simBus_init(), then pass the bus to CO_CANinit() of each device.
+ * - In the loop process all devices for the time step, then call
+ *   CO_simBus_process() with the same time step.
+ */
+
+/** Maximum number of CAN modules on the bus */
+#ifndef CO_SIM_BUS_MODULES
+#define CO_SIM_BUS_MODULES 128
+#endif
+
+/** Window for peak bus load, in nanoseconds */
+#ifndef CO_SIM_BUS_WINDOW_NS
+#define CO_SIM_BUS_WINDOW_NS 100000000ULL
+#endif
+
+/**
+ * Simulated CAN bus object.
+ */
+typedef struct CO_simBus_t {
+    /** CAN modules, attached by CO_CANmodule_init() */
+    CO_CANmodule_t *modules[CO_SIM_BUS_MODULES];
+    /** Number of attached CAN modules */
+    uint16_t modulesCount;
+    /** Duration of one bit */
+    uint32_t bitTime_ns;
+    /** Current bus time, also inside callbacks of received messages */
+    uint64_t time_ns;
+    /** True, if frame is on the bus */
+    bool_t busy;
+    /** Copy of the frame on the bus */
+    CO_CANtx_t frame;
+    /** CAN modules, which transmit the frame. There are more, if they send
+     * identical frame at the same time. */
+    CO_CANmodule_t *frameSenders[CO_SIM_BUS_MODULES];
+    /** Time, when frame was queued in each of frameSenders */
+    uint64_t frameQueued_ns[CO_SIM_BUS_MODULES];
+    /** Number of frameSenders */
+    uint16_t frameSendersCount;
+    /** Bus time at the end of the frame, including interframe space */
+    uint64_t frameEnd_ns;
+    /** Time, when bus was busy */
+    uint64_t busy_ns;
+    /** Number of transmitted frames */
+    uint32_t frames;
+    /** Number of transmitted bits, including stuff bits */
+    uint64_t bits;
+    /** Number of stuff bits */
+    uint64_t stuffBits;
+    /** Number of arbitrations lost, summed over all modules */
+    uint32_t arbitrationLost;
+    /** Start of the current window for peak bus load */
+    uint64_t windowStart_ns;
+    /** Time, when bus was busy in the current window */
+    uint64_t windowBusy_ns;
+    /** Peak bus load in any window, in per mille */
+    uint16_t loadPeak;
+} CO_simBus_t;
+
+
+/**
+ * Initialize simulated bus.
+ *
+ * @param bus This object will be initialized.
+ * @param bitRate_kbps CAN bit rate.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_simBus_init(CO_simBus_t *bus, uint16_t bitRate_kbps);
+
+
+/**
+ * Advance simulated bus time.
+ *
+ * Frames, which end inside the time interval, are delivered to receivers.
+ * Function must be called after all CANopen devices were processed for the
+ * same time interval.
+ *
+ * @param bus This object.
+ * @param timeDifference_us Time difference from previous function call in
+ * [microseconds].
+ */
+void CO_simBus_process(CO_simBus_t *bus, uint32_t timeDifference_us);
+
+
+/**
+ * Get average bus load since CO_simBus_init().
+ *
+ * @param bus This object.
+ *
+ * @return Bus load in per mille.
+ */
+uint16_t CO_simBus_getLoad(CO_simBus_t *bus);
+
+
+/**
+ * Get index of the latency histogram bucket.
+ *
+ * @param latency_ns Latency in nanoseconds.
+ *
+ * @return Index from 0 to CO_SIM_LATENCY_HIST_SIZE-1.
+ */
+uint8_t CO_simBus_latencyBucket(uint64_t latency_ns);
+
+/** @} */ /* CO_simulation */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* CO_SIM_BUS_H */
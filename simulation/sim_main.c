@@ -0,0 +1,592 @@
+/*
+ * CANopen network simulation: many CANopen devices on the simulated CAN bus.
+ *
+ * @file        sim_main.c
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <unistd.h>
+
+#define OD_DEFINITION
+#include "301/CO_ODinterface.h"
+#include "CANopen.h"
+#include "OD.h"
+#include "CO_simBus.h"
+
+#ifndef CO_MULTIPLE_OD
+#error Simulation requires CO_MULTIPLE_OD, each node has own Object Dictionary.
+#endif
+
+
+#define log_printf(macropar_message, ...) \
+        printf(macropar_message, ##__VA_ARGS__)
+
+
+/* default values for CO_CANopenInit() */
+#define NMT_CONTROL \
+            CO_NMT_STARTUP_TO_OPERATIONAL \
+          | CO_NMT_ERR_ON_ERR_REG \
+          | CO_ERR_REG_GENERIC_ERR \
+          | CO_ERR_REG_COMMUNICATION
+#define FIRST_HB_TIME 500
+#define SDO_SRV_TIMEOUT_TIME 1000
+#define SDO_CLI_TIMEOUT_TIME 500
+#define SDO_CLI_BLOCK false
+
+/* Network configuration, written into OD of each node */
+#define HB_PRODUCER_TIME_MS 100
+#define HB_CONSUMER_TIME_MS 250
+#define LSS_TIMEOUT_MS 10
+
+/* Default simulation parameters, may be changed by program arguments */
+#define DEFAULT_NODES 32
+#define DEFAULT_BITRATE_KBPS 500
+#define DEFAULT_DURATION_MS 2000
+#define DEFAULT_SYNC_PERIOD_US 10000
+#define DEFAULT_STEP_US 100
+
+
+/* One simulated CANopen device with own copy of the Object Dictionary */
+typedef struct {
+    CO_t *co;
+    CO_config_t config;
+    /* Object Dictionary, cloned from OD.c, pointing to own data below */
+    OD_t od;
+    OD_entry_t *odList;
+    OD_PERSIST_COMM_t persist;
+    OD_RAM_t ram;
+    /* Larger array for OD object 0x1016 on the first node */
+    uint8_t hbConsCount;
+    uint32_t hbCons[127];
+    uint8_t pendingNodeId;
+    uint8_t activeNodeId;
+    uint16_t pendingBitRate;
+    uint32_t commResets;
+} simNode_t;
+
+
+/* Return pointer into own copy of OD data, if data is inside OD.c groups */
+static void *odRelocate(simNode_t *node, void *data) {
+    uintptr_t p = (uintptr_t)data;
+    uintptr_t persist = (uintptr_t)&OD_PERSIST_COMM;
+    uintptr_t ram = (uintptr_t)&OD_RAM;
+
+    if (p >= persist && p < persist + sizeof(OD_PERSIST_COMM)) {
+        return (uint8_t *)&node->persist + (p - persist);
+    }
+    if (p >= ram && p < ram + sizeof(OD_RAM)) {
+        return (uint8_t *)&node->ram + (p - ram);
+    }
+    /* constant data may be shared */
+    return data;
+}
+
+
+/* Copy Object Dictionary from OD.c into the node. OD entries, OD objects and
+ * OD variables are copied, extensions are not, they are set by CANopen
+ * objects of the node at initialization. */
+static bool_t odClone(simNode_t *node) {
+    uint16_t size = OD->size;
+
+    node->odList = calloc(size + 1U, sizeof(OD_entry_t));
+    if (node->odList == NULL) {
+        return false;
+    }
+    memcpy(&node->persist, &OD_PERSIST_COMM, sizeof(node->persist));
+    memcpy(&node->ram, &OD_RAM, sizeof(node->ram));
+
+    for (uint16_t i = 0; i < size; i++) {
+        const OD_entry_t *src = &OD->list[i];
+        OD_entry_t *dst = &node->odList[i];
+
+        *dst = *src;
+        dst->odObject = NULL;
+        dst->extension = NULL;
+
+        switch (src->odObjectType & ODT_TYPE_MASK) {
+        case ODT_VAR: {
+            OD_obj_var_t *obj = malloc(sizeof(OD_obj_var_t));
+            if (obj == NULL) return false;
+            *obj = *(const OD_obj_var_t *)src->odObject;
+            obj->dataOrig = odRelocate(node, obj->dataOrig);
+            dst->odObject = obj;
+            break;
+        }
+        case ODT_ARR: {
+            OD_obj_array_t *obj = malloc(sizeof(OD_obj_array_t));
+            if (obj == NULL) return false;
+            *obj = *(const OD_obj_array_t *)src->odObject;
+            obj->dataOrig0 = odRelocate(node, obj->dataOrig0);
+            obj->dataOrig = odRelocate(node, obj->dataOrig);
+            dst->odObject = obj;
+            break;
+        }
+        case ODT_REC: {
+            size_t len = src->subEntriesCount * sizeof(OD_obj_record_t);
+            OD_obj_record_t *obj = malloc(len);
+            if (obj == NULL) return false;
+            memcpy(obj, src->odObject, len);
+            for (uint8_t sub = 0; sub < src->subEntriesCount; sub++) {
+                obj[sub].dataOrig = odRelocate(node, obj[sub].dataOrig);
+            }
+            dst->odObject = obj;
+            break;
+        }
+        default:
+            /* compact OD objects are not supported */
+            return false;
+        }
+    }
+
+    memset(&node->od, 0, sizeof(node->od));
+    node->od.size = size;
+    node->od.list = node->odList;
+    return true;
+}
+
+
+/* Free memory, allocated by odClone() */
+static void odFree(simNode_t *node) {
+    if (node->odList == NULL) {
+        return;
+    }
+    for (uint16_t i = 0; i < OD->size; i++) {
+        free((void *)node->odList[i].odObject);
+    }
+    free(node->odList);
+    node->odList = NULL;
+}
+
+
+/* Replace OD object 0x1016 with larger array, so heartbeats of all nodes can
+ * be consumed. Example OD has only OD_CNT_ARR_1016 entries. */
+static void odExtendHBconsumer(simNode_t *node, uint8_t nodesCount) {
+    OD_entry_t *entry = OD_find(&node->od, 0x1016);
+    OD_obj_array_t *obj = (OD_obj_array_t *)entry->odObject;
+
+    node->hbConsCount = nodesCount - 1U;
+    for (uint8_t i = 0; i < node->hbConsCount; i++) {
+        uint8_t nodeId = i + 2U;
+        node->hbCons[i] = ((uint32_t)nodeId << 16) | HB_CONSUMER_TIME_MS;
+    }
+    obj->dataOrig0 = &node->hbConsCount;
+    obj->dataOrig = node->hbCons;
+    entry->subEntriesCount = node->hbConsCount + 1U;
+}
+
+
+/* Set CO_config_t from Object Dictionary of the node */
+static void nodeConfig(simNode_t *node, bool_t first, bool_t lss) {
+    CO_config_t *c = &node->config;
+    OD_t *od = &node->od;
+
+    /* counts from OD.h, entries from own OD */
+    OD_INIT_CONFIG(*c);
+    c->ENTRY_H1017 = OD_find(od, 0x1017);
+    c->ENTRY_H1016 = OD_find(od, 0x1016);
+    c->ENTRY_H1001 = OD_find(od, 0x1001);
+    c->ENTRY_H1014 = OD_find(od, 0x1014);
+    c->ENTRY_H1015 = OD_find(od, 0x1015);
+    c->ENTRY_H1003 = OD_find(od, 0x1003);
+    c->ENTRY_H1200 = OD_find(od, 0x1200);
+    c->ENTRY_H1280 = OD_find(od, 0x1280);
+    c->ENTRY_H1012 = OD_find(od, 0x1012);
+    c->ENTRY_H1005 = OD_find(od, 0x1005);
+    c->ENTRY_H1006 = OD_find(od, 0x1006);
+    c->ENTRY_H1007 = OD_find(od, 0x1007);
+    c->ENTRY_H1019 = OD_find(od, 0x1019);
+    c->ENTRY_H1400 = OD_find(od, 0x1400);
+    c->ENTRY_H1600 = OD_find(od, 0x1600);
+    c->ENTRY_H1800 = OD_find(od, 0x1800);
+    c->ENTRY_H1A00 = OD_find(od, 0x1A00);
+
+    /* only the first node consumes heartbeats and may be LSS master */
+    c->CNT_HB_CONS = first ? 1 : 0;
+    c->CNT_ARR_1016 = first ? node->hbConsCount : 0;
+    c->CNT_LSS_SLV = 1;
+    c->CNT_LSS_MST = (first && lss) ? 1 : 0;
+}
+
+
+/* Create the node, write network configuration into its OD */
+static bool_t nodeCreate(simNode_t *node, uint8_t idx, uint8_t nodesCount,
+                         uint32_t syncPeriod_us, bool_t lss,
+                         uint16_t bitRate)
+{
+    bool_t first = idx == 0;
+    uint32_t heapMemoryUsed = 0;
+
+    if (!odClone(node)) {
+        return false;
+    }
+
+    /* all nodes produce heartbeat and synchronous TPDO with error register */
+    node->persist.x1017_producerHeartbeatTime = HB_PRODUCER_TIME_MS;
+    node->persist.x1018_identity.serialNumber = (uint32_t)idx + 1U;
+    node->persist.x1800_TPDOCommunicationParameter.COB_IDUsedByTPDO = 0x40000180;
+    node->persist.x1800_TPDOCommunicationParameter.transmissionType = 1;
+    node->persist.x1A00_TPDOMappingParameter.numberOfMappedApplicationObjectsInPDO = 1;
+    node->persist.x1A00_TPDOMappingParameter.applicationObject1 = 0x10010008;
+
+    if (first) {
+        /* SYNC producer and heartbeat consumer of all other nodes */
+        node->persist.x1005_COB_ID_SYNCMessage = 0x40000080;
+        node->persist.x1006_communicationCyclePeriod = syncPeriod_us;
+        odExtendHBconsumer(node, nodesCount);
+    }
+
+    nodeConfig(node, first, lss);
+    node->co = CO_new(&node->config, &heapMemoryUsed);
+    if (node->co == NULL) {
+        return false;
+    }
+
+    node->pendingNodeId = (lss && !first) ? CO_LSS_NODE_ID_ASSIGNMENT
+                                         : (uint8_t)(idx + 1U);
+    node->pendingBitRate = bitRate;
+    return true;
+}
+
+
+/* CANopen communication reset of the node */
+static CO_ReturnError_t nodeCommReset(simNode_t *node, CO_simBus_t *bus) {
+    CO_t *co = node->co;
+    CO_ReturnError_t err;
+    uint32_t errInfo = 0;
+
+    CO_CANsetConfigurationMode((void *)bus);
+    CO_CANmodule_disable(co->CANmodule);
+
+    err = CO_CANinit(co, (void *)bus, node->pendingBitRate);
+    if (err != CO_ERROR_NO) {
+        return err;
+    }
+
+    CO_LSS_address_t lssAddress = {.identity = {
+        .vendorID = node->persist.x1018_identity.vendor_ID,
+        .productCode = node->persist.x1018_identity.productCode,
+        .revisionNumber = node->persist.x1018_identity.revisionNumber,
+        .serialNumber = node->persist.x1018_identity.serialNumber
+    }};
+    err = CO_LSSinit(co, &lssAddress,
+                     &node->pendingNodeId, &node->pendingBitRate);
+    if (err != CO_ERROR_NO) {
+        return err;
+    }
+
+    node->activeNodeId = node->pendingNodeId;
+    err = CO_CANopenInit(co, NULL, NULL, &node->od, NULL, NMT_CONTROL,
+                         FIRST_HB_TIME, SDO_SRV_TIMEOUT_TIME,
+                         SDO_CLI_TIMEOUT_TIME, SDO_CLI_BLOCK,
+                         node->activeNodeId, &errInfo);
+    if (err != CO_ERROR_NO && err != CO_ERROR_NODE_ID_UNCONFIGURED_LSS) {
+        if (err == CO_ERROR_OD_PARAMETERS) {
+            log_printf("Error: Object Dictionary entry 0x%"PRIX32"\n", errInfo);
+        }
+        return err;
+    }
+
+    if (!co->nodeIdUnconfigured) {
+        err = CO_CANopenInitPDO(co, co->em, &node->od, node->activeNodeId,
+                                &errInfo);
+        if (err != CO_ERROR_NO) {
+            if (err == CO_ERROR_OD_PARAMETERS) {
+                log_printf("Error: Object Dictionary entry 0x%"PRIX32"\n",
+                           errInfo);
+            }
+            return err;
+        }
+    }
+
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER
+    if (node->config.CNT_LSS_MST == 1) {
+        CO_LSSmaster_changeTimeout(co->LSSmaster, LSS_TIMEOUT_MS);
+    }
+#endif
+
+    CO_CANsetNormalMode(co->CANmodule);
+    node->commResets++;
+    return CO_ERROR_NO;
+}
+
+
+/* Process the node for one time step */
+static CO_ReturnError_t nodeProcess(simNode_t *node, CO_simBus_t *bus,
+                                    uint32_t timeDifference_us)
+{
+    CO_t *co = node->co;
+    CO_NMT_reset_cmd_t reset;
+
+    reset = CO_process(co, false, timeDifference_us, NULL);
+    if (reset != CO_RESET_NOT) {
+        /* application reset is simulated as communication reset */
+        return nodeCommReset(node, bus);
+    }
+
+    if (!co->nodeIdUnconfigured) {
+        bool_t syncWas = false;
+
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_ENABLE
+        syncWas = CO_process_SYNC(co, timeDifference_us, NULL);
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+        CO_process_RPDO(co, syncWas, timeDifference_us, NULL);
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+        CO_process_TPDO(co, syncWas, timeDifference_us, NULL);
+#endif
+        (void)syncWas;
+    }
+    return CO_ERROR_NO;
+}
+
+
+/* Print bus statistics and transmit latency of each node */
+static void report(CO_simBus_t *bus, simNode_t *nodes, uint8_t nodesCount,
+                   bool_t quiet)
+{
+    uint32_t histTotal[CO_SIM_LATENCY_HIST_SIZE] = {0};
+    uint64_t sumTotal = 0;
+    uint64_t maxTotal = 0;
+    uint32_t txTotal = 0;
+    uint16_t load = CO_simBus_getLoad(bus);
+
+    log_printf("\nBus: %"PRIu64" ms, %"PRIu32" frames, %"PRIu64" bits "
+               "(%"PRIu64" stuff bits), %"PRIu32" arbitrations lost\n",
+               bus->time_ns / 1000000U, bus->frames, bus->bits,
+               bus->stuffBits, bus->arbitrationLost);
+    log_printf("Bus load: average %u.%u %%, peak %u.%u %% in %"PRIu64" ms "
+               "window\n", load / 10, load % 10,
+               bus->loadPeak / 10, bus->loadPeak % 10,
+               (uint64_t)CO_SIM_BUS_WINDOW_NS / 1000000U);
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+    if (nodesCount > 0) {
+        /* the same statistics, as estimated by the driver of node 1 */
+        CO_CANtraffic_t *t = &nodes[0].co->CANmodule->traffic;
+        log_printf("Node 1 traffic: rx %"PRIu32", tx %"PRIu32", load %u.%u "
+                   "%%, peak %u.%u %% in %u ms window, tx queue max %u\n",
+                   t->rxFrames, t->txFrames, t->load / 10, t->load % 10,
+                   t->loadPeak / 10, t->loadPeak % 10,
+                   CO_CONFIG_DRIVER_TRAFFIC_WINDOW_MS, t->txCountMax);
+    }
+#endif
+
+    log_printf("\nTransmit latency histogram, bucket n: 2^n..2^(n+1)-1 us\n");
+    log_printf("node   tx    rx        avg_us  max_us  histogram\n");
+    for (uint8_t i = 0; i < nodesCount; i++) {
+        CO_CANmodule_t *CANmodule = nodes[i].co->CANmodule;
+        uint32_t tx = CANmodule->txFrames;
+
+        txTotal += tx;
+        sumTotal += CANmodule->latencySum_ns;
+        if (CANmodule->latencyMax_ns > maxTotal) {
+            maxTotal = CANmodule->latencyMax_ns;
+        }
+        for (uint8_t b = 0; b < CO_SIM_LATENCY_HIST_SIZE; b++) {
+            histTotal[b] += CANmodule->latencyHist[b];
+        }
+        if (quiet) {
+            continue;
+        }
+        log_printf("%3u %6"PRIu32" %6"PRIu32" %10"PRIu64" %7"PRIu64" ",
+                   nodes[i].activeNodeId, tx, CANmodule->rxFrames,
+                   tx > 0 ? CANmodule->latencySum_ns / tx / 1000U : 0,
+                   CANmodule->latencyMax_ns / 1000U);
+        for (uint8_t b = 0; b < CO_SIM_LATENCY_HIST_SIZE; b++) {
+            log_printf(" %"PRIu32, CANmodule->latencyHist[b]);
+        }
+        log_printf("\n");
+    }
+    log_printf("all %6"PRIu32"        %10"PRIu64" %7"PRIu64" ", txTotal,
+               txTotal > 0 ? sumTotal / txTotal / 1000U : 0,
+               maxTotal / 1000U);
+    for (uint8_t b = 0; b < CO_SIM_LATENCY_HIST_SIZE; b++) {
+        log_printf(" %"PRIu32, histTotal[b]);
+    }
+    log_printf("\n");
+}
+
+
+static void usage(const char *name) {
+    log_printf(
+"Usage: %s [options]\n"
+"Simulate CANopen network with many devices on the simulated CAN bus.\n"
+"Node 1 is SYNC producer and heartbeat consumer of all other nodes, all nodes\n"
+"produce heartbeat and synchronous TPDO.\n"
+"  -n <nodes>    Number of nodes, 2 to 127 (default %d).\n"
+"  -b <kbps>     CAN bit rate in kbit/s (default %d).\n"
+"  -t <ms>       Duration of the simulation (default %d).\n"
+"  -s <us>       SYNC period, 0 disables SYNC (default %d).\n"
+"  -d <us>       Time step of the simulation (default %d).\n"
+"  -l            Nodes 2..n start unconfigured, node 1 assigns node-IDs\n"
+"                with LSS fastscan.\n"
+"  -q            Print only totals, not statistics of each node.\n",
+        name, DEFAULT_NODES, DEFAULT_BITRATE_KBPS, DEFAULT_DURATION_MS,
+        DEFAULT_SYNC_PERIOD_US, DEFAULT_STEP_US);
+}
+
+
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI
+/* Called by LSS master after node-ID is assigned */
+static void lssAssigned(void *object, uint8_t nodeId,
+                        const CO_LSS_address_t *lssAddress)
+{
+    CO_simBus_t *bus = (CO_simBus_t *)object;
+    log_printf("%8"PRIu64" us: LSS node-ID %u assigned to serial %"PRIu32"\n",
+               bus->time_ns / 1000U, nodeId,
+               lssAddress->identity.serialNumber);
+}
+#endif
+
+
+/* main ***********************************************************************/
+int main (int argc, char *argv[]){
+    CO_simBus_t bus;
+    simNode_t *nodes;
+    unsigned long nodesCount = DEFAULT_NODES;
+    unsigned long bitRate = DEFAULT_BITRATE_KBPS;
+    unsigned long duration_ms = DEFAULT_DURATION_MS;
+    unsigned long syncPeriod_us = DEFAULT_SYNC_PERIOD_US;
+    unsigned long step_us = DEFAULT_STEP_US;
+    bool_t lss = false;
+    bool_t quiet = false;
+    int ret = EXIT_SUCCESS;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:b:t:s:d:lqh")) != -1) {
+        switch (opt) {
+            case 'n': nodesCount = strtoul(optarg, NULL, 0); break;
+            case 'b': bitRate = strtoul(optarg, NULL, 0); break;
+            case 't': duration_ms = strtoul(optarg, NULL, 0); break;
+            case 's': syncPeriod_us = strtoul(optarg, NULL, 0); break;
+            case 'd': step_us = strtoul(optarg, NULL, 0); break;
+            case 'l': lss = true; break;
+            case 'q': quiet = true; break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+    if (nodesCount < 2 || nodesCount > 127 || step_us == 0
+        || syncPeriod_us > UINT32_MAX || step_us > UINT32_MAX
+        || CO_simBus_init(&bus, (uint16_t)bitRate) != CO_ERROR_NO
+    ) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+#if !((CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI)
+    if (lss) {
+        log_printf("Error: LSS fastscan is not enabled in CO_CONFIG_LSS\n");
+        return EXIT_FAILURE;
+    }
+#endif
+
+    nodes = calloc(nodesCount, sizeof(simNode_t));
+    if (nodes == NULL) {
+        log_printf("Error: Can't allocate memory\n");
+        return EXIT_FAILURE;
+    }
+
+    log_printf("CANopenNode simulation: %lu nodes, %lu kbit/s, SYNC %lu us, "
+               "step %lu us%s\n", nodesCount, bitRate, syncPeriod_us, step_us,
+               lss ? ", LSS fastscan" : "");
+
+    for (uint8_t i = 0; i < nodesCount; i++) {
+        if (!nodeCreate(&nodes[i], i, (uint8_t)nodesCount,
+                        (uint32_t)syncPeriod_us, lss, (uint16_t)bitRate)
+            || nodeCommReset(&nodes[i], &bus) != CO_ERROR_NO
+        ) {
+            log_printf("Error: Initialization of node %u failed\n", i + 1U);
+            nodesCount = i + 1U;
+            ret = EXIT_FAILURE;
+            break;
+        }
+    }
+
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI
+    CO_LSSmaster_assign_t assign;
+    bool_t assignActive = lss;
+    uint32_t assignDt_us = 0;
+
+    memset(&assign, 0, sizeof(assign));
+    assign.fastscan.scan[CO_LSS_FASTSCAN_VENDOR_ID] = CO_LSSmaster_FS_MATCH;
+    assign.fastscan.scan[CO_LSS_FASTSCAN_PRODUCT] = CO_LSSmaster_FS_MATCH;
+    assign.fastscan.scan[CO_LSS_FASTSCAN_REV] = CO_LSSmaster_FS_MATCH;
+    assign.fastscan.scan[CO_LSS_FASTSCAN_SERIAL] = CO_LSSmaster_FS_SCAN;
+    assign.fastscan.match.identity.vendorID =
+        OD_PERSIST_COMM.x1018_identity.vendor_ID;
+    assign.fastscan.match.identity.productCode =
+        OD_PERSIST_COMM.x1018_identity.productCode;
+    assign.fastscan.match.identity.revisionNumber =
+        OD_PERSIST_COMM.x1018_identity.revisionNumber;
+    assign.nodeIdFirst = 2;
+    assign.nodeIdLast = 127;
+    assign.store = false;
+    assign.functAssigned = lssAssigned;
+    assign.object = &bus;
+#endif
+
+    for (uint64_t time_us = 0;
+         ret == EXIT_SUCCESS && time_us < (uint64_t)duration_ms * 1000U;
+         time_us += step_us
+    ) {
+/* loop for normal program execution ******************************************/
+        for (uint8_t i = 0; i < nodesCount; i++) {
+            if (nodeProcess(&nodes[i], &bus, (uint32_t)step_us) != CO_ERROR_NO) {
+                log_printf("Error: Reset of node %u failed\n", i + 1U);
+                ret = EXIT_FAILURE;
+                break;
+            }
+        }
+
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_MULTI
+        if (assignActive) {
+            CO_LSSmaster_return_t lssRet;
+            lssRet = CO_LSSmaster_AssignNodeIds(nodes[0].co->LSSmaster,
+                                                assignDt_us, &assign);
+            assignDt_us = (uint32_t)step_us;
+            if (lssRet != CO_LSSmaster_WAIT_SLAVE) {
+                log_printf("%8"PRIu64" us: LSS assignment finished (%d), "
+                           "%u nodes configured\n", bus.time_ns / 1000U,
+                           lssRet, assign.nodeCount);
+                assignActive = false;
+            }
+        }
+#endif
+
+        CO_simBus_process(&bus, (uint32_t)step_us);
+    }
+
+    report(&bus, nodes, (uint8_t)nodesCount, quiet);
+
+/* program exit ***************************************************************/
+    for (uint8_t i = 0; i < nodesCount; i++) {
+        CO_CANsetConfigurationMode((void *)&bus);
+        CO_delete(nodes[i].co);
+        odFree(&nodes[i]);
+    }
+    free(nodes);
+
+    return ret;
+}
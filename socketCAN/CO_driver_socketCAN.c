@@ -0,0 +1,680 @@
+/*
+ * CAN module object for Linux SocketCAN.
+ *
+ * @file        CO_driver_socketCAN.c
+ * @ingroup     CO_driver
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* recvmmsg(), sendmmsg() */
+#endif
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/time.h>
+#include <linux/can/raw.h>
+#include <linux/can/error.h>
+
+#include "301/CO_driver.h"
+#include "301/CO_CANrxDispatch.h"
+
+
+pthread_mutex_t CO_CAN_SEND_mutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_mutex_t CO_EMCY_mutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_mutex_t CO_OD_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* Maximum number of kernel filters, set from rxArray */
+#define CO_CAN_KERNEL_FILTERS_MAX 512
+
+
+/******************************************************************************/
+void CO_CANsetConfigurationMode(void *CANptr){
+    /* Bit rate and mode are configured outside, with "ip link" command */
+    (void)CANptr;
+}
+
+
+/******************************************************************************/
+void CO_CANsetNormalMode(CO_CANmodule_t *CANmodule){
+    if(CANmodule == NULL || !CANmodule->fdOpen){
+        return;
+    }
+
+    /* Set kernel filters from configured rxArray, so only CANopen messages,
+     * which are used by this node, wake up the process. */
+    if(CANmodule->rxSize <= CO_CAN_KERNEL_FILTERS_MAX){
+        struct can_filter filters[CO_CAN_KERNEL_FILTERS_MAX];
+        int count = 0;
+        uint16_t i;
+
+        for(i = 0U; i < CANmodule->rxSize; i++){
+            CO_CANrx_t *buffer = &CANmodule->rxArray[i];
+            if(buffer->CANrx_callback == NULL){
+                continue;
+            }
+            filters[count].can_id = buffer->ident & 0x07FFU;
+            if((buffer->ident & 0x0800U) != 0U){
+                filters[count].can_id |= CAN_RTR_FLAG;
+            }
+            filters[count].can_mask = (buffer->mask & 0x07FFU)
+                                    | CAN_EFF_FLAG | CAN_RTR_FLAG;
+            count++;
+        }
+        setsockopt(CANmodule->fd, SOL_CAN_RAW, CAN_RAW_FILTER,
+                   filters, sizeof(filters[0]) * (size_t)count);
+    }
+    else{
+        /* Too many entries for kernel filters, accept all messages, software
+         * match in CO_CANrxMessage() drops the unused ones. */
+        struct can_filter filter;
+
+        filter.can_id = 0U;
+        filter.can_mask = 0U;
+        setsockopt(CANmodule->fd, SOL_CAN_RAW, CAN_RAW_FILTER,
+                   &filter, sizeof(filter));
+    }
+
+    CANmodule->CANnormal = true;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANmodule_init(
+        CO_CANmodule_t         *CANmodule,
+        void                   *CANptr,
+        CO_CANrx_t              rxArray[],
+        uint16_t                rxSize,
+        CO_CANtx_t              txArray[],
+        uint16_t                txSize,
+        uint16_t                CANbitRate)
+{
+    CO_CANptrSocketCan_t *CANptrReal = (CO_CANptrSocketCan_t *)CANptr;
+    struct sockaddr_can sockAddr;
+    int opt;
+    uint16_t i;
+
+    /* verify arguments */
+    if(CANmodule==NULL || CANptr==NULL || rxArray==NULL || txArray==NULL){
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* communication reset may initialize the module again */
+    CO_CANmodule_disable(CANmodule);
+
+    /* Configure object variables */
+    CANmodule->CANptr = CANptr;
+    CANmodule->rxArray = rxArray;
+    CANmodule->rxSize = rxSize;
+    CANmodule->txArray = txArray;
+    CANmodule->txSize = txSize;
+    CANmodule->CANerrorStatus = 0;
+    CANmodule->CANnormal = false;
+    /* kernel filters do not tell the rxArray index */
+    CANmodule->useCANrxFilters = false;
+    CANmodule->bufferInhibitFlag = false;
+    CANmodule->firstCANtxMessage = true;
+    CANmodule->CANtxCount = 0U;
+    CANmodule->epoll_fd = CANptrReal->epoll_fd;
+    CANmodule->rxDropCount = 0U;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+    CO_CANtraffic_init(&CANmodule->traffic, CANbitRate);
+#else
+    (void)CANbitRate;
+#endif
+
+    for(i=0U; i<rxSize; i++){
+        rxArray[i].ident = 0U;
+        rxArray[i].mask = 0xFFFFU;
+        rxArray[i].object = NULL;
+        rxArray[i].CANrx_callback = NULL;
+    }
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_DISPATCH
+    CO_CANrxDispatch_init(CANmodule);
+#endif
+    for(i=0U; i<txSize; i++){
+        txArray[i].bufferFull = false;
+    }
+
+    /* Create and bind raw CAN socket */
+    CANmodule->fd = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK, CAN_RAW);
+    if(CANmodule->fd < 0){
+        return CO_ERROR_SYSCALL;
+    }
+    CANmodule->fdOpen = true;
+
+    /* kernel reception time and number of dropped messages */
+    opt = 1;
+    setsockopt(CANmodule->fd, SOL_SOCKET, SO_TIMESTAMP, &opt, sizeof(opt));
+    opt = 1;
+    setsockopt(CANmodule->fd, SOL_SOCKET, SO_RXQ_OVFL, &opt, sizeof(opt));
+
+    /* error frames for CANerrorStatus */
+    can_err_mask_t errMask = CAN_ERR_CRTL | CAN_ERR_BUSOFF | CAN_ERR_RESTARTED;
+    setsockopt(CANmodule->fd, SOL_CAN_RAW, CAN_RAW_ERR_FILTER,
+               &errMask, sizeof(errMask));
+
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD
+    opt = 1;
+    if(setsockopt(CANmodule->fd, SOL_CAN_RAW, CAN_RAW_FD_FRAMES,
+                  &opt, sizeof(opt)) < 0
+    ){
+        CO_CANmodule_disable(CANmodule);
+        return CO_ERROR_SYSCALL;
+    }
+#endif
+
+    /* no messages until CO_CANsetNormalMode() sets the kernel filters */
+    setsockopt(CANmodule->fd, SOL_CAN_RAW, CAN_RAW_FILTER, NULL, 0);
+
+    memset(&sockAddr, 0, sizeof(sockAddr));
+    sockAddr.can_family = AF_CAN;
+    sockAddr.can_ifindex = CANptrReal->can_ifindex;
+    if(bind(CANmodule->fd, (struct sockaddr *)&sockAddr, sizeof(sockAddr)) < 0){
+        CO_CANmodule_disable(CANmodule);
+        return CO_ERROR_SYSCALL;
+    }
+
+    /* Add socket to epoll, event data is this CAN module */
+    if(CANmodule->epoll_fd >= 0){
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.ptr = CANmodule;
+        if(epoll_ctl(CANmodule->epoll_fd, EPOLL_CTL_ADD,
+                     CANmodule->fd, &ev) < 0
+        ){
+            CO_CANmodule_disable(CANmodule);
+            return CO_ERROR_SYSCALL;
+        }
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_CANmodule_disable(CO_CANmodule_t *CANmodule) {
+    if (CANmodule != NULL && CANmodule->fdOpen) {
+        if (CANmodule->epoll_fd >= 0) {
+            epoll_ctl(CANmodule->epoll_fd, EPOLL_CTL_DEL, CANmodule->fd, NULL);
+        }
+        close(CANmodule->fd);
+        CANmodule->fdOpen = false;
+        CANmodule->CANnormal = false;
+        CANmodule->CANtxCount = 0U;
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANrxBufferInit(
+        CO_CANmodule_t         *CANmodule,
+        uint16_t                index,
+        uint16_t                ident,
+        uint16_t                mask,
+        bool_t                  rtr,
+        void                   *object,
+        void                  (*CANrx_callback)(void *object, void *message))
+{
+    CO_ReturnError_t ret = CO_ERROR_NO;
+
+    if((CANmodule!=NULL) && (object!=NULL) && (CANrx_callback!=NULL) && (index < CANmodule->rxSize)){
+        /* buffer, which will be configured */
+        CO_CANrx_t *buffer = &CANmodule->rxArray[index];
+
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_DISPATCH
+        CO_LOCK_CAN_SEND(CANmodule);
+        CO_CANrxDispatch_remove(CANmodule, index);
+#endif
+
+        /* Configure object variables */
+        buffer->object = object;
+        buffer->CANrx_callback = CANrx_callback;
+
+        /* CAN identifier and CAN mask, 0x0800 is RTR bit */
+        buffer->ident = ident & 0x07FFU;
+        if(rtr){
+            buffer->ident |= 0x0800U;
+        }
+        buffer->mask = (mask & 0x07FFU) | 0x0800U;
+
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_DISPATCH
+        CO_CANrxDispatch_add(CANmodule, index);
+        CO_UNLOCK_CAN_SEND(CANmodule);
+#endif
+
+        /* Kernel filters are set from rxArray by CO_CANsetNormalMode(). If
+         * buffer is changed in normal mode, update them. */
+        if(CANmodule->CANnormal){
+            CO_CANsetNormalMode(CANmodule);
+        }
+    }
+    else{
+        ret = CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    return ret;
+}
+
+
+/******************************************************************************/
+CO_CANtx_t *CO_CANtxBufferInit(
+        CO_CANmodule_t         *CANmodule,
+        uint16_t                index,
+        uint16_t                ident,
+        bool_t                  rtr,
+        uint8_t                 noOfBytes,
+        bool_t                  syncFlag)
+{
+    CO_CANtx_t *buffer = NULL;
+
+    if((CANmodule != NULL) && (index < CANmodule->txSize)){
+        /* get specific buffer */
+        buffer = &CANmodule->txArray[index];
+
+        if(noOfBytes > sizeof(buffer->data)){
+            return NULL;
+        }
+
+        /* CAN identifier and rtr bit, DLC is data length in bytes */
+        buffer->ident = ((uint32_t)ident & 0x07FFU)
+                      | (rtr ? CAN_RTR_FLAG : 0U);
+        buffer->DLC = noOfBytes;
+        buffer->bufferFull = false;
+        buffer->syncFlag = syncFlag;
+    }
+
+    return buffer;
+}
+
+
+/******************************************************************************/
+/* Send queued frames, CO_LOCK_CAN_SEND must be locked. */
+static void CO_CANflushLocked(CO_CANmodule_t *CANmodule) {
+    struct mmsghdr msgs[CO_DRIVER_TX_QUEUE_SIZE];
+    struct iovec iov[CO_DRIVER_TX_QUEUE_SIZE];
+    uint16_t count = CANmodule->CANtxCount;
+    uint16_t i;
+    int sent;
+
+    if(count == 0U || !CANmodule->fdOpen){
+        return;
+    }
+
+    memset(msgs, 0, sizeof(msgs[0]) * count);
+    for(i = 0U; i < count; i++){
+        CO_CANframe_t *frame = &CANmodule->txFrames[i];
+        iov[i].iov_base = frame;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD
+        iov[i].iov_len = (frame->len > 8U) ? CANFD_MTU : CAN_MTU;
+#else
+        iov[i].iov_len = CAN_MTU;
+#endif
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    sent = sendmmsg(CANmodule->fd, msgs, count, MSG_DONTWAIT);
+    if(sent < 0){
+        if(errno == EAGAIN || errno == ENOBUFS){
+            /* kernel queue is full, try again later */
+            return;
+        }
+        /* other error, drop the first message */
+        sent = 1;
+    }
+    else if(sent > 0){
+        CANmodule->firstCANtxMessage = false;
+    }
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+    for(i = 0U; i < (uint16_t)sent; i++){
+        CO_CANframe_t *frame = &CANmodule->txFrames[i];
+        uint16_t ident = (uint16_t)(frame->can_id & 0x07FFU);
+        if((frame->can_id & CAN_RTR_FLAG) != 0U){
+            ident |= 0x0800U;
+        }
+ #if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD
+        CO_CANtraffic_tx(&CANmodule->traffic, ident, frame->len, frame->data);
+ #else
+        CO_CANtraffic_tx(&CANmodule->traffic, ident, frame->can_dlc,
+                         frame->data);
+ #endif
+    }
+#endif
+
+    /* move unsent frames to the beginning of the queue */
+    count -= (uint16_t)sent;
+    if(count > 0U){
+        memmove(&CANmodule->txFrames[0], &CANmodule->txFrames[sent],
+                sizeof(CANmodule->txFrames[0]) * count);
+        memmove(&CANmodule->txFramesSync[0], &CANmodule->txFramesSync[sent],
+                sizeof(CANmodule->txFramesSync[0]) * count);
+    }
+    CANmodule->CANtxCount = count;
+    CANmodule->bufferInhibitFlag = false;
+    for(i = 0U; i < count; i++){
+        if(CANmodule->txFramesSync[i]){
+            CANmodule->bufferInhibitFlag = true;
+        }
+    }
+}
+
+
+/* Copy message into the transmit queue, CO_LOCK_CAN_SEND must be locked. */
+static CO_ReturnError_t CO_CANqueueLocked(CO_CANmodule_t *CANmodule,
+                                          CO_CANtx_t *buffer)
+{
+    CO_CANframe_t *frame;
+
+    if(CANmodule->CANtxCount >= CO_DRIVER_TX_QUEUE_SIZE){
+        CO_CANflushLocked(CANmodule);
+        if(CANmodule->CANtxCount >= CO_DRIVER_TX_QUEUE_SIZE){
+            if(!CANmodule->firstCANtxMessage){
+                /* don't set error, if bootup message is still on buffers */
+                CANmodule->CANerrorStatus |= CO_CAN_ERRTX_OVERFLOW;
+                CO_CAN_COUNT_TX_OVERFLOW(CANmodule, 1);
+            }
+            return CO_ERROR_TX_OVERFLOW;
+        }
+    }
+
+    frame = &CANmodule->txFrames[CANmodule->CANtxCount];
+    memset(frame, 0, sizeof(*frame));
+    frame->can_id = buffer->ident;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD
+    frame->len = buffer->DLC;
+#else
+    frame->can_dlc = buffer->DLC;
+#endif
+    memcpy(frame->data, buffer->data, buffer->DLC);
+    CANmodule->txFramesSync[CANmodule->CANtxCount] = buffer->syncFlag;
+    if(buffer->syncFlag){
+        CANmodule->bufferInhibitFlag = true;
+    }
+    CANmodule->CANtxCount++;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+    CO_CANtraffic_txQueued(&CANmodule->traffic, CANmodule->CANtxCount);
+#endif
+
+    return CO_ERROR_NO;
+}
+
+
+CO_ReturnError_t CO_CANsend(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer){
+    CO_ReturnError_t err;
+
+    CO_LOCK_CAN_SEND(CANmodule);
+    err = CO_CANqueueLocked(CANmodule, buffer);
+    CO_UNLOCK_CAN_SEND(CANmodule);
+
+    return err;
+}
+
+
+/******************************************************************************/
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_BATCH
+CO_ReturnError_t CO_CANsendBatch(CO_CANmodule_t *CANmodule,
+                                 CO_CANtx_t *buffers[],
+                                 uint16_t count)
+{
+    CO_ReturnError_t err = CO_ERROR_NO;
+    uint16_t i;
+
+    CO_LOCK_CAN_SEND(CANmodule);
+    for(i = 0U; i < count; i++){
+        if(CO_CANqueueLocked(CANmodule, buffers[i]) != CO_ERROR_NO){
+            err = CO_ERROR_TX_OVERFLOW;
+        }
+    }
+    /* batch is submitted immediately */
+    CO_CANflushLocked(CANmodule);
+    CO_UNLOCK_CAN_SEND(CANmodule);
+
+    return err;
+}
+#endif /* (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TX_BATCH */
+
+
+/******************************************************************************/
+void CO_CANflush(CO_CANmodule_t *CANmodule) {
+    if(CANmodule != NULL && CANmodule->CANtxCount > 0U){
+        CO_LOCK_CAN_SEND(CANmodule);
+        CO_CANflushLocked(CANmodule);
+        CO_UNLOCK_CAN_SEND(CANmodule);
+    }
+}
+
+
+/******************************************************************************/
+void CO_CANclearPendingSyncPDOs(CO_CANmodule_t *CANmodule){
+    uint32_t tpdoDeleted = 0U;
+
+    CO_LOCK_CAN_SEND(CANmodule);
+    /* delete pending synchronous TPDOs from the transmit queue, messages
+     * already passed to the kernel can not be aborted */
+    if(CANmodule->bufferInhibitFlag){
+        uint16_t i, j = 0U;
+        for(i = 0U; i < CANmodule->CANtxCount; i++){
+            if(CANmodule->txFramesSync[i]){
+                tpdoDeleted = 2U;
+                continue;
+            }
+            if(i != j){
+                CANmodule->txFrames[j] = CANmodule->txFrames[i];
+                CANmodule->txFramesSync[j] = false;
+            }
+            j++;
+        }
+        CANmodule->CANtxCount = j;
+        CANmodule->bufferInhibitFlag = false;
+    }
+    CO_UNLOCK_CAN_SEND(CANmodule);
+
+
+    if(tpdoDeleted != 0U){
+        CANmodule->CANerrorStatus |= CO_CAN_ERRTX_PDO_LATE;
+    }
+}
+
+
+/******************************************************************************/
+/* Find receive buffer for the received message and process it. */
+static void CO_CANrxMessage(CO_CANmodule_t *CANmodule, CO_CANrxMsg_t *rcvMsg){
+#if !((CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_DISPATCH)
+    uint16_t index;             /* index of received message */
+#endif
+    uint32_t rcvMsgIdent;       /* identifier of the received message */
+    CO_CANrx_t *buffer = NULL;  /* receive message buffer from CO_CANmodule_t object. */
+    bool_t msgMatched = false;
+
+    rcvMsgIdent = rcvMsg->ident;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_DISPATCH
+    buffer = CO_CANrxDispatch_find(CANmodule, (uint16_t)rcvMsgIdent);
+    msgMatched = buffer != NULL;
+#else
+    /* Search rxArray form CANmodule for the same CAN-ID. */
+    buffer = &CANmodule->rxArray[0];
+    for(index = CANmodule->rxSize; index > 0U; index--){
+        if(((rcvMsgIdent ^ buffer->ident) & buffer->mask) == 0U){
+            msgMatched = true;
+            break;
+        }
+        buffer++;
+    }
+#endif
+
+    /* Call specific function, which will process the message */
+    if(msgMatched && (buffer != NULL) && (buffer->CANrx_callback != NULL)){
+        buffer->CANrx_callback(buffer->object, (void*) rcvMsg);
+    }
+}
+
+
+/* Update CANerrorStatus from CAN error frame */
+static void CO_CANrxError(CO_CANmodule_t *CANmodule, CO_CANframe_t *frame){
+    uint16_t status = CANmodule->CANerrorStatus;
+
+    if((frame->can_id & CAN_ERR_BUSOFF) != 0U){
+        status |= CO_CAN_ERRTX_BUS_OFF;
+    }
+    if((frame->can_id & CAN_ERR_RESTARTED) != 0U){
+        status &= 0xFFFF ^ CO_CAN_ERRTX_BUS_OFF;
+    }
+    if((frame->can_id & CAN_ERR_CRTL) != 0U){
+        uint8_t ctrl = frame->data[1];
+
+        if(ctrl == CAN_ERR_CRTL_UNSPEC || (ctrl & 0x40U) != 0U){
+            /* error active again (CAN_ERR_CRTL_ACTIVE) */
+            status &= 0xFFFF ^ (CO_CAN_ERRRX_WARNING | CO_CAN_ERRRX_PASSIVE |
+                                CO_CAN_ERRTX_WARNING | CO_CAN_ERRTX_PASSIVE);
+        }
+        if((ctrl & (CAN_ERR_CRTL_RX_OVERFLOW | CAN_ERR_CRTL_TX_OVERFLOW)) != 0U){
+            status |= CO_CAN_ERRRX_OVERFLOW;
+            CO_CAN_COUNT_RX_OVERFLOW(CANmodule, 1);
+        }
+        if((ctrl & CAN_ERR_CRTL_RX_WARNING) != 0U){
+            status |= CO_CAN_ERRRX_WARNING;
+        }
+        if((ctrl & CAN_ERR_CRTL_RX_PASSIVE) != 0U){
+            status |= CO_CAN_ERRRX_WARNING | CO_CAN_ERRRX_PASSIVE;
+        }
+        if((ctrl & CAN_ERR_CRTL_TX_WARNING) != 0U){
+            status |= CO_CAN_ERRTX_WARNING;
+        }
+        if((ctrl & CAN_ERR_CRTL_TX_PASSIVE) != 0U){
+            status |= CO_CAN_ERRTX_WARNING | CO_CAN_ERRTX_PASSIVE;
+        }
+    }
+
+    CANmodule->CANerrorStatus = status;
+}
+
+
+/******************************************************************************/
+void CO_CANrxFromSocket(CO_CANmodule_t *CANmodule) {
+    struct mmsghdr msgs[CO_DRIVER_RX_BATCH_SIZE];
+    struct iovec iov[CO_DRIVER_RX_BATCH_SIZE];
+    CO_CANframe_t frames[CO_DRIVER_RX_BATCH_SIZE];
+    uint8_t ctrl[CO_DRIVER_RX_BATCH_SIZE][CMSG_SPACE(sizeof(struct timeval))
+                                          + CMSG_SPACE(sizeof(uint32_t))];
+    int i, n;
+
+    if(CANmodule == NULL || !CANmodule->fdOpen){
+        return;
+    }
+
+    do {
+        memset(msgs, 0, sizeof(msgs));
+        for(i = 0; i < CO_DRIVER_RX_BATCH_SIZE; i++){
+            iov[i].iov_base = &frames[i];
+            iov[i].iov_len = sizeof(frames[i]);
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_control = ctrl[i];
+            msgs[i].msg_hdr.msg_controllen = sizeof(ctrl[i]);
+        }
+
+        n = recvmmsg(CANmodule->fd, msgs, CO_DRIVER_RX_BATCH_SIZE,
+                     MSG_DONTWAIT, NULL);
+
+        for(i = 0; i < n; i++){
+            CO_CANframe_t *frame = &frames[i];
+            struct msghdr *hdr = &msgs[i].msg_hdr;
+            struct cmsghdr *cmsg;
+            CO_CANrxMsg_t rcvMsg;
+
+            rcvMsg.timestamp = 0U;
+            for(cmsg = CMSG_FIRSTHDR(hdr); cmsg != NULL;
+                cmsg = CMSG_NXTHDR(hdr, cmsg)
+            ){
+                if(cmsg->cmsg_level != SOL_SOCKET){
+                    continue;
+                }
+                if(cmsg->cmsg_type == SO_TIMESTAMP){
+                    struct timeval tv;
+                    memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+                    rcvMsg.timestamp = (uint32_t)((uint64_t)tv.tv_sec * 1000000U
+                                                  + (uint64_t)tv.tv_usec);
+                }
+                else if(cmsg->cmsg_type == SO_RXQ_OVFL){
+                    uint32_t drops;
+                    memcpy(&drops, CMSG_DATA(cmsg), sizeof(drops));
+                    if(drops != CANmodule->rxDropCount){
+                        CO_CAN_COUNT_RX_OVERFLOW(CANmodule,
+                                                 drops - CANmodule->rxDropCount);
+                        CANmodule->rxDropCount = drops;
+                        CANmodule->CANerrorStatus |= CO_CAN_ERRRX_OVERFLOW;
+                    }
+                }
+            }
+
+            if((frame->can_id & CAN_ERR_FLAG) != 0U){
+                CO_CANrxError(CANmodule, frame);
+                continue;
+            }
+            if((frame->can_id & CAN_EFF_FLAG) != 0U){
+                /* extended identifiers are not used by CANopen */
+                continue;
+            }
+
+            rcvMsg.ident = frame->can_id & 0x07FFU;
+            if((frame->can_id & CAN_RTR_FLAG) != 0U){
+                rcvMsg.ident |= 0x0800U;
+            }
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD
+            rcvMsg.DLC = frame->len;
+#else
+            rcvMsg.DLC = frame->can_dlc;
+#endif
+            if(rcvMsg.DLC > sizeof(rcvMsg.data)){
+                rcvMsg.DLC = sizeof(rcvMsg.data);
+            }
+            memcpy(rcvMsg.data, frame->data, sizeof(rcvMsg.data));
+
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+            /* may run in other thread than CO_CANsend() */
+            CO_LOCK_CAN_SEND(CANmodule);
+            CO_CANtraffic_rx(&CANmodule->traffic, (uint16_t)rcvMsg.ident,
+                             rcvMsg.DLC, rcvMsg.data);
+            CO_UNLOCK_CAN_SEND(CANmodule);
+#endif
+            CO_CANrxMessage(CANmodule, &rcvMsg);
+        }
+    } while(n == CO_DRIVER_RX_BATCH_SIZE);
+}
+
+
+/******************************************************************************/
+void CO_CANmodule_process(CO_CANmodule_t *CANmodule) {
+    /* CANerrorStatus is updated from error frames in CO_CANrxFromSocket(),
+     * send messages left from previous cycle */
+    CO_CANflush(CANmodule);
+
+    /* if not tx passive clear also overflow */
+    if (CANmodule->CANtxCount == 0U
+        && (CANmodule->CANerrorStatus & CO_CAN_ERRTX_PASSIVE) == 0
+    ) {
+        CANmodule->CANerrorStatus &= 0xFFFF ^ CO_CAN_ERRTX_OVERFLOW;
+    }
+}
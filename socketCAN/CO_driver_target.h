@@ -0,0 +1,241 @@
+/*
+ * Linux SocketCAN specific definitions for CANopenNode.
+ *
+ * @file        CO_driver_target.h
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CO_DRIVER_TARGET_H
+#define CO_DRIVER_TARGET_H
+
+/* This file contains device and application specific definitions.
+ * It is included from CO_driver.h, which contains documentation
+ * for common definitions below. */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <endian.h>
+#include <pthread.h>
+#include <linux/can.h>
+
+#ifdef CO_DRIVER_CUSTOM
+#include "CO_driver_custom.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Stack configuration override default values.
+ * For more information see file CO_config.h. */
+#ifndef CO_CONFIG_DRIVER
+#define CO_CONFIG_DRIVER (CO_CONFIG_DRIVER_RX_DISPATCH)
+#endif
+#ifndef CO_CONFIG_DRIVER_RX_MASKED_COUNT
+#define CO_CONFIG_DRIVER_RX_MASKED_COUNT 4
+#endif
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+#include "301/CO_CANtraffic.h"
+#endif
+
+/* Number of CAN messages received with single recvmmsg() call and maximum
+ * number of CAN messages queued for single sendmmsg() call, see
+ * CO_CANrxFromSocket() and CO_CANflush(). */
+#ifndef CO_DRIVER_RX_BATCH_SIZE
+#define CO_DRIVER_RX_BATCH_SIZE 16
+#endif
+#ifndef CO_DRIVER_TX_QUEUE_SIZE
+#define CO_DRIVER_TX_QUEUE_SIZE 64
+#endif
+
+
+/* Basic definitions */
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+ #define CO_LITTLE_ENDIAN
+ #define CO_SWAP_16(x) x
+ #define CO_SWAP_32(x) x
+ #define CO_SWAP_64(x) x
+#else
+ #define CO_BIG_ENDIAN
+ #include <byteswap.h>
+ #define CO_SWAP_16(x) bswap_16(x)
+ #define CO_SWAP_32(x) bswap_32(x)
+ #define CO_SWAP_64(x) bswap_64(x)
+#endif
+/* NULL is defined in stddef.h */
+/* true and false are defined in stdbool.h */
+/* int8_t to uint64_t are defined in stdint.h */
+typedef uint_fast8_t            bool_t;
+typedef float                   float32_t;
+typedef double                  float64_t;
+
+
+/* CAN frame as used by SocketCAN */
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD
+typedef struct canfd_frame CO_CANframe_t;
+#else
+typedef struct can_frame CO_CANframe_t;
+#endif
+
+/* Pointer to this structure is passed as CANptr to CO_CANinit(). */
+typedef struct {
+    /* Interface index, from if_nametoindex("can0") */
+    int can_ifindex;
+    /* Epoll file descriptor, from CO_epoll_create(). CAN socket is added to
+     * it with CO_CANmodule_t pointer as event data. */
+    int epoll_fd;
+} CO_CANptrSocketCan_t;
+
+
+/* Access to received CAN message */
+#define CO_CANrxMsg_readIdent(msg) \
+    ((uint16_t)(((CO_CANrxMsg_t *)(msg))->ident & 0x07FFU))
+#define CO_CANrxMsg_readDLC(msg)   (((CO_CANrxMsg_t *)(msg))->DLC)
+#define CO_CANrxMsg_readData(msg)  (((CO_CANrxMsg_t *)(msg))->data)
+#define CO_CANrxMsg_readTimestamp(msg) (((CO_CANrxMsg_t *)(msg))->timestamp)
+
+/* Received CAN message, DLC is data length in bytes. Timestamp is kernel
+ * reception time in microseconds (SO_TIMESTAMP). */
+typedef struct {
+    uint32_t ident;
+    uint8_t DLC;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD
+    uint8_t data[64];
+#else
+    uint8_t data[8];
+#endif
+    uint32_t timestamp;
+} CO_CANrxMsg_t;
+
+/* Received message object */
+typedef struct {
+    uint16_t ident;
+    uint16_t mask;
+    void *object;
+    void (*CANrx_callback)(void *object, void *message);
+} CO_CANrx_t;
+
+/* Transmit message object, DLC is data length in bytes */
+typedef struct {
+    uint32_t ident;
+    uint8_t DLC;
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_FD
+    uint8_t data[64];
+#else
+    uint8_t data[8];
+#endif
+    volatile bool_t bufferFull;
+    volatile bool_t syncFlag;
+} CO_CANtx_t;
+
+/* CAN module object */
+typedef struct {
+    void *CANptr;
+    CO_CANrx_t *rxArray;
+    uint16_t rxSize;
+    CO_CANtx_t *txArray;
+    uint16_t txSize;
+    uint16_t CANerrorStatus;
+    volatile bool_t CANnormal;
+    volatile bool_t useCANrxFilters;
+    volatile bool_t bufferInhibitFlag;
+    volatile bool_t firstCANtxMessage;
+    volatile uint16_t CANtxCount;
+    /* SocketCAN raw socket and epoll file descriptor from CANptr */
+    int fd;
+    int epoll_fd;
+    bool_t fdOpen;
+    /* Number of dropped messages from SO_RXQ_OVFL */
+    uint32_t rxDropCount;
+    /* Messages from CO_CANsend(), which are waiting for CO_CANflush() */
+    CO_CANframe_t txFrames[CO_DRIVER_TX_QUEUE_SIZE];
+    bool_t txFramesSync[CO_DRIVER_TX_QUEUE_SIZE];
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_RX_DISPATCH
+    uint16_t rxDispatch[0x800];
+    uint16_t rxMasked[CO_CONFIG_DRIVER_RX_MASKED_COUNT];
+    uint16_t rxMaskedCount;
+    bool_t rxMaskedOverflow;
+#endif
+#if (CO_CONFIG_DRIVER) & CO_CONFIG_DRIVER_TRAFFIC
+    /* Bit rate is taken from CO_CANinit(), it must match "ip link" setting */
+    CO_CANtraffic_t traffic;
+#endif
+#if (CO_CONFIG_STATS) & CO_CONFIG_STATS_ENABLE
+    uint32_t rxOverflowCount;
+    uint32_t txOverflowCount;
+#endif
+} CO_CANmodule_t;
+
+
+/* Data storage object for one entry */
+typedef struct {
+    void *addr;
+    size_t len;
+    uint8_t subIndexOD;
+    uint8_t attr;
+    /* Additional variables (target specific) */
+    void *addrNV;
+} CO_storage_entry_t;
+
+
+/* Mutexes are defined in CO_driver_socketCAN.c */
+extern pthread_mutex_t CO_CAN_SEND_mutex;
+extern pthread_mutex_t CO_EMCY_mutex;
+extern pthread_mutex_t CO_OD_mutex;
+
+/* (un)lock critical section in CO_CANsend() */
+#define CO_LOCK_CAN_SEND(CAN_MODULE) pthread_mutex_lock(&CO_CAN_SEND_mutex)
+#define CO_UNLOCK_CAN_SEND(CAN_MODULE) pthread_mutex_unlock(&CO_CAN_SEND_mutex)
+
+/* (un)lock critical section in CO_errorReport() or CO_errorReset() */
+#define CO_LOCK_EMCY(CAN_MODULE) pthread_mutex_lock(&CO_EMCY_mutex)
+#define CO_UNLOCK_EMCY(CAN_MODULE) pthread_mutex_unlock(&CO_EMCY_mutex)
+
+/* (un)lock critical section when accessing Object Dictionary */
+#define CO_LOCK_OD(CAN_MODULE) pthread_mutex_lock(&CO_OD_mutex)
+#define CO_UNLOCK_OD(CAN_MODULE) pthread_mutex_unlock(&CO_OD_mutex)
+
+/* Synchronization between CAN receive and message processing threads. */
+#define CO_MemoryBarrier() __sync_synchronize()
+#define CO_FLAG_READ(rxNew) ((rxNew) != NULL)
+#define CO_FLAG_SET(rxNew) {CO_MemoryBarrier(); rxNew = (void*)1L;}
+#define CO_FLAG_CLEAR(rxNew) {CO_MemoryBarrier(); rxNew = NULL;}
+
+
+/* Receive all available CAN messages from the socket and pass them to the
+ * receive callbacks. Messages are read in batches of CO_DRIVER_RX_BATCH_SIZE
+ * with recvmmsg(). Function is called from CO_epoll_wait(), when socket is
+ * readable. */
+void CO_CANrxFromSocket(CO_CANmodule_t *CANmodule);
+
+/* Send all CAN messages, queued by CO_CANsend(), with single sendmmsg() call.
+ * Function is called from CO_epoll_processMain() after processing of CANopen
+ * objects and from CO_CANmodule_process(). If kernel queue is full, remaining
+ * messages stay queued for the next call. */
+void CO_CANflush(CO_CANmodule_t *CANmodule);
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* CO_DRIVER_TARGET_H */
@@ -0,0 +1,177 @@
+/*
+ * Event loop for CANopenNode on Linux, based on epoll.
+ *
+ * @file        CO_epoll.c
+ * @ingroup     CO_socketCAN
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+#include "CO_epoll.h"
+
+/* Number of events returned by single epoll_wait() */
+#define CO_EPOLL_EVENTS 8
+
+static uint64_t CO_epoll_time_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000U + (uint64_t)ts.tv_nsec / 1000U;
+}
+
+/* Arm one-shot timer, zero interval would disarm it */
+static void CO_epoll_arm(CO_epoll_t *ep, uint32_t interval_us) {
+    struct itimerspec its;
+
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = interval_us / 1000000U;
+    its.it_value.tv_nsec = (long)(interval_us % 1000000U) * 1000L;
+    if (interval_us == 0U) {
+        its.it_value.tv_nsec = 1;
+    }
+    timerfd_settime(ep->timer_fd, 0, &its, NULL);
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_epoll_create(CO_epoll_t *ep, uint32_t timerInterval_us) {
+    struct epoll_event ev;
+
+    if (ep == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(ep, 0, sizeof(CO_epoll_t));
+    ep->timerInterval_us = timerInterval_us;
+    ep->timerNext_us = timerInterval_us;
+    ep->timer_fd = -1;
+
+    ep->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (ep->epoll_fd < 0) {
+        return CO_ERROR_SYSCALL;
+    }
+
+    ep->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (ep->timer_fd < 0) {
+        CO_epoll_close(ep);
+        return CO_ERROR_SYSCALL;
+    }
+
+    /* timer events are recognized by pointer to this object */
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = ep;
+    if (epoll_ctl(ep->epoll_fd, EPOLL_CTL_ADD, ep->timer_fd, &ev) < 0) {
+        CO_epoll_close(ep);
+        return CO_ERROR_SYSCALL;
+    }
+
+    CO_epoll_arm(ep, timerInterval_us);
+    ep->previousTime_us = CO_epoll_time_us();
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_epoll_close(CO_epoll_t *ep) {
+    if (ep == NULL) {
+        return;
+    }
+    if (ep->timer_fd >= 0) {
+        close(ep->timer_fd);
+        ep->timer_fd = -1;
+    }
+    if (ep->epoll_fd >= 0) {
+        close(ep->epoll_fd);
+        ep->epoll_fd = -1;
+    }
+}
+
+
+/******************************************************************************/
+void CO_epoll_wait(CO_epoll_t *ep) {
+    struct epoll_event ev[CO_EPOLL_EVENTS];
+    uint64_t now;
+    int i, n;
+
+    n = epoll_wait(ep->epoll_fd, ev, CO_EPOLL_EVENTS, -1);
+
+    ep->timerEvent = false;
+    for (i = 0; i < n; i++) {
+        if (ev[i].data.ptr == ep) {
+            uint64_t expirations;
+            if (read(ep->timer_fd, &expirations, sizeof(expirations)) > 0) {
+                ep->timerEvent = true;
+            }
+        }
+        else {
+            CO_CANrxFromSocket((CO_CANmodule_t *)ev[i].data.ptr);
+        }
+    }
+
+    now = CO_epoll_time_us();
+    ep->timeDifference_us = (uint32_t)(now - ep->previousTime_us);
+    ep->previousTime_us = now;
+    ep->timerNext_us = ep->timerInterval_us;
+}
+
+
+/******************************************************************************/
+CO_NMT_reset_cmd_t CO_epoll_processMain(CO_epoll_t *ep, CO_t *co) {
+    CO_NMT_reset_cmd_t reset;
+    uint32_t dt = ep->timeDifference_us;
+
+    reset = CO_process(co, false, dt, &ep->timerNext_us);
+
+    if (co->CANmodule->CANnormal) {
+        bool_t syncWas = false;
+#if (CO_CONFIG_SYNC) & CO_CONFIG_SYNC_ENABLE
+        syncWas = CO_process_SYNC(co, dt, &ep->timerNext_us);
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+        CO_process_RPDO(co, syncWas, dt, &ep->timerNext_us);
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+        CO_process_TPDO(co, syncWas, dt, &ep->timerNext_us);
+#endif
+        (void)syncWas;
+    }
+
+    /* send all messages, produced in this cycle, with single system call */
+#if CO_CONFIG_CAN_IF_COUNT > 1
+    for (uint8_t i = 0; i < CO_CONFIG_CAN_IF_COUNT; i++) {
+        if (co->CANmoduleIf[i] != NULL) {
+            CO_CANflush(co->CANmoduleIf[i]);
+        }
+    }
+#else
+    CO_CANflush(co->CANmodule);
+#endif
+
+    CO_epoll_arm(ep, ep->timerNext_us);
+
+    return reset;
+}
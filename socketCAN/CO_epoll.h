@@ -0,0 +1,128 @@
+/**
+ * Event loop for CANopenNode on Linux, based on epoll.
+ *
+ * @file        CO_epoll.h
+ * @ingroup     CO_socketCAN
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_EPOLL_H
+#define CO_EPOLL_H
+
+#include "CANopen.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_socketCAN Linux SocketCAN
+ * Reference driver and event loop for Linux SocketCAN.
+ *
+ * @ingroup CO_driver
+ * @{
+ *
+ * Whole CANopen stack runs in a single thread, which sleeps in epoll_wait()
+ * until CAN socket is readable or the timer expires. Received CAN messages
+ * are read in batches with recvmmsg() and processed directly from the
+ * CO_epoll_wait(). Messages sent by CANopen objects are queued and passed to
+ * the kernel with a single sendmmsg() call at the end of
+ * CO_epoll_processMain(). Timer is a one-shot timerfd, which is re-armed with
+ * timerNext_us, calculated by CO_process(), so no periodic wakeups are
+ * needed, when there is no traffic.
+ *
+ * Usage:
+ * - CO_epoll_create(), then set CO_CANptrSocketCan_t.epoll_fd to
+ *   CO_epoll_t.epoll_fd and pass it to CO_CANinit().
+ * - In the loop call CO_epoll_wait() and CO_epoll_processMain().
+ * - CO_epoll_close() at the end.
+ */
+
+/**
+ * Object for epoll, timerfd and time measurement.
+ */
+typedef struct {
+    /** Epoll file descriptor, CAN sockets are added by CO_CANmodule_init() */
+    int epoll_fd;
+    /** Timer file descriptor, one-shot, re-armed by CO_epoll_processMain() */
+    int timer_fd;
+    /** Maximum interval between two CO_epoll_processMain() calls */
+    uint32_t timerInterval_us;
+    /** Time difference since previous CO_epoll_wait(), calculated there */
+    uint32_t timeDifference_us;
+    /** Time to next required processing, may be lowered by application */
+    uint32_t timerNext_us;
+    /** True, if timer expired in last CO_epoll_wait() */
+    bool_t timerEvent;
+    /** Monotonic time of previous CO_epoll_wait() in microseconds */
+    uint64_t previousTime_us;
+} CO_epoll_t;
+
+/**
+ * Create epoll and timerfd.
+ *
+ * @param ep This object will be initialized.
+ * @param timerInterval_us Maximum interval between two processing calls.
+ *
+ * @return #CO_ReturnError_t CO_ERROR_NO or CO_ERROR_SYSCALL.
+ */
+CO_ReturnError_t CO_epoll_create(CO_epoll_t *ep, uint32_t timerInterval_us);
+
+/**
+ * Close epoll and timerfd.
+ *
+ * @param ep This object.
+ */
+void CO_epoll_close(CO_epoll_t *ep);
+
+/**
+ * Wait for the next event.
+ *
+ * Function blocks in epoll_wait() until CAN socket is readable or timer
+ * expires. Received CAN messages are processed by CO_CANrxFromSocket(). After
+ * the function returns, timeDifference_us is set and timerNext_us is reset to
+ * timerInterval_us.
+ *
+ * @param ep This object.
+ */
+void CO_epoll_wait(CO_epoll_t *ep);
+
+/**
+ * Process CANopen objects and send queued CAN messages.
+ *
+ * Function calls CO_process(), CO_process_SYNC(), CO_process_RPDO() and
+ * CO_process_TPDO() with timeDifference_us from CO_epoll_wait(). Then all CAN
+ * messages, queued by CO_CANsend(), are sent with CO_CANflush() and timer is
+ * re-armed with the lowest timerNext_us.
+ *
+ * @param ep This object.
+ * @param co CANopen object.
+ *
+ * @return #CO_NMT_reset_cmd_t from CO_process().
+ */
+CO_NMT_reset_cmd_t CO_epoll_processMain(CO_epoll_t *ep, CO_t *co);
+
+/** @} */ /* CO_socketCAN */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* CO_EPOLL_H */
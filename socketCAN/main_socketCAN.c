@@ -0,0 +1,264 @@
+/*
+ * CANopen main program file for Linux SocketCAN.
+ *
+ * @file        main_socketCAN.c
+ * @author      agent
+ * @copyright   2026 agent
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <net/if.h>
+
+#include "CANopen.h"
+#include "OD.h"
+#include "CO_epoll.h"
+#include "CO_storageBlank.h"
+
+
+#define log_printf(macropar_message, ...) \
+        printf(macropar_message, ##__VA_ARGS__)
+
+
+/* default values for CO_CANopenInit() */
+#define NMT_CONTROL \
+            CO_NMT_STARTUP_TO_OPERATIONAL \
+          | CO_NMT_ERR_ON_ERR_REG \
+          | CO_ERR_REG_GENERIC_ERR \
+          | CO_ERR_REG_COMMUNICATION
+#define FIRST_HB_TIME 500
+#define SDO_SRV_TIMEOUT_TIME 1000
+#define SDO_CLI_TIMEOUT_TIME 500
+#define SDO_CLI_BLOCK false
+#define OD_STATUS_BITS NULL
+
+/* Maximum interval of the main loop, if no events */
+#define MAIN_INTERVAL_US 100000
+
+
+/* Global variables and objects */
+CO_t *CO = NULL; /* CANopen object */
+static volatile sig_atomic_t endProgram = 0;
+
+static void sigHandler(int sig) {
+    (void)sig;
+    endProgram = 1;
+}
+
+
+/* main ***********************************************************************/
+int main (int argc, char *argv[]){
+    CO_ReturnError_t err;
+    CO_NMT_reset_cmd_t reset = CO_RESET_NOT;
+    uint32_t heapMemoryUsed;
+    CO_epoll_t ep;
+    CO_CANptrSocketCan_t CANptr = {0};
+    uint8_t pendingNodeId = 10; /* configurable by LSS slave */
+    uint8_t activeNodeId = 10; /* Copied from CO_pendingNodeId in the communication reset section */
+    uint16_t pendingBitRate = 125;  /* informative, bit rate is set by "ip link" */
+
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE
+    CO_storage_t storage;
+    CO_storage_entry_t storageEntries[] = {
+        {
+            .addr = &OD_PERSIST_COMM,
+            .len = sizeof(OD_PERSIST_COMM),
+            .subIndexOD = 2,
+            .attr = CO_storage_cmd | CO_storage_restore,
+            .addrNV = NULL
+        }
+    };
+    uint8_t storageEntriesCount = sizeof(storageEntries) / sizeof(storageEntries[0]);
+    uint32_t storageInitError = 0;
+#endif
+
+    if (argc < 2) {
+        log_printf("Usage: %s <CAN interface> [node-id]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    CANptr.can_ifindex = (int)if_nametoindex(argv[1]);
+    if (CANptr.can_ifindex == 0) {
+        log_printf("Error: Can't find CAN interface \"%s\"\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    if (argc > 2) {
+        long id = strtol(argv[2], NULL, 0);
+        if (id < 1 || id > 127) {
+            log_printf("Error: Wrong node-id \"%s\"\n", argv[2]);
+            return EXIT_FAILURE;
+        }
+        pendingNodeId = (uint8_t)id;
+    }
+
+    signal(SIGINT, sigHandler);
+    signal(SIGTERM, sigHandler);
+
+    /* Create epoll, CAN socket is added by CO_CANinit() */
+    err = CO_epoll_create(&ep, MAIN_INTERVAL_US);
+    if (err != CO_ERROR_NO) {
+        log_printf("Error: Can't create epoll\n");
+        return EXIT_FAILURE;
+    }
+    CANptr.epoll_fd = ep.epoll_fd;
+
+
+    /* Allocate memory */
+    CO = CO_new(NULL, &heapMemoryUsed);
+    if (CO == NULL) {
+        log_printf("Error: Can't allocate memory\n");
+        CO_epoll_close(&ep);
+        return EXIT_FAILURE;
+    }
+    else {
+        log_printf("Allocated %u bytes for CANopen objects\n", heapMemoryUsed);
+    }
+
+
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE
+    err = CO_storageBlank_init(&storage,
+                               CO->CANmodule,
+                               OD_ENTRY_H1010_storeParameters,
+                               OD_ENTRY_H1011_restoreDefaultParameters,
+                               storageEntries,
+                               storageEntriesCount,
+                               &storageInitError);
+
+    if (err != CO_ERROR_NO && err != CO_ERROR_DATA_CORRUPT) {
+        log_printf("Error: Storage %d\n", storageInitError);
+        return EXIT_FAILURE;
+    }
+#endif
+
+
+    while(reset != CO_RESET_APP && !endProgram){
+/* CANopen communication reset - initialize CANopen objects *******************/
+        log_printf("CANopenNode - Reset communication...\n");
+
+        /* Enter CAN configuration. */
+        CO_CANsetConfigurationMode((void *)&CANptr);
+        CO_CANmodule_disable(CO->CANmodule);
+
+        /* initialize CANopen, CAN socket is opened and added to epoll */
+        err = CO_CANinit(CO, (void *)&CANptr, pendingBitRate);
+        if (err != CO_ERROR_NO) {
+            log_printf("Error: CAN initialization failed: %d\n", err);
+            break;
+        }
+
+        CO_LSS_address_t lssAddress = {.identity = {
+            .vendorID = OD_PERSIST_COMM.x1018_identity.vendor_ID,
+            .productCode = OD_PERSIST_COMM.x1018_identity.productCode,
+            .revisionNumber = OD_PERSIST_COMM.x1018_identity.revisionNumber,
+            .serialNumber = OD_PERSIST_COMM.x1018_identity.serialNumber
+        }};
+        err = CO_LSSinit(CO, &lssAddress, &pendingNodeId, &pendingBitRate);
+        if(err != CO_ERROR_NO) {
+            log_printf("Error: LSS slave initialization failed: %d\n", err);
+            break;
+        }
+
+        activeNodeId = pendingNodeId;
+        uint32_t errInfo = 0;
+
+        err = CO_CANopenInit(CO,                /* CANopen object */
+                             NULL,              /* alternate NMT */
+                             NULL,              /* alternate em */
+                             OD,                /* Object dictionary */
+                             OD_STATUS_BITS,    /* Optional OD_statusBits */
+                             NMT_CONTROL,       /* CO_NMT_control_t */
+                             FIRST_HB_TIME,     /* firstHBTime_ms */
+                             SDO_SRV_TIMEOUT_TIME, /* SDOserverTimeoutTime_ms */
+                             SDO_CLI_TIMEOUT_TIME, /* SDOclientTimeoutTime_ms */
+                             SDO_CLI_BLOCK,     /* SDOclientBlockTransfer */
+                             activeNodeId,
+                             &errInfo);
+        if(err != CO_ERROR_NO && err != CO_ERROR_NODE_ID_UNCONFIGURED_LSS) {
+            if (err == CO_ERROR_OD_PARAMETERS) {
+                log_printf("Error: Object Dictionary entry 0x%X\n", errInfo);
+            }
+            else {
+                log_printf("Error: CANopen initialization failed: %d\n", err);
+            }
+            break;
+        }
+
+        err = CO_CANopenInitPDO(CO, CO->em, OD, activeNodeId, &errInfo);
+        if(err != CO_ERROR_NO) {
+            if (err == CO_ERROR_OD_PARAMETERS) {
+                log_printf("Error: Object Dictionary entry 0x%X\n", errInfo);
+            }
+            else {
+                log_printf("Error: PDO initialization failed: %d\n", err);
+            }
+            break;
+        }
+
+        if(!CO->nodeIdUnconfigured) {
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE
+            if(storageInitError != 0) {
+                CO_errorReport(CO->em, CO_EM_NON_VOLATILE_MEMORY,
+                               CO_EMC_HARDWARE, storageInitError);
+            }
+#endif
+        }
+        else {
+            log_printf("CANopenNode - Node-id not initialized\n");
+        }
+
+
+        /* start CAN, kernel filters are set here */
+#if CO_CONFIG_CAN_IF_COUNT > 1
+        for(uint8_t ifNo = 0; ifNo < CO_CONFIG_CAN_IF_COUNT; ifNo++) {
+            CO_CANsetNormalMode(CO->CANmoduleIf[ifNo]);
+        }
+#else
+        CO_CANsetNormalMode(CO->CANmodule);
+#endif
+
+        reset = CO_RESET_NOT;
+
+        log_printf("CANopenNode - Running on %s...\n", argv[1]);
+        fflush(stdout);
+
+        while(reset == CO_RESET_NOT && !endProgram){
+/* loop for normal program execution ******************************************/
+            /* sleep until CAN message or timer, received messages are
+             * processed inside */
+            CO_epoll_wait(&ep);
+
+            /* CANopen process, queued messages are sent at the end */
+            reset = CO_epoll_processMain(&ep, CO);
+
+            /* Nonblocking application code may go here. */
+        }
+    }
+
+
+/* program exit ***************************************************************/
+    /* delete objects from memory */
+    CO_CANsetConfigurationMode((void *)&CANptr);
+    CO_delete(CO);
+    CO_epoll_close(&ep);
+
+    log_printf("CANopenNode finished\n");
+
+    return err == CO_ERROR_NO ? EXIT_SUCCESS : EXIT_FAILURE;
+}
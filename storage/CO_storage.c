@@ -26,6 +26,13 @@
 
 #if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE
 
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_DEFERRED
+/* values for storage->cmdState */
+#define CMD_IDLE 0
+#define CMD_BUSY 1
+#define CMD_FINISHED 2
+#endif
+
 /*
  * Custom function for writing OD object "Store parameters"
  *
@@ -47,6 +54,20 @@ static ODR_t OD_write_1010(OD_stream_t *stream, const void *buf,
         return ODR_READONLY;
     }
 
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_DEFERRED
+    if (stream->dataOffset != 0) {
+        /* repeated call from SDO server, command was queued before */
+        if (storage->cmdState == CMD_BUSY) {
+            return ODR_PENDING;
+        }
+        CO_MemoryBarrier();
+        stream->dataOffset = 0;
+        storage->cmdState = CMD_IDLE;
+        if (storage->cmdResult == ODR_OK) *countWritten = sizeof(uint32_t);
+        return storage->cmdResult;
+    }
+#endif
+
     uint32_t val = CO_getUint32(buf);
     if (val != 0x65766173) {
         return ODR_DATA_TRANSF;
@@ -62,8 +83,10 @@ static ODR_t OD_write_1010(OD_stream_t *stream, const void *buf,
         if (stream->subIndex == 1 || entry->subIndexOD == stream->subIndex) {
             if (found == 0) found = 1;
             if ((entry->attr & CO_storage_cmd) != 0) {
+#if !((CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_DEFERRED)
                 ODR_t code = storage->store(entry, storage->CANmodule);
                 if (code != ODR_OK) returnCode = code;
+#endif
                 found = 2;
             }
         }
@@ -72,6 +95,23 @@ static ODR_t OD_write_1010(OD_stream_t *stream, const void *buf,
     if (found != 2)
         returnCode = found == 0 ? ODR_SUB_NOT_EXIST : ODR_READONLY;
 
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_DEFERRED
+    if (returnCode == ODR_OK) {
+        if (storage->cmdState == CMD_BUSY) {
+            /* previous command (SDO transfer was aborted) is still running */
+            return ODR_PENDING;
+        }
+        /* queue the command for CO_storage_process() */
+        storage->cmdSubIndex = stream->subIndex;
+        storage->cmdEntry = 0;
+        storage->cmdResult = ODR_OK;
+        CO_MemoryBarrier();
+        storage->cmdState = CMD_BUSY;
+        stream->dataOffset = 1;
+        return ODR_PENDING;
+    }
+#endif
+
     if (returnCode == ODR_OK) *countWritten = sizeof(uint32_t);
     return returnCode;
 }
@@ -145,6 +185,9 @@ CO_ReturnError_t CO_storage_init(CO_storage_t *storage,
     }
 
     /* Configure object variables */
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_DEFERRED
+    storage->cmdState = CMD_IDLE;
+#endif
     storage->CANmodule = CANmodule;
     storage->store = store;
     storage->restore = restore;
@@ -170,4 +213,43 @@ CO_ReturnError_t CO_storage_init(CO_storage_t *storage,
     return CO_ERROR_NO;
 }
 
+
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_DEFERRED
+bool_t CO_storage_process(CO_storage_t *storage) {
+    if (storage == NULL || storage->cmdState != CMD_BUSY) {
+        return false;
+    }
+    CO_MemoryBarrier();
+
+    /* find next relevant entry and call its store function once */
+    while (storage->cmdEntry < storage->entriesCount) {
+        CO_storage_entry_t *entry = &storage->entries[storage->cmdEntry];
+
+        if ((storage->cmdSubIndex == 1
+             || entry->subIndexOD == storage->cmdSubIndex)
+            && (entry->attr & CO_storage_cmd) != 0
+        ) {
+            ODR_t code = storage->store(entry, storage->CANmodule);
+            if (code == ODR_PARTIAL) {
+                /* continue with the same entry on next call */
+                return true;
+            }
+            if (code != ODR_OK) storage->cmdResult = code;
+            storage->cmdEntry++;
+            break;
+        }
+        storage->cmdEntry++;
+    }
+
+    if (storage->cmdEntry < storage->entriesCount) {
+        return true;
+    }
+
+    /* all entries stored, SDO server will get the result */
+    CO_MemoryBarrier();
+    storage->cmdState = CMD_FINISHED;
+    return false;
+}
+#endif
+
 #endif /* (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE */
@@ -82,6 +82,24 @@ extern "C" {
  *   - bit 0: If set, CANopen device restores parameters
  * - Writing value 0x64616F6C ('l','o','a','d' from LSB to MSB) restores
  *   corresponding data.
+ *
+ * ### Deferred store command
+ * Storing large data blocks may take long time, for example on slow eeprom.
+ * With @ref CO_CONFIG_STORAGE_DEFERRED store command is not executed inside
+ * SDO server, so other CANopen objects are processed meanwhile. Write to
+ * 0x1010 only queues the command and returns ODR_PENDING to the SDO server.
+ * @ref CO_storage_process() then calls 'store' function for relevant entries.
+ * 'store' function may return ODR_PARTIAL, if it wants to be called again, so
+ * it can store data incrementally. SDO server sends the response, when all
+ * entries are stored. Store must finish within the SDO server timeout.
+ * Data block, stored incrementally, is not an atomic snapshot: application or
+ * SDO may write OD variables between two calls of 'store' function, so stored
+ * block may contain some values from before and some from after such a write.
+ * Stored CRC always matches the stored data. If consistency of related
+ * parameters is required, application must not change them during the store
+ * command (@ref CO_storage_process() returns true).
+ * Other accesses to 0x1010 than SDO server (OD_set_u32(), for example) don't
+ * support ODR_PENDING and fail.
  */
 
 
@@ -115,6 +133,13 @@ typedef struct {
     uint8_t entriesCount; /**< From CO_storage_init() */
     bool_t enabled; /**< true, if storage is enabled. Setting of this variable
     is implementation specific. */
+#if ((CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_DEFERRED) || defined CO_DOXYGEN
+    /** State of the queued store command: 0=idle, 1=busy, 2=finished */
+    volatile uint8_t cmdState;
+    uint8_t cmdSubIndex; /**< Sub index of 0x1010, written by store command */
+    uint8_t cmdEntry; /**< Index of entry currently being stored */
+    ODR_t cmdResult; /**< Result of the store command */
+#endif
 } CO_storage_t;
 
 
@@ -138,6 +163,8 @@ typedef struct {
  * OD variable 0x1010 will be written. Argument to function is entry, where
  * 'entry->subIndexOD' equals accessed subIndex. Function returns value from
  * @ref ODR_t : "ODR_OK" in case of success, "ODR_HW" in case of hardware error.
+ * With @ref CO_CONFIG_STORAGE_DEFERRED function may also return "ODR_PARTIAL",
+ * if store is not finished yet. It will be called again with the same entry.
  * @param restore Same as 'store', but for restoring default data.
  * @param entries Pointer to array of storage entries. Array must be defined and
  * initialized by application and must exist permanently.
@@ -158,6 +185,21 @@ CO_ReturnError_t CO_storage_init(CO_storage_t *storage,
                                  CO_storage_entry_t *entries,
                                  uint8_t entriesCount);
 
+
+#if ((CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_DEFERRED) || defined CO_DOXYGEN
+/**
+ * Process store command, queued by SDO write to OD object 0x1010.
+ *
+ * Function must be called cyclically, from mainline or from separate thread.
+ * Each call executes one call of 'store' function, see @ref CO_storage_init().
+ *
+ * @param storage This object
+ *
+ * @return true, if store command is in progress.
+ */
+bool_t CO_storage_process(CO_storage_t *storage);
+#endif
+
 /** @} */ /* CO_storage */
 
 #ifdef __cplusplus
@@ -22,12 +22,75 @@
  * limitations under the License.
  */
 
+#include <string.h>
+
 #include "storage/CO_storageEeprom.h"
 #include "storage/CO_eeprom.h"
 #include "301/crc16-ccitt.h"
 
 #if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE
 
+#if ((CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_EEPROM_DELTA) \
+    || ((CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_DEFERRED)
+/* Get length of the chunk at offset inside data block. Chunks are aligned to
+ * CO_CONFIG_STORAGE_EEPROM_CHUNK inside eeprom. */
+static size_t chunkLength(CO_storage_entry_t *entry, size_t offset) {
+    size_t eepromAddr = entry->eepromAddr + offset;
+    size_t len = CO_CONFIG_STORAGE_EEPROM_CHUNK
+                 - (eepromAddr % CO_CONFIG_STORAGE_EEPROM_CHUNK);
+
+    if (len > (entry->len - offset)) {
+        len = entry->len - offset;
+    }
+    return len;
+}
+
+/* Write one chunk of data block to the eeprom and verify it. With
+ * CO_CONFIG_STORAGE_EEPROM_DELTA chunk is written only, if changed. Calculate
+ * CRC from data, which are in the eeprom after the write. */
+static bool_t storeChunk(CO_storage_entry_t *entry, CO_CANmodule_t *CANmodule,
+                         size_t offset, size_t len, uint16_t *crc)
+{
+    uint8_t chunk[CO_CONFIG_STORAGE_EEPROM_CHUNK];
+    uint8_t chunkVerify[CO_CONFIG_STORAGE_EEPROM_CHUNK];
+    uint8_t *data = (uint8_t *)entry->addr;
+    size_t eepromAddr = entry->eepromAddr + offset;
+    bool_t changed = true;
+    (void) CANmodule;
+
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_EEPROM_DELTA
+    CO_eeprom_readBlock(entry->storageModule, chunk, eepromAddr, len);
+    CO_LOCK_OD(CANmodule);
+    changed = memcmp(chunk, &data[offset], len) != 0;
+    if (changed) {
+        memcpy(chunk, &data[offset], len);
+    }
+    CO_UNLOCK_OD(CANmodule);
+#else
+    CO_LOCK_OD(CANmodule);
+    memcpy(chunk, &data[offset], len);
+    CO_UNLOCK_OD(CANmodule);
+#endif
+    *crc = crc16_ccitt(chunk, len, *crc);
+
+    if (changed) {
+        if (!CO_eeprom_writeBlock(entry->storageModule, chunk,
+                                  eepromAddr, len)
+        ) {
+            return false;
+        }
+        /* Verify, if data in eeprom are equal */
+        CO_eeprom_readBlock(entry->storageModule, chunkVerify,
+                            eepromAddr, len);
+        if (memcmp(chunk, chunkVerify, len) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+
 /*
  * Function for writing data on "Store parameters" command - OD object 1010
  *
@@ -36,6 +99,44 @@
 static ODR_t storeEeprom(CO_storage_entry_t *entry, CO_CANmodule_t *CANmodule) {
     bool_t writeOk;
 
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_DEFERRED
+    /* store one chunk per call, CRC is accumulated in entry->crc. OD is
+     * locked for each chunk only, so block is not stored atomically, see
+     * "Deferred store command" in CO_storage.h. */
+    if (entry->storeOffset < entry->len) {
+        size_t len = chunkLength(entry, entry->storeOffset);
+
+        if (entry->storeOffset == 0) {
+            entry->crc = 0;
+        }
+        if (!storeChunk(entry, CANmodule, entry->storeOffset, len,
+                        &entry->crc)
+        ) {
+            entry->storeOffset = 0;
+            return ODR_HW;
+        }
+        entry->storeOffset += len;
+        if (entry->storeOffset < entry->len) {
+            return ODR_PARTIAL;
+        }
+    }
+    entry->storeOffset = 0;
+#elif (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_EEPROM_DELTA
+    /* save only changed chunks to the eeprom */
+    uint16_t crc = 0;
+    size_t offset = 0;
+
+    while (offset < entry->len) {
+        size_t len = chunkLength(entry, offset);
+
+        if (!storeChunk(entry, CANmodule, offset, len, &crc)) {
+            entry->crc = crc;
+            return ODR_HW;
+        }
+        offset += len;
+    }
+    entry->crc = crc;
+#else
     /* save data to the eeprom */
     CO_LOCK_OD(CANmodule);
     writeOk = CO_eeprom_writeBlock(entry->storageModule, entry->addr,
@@ -49,6 +150,7 @@ static ODR_t storeEeprom(CO_storage_entry_t *entry, CO_CANmodule_t *CANmodule) {
     if (entry->crc != crc_read || !writeOk) {
         return ODR_HW;
     }
+#endif
 
     /* Write signature (see CO_storageEeprom_init() for info) */
     uint16_t signatureOfEntry = (uint16_t)entry->len;
@@ -104,12 +206,27 @@ static ODR_t restoreEeprom(CO_storage_entry_t *entry,
 }
 
 
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY
+/*
+ * Observer of writes to OD, see OD_setWriteObserver()
+ */
+static void storageEeprom_writeObserver(void *object, const void *dataOrig,
+                                        OD_size_t len)
+{
+    CO_storageEeprom_markDirty((CO_storage_t *)object, dataOrig, len);
+}
+#endif
+
+
 /******************************************************************************/
 CO_ReturnError_t CO_storageEeprom_init(CO_storage_t *storage,
                                        CO_CANmodule_t *CANmodule,
                                        void *storageModule,
                                        OD_entry_t *OD_1010_StoreParameters,
                                        OD_entry_t *OD_1011_RestoreDefaultParam,
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY
+                                       OD_t *OD,
+#endif
                                        CO_storage_entry_t *entries,
                                        uint8_t entriesCount,
                                        uint32_t *storageInitError)
@@ -175,6 +292,14 @@ CO_ReturnError_t CO_storageEeprom_init(CO_storage_t *storage,
                                               entry->len,
                                               &eepromOvf);
         entry->offset = 0;
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_DEFERRED
+        entry->storeOffset = 0;
+#endif
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY
+        /* data are read from eeprom, nothing changed */
+        entry->dirtyStart = entry->len;
+        entry->dirtyEnd = 0;
+#endif
 
         /* verify if eeprom is too small */
         if (eepromOvf) {
@@ -219,6 +344,9 @@ CO_ReturnError_t CO_storageEeprom_init(CO_storage_t *storage,
     } /* for (entries) */
 
     storage->enabled = true;
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY
+    OD_setWriteObserver(OD, storage, storageEeprom_writeObserver);
+#endif
     return ret;
 }
 
@@ -238,6 +366,12 @@ void CO_storageEeprom_auto_process(CO_storage_t *storage, bool_t saveAll) {
             continue;
 
         if (saveAll) {
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY
+            CO_LOCK_OD(storage->CANmodule);
+            entry->dirtyStart = entry->len;
+            entry->dirtyEnd = 0;
+            CO_UNLOCK_OD(storage->CANmodule);
+#endif
             /* update all bytes */
             for (size_t i = 0; i < entry->len; ) {
                 uint8_t dataByteToUpdate = ((uint8_t *)(entry->addr))[i];
@@ -251,6 +385,32 @@ void CO_storageEeprom_auto_process(CO_storage_t *storage, bool_t saveAll) {
             }
         }
         else {
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY
+            /* update first byte from dirty range, if any */
+            size_t offset = entry->dirtyStart;
+            if (offset >= entry->dirtyEnd) {
+                continue;
+            }
+            uint8_t dataByteToUpdate = ((uint8_t*)(entry->addr))[offset];
+            size_t eepromAddr = entry->eepromAddr + offset;
+            if (CO_eeprom_updateByte(entry->storageModule, dataByteToUpdate,
+                                     eepromAddr)
+            ) {
+                CO_LOCK_OD(storage->CANmodule);
+                /* range may be extended by write in the meantime and byte
+                 * may be changed after it was read, then update it again */
+                if (entry->dirtyStart == offset
+                    && ((uint8_t*)(entry->addr))[offset] == dataByteToUpdate
+                ) {
+                    entry->dirtyStart++;
+                    if (entry->dirtyStart >= entry->dirtyEnd) {
+                        entry->dirtyStart = entry->len;
+                        entry->dirtyEnd = 0;
+                    }
+                }
+                CO_UNLOCK_OD(storage->CANmodule);
+            }
+#else
             /* update one data byte and if successful increment to next */
             uint8_t dataByteToUpdate = ((uint8_t*)(entry->addr))[entry->offset];
             size_t eepromAddr = entry->eepromAddr + entry->offset;
@@ -261,8 +421,45 @@ void CO_storageEeprom_auto_process(CO_storage_t *storage, bool_t saveAll) {
                     entry->offset = 0;
                 }
             }
+#endif
+        }
+    }
+}
+
+
+#if (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY
+/******************************************************************************/
+void CO_storageEeprom_markDirty(CO_storage_t *storage,
+                                const void *addr, size_t len)
+{
+    if (storage == NULL || addr == NULL || len == 0) {
+        return;
+    }
+
+    uintptr_t start = (uintptr_t)addr;
+    uintptr_t end = start + len;
+
+    for (uint8_t i = 0; i < storage->entriesCount; i++) {
+        CO_storage_entry_t *entry = &storage->entries[i];
+        uintptr_t entryStart = (uintptr_t)entry->addr;
+        uintptr_t entryEnd = entryStart + entry->len;
+
+        if ((entry->attr & CO_storage_auto) == 0
+            || end <= entryStart || start >= entryEnd
+        ) {
+            continue;
+        }
+
+        size_t dirtyStart = start > entryStart ? start - entryStart : 0;
+        size_t dirtyEnd = end < entryEnd ? end - entryStart : entry->len;
+        if (dirtyStart < entry->dirtyStart) {
+            entry->dirtyStart = dirtyStart;
+        }
+        if (dirtyEnd > entry->dirtyEnd) {
+            entry->dirtyEnd = dirtyEnd;
         }
     }
 }
+#endif
 
 #endif /* (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE */
@@ -28,6 +28,15 @@
 
 #include "storage/CO_storage.h"
 
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_STORAGE_EEPROM_CHUNK
+#define CO_CONFIG_STORAGE_EEPROM_CHUNK 32
+#endif
+
+#if ((CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY) && !OD_WRITE_OBSERVER
+#error CO_CONFIG_STORAGE_AUTO_DIRTY requires OD_WRITE_OBSERVER set to 1
+#endif
+
 #if ((CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE) || defined CO_DOXYGEN
 
 #ifdef __cplusplus
@@ -65,6 +74,18 @@ extern "C" {
  * entry, emergency message is sent. If eeprom is new, then all signatures are
  * wrong, so it is best to store all parameters by writing to 0x1010, sub 1.
  *
+ * With @ref CO_CONFIG_STORAGE_EEPROM_DELTA store command writes only chunks of
+ * data block, which differ from eeprom contents. This reduces eeprom wear and
+ * time of store command, if only few parameters were changed.
+ *
+ * With @ref CO_CONFIG_STORAGE_DEFERRED store command writes and verifies one
+ * chunk of data block per @ref CO_storage_process() call, so node is not
+ * blocked during the write of large data block.
+ *
+ * With @ref CO_CONFIG_STORAGE_AUTO_DIRTY automatic storage updates only byte
+ * ranges, which were written through Object Dictionary or marked with
+ * @ref CO_storageEeprom_markDirty().
+ *
  * If entry attribute has CO_storage_auto set, then data block is stored
  * autonomously, byte by byte, on change, during program run. Those data blocks
  * are stored into write unprotected location. For auto storage to work,
@@ -90,6 +111,9 @@ extern "C" {
  * Entry is optional, may be NULL.
  * @param OD_1011_RestoreDefaultParam OD entry for 0x1011 -"Restore default
  * parameters". Entry is optional, may be NULL.
+ * @param OD Object Dictionary, which contains data of auto storage entries.
+ * Used with @ref CO_CONFIG_STORAGE_AUTO_DIRTY only, writes to it mark data
+ * dirty, see OD_setWriteObserver().
  * @param entries Pointer to array of storage entries, see @ref CO_storage_init.
  * @param entriesCount Count of storage entries
  * @param [out] storageInitError If function returns CO_ERROR_DATA_CORRUPT,
@@ -107,6 +131,9 @@ CO_ReturnError_t CO_storageEeprom_init(CO_storage_t *storage,
                                        void *storageModule,
                                        OD_entry_t *OD_1010_StoreParameters,
                                        OD_entry_t *OD_1011_RestoreDefaultParam,
+#if ((CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY) || defined CO_DOXYGEN
+                                       OD_t *OD,
+#endif
                                        CO_storage_entry_t *entries,
                                        uint8_t entriesCount,
                                        uint32_t *storageInitError);
@@ -122,6 +149,23 @@ CO_ReturnError_t CO_storageEeprom_init(CO_storage_t *storage,
  */
 void CO_storageEeprom_auto_process(CO_storage_t *storage, bool_t saveAll);
 
+
+#if ((CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_AUTO_DIRTY) || defined CO_DOXYGEN
+/**
+ * Mark data as changed for automatic storage.
+ *
+ * Function is called automatically for writes with OD_writeOriginal() and
+ * OD_notifyWrite(). It must be called by application, if data of auto storage
+ * entry are written directly. Data range, which is not inside auto storage entry, is ignored.
+ *
+ * @param storage This object
+ * @param addr Address of changed data.
+ * @param len Length of changed data.
+ */
+void CO_storageEeprom_markDirty(CO_storage_t *storage,
+                                const void *addr, size_t len);
+#endif
+
 /** @} */ /* CO_storage_eeprom */
 
 #ifdef __cplusplus